@@ -28,7 +28,12 @@ if(NOT WITH_PROFILER)
     add_definitions(-DPADDLE_DISABLE_PROFILER)
 endif(NOT WITH_PROFILER)
 
-if(WITH_AVX AND AVX_FOUND)
+if(LITE_WITH_X86_DISPATCH)
+    # baseline code targets SSE4, AVX2 kernels are picked at runtime
+    if(NOT WIN32)
+        set(SIMD_FLAG "-msse4.2")
+    endif()
+elseif(WITH_AVX AND AVX_FOUND)
     set(SIMD_FLAG ${AVX_FLAG})
 elseif(SSE3_FOUND)
     set(SIMD_FLAG ${SSE3_FLAG})
@@ -145,6 +150,12 @@ endif()
 # TODO(Superjomn) not work fine with the option
 if (LITE_WITH_X86)
     add_definitions("-DLITE_WITH_X86")
+    # Defines Eigen::ThreadPoolDevice for the Eigen expressions of x86.
+    add_definitions("-DEIGEN_USE_THREADS")
+endif()
+
+if (LITE_WITH_X86_DISPATCH)
+    add_definitions("-DLITE_WITH_X86_DISPATCH")
 endif()
 
 if (LITE_WITH_ARM)
@@ -166,6 +177,10 @@ if (WITH_ARM_DOTPROD)
     add_definitions("-DWITH_ARM_DOTPROD")
 endif()
 
+if (WITH_ARM_MMLA)
+    add_definitions("-DWITH_ARM_MMLA")
+endif()
+
 if (LITE_WITH_NPU)
     add_definitions("-DLITE_WITH_NPU")
 endif()
@@ -292,3 +307,11 @@ endif(LITE_WITH_PYTHON)
 if (LITE_WITH_ARM82_FP16)
   add_definitions("-DLITE_WITH_ARM82_FP16")
 endif(LITE_WITH_ARM82_FP16)
+
+if (LITE_WITH_ARM_SVE)
+  if (ARM_TARGET_ARCH_ABI STREQUAL "armv8")
+    add_definitions("-DLITE_WITH_ARM_SVE")
+  else()
+    message(WARNING "LITE_WITH_ARM_SVE needs ARM_TARGET_ARCH_ABI=armv8, ignored")
+  endif()
+endif(LITE_WITH_ARM_SVE)
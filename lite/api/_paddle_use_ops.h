@@ -51,6 +51,7 @@ USE_LITE_OP(pool2d)
 USE_LITE_OP(max_pool2d_with_index)
 USE_LITE_OP(batch_norm)
 USE_LITE_OP(fusion_elementwise_sub_activation)
+USE_LITE_OP(fusion_elementwise_chain)
 USE_LITE_OP(transpose)
 USE_LITE_OP(transpose2)
 USE_LITE_OP(arg_max)
@@ -107,6 +108,8 @@ USE_LITE_OP(beam_search_decode)
 USE_LITE_OP(beam_search)
 USE_LITE_OP(fill_constant)
 USE_LITE_OP(while)
+USE_LITE_OP(kv_cache_append)
+USE_LITE_OP(kv_cache_reorder)
 USE_LITE_OP(lod_reset)
 USE_LITE_OP(lookup_table)
 USE_LITE_OP(multiclass_nms)
@@ -383,6 +383,7 @@ void Predictor::Build(const std::shared_ptr<cpp::ProgramDesc> &program_desc,
     program_->set_version(program_desc->Version());
 
   PrepareFeedFetch();
+  PrepareTensorArrays();
   // Verify if the ops version of current runtime program is
   // the same with that in models.
   CheckPaddleOpVersions(program_desc);
@@ -517,22 +518,28 @@ void Predictor::CheckInputValid() {
   }
 }
 
-void Predictor::ClearTensorArray(
-    const std::shared_ptr<const cpp::ProgramDesc> &program_desc) {
-  for (size_t blk_idx = 0; blk_idx < program_desc->BlocksSize(); blk_idx++) {
+void Predictor::PrepareTensorArrays() {
+  tensor_array_vars_.clear();
+  for (size_t blk_idx = 0; blk_idx < program_desc_->BlocksSize(); blk_idx++) {
     const cpp::BlockDesc *block =
-        program_desc->GetBlock<cpp::BlockDesc>(blk_idx);
+        program_desc_->GetBlock<cpp::BlockDesc>(blk_idx);
     for (size_t var_idx = 0; var_idx < block->VarsSize(); var_idx++) {
       const cpp::VarDesc *var = block->GetVar<cpp::VarDesc>(var_idx);
       CHECK(var);
 
-      auto tmp = program_->exec_scope()->FindVar(var->Name());
-      if (tmp->IsType<std::vector<Tensor>>()) {
-        std::vector<Tensor> *tensor_array_var =
-            program_->exec_scope()->FindMutableTensorList(var->Name());
-        CHECK(tensor_array_var);
-        tensor_array_var->clear();
-      }
+      auto *tmp = program_->exec_scope()->FindVar(var->Name());
+      CHECK(tmp) << "no variable named with " << var->Name();
+      // A variable keeps the type of its first GetMutable(), a tensor never
+      // turns into a tensor array.
+      if (!tmp->IsType<Tensor>()) tensor_array_vars_.push_back(tmp);
+    }
+  }
+}
+
+void Predictor::ClearTensorArray() {
+  for (auto *var : tensor_array_vars_) {
+    if (var->IsType<std::vector<Tensor>>()) {
+      var->GetMutable<std::vector<Tensor>>()->clear();
     }
   }
 }
@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 #include "lite/api/paddle_api.h"
+#include "lite/core/calibrator.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/optimizer/optimizer.h"
 #include "lite/core/program.h"
@@ -76,6 +77,7 @@ class LITE_API Predictor {
     program_.reset(
         new RuntimeProgram(program_desc_, exec_scope_, kRootBlockIdx));
     program_generated_ = true;
+    PrepareTensorArrays();
   }
 
   // Build from a model, with places set for hardware config.
@@ -172,12 +174,15 @@ class LITE_API Predictor {
 #endif
 
     program_->Run();
+    if (calibrator_) {
+      calibrator_->IncreaseBatch();
+    }
 
 #ifdef LITE_WITH_XPU
     lite::TargetWrapperXPU::FreeL3Cache();
 #endif
 
-    ClearTensorArray(program_desc_);
+    ClearTensorArray();
   }
 
   /// \brief Release all tmp tensor to compress the size of the memory pool.
@@ -201,6 +206,34 @@ class LITE_API Predictor {
 
   void PrepareFeedFetch();
 
+  // Skip shape inference while the input shapes don't change.
+  void SetStaticShape(bool static_shape) {
+    program_->set_static_shape(static_shape);
+  }
+
+  // Collect the statistics of the activations for the post-training
+  // quantization in every run.
+  void EnableCalibration(lite_api::CalibrationMethod method, float percentile) {
+    calibrator_.reset(new Calibrator(method, percentile));
+    auto* calibrator = calibrator_.get();
+    auto* exec_scope = exec_scope_;
+    program_->set_instruction_hook(
+        [calibrator, exec_scope](const Instruction& inst, float) {
+          calibrator->Collect(inst.op(), exec_scope);
+        });
+  }
+  const Calibrator* calibrator() const { return calibrator_.get(); }
+
+  // Inspect the instructions after they run, see RuntimeProgram.
+  void SetInstructionHook(const RuntimeProgram::InstructionHook& hook) {
+    program_->set_instruction_hook(hook);
+  }
+
+  // Move the large embedding tables into shared read-only file mappings.
+  void MapEmbeddingTables(const std::string& dir) {
+    program_->MapEmbeddingTables(dir);
+  }
+
   // Get offset-th col of fetch results.
   const lite::Tensor* GetOutput(size_t offset) const;
   std::vector<const lite::Tensor*> GetOutputs() const;
@@ -241,15 +274,19 @@ class LITE_API Predictor {
   // would be called in Run().
   void CheckInputValid();
 
-  void ClearTensorArray(
-      const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
+  // Collects the variables of program_desc_ that may hold a tensor array, so
+  // that ClearTensorArray() doesn't look them up by name on every run.
+  void PrepareTensorArrays();
+  void ClearTensorArray();
 
  private:
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
   std::shared_ptr<Scope> scope_;
   Scope* exec_scope_;
+  std::shared_ptr<Calibrator> calibrator_;
   std::shared_ptr<RuntimeProgram> program_;
   bool program_generated_{false};
+  std::vector<Variable*> tensor_array_vars_;
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
   std::vector<Place> valid_places_;
@@ -13,13 +13,16 @@
 // limitations under the License.
 
 #include "lite/api/cxx_api.h"
+#include <map>
 #include <memory>
 #include <mutex>  //NOLINT
 #include <string>
 #include "lite/api/paddle_api.h"
 #include "lite/core/device_info.h"
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
 #include "lite/core/optimizer/mir/sparse_conv_detect_pass.h"
 #include "lite/core/version.h"
 #ifdef LITE_USE_THREAD_POOL
@@ -132,11 +135,25 @@ void CxxPaddleApiImpl::Init(const lite_api::CxxConfig &config) {
       sparse_detect_pass->SetSparseThreshold(1.5);
     }
 
+    // The activations are calibrated by their names, keep them unchanged.
+    mir::ScopedPassSetting<mir::MemoryOptimizePass, bool> memory_optimize(
+        "memory_optimize_pass",
+        &mir::MemoryOptimizePass::enabled,
+        &mir::MemoryOptimizePass::SetEnabled,
+        !config.calibration_mode());
     raw_predictor_->Build(config, places, passes);
+    if (config.calibration_mode()) {
+      raw_predictor_->EnableCalibration(config.calibration_method(),
+                                        config.calibration_percentile());
+    }
+    if (!config.embedding_mmap_dir().empty()) {
+      raw_predictor_->MapEmbeddingTables(config.embedding_mmap_dir());
+    }
   } else {
     raw_predictor_->PrepareFeedFetch();
     CHECK(raw_predictor_) << "The Predictor can not be nullptr in Clone mode.";
   }
+  raw_predictor_->SetStaticShape(config.static_shape());
 
 #ifdef LITE_WITH_NPU
   // Store the model-level configuration into scope for kernels, and use
@@ -308,7 +325,46 @@ std::unique_ptr<lite_api::Tensor> CxxPaddleApiImpl::GetInputByName(
 void CxxPaddleApiImpl::SaveOptimizedModel(const std::string &model_dir,
                                           lite_api::LiteModelType model_type,
                                           bool record_info) {
-  raw_predictor_->SaveModel(model_dir, model_type, record_info);
+  auto *calibrator = raw_predictor_->calibrator();
+  if (!calibrator) {
+    raw_predictor_->SaveModel(model_dir, model_type, record_info);
+    return;
+  }
+  // Rebuild the model with the thresholds of the activations, the fused ops
+  // and their variables are the same as the calibrated ones until
+  // post_quant_static_pass, which quantizes the model.
+  CHECK_GT(calibrator->num_batches(), 0)
+      << "Run the predictor with the calibration data before saving the "
+         "quantized model.";
+  LOG(INFO) << "Quantize the model with " << calibrator->num_batches()
+            << " calibration batches.";
+  using Thresholds = std::map<std::string, float>;
+  mir::ScopedPassSetting<mir::PostQuantStaticPass, Thresholds> thresholds(
+      "post_quant_static_pass",
+      &mir::PostQuantStaticPass::thresholds,
+      &mir::PostQuantStaticPass::SetThresholds,
+      calibrator->ComputeThresholds());
+  mir::ScopedPassSetting<mir::MemoryOptimizePass, bool> memory_optimize(
+      "memory_optimize_pass",
+      &mir::MemoryOptimizePass::enabled,
+      &mir::MemoryOptimizePass::SetEnabled,
+      true);
+
+  std::vector<Place> places;
+  for (auto &place : config_.valid_places()) {
+    if ((place.target == TARGET(kARM) || place.target == TARGET(kX86)) &&
+        place.precision == PRECISION(kFloat)) {
+      places.emplace_back(place.target, PRECISION(kInt8), place.layout);
+    }
+  }
+  for (auto &place : config_.valid_places()) {
+    places.push_back(place);
+  }
+  std::vector<std::string> passes = config_.get_passes_internal();
+  passes.push_back("post_quant_static_pass");
+  Predictor quantized_predictor;
+  quantized_predictor.Build(config_, places, passes);
+  quantized_predictor.SaveModel(model_dir, model_type, record_info);
 }
 
 bool CxxPaddleApiImpl::TryShrinkMemory() {
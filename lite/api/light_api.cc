@@ -180,9 +180,10 @@ void LightPredictor::PrepareFeedFetch() {
 void LightPredictor::BuildRuntimeProgram(
     const std::shared_ptr<const cpp::ProgramDesc>& program_desc) {
   auto* exe_scope = &scope_->NewScope();
-  // Prepare workspace
-  scope_->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
-  scope_->Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
+  // Prepare workspace. The feed and fetch lists are private to the predictor,
+  // the clones only share the weights in scope_.
+  exe_scope->Var("feed")->GetMutable<std::vector<lite::Tensor>>();
+  exe_scope->Var("fetch")->GetMutable<std::vector<lite::Tensor>>();
   CHECK(program_desc);
   auto block_size = program_desc->BlocksSize();
   CHECK(block_size);
@@ -208,6 +209,7 @@ void LightPredictor::BuildRuntimeProgram(
   // Only extracting the ops and generate the runtime program from the main
   // block desc
   program_.reset(new RuntimeProgram(program_desc, exe_scope, kRootBlockIdx));
+  PrepareTensorArrays();
 }
 
 void LightPredictor::DequantizeWeight() {
@@ -392,22 +394,28 @@ bool LightPredictor::TryShrinkMemory() {
   }
   return true;
 }
-void LightPredictor::ClearTensorArray(
-    const std::shared_ptr<const cpp::ProgramDesc>& program_desc) {
-  for (size_t blk_idx = 0; blk_idx < program_desc->BlocksSize(); blk_idx++) {
+void LightPredictor::PrepareTensorArrays() {
+  tensor_array_vars_.clear();
+  for (size_t blk_idx = 0; blk_idx < program_desc_->BlocksSize(); blk_idx++) {
     const cpp::BlockDesc* block =
-        program_desc->GetBlock<cpp::BlockDesc>(blk_idx);
+        program_desc_->GetBlock<cpp::BlockDesc>(blk_idx);
     for (size_t var_idx = 0; var_idx < block->VarsSize(); var_idx++) {
       const cpp::VarDesc* var = block->GetVar<cpp::VarDesc>(var_idx);
       CHECK(var);
 
-      auto tmp = program_->exec_scope()->FindVar(var->Name());
-      if (tmp->IsType<std::vector<Tensor>>()) {
-        std::vector<Tensor>* tensor_array_var =
-            program_->exec_scope()->FindMutableTensorList(var->Name());
-        CHECK(tensor_array_var);
-        tensor_array_var->clear();
-      }
+      auto* tmp = program_->exec_scope()->FindVar(var->Name());
+      CHECK(tmp) << "no variable named with " << var->Name();
+      // A variable keeps the type of its first GetMutable(), a tensor never
+      // turns into a tensor array.
+      if (!tmp->IsType<Tensor>()) tensor_array_vars_.push_back(tmp);
+    }
+  }
+}
+
+void LightPredictor::ClearTensorArray() {
+  for (auto* var : tensor_array_vars_) {
+    if (var->IsType<std::vector<Tensor>>()) {
+      var->GetMutable<std::vector<Tensor>>()->clear();
     }
   }
 }
@@ -62,10 +62,27 @@ class LITE_API LightPredictor {
     Build(model_dir, model_buffer, param_buffer, model_type, model_from_memory);
   }
 
+  // Create a predictor from the program and the weights of another one, only
+  // the variables of the execution are private. Used by Clone.
+  LightPredictor(const std::shared_ptr<cpp::ProgramDesc>& program_desc,
+                 const std::shared_ptr<Scope>& root_scope)
+      : scope_(root_scope), program_desc_(program_desc) {
+    BuildRuntimeProgram(program_desc_);
+    PrepareFeedFetch();
+  }
+
+  // Create a predictor sharing the weights with this one.
+  std::unique_ptr<LightPredictor> Clone() const {
+    std::unique_ptr<LightPredictor> predictor(
+        new LightPredictor(program_desc_, scope_));
+    predictor->SetStaticShape(program_->static_shape());
+    return predictor;
+  }
+
   void Run() {
     CheckInputValid();
     program_->Run();
-    ClearTensorArray(program_desc_);
+    ClearTensorArray();
   }
 
   /// \brief Release all tmp tensor to compress the size of the memory pool.
@@ -96,6 +113,16 @@ class LITE_API LightPredictor {
   void PrepareFeedFetch();
   Scope* scope() { return scope_.get(); }
 
+  // Skip shape inference while the input shapes don't change.
+  void SetStaticShape(bool static_shape) {
+    program_->set_static_shape(static_shape);
+  }
+
+  // Move the large embedding tables into shared read-only file mappings.
+  void MapEmbeddingTables(const std::string& dir) {
+    program_->MapEmbeddingTables(dir);
+  }
+
 #ifdef LITE_WITH_METAL
   void ConfigMetalContext(const lite_api::MobileConfig& config) {
     program_->ConfigMetalContext(config.metal_lib_path(),
@@ -131,13 +158,16 @@ class LITE_API LightPredictor {
   void WeightFP32ToFP16();
 #endif
 
-  void ClearTensorArray(
-      const std::shared_ptr<const cpp::ProgramDesc>& program_desc);
+  // Collects the variables of program_desc_ that may hold a tensor array, so
+  // that ClearTensorArray() doesn't look them up by name on every run.
+  void PrepareTensorArrays();
+  void ClearTensorArray();
 
  private:
   std::shared_ptr<Scope> scope_;
   std::unique_ptr<RuntimeProgram> program_;
   std::shared_ptr<cpp::ProgramDesc> program_desc_;
+  std::vector<Variable*> tensor_array_vars_;
   std::vector<std::string> input_names_;
   std::vector<std::string> output_names_;
   std::vector<PrecisionType> input_precisions_;
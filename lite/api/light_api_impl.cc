@@ -57,6 +57,10 @@ void LightPredictorImpl::Init(const lite_api::MobileConfig& config) {
 #ifdef LITE_WITH_METAL
   raw_predictor_->ConfigMetalContext(config);
 #endif
+  raw_predictor_->SetStaticShape(config.static_shape());
+  if (!config.embedding_mmap_dir().empty()) {
+    raw_predictor_->MapEmbeddingTables(config.embedding_mmap_dir());
+  }
 
 #ifdef LITE_WITH_NPU
   // Store the model-level configuration into scope for kernels, and use
@@ -146,8 +150,11 @@ void LightPredictorImpl::Run() {
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone() {
-  LOG(FATAL) << "The Clone API is not supported in LigthPredictor";
-  return nullptr;
+  auto predictor = std::make_shared<LightPredictorImpl>();
+  predictor->raw_predictor_ = raw_predictor_->Clone();
+  predictor->mode_ = mode_;
+  predictor->threads_ = threads_;
+  return predictor;
 }
 
 std::shared_ptr<lite_api::PaddlePredictor> LightPredictorImpl::Clone(
@@ -16,6 +16,7 @@
 
 #include <utility>
 
+#include "lite/backends/host/memory_policy.h"
 #include "lite/core/context.h"
 #include "lite/core/device_info.h"
 #include "lite/core/target_wrapper.h"
@@ -104,6 +105,41 @@ void Tensor::ShareExternalMemory(void *data,
   tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
 }
 
+namespace {
+// An unowned buffer which notifies the owner of the memory when released.
+class ExternalBuffer : public lite::Buffer {
+ public:
+  ExternalBuffer(void *data,
+                 TargetType target,
+                 size_t size,
+                 std::function<void(void *)> deleter)
+      : lite::Buffer(data, target, size), deleter_(std::move(deleter)) {}
+
+  ~ExternalBuffer() override {
+    if (deleter_) deleter_(data());
+  }
+
+ private:
+  std::function<void(void *)> deleter_;
+};
+}  // namespace
+
+void Tensor::ShareExternalMemory(void *data,
+                                 size_t memory_size,
+                                 TargetType target,
+                                 std::function<void(void *)> deleter) {
+  auto buf = std::make_shared<ExternalBuffer>(
+      data, target, memory_size, std::move(deleter));
+  tensor(raw_tensor_)->ResetBuffer(buf, memory_size);
+}
+
+void Tensor::ReleaseExternalMemory() {
+  auto *raw = tensor(raw_tensor_);
+  if (raw->IsExternalMemory()) {
+    raw->ResetBuffer(std::make_shared<lite::Buffer>(), 0);
+  }
+}
+
 template <typename T>
 T *Tensor::mutable_data(TargetType type) const {
   return tensor(raw_tensor_)->mutable_data<T>(type);
@@ -368,6 +404,16 @@ void ConfigBase::set_threads(int threads) {
 #endif
 }
 
+void ConfigBase::set_huge_page_mode(HugePageMode mode) {
+  lite::host::SetHugePageMode(mode);
+  huge_page_mode_ = mode;
+}
+
+void ConfigBase::set_numa_policy(NumaPolicy policy) {
+  lite::host::SetNumaPolicy(policy);
+  numa_policy_ = policy;
+}
+
 void ConfigBase::set_metal_device(void *device) {
 #ifdef LITE_WITH_METAL
   metal_device_ = device;
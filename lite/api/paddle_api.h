@@ -19,6 +19,7 @@
 
 #ifndef PADDLE_LITE_API_H_  // NOLINT
 #define PADDLE_LITE_API_H_
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -64,6 +65,16 @@ struct LITE_API Tensor {
   // state
   // during the prediction process.
   void ShareExternalMemory(void* data, size_t memory_size, TargetType target);
+  // Same as above, but `deleter` is invoked with `data` once no tensor of the
+  // predictor refers to the memory any more, so the caller can hand the
+  // ownership of the memory over to the predictor.
+  void ShareExternalMemory(void* data,
+                           size_t memory_size,
+                           TargetType target,
+                           std::function<void(void*)> deleter);
+  // Stop using the shared external memory, so that the data copied into the
+  // tensor afterwards goes to a buffer owned by the tensor.
+  void ReleaseExternalMemory();
 
   template <typename T, TargetType type = TargetType::kHost>
   void CopyFromCpu(const T* data);
@@ -174,6 +185,11 @@ class LITE_API ConfigBase {
   std::string nnadapter_subgraph_partition_config_buffer_{};
   int device_id_{0};
   int x86_math_num_threads_ = 1;
+  // Skip shape inference while the input shapes don't change
+  bool static_shape_{false};
+  std::string embedding_mmap_dir_{""};
+  HugePageMode huge_page_mode_{LITE_HUGE_PAGE_NONE};
+  NumaPolicy numa_policy_{LITE_NUMA_NONE};
 
   std::string metal_path_;
   bool metal_use_mps_{false};
@@ -283,6 +299,33 @@ class LITE_API ConfigBase {
   // set x86_math_num_threads
   void set_x86_math_num_threads(int threads);
   int x86_math_num_threads() const;
+  // set static shape mode: after the first run, shape inference is skipped
+  // and the kernels are launched from a pre-built table until an input shape
+  // or lod changes. Models with an op whose output shapes may depend on the
+  // data of its inputs, e.g. linspace or top_k_v2, keep the normal path.
+  void set_static_shape(bool static_shape) { static_shape_ = static_shape; }
+  bool static_shape() const { return static_shape_; }
+  // set the directory for memory-mapped embedding tables: large tables of
+  // lookup_table are written into files of this directory once, and mapped
+  // read-only, so that all the processes serving the same model share the
+  // pages of the tables instead of holding private copies. The tables are
+  // still loaded in full from the model before being moved to the mappings:
+  // this lowers the resident memory of the processes once the predictors are
+  // created, not the peak while one is created.
+  void set_embedding_mmap_dir(const std::string& dir) {
+    embedding_mmap_dir_ = dir;
+  }
+  const std::string& embedding_mmap_dir() const { return embedding_mmap_dir_; }
+  // set the policy of the large host allocations, e.g. the weights and the
+  // activation workspaces. It applies to all the predictors of the process
+  // created after it is set. The memory is backed by huge pages, and placed
+  // on the NUMA node of the calling thread or interleaved over all the
+  // nodes. Where the system does not support them, the memory is allocated
+  // as usual.
+  void set_huge_page_mode(HugePageMode mode);
+  HugePageMode huge_page_mode() const { return huge_page_mode_; }
+  void set_numa_policy(NumaPolicy policy);
+  NumaPolicy numa_policy() const { return numa_policy_; }
 
   void set_metal_lib_path(const std::string& path);
   void set_metal_use_mps(bool flag);
@@ -325,6 +368,9 @@ class LITE_API CxxConfig : public ConfigBase {
   std::vector<std::string> passes_internal_{};
   bool quant_model_{false};  // Enable post_quant_dynamic in opt
   QuantType quant_type_{QuantType::QUANT_INT16};
+  bool calibration_mode_{false};  // Collect the int8 scales while running
+  CalibrationMethod calibration_method_{CalibrationMethod::CALIB_KL};
+  float calibration_percentile_{0.9999f};
   bool sparse_model_{false};  // Enable sparse_conv_detect_pass in opt
   float sparse_threshold_{0.6f};
   std::map<int, std::vector<std::shared_ptr<void>>>
@@ -441,6 +487,29 @@ class LITE_API CxxConfig : public ConfigBase {
   void set_quant_type(QuantType quant_type) { quant_type_ = quant_type; }
   QuantType quant_type() const { return quant_type_; }
 
+  // Post-training quantization calibration. In the calibration mode, the
+  // predictor runs the fp32 model and collects the statistics of the
+  // activations of the quantizable ops in every Run(). SaveOptimizedModel()
+  // computes the int8 scales with the calibration method, and saves the model
+  // quantized with these scales instead of the fp32 model.
+  // The calibration settings are passed to the optimizer through its global
+  // passes, so creating a predictor in this mode, or saving its model, isn't
+  // thread safe with building other predictors at the same time.
+  void set_calibration_mode(bool calibration_mode) {
+    calibration_mode_ = calibration_mode;
+  }
+  bool calibration_mode() const { return calibration_mode_; }
+  void set_calibration_method(CalibrationMethod calibration_method) {
+    calibration_method_ = calibration_method;
+  }
+  CalibrationMethod calibration_method() const { return calibration_method_; }
+  // The ratio of the values which are not clipped by the threshold, only for
+  // CalibrationMethod::CALIB_PERCENTILE.
+  void set_calibration_percentile(float calibration_percentile) {
+    calibration_percentile_ = calibration_percentile;
+  }
+  float calibration_percentile() const { return calibration_percentile_; }
+
   void set_sparse_model(bool sparse_model) { sparse_model_ = sparse_model; }
   bool sparse_model() const { return sparse_model_; }
   void set_sparse_threshold(float sparse_threshold) {
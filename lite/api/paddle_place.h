@@ -113,6 +113,18 @@ typedef enum {
   CL_PRECISION_FP16 = 2
 } CLPrecisionType;
 
+typedef enum {
+  LITE_HUGE_PAGE_NONE = 0,
+  LITE_HUGE_PAGE_TRANSPARENT = 1,  // madvise(MADV_HUGEPAGE)
+  LITE_HUGE_PAGE_EXPLICIT = 2      // MAP_HUGETLB, or transparent if it fails
+} HugePageMode;
+
+typedef enum {
+  LITE_NUMA_NONE = 0,
+  LITE_NUMA_LOCAL = 1,  // preferred on the node of the configuring thread
+  LITE_NUMA_INTERLEAVE = 2
+} NumaPolicy;
+
 typedef enum { MLU_220 = 0, MLU_270 = 1 } MLUCoreVersion;
 
 enum class ActivationType : int {
@@ -170,6 +182,14 @@ enum class QuantType : int {
   QUANT_INT16,
 };
 
+// The methods to compute the thresholds of the activations in the
+// post-training quantization calibration.
+enum class CalibrationMethod : int {
+  CALIB_ABS_MAX,
+  CALIB_KL,
+  CALIB_PERCENTILE,
+};
+
 template <typename T>
 struct PrecisionTypeTrait {
   constexpr static PrecisionType Type() { return PrecisionType::kUnk; }
@@ -256,7 +256,11 @@ void BindLiteTensor(py::module *m) {
   py::class_<Tensor> tensor(*m, "Tensor");
 
   tensor.def("resize", &Tensor::Resize)
-      .def("numpy", [](Tensor &self) { return TensorToPyArray(self); })
+      .def("numpy",
+           [](py::object self, bool copy) {
+             return TensorToPyArray(self.cast<const Tensor &>(), self, copy);
+           },
+           py::arg("copy") = false)
       .def("shape", &Tensor::shape)
       .def("target", &Tensor::target)
       .def("precision", &Tensor::precision)
@@ -265,7 +269,8 @@ void BindLiteTensor(py::module *m) {
       .def("from_numpy",
            SetTensorFromPyArray,
            py::arg("array"),
-           py::arg("place") = TargetType::kHost);
+           py::arg("place") = TargetType::kHost)
+      .def("share_external_data", ShareTensorWithPyArray, py::arg("array"));
 
 #define DO_GETTER_ONCE(data_type__, name__)                           \
   tensor.def(#name__, [=](Tensor &self) -> std::vector<data_type__> { \
@@ -283,6 +288,7 @@ void BindLiteTensor(py::module *m) {
       [](Tensor &self,                                                   \
          const std::vector<data_type__> &data,                           \
          TargetType type = TargetType::kHost) {                          \
+        self.ReleaseExternalMemory();                                    \
         if (type == TargetType::kHost || type == TargetType::kARM) {     \
           self.CopyFromCpu<data_type__, TargetType::kHost>(data.data()); \
         } else if (type == TargetType::kCUDA) {                          \
@@ -309,9 +315,11 @@ void BindLiteTensor(py::module *m) {
 void BindLiteCxxPredictor(py::module *m) {
   py::class_<CxxPaddleApiImpl>(*m, "CxxPredictor")
       .def(py::init<>())
-      .def("get_input", &CxxPaddleApiImpl::GetInput)
-      .def("get_output", &CxxPaddleApiImpl::GetOutput)
-      .def("run", &CxxPaddleApiImpl::Run)
+      .def("get_input", &CxxPaddleApiImpl::GetInput, py::keep_alive<0, 1>())
+      .def("get_output", &CxxPaddleApiImpl::GetOutput, py::keep_alive<0, 1>())
+      .def("run",
+           &CxxPaddleApiImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_version", &CxxPaddleApiImpl::GetVersion)
       .def("save_optimized_model",
            [](CxxPaddleApiImpl &self, const std::string &output_dir) {
@@ -324,9 +332,11 @@ void BindLiteCxxPredictor(py::module *m) {
 void BindLiteLightPredictor(py::module *m) {
   py::class_<LightPredictorImpl>(*m, "LightPredictor")
       .def(py::init<>())
-      .def("get_input", &LightPredictorImpl::GetInput)
-      .def("get_output", &LightPredictorImpl::GetOutput)
-      .def("run", &LightPredictorImpl::Run)
+      .def("get_input", &LightPredictorImpl::GetInput, py::keep_alive<0, 1>())
+      .def("get_output", &LightPredictorImpl::GetOutput, py::keep_alive<0, 1>())
+      .def("run",
+           &LightPredictorImpl::Run,
+           py::call_guard<py::gil_scoped_release>())
       .def("get_version", &LightPredictorImpl::GetVersion);
 }
 
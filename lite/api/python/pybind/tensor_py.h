@@ -71,9 +71,12 @@ inline std::string TensorDTypeToPyDTypeStr(PrecisionType type) {
 
 ////////////////////////////////////////////////////////////////
 // Function Name: TensorToPyArray
-// Usage: Transform tensor's data into numpy array
+// Usage: Transform tensor's data into numpy array. Unless
+//        need_deep_copy is set, the array is a view of the tensor
+//        that keeps `base` alive and is overwritten by the next run.
 ////////////////////////////////////////////////////////////////
 inline py::array TensorToPyArray(const Tensor &tensor,
+                                 py::handle base,
                                  bool need_deep_copy = false) {
   if (!tensor.IsInitialized()) {
     return py::array();
@@ -94,7 +97,12 @@ inline py::array TensorToPyArray(const Tensor &tensor,
 
   const void *tensor_buf_ptr = static_cast<const void *>(tensor.data<int8_t>());
   std::string py_dtype_str = TensorDTypeToPyDTypeStr(tensor.precision());
-  auto base = py::cast(std::move(tensor));
+  if (need_deep_copy) {
+    return py::array(py::dtype(py_dtype_str.c_str()),
+                     py_dims,
+                     py_strides,
+                     const_cast<void *>(tensor_buf_ptr));
+  }
   return py::array(py::dtype(py_dtype_str.c_str()),
                    py_dims,
                    py_strides,
@@ -118,6 +126,8 @@ void SetTensorFromPyArrayT(
   }
   self->Resize(dims);
 
+  // Copy into a buffer of the tensor, not into an array shared before.
+  self->ReleaseExternalMemory();
   auto dst = self->mutable_data<T>(place);
   std::memcpy(dst, array.data(), array.nbytes());
 }
@@ -160,6 +170,65 @@ void SetTensorFromPyArray(Tensor *self,
   }
 }
 
+////////////////////////////////////////////////////////////////
+// Function Name: ShareTensorWithPyArrayT
+// Usage: Let tensor use the memory of numpy array without copy,
+//        the array is kept alive until the tensor releases it.
+////////////////////////////////////////////////////////////////
+template <typename T>
+void ShareTensorWithPyArrayT(Tensor *self, const py::array &array) {
+  std::vector<int64_t> dims;
+  dims.reserve(array.ndim());
+  for (decltype(array.ndim()) i = 0; i < array.ndim(); ++i) {
+    dims.push_back(static_cast<int64_t>(array.shape()[i]));
+  }
+  self->Resize(dims);
+
+  // The holder may be released by a thread running the predictor without
+  // the GIL, e.g. when the input is shared again during a run.
+  auto *holder = new py::object(array);
+  self->ShareExternalMemory(const_cast<void *>(array.data()),
+                            array.nbytes(),
+                            TargetType::kHost,
+                            [holder](void *) {
+                              py::gil_scoped_acquire acquire;
+                              delete holder;
+                            });
+  self->SetPrecision(lite_api::PrecisionTypeTrait<T>::Type());
+}
+
+////////////////////////////////////////////////////////////////
+// Function Name: ShareTensorWithPyArray
+// Usage: Share the memory of a C-contiguous numpy array with
+//        tensor, other arrays are copied as from_numpy does.
+////////////////////////////////////////////////////////////////
+void ShareTensorWithPyArray(Tensor *self, const py::object &obj) {
+  auto array = obj.cast<py::array>();
+  if (!(array.flags() & py::array::c_style) || array.nbytes() == 0) {
+    SetTensorFromPyArray(self, obj, TargetType::kHost);
+    return;
+  }
+  if (py::isinstance<py::array_t<float>>(array)) {
+    ShareTensorWithPyArrayT<float>(self, array);
+  } else if (py::isinstance<py::array_t<int>>(array)) {
+    ShareTensorWithPyArrayT<int>(self, array);
+  } else if (py::isinstance<py::array_t<int64_t>>(array)) {
+    ShareTensorWithPyArrayT<int64_t>(self, array);
+  } else if (py::isinstance<py::array_t<double>>(array)) {
+    ShareTensorWithPyArrayT<double>(self, array);
+  } else if (py::isinstance<py::array_t<int8_t>>(array)) {
+    ShareTensorWithPyArrayT<int8_t>(self, array);
+  } else if (py::isinstance<py::array_t<int16_t>>(array)) {
+    ShareTensorWithPyArrayT<int16_t>(self, array);
+  } else if (py::isinstance<py::array_t<uint8_t>>(array)) {
+    ShareTensorWithPyArrayT<uint8_t>(self, array);
+  } else if (py::isinstance<py::array_t<bool>>(array)) {
+    ShareTensorWithPyArrayT<bool>(self, array);
+  } else {
+    SetTensorFromPyArray(self, obj, TargetType::kHost);
+  }
+}
+
 }  // namespace pybind
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,249 @@
+# Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import shutil
+import struct
+import tempfile
+import threading
+import unittest
+
+import numpy as np
+from paddlelite.lite import *
+
+# framework.proto enums
+_FP32 = 5
+_LOD_TENSOR = 7
+_FEED_MINIBATCH = 9
+_FETCH_LIST = 10
+_ATTR_INT = 0
+_ATTR_FLOAT = 1
+_ATTR_BOOLEAN = 6
+
+
+def _varint(value):
+    # negative int32/int64 are encoded as their 64-bit two's complement
+    value &= (1 << 64) - 1
+    out = bytearray()
+    while value > 0x7f:
+        out.append((value & 0x7f) | 0x80)
+        value >>= 7
+    out.append(value)
+    return bytes(out)
+
+
+def _int(field, value):
+    return _varint(field << 3) + _varint(value)
+
+
+def _float(field, value):
+    return _varint(field << 3 | 5) + struct.pack("<f", value)
+
+
+def _message(field, data):
+    if not isinstance(data, bytes):
+        data = data.encode("utf-8")
+    return _varint(field << 3 | 2) + _varint(len(data)) + data
+
+
+def _var(name, var_type, dims=None):
+    if dims is None:
+        type_desc = _int(1, var_type)
+        persistable = 1
+    else:
+        tensor = _int(1, _FP32) + b"".join(_int(2, d) for d in dims)
+        type_desc = _int(1, var_type) + _message(3, _message(1, tensor))
+        persistable = 0
+    return _message(1, name) + _message(2, type_desc) + _int(3, persistable)
+
+
+def _op(op_type, inputs, outputs, attrs):
+    def slots(field, args):
+        return b"".join(
+            _message(field, _message(1, k) + _message(2, v))
+            for k, v in sorted(args.items()))
+
+    def attr(name, value):
+        if isinstance(value, bool):
+            return _int(2, _ATTR_BOOLEAN) + _int(10, value)
+        if isinstance(value, int):
+            return _int(2, _ATTR_INT) + _int(3, value)
+        return _int(2, _ATTR_FLOAT) + _float(4, value)
+
+    return (slots(1, inputs) + slots(2, outputs) + _message(3, op_type) +
+            b"".join(
+                _message(4, _message(1, k) + attr(k, v))
+                for k, v in sorted(attrs.items())))
+
+
+def save_scale_relu_model(model_dir):
+    """Saves y = relu(2 * x - 1), with x of [-1, 3, 224, 224] and no params."""
+    dims = [-1, 3, 224, 224]
+    block_vars = [
+        _var("feed", _FEED_MINIBATCH), _var("fetch", _FETCH_LIST),
+        _var("x", _LOD_TENSOR, dims), _var("a", _LOD_TENSOR, dims),
+        _var("y", _LOD_TENSOR, dims)
+    ]
+    ops = [
+        _op("feed", {"X": "feed"}, {"Out": "x"}, {"col": 0}),
+        _op("scale", {"X": "x"}, {"Out": "a"},
+            {"scale": 2.0,
+             "bias": -1.0,
+             "bias_after_scale": True}),
+        _op("relu", {"X": "a"}, {"Out": "y"}, {}),
+        _op("fetch", {"X": "y"}, {"Out": "fetch"}, {"col": 0}),
+    ]
+    block = (_int(1, 0) + _int(2, -1) + b"".join(
+        _message(3, v) for v in block_vars) + b"".join(
+            _message(4, op) for op in ops))
+    with open(os.path.join(model_dir, "__model__"), "wb") as f:
+        f.write(_message(1, block))
+
+
+def setUpModule():
+    global _model_dir
+    _model_dir = tempfile.mkdtemp()
+    save_scale_relu_model(_model_dir)
+
+
+def tearDownModule():
+    shutil.rmtree(_model_dir)
+
+
+def create_predictor():
+    config = CxxConfig()
+    config.set_model_dir(_model_dir)
+    config.set_valid_places([
+        Place(TargetType.X86, PrecisionType.FP32),
+        Place(TargetType.Host, PrecisionType.FP32)
+    ])
+    return create_paddle_predictor(config)
+
+
+def expected_output(x):
+    return np.maximum(2 * x - 1, 0)
+
+
+class ShareExternalDataTest(unittest.TestCase):
+    def setUp(self):
+        self.predictor = create_predictor()
+        self.tensor = self.predictor.get_input(0)
+
+    def test_share(self):
+        shared = np.random.rand(1, 3, 224, 224).astype("float32")
+        self.tensor.share_external_data(shared)
+        np.testing.assert_array_equal(self.tensor.numpy(), shared)
+        # the tensor reads the array in place
+        shared[0, 0, 0, 0] = 42.0
+        self.assertEqual(self.tensor.numpy()[0, 0, 0, 0], 42.0)
+
+    def test_share_then_copy(self):
+        shared = np.zeros([1, 3, 224, 224]).astype("float32")
+        self.tensor.share_external_data(shared)
+        copied = np.random.rand(1, 3, 224, 224).astype("float32")
+        self.tensor.from_numpy(copied)
+        np.testing.assert_array_equal(self.tensor.numpy(), copied)
+        # the copy must not have gone into the shared array
+        self.assertFalse(shared.any())
+
+    def test_share_then_larger_copy(self):
+        shared = np.zeros([1, 3, 224, 224]).astype("float32")
+        self.tensor.share_external_data(shared)
+        copied = np.random.rand(2, 3, 224, 224).astype("float32")
+        self.tensor.from_numpy(copied)
+        np.testing.assert_array_equal(self.tensor.numpy(), copied)
+        self.assertFalse(shared.any())
+        self.predictor.run()
+        np.testing.assert_allclose(
+            self.predictor.get_output(0).numpy(), expected_output(copied))
+
+    def test_share_then_set_data(self):
+        shared = np.zeros([1, 3, 224, 224]).astype("float32")
+        self.tensor.share_external_data(shared)
+        copied = np.random.rand(1, 3, 224, 224).astype("float32")
+        self.tensor.set_float_data(copied.flatten().tolist())
+        np.testing.assert_array_equal(self.tensor.numpy(), copied)
+        self.assertFalse(shared.any())
+
+    def test_copy_then_share_then_copy(self):
+        first = np.random.rand(1, 3, 224, 224).astype("float32")
+        self.tensor.from_numpy(first)
+        shared = np.zeros([1, 3, 224, 224]).astype("float32")
+        self.tensor.share_external_data(shared)
+        self.predictor.run()
+        self.tensor.from_numpy(first)
+        np.testing.assert_array_equal(self.tensor.numpy(), first)
+        self.assertFalse(shared.any())
+        self.predictor.run()
+        np.testing.assert_allclose(
+            self.predictor.get_output(0).numpy(), expected_output(first))
+
+
+class ConcurrentRunTest(unittest.TestCase):
+    def test_predictors_in_threads(self):
+        inputs = [
+            np.random.rand(2, 3, 224, 224).astype("float32") * 2 - 1
+            for _ in range(2)
+        ]
+        outputs = [None] * len(inputs)
+
+        def run(i):
+            predictor = create_predictor()
+            predictor.get_input(0).from_numpy(inputs[i])
+            for _ in range(20):
+                predictor.run()
+            outputs[i] = predictor.get_output(0).numpy()
+
+        threads = [
+            threading.Thread(target=run, args=(i, ))
+            for i in range(len(inputs))
+        ]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        for x, y in zip(inputs, outputs):
+            np.testing.assert_allclose(y, expected_output(x))
+
+    def test_run_releases_gil(self):
+        predictor = create_predictor()
+        predictor.get_input(0).from_numpy(
+            np.random.rand(32, 3, 224, 224).astype("float32"))
+        predictor.run()
+
+        # Counts the loops of this thread while another one is in run(),
+        # which holding the GIL would keep at zero.
+        def loops_during_run():
+            entered = threading.Event()
+            done = []
+
+            def run():
+                entered.set()
+                predictor.run()
+                done.append(True)
+
+            thread = threading.Thread(target=run)
+            thread.start()
+            entered.wait()
+            loops = 0
+            while not done:
+                loops += 1
+            thread.join()
+            return loops
+
+        self.assertTrue(any(loops_during_run() > 0 for _ in range(5)))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -15,6 +15,9 @@
 #include "lite/api/light_api.h"
 #include <gflags/gflags.h>
 #include <gtest/gtest.h>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 DEFINE_string(optimized_model, "", "");
 
@@ -99,5 +102,57 @@ TEST(LightAPI, loadNaiveBuffer) {
   }
 }
 
+static void FillInput(LightPredictor* predictor, float offset) {
+  auto* input_tensor = predictor->GetInput(0);
+  input_tensor->Resize(DDim(std::vector<int64_t>({100, 100})));
+  auto* data = input_tensor->mutable_data<float>();
+  for (int i = 0; i < 100 * 100; i++) {
+    data[i] = (i % 13) * 0.1f + offset;
+  }
+}
+
+static std::vector<float> RunOnce(LightPredictor* predictor, float offset) {
+  FillInput(predictor, offset);
+  predictor->Run();
+  const auto* output = predictor->GetOutput(0);
+  const float* raw_output = output->data<float>();
+  return std::vector<float>(raw_output, raw_output + output->numel());
+}
+
+// A clone shares the weights of its predictor but owns its feed and fetch
+// lists, so both can run at the same time on different inputs.
+TEST(LightAPI, clone) {
+  if (FLAGS_optimized_model.empty()) {
+    FLAGS_optimized_model = "lite_naive_model";
+  }
+  LightPredictor predictor(FLAGS_optimized_model, "", "");
+  auto clone = predictor.Clone();
+
+  ASSERT_EQ(clone->scope(), predictor.scope());
+  for (auto& name : predictor.scope()->LocalVarNames()) {
+    if (!predictor.scope()->FindLocalVar(name)->IsType<Tensor>()) continue;
+    EXPECT_EQ(clone->GetTensor(name), predictor.GetTensor(name)) << name;
+  }
+  EXPECT_NE(clone->GetInput(0), predictor.GetInput(0));
+
+  const auto expected_a = RunOnce(&predictor, 0.f);
+  const auto expected_b = RunOnce(clone.get(), 1.f);
+  ASSERT_NE(expected_a, expected_b);
+  EXPECT_EQ(RunOnce(&predictor, 0.f), expected_a);
+
+  std::vector<float> out_a;
+  std::vector<float> out_b;
+  for (int i = 0; i < 10; i++) {
+    std::thread thread_a(
+        [&predictor, &out_a] { out_a = RunOnce(&predictor, 0.f); });
+    std::thread thread_b(
+        [&clone, &out_b] { out_b = RunOnce(clone.get(), 1.f); });
+    thread_a.join();
+    thread_b.join();
+    EXPECT_EQ(out_a, expected_a);
+    EXPECT_EQ(out_b, expected_b);
+  }
+}
+
 }  // namespace lite
 }  // namespace paddle
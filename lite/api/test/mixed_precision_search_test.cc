@@ -0,0 +1,154 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/tools/mixed_precision_search.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite_api {
+
+static MixedPrecisionLayer MakeLayer(
+    const std::map<PrecisionType, float>& latency,
+    const std::map<PrecisionType, float>& error) {
+  MixedPrecisionLayer layer;
+  layer.type = "conv2d";
+  layer.latency = latency;
+  layer.error = error;
+  return layer;
+}
+
+// The model error of a plan is the sum of the errors of its lowered layers,
+// every plan tried is recorded.
+class AdditiveError {
+ public:
+  explicit AdditiveError(const std::map<std::string, float>& errors)
+      : errors_(errors) {}
+
+  float operator()(const MixedPrecisionPlan& plan) {
+    trials_.push_back(plan);
+    float error = 0.f;
+    for (auto& item : plan) {
+      if (item.second != PRECISION(kFloat)) error += errors_.at(item.first);
+    }
+    return error;
+  }
+
+  const std::vector<MixedPrecisionPlan>& trials() const { return trials_; }
+
+ private:
+  std::map<std::string, float> errors_;
+  std::vector<MixedPrecisionPlan> trials_;
+};
+
+// The layers saving the most time per unit of error are lowered first, and
+// no plan over the budget is kept.
+TEST(MixedPrecisionSearch, select_plan_within_budget) {
+  std::map<std::string, MixedPrecisionLayer> layers;
+  layers["a"] = MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kInt8), 4.f}},
+                          {{PRECISION(kInt8), 0.01f}});
+  layers["b"] = MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kInt8), 2.f}},
+                          {{PRECISION(kInt8), 0.04f}});
+  layers["c"] = MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kInt8), 9.f}},
+                          {{PRECISION(kInt8), 0.02f}});
+  AdditiveError model_error({{"a", 0.01f}, {"b", 0.04f}, {"c", 0.02f}});
+  float error = -1.f;
+  auto plan = SelectMixedPrecisionPlan(
+      layers,
+      {PRECISION(kInt8)},
+      0.045f,
+      [&model_error](const MixedPrecisionPlan& plan) {
+        return model_error(plan);
+      },
+      &error);
+
+  // a saves 600 ms per unit of error, b 200 and c 50.
+  ASSERT_EQ(model_error.trials().size(), 3u);
+  EXPECT_EQ(model_error.trials()[0].at("a"), PRECISION(kInt8));
+  EXPECT_EQ(model_error.trials()[1].at("b"), PRECISION(kInt8));
+  EXPECT_EQ(model_error.trials()[2].at("c"), PRECISION(kInt8));
+  EXPECT_EQ(plan.at("a"), PRECISION(kInt8));
+  EXPECT_EQ(plan.at("b"), PRECISION(kFloat));
+  EXPECT_EQ(plan.at("c"), PRECISION(kInt8));
+  EXPECT_FLOAT_EQ(error, 0.03f);
+  EXPECT_LE(error, 0.045f);
+}
+
+// A layer whose output error is unknown is tried after all the known ones,
+// however much time it saves.
+TEST(MixedPrecisionSearch, select_plan_unknown_error_last) {
+  std::map<std::string, MixedPrecisionLayer> layers;
+  layers["known_slow"] =
+      MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kFP16), 9.f}},
+                {{PRECISION(kFP16), 0.5f}});
+  layers["unknown_fast"] =
+      MakeLayer({{PRECISION(kFloat), 100.f}, {PRECISION(kFP16), 1.f}}, {});
+  layers["unknown_slow"] =
+      MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kFP16), 5.f}}, {});
+  AdditiveError model_error(
+      {{"known_slow", 0.f}, {"unknown_fast", 0.f}, {"unknown_slow", 0.f}});
+  float error = -1.f;
+  auto plan = SelectMixedPrecisionPlan(
+      layers,
+      {PRECISION(kFP16)},
+      1.f,
+      [&model_error](const MixedPrecisionPlan& plan) {
+        return model_error(plan);
+      },
+      &error);
+
+  ASSERT_EQ(model_error.trials().size(), 3u);
+  EXPECT_EQ(model_error.trials()[0].at("known_slow"), PRECISION(kFP16));
+  EXPECT_EQ(model_error.trials()[1].at("unknown_fast"), PRECISION(kFP16));
+  EXPECT_EQ(model_error.trials()[1].at("unknown_slow"), PRECISION(kFloat));
+  EXPECT_EQ(model_error.trials()[2].at("unknown_slow"), PRECISION(kFP16));
+  for (auto& item : plan) {
+    EXPECT_EQ(item.second, PRECISION(kFP16)) << item.first;
+  }
+  EXPECT_FLOAT_EQ(error, 0.f);
+}
+
+// A precision which isn't faster than fp32, or than the precision already
+// assigned, is never tried.
+TEST(MixedPrecisionSearch, select_plan_skip_slower_moves) {
+  std::map<std::string, MixedPrecisionLayer> layers;
+  layers["a"] = MakeLayer({{PRECISION(kFloat), 10.f},
+                           {PRECISION(kFP16), 4.f},
+                           {PRECISION(kInt8), 6.f}},
+                          {{PRECISION(kFP16), 0.01f}, {PRECISION(kInt8), 0.f}});
+  layers["b"] = MakeLayer({{PRECISION(kFloat), 10.f}, {PRECISION(kInt8), 12.f}},
+                          {{PRECISION(kInt8), 0.f}});
+  AdditiveError model_error({{"a", 0.01f}, {"b", 0.f}});
+  float error = -1.f;
+  auto plan = SelectMixedPrecisionPlan(
+      layers,
+      {PRECISION(kInt8), PRECISION(kFP16)},
+      0.1f,
+      [&model_error](const MixedPrecisionPlan& plan) {
+        return model_error(plan);
+      },
+      &error);
+
+  // a to int8 comes first, for its zero error, then a to fp16 saves more.
+  ASSERT_EQ(model_error.trials().size(), 2u);
+  EXPECT_EQ(model_error.trials()[0].at("a"), PRECISION(kInt8));
+  EXPECT_EQ(model_error.trials()[1].at("a"), PRECISION(kFP16));
+  EXPECT_EQ(plan.at("a"), PRECISION(kFP16));
+  EXPECT_EQ(plan.at("b"), PRECISION(kFloat));
+}
+
+}  // namespace lite_api
+}  // namespace paddle
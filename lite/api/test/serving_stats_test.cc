@@ -0,0 +1,70 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/tools/serving_stats.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+namespace paddle {
+namespace lite_api {
+
+TEST(ServingStats, percentile_nearest_rank) {
+  std::vector<double> latencies;
+  for (int i = 1; i <= 1000; ++i) latencies.push_back(i);
+  EXPECT_EQ(Percentile(latencies, 0.0), 1.0);
+  EXPECT_EQ(Percentile(latencies, 0.5), 500.0);
+  EXPECT_EQ(Percentile(latencies, 0.9), 900.0);
+  EXPECT_EQ(Percentile(latencies, 0.99), 990.0);
+  EXPECT_EQ(Percentile(latencies, 0.999), 999.0);
+  EXPECT_EQ(Percentile(latencies, 1.0), 1000.0);
+
+  // With fewer requests than 1 / (1 - q), the tail percentiles are the max.
+  const std::vector<double> few{3.0, 5.0, 8.0};
+  EXPECT_EQ(Percentile(few, 0.5), 5.0);
+  EXPECT_EQ(Percentile(few, 0.9), 8.0);
+  EXPECT_EQ(Percentile(few, 0.99), 8.0);
+  EXPECT_EQ(Percentile({4.0}, 0.5), 4.0);
+}
+
+// The intervals between the arrivals are exponential: of mean 1 / qps, and
+// of a standard deviation equal to their mean.
+TEST(ServingStats, poisson_arrivals) {
+  const int requests = 100000;
+  const double qps = 200.0;
+  auto arrivals = PoissonArrivals(requests, qps, 2021);
+  ASSERT_EQ(arrivals.size(), static_cast<size_t>(requests));
+  EXPECT_EQ(arrivals, PoissonArrivals(requests, qps, 2021));
+  EXPECT_NE(arrivals, PoissonArrivals(requests, qps, 2022));
+
+  double sum = 0.0;
+  double square_sum = 0.0;
+  double prev = 0.0;
+  for (double arrival : arrivals) {
+    ASSERT_GT(arrival, prev);
+    sum += arrival - prev;
+    square_sum += (arrival - prev) * (arrival - prev);
+    prev = arrival;
+  }
+  const double mean = sum / requests;
+  const double stddev = std::sqrt(square_sum / requests - mean * mean);
+  EXPECT_NEAR(mean, 1.0 / qps, 0.02 / qps);
+  EXPECT_NEAR(stddev, 1.0 / qps, 0.02 / qps);
+  EXPECT_NEAR(arrivals.back(), requests / qps, 0.02 * requests / qps);
+
+  EXPECT_TRUE(PoissonArrivals(0, qps, 2021).empty());
+}
+
+}  // namespace lite_api
+}  // namespace paddle
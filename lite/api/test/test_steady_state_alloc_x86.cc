@@ -0,0 +1,198 @@
+// Copyright (c) 2019 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/paddle_api.h"
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/api/paddle_use_passes.h"
+#include "lite/api/test/test_helper.h"
+#include "lite/utils/log/cp_logging.h"
+
+// Count every heap allocation made while `g_tracking` is set. On glibc the
+// malloc family is interposed through its internal entry points, elsewhere
+// only operator new is counted.
+static std::atomic<bool> g_tracking{false};
+static std::atomic<int64_t> g_allocs{0};
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) {
+  if (g_tracking) ++g_allocs;
+  return __libc_malloc(size);
+}
+void* calloc(size_t num, size_t size) {
+  if (g_tracking) ++g_allocs;
+  return __libc_calloc(num, size);
+}
+void* realloc(void* ptr, size_t size) {
+  if (g_tracking) ++g_allocs;
+  return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+void* operator new(size_t size) {
+#ifndef __GLIBC__
+  if (g_tracking) ++g_allocs;
+#endif
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return ::operator new(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+namespace paddle {
+namespace lite {
+
+TEST(SteadyStateAlloc, test_steady_state_alloc_x86) {
+  lite_api::CxxConfig config;
+  config.set_model_dir(FLAGS_model_dir);
+  config.set_valid_places({lite_api::Place{TARGET(kX86), PRECISION(kFloat)},
+                           lite_api::Place{TARGET(kHost), PRECISION(kFloat)}});
+  // The guarantee covers the single-threaded path. With more threads the
+  // Eigen expressions (softmax, activations...) are split into
+  // std::function tasks for the Eigen thread pool, which allocate.
+  config.set_threads(1);
+  config.set_static_shape(true);
+  auto predictor = lite_api::CreatePaddlePredictor(config);
+
+  auto input_tensor = predictor->GetInput(0);
+  std::vector<int64_t> input_shape{1, 3, FLAGS_im_height, FLAGS_im_width};
+  input_tensor->Resize(input_shape);
+  auto* data = input_tensor->mutable_data<float>();
+  int64_t input_num = 1;
+  for (auto dim : input_shape) {
+    input_num *= dim;
+  }
+  for (int64_t i = 0; i < input_num; i++) {
+    data[i] = 1;
+  }
+
+  // The first runs pick kernels, transform weights, build the frozen launch
+  // table and grow the workspaces.
+  for (int i = 0; i < std::max(FLAGS_warmup, 2); ++i) {
+    predictor->Run();
+  }
+
+  g_allocs = 0;
+  g_tracking = true;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    predictor->Run();
+  }
+  g_tracking = false;
+
+  LOG(INFO) << "heap allocations in " << FLAGS_repeats
+            << " steady-state runs: " << g_allocs.load();
+  EXPECT_EQ(g_allocs.load(), 0);
+}
+
+// feed -> scale -> relu -> fetch, with names longer than any small string
+// buffer, so that a run which copies a name allocates.
+static std::shared_ptr<cpp::ProgramDesc> LongNameProgram() {
+  const std::string prefix(64, 'v');
+  const std::string x = prefix + "_input";
+  const std::string a = prefix + "_scaled";
+  const std::string y = prefix + "_output";
+  auto program_desc = std::make_shared<cpp::ProgramDesc>();
+  auto* block = program_desc->AddBlock<cpp::BlockDesc>();
+  block->SetIdx(0);
+  block->SetParentIdx(-1);
+  auto add_var = [block](const std::string& name, VarDescAPI::Type type) {
+    auto* var = block->AddVar<cpp::VarDesc>();
+    var->SetName(name);
+    var->SetType(type);
+    var->SetPersistable(name == "feed" || name == "fetch");
+  };
+  add_var("feed", VarDescAPI::Type::FEED_MINIBATCH);
+  add_var("fetch", VarDescAPI::Type::FETCH_LIST);
+  for (auto& name : {x, a, y}) add_var(name, VarDescAPI::Type::LOD_TENSOR);
+  // Never written, stays a candidate tensor array on every run.
+  add_var(prefix + "_array", VarDescAPI::Type::LOD_TENSOR_ARRAY);
+
+  auto* feed = block->AddOp<cpp::OpDesc>();
+  feed->SetType("feed");
+  feed->SetInput("X", {"feed"});
+  feed->SetOutput("Out", {x});
+  feed->SetAttr("col", 0);
+  auto* scale = block->AddOp<cpp::OpDesc>();
+  scale->SetType("scale");
+  scale->SetInput("X", {x});
+  scale->SetOutput("Out", {a});
+  scale->SetAttr("scale", 2.f);
+  scale->SetAttr("bias", -1.f);
+  scale->SetAttr("bias_after_scale", true);
+  auto* relu = block->AddOp<cpp::OpDesc>();
+  relu->SetType("relu");
+  relu->SetInput("X", {a});
+  relu->SetOutput("Out", {y});
+  auto* fetch = block->AddOp<cpp::OpDesc>();
+  fetch->SetType("fetch");
+  fetch->SetInput("X", {y});
+  fetch->SetOutput("Out", {"fetch"});
+  fetch->SetAttr("col", 0);
+  return program_desc;
+}
+
+TEST(SteadyStateAlloc, test_steady_state_alloc_long_var_names) {
+  Predictor predictor;
+  predictor.Build(LongNameProgram(),
+                  {Place{TARGET(kX86), PRECISION(kFloat)},
+                   Place{TARGET(kHost), PRECISION(kFloat)}});
+  predictor.SetStaticShape(true);
+
+  // Small enough for the Eigen expressions to stay on the calling thread.
+  auto* input = predictor.GetInput(0);
+  input->Resize({1, 4, 4, 4});
+  auto* data = input->mutable_data<float>();
+  for (int64_t i = 0; i < input->numel(); i++) {
+    data[i] = static_cast<float>(i % 5) - 2.f;
+  }
+  for (int i = 0; i < 2; ++i) {
+    predictor.Run();
+  }
+
+  g_allocs = 0;
+  g_tracking = true;
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    predictor.Run();
+  }
+  g_tracking = false;
+
+  EXPECT_EQ(g_allocs.load(), 0);
+  auto* output = predictor.GetOutput(0);
+  ASSERT_EQ(output->numel(), input->numel());
+  for (int64_t i = 0; i < output->numel(); i++) {
+    EXPECT_FLOAT_EQ(output->data<float>()[i],
+                    std::max(2.f * data[i] - 1.f, 0.f));
+  }
+}
+
+}  // namespace lite
+}  // namespace paddle
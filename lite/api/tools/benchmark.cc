@@ -14,13 +14,20 @@
 
 #include "lite/api/tools/benchmark.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <numeric>
 #include <string>
+#include <thread>  // NOLINT
 #include <vector>
+#include "lite/api/tools/mixed_precision_search.h"
+#include "lite/api/tools/serving_stats.h"
 #include "lite/core/version.h"
 #include "lite/utils/timer.h"
 
@@ -42,25 +49,66 @@ int Benchmark(int argc, char** argv) {
     exit(0);
   }
 
-  // Get optimized model file if necessary
-  OutputOptModel(FLAGS_optimized_model_path);
-
   // Get input shapes
   auto input_shapes = lite::GetShapes(FLAGS_input_shape);
 
+  // Get optimized model file if necessary
+  if (FLAGS_mixed_precision_error_budget > 0) {
+    auto report = RunMixedPrecisionSearch(
+        FLAGS_optimized_model_path,
+        input_shapes.size(),
+        [&](Tensor* input, size_t idx) {
+          SetInput(input, input_shapes[idx], idx);
+        });
+    std::cout << report << std::endl;
+    StoreBenchmarkResult(report);
+  } else {
+    OutputOptModel(FLAGS_optimized_model_path);
+  }
+
   // Run
-  Run(FLAGS_optimized_model_path + ".nb", input_shapes);
+  if (FLAGS_serving_instances > 0) {
+    RunServing(FLAGS_optimized_model_path + ".nb", input_shapes);
+  } else {
+    Run(FLAGS_optimized_model_path + ".nb", input_shapes);
+  }
 
   return 0;
 }
 
-void Run(const std::string& model_file,
-         const std::vector<std::vector<int64_t>>& input_shapes) {
-  lite::Timer timer;
-  std::vector<float> perf_vct;
+void SetInput(Tensor* input_tensor,
+              const std::vector<int64_t>& input_shape,
+              size_t idx) {
+  input_tensor->Resize(input_shape);
+  // NOTE: Change input data type to other type as you need.
+  auto input_data = input_tensor->mutable_data<float>();
+  auto input_num = lite::ShapeProduction(input_shape);
+  if (FLAGS_input_data_path.empty()) {
+    for (auto j = 0; j < input_num; j++) {
+      input_data[j] = 1.f;
+    }
+  } else {
+    auto paths = lite::SplitString(FLAGS_input_data_path);
+    std::ifstream fs(paths[idx]);
+    if (!fs.is_open()) {
+      std::cerr << "Open input image " << paths[idx] << " error." << std::endl;
+    }
+    for (int k = 0; k < input_num; k++) {
+      fs >> input_data[k];
+    }
+    fs.close();
+  }
+}
 
-  // Set config and create predictor
-  timer.Start();
+void SetInputs(PaddlePredictor* predictor,
+               const std::vector<std::vector<int64_t>>& input_shapes) {
+  for (size_t i = 0; i < input_shapes.size(); i++) {
+    SetInput(predictor->GetInput(i).get(), input_shapes[i], i);
+  }
+}
+
+std::shared_ptr<PaddlePredictor> CreatePredictor(
+    const std::string& model_file) {
   MobileConfig config;
   config.set_model_from_file(model_file);
   config.set_threads(FLAGS_threads);
@@ -69,32 +117,21 @@ void Run(const std::string& model_file,
   // Set backend config info
   SetBackendConfig(config);
 
-  auto predictor = CreatePaddlePredictor(config);
+  return CreatePaddlePredictor(config);
+}
+
+void Run(const std::string& model_file,
+         const std::vector<std::vector<int64_t>>& input_shapes) {
+  lite::Timer timer;
+  std::vector<float> perf_vct;
+
+  // Set config and create predictor
+  timer.Start();
+  auto predictor = CreatePredictor(model_file);
   float init_time = timer.Stop();
 
   // Set inputs
-  for (size_t i = 0; i < input_shapes.size(); i++) {
-    auto input_tensor = predictor->GetInput(i);
-    input_tensor->Resize(input_shapes[i]);
-    // NOTE: Change input data type to other type as you need.
-    auto input_data = input_tensor->mutable_data<float>();
-    auto input_num = lite::ShapeProduction(input_shapes[i]);
-    if (FLAGS_input_data_path.empty()) {
-      for (auto j = 0; j < input_num; j++) {
-        input_data[j] = 1.f;
-      }
-    } else {
-      auto paths = lite::SplitString(FLAGS_input_data_path);
-      std::ifstream fs(paths[i]);
-      if (!fs.is_open()) {
-        std::cerr << "Open input image " << paths[i] << " error." << std::endl;
-      }
-      for (int k = 0; k < input_num; k++) {
-        fs >> input_data[k];
-      }
-      fs.close();
-    }
-  }
+  SetInputs(predictor.get(), input_shapes);
 
   // Warmup
   for (int i = 0; i < FLAGS_warmup; ++i) {
@@ -207,5 +244,166 @@ void Run(const std::string& model_file,
   StoreBenchmarkResult(ss.str());
 }
 
+// The resident and the peak resident memory of the process in kB, 0 where
+// they are unknown.
+void GetMemoryUsage(int64_t* rss, int64_t* peak) {
+  *rss = 0;
+  *peak = 0;
+#ifdef __linux__
+  std::ifstream fs("/proc/self/status");
+  std::string line;
+  while (std::getline(fs, line)) {
+    if (line.compare(0, 6, "VmRSS:") == 0) {
+      *rss = std::stoll(line.substr(6));
+    } else if (line.compare(0, 6, "VmHWM:") == 0) {
+      *peak = std::stoll(line.substr(6));
+    }
+  }
+#endif
+}
+
+// Lends the predictors to the client threads, one request at a time.
+class PredictorPool {
+ public:
+  explicit PredictorPool(
+      const std::vector<std::shared_ptr<PaddlePredictor>>& predictors)
+      : free_(predictors) {}
+
+  std::shared_ptr<PaddlePredictor> Acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !free_.empty(); });
+    auto predictor = free_.back();
+    free_.pop_back();
+    return predictor;
+  }
+
+  void Release(const std::shared_ptr<PaddlePredictor>& predictor) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      free_.push_back(predictor);
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::vector<std::shared_ptr<PaddlePredictor>> free_;
+};
+
+void RunServing(const std::string& model_file,
+                const std::vector<std::vector<int64_t>>& input_shapes) {
+  using Clock = std::chrono::steady_clock;
+  auto ms_since = [](Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+  };
+  const int instances = FLAGS_serving_instances;
+  const int client_threads = FLAGS_serving_client_threads > 0
+                                 ? FLAGS_serving_client_threads
+                                 : instances;
+  const int requests = std::max(FLAGS_serving_requests, 1);
+  const bool open_loop = FLAGS_serving_qps > 0.0;
+
+  // Create the predictors, the memory of each one is measured after its
+  // first run, when the workspaces of its kernels are allocated.
+  int64_t rss = 0;
+  int64_t peak = 0;
+  GetMemoryUsage(&rss, &peak);
+  const int64_t rss_before = rss;
+  std::vector<std::shared_ptr<PaddlePredictor>> predictors;
+  std::vector<int64_t> instance_kb;
+  for (int i = 0; i < instances; ++i) {
+    int64_t rss_prev = rss;
+    if (FLAGS_serving_clone && i > 0) {
+      predictors.push_back(predictors.front()->Clone());
+    } else {
+      predictors.push_back(CreatePredictor(model_file));
+    }
+    SetInputs(predictors.back().get(), input_shapes);
+    for (int j = 0; j < std::max(FLAGS_warmup, 1); ++j) {
+      predictors.back()->Run();
+    }
+    GetMemoryUsage(&rss, &peak);
+    instance_kb.push_back(rss - rss_prev);
+  }
+  const int64_t rss_loaded = rss;
+
+  // Closed loop: a thread sends a request as soon as it is free.
+  // Open loop: the k-th request arrives at arrivals[k], and waits in the
+  // queue until a thread and a predictor are free.
+  std::vector<Clock::duration> arrivals(requests, Clock::duration::zero());
+  if (open_loop) {
+    auto seconds = PoissonArrivals(requests, FLAGS_serving_qps, 2021);
+    for (int k = 0; k < requests; ++k) {
+      arrivals[k] = std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(seconds[k]));
+    }
+  }
+  std::vector<double> latencies(requests, 0.0);
+  std::atomic<int> next{0};
+  PredictorPool pool(predictors);
+  const auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < client_threads; ++t) {
+    threads.emplace_back([&] {
+      for (int k = next++; k < requests; k = next++) {
+        auto begin = Clock::now();
+        if (open_loop) {
+          begin = start + arrivals[k];
+          std::this_thread::sleep_until(begin);
+        }
+        auto predictor = pool.Acquire();
+        predictor->Run();
+        pool.Release(predictor);
+        latencies[k] = ms_since(begin, Clock::now());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const double duration = ms_since(start, Clock::now()) / 1000.0;
+  GetMemoryUsage(&rss, &peak);
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double q) { return Percentile(latencies, q); };
+  const double avg =
+      std::accumulate(latencies.begin(), latencies.end(), 0.0) / requests;
+
+  std::stringstream ss;
+  ss.precision(3);
+  ss << std::fixed;
+  ss << "{\n";
+  ss << "  \"model\": \"" << model_file << "\",\n";
+  ss << "  \"backend\": \"" << FLAGS_backend << "\",\n";
+  ss << "  \"version\": \"" << lite::version() << "\",\n";
+  ss << "  \"input_shape\": \"" << FLAGS_input_shape << "\",\n";
+  ss << "  \"instances\": " << instances << ",\n";
+  ss << "  \"clone\": " << (FLAGS_serving_clone ? "true" : "false") << ",\n";
+  ss << "  \"threads_per_instance\": " << FLAGS_threads << ",\n";
+  ss << "  \"client_threads\": " << client_threads << ",\n";
+  ss << "  \"mode\": \"" << (open_loop ? "open_loop" : "closed_loop")
+     << "\",\n";
+  ss << "  \"target_qps\": " << FLAGS_serving_qps << ",\n";
+  ss << "  \"requests\": " << requests << ",\n";
+  ss << "  \"duration_s\": " << duration << ",\n";
+  ss << "  \"throughput_qps\": " << requests / duration << ",\n";
+  ss << "  \"latency_ms\": {\"min\": " << latencies.front()
+     << ", \"avg\": " << avg << ", \"p50\": " << percentile(0.5)
+     << ", \"p90\": " << percentile(0.9) << ", \"p99\": " << percentile(0.99)
+     << ", \"p999\": " << percentile(0.999)
+     << ", \"max\": " << latencies.back() << "},\n";
+  ss << "  \"memory_kb\": {\"before_load\": " << rss_before
+     << ", \"loaded\": " << rss_loaded << ", \"final\": " << rss
+     << ", \"peak\": " << peak << ", \"per_instance\": [";
+  for (size_t i = 0; i < instance_kb.size(); ++i) {
+    ss << (i > 0 ? ", " : "") << instance_kb[i];
+  }
+  ss << "]}\n";
+  ss << "}\n";
+  std::cout << ss.str();
+  StoreBenchmarkResult(ss.str());
+}
+
 }  // namespace lite_api
 }  // namespace paddle
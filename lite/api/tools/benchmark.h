@@ -34,8 +34,16 @@ namespace paddle {
 namespace lite_api {
 
 int Benchmark(int argc, char** argv);
+// Fills the idx-th input with ones, or with the idx-th of --input_data_path.
+void SetInput(Tensor* input_tensor,
+              const std::vector<int64_t>& input_shape,
+              size_t idx);
 void Run(const std::string& model_file,
          const std::vector<std::vector<int64_t>>& input_shape);
+// Runs several predictors at once from several threads, and prints the
+// throughput, the latency percentiles and the memory usage as JSON.
+void RunServing(const std::string& model_file,
+                const std::vector<std::vector<int64_t>>& input_shape);
 
 #ifdef __ANDROID__
 std::string GetDeviceInfo() {
@@ -119,6 +127,14 @@ bool CheckFlagsValid() {
       ret = false;
     }
   }
+  bool is_cpu_backend = FLAGS_backend == "arm" || FLAGS_backend == "x86";
+  if (FLAGS_mixed_precision_error_budget > 0 &&
+      (!is_origin_model || !is_cpu_backend)) {
+    std::cerr << "The mixed precision search needs the origin model and "
+                 "--backend=arm or --backend=x86!"
+              << std::endl;
+    ret = false;
+  }
 
   return ret;
 }
@@ -158,6 +174,15 @@ const std::string PrintUsage() {
         "--model_file=/path/to/mobilenetv1/model "
         "--param_file=/path/to/mobilenetv1/params "
         "--input_shape=1,3,224,224 --backend=x86 \n\n"
+        "  For serving load    : ./benchmark_bin "
+        "--optimized_model_path=/path/to/mbilenetv1_opt.nb "
+        "--input_shape=1,3,224,224 --backend=x86 --threads=2 "
+        "--serving_instances=4 --serving_clone=true --serving_qps=200 \n\n"
+        "  For mixed precision : ./benchmark_bin "
+        "--uncombined_model_dir=/path/to/mobilenetv1 "
+        "--optimized_model_path=/path/to/mobilenetv1_mixed "
+        "--input_shape=1,3,224,224 --backend=arm "
+        "--mixed_precision_error_budget=0.01 \n\n"
         "For detailed usage info: ./benchmark_bin --help \n\n";
 
   return ss.str();
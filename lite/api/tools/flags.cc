@@ -56,6 +56,21 @@ DEFINE_bool(enable_op_time_profile, false, enable_op_time_profile_msg);
 DEFINE_bool(enable_memory_profile, false, enable_memory_profile_msg);
 DEFINE_int32(memory_check_interval_ms, 5, memory_check_interval_ms_msg);
 
+// Serving options
+DEFINE_int32(serving_instances, 0, serving_instances_msg);
+DEFINE_bool(serving_clone, false, serving_clone_msg);
+DEFINE_int32(serving_client_threads, 0, serving_client_threads_msg);
+DEFINE_int32(serving_requests, 1000, serving_requests_msg);
+DEFINE_double(serving_qps, 0.0, serving_qps_msg);
+
+// Mixed precision search options
+DEFINE_double(mixed_precision_error_budget,
+              0.0,
+              mixed_precision_error_budget_msg);
+DEFINE_string(mixed_precision_candidates,
+              "int8,fp16",
+              mixed_precision_candidates_msg);
+
 // Others
 
 }  // namespace lite_api
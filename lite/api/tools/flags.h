@@ -103,6 +103,36 @@ static const char memory_check_interval_ms_msg[] =
     "footprint checks. This is only used when "
     "--enable_memory_profile is set to true. Not supported yet.";
 
+// Serving options
+static const char serving_instances_msg[] =
+    "Run the serving benchmark with this number of predictors instead, "
+    "each of them with --threads threads. 0 for the single predictor "
+    "benchmark.";
+static const char serving_clone_msg[] =
+    "Create the predictors of the serving benchmark by cloning the first "
+    "one, so that they share the weights.";
+static const char serving_client_threads_msg[] =
+    "The number of the threads sending the requests in the serving "
+    "benchmark. A request waits for a free predictor if there are more "
+    "threads than predictors. 0 for one thread per predictor.";
+static const char serving_requests_msg[] =
+    "The number of the requests sent in the serving benchmark.";
+static const char serving_qps_msg[] =
+    "The target queries per second of the serving benchmark. The requests "
+    "arrive as a Poisson process (open loop), and their latency includes "
+    "the time waiting for a thread. 0 for sending a new request as soon as "
+    "a thread is free (closed loop).";
+
+// Mixed precision search options
+static const char mixed_precision_error_budget_msg[] =
+    "Search the precision of every conv2d, depthwise_conv2d, "
+    "conv2d_transpose, fc and mul of the origin model, and save the fastest "
+    "assignment whose relative L2 error of the outputs stays in this budget "
+    "to --optimized_model_path. 0 for no search.";
+static const char mixed_precision_candidates_msg[] =
+    "The precisions the search may lower the layers to, separated by ','. "
+    "Available: int8, fp16.";
+
 // Others
 
 // Model options
@@ -138,6 +168,17 @@ DECLARE_bool(enable_op_time_profile);
 DECLARE_bool(enable_memory_profile);
 DECLARE_int32(memory_check_interval_ms);
 
+// Serving options
+DECLARE_int32(serving_instances);
+DECLARE_bool(serving_clone);
+DECLARE_int32(serving_client_threads);
+DECLARE_int32(serving_requests);
+DECLARE_double(serving_qps);
+
+// Mixed precision search options
+DECLARE_double(mixed_precision_error_budget);
+DECLARE_string(mixed_precision_candidates);
+
 // Others
 
 }  // namespace lite_api
@@ -0,0 +1,437 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/api/tools/mixed_precision_search.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "lite/api/cxx_api.h"
+#include "lite/api/tools/flags.h"
+#include "lite/core/calibrator.h"
+#include "lite/core/device_info.h"
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include "lite/core/optimizer/mir/pass_manager.h"
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
+#include "lite/utils/string.h"
+
+namespace paddle {
+namespace lite_api {
+
+namespace {
+
+using Plan = MixedPrecisionPlan;
+using Layer = MixedPrecisionLayer;
+using Outputs = std::map<std::string, std::vector<float>>;
+
+// The results of profiling a predictor, the layers are keyed by the name of
+// their outputs, which is what MixedPrecisionPass matches.
+struct Profile {
+  std::map<std::string, std::string> types;
+  std::map<std::string, PrecisionType> precisions;
+  std::map<std::string, float> latency;
+  Outputs layer_outputs;
+  Outputs model_outputs;
+};
+
+// Lowering a layer to a precision, saving `saving` ms with the relative
+// error `error` of its output, which is unknown if `has_error` is false.
+struct Move {
+  std::string layer;
+  PrecisionType precision;
+  float saving;
+  float error;
+  bool has_error;
+};
+
+const char* PrecisionName(PrecisionType precision) {
+  switch (precision) {
+    case PRECISION(kInt8):
+      return "int8";
+    case PRECISION(kFP16):
+      return "fp16";
+    default:
+      return "fp32";
+  }
+}
+
+std::vector<PrecisionType> Candidates() {
+  std::vector<PrecisionType> candidates;
+  for (auto& candidate : lite::Split(FLAGS_mixed_precision_candidates, ",")) {
+    if (candidate == "int8") {
+      candidates.push_back(PRECISION(kInt8));
+    } else if (candidate == "fp16") {
+      candidates.push_back(PRECISION(kFP16));
+    } else {
+      LOG(FATAL) << "Unsupported mixed precision candidate: " << candidate;
+    }
+  }
+  return candidates;
+}
+
+std::vector<Place> SearchPlaces(const std::vector<PrecisionType>& precisions) {
+  auto target = FLAGS_backend == "x86" ? TARGET(kX86) : TARGET(kARM);
+  std::vector<Place> places;
+  for (auto precision : precisions) {
+    places.emplace_back(target, precision);
+  }
+  places.emplace_back(target, PRECISION(kFloat));
+  places.emplace_back(target, PRECISION(kInt32));
+  places.emplace_back(target, PRECISION(kInt64));
+  places.emplace_back(target, PRECISION(kAny));
+  return places;
+}
+
+// Build the origin model with the precisions of the layers in `plan`, the
+// layers out of it, and all of them if it is empty, run in fp32.
+std::unique_ptr<lite::Predictor> BuildPredictor(
+    const std::vector<Place>& places,
+    const Plan& plan,
+    const std::map<std::string, float>& thresholds,
+    bool memory_optimize) {
+  using lite::mir::MemoryOptimizePass;
+  using lite::mir::MixedPrecisionPass;
+  using lite::mir::PostQuantStaticPass;
+  using lite::mir::ScopedPassSetting;
+  ScopedPassSetting<MixedPrecisionPass, Plan> precisions(
+      "mixed_precision_pass",
+      &MixedPrecisionPass::precisions,
+      &MixedPrecisionPass::SetPrecisions,
+      plan);
+  ScopedPassSetting<PostQuantStaticPass, std::map<std::string, float>>
+      quant_thresholds("post_quant_static_pass",
+                       &PostQuantStaticPass::thresholds,
+                       &PostQuantStaticPass::SetThresholds,
+                       thresholds);
+  // The outputs of the layers are compared after the runs, so that they
+  // must not share the memory when profiling.
+  ScopedPassSetting<MemoryOptimizePass, bool> reuse(
+      "memory_optimize_pass",
+      &MemoryOptimizePass::enabled,
+      &MemoryOptimizePass::SetEnabled,
+      memory_optimize);
+
+  CxxConfig config;
+  if (!FLAGS_uncombined_model_dir.empty()) {
+    config.set_model_dir(FLAGS_uncombined_model_dir);
+  } else {
+    config.set_model_file(FLAGS_model_file);
+    config.set_param_file(FLAGS_param_file);
+  }
+  std::unique_ptr<lite::Predictor> predictor(new lite::Predictor);
+  predictor->Build(
+      config, places, {"mixed_precision_pass", "post_quant_static_pass"});
+  return predictor;
+}
+
+// Copy a tensor as fp32, the int8 outputs of the layers are dequantized with
+// their scales. Return false if it can't be compared with the fp32 one.
+bool CopyAsFloat(const lite::Tensor& tensor,
+                 const lite::OpInfo& op_info,
+                 const std::string& name,
+                 std::vector<float>* out) {
+  auto size = static_cast<size_t>(tensor.numel());
+  if (tensor.precision() == PRECISION(kFloat)) {
+    auto* data = tensor.data<float>();
+    out->assign(data, data + size);
+    return true;
+  }
+  if (tensor.precision() == PRECISION(kInt8) &&
+      op_info.HasOutputScale(name)) {
+    auto scale = op_info.GetOutputScale(name).front();
+    auto* data = tensor.data<int8_t>();
+    out->resize(size);
+    for (size_t i = 0; i < size; i++) {
+      (*out)[i] = data[i] * scale;
+    }
+    return true;
+  }
+  return false;
+}
+
+float RelativeError(const std::vector<float>& out,
+                    const std::vector<float>& ref) {
+  if (out.size() != ref.size()) return std::numeric_limits<float>::max();
+  double diff = 0.0;
+  double norm = 0.0;
+  for (size_t i = 0; i < ref.size(); i++) {
+    diff += (out[i] - ref[i]) * (out[i] - ref[i]);
+    norm += ref[i] * ref[i];
+  }
+  return static_cast<float>(std::sqrt(diff / std::max(norm, 1e-12)));
+}
+
+// The largest relative L2 error of the outputs of the model.
+float ModelError(const Outputs& outputs, const Outputs& reference) {
+  float error = 0.f;
+  for (auto& item : reference) {
+    auto iter = outputs.find(item.first);
+    if (iter == outputs.end()) return std::numeric_limits<float>::max();
+    error = std::max(error, RelativeError(iter->second, item.second));
+  }
+  return error;
+}
+
+// Run the predictor `warmup` + `repeats` times, and profile the average
+// latency of the layers and the precisions they actually run in. The outputs
+// of the layers are kept only if `keep_layer_outputs` is true.
+Profile Run(lite::Predictor* predictor,
+            size_t num_inputs,
+            const std::function<void(Tensor* input, size_t idx)>& set_input,
+            int warmup,
+            int repeats,
+            bool keep_layer_outputs) {
+  for (size_t i = 0; i < num_inputs; i++) {
+    Tensor input(predictor->GetInput(i));
+    set_input(&input, i);
+  }
+#ifdef LITE_WITH_ARM
+  lite::DeviceInfo::Global().SetRunMode(
+      static_cast<PowerMode>(FLAGS_power_mode), FLAGS_threads);
+#endif
+
+  Profile profile;
+  bool timing = false;
+  bool last_run = false;
+  auto& quantizable_ops = lite::Calibrator::quantizable_ops();
+  predictor->SetInstructionHook([&](const lite::Instruction& inst, float ms) {
+    if (!timing) return;
+    auto* op_info = inst.op()->op_info();
+    auto iter = quantizable_ops.find(op_info->Type());
+    if (iter == quantizable_ops.end() ||
+        !op_info->HasOutput(iter->second.output) ||
+        op_info->Output(iter->second.output).empty()) {
+      return;
+    }
+    auto& name = op_info->Output(iter->second.output).front();
+    profile.types[name] = op_info->Type();
+    profile.latency[name] += ms / repeats;
+    profile.precisions[name] = op_info->HasAttr("enable_int8")
+                                   ? PRECISION(kInt8)
+                                   : inst.kernel()->precision();
+    if (last_run && keep_layer_outputs) {
+      auto* tensor = predictor->GetTensor(name);
+      if (!tensor ||
+          !CopyAsFloat(*tensor, *op_info, name, &profile.layer_outputs[name])) {
+        profile.layer_outputs.erase(name);
+      }
+    }
+  });
+  for (int i = 0; i < warmup + repeats; i++) {
+    timing = i >= warmup;
+    last_run = i == warmup + repeats - 1;
+    predictor->Run();
+  }
+  predictor->SetInstructionHook(nullptr);
+
+  auto output_names = predictor->GetOutputNames();
+  for (size_t i = 0; i < output_names.size(); i++) {
+    auto* output = predictor->GetOutput(i);
+    if (output->precision() != PRECISION(kFloat)) continue;
+    auto* data = output->data<float>();
+    profile.model_outputs[output_names[i]].assign(data,
+                                                  data + output->numel());
+  }
+  return profile;
+}
+
+}  // namespace
+
+MixedPrecisionPlan SelectMixedPrecisionPlan(
+    const std::map<std::string, MixedPrecisionLayer>& layers,
+    const std::vector<PrecisionType>& candidates,
+    float error_budget,
+    const std::function<float(const MixedPrecisionPlan& plan)>& model_error,
+    float* error) {
+  // Lower the layers greedily, the one saving the most time for its error
+  // first, and the ones of the unknown error last.
+  std::vector<Move> moves;
+  for (auto& item : layers) {
+    auto& layer = item.second;
+    for (auto candidate : candidates) {
+      auto latency = layer.latency.find(candidate);
+      if (latency == layer.latency.end()) continue;
+      float saving = layer.latency.at(PRECISION(kFloat)) - latency->second;
+      if (saving <= 0.f) continue;
+      auto candidate_error = layer.error.find(candidate);
+      bool has_error = candidate_error != layer.error.end();
+      moves.push_back({item.first,
+                       candidate,
+                       saving,
+                       has_error ? candidate_error->second : 0.f,
+                       has_error});
+    }
+  }
+  std::stable_sort(
+      moves.begin(), moves.end(), [](const Move& a, const Move& b) {
+        if (a.has_error != b.has_error) return a.has_error;
+        if (!a.has_error) return a.saving > b.saving;
+        return a.saving / (a.error + 1e-6f) > b.saving / (b.error + 1e-6f);
+      });
+  Plan plan;
+  for (auto& item : layers) {
+    plan[item.first] = PRECISION(kFloat);
+  }
+  *error = 0.f;
+  for (auto& move : moves) {
+    auto& latency = layers.at(move.layer).latency;
+    if (latency.at(plan[move.layer]) <= latency.at(move.precision)) continue;
+    auto trial = plan;
+    trial[move.layer] = move.precision;
+    float trial_error = model_error(trial);
+    if (trial_error <= error_budget) {
+      plan = trial;
+      *error = trial_error;
+    }
+  }
+  return plan;
+}
+
+std::string RunMixedPrecisionSearch(
+    const std::string& save_optimized_model_path,
+    size_t num_inputs,
+    const std::function<void(Tensor* input, size_t idx)>& set_input) {
+  auto candidates = Candidates();
+  const int repeats = std::max(FLAGS_repeats, 1);
+  const auto fp32_places = SearchPlaces({});
+  const auto search_places = SearchPlaces(candidates);
+
+  // Calibrate the thresholds of the activations for the int8 layers.
+  std::map<std::string, float> thresholds;
+  if (std::find(candidates.begin(), candidates.end(), PRECISION(kInt8)) !=
+      candidates.end()) {
+    auto predictor = BuildPredictor(fp32_places, {}, {}, false);
+    predictor->EnableCalibration(CalibrationMethod::CALIB_KL, 0.9999f);
+    for (size_t i = 0; i < num_inputs; i++) {
+      Tensor input(predictor->GetInput(i));
+      set_input(&input, i);
+    }
+    predictor->Run();
+    thresholds = predictor->calibrator()->ComputeThresholds();
+  }
+
+  // Profile the layers in fp32 and in each of the candidates.
+  auto reference =
+      Run(BuildPredictor(fp32_places, {}, {}, false).get(),
+          num_inputs,
+          set_input,
+          FLAGS_warmup,
+          repeats,
+          true);
+  CHECK(!reference.types.empty())
+      << "No conv2d, depthwise_conv2d, conv2d_transpose, fc or mul is found "
+         "for the mixed precision search.";
+  std::map<std::string, Layer> layers;
+  for (auto& item : reference.types) {
+    auto& layer = layers[item.first];
+    layer.type = item.second;
+    layer.latency[PRECISION(kFloat)] = reference.latency[item.first];
+    layer.error[PRECISION(kFloat)] = 0.f;
+  }
+  for (auto candidate : candidates) {
+    Plan plan;
+    for (auto& item : layers) {
+      plan[item.first] = candidate;
+    }
+    auto profile =
+        Run(BuildPredictor(search_places, plan, thresholds, false).get(),
+            num_inputs,
+            set_input,
+            FLAGS_warmup,
+            repeats,
+            true);
+    for (auto& item : layers) {
+      auto& name = item.first;
+      // The layers without the kernels or the thresholds of the candidate
+      // fall back to fp32.
+      if (!profile.precisions.count(name) ||
+          profile.precisions[name] != candidate) {
+        continue;
+      }
+      item.second.latency[candidate] = profile.latency[name];
+      if (profile.layer_outputs.count(name) &&
+          reference.layer_outputs.count(name)) {
+        item.second.error[candidate] = RelativeError(
+            profile.layer_outputs[name], reference.layer_outputs[name]);
+      }
+    }
+  }
+
+  float error = 0.f;
+  auto plan = SelectMixedPrecisionPlan(
+      layers,
+      candidates,
+      FLAGS_mixed_precision_error_budget,
+      [&](const Plan& trial) {
+        auto profile =
+            Run(BuildPredictor(search_places, trial, thresholds, true).get(),
+                num_inputs,
+                set_input,
+                0,
+                1,
+                false);
+        return ModelError(profile.model_outputs, reference.model_outputs);
+      },
+      &error);
+
+  BuildPredictor(search_places, plan, thresholds, true)
+      ->SaveModel(save_optimized_model_path, LiteModelType::kNaiveBuffer);
+
+  std::stringstream ss;
+  float fp32_time = 0.f;
+  float mixed_time = 0.f;
+  std::map<PrecisionType, int> counts;
+  ss << "\n======= Mixed Precision Search =======\n";
+  ss << "Error budget: " << FLAGS_mixed_precision_error_budget << std::endl;
+  ss << std::setw(40) << std::left << "layer" << std::setw(20) << "type"
+     << std::setw(10) << "precision" << std::setw(12) << "fp32(ms)"
+     << std::setw(12) << "time(ms)"
+     << "error" << std::endl;
+  for (auto& item : layers) {
+    auto& layer = item.second;
+    auto precision = plan[item.first];
+    fp32_time += layer.latency[PRECISION(kFloat)];
+    mixed_time += layer.latency[precision];
+    counts[precision]++;
+    ss << std::setw(40) << std::left << item.first << std::setw(20)
+       << layer.type << std::setw(10) << PrecisionName(precision)
+       << std::setw(12) << layer.latency[PRECISION(kFloat)] << std::setw(12)
+       << layer.latency[precision];
+    if (layer.error.count(precision)) {
+      ss << layer.error[precision];
+    } else {
+      ss << "unknown";
+    }
+    ss << std::endl;
+  }
+  ss << "Layers: " << counts[PRECISION(kInt8)] << " int8, "
+     << counts[PRECISION(kFP16)] << " fp16, " << counts[PRECISION(kFloat)]
+     << " fp32" << std::endl;
+  ss << "Layer time(ms): " << fp32_time << " in fp32, " << mixed_time
+     << " in mixed precision" << std::endl;
+  ss << "Output error: " << error << std::endl;
+  ss << "Save optimized model to " << save_optimized_model_path + ".nb"
+     << std::endl;
+  return ss.str();
+}
+
+}  // namespace lite_api
+}  // namespace paddle
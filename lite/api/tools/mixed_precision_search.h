@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LITE_API_TOOLS_MIXED_PRECISION_SEARCH_H_
+#define LITE_API_TOOLS_MIXED_PRECISION_SEARCH_H_
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_api.h"
+
+namespace paddle {
+namespace lite_api {
+
+// The precisions of the layers, keyed by the names of their outputs.
+using MixedPrecisionPlan = std::map<std::string, PrecisionType>;
+
+// The profile of a layer: its latency in fp32 and in each precision it has
+// the kernels for, and the relative error of its output in the precisions
+// where the output could be compared with the fp32 one.
+struct MixedPrecisionLayer {
+  std::string type;
+  std::map<PrecisionType, float> latency;
+  std::map<PrecisionType, float> error;
+};
+
+// Start from all the layers in fp32, and try to lower them one at a time,
+// the move saving the most time per unit of layer error first and the moves
+// of an unknown error last, in the order of the time saved. A move is kept if
+// `model_error` of the resulting plan is within `error_budget`. Returns the
+// plan and stores its model error in `error`.
+MixedPrecisionPlan SelectMixedPrecisionPlan(
+    const std::map<std::string, MixedPrecisionLayer>& layers,
+    const std::vector<PrecisionType>& candidates,
+    float error_budget,
+    const std::function<float(const MixedPrecisionPlan& plan)>& model_error,
+    float* error);
+
+// Search the precision of every layer(conv2d, depthwise_conv2d,
+// conv2d_transpose, fc and mul) of the model set by the flags:
+// 1. Profile the latency and the output error of the layers when all of them
+//    run in fp32 and in each of --mixed_precision_candidates.
+// 2. Lower the layers greedily, the one saving the most time for its error
+//    first, each of them to the cheapest precision which keeps the relative
+//    L2 error of the model outputs in --mixed_precision_error_budget.
+// 3. Save the model with the assigned precisions to
+//    `save_optimized_model_path`.nb, and return the report.
+// `set_input` fills the idx-th of the `num_inputs` inputs of the model.
+std::string RunMixedPrecisionSearch(
+    const std::string& save_optimized_model_path,
+    size_t num_inputs,
+    const std::function<void(Tensor* input, size_t idx)>& set_input);
+
+}  // namespace lite_api
+}  // namespace paddle
+
+#endif  // LITE_API_TOOLS_MIXED_PRECISION_SEARCH_H_
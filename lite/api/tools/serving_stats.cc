@@ -0,0 +1,46 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/api/tools/serving_stats.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite_api {
+
+std::vector<double> PoissonArrivals(int requests, double qps, uint32_t seed) {
+  CHECK_GT(qps, 0.0);
+  std::mt19937 rng(seed);
+  // The intervals between the arrivals are exponential.
+  std::exponential_distribution<double> interval(qps);
+  std::vector<double> arrivals(std::max(requests, 0));
+  double seconds = 0.0;
+  for (auto& arrival : arrivals) {
+    seconds += interval(rng);
+    arrival = seconds;
+  }
+  return arrivals;
+}
+
+double Percentile(const std::vector<double>& sorted, double q) {
+  CHECK(!sorted.empty());
+  CHECK(q >= 0.0 && q <= 1.0) << "q: " << q;
+  size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+}  // namespace lite_api
+}  // namespace paddle
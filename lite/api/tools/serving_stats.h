@@ -0,0 +1,34 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LITE_API_TOOLS_SERVING_STATS_H_
+#define LITE_API_TOOLS_SERVING_STATS_H_
+#include <cstdint>
+#include <vector>
+
+namespace paddle {
+namespace lite_api {
+
+// The arrival times of `requests` requests of a Poisson process of rate
+// `qps`, in seconds since the first request could arrive.
+std::vector<double> PoissonArrivals(int requests, double qps, uint32_t seed);
+
+// The q-quantile of the ascending `sorted` by the nearest rank, the smallest
+// value not below a fraction q of the values.
+double Percentile(const std::vector<double>& sorted, double q);
+
+}  // namespace lite_api
+}  // namespace paddle
+
+#endif  // LITE_API_TOOLS_SERVING_STATS_H_
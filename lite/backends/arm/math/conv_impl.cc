@@ -639,7 +639,7 @@ void conv1x1s1_gemm_int8(const int8_t* i_data,
   const int n = oh * ow;
   const int k = ic / group;
   int hblock = get_hblock_int8(ctx);
-  int k_roundup = ROUNDUP(k, KBLOCK_INT8);
+  int k_roundup = ROUNDUP(k, get_kblock_int8(ctx));
   int m_roundup = ROUNDUP(m, hblock);
   int weights_size_per_group = m * k;
   if (n > 1 && m > 1) {
@@ -897,7 +897,7 @@ void conv_im2col_gemm_int8(const int8_t* i_data,
   auto act_param = param.activation_param;
 
   int hblock = get_hblock_int8(ctx);
-  int k_roundup = ROUNDUP(k, KBLOCK_INT8);
+  int k_roundup = ROUNDUP(k, get_kblock_int8(ctx));
   int m_roundup = ROUNDUP(m, hblock);
   int weights_size_per_group = m * k;
   if (n > 1 && m > 1) {
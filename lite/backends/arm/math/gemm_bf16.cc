@@ -0,0 +1,207 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/gemm_bf16.h"
+#include <algorithm>
+#include "lite/core/parallel_defines.h"
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+#include "lite/backends/arm/math/mmla_toolchain_support.h"
+#endif
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+#define ROUNDUP_BF16(a, b) ((((a) + (b)-1) / (b)) * (b))
+
+// A is packed in blocks of 8 rows x 4 k, rows and depth padded with zeros.
+void prepackA_bf16(uint16_t* out,
+                   const float* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP_BF16(x_len, KBLOCK_BF16);
+
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, mmax, m0, MBLOCK_BF16) {
+    uint16_t* outptr = out + (y - m0) * kup;
+    int rows = std::min(mmax - y, MBLOCK_BF16);
+    memset(outptr, 0, MBLOCK_BF16 * kup * sizeof(uint16_t));
+    for (int k = 0; k < x_len; ++k) {
+      uint16_t* block = outptr + (k / KBLOCK_BF16) * MBLOCK_BF16 * KBLOCK_BF16 +
+                        k % KBLOCK_BF16;
+      for (int i = 0; i < rows; ++i) {
+        float v = is_trans ? in[(k0 + k) * ldin + y + i]
+                           : in[(y + i) * ldin + k0 + k];
+        block[i * KBLOCK_BF16] = fp32_to_bf16(v);
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+// B is packed in blocks of 12 columns x 4 k, each column stored as 4
+// consecutive k values, columns and depth padded with zeros.
+void packb_bf16(uint16_t* out,
+                const float* in,
+                int ldin,
+                int k0,
+                int kmax,
+                int n0,
+                int nmax,
+                bool is_trans) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP_BF16(x_len, KBLOCK_BF16);
+  int block_size = NBLOCK_BF16 * kup;
+
+  LITE_PARALLEL_COMMON_BEGIN(x, tid, nmax, n0, NBLOCK_BF16) {
+    uint16_t* outptr = out + (x - n0) / NBLOCK_BF16 * block_size;
+    int cols = std::min(nmax - x, NBLOCK_BF16);
+    memset(outptr, 0, block_size * sizeof(uint16_t));
+    for (int k = 0; k < x_len; ++k) {
+      uint16_t* block = outptr + (k / KBLOCK_BF16) * NBLOCK_BF16 * KBLOCK_BF16 +
+                        k % KBLOCK_BF16;
+      for (int j = 0; j < cols; ++j) {
+        float v = is_trans ? in[(x + j) * ldin + k0 + k]
+                           : in[(k0 + k) * ldin + x + j];
+        block[j * KBLOCK_BF16] = fp32_to_bf16(v);
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+// Computes an 8x12 fp32 tile from kup / 4 steps of packed A and B, see
+// GEMM_MMLA_8x12_KERNEL for the tile layout.
+inline void gemm_bf16_kernel(const uint16_t* a_ptr,
+                             const uint16_t*& b_ptr,  // NOLINT
+                             int k,
+                             float* tile) {
+  // clang-format off
+  asm volatile(GEMM_MMLA_8x12_KERNEL(BFMMLA_V)
+               : [a_ptr] "+r"(a_ptr),
+                 [b_ptr] "+r"(b_ptr),
+                 [k] "+r"(k),
+                 [tile] "+r"(tile)
+               :
+               : "cc","memory","v0","v1","v2","v3",
+                 "v4","v5","v6","v7","v8","v9","v10",
+                 "v11","v12","v13","v14","v15","v16","v17",
+                 "v18","v19","v20","v21","v22","v23","v24",
+                 "v25","v26","v27","v28","v29","v30","v31");
+  // clang-format on
+}
+
+inline float bf16_act(float x, int flag_act, float alpha) {
+  switch (flag_act) {
+    case 1:
+      return x > 0.f ? x : 0.f;
+    case 2:
+      return std::min(std::max(x, 0.f), alpha);
+    case 3:
+      return x >= 0.f ? x : x * alpha;
+    default:
+      return x;
+  }
+}
+#endif  // __aarch64__ && WITH_ARM_MMLA
+
+void gemm_prepack_bf16(const uint16_t* A_packed,
+                       const float* B,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int N,
+                       int K,
+                       bool is_bias,
+                       bool is_transB,
+                       const operators::ActivationParam act_param,
+                       ARMContext* ctx) {
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+  CHECK(ctx->has_bf16()) << "bf16 gemm is not supported on this cpu";
+  auto act_type = act_param.active_type;
+  float alpha = 0.f;
+  int flag_act = 0x00;  // relu: 1, relu6: 2, leakey: 3
+  if (act_param.has_active) {
+    if (act_type == lite_api::ActivationType::kRelu) {
+      flag_act = 0x01;
+    } else if (act_type == lite_api::ActivationType::kRelu6) {
+      flag_act = 0x02;
+      alpha = act_param.Relu_clipped_coef;
+    } else if (act_type == lite_api::ActivationType::kLeakyRelu) {
+      flag_act = 0x03;
+      alpha = act_param.Leaky_relu_alpha;
+    }
+  }
+
+  size_t llc_size = ctx->llc_size() / 4;
+  auto workspace = ctx->workspace_data<uint16_t>();
+  int kup = ROUNDUP_BF16(K, KBLOCK_BF16);
+  //! MBLOCK_BF16 * x (result) + MBLOCK_BF16 * k (A) + x * k (B) = l2
+  int x_block = (static_cast<int>(llc_size / sizeof(uint16_t)) -
+                 (MBLOCK_BF16 * kup)) /
+                (kup + 2 * MBLOCK_BF16);
+  x_block /= NBLOCK_BF16;
+  x_block *= NBLOCK_BF16;
+  x_block = std::max(x_block, NBLOCK_BF16);
+
+  int x_num = (N + (x_block - 1)) / x_block;
+  x_block = (N + x_num - 1) / x_num;
+  x_block = ROUNDUP_BF16(x_block, NBLOCK_BF16);
+
+  //! apanel is pre_compute outside gemm
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = std::min(x0 + x_block, N);
+    int bblocks = (xmax - x0 + NBLOCK_BF16 - 1) / NBLOCK_BF16;
+    //! load bpanel
+    auto b_pannel = static_cast<uint16_t*>(workspace);
+    packb_bf16(b_pannel, B, is_transB ? K : N, 0, K, x0, xmax, is_transB);
+
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_BF16) {
+      int rows = std::min(M - y, MBLOCK_BF16);
+      float tile[MBLOCK_BF16 * NBLOCK_BF16];
+      const uint16_t* a_ptr = A_packed + y * kup;
+      const uint16_t* b_ptr = b_pannel;
+      for (int xb = 0; xb < bblocks; ++xb) {
+        int x = x0 + xb * NBLOCK_BF16;
+        int cols = std::min(xmax - x, NBLOCK_BF16);
+        gemm_bf16_kernel(a_ptr, b_ptr, kup / KBLOCK_BF16, tile);
+        for (int i = 0; i < rows; ++i) {
+          float* c_row = C + (y + i) * N + x;
+          float b = is_bias ? bias[y + i] : 0.f;
+          for (int j = 0; j < cols; ++j) {
+            c_row[j] =
+                bf16_act(tile[MMLA_TILE_INDEX(i, j)] + b, flag_act, alpha);
+          }
+        }
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+#else
+  LOG(FATAL) << "bf16 gemm requires an aarch64 build with WITH_ARM_MMLA";
+#endif
+}
+
+#undef ROUNDUP_BF16
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
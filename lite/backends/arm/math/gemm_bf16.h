@@ -0,0 +1,86 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+
+// bfmmla consumes 4 bf16 values of k per step on an 8x12 tile
+const int MBLOCK_BF16 = 8;
+const int NBLOCK_BF16 = 12;
+const int KBLOCK_BF16 = 4;
+
+// Converts fp32 to bf16 storage with round-to-nearest-even.
+inline uint16_t fp32_to_bf16(float x) {
+  uint32_t bits;
+  memcpy(&bits, &x, sizeof(bits));
+  if ((bits & 0x7fffffff) > 0x7f800000) {
+    // keep NaN quiet instead of rounding it into inf
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7fff + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+inline float bf16_to_fp32(uint16_t x) {
+  uint32_t bits = static_cast<uint32_t>(x) << 16;
+  float out;
+  memcpy(&out, &bits, sizeof(out));
+  return out;
+}
+
+// Packed A size in elements, rows rounded to MBLOCK_BF16 and depth to
+// KBLOCK_BF16.
+inline int get_packed_size_bf16(int m, int k) {
+  return ((m + MBLOCK_BF16 - 1) / MBLOCK_BF16) * MBLOCK_BF16 *
+         ((k + KBLOCK_BF16 - 1) / KBLOCK_BF16) * KBLOCK_BF16;
+}
+
+// Converts fp32 weights to bf16 and packs them for gemm_prepack_bf16.
+void prepackA_bf16(uint16_t* out,
+                   const float* in,
+                   int ldin,
+                   int m0,
+                   int mmax,
+                   int k0,
+                   int kmax,
+                   bool is_trans);
+
+// C = act(A_packed * B + bias), B and C are fp32, B is rounded to bf16
+// while it is packed and accumulation is done in fp32. Requires bf16
+// support, see ARMContext::has_bf16().
+void gemm_prepack_bf16(const uint16_t* A_packed,
+                       const float* B,
+                       const float* bias,
+                       float* C,
+                       int M,
+                       int N,
+                       int K,
+                       bool is_bias,
+                       bool is_transB,
+                       const operators::ActivationParam act_param,
+                       ARMContext* ctx);
+
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
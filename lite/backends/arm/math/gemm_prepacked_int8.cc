@@ -14,9 +14,11 @@
 
 #include "lite/backends/arm/math/gemm_prepacked_int8.h"
 #include <arm_neon.h>
+#include <algorithm>
 #include "lite/core/parallel_defines.h"
 #ifdef __aarch64__
 #include "lite/backends/arm/math/dotprod/gemm_sdot.h"
+#include "lite/backends/arm/math/mmla_toolchain_support.h"
 #else
 #include "lite/backends/arm/math/dotprod/gemm_vsdot.h"
 #endif
@@ -123,6 +125,40 @@ void prepackA_m6k4_trans_int8(int8_t* out,
                               int kmax);
 #endif
 
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+void prepackA_m8k8_int8(int8_t* out,
+                        const int8_t* in,
+                        int ldin,
+                        int m0,
+                        int mmax,
+                        int k0,
+                        int kmax);
+
+void prepackA_m8k8_trans_int8(int8_t* out,
+                              const int8_t* in,
+                              int ldin,
+                              int m0,
+                              int mmax,
+                              int k0,
+                              int kmax);
+
+void packb_mmla_int8(int8_t* out,
+                     const int8_t* in,
+                     int ldin,
+                     int k0,
+                     int kmax,
+                     int n0,
+                     int nmax);
+
+void packb_mmla_trans_int8(int8_t* out,
+                           const int8_t* in,
+                           int ldin,
+                           int k0,
+                           int kmax,
+                           int n0,
+                           int nmax);
+#endif
+
 void prepackA_int8(void* out,
                    const void* in,
                    int ldin,
@@ -133,6 +169,28 @@ void prepackA_int8(void* out,
                    bool is_trans,
                    ARMContext* ctx) {
 #ifdef __aarch64__
+#ifdef WITH_ARM_MMLA
+  if (ctx->has_i8mm()) {
+    if (is_trans) {
+      prepackA_m8k8_trans_int8(static_cast<int8_t*>(out),
+                               static_cast<const int8_t*>(in),
+                               ldin,
+                               m0,
+                               mmax,
+                               k0,
+                               kmax);
+    } else {
+      prepackA_m8k8_int8(static_cast<int8_t*>(out),
+                         static_cast<const int8_t*>(in),
+                         ldin,
+                         m0,
+                         mmax,
+                         k0,
+                         kmax);
+    }
+    return;
+  }
+#endif
   if (ctx->has_dot()) {
 #ifdef WITH_ARM_DOTPROD
     if (is_trans) {
@@ -227,7 +285,7 @@ void prepackA_int8(TensorLite* tout,
   int hblock = get_hblock_int8(ctx);
   int m_roundup = ROUNDUP(m, hblock);
   // round up to 128 bits
-  int kup = ROUNDUP(k, KBLOCK_INT8);
+  int kup = ROUNDUP(k, get_kblock_int8(ctx));
   int group_size_round_up = ((m_roundup * kup + 15) / 16) * 16;
 
   if (tout->numel() < group_size_round_up * group) {
@@ -6787,6 +6845,281 @@ void gemm_prepack_vsdot_int8(const int8_t* A_packed,
 #endif
 #endif  // dotprod  //NOLINT
 
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+// Computes an 8x12 int32 tile from kup / 8 steps of packed A and B, see
+// GEMM_MMLA_8x12_KERNEL for the tile layout.
+inline void gemm_mmla_int8_kernel(const int8_t* a_ptr,
+                                  const int8_t*& b_ptr,  // NOLINT
+                                  int k,
+                                  int32_t* tile) {
+  // clang-format off
+  asm volatile(GEMM_MMLA_8x12_KERNEL(SMMLA_V)
+               : [a_ptr] "+r"(a_ptr),
+                 [b_ptr] "+r"(b_ptr),
+                 [k] "+r"(k),
+                 [tile] "+r"(tile)
+               :
+               : "cc","memory","v0","v1","v2","v3",
+                 "v4","v5","v6","v7","v8","v9","v10",
+                 "v11","v12","v13","v14","v15","v16","v17",
+                 "v18","v19","v20","v21","v22","v23","v24",
+                 "v25","v26","v27","v28","v29","v30","v31");
+  // clang-format on
+}
+
+inline float mmla_act(float x, int flag_act, float alpha) {
+  switch (flag_act) {
+    case 1:
+      return x > 0.f ? x : 0.f;
+    case 2:
+      return std::min(std::max(x, 0.f), alpha);
+    case 3:
+      return x >= 0.f ? x : x * alpha;
+    default:
+      return x;
+  }
+}
+
+inline void mmla_store(int32_t acc,
+                       float scale,
+                       float bias,
+                       int flag_act,
+                       float alpha,
+                       int32_t* out) {
+  *out = acc;
+}
+
+inline void mmla_store(int32_t acc,
+                       float scale,
+                       float bias,
+                       int flag_act,
+                       float alpha,
+                       float* out) {
+  *out = mmla_act(acc * scale + bias, flag_act, alpha);
+}
+
+inline void mmla_store(int32_t acc,
+                       float scale,
+                       float bias,
+                       int flag_act,
+                       float alpha,
+                       int8_t* out) {
+  float x = mmla_act(acc * scale + bias, flag_act, alpha);
+  // same as the sdot kernels: clamp to -127 and round half away from zero
+  x = std::min(std::max(std::round(x), -127.f), 127.f);
+  *out = static_cast<int8_t>(x);
+}
+
+template <typename Dtype>
+inline void write_mmla_int8_tile(const int32_t* tile,
+                                 Dtype* c_ptr,
+                                 int ldc,
+                                 int rows,
+                                 int cols,
+                                 const float* bias,
+                                 const float* scale,
+                                 int flag_act,
+                                 float alpha) {
+  for (int i = 0; i < rows; ++i) {
+    Dtype* c_row = c_ptr + i * ldc;
+    for (int j = 0; j < cols; ++j) {
+      mmla_store(tile[MMLA_TILE_INDEX(i, j)],
+                 scale[i],
+                 bias[i],
+                 flag_act,
+                 alpha,
+                 c_row + j);
+    }
+  }
+}
+
+template <typename Dtype>
+void gemm_prepack_mmla_int8(const int8_t* A_packed,
+                            const int8_t* B,
+                            const float* bias,
+                            Dtype* C,
+                            int M,
+                            int N,
+                            int K,
+                            bool is_bias,
+                            int flag_act,
+                            bool is_transB,
+                            const float* scale,
+                            const float* alpha,
+                            ARMContext* ctx) {
+  size_t llc_size = ctx->llc_size() / 4;
+  auto workspace = ctx->workspace_data<int8_t>();
+  int kup = ROUNDUP(K, KBLOCK_INT8_MMLA);
+  //! MBLOCK_INT8_MMLA * x (result) + MBLOCK_INT8_MMLA * k (A) + x * k (B) = l2
+  int x_block = (static_cast<int>(llc_size) - (MBLOCK_INT8_MMLA * kup)) /
+                (kup + MBLOCK_INT8_MMLA);
+  x_block /= NBLOCK_INT8_MMLA;
+  x_block *= NBLOCK_INT8_MMLA;
+  x_block = std::max(x_block, NBLOCK_INT8_MMLA);
+
+  int x_num = (N + (x_block - 1)) / x_block;
+  x_block = (N + x_num - 1) / x_num;
+  x_block = ROUNDUP(x_block, NBLOCK_INT8_MMLA);
+
+  //! apanel is pre_compute outside gemm
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = std::min(x0 + x_block, N);
+    int bblocks = (xmax - x0 + NBLOCK_INT8_MMLA - 1) / NBLOCK_INT8_MMLA;
+    //! load bpanel
+    auto b_pannel = static_cast<int8_t*>(workspace);
+    if (!is_transB) {
+      // K * N
+      packb_mmla_int8(b_pannel, B, N, 0, K, x0, xmax);
+    } else {
+      // N X K
+      packb_mmla_trans_int8(b_pannel, B, K, 0, K, x0, xmax);
+    }
+
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_INT8_MMLA) {
+      int rows = std::min(M - y, MBLOCK_INT8_MMLA);
+      float bias_local[MBLOCK_INT8_MMLA] = {0.f};
+      float scale_local[MBLOCK_INT8_MMLA] = {0.f};
+      for (int i = 0; i < rows; ++i) {
+        bias_local[i] = is_bias ? bias[y + i] : 0.f;
+        scale_local[i] = scale ? scale[y + i] : 1.f;
+      }
+      int32_t tile[MBLOCK_INT8_MMLA * NBLOCK_INT8_MMLA];
+      const int8_t* a_ptr = A_packed + y * kup;
+      const int8_t* b_ptr = b_pannel;
+      for (int xb = 0; xb < bblocks; ++xb) {
+        int x = x0 + xb * NBLOCK_INT8_MMLA;
+        gemm_mmla_int8_kernel(a_ptr, b_ptr, kup / KBLOCK_INT8_MMLA, tile);
+        write_mmla_int8_tile(tile,
+                             C + y * N + x,
+                             N,
+                             rows,
+                             std::min(xmax - x, NBLOCK_INT8_MMLA),
+                             bias_local,
+                             scale_local,
+                             flag_act,
+                             alpha[0]);
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+// A is packed in blocks of 8 rows x 8 k, rows and depth padded with zeros.
+void prepackA_m8k8_int8(int8_t* out,
+                        const int8_t* in,
+                        const int ldin,
+                        const int m0,
+                        const int mmax,
+                        const int k0,
+                        const int kmax) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP(x_len, KBLOCK_INT8_MMLA);
+
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, mmax, m0, MBLOCK_INT8_MMLA) {
+    int8_t* outptr = out + (y - m0) * kup;
+    for (int kb = 0; kb < kup; kb += KBLOCK_INT8_MMLA) {
+      int valid = std::min(KBLOCK_INT8_MMLA, x_len - kb);
+      for (int i = 0; i < MBLOCK_INT8_MMLA; ++i) {
+        if (y + i < mmax) {
+          memcpy(outptr, in + (y + i) * ldin + k0 + kb, valid);
+          memset(outptr + valid, 0, KBLOCK_INT8_MMLA - valid);
+        } else {
+          memset(outptr, 0, KBLOCK_INT8_MMLA);
+        }
+        outptr += KBLOCK_INT8_MMLA;
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+void prepackA_m8k8_trans_int8(int8_t* out,
+                              const int8_t* in,
+                              const int ldin,
+                              const int m0,
+                              const int mmax,
+                              const int k0,
+                              const int kmax) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP(x_len, KBLOCK_INT8_MMLA);
+
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, mmax, m0, MBLOCK_INT8_MMLA) {
+    int8_t* outptr = out + (y - m0) * kup;
+    int rows = std::min(mmax - y, MBLOCK_INT8_MMLA);
+    memset(outptr, 0, MBLOCK_INT8_MMLA * kup);
+    for (int k = 0; k < x_len; ++k) {
+      const int8_t* inptr = in + (k0 + k) * ldin + y;
+      int8_t* block = outptr + (k / KBLOCK_INT8_MMLA) * MBLOCK_INT8_MMLA *
+                                   KBLOCK_INT8_MMLA +
+                      k % KBLOCK_INT8_MMLA;
+      for (int i = 0; i < rows; ++i) {
+        block[i * KBLOCK_INT8_MMLA] = inptr[i];
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+// B is packed in blocks of 12 columns x 8 k, each column stored as 8
+// consecutive k values, columns and depth padded with zeros.
+void packb_mmla_int8(int8_t* out,
+                     const int8_t* in,
+                     const int ldin,
+                     const int k0,
+                     const int kmax,
+                     const int n0,
+                     const int nmax) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP(x_len, KBLOCK_INT8_MMLA);
+  int block_size = NBLOCK_INT8_MMLA * kup;
+
+  LITE_PARALLEL_COMMON_BEGIN(x, tid, nmax, n0, NBLOCK_INT8_MMLA) {
+    int8_t* outptr = out + (x - n0) / NBLOCK_INT8_MMLA * block_size;
+    int cols = std::min(nmax - x, NBLOCK_INT8_MMLA);
+    memset(outptr, 0, block_size);
+    for (int k = 0; k < x_len; ++k) {
+      const int8_t* inptr = in + (k0 + k) * ldin + x;
+      int8_t* block = outptr + (k / KBLOCK_INT8_MMLA) * NBLOCK_INT8_MMLA *
+                                   KBLOCK_INT8_MMLA +
+                      k % KBLOCK_INT8_MMLA;
+      for (int j = 0; j < cols; ++j) {
+        block[j * KBLOCK_INT8_MMLA] = inptr[j];
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+void packb_mmla_trans_int8(int8_t* out,
+                           const int8_t* in,
+                           const int ldin,
+                           const int k0,
+                           const int kmax,
+                           const int n0,
+                           const int nmax) {
+  int x_len = kmax - k0;
+  int kup = ROUNDUP(x_len, KBLOCK_INT8_MMLA);
+  int block_size = NBLOCK_INT8_MMLA * kup;
+
+  LITE_PARALLEL_COMMON_BEGIN(x, tid, nmax, n0, NBLOCK_INT8_MMLA) {
+    int8_t* outptr = out + (x - n0) / NBLOCK_INT8_MMLA * block_size;
+    for (int kb = 0; kb < kup; kb += KBLOCK_INT8_MMLA) {
+      int valid = std::min(KBLOCK_INT8_MMLA, x_len - kb);
+      for (int j = 0; j < NBLOCK_INT8_MMLA; ++j) {
+        if (x + j < nmax) {
+          memcpy(outptr, in + (x + j) * ldin + k0 + kb, valid);
+          memset(outptr + valid, 0, KBLOCK_INT8_MMLA - valid);
+        } else {
+          memset(outptr, 0, KBLOCK_INT8_MMLA);
+        }
+        outptr += KBLOCK_INT8_MMLA;
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+#endif  // __aarch64__ && WITH_ARM_MMLA
+
 template <typename dtype>
 void gemm_prepack_int8(const int8_t* A_packed,
                        const int8_t* B,
@@ -6826,6 +7159,12 @@ void gemm_prepack_int8(const int8_t* A_packed,
 #define IN_PARAMS \
   A_packed, B, bias, C, M, N, K, is_bias, flag_act, is_transB, scale, alpha, ctx
 #ifdef __aarch64__
+#ifdef WITH_ARM_MMLA
+  if (ctx->has_i8mm()) {
+    gemm_prepack_mmla_int8<dtype>(IN_PARAMS);
+    return;
+  }
+#endif
   if (ctx->has_dot()) {
 #ifdef WITH_ARM_DOTPROD
     gemm_prepack_sdot_int8<dtype>(IN_PARAMS);
@@ -34,7 +34,17 @@ const int NBLOCK_INT8_OTH = 16;
 const int MBLOCK_INT8_DOT = 8;
 const int NBLOCK_INT8_DOT = 12;
 
+// for i8mm gemm, smmla consumes 8 k values per step
+const int MBLOCK_INT8_MMLA = 8;
+const int NBLOCK_INT8_MMLA = 12;
+const int KBLOCK_INT8_MMLA = 8;
+
 inline int get_hblock_int8(ARMContext* ctx) {
+#ifdef WITH_ARM_MMLA
+  if (ctx->has_i8mm()) {
+    return MBLOCK_INT8_MMLA;
+  }
+#endif
 #ifdef WITH_ARM_DOTPROD
   if (ctx->has_dot()) {
     return MBLOCK_INT8_DOT;
@@ -67,6 +77,16 @@ inline int get_hblock_int8(ARMContext* ctx) {
 }
 #endif  // __aarch64__
 
+// The depth A is padded to by prepackA_int8.
+inline int get_kblock_int8(ARMContext* ctx) {
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+  if (ctx->has_i8mm()) {
+    return KBLOCK_INT8_MMLA;
+  }
+#endif
+  return KBLOCK_INT8;
+}
+
 void prepackA_int8(void* out,
                    const void* in,
                    int ldin,
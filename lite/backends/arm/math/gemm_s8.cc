@@ -56,7 +56,8 @@ void gemm_s8(bool is_transA,
 
   int hblock = get_hblock_int8(ctx);
   int m_roundup = hblock * ((M + hblock - 1) / hblock);
-  ctx->ExtendWorkspace(m_roundup * K * sizeof(int8_t));
+  ctx->ExtendWorkspace(m_roundup * ROUNDUP(K, get_kblock_int8(ctx)) *
+                       sizeof(int8_t));
   auto packed_A = static_cast<int8_t*>(ctx->workspace_data<int8_t>()) +
                   ctx->llc_size() / sizeof(int8_t);
   int lda = is_transA ? M : K;
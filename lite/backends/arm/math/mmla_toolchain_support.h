@@ -0,0 +1,63 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+// ARMv8.6 matrix multiply instructions, emitted as raw encodings so the
+// kernels build with toolchains that do not know the i8mm/bf16 extensions.
+
+// smmla vd.4s, vn.16b, vm.16b
+#define SMMLA_V(d, n, m) \
+  ".inst 0x4e80a400 | (" #m " << 16) | (" #n " << 5) | " #d "\n"
+// bfmmla vd.4s, vn.8h, vm.8h
+#define BFMMLA_V(d, n, m) \
+  ".inst 0x6e40ec00 | (" #m " << 16) | (" #n " << 5) | " #d "\n"
+
+// 8x12 micro kernel shared by the int8 and bf16 GEMMs. Each step loads two
+// rows of A per register from v0-v3 and two columns of B per register into
+// v4-v7, and accumulates 24 2x2 blocks in v8-v31: block (r, c) lives in
+// v(8 + 6 * r + c) and covers rows 2r, 2r + 1 and columns 2c, 2c + 1.
+// clang-format off
+#define GEMM_MMLA_8x12_KERNEL(MMLA)                                  \
+  "movi v8.4s, #0\n"  "movi v9.4s, #0\n"  "movi v10.4s, #0\n"        \
+  "movi v11.4s, #0\n" "movi v12.4s, #0\n" "movi v13.4s, #0\n"        \
+  "movi v14.4s, #0\n" "movi v15.4s, #0\n" "movi v16.4s, #0\n"        \
+  "movi v17.4s, #0\n" "movi v18.4s, #0\n" "movi v19.4s, #0\n"        \
+  "movi v20.4s, #0\n" "movi v21.4s, #0\n" "movi v22.4s, #0\n"        \
+  "movi v23.4s, #0\n" "movi v24.4s, #0\n" "movi v25.4s, #0\n"        \
+  "movi v26.4s, #0\n" "movi v27.4s, #0\n" "movi v28.4s, #0\n"        \
+  "movi v29.4s, #0\n" "movi v30.4s, #0\n" "movi v31.4s, #0\n"        \
+  "1:\n"                                                             \
+  "ld1 {v0.16b, v1.16b, v2.16b, v3.16b}, [%[a_ptr]], #64\n"          \
+  "ld1 {v4.16b, v5.16b, v6.16b, v7.16b}, [%[b_ptr]], #64\n"          \
+  MMLA(8, 0, 4)  MMLA(9, 0, 5)  MMLA(10, 0, 6) MMLA(11, 0, 7)        \
+  MMLA(14, 1, 4) MMLA(15, 1, 5) MMLA(16, 1, 6) MMLA(17, 1, 7)        \
+  MMLA(20, 2, 4) MMLA(21, 2, 5) MMLA(22, 2, 6) MMLA(23, 2, 7)        \
+  MMLA(26, 3, 4) MMLA(27, 3, 5) MMLA(28, 3, 6) MMLA(29, 3, 7)        \
+  "ld1 {v4.16b, v5.16b}, [%[b_ptr]], #32\n"                          \
+  MMLA(12, 0, 4) MMLA(13, 0, 5) MMLA(18, 1, 4) MMLA(19, 1, 5)        \
+  MMLA(24, 2, 4) MMLA(25, 2, 5) MMLA(30, 3, 4) MMLA(31, 3, 5)        \
+  "subs %w[k], %w[k], #1\n"                                          \
+  "bne 1b\n"                                                         \
+  "st1 {v8.4s, v9.4s, v10.4s, v11.4s}, [%[tile]], #64\n"             \
+  "st1 {v12.4s, v13.4s, v14.4s, v15.4s}, [%[tile]], #64\n"           \
+  "st1 {v16.4s, v17.4s, v18.4s, v19.4s}, [%[tile]], #64\n"           \
+  "st1 {v20.4s, v21.4s, v22.4s, v23.4s}, [%[tile]], #64\n"           \
+  "st1 {v24.4s, v25.4s, v26.4s, v27.4s}, [%[tile]], #64\n"           \
+  "st1 {v28.4s, v29.4s, v30.4s, v31.4s}, [%[tile]], #64\n"
+// clang-format on
+
+// Index of element (i, j) of an 8x12 tile stored by GEMM_MMLA_8x12_KERNEL.
+#define MMLA_TILE_INDEX(i, j) \
+  ((((i) >> 1) * 6 + ((j) >> 1)) * 4 + ((i)&1) * 2 + ((j)&1))
@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "lite/backends/arm/math/sgemm.h"
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -52,6 +55,28 @@ void sgemm(bool is_transA,
     sgemv(B, A, C, !is_transB, N, K, beta, is_bias, bias_ptr, act_param, ctx);
     return;
   }
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx->has_sve() && sve::fused_act_supported(act_param)) {
+    sve::sgemm(is_transA,
+               is_transB,
+               M,
+               N,
+               K,
+               alpha,
+               A,
+               lda,
+               B,
+               ldb,
+               beta,
+               C,
+               ldc,
+               bias,
+               is_bias,
+               act_param,
+               ctx);
+    return;
+  }
+#endif
   int hblock = get_hblock(ctx);
   int m_roundup = hblock * ((M + hblock - 1) / hblock);
   ctx->ExtendWorkspace(m_roundup * K * sizeof(float));
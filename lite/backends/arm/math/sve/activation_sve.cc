@@ -0,0 +1,83 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/activation_sve.h"
+#include <algorithm>
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// Splits size over the threads and applies op one vector at a time, the
+// tail is handled by the loop predicate.
+template <typename Op>
+void act_sve(const float* din, float* dout, int size, int threads, Op op) {
+  threads = std::max(threads, 1);
+  int nums_per_thread = (size + threads - 1) / threads;
+  const int vl = svcntw();
+  LITE_PARALLEL_BEGIN(i, tid, threads) {
+    int start = i * nums_per_thread;
+    int end = std::min(size, start + nums_per_thread);
+    for (int j = start; j < end; j += vl) {
+      svbool_t pg = svwhilelt_b32(j, end);
+      svst1_f32(pg, dout + j, op(pg, svld1_f32(pg, din + j)));
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void act_relu(const float* din, float* dout, int size, int threads) {
+  act_sve(din, dout, size, threads, [](svbool_t pg, svfloat32_t x) {
+    return svmax_n_f32_x(pg, x, 0.f);
+  });
+}
+
+void act_relu_neg(const float* din,
+                  float* dout,
+                  int size,
+                  float negative_slope,
+                  int threads) {
+  act_sve(din, dout, size, threads, [=](svbool_t pg, svfloat32_t x) {
+    return act_ps(pg, x, 3, negative_slope);
+  });
+}
+
+void act_clipped_relu(
+    const float* din, float* dout, int size, float coef, int threads) {
+  act_sve(din, dout, size, threads, [=](svbool_t pg, svfloat32_t x) {
+    return act_ps(pg, x, 2, coef);
+  });
+}
+
+void act_sigmoid(const float* din, float* dout, int size, int threads) {
+  act_sve(din, dout, size, threads, [](svbool_t pg, svfloat32_t x) {
+    return sigmoid_ps(pg, x);
+  });
+}
+
+void act_tanh(const float* din, float* dout, int size, int threads) {
+  act_sve(din, dout, size, threads, [](svbool_t pg, svfloat32_t x) {
+    return tanh_ps(pg, x);
+  });
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
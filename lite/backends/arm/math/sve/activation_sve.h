@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+void act_relu(const float* din, float* dout, int size, int threads);
+
+void act_relu_neg(const float* din,
+                  float* dout,
+                  int size,
+                  float negative_slope,
+                  int threads);
+
+void act_clipped_relu(
+    const float* din, float* dout, int size, float coef, int threads);
+
+void act_sigmoid(const float* din, float* dout, int size, int threads);
+
+void act_tanh(const float* din, float* dout, int size, int threads);
+
+// The sve conv and gemm kernels fuse relu, relu6 and leaky relu.
+inline bool fused_act_supported(const operators::ActivationParam& act_param) {
+  return !act_param.has_active ||
+         act_param.active_type == lite_api::ActivationType::kRelu ||
+         act_param.active_type == lite_api::ActivationType::kRelu6 ||
+         act_param.active_type == lite_api::ActivationType::kLeakyRelu;
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,118 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <arm_sve.h>
+#include "lite/operators/op_params.h"
+
+// Helpers shared by the sve kernels. Only the files in this directory may
+// include it, they are the only ones built with sve code generation.
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// exp() computed for one vector, same cephes approximation as the neon
+// exp_ps in funcs.h
+inline svfloat32_t exp_ps(svbool_t pg, svfloat32_t x) {
+  x = svmin_n_f32_x(pg, x, 88.3762626647949f);
+  x = svmax_n_f32_x(pg, x, -88.3762626647949f);
+
+  // express exp(x) as exp(g + n*log(2))
+  svfloat32_t fx =
+      svmla_n_f32_x(pg, svdup_n_f32(0.5f), x, 1.44269504088896341f);
+  fx = svrintm_f32_x(pg, fx);
+  x = svmls_n_f32_x(pg, x, fx, 0.693359375f);
+  x = svmls_n_f32_x(pg, x, fx, -2.12194440e-4f);
+
+  svfloat32_t z = svmul_f32_x(pg, x, x);
+  svfloat32_t y = svdup_n_f32(1.9875691500E-4f);
+  y = svmad_n_f32_x(pg, y, x, 1.3981999507E-3f);
+  y = svmad_n_f32_x(pg, y, x, 8.3334519073E-3f);
+  y = svmad_n_f32_x(pg, y, x, 4.1665795894E-2f);
+  y = svmad_n_f32_x(pg, y, x, 1.6666665459E-1f);
+  y = svmad_n_f32_x(pg, y, x, 5.0000001201E-1f);
+  y = svmla_f32_x(pg, x, y, z);
+  y = svadd_n_f32_x(pg, y, 1.f);
+
+  // build 2^n
+  svint32_t n = svcvt_s32_f32_x(pg, fx);
+  n = svadd_n_s32_x(pg, n, 127);
+  n = svlsl_n_s32_x(pg, n, 23);
+  return svmul_f32_x(pg, y, svreinterpret_f32_s32(n));
+}
+
+inline svfloat32_t sigmoid_ps(svbool_t pg, svfloat32_t x) {
+  svfloat32_t den = svadd_n_f32_x(pg, exp_ps(pg, svneg_f32_x(pg, x)), 1.f);
+  return svdiv_f32_x(pg, svdup_n_f32(1.f), den);
+}
+
+// tanh(x) = 2 * sigmoid(2x) - 1
+inline svfloat32_t tanh_ps(svbool_t pg, svfloat32_t x) {
+  svfloat32_t sig = sigmoid_ps(pg, svmul_n_f32_x(pg, x, 2.f));
+  return svsub_n_f32_x(pg, svmul_n_f32_x(pg, sig, 2.f), 1.f);
+}
+
+// relu: 1, relu6: 2, leakey: 3, same flags as the gemm kernels
+inline void get_act_flag(const operators::ActivationParam& act_param,
+                         int* flag_act,
+                         float* alpha) {
+  *flag_act = 0;
+  *alpha = 0.f;
+  if (!act_param.has_active) {
+    return;
+  }
+  switch (act_param.active_type) {
+    case lite_api::ActivationType::kRelu:
+      *flag_act = 1;
+      break;
+    case lite_api::ActivationType::kRelu6:
+      *flag_act = 2;
+      *alpha = act_param.Relu_clipped_coef;
+      break;
+    case lite_api::ActivationType::kLeakyRelu:
+      *flag_act = 3;
+      *alpha = act_param.Leaky_relu_alpha;
+      break;
+    default:
+      break;
+  }
+}
+
+inline svfloat32_t act_ps(svbool_t pg,
+                          svfloat32_t x,
+                          int flag_act,
+                          float alpha) {
+  switch (flag_act) {
+    case 1:
+      return svmax_n_f32_x(pg, x, 0.f);
+    case 2:
+      return svmin_n_f32_x(pg, svmax_n_f32_x(pg, x, 0.f), alpha);
+    case 3:
+      return svsel_f32(svcmpge_n_f32(pg, x, 0.f),
+                       x,
+                       svmul_n_f32_x(pg, x, alpha));
+    default:
+      return x;
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,120 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/conv_depthwise_sve.h"
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// Loads the input columns of one kernel column for a vector of outputs,
+// columns that fall into the padding are read as zero.
+inline svfloat32_t load_dw_cols(svbool_t valid,
+                                const float* din_row,
+                                int iw0,
+                                svint32_t iw,
+                                int stride) {
+  return stride == 1 ? svld1_f32(valid, din_row + iw0)
+                     : svld1_gather_s32index_f32(valid, din_row, iw);
+}
+
+void conv_depthwise_3x3_fp32(const void* din,
+                             void* dout,
+                             int num,
+                             int ch_out,
+                             int h_out,
+                             int w_out,
+                             int ch_in,
+                             int h_in,
+                             int w_in,
+                             const void* weights,
+                             const float* bias,
+                             const operators::ConvParam& param,
+                             ARMContext* ctx,
+                             const float* scale) {
+  auto paddings = *param.paddings;
+  int pad_h = paddings[0];
+  int pad_w = paddings[2];
+  int stride = param.strides[1];
+  int flag_act = 0;
+  float alpha = 0.f;
+  get_act_flag(param.activation_param, &flag_act, &alpha);
+
+  const float* i_data = static_cast<const float*>(din);
+  float* o_data = static_cast<float*>(dout);
+  const float* w_data = static_cast<const float*>(weights);
+  int size_in_channel = w_in * h_in;
+  int size_out_channel = w_out * h_out;
+  const int vl = svcntw();
+
+  for (int n = 0; n < num; ++n) {
+    const float* din_batch = i_data + n * ch_in * size_in_channel;
+    float* dout_batch = o_data + n * ch_out * size_out_channel;
+    LITE_PARALLEL_BEGIN(c, tid, ch_out) {
+      const float* din_ch = din_batch + c * size_in_channel;
+      float* dout_ch = dout_batch + c * size_out_channel;
+      const float* wei = w_data + c * 9;
+      float bias_val = bias ? bias[c] : 0.f;
+      for (int ow = 0; ow < w_out; ow += vl) {
+        svbool_t pg = svwhilelt_b32(ow, w_out);
+        int iw0 = ow * stride - pad_w;
+        svint32_t iw_0 = svindex_s32(iw0, stride);
+        svint32_t iw_1 = svindex_s32(iw0 + 1, stride);
+        svint32_t iw_2 = svindex_s32(iw0 + 2, stride);
+        svbool_t valid_0 = svand_b_z(pg,
+                                     svcmpge_n_s32(pg, iw_0, 0),
+                                     svcmplt_n_s32(pg, iw_0, w_in));
+        svbool_t valid_1 = svand_b_z(pg,
+                                     svcmpge_n_s32(pg, iw_1, 0),
+                                     svcmplt_n_s32(pg, iw_1, w_in));
+        svbool_t valid_2 = svand_b_z(pg,
+                                     svcmpge_n_s32(pg, iw_2, 0),
+                                     svcmplt_n_s32(pg, iw_2, w_in));
+        for (int oh = 0; oh < h_out; ++oh) {
+          svfloat32_t acc = svdup_n_f32(bias_val);
+          for (int kh = 0; kh < 3; ++kh) {
+            int ih = oh * stride - pad_h + kh;
+            if (ih < 0 || ih >= h_in) {
+              continue;
+            }
+            const float* din_row = din_ch + ih * w_in;
+            const float* w_row = wei + kh * 3;
+            svfloat32_t x0 =
+                load_dw_cols(valid_0, din_row, iw0, iw_0, stride);
+            svfloat32_t x1 =
+                load_dw_cols(valid_1, din_row, iw0 + 1, iw_1, stride);
+            svfloat32_t x2 =
+                load_dw_cols(valid_2, din_row, iw0 + 2, iw_2, stride);
+            acc = svmla_n_f32_x(pg, acc, x0, w_row[0]);
+            acc = svmla_n_f32_x(pg, acc, x1, w_row[1]);
+            acc = svmla_n_f32_x(pg, acc, x2, w_row[2]);
+          }
+          acc = act_ps(pg, acc, flag_act, alpha);
+          svst1_f32(pg, dout_ch + oh * w_out + ow, acc);
+        }
+      }
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// 3x3 depthwise conv for stride 1 or 2 and any padding, weights in the
+// original [ch, 1, 3, 3] layout. Same signature as conv_depthwise_3x3_fp32.
+void conv_depthwise_3x3_fp32(const void* din,
+                             void* dout,
+                             int num,
+                             int ch_out,
+                             int h_out,
+                             int w_out,
+                             int ch_in,
+                             int h_in,
+                             int w_in,
+                             const void* weights,
+                             const float* bias,
+                             const operators::ConvParam& param,
+                             ARMContext* ctx,
+                             const float* scale);
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
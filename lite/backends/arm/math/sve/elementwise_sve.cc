@@ -0,0 +1,148 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/elementwise_sve.h"
+#include <algorithm>
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+struct AddOp {
+  static svfloat32_t Run(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+    return svadd_f32_x(pg, x, y);
+  }
+};
+
+struct SubOp {
+  static svfloat32_t Run(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+    return svsub_f32_x(pg, x, y);
+  }
+};
+
+struct MulOp {
+  static svfloat32_t Run(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+    return svmul_f32_x(pg, x, y);
+  }
+};
+
+struct MaxOp {
+  static svfloat32_t Run(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+    return svmax_f32_x(pg, x, y);
+  }
+};
+
+struct MinOp {
+  static svfloat32_t Run(svbool_t pg, svfloat32_t x, svfloat32_t y) {
+    return svmin_f32_x(pg, x, y);
+  }
+};
+
+// Each task handles a multiple of the vector length, so only the last one
+// runs a partial vector.
+template <typename Op, bool kRelu>
+void elementwise_sve(const float* dinx,
+                     const float* diny,
+                     float* dout,
+                     int num) {
+  const int vl = svcntw();
+  const int block = vl * 16;
+  int cnt = (num + block - 1) / block;
+  LITE_PARALLEL_BEGIN(i, tid, cnt) {
+    int end = std::min(num, (i + 1) * block);
+    for (int j = i * block; j < end; j += vl) {
+      svbool_t pg = svwhilelt_b32(j, end);
+      svfloat32_t out =
+          Op::Run(pg, svld1_f32(pg, dinx + j), svld1_f32(pg, diny + j));
+      if (kRelu) {
+        out = svmax_n_f32_x(pg, out, 0.f);
+      }
+      svst1_f32(pg, dout + j, out);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// dout[b][c][k] = dinx[b][c][k] op diny[c]
+template <typename Op, bool kRelu>
+void elementwise_broadcast_sve(const float* dinx,
+                               const float* diny,
+                               float* dout,
+                               int batch,
+                               int channels,
+                               int num) {
+  const int vl = svcntw();
+  for (int i = 0; i < batch; ++i) {
+    LITE_PARALLEL_BEGIN(j, tid, channels) {
+      int offset = (i * channels + j) * num;
+      const float* din_ptr = dinx + offset;
+      float* dout_ptr = dout + offset;
+      svfloat32_t rb = svdup_n_f32(diny[j]);
+      for (int k = 0; k < num; k += vl) {
+        svbool_t pg = svwhilelt_b32(k, num);
+        svfloat32_t out = Op::Run(pg, svld1_f32(pg, din_ptr + k), rb);
+        if (kRelu) {
+          out = svmax_n_f32_x(pg, out, 0.f);
+        }
+        svst1_f32(pg, dout_ptr + k, out);
+      }
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
+#define ELEMENTWISE_SVE_IMPL(name, op)                                   \
+  void elementwise_##name(                                               \
+      const float* dinx, const float* diny, float* dout, int num) {      \
+    elementwise_sve<op, false>(dinx, diny, dout, num);                   \
+  }                                                                      \
+  void elementwise_##name##_relu(                                        \
+      const float* dinx, const float* diny, float* dout, int num) {      \
+    elementwise_sve<op, true>(dinx, diny, dout, num);                    \
+  }                                                                      \
+  void elementwise_##name##_broadcast(const float* dinx,                 \
+                                      const float* diny,                 \
+                                      float* dout,                       \
+                                      int batch,                         \
+                                      int channels,                      \
+                                      int num) {                         \
+    elementwise_broadcast_sve<op, false>(                                \
+        dinx, diny, dout, batch, channels, num);                         \
+  }                                                                      \
+  void elementwise_##name##_relu_broadcast(const float* dinx,            \
+                                           const float* diny,            \
+                                           float* dout,                  \
+                                           int batch,                    \
+                                           int channels,                 \
+                                           int num) {                    \
+    elementwise_broadcast_sve<op, true>(                                 \
+        dinx, diny, dout, batch, channels, num);                         \
+  }
+
+ELEMENTWISE_SVE_IMPL(add, AddOp)
+ELEMENTWISE_SVE_IMPL(sub, SubOp)
+ELEMENTWISE_SVE_IMPL(mul, MulOp)
+ELEMENTWISE_SVE_IMPL(max, MaxOp)
+ELEMENTWISE_SVE_IMPL(min, MinOp)
+#undef ELEMENTWISE_SVE_IMPL
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
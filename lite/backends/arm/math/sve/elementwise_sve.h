@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+#define ELEMENTWISE_SVE_DECLARE(name)                                  \
+  void elementwise_##name(                                             \
+      const float* dinx, const float* diny, float* dout, int num);     \
+  void elementwise_##name##_relu(                                      \
+      const float* dinx, const float* diny, float* dout, int num);     \
+  void elementwise_##name##_broadcast(const float* dinx,               \
+                                      const float* diny,               \
+                                      float* dout,                     \
+                                      int batch,                       \
+                                      int channels,                    \
+                                      int num);                        \
+  void elementwise_##name##_relu_broadcast(const float* dinx,          \
+                                           const float* diny,          \
+                                           float* dout,                \
+                                           int batch,                  \
+                                           int channels,               \
+                                           int num);
+
+ELEMENTWISE_SVE_DECLARE(add)
+ELEMENTWISE_SVE_DECLARE(sub)
+ELEMENTWISE_SVE_DECLARE(mul)
+ELEMENTWISE_SVE_DECLARE(max)
+ELEMENTWISE_SVE_DECLARE(min)
+#undef ELEMENTWISE_SVE_DECLARE
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,254 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/gemm_sve.h"
+#include <algorithm>
+#include <cmath>
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// The micro kernel computes MBLOCK_SVE rows by two vectors of columns.
+const int MBLOCK_SVE = 8;
+// Largest sve vector is 2048 bits.
+const int MAX_NBLOCK_SVE = 2 * 64;
+
+// A is packed in blocks of 8 rows, each k stores the 8 rows next to each
+// other, alpha is folded in and missing rows are zero.
+void prepackA_sve(float* out,
+                  const float* in,
+                  float alpha,
+                  int ldin,
+                  int M,
+                  int K,
+                  bool is_trans) {
+  LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_SVE) {
+    float* outptr = out + y * K;
+    int rows = std::min(M - y, MBLOCK_SVE);
+    for (int k = 0; k < K; ++k) {
+      for (int i = 0; i < MBLOCK_SVE; ++i) {
+        float v = 0.f;
+        if (i < rows) {
+          v = is_trans ? in[k * ldin + y + i] : in[(y + i) * ldin + k];
+        }
+        *outptr++ = alpha * v;
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+// B columns [n0, nmax) are packed in strips of two vectors, each k stores
+// the strip contiguously, missing columns are zero.
+void packB_sve(float* out,
+               const float* in,
+               int ldin,
+               int K,
+               int n0,
+               int nmax,
+               bool is_trans) {
+  const int vl = svcntw();
+  const int nblock = 2 * vl;
+  svbool_t all = svptrue_b32();
+  LITE_PARALLEL_COMMON_BEGIN(x, tid, nmax, n0, nblock) {
+    float* outptr = out + (x - n0) * K;
+    int cols = nmax - x;
+    svbool_t pg0 = svwhilelt_b32(0, cols);
+    svbool_t pg1 = svwhilelt_b32(vl, cols);
+    if (!is_trans) {
+      for (int k = 0; k < K; ++k) {
+        const float* inptr = in + k * ldin + x;
+        svst1_f32(all, outptr, svld1_f32(pg0, inptr));
+        svst1_f32(all, outptr + vl, svld1_f32(pg1, inptr + vl));
+        outptr += nblock;
+      }
+    } else {
+      svint32_t offset = svindex_s32(0, ldin);
+      for (int k = 0; k < K; ++k) {
+        const float* inptr = in + x * ldin + k;
+        svst1_f32(all, outptr, svld1_gather_s32index_f32(pg0, inptr, offset));
+        svst1_f32(all,
+                  outptr + vl,
+                  svld1_gather_s32index_f32(pg1, inptr + vl * ldin, offset));
+        outptr += nblock;
+      }
+    }
+  }
+  LITE_PARALLEL_COMMON_END();
+}
+
+// Starts an accumulator from bias plus beta * C.
+inline svfloat32_t sgemm_sve_init(
+    svbool_t pg, const float* c_ptr, float bias, float beta, bool has_beta) {
+  svfloat32_t acc = svdup_n_f32(bias);
+  if (has_beta) {
+    acc = svmla_n_f32_x(pg, acc, svld1_f32(pg, c_ptr), beta);
+  }
+  return acc;
+}
+
+#define SGEMM_SVE_INIT(r)                                                \
+  svfloat32_t c##r##0 =                                                  \
+      sgemm_sve_init(pg0, c_ptr[r], bias[r], beta, has_beta);            \
+  svfloat32_t c##r##1 =                                                  \
+      sgemm_sve_init(pg1, c_ptr[r] + vl, bias[r], beta, has_beta);
+
+#define SGEMM_SVE_FMA(r, a, lane)                   \
+  c##r##0 = svmla_lane_f32(c##r##0, b0, a, lane); \
+  c##r##1 = svmla_lane_f32(c##r##1, b1, a, lane);
+
+#define SGEMM_SVE_STORE(r)                                              \
+  svst1_f32(pg0, c_ptr[r], act_ps(pg0, c##r##0, flag_act, act_alpha)); \
+  svst1_f32(pg1, c_ptr[r] + vl, act_ps(pg1, c##r##1, flag_act, act_alpha));
+
+// 8 x (2 * vl) tile, c_ptr rows past M point to a scratch row.
+void sgemm_sve_kernel(const float* a_ptr,
+                      const float* b_ptr,
+                      int K,
+                      float** c_ptr,
+                      const float* bias,
+                      float beta,
+                      bool has_beta,
+                      svbool_t pg0,
+                      svbool_t pg1,
+                      int flag_act,
+                      float act_alpha) {
+  const int vl = svcntw();
+  svbool_t all = svptrue_b32();
+  SGEMM_SVE_INIT(0)
+  SGEMM_SVE_INIT(1)
+  SGEMM_SVE_INIT(2)
+  SGEMM_SVE_INIT(3)
+  SGEMM_SVE_INIT(4)
+  SGEMM_SVE_INIT(5)
+  SGEMM_SVE_INIT(6)
+  SGEMM_SVE_INIT(7)
+  for (int k = 0; k < K; ++k) {
+    svfloat32_t b0 = svld1_f32(all, b_ptr);
+    svfloat32_t b1 = svld1_f32(all, b_ptr + vl);
+    // each 128-bit segment holds the same 4 values of A
+    svfloat32_t a0 = svld1rq_f32(all, a_ptr);
+    svfloat32_t a1 = svld1rq_f32(all, a_ptr + 4);
+    SGEMM_SVE_FMA(0, a0, 0)
+    SGEMM_SVE_FMA(1, a0, 1)
+    SGEMM_SVE_FMA(2, a0, 2)
+    SGEMM_SVE_FMA(3, a0, 3)
+    SGEMM_SVE_FMA(4, a1, 0)
+    SGEMM_SVE_FMA(5, a1, 1)
+    SGEMM_SVE_FMA(6, a1, 2)
+    SGEMM_SVE_FMA(7, a1, 3)
+    a_ptr += MBLOCK_SVE;
+    b_ptr += 2 * vl;
+  }
+  SGEMM_SVE_STORE(0)
+  SGEMM_SVE_STORE(1)
+  SGEMM_SVE_STORE(2)
+  SGEMM_SVE_STORE(3)
+  SGEMM_SVE_STORE(4)
+  SGEMM_SVE_STORE(5)
+  SGEMM_SVE_STORE(6)
+  SGEMM_SVE_STORE(7)
+}
+
+#undef SGEMM_SVE_INIT
+#undef SGEMM_SVE_FMA
+#undef SGEMM_SVE_STORE
+
+void sgemm(bool is_transA,
+           bool is_transB,
+           int M,
+           int N,
+           int K,
+           float alpha,
+           const float* A,
+           int lda,
+           const float* B,
+           int ldb,
+           float beta,
+           float* C,
+           int ldc,
+           const float* bias,
+           bool is_bias,
+           const operators::ActivationParam act_param,
+           ARMContext* ctx) {
+  int flag_act = 0;
+  float act_alpha = 0.f;
+  get_act_flag(act_param, &flag_act, &act_alpha);
+  bool has_beta = fabsf(beta) > 1e-8f;
+  const int vl = svcntw();
+  const int nblock = 2 * vl;
+
+  //! x * k (B panel) fills the l2 cache
+  int x_block = ctx->llc_size() / sizeof(float) / std::max(K, 1);
+  x_block = std::max(x_block / nblock * nblock, nblock);
+  int x_num = (N + (x_block - 1)) / x_block;
+  x_block = (N + x_num - 1) / x_num;
+  x_block = (x_block + nblock - 1) / nblock * nblock;
+
+  int m_roundup = (M + MBLOCK_SVE - 1) / MBLOCK_SVE * MBLOCK_SVE;
+  int b_size = x_block * K;
+  ctx->ExtendWorkspace((b_size + m_roundup * K) * sizeof(float));
+  float* b_panel = ctx->workspace_data<float>();
+  float* a_packed = b_panel + b_size;
+
+  prepackA_sve(a_packed, A, alpha, lda, M, K, is_transA);
+
+  for (int x0 = 0; x0 < N; x0 += x_block) {
+    int xmax = std::min(x0 + x_block, N);
+    packB_sve(b_panel, B, ldb, K, x0, xmax, is_transB);
+
+    LITE_PARALLEL_COMMON_BEGIN(y, tid, M, 0, MBLOCK_SVE) {
+      int rows = std::min(M - y, MBLOCK_SVE);
+      float bias_local[MBLOCK_SVE] = {0.f};
+      float c_scratch[MAX_NBLOCK_SVE] = {0.f};
+      float* c_ptr[MBLOCK_SVE];
+      for (int i = 0; i < rows; ++i) {
+        bias_local[i] = is_bias ? bias[y + i] : 0.f;
+      }
+      const float* a_ptr = a_packed + y * K;
+      const float* b_ptr = b_panel;
+      for (int x = x0; x < xmax; x += nblock) {
+        for (int i = 0; i < MBLOCK_SVE; ++i) {
+          c_ptr[i] = i < rows ? C + (y + i) * ldc + x : c_scratch;
+        }
+        svbool_t pg0 = svwhilelt_b32(x, xmax);
+        svbool_t pg1 = svwhilelt_b32(x + vl, xmax);
+        sgemm_sve_kernel(a_ptr,
+                         b_ptr,
+                         K,
+                         c_ptr,
+                         bias_local,
+                         beta,
+                         has_beta,
+                         pg0,
+                         pg1,
+                         flag_act,
+                         act_alpha);
+        b_ptr += nblock * K;
+      }
+    }
+    LITE_PARALLEL_COMMON_END();
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
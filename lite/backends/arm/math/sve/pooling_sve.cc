@@ -0,0 +1,157 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/pooling_sve.h"
+#include <algorithm>
+#include <limits>
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+void pooling_global_max(const float* din,
+                        float* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win) {
+  int size_channel_in = win * hin;
+  const int vl = svcntw();
+  for (int n = 0; n < num; ++n) {
+    float* dout_batch = dout + n * chout;
+    const float* din_batch = din + n * chin * size_channel_in;
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
+      const float* din_ch = din_batch + c * size_channel_in;
+      svfloat32_t vmax = svdup_n_f32(din_ch[0]);
+      for (int i = 0; i < size_channel_in; i += vl) {
+        svbool_t pg = svwhilelt_b32(i, size_channel_in);
+        vmax = svmax_f32_m(pg, vmax, svld1_f32(pg, din_ch + i));
+      }
+      dout_batch[c] = svmaxv_f32(svptrue_b32(), vmax);
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
+void pooling_global_avg(const float* din,
+                        float* dout,
+                        int num,
+                        int chout,
+                        int hout,
+                        int wout,
+                        int chin,
+                        int hin,
+                        int win) {
+  int size_channel_in = win * hin;
+  const int vl = svcntw();
+  for (int n = 0; n < num; ++n) {
+    float* dout_batch = dout + n * chout;
+    const float* din_batch = din + n * chin * size_channel_in;
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
+      const float* din_ch = din_batch + c * size_channel_in;
+      svfloat32_t vsum = svdup_n_f32(0.f);
+      for (int i = 0; i < size_channel_in; i += vl) {
+        svbool_t pg = svwhilelt_b32(i, size_channel_in);
+        vsum = svadd_f32_m(pg, vsum, svld1_f32(pg, din_ch + i));
+      }
+      dout_batch[c] = svaddv_f32(svptrue_b32(), vsum) / size_channel_in;
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
+void pooling(const float* din,
+             float* dout,
+             int num,
+             int chout,
+             int hout,
+             int wout,
+             int chin,
+             int hin,
+             int win,
+             const std::vector<int>& ksize,
+             const std::vector<int>& strides,
+             const std::vector<int>& paddings,
+             bool is_max) {
+  int kernel_h = ksize[0];
+  int kernel_w = ksize[1];
+  int stride_h = strides[0];
+  int stride_w = strides[1];
+  int pad_h = paddings[0];
+  int pad_w = paddings[2];
+  int size_channel_in = win * hin;
+  int size_channel_out = wout * hout;
+  const int vl = svcntw();
+  const float init = is_max ? std::numeric_limits<float>::lowest() : 0.f;
+
+  for (int n = 0; n < num; ++n) {
+    LITE_PARALLEL_BEGIN(c, tid, chout) {
+      const float* din_ch = din + (n * chin + c) * size_channel_in;
+      float* dout_ch = dout + (n * chout + c) * size_channel_out;
+      for (int oh = 0; oh < hout; ++oh) {
+        int sh = oh * stride_h - pad_h;
+        int eh = std::min(sh + kernel_h, hin);
+        sh = std::max(sh, 0);
+        float* dout_row = dout_ch + oh * wout;
+        for (int ow = 0; ow < wout; ow += vl) {
+          svbool_t pg = svwhilelt_b32(ow, wout);
+          svfloat32_t vres = svdup_n_f32(init);
+          svfloat32_t vcnt = svdup_n_f32(0.f);
+          for (int kw = 0; kw < kernel_w; ++kw) {
+            // input columns of this window column, padding is masked off
+            int iw0 = ow * stride_w - pad_w + kw;
+            svint32_t iw = svindex_s32(iw0, stride_w);
+            svbool_t valid = svand_b_z(pg,
+                                       svcmpge_n_s32(pg, iw, 0),
+                                       svcmplt_n_s32(pg, iw, win));
+            for (int ih = sh; ih < eh; ++ih) {
+              const float* din_row = din_ch + ih * win;
+              svfloat32_t x =
+                  stride_w == 1
+                      ? svld1_f32(valid, din_row + iw0)
+                      : svld1_gather_s32index_f32(valid, din_row, iw);
+              if (is_max) {
+                vres = svmax_f32_m(valid, vres, x);
+              } else {
+                vres = svadd_f32_m(valid, vres, x);
+              }
+              vcnt = svadd_n_f32_m(valid, vcnt, 1.f);
+            }
+          }
+          // windows that only cover padding give 0, as pooling_basic does
+          svbool_t empty = svcmpeq_n_f32(pg, vcnt, 0.f);
+          if (!is_max) {
+            vres = svdiv_f32_x(pg, vres, svmax_n_f32_x(pg, vcnt, 1.f));
+          }
+          vres = svsel_f32(empty, svdup_n_f32(0.f), vres);
+          svst1_f32(pg, dout_row + ow, vres);
+        }
+      }
+    }
+    LITE_PARALLEL_END();
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
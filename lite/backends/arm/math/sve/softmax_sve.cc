@@ -0,0 +1,118 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/arm/math/sve/softmax_sve.h"
+#include <algorithm>
+#include "lite/backends/arm/math/sve/common_sve.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace arm {
+namespace math {
+namespace sve {
+
+// axis is the innermost dim, every row is reduced on its own
+void softmax_inner1(const float* din,
+                    float* dout,
+                    int axis_size,
+                    int outer_num) {
+  const int vl = svcntw();
+  LITE_PARALLEL_BEGIN(i, tid, outer_num) {
+    const float* din_ptr = din + i * axis_size;
+    float* dout_ptr = dout + i * axis_size;
+    svbool_t all = svptrue_b32();
+
+    svfloat32_t vmax = svdup_n_f32(din_ptr[0]);
+    for (int j = 0; j < axis_size; j += vl) {
+      svbool_t pg = svwhilelt_b32(j, axis_size);
+      vmax = svmax_f32_m(pg, vmax, svld1_f32(pg, din_ptr + j));
+    }
+    float max_data = svmaxv_f32(all, vmax);
+
+    svfloat32_t vsum = svdup_n_f32(0.f);
+    for (int j = 0; j < axis_size; j += vl) {
+      svbool_t pg = svwhilelt_b32(j, axis_size);
+      svfloat32_t x = svsub_n_f32_x(pg, svld1_f32(pg, din_ptr + j), max_data);
+      x = exp_ps(pg, x);
+      svst1_f32(pg, dout_ptr + j, x);
+      vsum = svadd_f32_m(pg, vsum, x);
+    }
+    float sum_inv = 1.f / svaddv_f32(all, vsum);
+
+    for (int j = 0; j < axis_size; j += vl) {
+      svbool_t pg = svwhilelt_b32(j, axis_size);
+      svfloat32_t x = svld1_f32(pg, dout_ptr + j);
+      svst1_f32(pg, dout_ptr + j, svmul_n_f32_x(pg, x, sum_inv));
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+// the axis is strided by inner_num, vectors run along the inner dim
+void softmax_inner(const float* din,
+                   float* dout,
+                   int axis_size,
+                   int inner_num,
+                   int outer_num) {
+  const int vl = svcntw();
+  int inner_cnt = (inner_num + vl - 1) / vl;
+  int compute_size = outer_num * inner_cnt;
+  LITE_PARALLEL_BEGIN(i, tid, compute_size) {
+    int idx_outer = i / inner_cnt;
+    int idx_inner = (i % inner_cnt) * vl;
+    int offset = idx_outer * axis_size * inner_num + idx_inner;
+    const float* din_ptr = din + offset;
+    float* dout_ptr = dout + offset;
+    svbool_t pg = svwhilelt_b32(idx_inner, inner_num);
+
+    svfloat32_t vmax = svld1_f32(pg, din_ptr);
+    for (int j = 1; j < axis_size; ++j) {
+      vmax = svmax_f32_x(pg, vmax, svld1_f32(pg, din_ptr + j * inner_num));
+    }
+
+    svfloat32_t vsum = svdup_n_f32(0.f);
+    for (int j = 0; j < axis_size; ++j) {
+      svfloat32_t x = svld1_f32(pg, din_ptr + j * inner_num);
+      x = exp_ps(pg, svsub_f32_x(pg, x, vmax));
+      svst1_f32(pg, dout_ptr + j * inner_num, x);
+      vsum = svadd_f32_x(pg, vsum, x);
+    }
+
+    svfloat32_t vsum_inv = svdiv_f32_x(pg, svdup_n_f32(1.f), vsum);
+    for (int j = 0; j < axis_size; ++j) {
+      svfloat32_t x = svld1_f32(pg, dout_ptr + j * inner_num);
+      svst1_f32(pg, dout_ptr + j * inner_num, svmul_f32_x(pg, x, vsum_inv));
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void softmax(const float* din,
+             float* dout,
+             int axis_size,
+             int inner_num,
+             int outer_num) {
+  if (inner_num == 1) {
+    softmax_inner1(din, dout, axis_size, outer_num);
+  } else {
+    softmax_inner(din, dout, axis_size, inner_num, outer_num);
+  }
+}
+
+}  // namespace sve
+}  // namespace math
+}  // namespace arm
+}  // namespace lite
+}  // namespace paddle
@@ -17,12 +17,32 @@
 #include <utility>
 #include <vector>
 #include "lite/backends/host/math/poly_util.h"
+#include "lite/core/parallel_defines.h"
 #include "lite/core/tensor.h"
+#ifdef LITE_WITH_X86
+#include "lite/backends/x86/parallel.h"
+#endif
 namespace paddle {
 namespace lite {
 namespace host {
 namespace math {
 
+// Calls f(i) for every i in [0, n) in parallel. LITE_PARALLEL_BEGIN is a
+// serial loop on x86, so x86 builds use the omp threads of RunParallelFor.
+template <typename Func>
+void ParallelFor(int64_t n, const Func& f) {
+#ifdef LITE_WITH_X86
+  lite::x86::RunParallelFor(0, n, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      f(i);
+    }
+  });
+#else
+  LITE_PARALLEL_BEGIN(i, tid, n) { f(i); }
+  LITE_PARALLEL_END();
+#endif
+}
+
 template <typename T>
 bool SortScorePairDescend(const std::pair<float, T>& pair1,
                           const std::pair<float, T>& pair2) {
@@ -39,13 +59,22 @@ static void GetMaxScoreIndex(const std::vector<T>& scores,
       sorted_indices->push_back(std::make_pair(scores[i], i));
     }
   }
-  // Sort the score pair according to the scores in descending order
-  std::stable_sort(sorted_indices->begin(),
-                   sorted_indices->end(),
-                   SortScorePairDescend<int>);
-  // Keep top_k scores if needed.
+  // Candidates are pushed in ascending index order, so breaking score ties by
+  // index gives the same order as a stable sort and lets us only sort the
+  // top_k head of the array instead of all candidates.
+  auto score_index_descend = [](const std::pair<T, int>& a,
+                                const std::pair<T, int>& b) {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  };
   if (top_k > -1 && top_k < static_cast<int>(sorted_indices->size())) {
+    std::partial_sort(sorted_indices->begin(),
+                      sorted_indices->begin() + top_k,
+                      sorted_indices->end(),
+                      score_index_descend);
     sorted_indices->resize(top_k);
+  } else {
+    std::sort(
+        sorted_indices->begin(), sorted_indices->end(), score_index_descend);
   }
 }
 
@@ -87,6 +116,85 @@ static T JaccardOverlap(const T* box1, const T* box2, const bool normalized) {
   }
 }
 
+// Axis-aligned boxes [xmin ymin xmax ymax] stored as structure-of-arrays
+// together with their areas. Overlaps of one box against a range of stored
+// boxes are then computed by a branch-free loop over contiguous arrays which
+// the compiler vectorizes, and each value equals JaccardOverlap(box, stored).
+template <typename T>
+class BoxesSoA {
+ public:
+  BoxesSoA(size_t capacity, bool normalized) : normalized_(normalized) {
+    xmin_.reserve(capacity);
+    ymin_.reserve(capacity);
+    xmax_.reserve(capacity);
+    ymax_.reserve(capacity);
+    area_.reserve(capacity);
+  }
+
+  size_t size() const { return area_.size(); }
+
+  void Push(const T* box) {
+    xmin_.push_back(box[0]);
+    ymin_.push_back(box[1]);
+    xmax_.push_back(box[2]);
+    ymax_.push_back(box[3]);
+    area_.push_back(BBoxArea<T>(box, normalized_));
+  }
+
+  // overlaps[i - begin] = JaccardOverlap(box, stored[i]), i in [begin, end).
+  void Overlaps(const T* box, int64_t begin, int64_t end, T* overlaps) const {
+    const T norm = normalized_ ? static_cast<T>(0.) : static_cast<T>(1.);
+    const T box_area = BBoxArea<T>(box, normalized_);
+    const T* xmin = xmin_.data();
+    const T* ymin = ymin_.data();
+    const T* xmax = xmax_.data();
+    const T* ymax = ymax_.data();
+    const T* area = area_.data();
+    for (int64_t i = begin; i < end; ++i) {
+      const bool disjoint = (xmin[i] > box[2]) | (xmax[i] < box[0]) |
+                            (ymin[i] > box[3]) | (ymax[i] < box[1]);
+      const T inter_xmin = (std::max)(box[0], xmin[i]);
+      const T inter_ymin = (std::max)(box[1], ymin[i]);
+      const T inter_xmax = (std::min)(box[2], xmax[i]);
+      const T inter_ymax = (std::min)(box[3], ymax[i]);
+      const T inter_w = inter_xmax - inter_xmin + norm;
+      const T inter_h = inter_ymax - inter_ymin + norm;
+      const T inter_area = inter_w * inter_h;
+      overlaps[i - begin] =
+          disjoint ? static_cast<T>(0.)
+                   : inter_area / (box_area + area[i] - inter_area);
+    }
+  }
+
+  // Greedy NMS test: true if any stored box fails `overlap <= threshold`.
+  // Boxes are tested a block at a time so that we can still stop early.
+  bool Suppress(const T* box, const T threshold) const {
+    const int64_t kBlock = 16;
+    T overlaps[kBlock];
+    const int64_t num = static_cast<int64_t>(area_.size());
+    for (int64_t begin = 0; begin < num; begin += kBlock) {
+      const int64_t end = (std::min)(num, begin + kBlock);
+      Overlaps(box, begin, end, overlaps);
+      int suppressed = 0;
+      for (int64_t i = 0; i < end - begin; ++i) {
+        suppressed |= !(overlaps[i] <= threshold);
+      }
+      if (suppressed) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  bool normalized_;
+  std::vector<T> xmin_;
+  std::vector<T> ymin_;
+  std::vector<T> xmax_;
+  std::vector<T> ymax_;
+  std::vector<T> area_;
+};
+
 template <typename T>
 T PolyIoU(const T* box1,
           const T* box2,
@@ -149,27 +257,20 @@ static Tensor NMS(Tensor* bbox,
       GetSortedScoreIndex<T>(scores_data);
 
   std::vector<int> selected_indices;
+  selected_indices.reserve(num_boxes);
+  BoxesSoA<T> kept_boxes(num_boxes, !pixel_offset);
   int selected_num = 0;
   T adaptive_threshold = nms_threshold;
   const T* bbox_data = bbox->data<T>();
-  while (sorted_indices.size() != 0) {
-    int idx = sorted_indices.back().second;
-    bool flag = true;
-    for (int kept_idx : selected_indices) {
-      if (flag) {
-        T overlap = JaccardOverlap<T>(bbox_data + idx * box_size,
-                                      bbox_data + kept_idx * box_size,
-                                      !pixel_offset);
-        flag = (overlap <= adaptive_threshold);
-      } else {
-        break;
-      }
-    }
+  for (auto it = sorted_indices.rbegin(); it != sorted_indices.rend(); ++it) {
+    int idx = it->second;
+    const T* box = bbox_data + idx * box_size;
+    bool flag = !kept_boxes.Suppress(box, adaptive_threshold);
     if (flag) {
       selected_indices.push_back(idx);
+      kept_boxes.Push(box);
       ++selected_num;
     }
-    sorted_indices.erase(sorted_indices.end() - 1);
     if (flag && eta < 1 && adaptive_threshold > 0.5) {
       adaptive_threshold *= eta;
     }
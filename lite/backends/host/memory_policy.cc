@@ -0,0 +1,204 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/host/memory_policy.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "lite/utils/log/cp_logging.h"
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+namespace {
+
+const size_t kHugePageSize = 2 * 1024 * 1024;
+// Nodes beyond the first 64 are not bound.
+const int kMaxNumaNodes = 64;
+
+std::atomic<int> huge_page_mode{lite_api::LITE_HUGE_PAGE_NONE};
+std::atomic<int> numa_policy{lite_api::LITE_NUMA_NONE};
+std::atomic<int> numa_node{0};
+
+// The mask of the online nodes, from a list as "0-1,4".
+uint64_t OnlineNodes() {
+  uint64_t mask = 1;
+#if defined(__linux__)
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string list;
+  if (!(file >> list)) return mask;
+  mask = 0;
+  std::stringstream ss(list);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last =
+        dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int i = first; i <= last && i < kMaxNumaNodes; ++i) {
+      mask |= uint64_t{1} << i;
+    }
+  }
+  if (mask == 0) mask = 1;
+#endif
+  return mask;
+}
+
+uint64_t CachedOnlineNodes() {
+  static const uint64_t mask = OnlineNodes();
+  return mask;
+}
+
+#if defined(__linux__)
+// Aligns an anonymous mapping to the huge pages, which the kernel may not do
+// for the transparent huge pages.
+void* MapAligned(size_t length) {
+  void* p = mmap(nullptr,
+                 length + kHugePageSize,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS,
+                 -1,
+                 0);
+  if (p == MAP_FAILED) return nullptr;
+  auto begin = reinterpret_cast<uintptr_t>(p);
+  auto aligned = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  if (aligned > begin) {
+    munmap(p, aligned - begin);
+  }
+  size_t tail = begin + kHugePageSize - aligned;
+  if (tail > 0) {
+    munmap(reinterpret_cast<void*>(aligned + length), tail);
+  }
+  return reinterpret_cast<void*>(aligned);
+}
+
+void BindPages(void* ptr, size_t length, int policy) {
+  const uint64_t online = CachedOnlineNodes();
+  // Nothing to bind on a single node.
+  if ((online & (online - 1)) == 0) return;
+  uint64_t mask = online;
+  int mode = MPOL_INTERLEAVE;
+  if (policy == lite_api::LITE_NUMA_LOCAL) {
+    // Preferred instead of bound, so a full node falls back to the others.
+    mask = uint64_t{1} << numa_node.load();
+    mode = MPOL_PREFERRED;
+  }
+  // The pages are not touched yet, so they are placed at the first touch.
+  if (syscall(SYS_mbind, ptr, length, mode, &mask, kMaxNumaNodes + 1, 0) !=
+      0) {
+    VLOG(4) << "mbind failed, the memory is placed by the system.";
+  }
+}
+#endif
+
+}  // namespace
+
+void SetHugePageMode(lite_api::HugePageMode mode) { huge_page_mode = mode; }
+
+lite_api::HugePageMode GetHugePageMode() {
+  return static_cast<lite_api::HugePageMode>(huge_page_mode.load());
+}
+
+void SetNumaPolicy(lite_api::NumaPolicy policy) {
+  numa_node = CurrentNumaNode();
+  numa_policy = policy;
+}
+
+lite_api::NumaPolicy GetNumaPolicy() {
+  return static_cast<lite_api::NumaPolicy>(numa_policy.load());
+}
+
+int NumaNodeCount() {
+  uint64_t online = CachedOnlineNodes();
+  int count = 0;
+  for (; online; online &= online - 1) count++;
+  return count;
+}
+
+int CurrentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0 &&
+      node < static_cast<unsigned>(kMaxNumaNodes)) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
+void* MapPages(size_t size, size_t* mapped) {
+#if defined(__linux__)
+  const int mode = huge_page_mode.load();
+  const int policy = numa_policy.load();
+  if (size < kHugePageSize || (mode == lite_api::LITE_HUGE_PAGE_NONE &&
+                               policy == lite_api::LITE_NUMA_NONE)) {
+    return nullptr;
+  }
+  const size_t length =
+      (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  void* p = nullptr;
+  if (mode == lite_api::LITE_HUGE_PAGE_EXPLICIT) {
+    p = mmap(nullptr,
+             length,
+             PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB,
+             -1,
+             0);
+    if (p == MAP_FAILED) {
+      static std::atomic<bool> warned{false};
+      if (!warned.exchange(true)) {
+        LOG(WARNING) << "No explicit huge pages are reserved, the "
+                        "transparent huge pages are used instead.";
+      }
+      p = nullptr;
+    }
+  }
+  if (!p) {
+    p = MapAligned(length);
+    if (!p) return nullptr;
+#ifdef MADV_HUGEPAGE
+    if (mode != lite_api::LITE_HUGE_PAGE_NONE) {
+      madvise(p, length, MADV_HUGEPAGE);
+    }
+#endif
+  }
+  if (policy != lite_api::LITE_NUMA_NONE) {
+    BindPages(p, length, policy);
+  }
+  *mapped = length;
+  return p;
+#else
+  return nullptr;
+#endif
+}
+
+void UnmapPages(void* ptr, size_t mapped) {
+#if defined(__linux__)
+  munmap(ptr, mapped);
+#endif
+}
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
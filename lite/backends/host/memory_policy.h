@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include "lite/api/paddle_place.h"
+
+namespace paddle {
+namespace lite {
+namespace host {
+
+// The policy of the large host allocations, e.g. the weights and the
+// workspaces of the activations. The allocations below one huge page are
+// always served by malloc.
+void SetHugePageMode(lite_api::HugePageMode mode);
+lite_api::HugePageMode GetHugePageMode();
+// LITE_NUMA_LOCAL binds the memory to the node of the calling thread, so it
+// should be set from a thread running on the cores which run the predictor.
+void SetNumaPolicy(lite_api::NumaPolicy policy);
+lite_api::NumaPolicy GetNumaPolicy();
+
+// The number of the online NUMA nodes, 1 where it is unknown.
+int NumaNodeCount();
+// The NUMA node of the calling thread, 0 where it is unknown.
+int CurrentNumaNode();
+
+// Maps `size` bytes of anonymous memory following the policy, and returns
+// nullptr if the policy does not apply, in which case the caller falls back
+// to malloc. The length to unmap is returned in `mapped`.
+void* MapPages(size_t size, size_t* mapped);
+void UnmapPages(void* ptr, size_t mapped);
+
+}  // namespace host
+}  // namespace lite
+}  // namespace paddle
@@ -15,28 +15,41 @@
 #include "lite/core/target_wrapper.h"
 #include <cstring>
 #include <memory>
+#include "lite/backends/host/memory_policy.h"
 
 namespace paddle {
 namespace lite {
 
 const int MALLOC_ALIGN = 64;
 
+// The pointer to release is kept at [-1] of every block, and the length of
+// the mapping at [-2], which is 0 for the blocks from malloc.
 void* TargetWrapper<TARGET(kHost)>::Malloc(size_t size) {
-  size_t offset = sizeof(void*) + MALLOC_ALIGN - 1;
+  size_t offset = 2 * sizeof(void*) + MALLOC_ALIGN - 1;
   CHECK(size);
   CHECK_GT(offset + size, size);
-  char* p = static_cast<char*>(malloc(offset + size));
+  size_t mapped = 0;
+  char* p = static_cast<char*>(host::MapPages(offset + size, &mapped));
+  if (!p) {
+    p = static_cast<char*>(malloc(offset + size));
+  }
   CHECK(p) << "Error occurred in TargetWrapper::Malloc period: no enough for "
               "mallocing "
            << size << " bytes.";
   void* r = reinterpret_cast<void*>(reinterpret_cast<size_t>(p + offset) &
                                     (~(MALLOC_ALIGN - 1)));
   static_cast<void**>(r)[-1] = p;
+  static_cast<size_t*>(r)[-2] = mapped;
   return r;
 }
 void TargetWrapper<TARGET(kHost)>::Free(void* ptr) {
   if (ptr) {
-    free(static_cast<void**>(ptr)[-1]);
+    size_t mapped = static_cast<size_t*>(ptr)[-2];
+    if (mapped > 0) {
+      host::UnmapPages(static_cast<void**>(ptr)[-1], mapped);
+    } else {
+      free(static_cast<void**>(ptr)[-1]);
+    }
   }
 }
 void TargetWrapper<TARGET(kHost)>::MemcpySync(void* dst,
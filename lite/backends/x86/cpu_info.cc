@@ -157,6 +157,31 @@ bool MayIUse(const cpu_isa_t cpu_isa) {
   }
   return false;
 }
+#elif defined(__GNUC__) && !defined(_WIN32)
+// Without xbyak fall back to the compiler's cpuid cache, so the runtime ISA
+// dispatch still works. Less common extensions are reported as unavailable.
+bool MayIUse(const cpu_isa_t cpu_isa) {
+  __builtin_cpu_init();
+  switch (cpu_isa) {
+    case sse42:
+      return __builtin_cpu_supports("sse4.2");
+    case avx:
+      return __builtin_cpu_supports("avx");
+    case avx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case avx512f:
+      return __builtin_cpu_supports("avx512f");
+    case avx512_core:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512bw") &&
+             __builtin_cpu_supports("avx512vl") &&
+             __builtin_cpu_supports("avx512dq");
+    case isa_any:
+      return true;
+    default:
+      return false;
+  }
+}
 #else
 bool MayIUse(const cpu_isa_t cpu_isa) {
   if (cpu_isa == isa_any) {
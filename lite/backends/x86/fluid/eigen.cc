@@ -0,0 +1,128 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/fluid/eigen.h"
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <functional>
+#include <mutex>   // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/macros.h"
+
+namespace paddle {
+namespace lite {
+namespace fluid {
+
+namespace {
+
+// The threads of the Eigen devices. The workers block while no expression is
+// evaluated, instead of spinning, so they do not take the cores from the
+// OpenMP threads of the math library.
+class EigenThreadPool : public Eigen::ThreadPoolInterface {
+ public:
+  explicit EigenThreadPool(int num_threads) {
+    for (int i = 0; i < num_threads; ++i) {
+      workers_.emplace_back([this, i] { Work(i); });
+    }
+  }
+
+  ~EigenThreadPool() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Schedule(std::function<void()> fn) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(fn));
+    }
+    cv_.notify_one();
+  }
+
+  int NumThreads() const override { return static_cast<int>(workers_.size()); }
+
+  int CurrentThreadId() const override { return thread_id_; }
+
+ private:
+  void Work(int id) {
+    thread_id_ = id;
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty()) return;
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  static LITE_THREAD_LOCAL int thread_id_;
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_{false};
+};
+
+LITE_THREAD_LOCAL int EigenThreadPool::thread_id_ = -1;
+
+// Runs every task on the calling thread, for the single threaded devices.
+class InlineThreadPool : public Eigen::ThreadPoolInterface {
+ public:
+  void Schedule(std::function<void()> fn) override { fn(); }
+  int NumThreads() const override { return 1; }
+  int CurrentThreadId() const override { return -1; }
+};
+
+}  // namespace
+
+template <>
+EigenDeviceType<lite::TargetType::kX86>
+GetEigenDevice<lite::TargetType::kX86>() {
+  static InlineThreadPool inline_pool;
+  // GetMaxThreads is 1 inside an OpenMP parallel region.
+  const int num_threads = static_cast<int>(x86::GetMaxThreads());
+  if (num_threads <= 1) {
+    return Eigen::ThreadPoolDevice(&inline_pool, 1);
+  }
+  // The pool is created once with a thread per core, or with as many threads
+  // as the math library is first set to if that is more. The devices use as
+  // many of them as the math library is set to.
+  static EigenThreadPool pool((std::max)(
+      static_cast<int>(std::thread::hardware_concurrency()), num_threads));
+  // The workers evaluate nested expressions inline, waiting for the pool
+  // from one of its threads could deadlock.
+  if (pool.CurrentThreadId() >= 0) {
+    return Eigen::ThreadPoolDevice(&inline_pool, 1);
+  }
+  return Eigen::ThreadPoolDevice(&pool,
+                                 (std::min)(num_threads, pool.NumThreads()));
+}
+
+}  // namespace fluid
+}  // namespace lite
+}  // namespace paddle
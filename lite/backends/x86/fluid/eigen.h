@@ -140,12 +140,22 @@ struct EigenDevice;
 
 template <>
 struct EigenDevice<lite::TargetType::kX86> {
-  using Type = ::Eigen::DefaultDevice;
+  using Type = ::Eigen::ThreadPoolDevice;
 };
 
 template <lite::TargetType Target>
 using EigenDeviceType = typename EigenDevice<Target>::Type;
 
+// Returns the device to evaluate the Eigen expressions of the target with.
+// On x86 the expressions are sharded over as many threads as the math
+// library uses, and Eigen evaluates the ones too small to pay off inline.
+template <lite::TargetType Target>
+EigenDeviceType<Target> GetEigenDevice();
+
+template <>
+EigenDeviceType<lite::TargetType::kX86>
+GetEigenDevice<lite::TargetType::kX86>();
+
 }  // namespace fluid
 }  // namespace lite
 }  // namespace paddle
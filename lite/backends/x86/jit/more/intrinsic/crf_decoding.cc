@@ -13,6 +13,7 @@
  * limitations under the License. */
 
 #include "lite/backends/x86/jit/more/intrinsic/crf_decoding.h"
+#include <immintrin.h>
 #include <limits>
 #include "lite/backends/x86/cpu_info.h"
 #include "lite/backends/x86/jit/registry.h"
@@ -25,6 +26,9 @@ namespace intrinsic {
 // Note: intrinsic code is not runtime build.
 // For example, if you build code on AVX, and run on AVX512 it can only use AVX
 
+// Built for AVX in LITE_WITH_X86_DISPATCH builds, see
+// math/isa_dispatch.h. CanBeUsed() stays baseline code.
+#include "lite/backends/x86/math/avx_target_begin.h"
 void CRFDecoding(const int seq_len,
                  const float* x,
                  const float* w,
@@ -163,6 +167,8 @@ void CRFDecoding(const int seq_len,
   }
 }
 
+#include "lite/backends/x86/math/avx_target_end.h"
+
 bool CRFDecodingKernel::CanBeUsed(const int& d) const {
 #ifdef __AVX512F__
   constexpr int block = ZMM_FLOAT_BLOCK;
@@ -13,6 +13,7 @@
  * limitations under the License. */
 
 #include "lite/backends/x86/jit/more/intrinsic/layer_norm.h"
+#include <immintrin.h>
 #include <limits>
 #include "lite/backends/x86/jit/registry.h"
 
@@ -22,6 +23,9 @@ namespace jit {
 namespace more {
 namespace intrinsic {
 
+// Built for AVX in LITE_WITH_X86_DISPATCH builds, see
+// math/isa_dispatch.h. CanBeUsed() stays baseline code.
+#include "lite/backends/x86/math/avx_target_begin.h"
 void LayerNorm(float* x,
                float* out,
                float* mean,
@@ -166,6 +170,8 @@ void LayerNorm(float* x,
   }
 }
 
+#include "lite/backends/x86/math/avx_target_end.h"
+
 bool LayerNormKernel::CanBeUsed(const int& d) const {
   return x86::MayIUse(x86::avx) && d >= YMM_FLOAT_BLOCK;
 }
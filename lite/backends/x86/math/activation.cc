@@ -13,8 +13,9 @@
 // limitations under the License.
 
 #include "lite/backends/x86/math/activation.h"
+#include "lite/backends/x86/math/isa_dispatch.h"
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
 #include <immintrin.h>
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #else
@@ -29,10 +30,12 @@ namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
 
 template <>
 void mish(const float* din, float* dout, int size, float threshold) {
-#ifdef __AVX__
+  LITE_X86_DISPATCH_AVX2(mish<float>, din, dout, size, threshold);
+#ifdef LITE_X86_AVX
   int cnt = size >> 3;
   int remain = size & 7;
 #else
@@ -40,7 +43,7 @@ void mish(const float* din, float* dout, int size, float threshold) {
   int remain = size & 3;
 #endif
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   __m256 vthreshold = _mm256_set1_ps(threshold);
   __m256 vone = _mm256_set1_ps(1.f);
   __m256 vtwo = _mm256_set1_ps(2.f);
@@ -141,7 +144,9 @@ void hard_swish(const float* din,
                 float scale,
                 float offset,
                 float threshold) {
-#ifdef __AVX__
+  LITE_X86_DISPATCH_AVX2(
+      hard_swish<float>, din, dout, size, scale, offset, threshold);
+#ifdef LITE_X86_AVX
   int cnt = size >> 5;
   int remain = size & 31;
   __m256 vec_zero = _mm256_set1_ps(0.f);
@@ -159,7 +164,7 @@ void hard_swish(const float* din,
   int cnt_4 = remain >> 2;
   int rem_4 = remain & 3;
   for (int i = 0; i < cnt; i++) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     __m256 vin0 = _mm256_loadu_ps(din);
     __m256 vin1 = _mm256_loadu_ps(din + 8);
     __m256 vin2 = _mm256_loadu_ps(din + 16);
@@ -229,6 +234,7 @@ void hard_swish(const float* din,
   }
 }
 
+LITE_X86_ISA_NAMESPACE_END
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -30,6 +30,22 @@ void hard_swish(const T* din,
                 float offset,
                 float threshold);
 
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copies of the kernels above, see isa_dispatch.h.
+namespace avx2 {
+template <typename T>
+void mish(const T* din, T* dout, int size, float threshold);
+
+template <typename T>
+void hard_swish(const T* din,
+                T* dout,
+                int size,
+                float scale,
+                float offset,
+                float threshold);
+}  // namespace avx2
+#endif
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
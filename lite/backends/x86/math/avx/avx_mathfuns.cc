@@ -41,9 +41,14 @@
 
   (this is the zlib license)
 */
+#include <immintrin.h>
+#include "lite/backends/x86/cpu_info.h"
+
+// AVX2 code, see isa_dispatch.h.
+#include "lite/backends/x86/math/avx2_target_begin.h"
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
 namespace paddle {
 namespace lite {
 namespace x86 {
@@ -99,7 +104,7 @@ _PS256_CONST(cephes_log_p8, +3.3333331174E-1);
 _PS256_CONST(cephes_log_q1, -2.12194440e-4);
 _PS256_CONST(cephes_log_q2, 0.693359375);
 
-#ifndef __AVX2__
+#ifndef LITE_X86_AVX2
 
 typedef union imm_xmm_union {
   v8si imm;
@@ -168,7 +173,7 @@ AVX2_INTOP_USING_SSE2(add_epi32)
 #define avx2_mm256_cmpeq_epi32 _mm256_cmpeq_epi32
 #define avx2_mm256_sub_epi32 _mm256_sub_epi32
 #define avx2_mm256_add_epi32 _mm256_add_epi32
-#endif /* __AVX2__ */
+#endif /* LITE_X86_AVX2 */
 
 /* natural logarithm computed for 8 simultaneous float
    return NaN for x <= 0
@@ -349,7 +354,7 @@ v8sf sin256_ps(v8sf x) {  // any x
   v8sf xmm1, xmm2 = _mm256_setzero_ps(), xmm3, sign_bit, y;
   v8si imm0, imm2;
 
-#ifndef __AVX2__
+#ifndef LITE_X86_AVX2
   v4si imm0_1, imm0_2;
   v4si imm2_1, imm2_2;
 #endif
@@ -369,7 +374,7 @@ v8sf sin256_ps(v8sf x) {  // any x
   If we don't have AVX, let's perform them using SSE2 directives
 */
 
-#ifdef __AVX2__
+#ifdef LITE_X86_AVX2
   /* store the integer part of y in mm0 */
   imm2 = _mm256_cvttps_epi32(y);
   /* j=(j+1) & (~1) (see the cephes sources) */
@@ -476,7 +481,7 @@ v8sf cos256_ps(v8sf x) {  // any x
   v8sf xmm1, xmm2 = _mm256_setzero_ps(), xmm3, y;
   v8si imm0, imm2;
 
-#ifndef __AVX2__
+#ifndef LITE_X86_AVX2
   v4si imm0_1, imm0_2;
   v4si imm2_1, imm2_2;
 #endif
@@ -487,7 +492,7 @@ v8sf cos256_ps(v8sf x) {  // any x
   /* scale by 4/Pi */
   y = _mm256_mul_ps(x, *(v8sf *)_ps256_cephes_FOPI);  // NOLINT
 
-#ifdef __AVX2__
+#ifdef LITE_X86_AVX2
   /* store the integer part of y in mm0 */
   imm2 = _mm256_cvttps_epi32(y);
   /* j=(j+1) & (~1) (see the cephes sources) */
@@ -594,7 +599,7 @@ void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
   v8sf xmm1, xmm2, xmm3 = _mm256_setzero_ps(), sign_bit_sin, y;
   v8si imm0, imm2, imm4;
 
-#ifndef __AVX2__
+#ifndef LITE_X86_AVX2
   v4si imm0_1, imm0_2;
   v4si imm2_1, imm2_2;
   v4si imm4_1, imm4_2;
@@ -610,7 +615,7 @@ void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
   /* scale by 4/Pi */
   y = _mm256_mul_ps(x, *(v8sf *)_ps256_cephes_FOPI);  // NOLINT
 
-#ifdef __AVX2__
+#ifdef LITE_X86_AVX2
   /* store the integer part of y in imm2 */
   imm2 = _mm256_cvttps_epi32(y);
 
@@ -677,7 +682,7 @@ void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
   x = _mm256_add_ps(x, xmm2);
   x = _mm256_add_ps(x, xmm3);
 
-#ifdef __AVX2__
+#ifdef LITE_X86_AVX2
   imm4 = avx2_mm256_sub_epi32(imm4, *(v8si *)_pi32_256_2);     // NOLINT
   imm4 = avx2_mm256_andnot_si256(imm4, *(v8si *)_pi32_256_4);  // NOLINT
   imm4 = avx2_mm256_slli_epi32(imm4, 29);
@@ -742,3 +747,5 @@ void sincos256_ps(v8sf x, v8sf *s, v8sf *c) {
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
+
+#include "lite/backends/x86/math/avx2_target_end.h"
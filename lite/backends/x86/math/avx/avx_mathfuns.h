@@ -13,7 +13,8 @@
 // limitations under the License.
 #pragma once
 #include "lite/backends/x86/cpu_info.h"
-#ifdef __AVX__
+#include "lite/backends/x86/math/isa_dispatch.h"
+#ifdef LITE_X86_AVX
 namespace paddle {
 namespace lite {
 namespace x86 {
@@ -30,7 +31,7 @@ v8sf cos256_ps(v8sf x);
 void sincos256_ps(v8sf x, v8sf *s, v8sf *c);
 
 // FMA support
-#ifndef __AVX2__
+#ifndef LITE_X86_AVX2
 #define _mm256_fmadd_ps(a, b, c) _mm256_add_ps(c, _mm256_mul_ps(a, b))
 #define _mm256_permutevar8x32_ps(a, b)                  \
   _mm256_setr_ps(*((float *)(&a) + *((int *)(&b))),     \
@@ -13,7 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/avx/conv_depthwise_pack4.h"
+#include <immintrin.h>
 #include <vector>
+
+// AVX2 code, see isa_dispatch.h.
+#include "lite/backends/x86/math/avx2_target_begin.h"
 #include "lite/backends/x86/math/avx/conv_utils.h"
 
 namespace paddle {
@@ -114,3 +118,5 @@ void conv_depthwise_m128(lite::Tensor* input,
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
+
+#include "lite/backends/x86/math/avx2_target_end.h"
@@ -12,8 +12,15 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
-#include "lite/backends/x86/math/avx/conv_utils.h"
+#include <immintrin.h>
 #include <algorithm>
+#include <vector>
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+
+// AVX2 code, see isa_dispatch.h.
+#include "lite/backends/x86/math/avx2_target_begin.h"
+#include "lite/backends/x86/math/avx/conv_utils.h"
 
 namespace paddle {
 namespace lite {
@@ -156,14 +163,14 @@ void pack8_m256(lite::Tensor* input,
       const float* r6 = (input_ptr + kernel_size * 6);
       const float* r7 = (input_ptr + kernel_size * 7);
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       int loop_num = kernel_size >> 3;
       int remain = kernel_size & 7;
 #else
       int remain = kernel_size;
 #endif
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       for (; loop_num > 0; loop_num--) {
         __m256 _row0 = _mm256_loadu_ps(r0);
         __m256 _row1 = _mm256_loadu_ps(r1);
@@ -246,14 +253,14 @@ void pack4_m128(lite::Tensor* input,
       const float* r2 = (input_ptr + kernel_size * 2);
       const float* r3 = (input_ptr + kernel_size * 3);
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       int loop_num = kernel_size >> 2;
       int remain = kernel_size & 3;
 #else
       int remain = kernel_size;
 #endif
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       for (; loop_num > 0; loop_num--) {
         __m128 _row0 = _mm_loadu_ps(r0);
         __m128 _row1 = _mm_loadu_ps(r1);
@@ -313,14 +320,14 @@ void unpack8_m256(lite::Tensor* input, lite::Tensor* output) {
       float* outptr6 = (output_ptr + kernel_size * 6);
       float* outptr7 = (output_ptr + kernel_size * 7);
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       int loop_num = kernel_size >> 3;
       int remain = kernel_size & 7;
 #else
       int remain = kernel_size;
 #endif
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       for (; loop_num > 0; loop_num--) {
         __m256 _row0 = _mm256_loadu_ps(r0);
         __m256 _row1 = _mm256_loadu_ps(r0 + 8);
@@ -392,14 +399,14 @@ void unpack4_m128(lite::Tensor* input, lite::Tensor* output) {
       float* outptr2 = (output_ptr + kernel_size * 2);
       float* outptr3 = (output_ptr + kernel_size * 3);
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       int loop_num = kernel_size >> 2;
       int remain = kernel_size & 3;
 #else
       int remain = kernel_size;
 #endif
 
-#if __AVX__
+#ifdef LITE_X86_AVX
       for (; loop_num > 0; loop_num--) {
         __m128 _row0 = _mm_loadu_ps(r0);
         __m128 _row1 = _mm_loadu_ps(r0 + 4);
@@ -1045,295 +1052,9 @@ float activation1_float(float input,
   }
   return 0.f;
 }
-
-/**
- * \brief inline funcs used in im2col
- * @param a
- * @param b
- * @return
- */
-inline bool is_a_ge_zero_and_a_lt_b(int a, int b) {
-  return static_cast<unsigned>(a) < static_cast<unsigned>(b);
-}
-
-/**
- * \brief normal im2col function for gemm conv
- * @tparam dtype
- * @param data_im
- * @param channels
- * @param height
- * @param width
- * @param kernel_size
- * @param pad
- * @param stride
- * @param data_col
- */
-template <typename Dtype>
-void im2col_common(const Dtype* data_im,
-                   int channels,
-                   int height,
-                   int width,
-                   int kernel_h,
-                   int kernel_w,
-                   int pad_top,
-                   int pad_bottom,
-                   int pad_left,
-                   int pad_right,
-                   int stride_h,
-                   int stride_w,
-                   int dilation_h,
-                   int dilation_w,
-                   Dtype* data_col) {
-  const int output_h =
-      (height + pad_top + pad_bottom - (dilation_h * (kernel_h - 1) + 1)) /
-          stride_h +
-      1;
-  const int output_w =
-      (width + pad_left + pad_right - (dilation_w * (kernel_w - 1) + 1)) /
-          stride_w +
-      1;
-  const int channel_size = height * width;
-  for (int channel = channels; channel--; data_im += channel_size) {
-    for (int kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
-      for (int kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
-        int input_row = -pad_top + kernel_row * dilation_h;
-        for (int output_rows = output_h; output_rows; output_rows--) {
-          if (!is_a_ge_zero_and_a_lt_b(input_row, height)) {
-            for (int output_cols = output_w; output_cols; output_cols--) {
-              *(data_col++) = 0;
-            }
-          } else {
-            int input_col = -pad_left + kernel_col * dilation_w;
-            for (int output_col = output_w; output_col; output_col--) {
-              if (is_a_ge_zero_and_a_lt_b(input_col, width)) {
-                *(data_col++) = data_im[input_row * width + input_col];
-              } else {
-                *(data_col++) = 0;
-              }
-              input_col += stride_w;
-            }
-          }
-          input_row += stride_h;
-        }
-      }
-    }
-  }
-}
-
-template <>
-void im2col_s1<float>(const float* data_im,
-                      int channels,
-                      int height,
-                      int width,
-                      int kernel_h,
-                      int kernel_w,
-                      int pad_top,
-                      int pad_bottom,
-                      int pad_left,
-                      int pad_right,
-                      int dilation_h,
-                      int dilation_w,
-                      float* data_col) {
-  const int output_h =
-      (height + pad_top + pad_bottom - (dilation_h * (kernel_h - 1) + 1)) + 1;
-  const int output_w =
-      (width + pad_left + pad_right - (dilation_w * (kernel_w - 1) + 1)) + 1;
-  const int in_channel_size = height * width;
-  const int out_channel_size = output_h * output_w;
-  const int output_plane_size = output_h * output_w * kernel_h * kernel_w;
-  memset(data_col, 0, output_plane_size * channels * sizeof(float));
-#pragma omp parallel for
-  for (int c = 0; c < channels; c++) {
-    int data_im_z = c * in_channel_size;
-    int data_col_z1 = c * output_plane_size;
-    for (int ky = 0, h_offset = 0; ky < kernel_h;
-         ky++, h_offset += dilation_h) {
-      int data_col_z2 = ky * out_channel_size * kernel_w;
-      for (int kx = 0, w_offset = 0; kx < kernel_w;
-           kx++, w_offset += dilation_w) {
-        int data_col_z3 = kx * out_channel_size;
-        int data_col_z = data_col_z1 + data_col_z2 + data_col_z3;
-        int oh_begin = std::max(((pad_top - h_offset)), 0);
-        int oh_end = std::min(((height + pad_bottom - h_offset)), output_h);
-        oh_end = std::max(oh_begin, oh_end);
-        int ow_begin = std::max(((pad_left - w_offset)), 0);
-        int ow_end = std::min(((width + pad_right - w_offset)), output_w);
-        ow_end = std::max(ow_begin, ow_end);
-        int ih = oh_begin - pad_top + h_offset;
-        for (int oh = oh_begin; oh < oh_end; ++oh, ++ih) {
-          int iw = ow_begin - pad_left + w_offset;
-          int ow = ow_begin;
-          int data_im_offset = data_im_z + ih * width;
-          int data_col_offset = data_col_z + oh * output_w;
-          const float* data_im_ptr = data_im + data_im_offset;
-          float* data_col_ptr = data_col + data_col_offset;
-#ifdef __AVX__
-          for (; ow + 7 < ow_end; ow += 8, iw += 8) {
-            __m256 vtmp = _mm256_loadu_ps(data_im_ptr + iw);
-            _mm256_storeu_ps(data_col_ptr + ow, vtmp);
-          }
-#else
-          for (; ow + 3 < ow_end; ow += 4, iw += 4) {
-            __m128 vtmp = _mm_loadu_ps(data_im_ptr + iw);
-            _mm_storeu_ps(data_col_ptr + ow, vtmp);
-          }
-#endif
-          for (; ow < ow_end; ++ow, ++iw) {
-            data_col[data_col_offset + ow] = data_im[data_im_offset + iw];
-          }
-        }
-      }
-    }
-  }
-}
-
-template <>
-void im2col_s2<float>(const float* data_im,
-                      int channels,
-                      int height,
-                      int width,
-                      int kernel_h,
-                      int kernel_w,
-                      int pad_top,
-                      int pad_bottom,
-                      int pad_left,
-                      int pad_right,
-                      int dilation_h,
-                      int dilation_w,
-                      float* data_col) {
-  const int output_h =
-      (height + pad_top + pad_bottom - (dilation_h * (kernel_h - 1) + 1)) / 2 +
-      1;
-  const int output_w =
-      (width + pad_left + pad_right - (dilation_w * (kernel_w - 1) + 1)) / 2 +
-      1;
-  const int in_channel_size = height * width;
-  const int output_plane_size = output_h * output_w * kernel_h * kernel_w;
-  memset(data_col, 0, output_plane_size * channels * sizeof(float));
-#pragma omp parallel for
-  for (int c = 0; c < channels; c++) {
-    int data_im_z = c * in_channel_size;
-    int data_col_z1 = c * output_plane_size;
-    for (int ky = 0, h_offset = 0; ky < kernel_h;
-         ky++, h_offset += dilation_h) {
-      int data_col_z2 = ky * output_h * output_w * kernel_w;
-      for (int kx = 0, w_offset = 0; kx < kernel_w;
-           kx++, w_offset += dilation_w) {
-        int data_col_z3 = kx * output_h * output_w;
-        int data_col_z = data_col_z1 + data_col_z2 + data_col_z3;
-        int oh_begin = std::max(((pad_top - h_offset + 1) / 2), 0);
-        int oh_end =
-            std::min(((height + pad_bottom - h_offset + 1) / 2), output_h);
-        oh_end = std::max(oh_begin, oh_end);
-        int ow_begin = std::max(((pad_left - w_offset + 1) / 2), 0);
-        int ow_end =
-            std::min(((width + pad_right - w_offset + 1) / 2), output_w);
-        ow_end = std::max(ow_begin, ow_end);
-        int ih = oh_begin * 2 - pad_top + h_offset;
-        for (int oh = oh_begin; oh < oh_end; ++oh, ih += 2) {
-          int iw = ow_begin * 2 - pad_left + w_offset;
-          int ow = ow_begin;
-          int data_im_offset = data_im_z + ih * width;
-          int data_col_offset = data_col_z + oh * output_w;
-          const float* data_im_ptr = data_im + data_im_offset;
-          float* data_col_ptr = data_col + data_col_offset;
-          for (; ow + 3 < ow_end; ow += 4, iw += 8) {
-            // a0a1a2a3
-            __m128 vtmp0 = _mm_loadu_ps(data_im_ptr + iw);
-            // a4a5a6a7
-            __m128 vtmp1 = _mm_loadu_ps(data_im_ptr + iw + 4);
-            // a0a2a4a6
-            _mm_storeu_ps(data_col_ptr + ow,
-                          _mm_shuffle_ps(vtmp0, vtmp1, 0x88));
-          }
-          for (; ow < ow_end; ++ow, iw += 2) {
-            data_col[data_col_offset + ow] = data_im[data_im_offset + iw];
-          }
-        }
-      }
-    }
-  }
-}
-
-/**
- * \brief normal im2col function for gemm conv
- * @param data_im
- * @param channels
- * @param height
- * @param width
- * @param kernel_size
- * @param pad
- * @param stride
- * @param data_col
- */
-template <>
-void im2col<float>(const float* data_im,
-                   int channels,
-                   int height,
-                   int width,
-                   int kernel_h,
-                   int kernel_w,
-                   int pad_top,
-                   int pad_bottom,
-                   int pad_left,
-                   int pad_right,
-                   int stride_h,
-                   int stride_w,
-                   int dilation_h,
-                   int dilation_w,
-                   float* data_col) {
-  bool pads_equal = ((pad_top == pad_bottom) && (pad_left == pad_right));
-  bool pads_all_equal = (pads_equal && pad_top == pad_left);
-  bool ks_equal = (stride_h == stride_w) && (kernel_h == kernel_w);
-  bool no_dilation = (dilation_h == 1) && (dilation_w == 1);
-  bool kspd = pads_all_equal && ks_equal && no_dilation;
-  if (kspd && stride_h == 1) {
-    im2col_s1<float>(data_im,
-                     channels,
-                     height,
-                     width,
-                     kernel_h,
-                     kernel_w,
-                     pad_top,
-                     pad_bottom,
-                     pad_left,
-                     pad_right,
-                     dilation_h,
-                     dilation_w,
-                     data_col);
-  } else if (kspd && stride_h == 2) {
-    im2col_s2<float>(data_im,
-                     channels,
-                     height,
-                     width,
-                     kernel_h,
-                     kernel_w,
-                     pad_top,
-                     pad_bottom,
-                     pad_left,
-                     pad_right,
-                     dilation_h,
-                     dilation_w,
-                     data_col);
-  } else {
-    im2col_common<float>(data_im,
-                         channels,
-                         height,
-                         width,
-                         kernel_h,
-                         kernel_w,
-                         pad_top,
-                         pad_bottom,
-                         pad_left,
-                         pad_right,
-                         stride_h,
-                         stride_w,
-                         dilation_h,
-                         dilation_w,
-                         data_col);
-  }
-}
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
+
+#include "lite/backends/x86/math/avx2_target_end.h"
@@ -16,11 +16,22 @@
 #include <immintrin.h>
 #include <stdio.h>
 #include <cmath>
+#include "lite/backends/x86/math/isa_dispatch.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
+
+// x * y + z, fused in the AVX2 copy.
+static inline __m128 mul_add_ps(__m128 x, __m128 y, __m128 z) {
+#ifdef LITE_X86_FMA
+  return _mm_fmadd_ps(x, y, z);
+#else
+  return _mm_add_ps(_mm_mul_ps(x, y), z);
+#endif
+}
 
 void group_norm(const float* in,
                 float* out,
@@ -34,6 +45,19 @@ void group_norm(const float* in,
                 const float* bias,
                 float* saved_mean,
                 float* saved_variance) {
+  LITE_X86_DISPATCH_AVX2(group_norm,
+                         in,
+                         out,
+                         n,
+                         c,
+                         height,
+                         width,
+                         epsilon,
+                         groups,
+                         scale,
+                         bias,
+                         saved_mean,
+                         saved_variance);
   int nb = n;
   int spatial_size = height * width;
   int group_size = (c - 1) / groups +
@@ -81,10 +105,10 @@ void group_norm(const float* in,
             sum2 = _mm_add_ps(sum2, in2);
             sum3 = _mm_add_ps(sum3, in3);
             // add x * x
-            square_sum0 = _mm_fmadd_ps(in0, in0, square_sum0);
-            square_sum1 = _mm_fmadd_ps(in1, in1, square_sum1);
-            square_sum2 = _mm_fmadd_ps(in2, in2, square_sum2);
-            square_sum3 = _mm_fmadd_ps(in3, in3, square_sum3);
+            square_sum0 = mul_add_ps(in0, in0, square_sum0);
+            square_sum1 = mul_add_ps(in1, in1, square_sum1);
+            square_sum2 = mul_add_ps(in2, in2, square_sum2);
+            square_sum3 = mul_add_ps(in3, in3, square_sum3);
 
             in_p += 16;
           }
@@ -93,14 +117,14 @@ void group_norm(const float* in,
             in1 = _mm_loadu_ps(in_p + 4);
             sum0 = _mm_add_ps(sum0, in0);
             sum1 = _mm_add_ps(sum1, in1);
-            square_sum0 = _mm_fmadd_ps(in0, in0, square_sum0);
-            square_sum1 = _mm_fmadd_ps(in1, in1, square_sum1);
+            square_sum0 = mul_add_ps(in0, in0, square_sum0);
+            square_sum1 = mul_add_ps(in1, in1, square_sum1);
             in_p += 8;
           }
           for (; w > 3; w -= 4) {
             in0 = _mm_loadu_ps(in_p);
             sum0 = _mm_add_ps(sum0, in0);
-            square_sum0 = _mm_fmadd_ps(in0, in0, square_sum0);
+            square_sum0 = mul_add_ps(in0, in0, square_sum0);
             in_p += 4;
           }
           float sum = 0.f;
@@ -163,8 +187,8 @@ void group_norm(const float* in,
           in1 = _mm_loadu_ps(in_p + 4);
           submean0 = _mm_sub_ps(in0, vmean);
           submean1 = _mm_sub_ps(in1, vmean);
-          out0 = _mm_fmadd_ps(submean0, vsstd, vbias);
-          out1 = _mm_fmadd_ps(submean1, vsstd, vbias);
+          out0 = mul_add_ps(submean0, vsstd, vbias);
+          out1 = mul_add_ps(submean1, vsstd, vbias);
 
           _mm_storeu_ps(out_p, out0);
           _mm_storeu_ps(out_p + 4, out1);
@@ -175,7 +199,7 @@ void group_norm(const float* in,
         for (; j > 3; j -= 4) {
           in0 = _mm_loadu_ps(in_p);
           submean0 = _mm_sub_ps(in0, vmean);
-          out0 = _mm_fmadd_ps(submean0, vsstd, vbias);
+          out0 = mul_add_ps(submean0, vsstd, vbias);
 
           _mm_storeu_ps(out_p, out0);
 
@@ -191,6 +215,7 @@ void group_norm(const float* in,
     }
   }
 }
+LITE_X86_ISA_NAMESPACE_END
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -31,6 +31,23 @@ void instance_norm(const float* in,
                    float* saved_mean,
                    float* saved_variance);
 
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copy of the kernel above, see isa_dispatch.h.
+namespace avx2 {
+void instance_norm(const float* in,
+                   float* out,
+                   const int n,
+                   const int c,
+                   const int height,
+                   const int width,
+                   const float epsilon,
+                   const float* scale,
+                   const float* bias,
+                   float* saved_mean,
+                   float* saved_variance);
+}  // namespace avx2
+#endif
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -0,0 +1,26 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// AVX2 copy of avx/group_norm.cc, see isa_dispatch.h. The shared headers are
+// included before the AVX2 target region.
+#define LITE_X86_ISA avx2
+#include <immintrin.h>
+#include <stdio.h>
+#include <cmath>
+#include "lite/backends/x86/math/avx/group_norm.h"
+#include "lite/backends/x86/math/isa_dispatch.h"
+
+#include "lite/backends/x86/math/avx2_target_begin.h"
+#include "lite/backends/x86/math/avx/group_norm.cc"
+#include "lite/backends/x86/math/avx2_target_end.h"
@@ -0,0 +1,31 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Opens an AVX2/FMA target region for the code that follows, up to
+// avx2_target_end.h. See isa_dispatch.h. Include the shared headers before
+// this one.
+// NOLINT(build/header_guard)
+#include "lite/backends/x86/math/isa_dispatch.h"
+#if defined(LITE_WITH_X86_DISPATCH) && defined(__GNUC__) && \
+    !defined(__clang__) && !defined(__AVX2__)
+#define LITE_X86_AVX2_TARGET_REGION
+#pragma GCC push_options
+#pragma GCC target("avx,avx2,fma,f16c")
+#ifndef LITE_X86_AVX
+#define LITE_X86_AVX 1
+#define LITE_X86_AVX2_TARGET_UNDEF_AVX
+#endif
+#define LITE_X86_AVX2 1
+#define LITE_X86_FMA 1
+#endif
@@ -0,0 +1,26 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Closes the region opened by avx2_target_begin.h.
+// NOLINT(build/header_guard)
+#ifdef LITE_X86_AVX2_TARGET_REGION
+#undef LITE_X86_AVX2_TARGET_REGION
+#ifdef LITE_X86_AVX2_TARGET_UNDEF_AVX
+#undef LITE_X86_AVX2_TARGET_UNDEF_AVX
+#undef LITE_X86_AVX
+#endif
+#undef LITE_X86_AVX2
+#undef LITE_X86_FMA
+#pragma GCC pop_options
+#endif
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "lite/backends/x86/math/calib.h"
+#include <immintrin.h>
 #include <string.h>
 #include <vector>
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
@@ -22,6 +23,12 @@ namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
+
+// Loads 16 int8 values from an unaligned address.
+static inline __m128i load_i8x16(const int8_t* ptr) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+}
+
 void fp32_to_int8(const float* din,
                   int8_t* dout,
                   const float* scale,
@@ -43,11 +50,11 @@ void fp32_to_int8(const float* din,
     float inv_scale = 1.f / scale[j % axis_size];
     __m128 vzero = _mm_set1_ps(-127.f);
     __m128 vscale = _mm_set1_ps(inv_scale);
-    __m256 vzero_l = _mm256_set1_ps(-127.f);
-    __m256 vscale_l = _mm256_set1_ps(inv_scale);
     const float* din_c = din + j * inner_size;
     int8_t* dout_c = dout + j * inner_size;
 #ifdef __AVX__
+    __m256 vzero_l = _mm256_set1_ps(-127.f);
+    __m256 vscale_l = _mm256_set1_ps(inv_scale);
     for (int i = 0; i < cnt; i++) {
       __m256 vin0 = _mm256_loadu_ps(din_c);
       __m256 vin1 = _mm256_loadu_ps(din_c + 8);
@@ -98,10 +105,10 @@ void fp32_to_int8(const float* din,
       __m128 vout1 = _mm_mul_ps(vin1, vscale);
       __m128 vout2 = _mm_mul_ps(vin2, vscale);
       __m128 vout3 = _mm_mul_ps(vin3, vscale);
-      vin0 = _mm_blendv_ps(vzero, vout0, _mm_cmp_ps(vout0, vzero, _CMP_GT_OS));
-      vin1 = _mm_blendv_ps(vzero, vout1, _mm_cmp_ps(vout1, vzero, _CMP_GT_OS));
-      vin2 = _mm_blendv_ps(vzero, vout2, _mm_cmp_ps(vout2, vzero, _CMP_GT_OS));
-      vin3 = _mm_blendv_ps(vzero, vout3, _mm_cmp_ps(vout3, vzero, _CMP_GT_OS));
+      vin0 = _mm_blendv_ps(vzero, vout0, _mm_cmpgt_ps(vout0, vzero));
+      vin1 = _mm_blendv_ps(vzero, vout1, _mm_cmpgt_ps(vout1, vzero));
+      vin2 = _mm_blendv_ps(vzero, vout2, _mm_cmpgt_ps(vout2, vzero));
+      vin3 = _mm_blendv_ps(vzero, vout3, _mm_cmpgt_ps(vout3, vzero));
       // fp32->int32
       __m128i vres0 = _mm_cvttps_epi32(vin0);
       __m128i vres1 = _mm_cvttps_epi32(vin1);
@@ -115,10 +122,10 @@ void fp32_to_int8(const float* din,
       __m128i vres1_8 = _mm_packs_epi16(vres1_16, vres1_16);
       __m128i vres2_8 = _mm_packs_epi16(vres2_16, vres2_16);
       __m128i vres3_8 = _mm_packs_epi16(vres3_16, vres3_16);
-      *(reinterpret_cast<int*>(dout)) = _mm_extract_epi32(vres0_8, 0);
-      *(reinterpret_cast<int*>(dout + 4)) = _mm_extract_epi32(vres1_8, 0);
-      *(reinterpret_cast<int*>(dout + 8)) = _mm_extract_epi32(vres2_8, 0);
-      *(reinterpret_cast<int*>(dout + 12)) = _mm_extract_epi32(vres3_8, 0);
+      *(reinterpret_cast<int*>(dout_c)) = _mm_extract_epi32(vres0_8, 0);
+      *(reinterpret_cast<int*>(dout_c + 4)) = _mm_extract_epi32(vres1_8, 0);
+      *(reinterpret_cast<int*>(dout_c + 8)) = _mm_extract_epi32(vres2_8, 0);
+      *(reinterpret_cast<int*>(dout_c + 12)) = _mm_extract_epi32(vres3_8, 0);
       din_c += 16;
       dout_c += 16;
     }
@@ -126,7 +133,7 @@ void fp32_to_int8(const float* din,
     for (int i = 0; i < rem_cnt; i++) {
       __m128 vin0 = _mm_loadu_ps(din_c);
       __m128 vout0 = _mm_mul_ps(vin0, vscale);
-      vin0 = _mm_blendv_ps(vzero, vout0, _mm_cmp_ps(vout0, vzero, _CMP_GT_OS));
+      vin0 = _mm_blendv_ps(vzero, vout0, _mm_cmpgt_ps(vout0, vzero));
       // fp32->int32
       __m128i vres0 = _mm_cvttps_epi32(vin0);
       __m128i vres0_16 = _mm_packs_epi32(vres0, vres0);
@@ -164,14 +171,14 @@ void int8_to_fp32(const int8_t* in,
     const int8_t* din_c = in + n * inner_size;
     float* dout_c = out + n * inner_size;
     __m128 vscale = _mm_set1_ps(in_scale);
-    __m256 vscale_l = _mm256_set1_ps(in_scale);
 
 #ifdef __AVX__
+    __m256 vscale_l = _mm256_set1_ps(in_scale);
     for (int i = 0; i < cnt; i++) {
-      __m128i vin0 = _mm_loadu_epi8(din_c);
-      __m128i vin1 = _mm_loadu_epi8(din_c + 8);
-      __m128i vin2 = _mm_loadu_epi8(din_c + 16);
-      __m128i vin3 = _mm_loadu_epi8(din_c + 24);
+      __m128i vin0 = load_i8x16(din_c);
+      __m128i vin1 = load_i8x16(din_c + 8);
+      __m128i vin2 = load_i8x16(din_c + 16);
+      __m128i vin3 = load_i8x16(din_c + 24);
       // 8bits x 16 -> 32bits x 8
       __m256i v00 = _mm256_cvtepi8_epi32(vin0);
       __m256i v01 = _mm256_cvtepi8_epi32(vin1);
@@ -191,10 +198,10 @@ void int8_to_fp32(const int8_t* in,
     }
 #else
     for (int i = 0; i < cnt; i++) {
-      __m128i vin0 = _mm_loadu_epi8(din_c);
-      __m128i vin1 = _mm_loadu_epi8(din_c + 4);
-      __m128i vin2 = _mm_loadu_epi8(din_c + 8);
-      __m128i vin3 = _mm_loadu_epi8(din_c + 12);
+      __m128i vin0 = load_i8x16(din_c);
+      __m128i vin1 = load_i8x16(din_c + 4);
+      __m128i vin2 = load_i8x16(din_c + 8);
+      __m128i vin3 = load_i8x16(din_c + 12);
       // 8bits x 16 -> 32bits x 4
       __m128i v00 = _mm_cvtepi8_epi32(vin0);
       __m128i v01 = _mm_cvtepi8_epi32(vin1);
@@ -202,9 +209,9 @@ void int8_to_fp32(const int8_t* in,
       __m128i v03 = _mm_cvtepi8_epi32(vin3);
       // int32 -> fp32
       __m128 vout0 = _mm_mul_ps(_mm_cvtepi32_ps(v00), vscale);
-      __m128 vout1 = _mm_mul_ps(mm_cvtepi32_ps(v01), vscale);
-      __m128 vout2 = _mm_mul_ps(mm_cvtepi32_ps(v02), vscale);
-      __m128 vout3 = _mm_mul_ps(mm_cvtepi32_ps(v03), vscale);
+      __m128 vout1 = _mm_mul_ps(_mm_cvtepi32_ps(v01), vscale);
+      __m128 vout2 = _mm_mul_ps(_mm_cvtepi32_ps(v02), vscale);
+      __m128 vout3 = _mm_mul_ps(_mm_cvtepi32_ps(v03), vscale);
       _mm_storeu_ps(dout_c, vout0);
       _mm_storeu_ps(dout_c + 4, vout1);
       _mm_storeu_ps(dout_c + 8, vout2);
@@ -214,7 +221,7 @@ void int8_to_fp32(const int8_t* in,
     }
 #endif
     for (int i = 0; i < rem_cnt; i++) {
-      __m128i vin0 = _mm_loadu_epi8(din_c);
+      __m128i vin0 = load_i8x16(din_c);
       // 8bits x 16 -> 32bits x 4
       __m128i v00 = _mm_cvtepi8_epi32(vin0);
       // int32 -> fp32
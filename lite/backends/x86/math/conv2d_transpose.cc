@@ -22,6 +22,9 @@ limitations under the License. */
 #ifdef __SSE__
 #include <xmmintrin.h>
 #endif
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
 
 namespace paddle {
 namespace lite {
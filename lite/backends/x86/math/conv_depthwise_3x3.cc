@@ -15,8 +15,10 @@ limitations under the License. */
 #include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/backends/x86/math/conv_depthwise_impl.h"
+#include "lite/backends/x86/math/isa_dispatch.h"
 #include "lite/core/memory.h"
-#ifdef __AVX__
+#include "lite/core/workspace.h"
+#ifdef LITE_X86_AVX
 #include <immintrin.h>
 #else
 #include <smmintrin.h>
@@ -27,6 +29,7 @@ namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
 #define Max(a, b) (a > b ? a : b)
 
 void conv_depthwise_3x3s2_p1_direct(
@@ -44,17 +47,33 @@ void conv_depthwise_3x3s2_p1_direct(
     int pad,
     bool flag_bias,
     const operators::ActivationParam act_param) {
-#ifdef __AVX__
+  LITE_X86_DISPATCH_AVX2(conv_depthwise_3x3s2_p1_direct,
+                         din,
+                         dout,
+                         num,
+                         ch_out,
+                         h_out,
+                         w_out,
+                         ch_in,
+                         h_in,
+                         w_in,
+                         weights,
+                         bias,
+                         pad,
+                         flag_bias,
+                         act_param);
+#ifdef LITE_X86_AVX
   bool right = false;  // for right result
 
   bool has_active = act_param.has_active;
   auto act_type = act_param.active_type;
 
-  float *zero_ptr = static_cast<float *>(
-      TargetMalloc(TARGET(kX86), Max(w_in * sizeof(float), 8 * sizeof(float))));
-  memset(zero_ptr, 0, Max(w_in * sizeof(float), 8 * sizeof(float)));
-  float *write_ptr =
-      static_cast<float *>(TargetMalloc(TARGET(kX86), w_out * sizeof(float)));
+  //! zero_ptr and write_ptr share one workspace block reused across runs
+  const size_t zero_size = Max(w_in * sizeof(float), 8 * sizeof(float));
+  float *zero_ptr = reinterpret_cast<float *>(
+      WorkSpace::Global_X86().Alloc(zero_size + w_out * sizeof(float)));
+  memset(zero_ptr, 0, zero_size);
+  float *write_ptr = zero_ptr + zero_size / sizeof(float);
 
   //! prepare for processing right result
   int rmask_o[4] = {0};
@@ -321,19 +340,17 @@ void conv_depthwise_3x3s2_p1_direct(
       }
     }
   }
-  TargetFree(TARGET(kX86), zero_ptr);
-  TargetFree(TARGET(kX86), write_ptr);
 #else
   bool right = false;  // for right result
 
   bool has_active = act_param.has_active;
   auto act_type = act_param.active_type;
 
-  float *zero_ptr = static_cast<float *>(TargetMalloc(
-      TARGET(kX86), Max(w_in * sizeof(float), 12 * sizeof(float))));
-  memset(zero_ptr, 0, Max(w_in * sizeof(float), 12 * sizeof(float)));
-  float *write_ptr =
-      static_cast<float *>(TargetMalloc(TARGET(kX86), w_out * sizeof(float)));
+  //! zero_ptr lives in a workspace block reused across runs
+  const size_t zero_size = Max(w_in * sizeof(float), 12 * sizeof(float));
+  float *zero_ptr =
+      reinterpret_cast<float *>(WorkSpace::Global_X86().Alloc(zero_size));
+  memset(zero_ptr, 0, zero_size);
 
   //! prepare for processing right result
   float rmasko[4] = {1.f, 1.f, 1.f, 1.f};
@@ -587,8 +604,6 @@ void conv_depthwise_3x3s2_p1_direct(
       }
     }
   }
-  TargetFree(TARGET(kX86), zero_ptr);
-  TargetFree(TARGET(kX86), write_ptr);
 #endif
 }
 void conv_depthwise_3x3s1_p1_direct(
@@ -606,17 +621,33 @@ void conv_depthwise_3x3s1_p1_direct(
     int pad,
     bool flag_bias,
     const operators::ActivationParam act_param) {
-#ifdef __AVX__
+  LITE_X86_DISPATCH_AVX2(conv_depthwise_3x3s1_p1_direct,
+                         din,
+                         dout,
+                         num,
+                         ch_out,
+                         h_out,
+                         w_out,
+                         ch_in,
+                         h_in,
+                         w_in,
+                         weights,
+                         bias,
+                         pad,
+                         flag_bias,
+                         act_param);
+#ifdef LITE_X86_AVX
   bool right = false;
 
   bool has_active = act_param.has_active;
   auto act_type = act_param.active_type;
 
-  float *zero_ptr = static_cast<float *>(
-      TargetMalloc(TARGET(kX86), Max(w_in * sizeof(float), 8)));
-  memset(zero_ptr, 0, Max(w_in * sizeof(float), 8));
-  float *write_ptr =
-      static_cast<float *>(TargetMalloc(TARGET(kX86), w_out * sizeof(float)));
+  //! zero_ptr and write_ptr share one workspace block reused across runs
+  const size_t zero_size = Max(w_in * sizeof(float), 8);
+  float *zero_ptr = reinterpret_cast<float *>(
+      WorkSpace::Global_X86().Alloc(zero_size + w_out * sizeof(float)));
+  memset(zero_ptr, 0, zero_size);
+  float *write_ptr = zero_ptr + zero_size / sizeof(float);
 
   //! prepare for processing right result
   int rmask_o[8] = {0, 0, 0, 0, 0, 0, 0, 0};
@@ -984,19 +1015,18 @@ void conv_depthwise_3x3s1_p1_direct(
     }
   }
 
-  TargetFree(TARGET(kX86), zero_ptr);
-  TargetFree(TARGET(kX86), write_ptr);
 #else
   bool right = false;  // for right result
 
   bool has_active = act_param.has_active;
   auto act_type = act_param.active_type;
 
-  float *zero_ptr = static_cast<float *>(
-      TargetMalloc(TARGET(kX86), Max(w_in * sizeof(float), 8)));
-  memset(zero_ptr, 0, Max(w_in * sizeof(float), 8));
-  float *write_ptr =
-      static_cast<float *>(TargetMalloc(TARGET(kX86), w_out * sizeof(float)));
+  //! zero_ptr and write_ptr share one workspace block reused across runs
+  const size_t zero_size = Max(w_in * sizeof(float), 8);
+  float *zero_ptr = reinterpret_cast<float *>(
+      WorkSpace::Global_X86().Alloc(zero_size + w_out * sizeof(float)));
+  memset(zero_ptr, 0, zero_size);
+  float *write_ptr = zero_ptr + zero_size / sizeof(float);
 
   //! prepare for processing right result
   float rmasko[4] = {1.f, 1.f, 1.f, 1.f};
@@ -1300,11 +1330,10 @@ void conv_depthwise_3x3s1_p1_direct(
       }
     }
   }
-  TargetFree(TARGET(kX86), zero_ptr);
-  TargetFree(TARGET(kX86), write_ptr);
 #endif
 }
 
+LITE_X86_ISA_NAMESPACE_END
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -14,11 +14,14 @@ limitations under the License. */
 
 #include <immintrin.h>
 #include <vector>
-#include "lite/backends/x86/math/avx/avx_mathfuns.h"
-#include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/backends/x86/math/conv_depthwise_impl.h"
 #include "lite/core/memory.h"
 
+// AVX2 code, see isa_dispatch.h.
+#include "lite/backends/x86/math/avx2_target_begin.h"
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
+#include "lite/backends/x86/math/avx/conv_utils.h"
+
 namespace paddle {
 namespace lite {
 namespace x86 {
@@ -763,3 +766,5 @@ void conv_depthwise_5x5s2(const float* din,
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
+
+#include "lite/backends/x86/math/avx2_target_end.h"
@@ -77,6 +77,41 @@ void conv_depthwise_5x5s2(const float* din,
                           int pad,
                           bool flag_bias,
                           const operators::ActivationParam act_param);
+
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copies of the 3x3 kernels, see isa_dispatch.h.
+namespace avx2 {
+void conv_depthwise_3x3s1_p1_direct(const float* din,
+                                    float* dout,
+                                    int num,
+                                    int ch_out,
+                                    int h_out,
+                                    int w_out,
+                                    int ch_in,
+                                    int h_in,
+                                    int w_in,
+                                    const float* weights,
+                                    const float* bias,
+                                    int pad,
+                                    bool flag_bias,
+                                    const operators::ActivationParam act_param);
+void conv_depthwise_3x3s2_p1_direct(const float* din,
+                                    float* dout,
+                                    int num,
+                                    int ch_out,
+                                    int h_out,
+                                    int w_out,
+                                    int ch_in,
+                                    int h_in,
+                                    int w_in,
+                                    const float* weights,
+                                    const float* bias,
+                                    int pad,
+                                    bool flag_bias,
+                                    const operators::ActivationParam act_param);
+}  // namespace avx2
+#endif
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
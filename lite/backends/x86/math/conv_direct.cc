@@ -16,9 +16,12 @@ limitations under the License. */
 #include <cstring>
 #include <iostream>
 #include <vector>
-#include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/core/context.h"
-#ifdef __AVX__
+
+// AVX2 code, see isa_dispatch.h.
+#include "lite/backends/x86/math/avx2_target_begin.h"
+#include "lite/backends/x86/math/avx/conv_utils.h"
+#ifdef LITE_X86_AVX
 #include <immintrin.h>
 #else
 #include <emmintrin.h>
@@ -50,7 +53,7 @@ void conv_direct_3x3s2(const float* i_data,
   constexpr int strideh = 2;
   constexpr int stridew = 2;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   constexpr int BLOCK = 8;
   // the sliding window is 5x7 and can obtain 2x3 results！ for AVX
   constexpr int window_h = 5;
@@ -143,7 +146,7 @@ void conv_direct_3x3s2(const float* i_data,
                 trans_out + oc_gi * ohw + oh_i * ow * BLOCK + ow_i * BLOCK;
 
 // Let's start the convolution of 3x3!
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 res = _mm256_loadu_ps(output_address);
 #else
             __m128 res = _mm_loadu_ps(output_address);
@@ -157,7 +160,7 @@ void conv_direct_3x3s2(const float* i_data,
                   continue;
                 const float* input_address =
                     input_start_address + new_ih_i * iw + new_iw_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
                 __m256 input = _mm256_set1_ps(*input_address);
                 __m256 w =
                     _mm256_loadu_ps(kernel_start_address + (i * 3 + j) * BLOCK);
@@ -169,7 +172,7 @@ void conv_direct_3x3s2(const float* i_data,
                 res = _mm_fmadd_ps(input, w, res);
 #endif
               }
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             _mm256_storeu_ps(output_address, res);
 #else
             _mm_storeu_ps(output_address, res);
@@ -201,7 +204,7 @@ void conv_direct_3x3s2(const float* i_data,
             float* output_address =
                 trans_out + oc_gi * ohw + oh_i * ow * BLOCK + ow_i * BLOCK;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 res = _mm256_loadu_ps(output_address);
 #else
             __m128 res = _mm_loadu_ps(output_address);
@@ -215,7 +218,7 @@ void conv_direct_3x3s2(const float* i_data,
                   continue;
                 const float* input_address =
                     input_start_address + new_ih_i * iw + new_iw_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
                 __m256 input = _mm256_set1_ps(*input_address);
                 __m256 w =
                     _mm256_loadu_ps(kernel_start_address + (i * 3 + j) * BLOCK);
@@ -227,7 +230,7 @@ void conv_direct_3x3s2(const float* i_data,
                 res = _mm_fmadd_ps(input, w, res);
 #endif
               }
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             _mm256_storeu_ps(output_address, res);
 #else
             _mm_storeu_ps(output_address, res);
@@ -261,7 +264,7 @@ void conv_direct_3x3s2(const float* i_data,
             float* output_address =
                 trans_out + oc_gi * ohw + oh_i * ow * BLOCK + ow_i * BLOCK;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 res = _mm256_loadu_ps(output_address);
 #else
             __m128 res = _mm_loadu_ps(output_address);
@@ -275,7 +278,7 @@ void conv_direct_3x3s2(const float* i_data,
                   continue;
                 const float* input_address =
                     input_start_address + new_ih_i * iw + new_iw_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
                 __m256 input = _mm256_set1_ps(*input_address);
                 __m256 w =
                     _mm256_loadu_ps(kernel_start_address + (i * 3 + j) * BLOCK);
@@ -287,7 +290,7 @@ void conv_direct_3x3s2(const float* i_data,
                 res = _mm_fmadd_ps(input, w, res);
 #endif
               }
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             _mm256_storeu_ps(output_address, res);
 #else
             _mm_storeu_ps(output_address, res);
@@ -320,7 +323,7 @@ void conv_direct_3x3s2(const float* i_data,
             float* output_address =
                 trans_out + oc_gi * ohw + oh_i * ow * BLOCK + ow_i * BLOCK;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 res = _mm256_loadu_ps(output_address);
 #else
             __m128 res = _mm_loadu_ps(output_address);
@@ -334,7 +337,7 @@ void conv_direct_3x3s2(const float* i_data,
                   continue;
                 const float* input_address =
                     input_start_address + new_ih_i * iw + new_iw_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
                 __m256 input = _mm256_set1_ps(*input_address);
                 __m256 w =
                     _mm256_loadu_ps(kernel_start_address + (i * 3 + j) * BLOCK);
@@ -346,7 +349,7 @@ void conv_direct_3x3s2(const float* i_data,
                 res = _mm_fmadd_ps(input, w, res);
 #endif
               }
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             _mm256_storeu_ps(output_address, res);
 #else
             _mm_storeu_ps(output_address, res);
@@ -376,7 +379,7 @@ void conv_direct_3x3s2(const float* i_data,
  * the general situation */
 
 // prefetch the 3x3 conv kernel outside the below two Nested loop !
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
 
         // Take out 9 weight values to the register
         __m256 w00 = _mm256_loadu_ps(kernel_start_address + 0 * BLOCK);
@@ -447,7 +450,7 @@ void conv_direct_3x3s2(const float* i_data,
                    output_address10 += 3 * BLOCK,
                    output_address11 += 3 * BLOCK,
                    output_address12 += 3 * BLOCK) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
 
             // Sliding windows can produce 2x3 results, I now create them
             __m256 res00 = _mm256_loadu_ps(output_address00);
@@ -732,7 +735,7 @@ void conv_direct_3x3s2(const float* i_data,
           float* from_address =
               trans_out + oc_gi * ohw + oh_i * owB + ow_i * BLOCK;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
           __m256 row0 = _mm256_loadu_ps(from_address + 0 * BLOCK);
           __m256 row1 = _mm256_loadu_ps(from_address + 1 * BLOCK);
           __m256 row2 = _mm256_loadu_ps(from_address + 2 * BLOCK);
@@ -753,7 +756,7 @@ void conv_direct_3x3s2(const float* i_data,
 #endif
 
           if (bias != nullptr) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             row0 = _mm256_add_ps(row0, _mm256_set1_ps(bias[oc_gi + 0]));
             row1 = _mm256_add_ps(row1, _mm256_set1_ps(bias[oc_gi + 1]));
             row2 = _mm256_add_ps(row2, _mm256_set1_ps(bias[oc_gi + 2]));
@@ -771,7 +774,7 @@ void conv_direct_3x3s2(const float* i_data,
           }
 
           if (active_type == lite_api::ActivationType::kRelu) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 vzero = _mm256_set1_ps(0.f);
             row0 = _mm256_max_ps(row0, vzero);
             row1 = _mm256_max_ps(row1, vzero);
@@ -788,7 +791,7 @@ void conv_direct_3x3s2(const float* i_data,
             row3 = _mm_max_ps(row3, _mm_set1_ps(0.f));
 #endif
           } else if (active_type == lite_api::ActivationType::kRelu6) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 vzero = _mm256_set1_ps(0.f);
             __m256 vsix = _mm256_set1_ps(act_param.Relu_clipped_coef);
             row0 = _mm256_max_ps(row0, vzero);
@@ -821,7 +824,7 @@ void conv_direct_3x3s2(const float* i_data,
             row3 = _mm_min_ps(row3, vsix);
 #endif
           } else if (active_type == lite_api::ActivationType::kLeakyRelu) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 vzero = _mm256_set1_ps(0.f);
             __m256 vscale = _mm256_set1_ps(act_param.Leaky_relu_alpha);
             row0 = _mm256_blendv_ps(_mm256_mul_ps(row0, vscale),
@@ -865,7 +868,7 @@ void conv_direct_3x3s2(const float* i_data,
                                  _mm_cmp_ps(row3, vzero, _CMP_GT_OS));
 #endif
           } else if (active_type == lite_api::ActivationType::kHardSwish) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 vzero = _mm256_set1_ps(0.f);
             __m256 voffset = _mm256_set1_ps(act_param.hard_swish_offset);
             __m256 vscale = _mm256_set1_ps(1.0 / act_param.hard_swish_scale);
@@ -935,7 +938,7 @@ void conv_direct_3x3s2(const float* i_data,
 
           float* dst_address =
               o_data + bs_i * ochw + oc_gi * ohw + oh_i * ow + ow_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
           _mm256_storeu_ps(dst_address + 0 * ohw, row0);
           _mm256_storeu_ps(dst_address + 1 * ohw, row1);
           _mm256_storeu_ps(dst_address + 2 * ohw, row2);
@@ -958,26 +961,26 @@ void conv_direct_3x3s2(const float* i_data,
               trans_out + oc_gi * ohw + oh_i * owB + ow_i * BLOCK;
           float* dst_address =
               o_data + bs_i * ochw + oc_gi * ohw + oh_i * ow + ow_i;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
           __m256 row = _mm256_loadu_ps(from_address);
 #else
           __m128 row = _mm_loadu_ps(from_address);
 #endif
           if (bias != nullptr) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             row = _mm256_add_ps(row, _mm256_loadu_ps(&bias[oc_gi]));
 #else
             row = _mm_add_ps(row, _mm_loadu_ps(&bias[oc_gi]));
 #endif
           }
           if (active_type == lite_api::ActivationType::kRelu) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             row = _mm256_max_ps(row, _mm256_set1_ps(0.f));
 #else
             row = _mm_max_ps(row, _mm_set1_ps(0.f));
 #endif
           } else if (active_type == lite_api::ActivationType::kRelu6) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             row = _mm256_max_ps(row, _mm256_set1_ps(0.f));
             row =
                 _mm256_min_ps(row, _mm256_set1_ps(act_param.Relu_clipped_coef));
@@ -986,7 +989,7 @@ void conv_direct_3x3s2(const float* i_data,
             row = _mm_min_ps(row, _mm_set1_ps(6.f));
 #endif
           } else if (active_type == lite_api::ActivationType::kLeakyRelu) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 val_scale =
                 _mm256_mul_ps(row, _mm256_set1_ps(act_param.Leaky_relu_alpha));
             row = _mm256_blendv_ps(
@@ -1000,7 +1003,7 @@ void conv_direct_3x3s2(const float* i_data,
                 val_scale, row, _mm_cmp_ps(row, _mm_setzero_ps(), _CMP_GT_OS));
 #endif
           } else if (active_type == lite_api::ActivationType::kHardSwish) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
             __m256 val_offset =
                 _mm256_add_ps(row, _mm256_set1_ps(act_param.hard_swish_offset));
             __m256 val_scale = _mm256_mul_ps(
@@ -1022,7 +1025,7 @@ void conv_direct_3x3s2(const float* i_data,
           } else {
             LOG(FATAL) << "[X86] unsupported Activation type";
           }
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
           *(dst_address + 0 * oh * ow) = (reinterpret_cast<float*>(&row))[0];
           *(dst_address + 1 * oh * ow) = (reinterpret_cast<float*>(&row))[1];
           *(dst_address + 2 * oh * ow) = (reinterpret_cast<float*>(&row))[2];
@@ -1048,3 +1051,5 @@ void conv_direct_3x3s2(const float* i_data,
 }  // namespace x86
 }  // namespace lite
 }  // namespace paddle
+
+#include "lite/backends/x86/math/avx2_target_end.h"
@@ -45,7 +45,7 @@ class CrossEntropyFunctor<lite::TargetType::kX86, T> {
       auto lbl = EigenMatrix<T>::From(*labels);
       auto loss = EigenMatrix<T>::From(*out);
 
-      loss.device(lite::fluid::EigenDeviceType<lite::TargetType::kX86>()) =
+      loss.device(lite::fluid::GetEigenDevice<lite::TargetType::kX86>()) =
           -((lbl * in.log().unaryExpr(math::TolerableValue<T>()))
                 .reshape(batch_axis_remain)
                 .sum(Eigen::DSizes<int, 1>(1)));
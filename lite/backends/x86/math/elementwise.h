@@ -13,6 +13,7 @@
 // limitations under the License.
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include "lite/backends/x86/math/elementwise_common_broadcast_config.h"
 
@@ -21,6 +22,57 @@ namespace lite {
 namespace x86 {
 namespace math {
 
+// Elementwise ops over more elements than this are split among the threads.
+constexpr int kElementwiseParallelSize = 1 << 15;
+
+// z = x op y on num elements of the same shape, in chunks per thread.
+template <class Config>
+void elementwise_same_dim(const typename Config::T* dinx,
+                          const typename Config::T* diny,
+                          typename Config::T* dout,
+                          int num) {
+  // A multiple of any vector width, keeps every chunk but the last aligned.
+  constexpr int kChunk = 1 << 14;
+  const int chunks = (num + kChunk - 1) / kChunk;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (num > kElementwiseParallelSize)
+#endif
+  for (int i = 0; i < chunks; ++i) {
+    const int offset = i * kChunk;
+    const int len = (std::min)(kChunk, num - offset);
+    elementwise_range_to_range<Config>(
+        dinx + offset, diny + offset, dout + offset, len);
+  }
+}
+
+// z = x op y where the smaller operand has `channels` elements, each of which
+// is broadcast along `num` continuous elements of the bigger one. `inv` means
+// x is the smaller operand.
+template <class Config>
+void elementwise_broadcast(const typename Config::T* dinx,
+                           const typename Config::T* diny,
+                           typename Config::T* dout,
+                           int batch,
+                           int channels,
+                           int num,
+                           bool inv) {
+  const int rows = batch * channels;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (rows * num > kElementwiseParallelSize)
+#endif
+  for (int i = 0; i < rows; ++i) {
+    const int j = i % channels;
+    const int offset = i * num;
+    if (inv) {
+      elementwise_one_to_range<Config>(
+          dinx + j, diny + offset, dout + offset, num);
+    } else {
+      elementwise_range_to_one<Config>(
+          dinx + offset, diny + j, dout + offset, num);
+    }
+  }
+}
+
 #define ElementWiseFunc(op)                                                    \
   template <typename T>                                                        \
   void Elementwise_##op(const T* dinx,                                         \
@@ -30,124 +82,52 @@ namespace math {
                         bool has_active,                                       \
                         std::string act_type) {                                \
     if (act_type == "tanh") {                                                  \
-      lite::x86::math::elementwise_range_to_range<                             \
+      elementwise_same_dim<                                                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "relu") {                                           \
-      lite::x86::math::elementwise_range_to_range<                             \
+      elementwise_same_dim<                                                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
           dinx, diny, dout, num);                                              \
     } else if (act_type == "sigmoid") {                                        \
-      lite::x86::math::elementwise_range_to_range<                             \
+      elementwise_same_dim<                                                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
           dinx, diny, dout, num);                                              \
     } else {                                                                   \
-      lite::x86::math::elementwise_range_to_range<                             \
+      elementwise_same_dim<                                                    \
           MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
           dinx, diny, dout, num);                                              \
     }                                                                          \
   }
 
-#define ElementWiseFuncBCast(op)                                      \
-  template <typename T>                                               \
-  void Elementwise_Broadcast_##op(const T* dinx,                      \
-                                  const T* diny,                      \
-                                  T* dout,                            \
-                                  int batch,                          \
-                                  int channels,                       \
-                                  int num,                            \
-                                  bool has_active,                    \
-                                  std::string act_type,               \
-                                  bool inv) {                         \
-    if (act_type == "tanh") {                                         \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::TANH, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "relu") {                                  \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::RELU, T>>>(      \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else if (act_type == "sigmoid") {                               \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::SIGMOID, T>>>(   \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    } else {                                                          \
-      for (int i = 0; i < batch; ++i) {                               \
-        for (int j = 0; j < channels; ++j) {                          \
-          int offset = (i * channels + j) * num;                      \
-          auto* dout_ptr = dout + offset;                             \
-          if (inv) {                                                  \
-            const auto* dinx_ptr = dinx + j;                          \
-            const auto* diny_ptr = diny + offset;                     \
-            lite::x86::math::elementwise_one_to_range<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          } else {                                                    \
-            const auto* dinx_ptr = dinx + offset;                     \
-            const auto* diny_ptr = diny + j;                          \
-            lite::x86::math::elementwise_range_to_one<                \
-                MergeConfig<op##Config<T>,                            \
-                            ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
-                dinx_ptr, diny_ptr, dout_ptr, num);                   \
-          }                                                           \
-        }                                                             \
-      }                                                               \
-    }                                                                 \
+#define ElementWiseFuncBCast(op)                                               \
+  template <typename T>                                                        \
+  void Elementwise_Broadcast_##op(const T* dinx,                               \
+                                  const T* diny,                               \
+                                  T* dout,                                     \
+                                  int batch,                                   \
+                                  int channels,                                \
+                                  int num,                                     \
+                                  bool has_active,                             \
+                                  std::string act_type,                        \
+                                  bool inv) {                                  \
+    if (act_type == "tanh") {                                                  \
+      elementwise_broadcast<                                                   \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::TANH, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "relu") {                                           \
+      elementwise_broadcast<                                                   \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::RELU, T>>>(      \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else if (act_type == "sigmoid") {                                        \
+      elementwise_broadcast<                                                   \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::SIGMOID, T>>>(   \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    } else {                                                                   \
+      elementwise_broadcast<                                                   \
+          MergeConfig<op##Config<T>, ActiveConfig<ActiveType::NO_ACTIVE, T>>>( \
+          dinx, diny, dout, batch, channels, num, inv);                        \
+    }                                                                          \
   }
 
 // clang-format off
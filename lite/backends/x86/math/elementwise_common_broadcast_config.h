@@ -99,80 +99,80 @@ T min_epi32_inline(T a, T b);
 // compiler can't recognize intrinsics function name
 #ifdef __AVX__
 template <>
-__m256 loadu_ps_inline<__m256, float>(const float* a) {
+inline __m256 loadu_ps_inline<__m256, float>(const float* a) {
   return _mm256_loadu_ps(a);
 }
 template <>
-void storeu_ps_inline<__m256, float>(float* b, __m256 a) {
+inline void storeu_ps_inline<__m256, float>(float* b, __m256 a) {
   _mm256_storeu_ps(b, a);
 }
 template <>
-__m256 set1_ps_inline<__m256, float>(float a) {
+inline __m256 set1_ps_inline<__m256, float>(float a) {
   return _mm256_set1_ps(a);
 }
 template <>
-__m256 add_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 add_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_add_ps(a, b);
 }
 template <>
-__m256 sub_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 sub_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_sub_ps(a, b);
 }
 template <>
-__m256 max_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 max_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_max_ps(a, b);
 }
 template <>
-__m256 min_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 min_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_min_ps(a, b);
 }
 template <>
-__m256 div_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 div_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_div_ps(a, b);
 }
 template <>
-__m256 mul_ps_inline<__m256>(__m256 a, __m256 b) {
+inline __m256 mul_ps_inline<__m256>(__m256 a, __m256 b) {
   return _mm256_mul_ps(a, b);
 }
 #elif defined(__SSE4_2__)
 template <>
-__m128 loadu_ps_inline<__m128, float>(const float* a) {
+inline __m128 loadu_ps_inline<__m128, float>(const float* a) {
   return _mm_loadu_ps(a);
 }
 template <>
-void storeu_ps_inline<__m128, float>(float* b, __m128 a) {
+inline void storeu_ps_inline<__m128, float>(float* b, __m128 a) {
   _mm_storeu_ps(b, a);
 }
 template <>
-__m128 set1_ps_inline<__m128, float>(float a) {
+inline __m128 set1_ps_inline<__m128, float>(float a) {
   return _mm_set1_ps(a);
 }
 template <>
-__m128 add_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 add_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_add_ps(a, b);
 }
 template <>
-__m128 sub_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 sub_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_sub_ps(a, b);
 }
 template <>
-__m128 max_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 max_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_max_ps(a, b);
 }
 template <>
-__m128 min_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 min_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_min_ps(a, b);
 }
 template <>
-__m128 div_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 div_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_div_ps(a, b);
 }
 template <>
-__m128 mul_ps_inline<__m128>(__m128 a, __m128 b) {
+inline __m128 mul_ps_inline<__m128>(__m128 a, __m128 b) {
   return _mm_mul_ps(a, b);
 }
 
-__m128 _mm_relu_ps(const __m128& a) {
+inline __m128 _mm_relu_ps(const __m128 a) {
   __m128 vec_zero = _mm_set1_ps(0.f);
   return _mm_max_ps(a, vec_zero);
 }
@@ -180,92 +180,92 @@ __m128 _mm_relu_ps(const __m128& a) {
 
 #if defined(__AVX2__)
 template <>
-__m256i loadu_si_inline<__m256i, __m256i>(const __m256i* a) {
+inline __m256i loadu_si_inline<__m256i, __m256i>(const __m256i* a) {
   return _mm256_loadu_si256(a);
 }
 template <>
-void storeu_si_inline<__m256i, __m256i>(__m256i* b, __m256i a) {
+inline void storeu_si_inline<__m256i, __m256i>(__m256i* b, __m256i a) {
   _mm256_storeu_si256(b, a);
 }
 template <>
-__m256i set1_epi32_inline<__m256i, int>(int a) {
+inline __m256i set1_epi32_inline<__m256i, int>(int a) {
   return _mm256_set1_epi32(a);
 }
 template <>
-__m256i set1_epi64x_inline<__m256i, int64_t>(int64_t a) {
+inline __m256i set1_epi64x_inline<__m256i, int64_t>(int64_t a) {
   return _mm256_set1_epi64x(a);
 }
 template <>
-__m256i add_epi32_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i add_epi32_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_add_epi32(a, b);
 }
 template <>
-__m256i add_epi64_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i add_epi64_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_add_epi64(a, b);
 }
 template <>
-__m256i sub_epi32_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i sub_epi32_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_sub_epi32(a, b);
 }
 template <>
-__m256i sub_epi64_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i sub_epi64_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_sub_epi64(a, b);
 }
 template <>
-__m256i mul_epi32_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i mul_epi32_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_mullo_epi32(a, b);
 }
 template <>
-__m256i max_epi32_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i max_epi32_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_max_epi32(a, b);
 }
 template <>
-__m256i min_epi32_inline<__m256i>(__m256i a, __m256i b) {
+inline __m256i min_epi32_inline<__m256i>(__m256i a, __m256i b) {
   return _mm256_min_epi32(a, b);
 }
 #elif defined(__SSE4_2__)
 template <>
-__m128i loadu_si_inline<__m128i, __m128i>(const __m128i* a) {
+inline __m128i loadu_si_inline<__m128i, __m128i>(const __m128i* a) {
   return _mm_loadu_si128(a);
 }
 template <>
-void storeu_si_inline<__m128i, __m128i>(__m128i* b, __m128i a) {
+inline void storeu_si_inline<__m128i, __m128i>(__m128i* b, __m128i a) {
   _mm_storeu_si128(b, a);
 }
 template <>
-__m128i set1_epi32_inline<__m128i, int>(int a) {
+inline __m128i set1_epi32_inline<__m128i, int>(int a) {
   return _mm_set1_epi32(a);
 }
 template <>
-__m128i set1_epi64x_inline<__m128i, int64_t>(int64_t a) {
+inline __m128i set1_epi64x_inline<__m128i, int64_t>(int64_t a) {
   return _mm_set1_epi64x(a);
 }
 template <>
-__m128i add_epi32_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i add_epi32_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_add_epi32(a, b);
 }
 template <>
-__m128i add_epi64_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i add_epi64_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_add_epi64(a, b);
 }
 template <>
-__m128i sub_epi32_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i sub_epi32_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_sub_epi32(a, b);
 }
 template <>
-__m128i sub_epi64_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i sub_epi64_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_sub_epi64(a, b);
 }
 template <>
-__m128i mul_epi32_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i mul_epi32_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_mullo_epi32(a, b);
 }
 template <>
-__m128i max_epi32_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i max_epi32_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_max_epi32(a, b);
 }
 template <>
-__m128i min_epi32_inline<__m128i>(__m128i a, __m128i b) {
+inline __m128i min_epi32_inline<__m128i>(__m128i a, __m128i b) {
   return _mm_min_epi32(a, b);
 }
 #endif
@@ -661,7 +661,6 @@ struct ActiveConfig<ActiveType::SIGMOID, float> {
   constexpr static bool has_active = true;
 };
 #elif defined(__SSE4_2__)
-__m128 _mm_relu_ps(const __m128& a);
 
 template <>
 struct ActiveConfig<ActiveType::RELU, float> {
@@ -855,6 +854,34 @@ void do_isa_elementwise(const typename Config::T* dinx,
   }
 }
 
+// Applies the activation of Config to num elements, used by the fused
+// elementwise chains. Falls back to the naive activation when there is no isa
+// version.
+template <class Config>
+void do_isa_active(const typename Config::T* din,
+                   typename Config::T* dout,
+                   int num) {
+  using T = typename Config::T;
+  using ISA_T = typename Config::ISA_T;
+  using LD_T = typename Config::LD_T;
+  constexpr auto isa_ld = Config::isa_ld;
+  constexpr auto isa_st = Config::isa_str;
+  constexpr auto isa_act = Config::isa_active;
+  constexpr auto naive_active = Config::naive_active;
+  constexpr int element_num = sizeof(ISA_T) / sizeof(T);
+
+  int i = 0;
+  if (condition_three(reinterpret_cast<void*>(isa_act))) {
+    for (; i + element_num <= num; i += element_num) {
+      ISA_T din0 = isa_ld(reinterpret_cast<const LD_T*>(din + i));
+      isa_st(reinterpret_cast<LD_T*>(dout + i), isa_act(din0));
+    }
+  }
+  for (; i < num; i++) {
+    dout[i] = naive_active(din[i]);
+  }
+}
+
 template <class Config>
 void elementwise_one_to_range(const typename Config::T* dinx,
                               const typename Config::T* diny,
@@ -15,25 +15,33 @@ limitations under the License. */
 #include "lite/backends/x86/math/fill_bias_activate.h"
 #include <string.h>
 #include <algorithm>
+#include <cmath>
+#include <vector>
+#include "lite/backends/x86/math/isa_dispatch.h"
 #include "lite/core/op_registry.h"
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
 #include <immintrin.h>
+#include "lite/backends/x86/math/avx/avx_mathfuns.h"
 #endif
 #ifdef __SSE__
 #include <xmmintrin.h>
 #endif
+#ifdef __SSE4_1__
+#include <smmintrin.h>
+#endif
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
 
 static void activate_relu_inplace(float *data, int len, float alpha, int mode) {
   int i = 0;
 
   if (0 == mode) {  // relu
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     __m256 vec_zero = _mm256_set1_ps(0.f);
     for (; i + 7 < len; i += 8) {
       __m256 vec_data = _mm256_loadu_ps(data + i);
@@ -51,7 +59,7 @@ static void activate_relu_inplace(float *data, int len, float alpha, int mode) {
       data[i] = data[i] > 0.f ? data[i] : 0.f;
     }
   } else {  // relu6
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     __m256 vec_zero = _mm256_set1_ps(0.f);
     __m256 vec_alph = _mm256_set1_ps(alpha);
     for (; i + 7 < len; i += 8) {
@@ -87,7 +95,7 @@ static void activate_relu_inplace_bias(float *data,
   int j = 0;
   float *tmp_data = data;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   __m256 vec_zero = {0.f};
   __m256 vec_bias = {0.f};
   __m256 vec_data = {0.f};
@@ -104,7 +112,7 @@ static void activate_relu_inplace_bias(float *data,
     for (j = 0; j < channel; j++) {
       i = 0;
       tmp_data = data + j * channel_size;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
       vec_bias = _mm256_set1_ps(bias[j]);
       for (; i + 7 < channel_size; i += 8) {
         vec_data = _mm256_loadu_ps(tmp_data + i);
@@ -129,7 +137,7 @@ static void activate_relu_inplace_bias(float *data,
     for (j = 0; j < channel; j++) {
       i = 0;
       tmp_data = data + j * channel_size;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
       vec_bias = _mm256_set1_ps(bias[j]);
       for (; i + 7 < channel_size; i += 8) {
         vec_data = _mm256_loadu_ps(tmp_data + i);
@@ -162,7 +170,7 @@ static void activate_lrelu_inplace(float *data, int len, float alpha) {
   const int cmp_le_os = 2;
   int i = 0;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   __m256 vec_zero = _mm256_set1_ps(0.f);
   __m256 vec_alph = _mm256_set1_ps(alpha);
   for (; i + 7 < len; i += 8) {
@@ -198,7 +206,7 @@ static void activate_lrelu_inplace_bias(float *data,
   int j = 0;
   float *tmp_data = data;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   __m256 vec_zero = _mm256_set1_ps(0.f);
   __m256 vec_alph = _mm256_set1_ps(alpha);
   __m256 vec_bias = {0.f};
@@ -213,7 +221,7 @@ static void activate_lrelu_inplace_bias(float *data,
     i = 0;
     tmp_data = data + j * channel_size;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     vec_bias = _mm256_set1_ps(bias[j]);
     for (; i + 7 < channel_size; i += 8) {
       __m256 vec_data = _mm256_add_ps(vec_bias, _mm256_loadu_ps(tmp_data + i));
@@ -248,7 +256,7 @@ static void activate_hardswish_inplace_bias(float *data,
                                             float scale,
                                             float threshold,
                                             float offset) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   int cnt = channel_size >> 5;
   int remain = channel_size & 31;
   __m256 vec_zero = _mm256_set1_ps(0.f);
@@ -266,14 +274,14 @@ static void activate_hardswish_inplace_bias(float *data,
   int cnt_4 = remain >> 2;
   int rem_4 = remain & 3;
   for (int i = 0; i < channel; i++) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     __m256 vec_bias = _mm256_set1_ps(bias[i]);
 #endif
     __m128 vec_bias_128 = _mm_set1_ps(bias[i]);
     float *tmp_data = data + i * channel_size;
 
     for (int j = 0; j < cnt; j++) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
       __m256 vin0 = _mm256_add_ps(_mm256_loadu_ps(tmp_data), vec_bias);
       __m256 vin1 = _mm256_add_ps(_mm256_loadu_ps(tmp_data + 8), vec_bias);
       __m256 vin2 = _mm256_add_ps(_mm256_loadu_ps(tmp_data + 16), vec_bias);
@@ -347,7 +355,7 @@ static void activate_hardswish_inplace_bias(float *data,
 
 static void activate_hardswish_inplace(
     float *data, int len, float scale, float threshold, float offset) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   int cnt = len >> 5;
   int remain = len & 31;
   __m256 vec_zero = _mm256_set1_ps(0.f);
@@ -366,7 +374,7 @@ static void activate_hardswish_inplace(
   int rem_4 = remain & 3;
   float *tmp_data = data;
   for (int i = 0; i < cnt; i++) {
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     __m256 vin0 = _mm256_loadu_ps(tmp_data);
     __m256 vin1 = _mm256_loadu_ps(tmp_data + 8);
     __m256 vin2 = _mm256_loadu_ps(tmp_data + 16);
@@ -440,7 +448,7 @@ static void activate_none_inplace_bias(float *data,
   int j = 0;
   float *tmp_data = data;
 
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
   __m256 vec_bias = {0.f};
   __m256 vec_data = {0.f};
 #endif
@@ -452,7 +460,7 @@ static void activate_none_inplace_bias(float *data,
   for (j = 0; j < channel; j++) {
     i = 0;
     tmp_data = data + j * channel_size;
-#ifdef __AVX__
+#ifdef LITE_X86_AVX
     vec_bias = _mm256_set1_ps(bias[j]);
     for (; i + 7 < channel_size; i += 8) {
       vec_data = _mm256_loadu_ps(tmp_data + i);
@@ -480,6 +488,8 @@ void fill_bias_act(float *tensor,
                    int channel_size,
                    bool flag_bias,
                    const operators::ActivationParam *act_param) {
+  LITE_X86_DISPATCH_AVX2(
+      fill_bias_act, tensor, bias, channel, channel_size, flag_bias, act_param);
   auto act_type = act_param->active_type;
   float local_alpha = 0.f;
   int len = channel * channel_size;
@@ -534,6 +544,286 @@ void fill_bias_act(float *tensor,
   }
 }
 
+static float epilogue_act(float x, const operators::ActivationParam *act) {
+  switch (act->active_type) {
+    case lite_api::ActivationType::kRelu:
+      return x > 0.f ? x : 0.f;
+    case lite_api::ActivationType::kRelu6:
+      return std::min(std::max(x, 0.f), act->Relu_clipped_coef);
+    case lite_api::ActivationType::kLeakyRelu:
+      return x > 0.f ? x : x * act->Leaky_relu_alpha;
+    case lite_api::ActivationType::kHardSwish:
+      return x *
+             std::min(std::max(x + act->hard_swish_offset, 0.f),
+                      act->hard_swish_threshold) /
+             act->hard_swish_scale;
+    case lite_api::ActivationType::kHardSigmoid:
+      return std::min(
+          std::max(x * act->hard_sigmoid_slope + act->hard_sigmoid_offset,
+                   0.f),
+          1.f);
+    case lite_api::ActivationType::kSigmoid:
+      return 1.f / (1.f + std::exp(-x));
+    case lite_api::ActivationType::kSwish:
+      return x / (1.f + std::exp(-act->Swish_beta * x));
+    case lite_api::ActivationType::kTanh:
+      return std::tanh(x);
+    case lite_api::ActivationType::kGelu:
+      if (act->gelu_approximate) {
+        return 0.5f * x *
+               (1.f + std::tanh(0.79788456f * (x + 0.044715f * x * x * x)));
+      }
+      return 0.5f * x * (1.f + std::erf(x * 0.70710678f));
+    default:
+      LOG(FATAL) << "Unsupported activation in the fused epilogue: "
+                 << static_cast<int>(act->active_type);
+  }
+  return x;
+}
+
+#ifdef LITE_X86_AVX
+static __m256 epilogue_sigmoid_avx(__m256 x) {
+  const __m256 one = _mm256_set1_ps(1.f);
+  __m256 e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), x));
+  return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+static __m256 epilogue_tanh_avx(__m256 x) {
+  // tanh(x) = 2 * sigmoid(2x) - 1
+  const __m256 one = _mm256_set1_ps(1.f);
+  __m256 s = epilogue_sigmoid_avx(_mm256_add_ps(x, x));
+  return _mm256_sub_ps(_mm256_add_ps(s, s), one);
+}
+
+static __m256 epilogue_act_avx(__m256 x,
+                               const operators::ActivationParam *act) {
+  const __m256 zero = _mm256_setzero_ps();
+  switch (act->active_type) {
+    case lite_api::ActivationType::kRelu:
+      return _mm256_max_ps(x, zero);
+    case lite_api::ActivationType::kRelu6:
+      return _mm256_min_ps(_mm256_max_ps(x, zero),
+                           _mm256_set1_ps(act->Relu_clipped_coef));
+    case lite_api::ActivationType::kLeakyRelu:
+      return _mm256_blendv_ps(
+          _mm256_mul_ps(x, _mm256_set1_ps(act->Leaky_relu_alpha)),
+          x,
+          _mm256_cmp_ps(x, zero, _CMP_GT_OS));
+    case lite_api::ActivationType::kHardSwish: {
+      __m256 clip = _mm256_min_ps(
+          _mm256_max_ps(
+              _mm256_add_ps(x, _mm256_set1_ps(act->hard_swish_offset)), zero),
+          _mm256_set1_ps(act->hard_swish_threshold));
+      return _mm256_mul_ps(_mm256_mul_ps(x, clip),
+                           _mm256_set1_ps(1.f / act->hard_swish_scale));
+    }
+    case lite_api::ActivationType::kHardSigmoid:
+      return _mm256_min_ps(
+          _mm256_max_ps(
+              _mm256_add_ps(
+                  _mm256_mul_ps(x, _mm256_set1_ps(act->hard_sigmoid_slope)),
+                  _mm256_set1_ps(act->hard_sigmoid_offset)),
+              zero),
+          _mm256_set1_ps(1.f));
+    case lite_api::ActivationType::kSigmoid:
+      return epilogue_sigmoid_avx(x);
+    case lite_api::ActivationType::kSwish:
+      return _mm256_mul_ps(x,
+                           epilogue_sigmoid_avx(_mm256_mul_ps(
+                               x, _mm256_set1_ps(act->Swish_beta))));
+    case lite_api::ActivationType::kTanh:
+      return epilogue_tanh_avx(x);
+    case lite_api::ActivationType::kGelu: {
+      // only the tanh approximation has a vector body
+      __m256 x3 = _mm256_mul_ps(_mm256_mul_ps(x, x), x);
+      __m256 inner = _mm256_mul_ps(
+          _mm256_set1_ps(0.79788456f),
+          _mm256_add_ps(x, _mm256_mul_ps(_mm256_set1_ps(0.044715f), x3)));
+      __m256 t = _mm256_add_ps(_mm256_set1_ps(1.f), epilogue_tanh_avx(inner));
+      return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x), t);
+    }
+    default:
+      return x;
+  }
+}
+
+static bool epilogue_act_vectorized(const operators::ActivationParam *act) {
+  if (act == nullptr) return true;
+  switch (act->active_type) {
+    case lite_api::ActivationType::kRelu:
+    case lite_api::ActivationType::kRelu6:
+    case lite_api::ActivationType::kLeakyRelu:
+    case lite_api::ActivationType::kHardSwish:
+    case lite_api::ActivationType::kHardSigmoid:
+    case lite_api::ActivationType::kSigmoid:
+    case lite_api::ActivationType::kSwish:
+    case lite_api::ActivationType::kTanh:
+      return true;
+    case lite_api::ActivationType::kGelu:
+      return act->gelu_approximate;
+    default:
+      return false;
+  }
+}
+#endif
+
+void fill_bias_residual_act(float *out,
+                            const float *bias,
+                            bool bias_per_row,
+                            const ResidualBroadcast *residual,
+                            int64_t first_row,
+                            int rows,
+                            int cols,
+                            const operators::ActivationParam *act_param,
+                            const operators::ActivationParam *post_act_param) {
+  LITE_X86_DISPATCH_AVX2(fill_bias_residual_act,
+                         out,
+                         bias,
+                         bias_per_row,
+                         residual,
+                         first_row,
+                         rows,
+                         cols,
+                         act_param,
+                         post_act_param);
+  const operators::ActivationParam *act =
+      (act_param != nullptr && act_param->has_active) ? act_param : nullptr;
+  const operators::ActivationParam *post_act =
+      (post_act_param != nullptr && post_act_param->has_active)
+          ? post_act_param
+          : nullptr;
+#ifdef LITE_X86_AVX
+  const bool vectorized =
+      epilogue_act_vectorized(act) && epilogue_act_vectorized(post_act);
+#endif
+  const int64_t res_stride = residual ? residual->col_stride() : 0;
+
+  for (int r = 0; r < rows; r++) {
+    float *dout = out + r * cols;
+    const float *dres = residual ? residual->row(first_row + r) : nullptr;
+    const float row_bias = (bias && bias_per_row) ? bias[r] : 0.f;
+    const float *col_bias = (bias && !bias_per_row) ? bias : nullptr;
+    int i = 0;
+#ifdef LITE_X86_AVX
+    if (vectorized) {
+      const __m256 vrow_bias = _mm256_set1_ps(row_bias);
+      for (; i + 7 < cols; i += 8) {
+        __m256 v = _mm256_add_ps(_mm256_loadu_ps(dout + i), vrow_bias);
+        if (col_bias) v = _mm256_add_ps(v, _mm256_loadu_ps(col_bias + i));
+        if (act) v = epilogue_act_avx(v, act);
+        if (dres) {
+          v = _mm256_add_ps(v,
+                            res_stride ? _mm256_loadu_ps(dres + i)
+                                       : _mm256_set1_ps(dres[0]));
+        }
+        if (post_act) v = epilogue_act_avx(v, post_act);
+        _mm256_storeu_ps(dout + i, v);
+      }
+    }
+#endif
+    for (; i < cols; i++) {
+      float v = dout[i] + row_bias;
+      if (col_bias) v += col_bias[i];
+      if (act) v = epilogue_act(v, act);
+      if (dres) v += dres[i * res_stride];
+      if (post_act) v = epilogue_act(v, post_act);
+      dout[i] = v;
+    }
+  }
+}
+
+LITE_X86_ISA_NAMESPACE_END
+
+#ifndef LITE_X86_ISA
+void ResidualBroadcast::Reset(const Tensor &residual,
+                              const DDim &out_dims,
+                              int col_axis) {
+  const auto &res_dims = residual.dims();
+  if (col_axis != col_axis_ || res_dims != res_dims_ || out_dims != out_dims_) {
+    Plan(res_dims, out_dims, col_axis);
+  }
+  data_ = residual.data<float>();
+  if (expand_) Expand();
+}
+
+void ResidualBroadcast::Plan(const DDim &res_dims,
+                             const DDim &out_dims,
+                             int col_axis) {
+  const int out_rank = static_cast<int>(out_dims.size());
+  const int offset = out_rank - static_cast<int>(res_dims.size());
+  CHECK_GE(offset, 0) << "The fused residual " << res_dims
+                      << " has a higher rank than the output " << out_dims;
+  strides_.assign(out_rank, 0);
+  int64_t stride = 1;
+  for (int d = out_rank - 1; d >= offset; d--) {
+    int64_t dim = res_dims[d - offset];
+    CHECK(dim == out_dims[d] || dim == 1)
+        << "The fused residual " << res_dims
+        << " does not broadcast onto the output " << out_dims;
+    strides_[d] = dim == 1 ? 0 : stride;
+    stride *= dim;
+  }
+  res_dims_ = res_dims;
+  out_dims_ = out_dims;
+  col_axis_ = col_axis;
+  row_dims_.clear();
+  row_strides_.clear();
+  for (int d = 0; d < col_axis; d++) {
+    row_dims_.push_back(out_dims[d]);
+    row_strides_.push_back(strides_[d]);
+  }
+
+  // A row is read with one stride, it must be contiguous or broadcast as a
+  // whole.
+  bool contiguous = true;
+  bool broadcast = true;
+  int64_t row_size = 1;
+  for (int d = out_rank - 1; d >= col_axis; d--) {
+    if (out_dims[d] == 1) continue;
+    contiguous = contiguous && strides_[d] == row_size;
+    broadcast = broadcast && strides_[d] == 0;
+    row_size *= out_dims[d];
+  }
+  expand_ = !contiguous && !broadcast;
+  col_stride_ = broadcast && !contiguous ? 0 : 1;
+  if (!expand_) return;
+  // the expanded residual has the layout of the output
+  for (int d = col_axis - 1; d >= 0; d--) {
+    row_strides_[d] = row_size;
+    row_size *= out_dims[d];
+  }
+  index_.assign(out_rank, 0);
+}
+
+void ResidualBroadcast::Expand() {
+  const int out_rank = static_cast<int>(out_dims_.size());
+  buffer_.Resize(out_dims_);
+  float *dst = buffer_.mutable_data<float>();
+  const int64_t count = out_dims_.production();
+  std::fill(index_.begin(), index_.end(), 0);
+  int64_t src_offset = 0;
+  for (int64_t i = 0; i < count; i++) {
+    dst[i] = data_[src_offset];
+    for (int d = out_rank - 1; d >= 0; d--) {
+      src_offset += strides_[d];
+      if (++index_[d] < out_dims_[d]) break;
+      src_offset -= strides_[d] * out_dims_[d];
+      index_[d] = 0;
+    }
+  }
+  data_ = dst;
+}
+
+const float *ResidualBroadcast::row(int64_t row) const {
+  int64_t offset = 0;
+  for (int d = static_cast<int>(row_dims_.size()) - 1; d >= 0; d--) {
+    offset += row % row_dims_[d] * row_strides_[d];
+    row /= row_dims_[d];
+  }
+  return data_ + offset;
+}
+#endif  // LITE_X86_ISA
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
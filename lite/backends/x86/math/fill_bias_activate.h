@@ -12,6 +12,9 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License. */
 
+#pragma once
+
+#include <vector>
 #include "lite/core/op_registry.h"
 
 namespace paddle {
@@ -26,6 +29,81 @@ void fill_bias_act(float* tensor,
                    bool flag_bias,
                    const operators::ActivationParam* act_param);
 
+// A residual added to an output of `out_dims`, aligned to its trailing dims
+// as elementwise_add with axis -1. The output is read as rows of its dims
+// from `col_axis` on. The residual is read in place with a stride of 0 along
+// the dims it broadcasts on; it is expanded into a buffer of its own only
+// when it broadcasts along some of the dims of a row but not all of them.
+// Kernels keep one as a member: the layout is planned again only when the
+// dims change, so a steady run does not allocate.
+class ResidualBroadcast {
+ public:
+  // Points at the data of `residual`, call it on every run.
+  void Reset(const Tensor& residual, const DDim& out_dims, int col_axis);
+
+  // The residual of the row `row` of the output.
+  const float* row(int64_t row) const;
+  // 1, or 0 when the residual holds one value per row.
+  int64_t col_stride() const { return col_stride_; }
+
+ private:
+  void Plan(const DDim& res_dims, const DDim& out_dims, int col_axis);
+  void Expand();
+
+  DDim res_dims_;
+  DDim out_dims_;
+  int col_axis_{-1};
+  const float* data_{nullptr};
+  // strides of the residual over the output index space, 0 where it
+  // broadcasts
+  std::vector<int64_t> strides_;
+  // the output dims before col_axis, and the residual strides along them
+  std::vector<int64_t> row_dims_;
+  std::vector<int64_t> row_strides_;
+  int64_t col_stride_{1};
+  bool expand_{false};
+  std::vector<int64_t> index_;
+  Tensor buffer_;
+};
+
+// Fused GEMM epilogue: out = post_act(act(out + bias) + residual), applied to
+// a rows x cols block in a single sweep. `bias` holds one value per row when
+// `bias_per_row` is set (conv output channels) and one per column otherwise
+// (fc output features). The rows of the block are the rows `first_row`... of
+// `residual`. Null bias/residual and null or inactive activations are
+// skipped; prelu is not supported.
+void fill_bias_residual_act(float* out,
+                            const float* bias,
+                            bool bias_per_row,
+                            const ResidualBroadcast* residual,
+                            int64_t first_row,
+                            int rows,
+                            int cols,
+                            const operators::ActivationParam* act_param,
+                            const operators::ActivationParam* post_act_param);
+
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copies of the kernels above, see isa_dispatch.h.
+namespace avx2 {
+void fill_bias_act(float* tensor,
+                   const float* bias,
+                   int channel,
+                   int channel_size,
+                   bool flag_bias,
+                   const operators::ActivationParam* act_param);
+
+void fill_bias_residual_act(float* out,
+                            const float* bias,
+                            bool bias_per_row,
+                            const ResidualBroadcast* residual,
+                            int64_t first_row,
+                            int rows,
+                            int cols,
+                            const operators::ActivationParam* act_param,
+                            const operators::ActivationParam* post_act_param);
+}  // namespace avx2
+#endif
+
 }  // namespace math
 }  // namespace x86
 }  // namespace lite
@@ -0,0 +1,166 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/fp16_gemm.h"
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+#include <algorithm>
+#include <vector>
+#include "lite/backends/x86/math/blas.h"
+#include "lite/utils/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Number of floats of a widened panel, 256KB keeps it in L2.
+static constexpr int64_t kPanelSize = 64 * 1024;
+
+void fp16_to_fp32(const uint16_t* in, float* out, int64_t n) {
+  int64_t i = 0;
+#ifdef __F16C__
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_cvtph_ps(h));
+  }
+#endif
+  for (; i < n; ++i) {
+    lite::float16 h;
+    h.x = in[i];
+    out[i] = static_cast<float>(h);
+  }
+}
+
+void fp16_to_fp32(const lite::Tensor& in, lite::Tensor* out) {
+  CHECK(in.precision() == PRECISION(kFP16));
+  out->Resize(in.dims());
+  fp16_to_fp32(in.data<uint16_t>(), out->mutable_data<float>(), in.numel());
+}
+
+void gemm_fp16_b(const lite::X86Context& context,
+                 bool trans_b,
+                 int M,
+                 int N,
+                 int K,
+                 float alpha,
+                 const float* A,
+                 int lda,
+                 const uint16_t* B,
+                 int ldb,
+                 float* C,
+                 int ldc) {
+  auto blas = GetBlas<lite::TargetType::kX86, float>(context);
+  if (trans_b) {
+    // B is [N, K]: widen a block of its rows, i.e. of the output columns.
+    int nb = static_cast<int>(
+        (std::max)(static_cast<int64_t>(1), kPanelSize / (std::max)(K, 1)));
+    nb = (std::min)(nb, N);
+    std::vector<float> panel(static_cast<size_t>(nb) * K);
+    for (int n0 = 0; n0 < N; n0 += nb) {
+      int cur_n = (std::min)(nb, N - n0);
+      for (int n = 0; n < cur_n; ++n) {
+        fp16_to_fp32(B + static_cast<int64_t>(n0 + n) * ldb,
+                     panel.data() + static_cast<int64_t>(n) * K,
+                     K);
+      }
+      blas.GEMM(false,
+                true,
+                M,
+                cur_n,
+                K,
+                alpha,
+                A,
+                lda,
+                panel.data(),
+                K,
+                0.f,
+                C + n0,
+                ldc);
+    }
+    return;
+  }
+  // B is [K, N]: widen a block of its rows and accumulate the partial
+  // products over K into C.
+  int kb = static_cast<int>(
+      (std::max)(static_cast<int64_t>(1), kPanelSize / (std::max)(N, 1)));
+  kb = (std::min)(kb, K);
+  std::vector<float> panel(static_cast<size_t>(kb) * N);
+  for (int k0 = 0; k0 < K; k0 += kb) {
+    int cur_k = (std::min)(kb, K - k0);
+    for (int k = 0; k < cur_k; ++k) {
+      fp16_to_fp32(B + static_cast<int64_t>(k0 + k) * ldb,
+                   panel.data() + static_cast<int64_t>(k) * N,
+                   N);
+    }
+    blas.GEMM(false,
+              false,
+              M,
+              N,
+              cur_k,
+              alpha,
+              A + k0,
+              lda,
+              panel.data(),
+              N,
+              k0 == 0 ? 0.f : 1.f,
+              C,
+              ldc);
+  }
+}
+
+void gemm_fp16_a(const lite::X86Context& context,
+                 int M,
+                 int N,
+                 int K,
+                 const uint16_t* A,
+                 int lda,
+                 const float* B,
+                 int ldb,
+                 float* C,
+                 int ldc) {
+  auto blas = GetBlas<lite::TargetType::kX86, float>(context);
+  // Widen a block of rows of A, each block yields the same rows of C.
+  int mb = static_cast<int>(
+      (std::max)(static_cast<int64_t>(1), kPanelSize / (std::max)(K, 1)));
+  mb = (std::min)(mb, M);
+  std::vector<float> panel(static_cast<size_t>(mb) * K);
+  for (int m0 = 0; m0 < M; m0 += mb) {
+    int cur_m = (std::min)(mb, M - m0);
+    for (int m = 0; m < cur_m; ++m) {
+      fp16_to_fp32(A + static_cast<int64_t>(m0 + m) * lda,
+                   panel.data() + static_cast<int64_t>(m) * K,
+                   K);
+    }
+    blas.GEMM(false,
+              false,
+              cur_m,
+              N,
+              K,
+              1.f,
+              panel.data(),
+              K,
+              B,
+              ldb,
+              0.f,
+              C + static_cast<int64_t>(m0) * ldc,
+              ldc);
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
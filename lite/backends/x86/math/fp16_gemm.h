@@ -0,0 +1,71 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "lite/core/context.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Widens n IEEE half values to float. Uses F16C when compiled in.
+void fp16_to_fp32(const uint16_t* in, float* out, int64_t n);
+
+// Widens a whole fp16 tensor into `out` as a float tensor of the same shape.
+void fp16_to_fp32(const lite::Tensor& in, lite::Tensor* out);
+
+/*
+ * \brief   GEMM with fp16 weights and fp32 activations and accumulation.
+ *
+ *  The half operand is widened to fp32 one panel at a time into a small
+ *  buffer that stays in cache, and each panel is multiplied by the fp32
+ *  GEMM. Weights are therefore read from memory at half width, while the
+ *  products and sums are still computed in fp32.
+ *
+ *  gemm_fp16_b:  C[M, N] = alpha * A[M, K] * op(B)   B is fp16
+ *                op(B) is B[K, N], or B[N, K] transposed when trans_b.
+ *  gemm_fp16_a:  C[M, N] = A[M, K] * B[K, N]         A is fp16
+ */
+void gemm_fp16_b(const lite::X86Context& context,
+                 bool trans_b,
+                 int M,
+                 int N,
+                 int K,
+                 float alpha,
+                 const float* A,
+                 int lda,
+                 const uint16_t* B,
+                 int ldb,
+                 float* C,
+                 int ldc);
+
+void gemm_fp16_a(const lite::X86Context& context,
+                 int M,
+                 int N,
+                 int K,
+                 const uint16_t* A,
+                 int lda,
+                 const float* B,
+                 int ldb,
+                 float* C,
+                 int ldc);
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "lite/backends/x86/cpu_info.h"
+
+// Runtime ISA dispatch for sources that carry both an AVX and an SSE body.
+//
+// With LITE_WITH_X86_DISPATCH such a source is compiled twice: once with the
+// baseline SSE4 flags, and once with AVX2/FMA through a one-line wrapper under
+// math/avx2/ that defines LITE_X86_ISA before including the original file.
+// The AVX2 copy places its entry points in the nested namespace `avx2`, and
+// the baseline entry points forward to it when the host supports AVX2.
+//
+// AVX2-only sources (math/avx...) and the wrappers hold AVX2 code that is
+// entered only after UseAVX2(). With GCC they are built with the baseline
+// flags too: they include the shared headers first and wrap only their own
+// code in avx2_target_begin.h and avx2_target_end.h, which turn on AVX2/FMA
+// for the functions defined in between. Inline functions of the shared
+// headers (std containers, Tensor, logging...) are then emitted as baseline
+// code. Were the whole file built with -mavx2, the linker could keep their
+// AVX2 copy for every caller, and the baseline path would raise SIGILL on
+// old CPUs. The jit intrinsic kernels, which check for AVX only, use
+// avx_target_begin.h and avx_target_end.h the same way. Other compilers
+// still build these sources with the AVX2 or AVX flags.
+//
+// GCC does not set __AVX__, __AVX2__ and __FMA__ for a target pragma in C++,
+// so the sources built in such a region select their SIMD bodies with
+// LITE_X86_AVX, LITE_X86_AVX2 and LITE_X86_FMA instead. They follow the
+// compiler flags, and the AVX2 target region defines them as well.
+#ifdef __AVX__
+#define LITE_X86_AVX 1
+#endif
+#ifdef __AVX2__
+#define LITE_X86_AVX2 1
+#endif
+#ifdef __FMA__
+#define LITE_X86_FMA 1
+#endif
+
+#ifdef LITE_X86_ISA
+#define LITE_X86_ISA_NAMESPACE_BEGIN namespace LITE_X86_ISA {
+#define LITE_X86_ISA_NAMESPACE_END }
+#else
+#define LITE_X86_ISA_NAMESPACE_BEGIN
+#define LITE_X86_ISA_NAMESPACE_END
+#endif
+
+#if defined(LITE_WITH_X86_DISPATCH) && !defined(LITE_X86_ISA)
+#define LITE_X86_DISPATCH_AVX2(func, ...)                          \
+  do {                                                             \
+    if (::paddle::lite::x86::math::UseAVX2()) {                    \
+      return ::paddle::lite::x86::math::avx2::func(__VA_ARGS__);   \
+    }                                                              \
+  } while (0)
+#else
+#define LITE_X86_DISPATCH_AVX2(func, ...) \
+  do {                                    \
+  } while (0)
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+#ifdef LITE_WITH_X86_DISPATCH
+// The dispatch level, whether the host supports AVX2 unless SetUseAVX2 forced
+// it.
+inline bool& AVX2DispatchLevel() {
+  static bool use_avx2 = MayIUse(x86::avx2);
+  return use_avx2;
+}
+
+// Forces the baseline or the AVX2 path, so that tests can compare them on an
+// AVX2 host. Forcing AVX2 on a host without it raises SIGILL.
+inline void SetUseAVX2(bool use_avx2) { AVX2DispatchLevel() = use_avx2; }
+#endif
+
+// Whether AVX2/FMA code may run on this host. AVX2-only kernels must check
+// this before being selected in a LITE_WITH_X86_DISPATCH build; without it
+// the AVX code is chosen at build time.
+inline bool UseAVX2() {
+#ifdef LITE_WITH_X86_DISPATCH
+  return AVX2DispatchLevel();
+#else
+  return true;
+#endif
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
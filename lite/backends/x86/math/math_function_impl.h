@@ -31,7 +31,7 @@ void SetConstant<Target, T>::operator()(const lite::Context<Target>& context,
 
   // t.device(*Eigen::DefaultDevice()) = t.constant(static_cast<T>(num));
   // t.device(*context.eigen_device()) = t.constant(static_cast<T>(num));
-  t.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  t.device(lite::fluid::GetEigenDevice<Target>()) =
       t.constant(static_cast<T>(num));
 }
 
@@ -49,7 +49,7 @@ void Transpose<Target, T, Rank>::operator()(
   auto eigen_out = lite::fluid::EigenTensor<T, Rank>::From(*out);
   // auto* dev = context.eigen_device();
   // eigen_out.device(*dev) = eigen_in.shuffle(permute);
-  eigen_out.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  eigen_out.device(lite::fluid::GetEigenDevice<Target>()) =
       eigen_in.shuffle(permute);
 }
 
@@ -65,7 +65,7 @@ void ColwiseSum<Target, T>::operator()(const lite::Context<Target>& context,
   auto vec = lite::fluid::EigenVector<T>::Flatten(*out);
 
   // vec.device(*context.eigen_device()) = in.sum(Eigen::array<int, 1>({{0}}));
-  vec.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  vec.device(lite::fluid::GetEigenDevice<Target>()) =
       in.sum(Eigen::array<int, 1>({{0}}));
 }
 
@@ -110,7 +110,7 @@ void RowwiseMean<Target, T>::operator()(const lite::Context<Target>& context,
   auto vec = lite::fluid::EigenVector<T>::Flatten(*out);
 
   // vec.device(*context.eigen_device()) = in.mean(Eigen::array<int, 1>({{1}}));
-  vec.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  vec.device(lite::fluid::GetEigenDevice<Target>()) =
       in.mean(Eigen::array<int, 1>({{1}}));
 }
 // TODO(zcd): Following ColwiseSum format, need to confirm.
@@ -154,7 +154,7 @@ void RowwiseSum<Target, T>::operator()(const lite::Context<Target>& context,
   auto vec = lite::fluid::EigenVector<T>::Flatten(*out);
 
   // vec.device(*context.eigen_device()) = in.sum(Eigen::array<int, 1>({{1}}));
-  vec.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  vec.device(lite::fluid::GetEigenDevice<Target>()) =
       in.sum(Eigen::array<int, 1>({{1}}));
 }
 // TODO(zcd): Following ColwiseSum format, need to confirm.
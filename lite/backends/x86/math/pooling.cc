@@ -13,18 +13,254 @@ See the License for the specific language governing permissions and
 limitations under the License. */
 
 #include "lite/backends/x86/math/pooling.h"
+#include <emmintrin.h>
 #include <algorithm>
 #include <vector>
+#include "lite/backends/x86/math/pooling_global.h"
 
 namespace paddle {
 namespace lite {
 namespace x86 {
 namespace math {
 
+namespace {
+
+// Pooling reading fewer input elements than this runs on one thread, the
+// OpenMP fork/join would cost more than the work.
+constexpr int64_t kPoolParallelSize = 1 << 15;
+
+struct Pool2dShape {
+  int input_height;
+  int input_width;
+  int output_height;
+  int output_width;
+  int ksize_height;
+  int ksize_width;
+  int stride_height;
+  int stride_width;
+  int padding_height;
+  int padding_width;
+  bool exclusive;
+  bool adaptive;
+};
+
+// Computes output columns [pw_begin, pw_end) of output row ph with the
+// generic pool process.
+template <typename PoolProcess, typename T>
+void PoolRowRef(PoolProcess* pool_process,
+                const T* input_data,
+                const Pool2dShape& s,
+                int ph,
+                int pw_begin,
+                int pw_end,
+                T* output_row) {
+  int hstart, hend;
+  if (s.adaptive) {
+    hstart = AdaptStartIndex(ph, s.input_height, s.output_height);
+    hend = AdaptEndIndex(ph, s.input_height, s.output_height);
+  } else {
+    hstart = ph * s.stride_height - s.padding_height;
+    hend = (std::min)(hstart + s.ksize_height, s.input_height);
+    hstart = (std::max)(hstart, 0);
+  }
+  for (int pw = pw_begin; pw < pw_end; ++pw) {
+    int wstart, wend;
+    if (s.adaptive) {
+      wstart = AdaptStartIndex(pw, s.input_width, s.output_width);
+      wend = AdaptEndIndex(pw, s.input_width, s.output_width);
+    } else {
+      wstart = pw * s.stride_width - s.padding_width;
+      wend = (std::min)(wstart + s.ksize_width, s.input_width);
+      wstart = (std::max)(wstart, 0);
+    }
+
+    T ele = pool_process->initial();
+    for (int h = hstart; h < hend; ++h) {
+      for (int w = wstart; w < wend; ++w) {
+        pool_process->compute(input_data[h * s.input_width + w], &ele);
+      }
+    }
+    int pool_size = (s.exclusive || s.adaptive)
+                        ? (hend - hstart) * (wend - wstart)
+                        : s.ksize_height * s.ksize_width;
+    pool_process->finalize(static_cast<T>(pool_size), &ele);
+    output_row[pw] = ele;
+  }
+}
+
+template <typename PoolProcess, typename T>
+void PoolPlane(PoolProcess* pool_process,
+               const T* input_data,
+               const Pool2dShape& s,
+               T* output_data) {
+  for (int ph = 0; ph < s.output_height; ++ph) {
+    PoolRowRef(pool_process,
+               input_data,
+               s,
+               ph,
+               0,
+               s.output_width,
+               output_data + ph * s.output_width);
+  }
+}
+
+// SIMD paths for float max/avg pooling. The vector reduction of each
+// process is picked by overloading on the process type.
+inline __m128 PoolReduce(const MaxPool<float>&, __m128 a, __m128 b) {
+  return _mm_max_ps(a, b);
+}
+inline __m128 PoolReduce(const AvgPool<float>&, __m128 a, __m128 b) {
+  return _mm_add_ps(a, b);
+}
+inline __m128 PoolFinalize(const MaxPool<float>&, __m128 v, __m128 field) {
+  return v;
+}
+inline __m128 PoolFinalize(const AvgPool<float>&, __m128 v, __m128 field) {
+  return _mm_div_ps(v, field);
+}
+
+// Global pooling of a whole plane, see pooling_global.h.
+inline float PoolGlobal(MaxPool<float>*, const float* in, int size) {
+  return global_max_pool(in, size);
+}
+inline float PoolGlobal(AvgPool<float>*, const float* in, int size) {
+  return global_avg_pool(in, size);
+}
+
+// Computes `count` outputs of a kxk, stride 2 window (k = 2 or 3) whose
+// rows are all inside the input. `rows` points at the first input column
+// of the first window in each of the k rows.
+template <typename PoolProcess>
+void PoolRowS2(PoolProcess* pool_process,
+               const float* const* rows,
+               int k,
+               int count,
+               float* out) {
+  const __m128 field = _mm_set1_ps(static_cast<float>(k * k));
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const int col = 2 * i;
+    __m128 lo = _mm_loadu_ps(rows[0] + col);
+    __m128 hi = _mm_loadu_ps(rows[0] + col + 4);
+    for (int r = 1; r < k; ++r) {
+      lo = PoolReduce(*pool_process, lo, _mm_loadu_ps(rows[r] + col));
+      hi = PoolReduce(*pool_process, hi, _mm_loadu_ps(rows[r] + col + 4));
+    }
+    // even/odd hold columns 0,2,4,6 and 1,3,5,7 of the vertical reduction.
+    __m128 even = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 odd = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+    __m128 res = PoolReduce(*pool_process, even, odd);
+    if (k == 3) {
+      // Column 8 is only read as a scalar so the last window of the row
+      // never loads past the input.
+      float last = rows[0][col + 8];
+      for (int r = 1; r < k; ++r) {
+        pool_process->compute(rows[r][col + 8], &last);
+      }
+      __m128 tail = _mm_shuffle_ps(even, _mm_set1_ps(last), 0x0e);
+      res = PoolReduce(*pool_process,
+                       res,
+                       _mm_shuffle_ps(even, tail, _MM_SHUFFLE(2, 1, 2, 1)));
+    }
+    _mm_storeu_ps(out + i, PoolFinalize(*pool_process, res, field));
+  }
+  for (; i < count; ++i) {
+    float ele = pool_process->initial();
+    for (int r = 0; r < k; ++r) {
+      for (int c = 0; c < k; ++c) {
+        pool_process->compute(rows[r][2 * i + c], &ele);
+      }
+    }
+    pool_process->finalize(static_cast<float>(k * k), &ele);
+    out[i] = ele;
+  }
+}
+
+template <typename PoolProcess>
+void PoolPlaneFloat(PoolProcess* pool_process,
+                    const float* input_data,
+                    const Pool2dShape& s,
+                    float* output_data) {
+  const bool global =
+      s.output_height == 1 && s.output_width == 1 &&
+      (s.adaptive || (s.ksize_height == s.input_height &&
+                      s.ksize_width == s.input_width &&
+                      s.padding_height == 0 && s.padding_width == 0));
+  if (global) {
+    output_data[0] = PoolGlobal(
+        pool_process, input_data, s.input_height * s.input_width);
+    return;
+  }
+  const int k = s.ksize_width;
+  if (s.adaptive || s.stride_width != 2 || s.ksize_height != k ||
+      (k != 2 && k != 3)) {
+    PoolPlane<PoolProcess, float>(pool_process, input_data, s, output_data);
+    return;
+  }
+  // Output columns whose window lies fully inside the input width. There is
+  // none when the input is narrower than the window, the division below
+  // would round a negative span up to zero.
+  const int pw_lo = (std::min)(s.output_width, (s.padding_width + 1) / 2);
+  const int inner_width = s.input_width + s.padding_width - k;
+  const int pw_hi =
+      inner_width < 0
+          ? pw_lo
+          : (std::max)(pw_lo,
+                       (std::min)(s.output_width, inner_width / 2 + 1));
+  const float* rows[3];
+  for (int ph = 0; ph < s.output_height; ++ph) {
+    float* output_row = output_data + ph * s.output_width;
+    const int hstart = ph * s.stride_height - s.padding_height;
+    if (hstart < 0 || hstart + k > s.input_height || pw_lo == pw_hi) {
+      PoolRowRef(pool_process,
+                 input_data,
+                 s,
+                 ph,
+                 0,
+                 s.output_width,
+                 output_row);
+      continue;
+    }
+    PoolRowRef(
+        pool_process, input_data, s, ph, 0, pw_lo, output_row);
+    for (int r = 0; r < k; ++r) {
+      rows[r] = input_data + (hstart + r) * s.input_width + 2 * pw_lo -
+                s.padding_width;
+    }
+    PoolRowS2(pool_process, rows, k, pw_hi - pw_lo, output_row + pw_lo);
+    PoolRowRef(pool_process,
+               input_data,
+               s,
+               ph,
+               pw_hi,
+               s.output_width,
+               output_row);
+  }
+}
+
+inline void PoolPlane(MaxPool<float>* pool_process,
+                      const float* input_data,
+                      const Pool2dShape& s,
+                      float* output_data) {
+  PoolPlaneFloat(pool_process, input_data, s, output_data);
+}
+
+inline void PoolPlane(AvgPool<float>* pool_process,
+                      const float* input_data,
+                      const Pool2dShape& s,
+                      float* output_data) {
+  PoolPlaneFloat(pool_process, input_data, s, output_data);
+}
+
+}  // namespace
+
 /*
  * All tensors are in NCHW format.
  * Ksize, strides, paddings are two elements. These two elements represent
  * height and width, respectively.
+ * Large enough inputs are pooled in parallel over the planes; float max/avg
+ * pooling uses SIMD for global pooling and for the interior of 2x2 and 3x3
+ * stride 2 windows.
  */
 template <typename PoolProcess, typename T>
 class Pool2dFunctor<lite::TargetType::kX86, PoolProcess, T> {
@@ -39,63 +275,43 @@ class Pool2dFunctor<lite::TargetType::kX86, PoolProcess, T> {
                   bool adaptive,
                   lite::Tensor* output) {
     const int batch_size = input->dims()[0];
-    const int input_height = input->dims()[2];
-    const int input_width = input->dims()[3];
     const int output_channels = output->dims()[1];
-    const int output_height = output->dims()[2];
-    const int output_width = output->dims()[3];
-    const int ksize_height = ksize[0];
-    const int ksize_width = ksize[1];
-    const int stride_height = strides[0];
-    const int stride_width = strides[1];
-    const int padding_height = paddings[0];
-    const int padding_width = paddings[2];
+    Pool2dShape shape;
+    shape.input_height = input->dims()[2];
+    shape.input_width = input->dims()[3];
+    shape.output_height = output->dims()[2];
+    shape.output_width = output->dims()[3];
+    shape.ksize_height = ksize[0];
+    shape.ksize_width = ksize[1];
+    shape.stride_height = strides[0];
+    shape.stride_width = strides[1];
+    shape.padding_height = paddings[0];
+    shape.padding_width = paddings[2];
+    shape.exclusive = exclusive;
+    shape.adaptive = adaptive;
 
-    const int input_stride = input_height * input_width;
-    const int output_stride = output_height * output_width;
+    const int input_stride = shape.input_height * shape.input_width;
+    const int output_stride = shape.output_height * shape.output_width;
+    const int planes = batch_size * output_channels;
 
     const T* input_data = input->template data<T>();
     T* output_data = output->template mutable_data<T>(lite::TargetType::kX86);
 
-    int hstart, hend;
-    int wstart, wend;
-    for (int i = 0; i < batch_size; i++) {
-      for (int c = 0; c < output_channels; ++c) {
-        for (int ph = 0; ph < output_height; ++ph) {
-          if (adaptive) {
-            hstart = AdaptStartIndex(ph, input_height, output_height);
-            hend = AdaptEndIndex(ph, input_height, output_height);
-          } else {
-            hstart = ph * stride_height - padding_height;
-            hend = (std::min)(hstart + ksize_height, input_height);
-            hstart = (std::max)(hstart, 0);
-          }
-          for (int pw = 0; pw < output_width; ++pw) {
-            if (adaptive) {
-              wstart = AdaptStartIndex(pw, input_width, output_width);
-              wend = AdaptEndIndex(pw, input_width, output_width);
-            } else {
-              wstart = pw * stride_width - padding_width;
-              wend = (std::min)(wstart + ksize_width, input_width);
-              wstart = (std::max)(wstart, 0);
-            }
-
-            T ele = pool_process.initial();
-            for (int h = hstart; h < hend; ++h) {
-              for (int w = wstart; w < wend; ++w) {
-                pool_process.compute(input_data[h * input_width + w], &ele);
-              }
-            }
-            int pool_size = (exclusive || adaptive)
-                                ? (hend - hstart) * (wend - wstart)
-                                : ksize_height * ksize_width;
-            pool_process.finalize(static_cast<T>(pool_size), &ele);
-            output_data[ph * output_width + pw] = ele;
-          }
-        }
-        input_data += input_stride;
-        output_data += output_stride;
-      }
+#ifdef PADDLE_WITH_MKLML
+    // Adaptive windows tile the input, others read ksize elements per output.
+    const int64_t plane_work =
+        adaptive ? input_stride
+                 : static_cast<int64_t>(output_stride) * ksize[0] * ksize[1];
+    const bool parallel =
+        planes > 1 && planes * plane_work >= kPoolParallelSize;
+#pragma omp parallel for if (parallel)
+#endif
+    for (int nc = 0; nc < planes; ++nc) {
+      PoolProcess process = pool_process;
+      PoolPlane(&process,
+                input_data + nc * input_stride,
+                shape,
+                output_data + nc * output_stride);
     }
   }
 };
@@ -0,0 +1,101 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/pooling_global.h"
+#include <cfloat>
+#include "lite/backends/x86/math/isa_dispatch.h"
+#ifdef LITE_X86_AVX
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
+
+namespace {
+
+struct MaxReduce {
+  float operator()(float a, float b) const { return a > b ? a : b; }
+  __m128 operator()(__m128 a, __m128 b) const { return _mm_max_ps(a, b); }
+#ifdef LITE_X86_AVX
+  __m256 operator()(__m256 a, __m256 b) const { return _mm256_max_ps(a, b); }
+#endif
+};
+
+struct SumReduce {
+  float operator()(float a, float b) const { return a + b; }
+  __m128 operator()(__m128 a, __m128 b) const { return _mm_add_ps(a, b); }
+#ifdef LITE_X86_AVX
+  __m256 operator()(__m256 a, __m256 b) const { return _mm256_add_ps(a, b); }
+#endif
+};
+
+template <typename Reduce>
+float ReducePlane(const Reduce& reduce,
+                  float init,
+                  const float* in,
+                  int size) {
+  int i = 0;
+#ifdef LITE_X86_AVX
+  __m256 acc0 = _mm256_set1_ps(init);
+  __m256 acc1 = acc0;
+  for (; i + 16 <= size; i += 16) {
+    acc0 = reduce(acc0, _mm256_loadu_ps(in + i));
+    acc1 = reduce(acc1, _mm256_loadu_ps(in + i + 8));
+  }
+  acc0 = reduce(acc0, acc1);
+  __m128 acc =
+      reduce(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+#else
+  __m128 acc = _mm_set1_ps(init);
+  __m128 acc1 = acc;
+  for (; i + 8 <= size; i += 8) {
+    acc = reduce(acc, _mm_loadu_ps(in + i));
+    acc1 = reduce(acc1, _mm_loadu_ps(in + i + 4));
+  }
+  acc = reduce(acc, acc1);
+#endif
+  for (; i + 4 <= size; i += 4) {
+    acc = reduce(acc, _mm_loadu_ps(in + i));
+  }
+  acc = reduce(acc, _mm_movehl_ps(acc, acc));
+  acc = reduce(acc, _mm_shuffle_ps(acc, acc, 0x55));
+  float ele = _mm_cvtss_f32(acc);
+  for (; i < size; ++i) {
+    ele = reduce(ele, in[i]);
+  }
+  return ele;
+}
+
+}  // namespace
+
+float global_max_pool(const float* in, int size) {
+  LITE_X86_DISPATCH_AVX2(global_max_pool, in, size);
+  return ReducePlane(MaxReduce(), -FLT_MAX, in, size);
+}
+
+float global_avg_pool(const float* in, int size) {
+  LITE_X86_DISPATCH_AVX2(global_avg_pool, in, size);
+  return ReducePlane(SumReduce(), 0.f, in, size) / static_cast<float>(size);
+}
+
+LITE_X86_ISA_NAMESPACE_END
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
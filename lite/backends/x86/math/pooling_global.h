@@ -0,0 +1,38 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Max and average of the `size` floats at `in`, the global pooling of one
+// plane.
+float global_max_pool(const float* in, int size);
+float global_avg_pool(const float* in, int size);
+
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copies of the kernels above, see isa_dispatch.h.
+namespace avx2 {
+float global_max_pool(const float* in, int size);
+float global_avg_pool(const float* in, int size);
+}  // namespace avx2
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
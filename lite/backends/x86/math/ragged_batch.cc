@@ -0,0 +1,79 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/ragged_batch.h"
+#include <algorithm>
+#include "lite/backends/x86/parallel.h"
+#include "lite/utils/log/cp_logging.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// Below this amount of elements per thread the fork/join overhead of a
+// parallel region outweighs the work.
+static constexpr int64_t kMinWorkPerThread = 16384;
+
+RaggedBatch::RaggedBatch(const std::vector<uint64_t>& offsets)
+    : offsets_(offsets) {
+  CHECK_GE(offsets_.size(), 1u);
+  CHECK_EQ(offsets_[0], 0u);
+  num_seqs_ = static_cast<int64_t>(offsets_.size()) - 1;
+  for (int64_t i = 0; i < num_seqs_; ++i) {
+    max_len_ = (std::max)(max_len_, seq_len(i));
+    uniform_ = uniform_ && seq_len(i) == seq_len(0);
+  }
+}
+
+void RaggedBatch::ParallelFor(int64_t row_cost, const RangeHandler& f) const {
+  if (num_seqs_ <= 0) {
+    return;
+  }
+  int64_t total_cost = (std::max)(
+      static_cast<int64_t>(total_len()) * row_cost, static_cast<int64_t>(1));
+  int64_t num_threads = (std::min)(
+      {GetMaxThreads(), num_seqs_, total_cost / kMinWorkPerThread});
+  if (num_threads <= 1) {
+    f(0, num_seqs_);
+    return;
+  }
+
+  // Thread t starts at the first sequence whose offset reaches t / n of the
+  // total length, so every range covers about the same number of steps.
+  std::vector<int64_t> bounds(num_threads + 1, num_seqs_);
+  bounds[0] = 0;
+  for (int64_t t = 1; t < num_threads && uniform_; ++t) {
+    bounds[t] = num_seqs_ * t / num_threads;
+  }
+  for (int64_t t = 1; t < num_threads && !uniform_; ++t) {
+    uint64_t target = total_len() * t / num_threads;
+    auto it = std::lower_bound(
+        offsets_.begin() + bounds[t - 1], offsets_.end() - 1, target);
+    bounds[t] = std::distance(offsets_.begin(), it);
+  }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for num_threads(num_threads)
+#endif
+  for (int64_t t = 0; t < num_threads; ++t) {
+    if (bounds[t] < bounds[t + 1]) {
+      f(bounds[t], bounds[t + 1]);
+    }
+  }
+}
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,75 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+/*
+ * \brief   Execution helper for a batch of variable-length sequences.
+ *
+ *  Wraps one level of LoD offsets, e.g. (0, 4, 6, 9, 10), and precomputes the
+ *  per-batch statistics the sequence kernels need, so they are derived once
+ *  per run instead of inside every kernel loop.
+ *
+ *  ParallelFor splits the sequences into contiguous ranges of roughly equal
+ *  total length, so that one long sequence does not serialize a thread while
+ *  the others handle many short ones. Since LoD offsets are already prefix
+ *  sums of the lengths, the split points are found by binary search. When
+ *  all sequences have the same length the batch is a dense tensor, and the
+ *  sequences are split evenly instead.
+ *
+ * \param offsets       LoD offsets of the batch, offsets[0] must be 0. They
+ *                      are copied, so a temporary LoD may be passed.
+ *
+ */
+class RaggedBatch {
+ public:
+  using RangeHandler =
+      std::function<void(const int64_t seq_begin, const int64_t seq_end)>;
+
+  explicit RaggedBatch(const std::vector<uint64_t>& offsets);
+
+  int64_t num_seqs() const { return num_seqs_; }
+  uint64_t seq_begin(int64_t i) const { return offsets_[i]; }
+  uint64_t seq_end(int64_t i) const { return offsets_[i + 1]; }
+  uint64_t seq_len(int64_t i) const { return offsets_[i + 1] - offsets_[i]; }
+  uint64_t total_len() const { return offsets_[num_seqs_]; }
+  uint64_t max_len() const { return max_len_; }
+  // All sequences have the same length, the batch is a dense
+  // [num_seqs, max_len, ...] tensor.
+  bool uniform() const { return uniform_; }
+
+  // Runs f(seq_begin, seq_end) over all sequences. `row_cost` is the work of
+  // one time step, and is used to avoid spawning threads for tiny batches.
+  void ParallelFor(int64_t row_cost, const RangeHandler& f) const;
+
+ private:
+  std::vector<uint64_t> offsets_;
+  int64_t num_seqs_{0};
+  uint64_t max_len_{0};
+  bool uniform_{true};
+};
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
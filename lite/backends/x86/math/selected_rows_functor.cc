@@ -98,7 +98,7 @@ struct SelectedRowsAddTensor<lite::TargetType::kX86, T> {
 
     auto out_eigen = fluid::EigenVector<T>::Flatten(*output);
     auto in2_eigen = fluid::EigenVector<T>::Flatten(input2);
-    out_eigen.device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) =
+    out_eigen.device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) =
         out_eigen + in2_eigen;
   }
 };
@@ -19,6 +19,7 @@ limitations under the License. */
 #include "lite/backends/x86/legacy_place.h"
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/math_function.h"
+#include "lite/backends/x86/math/ragged_batch.h"
 #include "lite/backends/x86/math/sequence_pooling.h"
 
 namespace paddle {
@@ -53,34 +54,41 @@ class MaxSeqPoolFunctor {
     }
     CHECK_EQ(idx_dims, out_dims);
 
-    auto starts = input.lod()[0];
+    const auto& starts = input.lod()[0];
     const T* in_data = input.data<T>();
     T* out_data = output->template mutable_data<T>();
     int* max_index = index->mutable_data<int>();
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
-    for (int64_t i = 0; i < num_seq; ++i) {
-      if (starts[i] == starts[i + 1]) {
-        for (int64_t k = 0; k < dim; ++k) {
-          out_data[i * dim + k] = pad_value;
-          max_index[i * dim + k] = -1;
+    RaggedBatch batch(starts);
+    CHECK_EQ(batch.num_seqs(), num_seq);
+    batch.ParallelFor(dim, [&](int64_t seq_begin, int64_t seq_end) {
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        T* out = out_data + i * dim;
+        int* out_index = max_index + i * dim;
+        if (starts[i] == starts[i + 1]) {
+          for (int64_t k = 0; k < dim; ++k) {
+            out[k] = pad_value;
+            out_index[k] = -1;
+          }
+          continue;
         }
-        continue;
-      }
-      for (int64_t k = 0; k < dim; ++k) {
-        out_data[i * dim + k] = in_data[starts[i] * dim + k];
-        max_index[i * dim + k] = starts[i];
-      }
-      for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
         for (int64_t k = 0; k < dim; ++k) {
-          if (in_data[j * dim + k] > out_data[i * dim + k]) {
-            out_data[i * dim + k] = in_data[j * dim + k];
-            max_index[i * dim + k] = j;
+          out[k] = in_data[starts[i] * dim + k];
+          out_index[k] = starts[i];
+        }
+        for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
+          const T* in = in_data + j * dim;
+          for (int64_t k = 0; k < dim; ++k) {
+            if (in[k] > out[k]) {
+              out[k] = in[k];
+              out_index[k] = j;
+            }
           }
         }
       }
-    }
+    });
   }
 };
 // Instantisation of Max Sequence Pooling for test phase eg. no need to fill
@@ -101,29 +109,33 @@ class MaxSeqPoolFunctor<T, true> {
       CHECK_EQ(in_dims[i], out_dims[i]);
     }
 
-    auto starts = input.lod()[0];
+    const auto& starts = input.lod()[0];
     const T* in_data = input.data<T>();
     T* out_data = output->template mutable_data<T>();
 
     int64_t num_seq = out_dims[0];
     int64_t dim = output->numel() / num_seq;
-    for (int64_t i = 0; i < num_seq; ++i) {
-      if (starts[i] == starts[i + 1]) {
-        for (int64_t k = 0; k < dim; ++k) {
-          out_data[i * dim + k] = pad_value;
+    RaggedBatch batch(starts);
+    CHECK_EQ(batch.num_seqs(), num_seq);
+    batch.ParallelFor(dim, [&](int64_t seq_begin, int64_t seq_end) {
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        T* out = out_data + i * dim;
+        if (starts[i] == starts[i + 1]) {
+          for (int64_t k = 0; k < dim; ++k) {
+            out[k] = pad_value;
+          }
+          continue;
         }
-        continue;
-      }
-      std::memcpy(
-          &out_data[i * dim], &in_data[starts[i] * dim], dim * sizeof(T));
-      for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
-        for (int64_t k = 0; k < dim; ++k) {
-          if (in_data[j * dim + k] > out_data[i * dim + k]) {
-            out_data[i * dim + k] = in_data[j * dim + k];
+        std::memcpy(out, &in_data[starts[i] * dim], dim * sizeof(T));
+        for (size_t j = starts[i] + 1; j < starts[i + 1]; ++j) {
+          // Branch-free select so the row reduction is vectorized.
+          const T* in = in_data + j * dim;
+          for (int64_t k = 0; k < dim; ++k) {
+            out[k] = in[k] > out[k] ? in[k] : out[k];
           }
         }
       }
-    }
+    });
   }
 };
 template <typename T>
@@ -174,23 +186,23 @@ class LastSeqPoolFunctor {
 
     // Calculate the size of each item in sequence
     int64_t item_size = input.numel() / input.dims()[0];
-    auto lod = input.lod()[0];
-    int seq_num = static_cast<int>(lod.size()) - 1;
-    for (int i = 0; i < seq_num; ++i) {
-      // Calculate the length of each sequence
-      int64_t seq_len = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      if (seq_len == 0) {
-        for (int j = 0; j < item_size; ++j) {
-          out_data[j] = pad_value;
+    const auto& lod = input.lod()[0];
+    RaggedBatch batch(lod);
+    batch.ParallelFor(1, [&](int64_t seq_begin, int64_t seq_end) {
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        T* out = out_data + i * item_size;
+        if (batch.seq_len(i) == 0) {
+          for (int j = 0; j < item_size; ++j) {
+            out[j] = pad_value;
+          }
+        } else {
+          // Copy the last item of sequence to output
+          std::memcpy(out,
+                      in_data + (batch.seq_end(i) - 1) * item_size,
+                      item_size * sizeof(T));
         }
-      } else {
-        // Point to the begin of next sequence
-        in_data += seq_len * item_size;
-        // Copy the last item of sequence to output
-        std::memcpy(out_data, (in_data - item_size), item_size * sizeof(T));
       }
-      out_data += item_size;
-    }
+    });
   }
 };
 
@@ -207,23 +219,23 @@ class FirstSeqPoolFunctor {
 
     // Calculate the size of each item in sequence
     int64_t item_size = input.numel() / input.dims()[0];
-    auto lod = input.lod()[0];
-    int seq_num = static_cast<int>(lod.size()) - 1;
-    for (int i = 0; i < seq_num; ++i) {
-      // Calculate the length of each sequence
-      int64_t seq_len = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      if (seq_len == 0) {
-        for (int j = 0; j < item_size; ++j) {
-          out_data[j] = pad_value;
+    const auto& lod = input.lod()[0];
+    RaggedBatch batch(lod);
+    batch.ParallelFor(1, [&](int64_t seq_begin, int64_t seq_end) {
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        T* out = out_data + i * item_size;
+        if (batch.seq_len(i) == 0) {
+          for (int j = 0; j < item_size; ++j) {
+            out[j] = pad_value;
+          }
+        } else {
+          // Copy the first item of sequence to output
+          std::memcpy(out,
+                      in_data + batch.seq_begin(i) * item_size,
+                      item_size * sizeof(T));
         }
-      } else {
-        // Copy the first item of sequence to output
-        std::memcpy(out_data, in_data, item_size * sizeof(T));
-        // Point to the next sequence
-        in_data += seq_len * item_size;
       }
-      out_data += item_size;
-    }
+    });
   }
 };
 
@@ -285,54 +297,73 @@ class SequencePoolFunctor<TARGET(kX86), T> {
       return;
     }
 
-    auto lod = input.lod()[0];
-    if (pooltype == "SUM") {
-      const T* src = input.data<T>();
-      T* dst = output->template mutable_data<T>(TARGET(kX86));
-      jit::seq_pool_attr_t attr(
-          static_cast<int>(input.numel() / input.dims()[0]),
-          jit::SeqPoolType::kSum);
-      auto seqpool =
-          jit::KernelFuncs<jit::SeqPoolTuple<T>, lite::fluid::CPUPlace>::Cache()
-              .At(attr);
-      for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
-        attr.h = static_cast<int>(lod[i + 1] - lod[i]);
-        if (attr.h == 0) {
-          for (int j = 0; j < attr.w; ++j) {
-            dst[j] = pad_value;
+    const auto& lod = input.lod()[0];
+    if (pooltype != "SUM" && pooltype != "AVERAGE" && pooltype != "SQRT") {
+      LOG(FATAL) << "unsupported pooling pooltype";
+    }
+    // The jit kAvg/kSqrt kernels keep 1/h in a member of the generated code,
+    // which is not safe to share between threads. So every pooling type runs
+    // the kSum kernel and AVERAGE/SQRT scale the pooled row afterwards.
+    const T* src = input.data<T>();
+    T* dst = output->template mutable_data<T>(TARGET(kX86));
+    const int w = static_cast<int>(input.numel() / input.dims()[0]);
+    jit::seq_pool_attr_t sum_attr(w, jit::SeqPoolType::kSum);
+    auto seqpool =
+        jit::KernelFuncs<jit::SeqPoolTuple<T>, lite::fluid::CPUPlace>::Cache()
+            .At(sum_attr);
+    const bool is_average = pooltype == "AVERAGE";
+    const bool is_sqrt = pooltype == "SQRT";
+    RaggedBatch batch(lod);
+    if (batch.uniform() && batch.max_len() > 0) {
+      // Dense [num_seqs, h, w] batch: every sequence shares the kernel
+      // attribute and the scale, so the rows are pooled without per-sequence
+      // bookkeeping.
+      const int h = static_cast<int>(batch.max_len());
+      T scale = static_cast<T>(1);
+      if (is_average) {
+        scale = static_cast<T>(1) / static_cast<T>(h);
+      } else if (is_sqrt) {
+        scale = static_cast<T>(1) / std::sqrt(static_cast<T>(h));
+      }
+      const bool need_scale = is_average || is_sqrt;
+      batch.ParallelFor(w, [&](int64_t seq_begin, int64_t seq_end) {
+        jit::seq_pool_attr_t attr(w, jit::SeqPoolType::kSum);
+        attr.h = h;
+        for (int64_t i = seq_begin; i < seq_end; ++i) {
+          T* out = dst + i * w;
+          seqpool(src + i * h * w, out, &attr);
+          for (int j = 0; need_scale && j < w; ++j) {
+            out[j] *= scale;
           }
-        } else {
-          seqpool(src, dst, &attr);
         }
-        dst += attr.w;
-        src += attr.h * attr.w;
-      }
+      });
       return;
     }
-    auto eigen_device = lite::fluid::EigenDeviceType<TARGET(kX86)>();
-    for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
-      Tensor out_t = output->Slice<float>(i, i + 1);
-      int64_t w = input.numel() / input.dims()[0];
-      if (lod[i] == lod[i + 1]) {
-        for (int j = 0; j < w; ++j) {
-          out_t.mutable_data<T>()[j] = pad_value;
+    batch.ParallelFor(w, [&](int64_t seq_begin, int64_t seq_end) {
+      jit::seq_pool_attr_t attr(w, jit::SeqPoolType::kSum);
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        T* out = dst + i * w;
+        attr.h = static_cast<int>(batch.seq_len(i));
+        if (attr.h == 0) {
+          for (int j = 0; j < w; ++j) {
+            out[j] = pad_value;
+          }
+          continue;
+        }
+        seqpool(src + batch.seq_begin(i) * w, out, &attr);
+        if (is_average) {
+          T scale = static_cast<T>(1) / static_cast<T>(attr.h);
+          for (int j = 0; j < w; ++j) {
+            out[j] *= scale;
+          }
+        } else if (is_sqrt) {
+          T scale = static_cast<T>(1) / std::sqrt(static_cast<T>(attr.h));
+          for (int j = 0; j < w; ++j) {
+            out[j] *= scale;
+          }
         }
-        continue;
-      }
-      Tensor in_t = input.Slice<float>(static_cast<int>(lod[i]),
-                                       static_cast<int>(lod[i + 1]));
-      int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
-      auto in_e = EigenMatrix<T>::From(in_t, lite::DDim({h, w}));
-      auto out_e = EigenVector<T>::Flatten(out_t);
-      if (pooltype == "AVERAGE") {
-        out_e.device(eigen_device) = in_e.mean(Eigen::array<int, 1>({{0}}));
-      } else if (pooltype == "SQRT") {
-        out_e.device(eigen_device) = in_e.sum(Eigen::array<int, 1>({{0}})) /
-                                     std::sqrt(static_cast<T>(h));
-      } else {
-        LOG(FATAL) << "unsupported pooling pooltype";
       }
-    }
+    });
   }
 };
 
@@ -365,7 +396,7 @@ class SequencePoolGradFunctor<TARGET(kX86), T> {
 
     auto lod = in_grad->lod()[0];
 
-    auto eigen_device = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+    const auto& eigen_device = lite::fluid::GetEigenDevice<TARGET(kX86)>();
     for (int i = 0; i < static_cast<int>(lod.size()) - 1; ++i) {
       if (lod[i] == lod[i + 1]) continue;
       auto in_g_t = in_grad->Slice<float>(static_cast<int>(lod[i]),
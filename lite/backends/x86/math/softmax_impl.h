@@ -68,9 +68,9 @@ void SoftmaxEigen(const lite::Context<Target>& context,
                              .broadcast(one_by_class))
                             .unaryExpr(ValueClip<T>());
 
-  softmax.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  softmax.device(lite::fluid::GetEigenDevice<Target>()) =
       shifted_logits.exp();
-  softmax.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  softmax.device(lite::fluid::GetEigenDevice<Target>()) =
       (softmax *
        softmax.reshape(batch_axis_remain)
            .sum(along_class)
@@ -217,7 +217,7 @@ void SoftmaxGradEigen(const lite::Context<Target>& context,
                  .broadcast(one_axis);
   // logits_grad.device(*context.eigen_device()) = (softmax_grad - dot) *
   // softmax;
-  logits_grad.device(typename lite::fluid::EigenDevice<Target>::Type()) =
+  logits_grad.device(lite::fluid::GetEigenDevice<Target>()) =
       (softmax_grad - dot) * softmax;
 }
 
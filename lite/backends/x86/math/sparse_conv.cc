@@ -0,0 +1,333 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/sparse_conv.h"
+#include <algorithm>
+#include "lite/backends/x86/math/isa_dispatch.h"
+#include "lite/core/workspace.h"
+#ifdef LITE_X86_AVX
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+LITE_X86_ISA_NAMESPACE_BEGIN
+
+namespace {
+
+#ifdef LITE_X86_AVX
+using vec_t = __m256;
+constexpr int kLanes = 8;
+inline vec_t VecSet(float v) { return _mm256_set1_ps(v); }
+inline vec_t VecLoad(const float* p) { return _mm256_loadu_ps(p); }
+inline void VecStore(float* p, vec_t v) { _mm256_storeu_ps(p, v); }
+inline vec_t VecAdd(vec_t a, vec_t b) { return _mm256_add_ps(a, b); }
+inline vec_t VecMul(vec_t a, vec_t b) { return _mm256_mul_ps(a, b); }
+inline vec_t VecMax(vec_t a, vec_t b) { return _mm256_max_ps(a, b); }
+inline vec_t VecMin(vec_t a, vec_t b) { return _mm256_min_ps(a, b); }
+#ifdef LITE_X86_FMA
+inline vec_t VecFma(vec_t a, vec_t b, vec_t c) {
+  return _mm256_fmadd_ps(a, b, c);
+}
+#else
+inline vec_t VecFma(vec_t a, vec_t b, vec_t c) {
+  return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+}
+#endif
+#else
+using vec_t = __m128;
+constexpr int kLanes = 4;
+inline vec_t VecSet(float v) { return _mm_set1_ps(v); }
+inline vec_t VecLoad(const float* p) { return _mm_loadu_ps(p); }
+inline void VecStore(float* p, vec_t v) { _mm_storeu_ps(p, v); }
+inline vec_t VecAdd(vec_t a, vec_t b) { return _mm_add_ps(a, b); }
+inline vec_t VecMul(vec_t a, vec_t b) { return _mm_mul_ps(a, b); }
+inline vec_t VecMax(vec_t a, vec_t b) { return _mm_max_ps(a, b); }
+inline vec_t VecMin(vec_t a, vec_t b) { return _mm_min_ps(a, b); }
+inline vec_t VecFma(vec_t a, vec_t b, vec_t c) {
+  return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+#endif
+
+// Pixels computed per row visit: four accumulators stay in registers while
+// the nonzeros of the row are streamed once.
+constexpr int kColBlock = 4 * kLanes;
+// Output channels per parallel task, sharing one tile of activations.
+constexpr int kRowBlock = 8;
+// Below this many fc rows the transposed path does not fill a vector.
+constexpr int kFcTransposeRows = kColBlock;
+
+struct Activation {
+  explicit Activation(const operators::ActivationParam& param) {
+    if (!param.has_active) return;
+    switch (param.active_type) {
+      case lite_api::ActivationType::kRelu:
+        type = param.active_type;
+        break;
+      case lite_api::ActivationType::kRelu6:
+        type = param.active_type;
+        six = param.Relu_clipped_coef;
+        break;
+      case lite_api::ActivationType::kLeakyRelu:
+        type = param.active_type;
+        alpha = param.Leaky_relu_alpha;
+        break;
+      default:
+        LOG(FATAL) << "The x86 sparse conv only supports fusing relu, relu6 "
+                      "and leaky relu, while the given activation type is "
+                   << static_cast<int>(param.active_type);
+    }
+  }
+
+  inline vec_t operator()(vec_t v) const {
+    switch (type) {
+      case lite_api::ActivationType::kRelu:
+        return VecMax(v, VecSet(0.f));
+      case lite_api::ActivationType::kRelu6:
+        return VecMin(VecMax(v, VecSet(0.f)), VecSet(six));
+      case lite_api::ActivationType::kLeakyRelu:
+        return VecAdd(VecMax(v, VecSet(0.f)),
+                      VecMul(VecMin(v, VecSet(0.f)), VecSet(alpha)));
+      default:
+        return v;
+    }
+  }
+
+  inline float operator()(float v) const {
+    switch (type) {
+      case lite_api::ActivationType::kRelu:
+        return std::max(v, 0.f);
+      case lite_api::ActivationType::kRelu6:
+        return std::min(std::max(v, 0.f), six);
+      case lite_api::ActivationType::kLeakyRelu:
+        return v > 0.f ? v : v * alpha;
+      default:
+        return v;
+    }
+  }
+
+  lite_api::ActivationType type{lite_api::ActivationType::kIndentity};
+  float six{6.f};
+  float alpha{0.f};
+};
+
+// One output channel over kColBlock pixels starting at din/dout.
+inline void SparseRowBlock(const float* values,
+                           const int32_t* offsets,
+                           int nnz,
+                           float bias,
+                           const float* din,
+                           float* dout,
+                           const Activation& act) {
+  vec_t acc0 = VecSet(bias);
+  vec_t acc1 = acc0;
+  vec_t acc2 = acc0;
+  vec_t acc3 = acc0;
+  for (int i = 0; i < nnz; ++i) {
+    const vec_t w = VecSet(values[i]);
+    const float* x = din + offsets[i];
+    acc0 = VecFma(w, VecLoad(x), acc0);
+    acc1 = VecFma(w, VecLoad(x + kLanes), acc1);
+    acc2 = VecFma(w, VecLoad(x + 2 * kLanes), acc2);
+    acc3 = VecFma(w, VecLoad(x + 3 * kLanes), acc3);
+  }
+  VecStore(dout, act(acc0));
+  VecStore(dout + kLanes, act(acc1));
+  VecStore(dout + 2 * kLanes, act(acc2));
+  VecStore(dout + 3 * kLanes, act(acc3));
+}
+
+// One output channel over the `cols` (< kColBlock) trailing pixels.
+inline void SparseRowTail(const float* values,
+                          const int32_t* offsets,
+                          int nnz,
+                          float bias,
+                          const float* din,
+                          float* dout,
+                          int cols,
+                          const Activation& act) {
+  for (int c = 0; c < cols; ++c) {
+    float acc = bias;
+    for (int i = 0; i < nnz; ++i) {
+      acc += values[i] * din[offsets[i] + c];
+    }
+    dout[c] = act(acc);
+  }
+}
+
+void SparseConv(const float* values,
+                const int32_t* offsets,
+                const int32_t* row_ptr,
+                const float* bias,
+                const float* din,
+                float* dout,
+                int oc,
+                int im_size,
+                const Activation& act) {
+  const int col_blocks = im_size / kColBlock;
+  const int row_blocks = (oc + kRowBlock - 1) / kRowBlock;
+  const int tail_begin = col_blocks * kColBlock;
+  const int tail = im_size - tail_begin;
+  // Every task reuses the same activation tile for kRowBlock channels.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for collapse(2)
+#endif
+  for (int cb = 0; cb < col_blocks; ++cb) {
+    for (int rb = 0; rb < row_blocks; ++rb) {
+      const int col = cb * kColBlock;
+      const int row_end = std::min(oc, (rb + 1) * kRowBlock);
+      for (int r = rb * kRowBlock; r < row_end; ++r) {
+        const int begin = row_ptr[r];
+        SparseRowBlock(values + begin,
+                       offsets + begin,
+                       row_ptr[r + 1] - begin,
+                       bias ? bias[r] : 0.f,
+                       din + col,
+                       dout + r * im_size + col,
+                       act);
+      }
+    }
+  }
+  if (tail > 0) {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int r = 0; r < oc; ++r) {
+      const int begin = row_ptr[r];
+      SparseRowTail(values + begin,
+                    offsets + begin,
+                    row_ptr[r + 1] - begin,
+                    bias ? bias[r] : 0.f,
+                    din + tail_begin,
+                    dout + r * im_size + tail_begin,
+                    tail,
+                    act);
+    }
+  }
+}
+
+}  // namespace
+
+void sparse_conv_fp32(const float* values,
+                      const int32_t* offsets,
+                      const int32_t* row_ptr,
+                      const float* bias,
+                      const float* din,
+                      float* dout,
+                      int oc,
+                      int im_size,
+                      const operators::ActivationParam& act_param) {
+  LITE_X86_DISPATCH_AVX2(sparse_conv_fp32,
+                         values,
+                         offsets,
+                         row_ptr,
+                         bias,
+                         din,
+                         dout,
+                         oc,
+                         im_size,
+                         act_param);
+  SparseConv(values,
+             offsets,
+             row_ptr,
+             bias,
+             din,
+             dout,
+             oc,
+             im_size,
+             Activation(act_param));
+}
+
+void sparse_fc_fp32(const float* values,
+                    const int32_t* columns,
+                    const int32_t* row_ptr,
+                    const float* bias,
+                    const float* x,
+                    float* y,
+                    int m,
+                    int n,
+                    int k,
+                    const operators::ActivationParam& act_param) {
+  LITE_X86_DISPATCH_AVX2(sparse_fc_fp32,
+                         values,
+                         columns,
+                         row_ptr,
+                         bias,
+                         x,
+                         y,
+                         m,
+                         n,
+                         k,
+                         act_param);
+  const Activation act(act_param);
+  if (m < kFcTransposeRows) {
+    // Too few rows to vectorize over, walk the nonzeros of every column.
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+    for (int j = 0; j < n; ++j) {
+      const int begin = row_ptr[j];
+      const int end = row_ptr[j + 1];
+      for (int i = 0; i < m; ++i) {
+        const float* x_row = x + i * k;
+        float acc = bias ? bias[j] : 0.f;
+        for (int e = begin; e < end; ++e) {
+          acc += values[e] * x_row[columns[e]];
+        }
+        y[i * n + j] = act(acc);
+      }
+    }
+    return;
+  }
+
+  // y^T = W^T x^T is a sparse 1x1 conv over `m` pixels, so transpose x into
+  // [k, m], run the conv kernel and transpose the result back.
+  const int nnz = row_ptr[n];
+  auto* x_t = reinterpret_cast<float*>(WorkSpace::Global_X86().Alloc(
+      (static_cast<size_t>(k) * m + static_cast<size_t>(n) * m) *
+          sizeof(float) +
+      nnz * sizeof(int32_t)));
+  float* y_t = x_t + static_cast<size_t>(k) * m;
+  auto* offsets = reinterpret_cast<int32_t*>(y_t + static_cast<size_t>(n) * m);
+  for (int e = 0; e < nnz; ++e) {
+    offsets[e] = columns[e] * m;
+  }
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int c = 0; c < k; ++c) {
+    for (int i = 0; i < m; ++i) {
+      x_t[c * m + i] = x[i * k + c];
+    }
+  }
+  SparseConv(values, offsets, row_ptr, bias, x_t, y_t, n, m, act);
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for
+#endif
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      y[i * n + j] = y_t[j * m + i];
+    }
+  }
+}
+
+LITE_X86_ISA_NAMESPACE_END
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,84 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace x86 {
+namespace math {
+
+// The sparse weights are kept in compressed sparse row form: row `r` owns the
+// entries [row_ptr[r], row_ptr[r + 1]) of `values` and of the column array.
+
+// dout[r][p] = act(bias[r] + sum_k values[k] * din[offsets[k] + p]) for the
+// `oc` output channels of a 1x1 conv over `im_size` pixels. `offsets` hold
+// the input channel of every entry multiplied by `im_size`, so the kernel
+// streams whole activation rows and never gathers.
+void sparse_conv_fp32(const float* values,
+                      const int32_t* offsets,
+                      const int32_t* row_ptr,
+                      const float* bias,
+                      const float* din,
+                      float* dout,
+                      int oc,
+                      int im_size,
+                      const operators::ActivationParam& act_param);
+
+// y[m][n] = act(bias[n] + sum_k values[k] * x[m][columns[k]]) for a fc
+// layer of `m` rows, with one sparse row per output column `n`.
+void sparse_fc_fp32(const float* values,
+                    const int32_t* columns,
+                    const int32_t* row_ptr,
+                    const float* bias,
+                    const float* x,
+                    float* y,
+                    int m,
+                    int n,
+                    int k,
+                    const operators::ActivationParam& act_param);
+
+#ifdef LITE_WITH_X86_DISPATCH
+// AVX2 copies of the kernels above, see isa_dispatch.h.
+namespace avx2 {
+void sparse_conv_fp32(const float* values,
+                      const int32_t* offsets,
+                      const int32_t* row_ptr,
+                      const float* bias,
+                      const float* din,
+                      float* dout,
+                      int oc,
+                      int im_size,
+                      const operators::ActivationParam& act_param);
+
+void sparse_fc_fp32(const float* values,
+                    const int32_t* columns,
+                    const int32_t* row_ptr,
+                    const float* bias,
+                    const float* x,
+                    float* y,
+                    int m,
+                    int n,
+                    int k,
+                    const operators::ActivationParam& act_param);
+}  // namespace avx2
+#endif
+
+}  // namespace math
+}  // namespace x86
+}  // namespace lite
+}  // namespace paddle
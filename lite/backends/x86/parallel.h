@@ -45,12 +45,13 @@ static inline int64_t GetMaxThreads() {
   return (std::max<int>)(num_threads, 1L);
 }
 
-using ThreadHandler =
-    std::function<void(const int64_t begin, const int64_t end)>;
-
+// `f` is called as f(begin, end) on each chunk. It is taken as a template
+// argument rather than a std::function, which would allocate for lambdas
+// with more than two captures on every call.
+template <typename Func>
 static inline void RunParallelFor(const int64_t begin,
                                   const int64_t end,
-                                  const ThreadHandler& f) {
+                                  const Func& f) {
   if (begin >= end) {
     return;
   }
@@ -0,0 +1,175 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/calibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace paddle {
+namespace lite {
+
+const std::map<std::string, Calibrator::QuantizableOp>&
+Calibrator::quantizable_ops() {
+  static const std::map<std::string, QuantizableOp> ops = {
+      {"conv2d", {"Input", "Filter", "Output", 0}},
+      {"depthwise_conv2d", {"Input", "Filter", "Output", 0}},
+      {"conv2d_transpose", {"Input", "Filter", "Output", 1}},
+      {"fc", {"Input", "W", "Out", 1}},
+      {"mul", {"X", "Y", "Out", 1}}};
+  return ops;
+}
+
+void Calibrator::Collect(const OpLite* op, Scope* scope) {
+  auto& ops = quantizable_ops();
+  auto* op_info = op->op_info();
+  auto iter = ops.find(op_info->Type());
+  if (iter == ops.end() || !op_info->HasInput(iter->second.activation)) {
+    return;
+  }
+  for (auto& name : op_info->Input(iter->second.activation)) {
+    auto* var = scope->FindVar(name);
+    if (!var || !var->IsType<Tensor>()) continue;
+    auto& tensor = var->Get<Tensor>();
+    if (tensor.persistable() || tensor.precision() != PRECISION(kFloat) ||
+        !(tensor.target() == TARGET(kHost) ||
+          tensor.target() == TARGET(kARM) ||
+          tensor.target() == TARGET(kX86))) {
+      continue;
+    }
+    Update(tensor, &histograms_[name]);
+  }
+}
+
+void Calibrator::Update(const Tensor& tensor, Histogram* hist) {
+  const float* data = tensor.data<float>();
+  const int64_t size = tensor.numel();
+  float abs_max = 0.f;
+  for (int64_t i = 0; i < size; i++) {
+    abs_max = std::max(abs_max, std::fabs(data[i]));
+  }
+  hist->abs_max = std::max(hist->abs_max, abs_max);
+  if (abs_max == 0.f) return;
+  if (hist->bins.empty()) {
+    hist->bins.resize(kHistogramBins, 0);
+    hist->range = abs_max;
+  }
+  while (hist->range < abs_max) {
+    for (int i = 0; i < kHistogramBins / 2; i++) {
+      hist->bins[i] = hist->bins[2 * i] + hist->bins[2 * i + 1];
+    }
+    std::fill(hist->bins.begin() + kHistogramBins / 2, hist->bins.end(), 0);
+    hist->range *= 2.f;
+  }
+  const float factor = kHistogramBins / hist->range;
+  auto* bins = hist->bins.data();
+  for (int64_t i = 0; i < size; i++) {
+    int idx = static_cast<int>(std::fabs(data[i]) * factor);
+    bins[std::min(idx, kHistogramBins - 1)]++;
+  }
+}
+
+// Search the threshold which minimizes the KL divergence between the
+// reference distribution clipped at the threshold and its 128-level
+// quantized expansion.
+float Calibrator::KLThreshold(const Histogram& hist) const {
+  constexpr int kLevels = 128;
+  const auto& bins = hist.bins;
+  std::vector<double> p(kHistogramBins);
+  std::vector<double> q(kHistogramBins);
+  double min_kl = std::numeric_limits<double>::max();
+  int best = kHistogramBins;
+  uint64_t outliers = 0;
+  for (int i = kLevels; i < kHistogramBins; i++) outliers += bins[i];
+  for (int i = kLevels; i <= kHistogramBins; i++) {
+    for (int j = 0; j < i; j++) p[j] = bins[j];
+    p[i - 1] += outliers;
+    if (i < kHistogramBins) outliers -= bins[i];
+    std::fill(q.begin(), q.begin() + i, 0.);
+    for (int level = 0; level < kLevels; level++) {
+      int start = level * i / kLevels;
+      int end = (level + 1) * i / kLevels;
+      double sum = 0.;
+      int nonzeros = 0;
+      for (int j = start; j < end; j++) {
+        sum += bins[j];
+        nonzeros += bins[j] != 0;
+      }
+      if (nonzeros == 0) continue;
+      for (int j = start; j < end; j++) {
+        if (bins[j] != 0) q[j] = sum / nonzeros;
+      }
+    }
+    double p_sum = 0.;
+    double q_sum = 0.;
+    for (int j = 0; j < i; j++) {
+      p_sum += p[j];
+      q_sum += q[j];
+    }
+    if (p_sum == 0. || q_sum == 0.) continue;
+    double kl = 0.;
+    for (int j = 0; j < i; j++) {
+      if (p[j] == 0.) continue;
+      double pj = p[j] / p_sum;
+      double qj = q[j] == 0. ? 1e-10 : q[j] / q_sum;
+      kl += pj * std::log(pj / qj);
+    }
+    if (kl < min_kl) {
+      min_kl = kl;
+      best = i;
+    }
+  }
+  return std::min(hist.abs_max, (best + 0.5f) * hist.range / kHistogramBins);
+}
+
+float Calibrator::PercentileThreshold(const Histogram& hist) const {
+  uint64_t total = 0;
+  for (auto count : hist.bins) total += count;
+  const double target = total * static_cast<double>(percentile_);
+  uint64_t sum = 0;
+  for (int i = 0; i < kHistogramBins; i++) {
+    sum += hist.bins[i];
+    if (sum >= target) {
+      return std::min(hist.abs_max, (i + 1) * hist.range / kHistogramBins);
+    }
+  }
+  return hist.abs_max;
+}
+
+std::map<std::string, float> Calibrator::ComputeThresholds() const {
+  std::map<std::string, float> thresholds;
+  for (auto& item : histograms_) {
+    auto& hist = item.second;
+    if (hist.abs_max == 0.f) continue;
+    float threshold = hist.abs_max;
+    switch (method_) {
+      case lite_api::CalibrationMethod::CALIB_KL:
+        threshold = KLThreshold(hist);
+        break;
+      case lite_api::CalibrationMethod::CALIB_PERCENTILE:
+        threshold = PercentileThreshold(hist);
+        break;
+      default:
+        break;
+    }
+    VLOG(4) << "threshold of " << item.first << ": " << threshold
+            << ", abs_max: " << hist.abs_max;
+    thresholds[item.first] = threshold;
+  }
+  return thresholds;
+}
+
+}  // namespace lite
+}  // namespace paddle
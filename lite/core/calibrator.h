@@ -0,0 +1,84 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_place.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/scope.h"
+#include "lite/core/tensor.h"
+
+namespace paddle {
+namespace lite {
+
+/*
+ * Calibrator collects the statistics of the activations which are consumed by
+ * the quantizable ops while the fp32 program runs the representative inputs,
+ * and computes the int8 thresholds of them with abs_max, KL or percentile.
+ * The thresholds are keyed by the variable names, and are used by
+ * post_quant_static_pass to quantize the model.
+ */
+class Calibrator {
+ public:
+  // The argument names of the activation, the weight and the output of a
+  // quantizable op, and the axis of the weight which is quantized
+  // channel-wise.
+  struct QuantizableOp {
+    std::string activation;
+    std::string weight;
+    std::string output;
+    int quant_axis;
+  };
+  static const std::map<std::string, QuantizableOp>& quantizable_ops();
+
+  static constexpr int kHistogramBins = 2048;
+
+  Calibrator(lite_api::CalibrationMethod method, float percentile)
+      : method_(method), percentile_(percentile) {}
+
+  // Update the statistics of the activation consumed by `op`, it's called
+  // after the op has run, before the tensor may be reused by other ops.
+  void Collect(const OpLite* op, Scope* scope);
+
+  // Return the thresholds of all of the collected activations, the threshold
+  // of a variable is the magnitude which is mapped to the largest int8 value.
+  std::map<std::string, float> ComputeThresholds() const;
+
+  int64_t num_batches() const { return num_batches_; }
+  void IncreaseBatch() { num_batches_++; }
+
+ private:
+  // The histogram of the magnitudes in [0, range), the range grows by
+  // doubling, so the bins are merged in pairs and never re-scanned.
+  struct Histogram {
+    float abs_max{0.f};
+    float range{0.f};
+    std::vector<uint64_t> bins;
+  };
+
+  void Update(const Tensor& tensor, Histogram* hist);
+  float KLThreshold(const Histogram& hist) const;
+  float PercentileThreshold(const Histogram& hist) const;
+
+  lite_api::CalibrationMethod method_;
+  float percentile_;
+  int64_t num_batches_{0};
+  std::map<std::string, Histogram> histograms_;
+};
+
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,114 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/calibrator.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+
+class CalibratorTestOp : public OpLite {
+ public:
+  explicit CalibratorTestOp(const std::string& type) : OpLite(type) {}
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override {
+    return true;
+  }
+  void AttachKernel(KernelBase* kernel) override {}
+  std::string DebugString() const override { return "calibrator_test"; }
+};
+
+// Feed `batches` batches of the normal distribution into a conv2d, the input
+// range grows from batch to batch.
+std::map<std::string, float> Calibrate(lite_api::CalibrationMethod method,
+                                       float percentile,
+                                       int batches) {
+  Scope scope;
+  auto* x = scope.Var("x")->GetMutable<Tensor>();
+  x->Resize({1, 4, 32, 32});
+  cpp::OpDesc desc;
+  desc.SetType("conv2d");
+  desc.SetInput("Input", {"x"});
+  desc.SetInput("Filter", {"w"});
+  desc.SetOutput("Output", {"y"});
+  CalibratorTestOp op("conv2d");
+  op.Attach(desc, &scope);
+
+  Calibrator calibrator(method, percentile);
+  std::mt19937 rng(0);
+  for (int i = 0; i < batches; i++) {
+    std::normal_distribution<float> dist(0.f, 1.f + i);
+    auto* data = x->mutable_data<float>();
+    for (int j = 0; j < x->numel(); j++) data[j] = dist(rng);
+    calibrator.Collect(&op, &scope);
+    calibrator.IncreaseBatch();
+  }
+  EXPECT_EQ(calibrator.num_batches(), batches);
+  return calibrator.ComputeThresholds();
+}
+
+TEST(Calibrator, abs_max) {
+  auto thresholds =
+      Calibrate(lite_api::CalibrationMethod::CALIB_ABS_MAX, 1.f, 4);
+  ASSERT_EQ(thresholds.size(), 1u);
+  // 4096 samples of N(0, 4^2) in the last batch.
+  EXPECT_GT(thresholds["x"], 4.f * 3.f);
+  EXPECT_LT(thresholds["x"], 4.f * 5.f);
+}
+
+TEST(Calibrator, percentile) {
+  auto abs_max =
+      Calibrate(lite_api::CalibrationMethod::CALIB_ABS_MAX, 1.f, 4)["x"];
+  auto thresholds =
+      Calibrate(lite_api::CalibrationMethod::CALIB_PERCENTILE, 0.99f, 4);
+  // 99% of the magnitudes of the mixed normal distributions.
+  EXPECT_GT(thresholds["x"], 4.f);
+  EXPECT_LT(thresholds["x"], 4.f * 2.8f);
+  EXPECT_LT(thresholds["x"], abs_max);
+}
+
+TEST(Calibrator, kl) {
+  auto abs_max =
+      Calibrate(lite_api::CalibrationMethod::CALIB_ABS_MAX, 1.f, 4)["x"];
+  auto thresholds = Calibrate(lite_api::CalibrationMethod::CALIB_KL, 1.f, 4);
+  EXPECT_GT(thresholds["x"], 0.f);
+  EXPECT_LE(thresholds["x"], abs_max);
+}
+
+TEST(Calibrator, skip_weights) {
+  Scope scope;
+  auto* w = scope.Var("w")->GetMutable<Tensor>();
+  w->Resize({4, 4});
+  w->mutable_data<float>()[0] = 1.f;
+  w->set_persistable(true);
+  cpp::OpDesc desc;
+  desc.SetType("mul");
+  desc.SetInput("X", {"w"});
+  desc.SetInput("Y", {"w"});
+  desc.SetOutput("Out", {"y"});
+  CalibratorTestOp op("mul");
+  op.Attach(desc, &scope);
+
+  Calibrator calibrator(lite_api::CalibrationMethod::CALIB_ABS_MAX, 1.f);
+  calibrator.Collect(&op, &scope);
+  EXPECT_TRUE(calibrator.ComputeThresholds().empty());
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -436,6 +436,10 @@ class Context<TargetType::kARM> {
   int llc_size() const { return DeviceInfo::Global().llc_size(); }
   bool has_dot() const { return DeviceInfo::Global().has_dot(); }
   bool has_fp16() const { return DeviceInfo::Global().has_fp16(); }
+  bool has_i8mm() const { return DeviceInfo::Global().has_i8mm(); }
+  bool has_bf16() const { return DeviceInfo::Global().has_bf16(); }
+  bool has_sve() const { return DeviceInfo::Global().has_sve(); }
+  bool has_sve2() const { return DeviceInfo::Global().has_sve2(); }
   bool has_a53_valid() const { return DeviceInfo::Global().set_a53_valid(); }
 
   template <typename T>
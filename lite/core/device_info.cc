@@ -48,6 +48,9 @@
 #ifdef LITE_WITH_LINUX
 #include <sys/syscall.h>
 #include <unistd.h>
+#ifdef __aarch64__
+#include <sys/auxv.h>
+#endif
 #endif
 #ifdef LITE_WITH_ANDROID
 #include <sys/system_properties.h>
@@ -914,6 +917,29 @@ void DeviceInfo::SetCPUInfoByProb() {
 #endif  // LITE_WITH_LINUX
 }
 
+void DeviceInfo::SetCPUInfoByHwcap() {
+#if defined(LITE_WITH_LINUX) && defined(__aarch64__)
+  // Bits of the arm64 hwcaps, older libc headers do not define them all.
+  const uint64_t kHwcapAsimdDp = 1UL << 20;
+  const uint64_t kHwcapSve = 1UL << 22;
+  const uint64_t kHwcap2Sve2 = 1UL << 1;
+  const uint64_t kHwcap2I8mm = 1UL << 13;
+  const uint64_t kHwcap2Bf16 = 1UL << 14;
+  uint64_t hwcap = getauxval(AT_HWCAP);
+  // Server cores are missing from the name tables, trust the kernel for them.
+  if (hwcap & kHwcapAsimdDp) {
+    SetDotInfo(1, 1);
+  }
+  sve_ = (hwcap & kHwcapSve) != 0;
+#ifdef AT_HWCAP2
+  uint64_t hwcap2 = getauxval(AT_HWCAP2);
+  sve2_ = sve_ && (hwcap2 & kHwcap2Sve2) != 0;
+  i8mm_ = (hwcap2 & kHwcap2I8mm) != 0;
+  bf16_ = (hwcap2 & kHwcap2Bf16) != 0;
+#endif
+#endif
+}
+
 void DeviceInfo::RequestPowerFullMode(int thread_num) {
   int big_core_size = big_core_ids_.size();
   int little_core_size = little_core_ids_.size();
@@ -1090,6 +1116,7 @@ int DeviceInfo::Setup() {
   if (!SetCPUInfoByName()) {
     SetCPUInfoByProb();
   }
+  SetCPUInfoByHwcap();
 #else
 #ifdef TARGET_IOS
   dev_name_ = "Apple";
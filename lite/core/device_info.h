@@ -122,6 +122,36 @@ class DeviceInfo {
 #endif
   }
   bool has_fp16() const { return fp16_[active_ids_[0]]; }
+  // ARMv8.6 matrix multiply extensions, reported by the kernel for all cores.
+  inline bool has_i8mm() const {
+#ifdef WITH_ARM_MMLA
+    return i8mm_;
+#else
+    return false;
+#endif
+  }
+  inline bool has_bf16() const {
+#ifdef WITH_ARM_MMLA
+    return bf16_;
+#else
+    return false;
+#endif
+  }
+  // Scalable vector extensions, the vector length is read at run time.
+  inline bool has_sve() const {
+#ifdef LITE_WITH_ARM_SVE
+    return sve_;
+#else
+    return false;
+#endif
+  }
+  inline bool has_sve2() const {
+#ifdef LITE_WITH_ARM_SVE
+    return sve2_;
+#else
+    return false;
+#endif
+  }
 
   template <typename T>
   T* workspace_data() {
@@ -146,6 +176,10 @@ class DeviceInfo {
   std::vector<bool> fp32_;
   std::vector<bool> fp16_;
   std::vector<bool> dot_;
+  bool i8mm_{false};
+  bool bf16_{false};
+  bool sve_{false};
+  bool sve2_{false};
   bool has_a53_valid_;
 
   // LITE_POWER_HIGH stands for using big cores,
@@ -165,6 +199,7 @@ class DeviceInfo {
   void SetArchInfo(int argc, ...);
   bool SetCPUInfoByName();
   void SetCPUInfoByProb();
+  void SetCPUInfoByHwcap();
   void RequestPowerFullMode(int thread_num);
   void RequestPowerHighMode(int thread_num);
   void RequestPowerLowMode(int thread_num);
@@ -19,35 +19,37 @@ namespace paddle {
 namespace lite {
 using value_type = int64_t;
 
+constexpr size_t DDimLite::kInlineRank;
+
 value_type DDimLite::production() const {
   value_type res = 1;
-  for (size_t i = 0; i < data_.size(); i++) {
-    res *= data_[i];
+  const value_type *dims = ptr();
+  for (size_t i = 0; i < size_; i++) {
+    res *= dims[i];
   }
   return res;
 }
 
 value_type DDimLite::count(int start, int end) const {
   start = std::max(start, 0);
-  end = std::min(end, static_cast<int>(data_.size()));
+  end = std::min(end, static_cast<int>(size_));
   if (end < start) {
     return 0;
   }
+  const value_type *dims = ptr();
   value_type sum = 1;
   for (auto i = start; i < end; ++i) {
-    sum *= data_[i];
+    sum *= dims[i];
   }
   return sum;
 }
 
 DDimLite DDimLite::Slice(int start, int end) const {
   start = std::max(start, 0);
-  end = std::min(end, static_cast<int>(data_.size()));
-  std::vector<value_type> new_dim(end - start);
-  for (int i = start; i < end; i++) {
-    new_dim[i - start] = data_[i];
-  }
-  return DDim(new_dim);
+  end = std::min(end, static_cast<int>(size_));
+  DDimLite res;
+  if (end > start) res.ConstructFrom(ptr() + start, end - start);
+  return res;
 }
 
 std::string DDimLite::repr() const {
@@ -31,31 +31,83 @@ class DDimLite {
  public:
   using value_type = int64_t;
 
+  // Ranks up to kInlineRank are stored inside the object, so copying dims in
+  // InferShape, Resize and the frozen launch path never touches the heap.
+  static constexpr size_t kInlineRank = 8;
+
+  // Read-only view returned by data(). It converts to std::vector for the
+  // callers that need an owning copy.
+  class ConstView {
+   public:
+    ConstView(const value_type *data, size_t size) : data_(data), size_(size) {}
+
+    const value_type *begin() const { return data_; }
+    const value_type *end() const { return data_ + size_; }
+    const value_type *data() const { return data_; }
+    const value_type &operator[](size_t offset) const { return data_[offset]; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    operator std::vector<value_type>() const {  // NOLINT
+      return std::vector<value_type>(begin(), end());
+    }
+
+    friend bool operator==(const ConstView &a, const ConstView &b) {
+      return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const ConstView &a, const ConstView &b) {
+      return !(a == b);
+    }
+
+   private:
+    const value_type *data_;
+    size_t size_;
+  };
+
   DDimLite() = default;
 
   explicit DDimLite(const std::vector<value_type> &x) { ConstructFrom(x); }
   // DDimLite(std::initializer_list<value_type> init_list) :
   // DDimLite(std::vector<value_type>(init_list)) {}
 
-  void ConstructFrom(const std::vector<value_type> &x) { data_ = x; }
+  DDimLite(const DDimLite &other) { ConstructFrom(other.ptr(), other.size()); }
+  DDimLite &operator=(const DDimLite &other) {
+    if (this != &other) ConstructFrom(other.ptr(), other.size());
+    return *this;
+  }
 
-  value_type operator[](int offset) const { return data_[offset]; }
-  value_type &operator[](int offset) { return data_[offset]; }
-  std::vector<int64_t> Vectorize() const { return data_; }
+  void ConstructFrom(const std::vector<value_type> &x) {
+    ConstructFrom(x.data(), x.size());
+  }
+  void ConstructFrom(const value_type *x, size_t size) {
+    if (size > kInlineRank) {
+      heap_.assign(x, x + size);
+    } else {
+      std::copy(x, x + size, inline_);
+    }
+    size_ = size;
+  }
 
-  size_t size() const { return data_.size(); }
-  bool empty() const { return data_.empty(); }
+  value_type operator[](int offset) const { return ptr()[offset]; }
+  value_type &operator[](int offset) { return ptr()[offset]; }
+  std::vector<int64_t> Vectorize() const { return data(); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
 
   value_type production() const;
 
-  const std::vector<value_type> &data() const { return data_; }
+  ConstView data() const { return ConstView(ptr(), size_); }
   value_type count(int start, int end) const;
 
   DDimLite Slice(int start, int end) const;
 
   DDimLite Flatten2D(int col) const {
-    return DDimLite(std::vector<value_type>(
-        {Slice(0, col).production(), Slice(col, size()).production()}));
+    const value_type dims[2] = {Slice(0, col).production(),
+                                Slice(col, size()).production()};
+    DDimLite res;
+    res.ConstructFrom(dims, 2);
+    return res;
   }
 
   std::string repr() const;
@@ -82,7 +134,15 @@ class DDimLite {
   }
 
  private:
-  std::vector<value_type> data_;
+  const value_type *ptr() const {
+    return size_ > kInlineRank ? heap_.data() : inline_;
+  }
+  value_type *ptr() { return size_ > kInlineRank ? heap_.data() : inline_; }
+
+  value_type inline_[kInlineRank];
+  // only used for ranks above kInlineRank
+  std::vector<value_type> heap_;
+  size_t size_{0};
 };
 
 using DDim = paddle::lite::DDimLite;
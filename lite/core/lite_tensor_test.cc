@@ -58,5 +58,34 @@ TEST(tensor, shared_memory) {
 #endif
 }
 
+TEST(tensor, buffer_view) {
+  TensorLite parent;
+  parent.Resize({6});
+  float* parent_data = parent.mutable_data<float>();
+
+  TensorLite view;
+  view.Resize({4});
+  view.ShareBufferWith(parent, 2 * sizeof(float), 4 * sizeof(float));
+  EXPECT_TRUE(view.IsViewOf(parent));
+  float* view_data = view.mutable_data<float>();
+  EXPECT_EQ(view_data, parent_data + 2);
+  for (int i = 0; i < 4; ++i) {
+    view_data[i] = static_cast<float>(i);
+  }
+  EXPECT_EQ(parent_data[5], 3.f);
+
+  // A view that no longer fits its slice gets a buffer of its own.
+  view.Resize({5});
+  EXPECT_NE(view.mutable_data<float>(), parent_data + 2);
+  EXPECT_FALSE(view.IsViewOf(parent));
+
+  view.Resize({4});
+  view.ShareBufferWith(parent, 2 * sizeof(float), 4 * sizeof(float));
+  view.DetachView();
+  EXPECT_FALSE(view.IsViewOf(parent));
+  EXPECT_EQ(std::memcmp(view.data<float>(), parent_data + 2, 4 * sizeof(float)),
+            0);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -14,6 +14,8 @@
 
 #include "lite/core/memory.h"
 #include <gtest/gtest.h>
+#include <cstring>
+#include "lite/backends/host/memory_policy.h"
 
 namespace paddle {
 namespace lite {
@@ -36,5 +38,33 @@ TEST(memory, test) {
 #endif
 }
 
+TEST(memory, policy) {
+  // The policy falls back to the usual allocation where it is not supported,
+  // e.g. without reserved huge pages or on a single node.
+  const size_t size = 5 * 1024 * 1024 + 3;
+  for (auto mode : {lite_api::LITE_HUGE_PAGE_NONE,
+                    lite_api::LITE_HUGE_PAGE_TRANSPARENT,
+                    lite_api::LITE_HUGE_PAGE_EXPLICIT}) {
+    for (auto policy : {lite_api::LITE_NUMA_NONE,
+                        lite_api::LITE_NUMA_LOCAL,
+                        lite_api::LITE_NUMA_INTERLEAVE}) {
+      host::SetHugePageMode(mode);
+      host::SetNumaPolicy(policy);
+      for (size_t bytes : {size_t{10}, size}) {
+        auto* buf = static_cast<char*>(TargetMalloc(TARGET(kHost), bytes));
+        ASSERT_TRUE(buf);
+        EXPECT_EQ(reinterpret_cast<size_t>(buf) % 64, 0u);
+        std::memset(buf, 1, bytes);
+        EXPECT_EQ(buf[bytes - 1], 1);
+        TargetFree(TARGET(kHost), buf);
+      }
+    }
+  }
+  host::SetHugePageMode(lite_api::LITE_HUGE_PAGE_NONE);
+  host::SetNumaPolicy(lite_api::LITE_NUMA_NONE);
+  EXPECT_GE(host::NumaNodeCount(), 1);
+  EXPECT_GE(host::CurrentNumaNode(), 0);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -13,6 +13,14 @@
 // limitations under the License.
 
 #include "lite/core/model/base/io.h"
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <cstdio>
+#include "lite/utils/string.h"
 
 namespace paddle {
 namespace lite {
@@ -69,6 +77,68 @@ void StringBufferReader::Read(void* dst, size_t size) const {
   cur_ += size;
 }
 
+#if !defined(_WIN32)
+namespace {
+// A read-only file mapping, unmapped with the last tensor using it.
+class MappedBuffer : public lite::Buffer {
+ public:
+  MappedBuffer(void* data, TargetType target, size_t size)
+      : lite::Buffer(data, target, size) {}
+  ~MappedBuffer() override { munmap(data(), space()); }
+};
+}  // namespace
+#endif
+
+bool MapTensorToFile(const std::string& path, lite::Tensor* tensor) {
+  CHECK(tensor);
+  const size_t size = tensor->memory_size();
+  if (size == 0) {
+    return false;
+  }
+#if defined(_WIN32)
+  LOG(WARNING) << "Mapping tensors to files is not supported on Windows.";
+  return false;
+#else
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) != size) {
+    // Write a temporary file and rename it, so that a concurrent process
+    // never maps a partially written file.
+    const std::string tmp_path =
+        path + ".tmp" + paddle::lite::to_string(static_cast<int>(getpid()));
+    FILE* file = fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+      LOG(WARNING) << "Unable to create file: " << tmp_path;
+      return false;
+    }
+    bool written = fwrite(tensor->raw_data(), 1, size, file) == size;
+    written = fclose(file) == 0 && written;
+    if (!written || rename(tmp_path.c_str(), path.c_str()) != 0) {
+      unlink(tmp_path.c_str());
+      LOG(WARNING) << "Failed to write " << size << " bytes to: " << path;
+      return false;
+    }
+  }
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(WARNING) << "Unable to open file: " << path;
+    return false;
+  }
+  void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG(WARNING) << "Failed to map " << size << " bytes of: " << path;
+    return false;
+  }
+  // Embedding lookups touch the rows in random order, so readahead only
+  // pulls in pages which are not needed.
+  madvise(data, size, MADV_RANDOM);
+  tensor->ResetBuffer(
+      std::make_shared<MappedBuffer>(data, tensor->target(), size), size);
+  return true;
+#endif
+}
+
 }  // namespace model_parser
 }  // namespace lite
 }  // namespace paddle
@@ -18,6 +18,7 @@
 #include <string>
 #include <utility>
 #include "lite/core/memory.h"
+#include "lite/core/tensor.h"
 
 // Use the no_sanitize attribute on a function or a global variable declaration
 // to specify that a particular instrumentation or set of instrumentations
@@ -198,6 +199,12 @@ class StringBufferReader : public ByteReader {
   mutable size_t cur_{0};
 };
 
+// Moves the data of a host tensor into a read-only shared mapping of the
+// file `path`, so that all the processes mapping the same file share its
+// pages. The file is written first if it does not exist yet. Returns false
+// when the tensor can not be mapped, and the tensor keeps its own memory.
+bool MapTensorToFile(const std::string& path, lite::Tensor* tensor);
+
 }  // namespace model_parser
 }  // namespace lite
 }  // namespace paddle
@@ -0,0 +1,143 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/concat_split_view_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+bool ConcatSplitViewPass::IsOutermostAxis(Node* node,
+                                          const std::string& var_name) const {
+  auto& stmt = node->AsStmt();
+  const auto* op_info = stmt.op_info();
+  // The axis is only known at runtime.
+  if (op_info->HasInput("AxisTensor") &&
+      !op_info->Input("AxisTensor").empty()) {
+    return false;
+  }
+  // The scope tensors are resized to the shapes of the var descs, in which
+  // unknown dims are -1. Those are left to the kernels, which check the
+  // runtime shapes.
+  const auto* tensor = stmt.op()->scope()->FindTensor(var_name);
+  if (!tensor) return false;
+  const auto& dims = tensor->dims();
+  const int rank = static_cast<int>(dims.size());
+  int axis = op_info->GetAttr<int>("axis");
+  if (axis < 0) axis += rank;
+  if (axis < 0 || axis >= rank) return false;
+  for (int i = 0; i < axis; ++i) {
+    if (dims[i] != 1 && dims[i] != -1) return false;
+  }
+  return true;
+}
+
+bool ConcatSplitViewPass::IsConcatViewable(Node* node) const {
+  auto& stmt = node->AsStmt();
+  if (stmt.picked_kernel().target() != TARGET(kX86)) return false;
+  const auto& x_names = stmt.op_info()->Input("X");
+  if (x_names.size() < 2) return false;
+  if (!IsOutermostAxis(node, stmt.op_info()->Output("Out").front())) {
+    return false;
+  }
+  std::set<std::string> unique_names(x_names.begin(), x_names.end());
+  if (unique_names.size() != x_names.size()) return false;
+
+  for (auto* in : node->inlinks) {
+    auto& arg = in->AsArg();
+    if (!unique_names.count(arg.name)) continue;
+    if (arg.is_weight || arg.is_persist) return false;
+    if (in->inlinks.size() != 1 || in->outlinks.size() != 1) return false;
+    auto* producer = in->inlinks.front();
+    if (!producer->IsStmt()) return false;
+    if (buffer_sharing_ops_.count(producer->AsStmt().op_type())) return false;
+    if (!IsWrittenOnSameTarget(producer, node, arg.name)) return false;
+    auto* producer_info = producer->AsStmt().op_info();
+    if (producer_info->HasAttr("inplace") &&
+        producer_info->GetAttr<bool>("inplace")) {
+      return false;
+    }
+  }
+  for (auto* out : node->outlinks) {
+    if (out->AsArg().is_weight || out->AsArg().is_persist) return false;
+  }
+  return true;
+}
+
+bool ConcatSplitViewPass::IsWrittenOnSameTarget(
+    Node* producer, Node* consumer, const std::string& var_name) const {
+  auto& producer_stmt = producer->AsStmt();
+  auto& consumer_stmt = consumer->AsStmt();
+  std::string out_arg_name;
+  std::string in_arg_name;
+  if (!producer_stmt.op_info()->GetOutputArgname(var_name, &out_arg_name) ||
+      !consumer_stmt.op_info()->GetInputArgname(var_name, &in_arg_name)) {
+    return false;
+  }
+  const auto* out_type =
+      producer_stmt.picked_kernel().GetOutputDeclType(out_arg_name);
+  const auto* in_type =
+      consumer_stmt.picked_kernel().GetInputDeclType(in_arg_name);
+  return out_type->target() == in_type->target();
+}
+
+bool ConcatSplitViewPass::IsSplitViewable(Node* node) const {
+  auto& stmt = node->AsStmt();
+  if (stmt.picked_kernel().target() != TARGET(kHost)) return false;
+  if (!IsOutermostAxis(node, stmt.op_info()->Input("X").front())) {
+    return false;
+  }
+  for (auto* out : node->outlinks) {
+    if (out->AsArg().is_weight || out->AsArg().is_persist) return false;
+  }
+  return true;
+}
+
+void ConcatSplitViewPass::MarkViewable(Node* node) const {
+  auto& stmt = node->AsStmt();
+  auto op = stmt.op();
+  cpp::OpDesc* op_desc = op->mutable_op_info();
+  op_desc->SetAttr<bool>("use_buffer_view", true);
+  op->Attach(*op_desc, op->scope());
+  op->AttachKernel(&(stmt.picked_kernel()));
+}
+
+void ConcatSplitViewPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  std::vector<Node*> nodes;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    const std::string op_type = node->AsStmt().op_type();
+    if ((op_type == "concat" && IsConcatViewable(node)) ||
+        (op_type == "split" && IsSplitViewable(node))) {
+      nodes.push_back(node);
+    }
+  }
+  for (auto* node : nodes) {
+    VLOG(4) << "use buffer views for " << node->AsStmt().op_type();
+    MarkViewable(node);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(concat_split_view_pass,
+                  paddle::lite::mir::ConcatSplitViewPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,84 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * Mark the concat and split ops whose copies can be removed at runtime with
+ * the attribute "use_buffer_view":
+ * - concat: every input is produced by exactly one op and only read by the
+ *   concat, so the inputs can live in the slices of the output buffer and
+ *   their producers write there directly.
+ * - split: the outputs can be handed out as slices of the input buffer.
+ * Only the ops whose declared shapes have no dim but 1 or -1 in front of the
+ * concat/split axis are marked, since only then can every slice be a
+ * contiguous block of the buffer. A -1 is usually the batch, which is only
+ * known at runtime, so the kernels check the runtime shapes again and fall
+ * back to copying whenever the views do not match them.
+ * Variables of the marked ops are kept out of memory_optimize_pass.
+ */
+class ConcatSplitViewPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // Whether all dims in front of the axis of the op are 1 or unknown in the
+  // shape of `var_name`.
+  bool IsOutermostAxis(Node* node, const std::string& var_name) const;
+  bool IsConcatViewable(Node* node) const;
+  bool IsSplitViewable(Node* node) const;
+  // Whether the kernel of `producer` writes `var_name` on the target of the
+  // kernel of `consumer`. Otherwise a view of the consumer's buffer is
+  // dropped every time the producer writes it.
+  bool IsWrittenOnSameTarget(Node* producer,
+                             Node* consumer,
+                             const std::string& var_name) const;
+  void MarkViewable(Node* node) const;
+
+  // Ops whose outputs share the buffer of their inputs, so their outputs can
+  // not be made views of another tensor.
+  const std::set<std::string> buffer_sharing_ops_{"feed",
+                                                  "fetch",
+                                                  "split",
+                                                  "io_copy",
+                                                  "io_copy_once",
+                                                  "layout",
+                                                  "layout_once",
+                                                  "calib",
+                                                  "calib_once",
+                                                  "reshape",
+                                                  "reshape2",
+                                                  "flatten",
+                                                  "flatten2",
+                                                  "squeeze",
+                                                  "squeeze2",
+                                                  "unsqueeze",
+                                                  "unsqueeze2",
+                                                  "subgraph",
+                                                  "while",
+                                                  "conditional_block"};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
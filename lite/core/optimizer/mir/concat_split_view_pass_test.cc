@@ -0,0 +1,162 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/concat_split_view_pass.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  return desc;
+}
+
+static cpp::OpDesc FetchDesc(const std::string& x) {
+  cpp::OpDesc desc;
+  desc.SetType("fetch");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {"fetch"});
+  desc.SetAttr("col", 0);
+  return desc;
+}
+
+// Declares the shape of a var as its var desc would, with -1 for the dims
+// only known at runtime.
+static void Declare(PassTestHelper* helper,
+                    const std::string& name,
+                    const std::vector<int64_t>& dims) {
+  helper->Var(name, PRECISION(kFloat));
+  helper->scope()->FindMutableTensor(name)->Resize(dims);
+}
+
+static bool IsMarked(PassTestHelper* helper, const std::string& op_type) {
+  const auto* op_info = helper->FindOp(op_type)->AsStmt().op_info();
+  return op_info->HasAttr("use_buffer_view") &&
+         op_info->GetAttr<bool>("use_buffer_view");
+}
+
+// concat(relu(x), relu(y)) along axis 1 of x [batch, 2, 3] and y [batch, 4, 3]
+void TestConcat(int64_t batch, int64_t declared_batch, bool expect_marked) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {batch, 2, 3});
+  helper.Input<float>("y", {batch, 4, 3});
+  helper.Op(UnaryDesc("relu", "x", "a"));
+  helper.Op(UnaryDesc("relu", "y", "b"));
+  cpp::OpDesc concat;
+  concat.SetType("concat");
+  concat.SetInput("X", {"a", "b"});
+  concat.SetOutput("Out", {"out"});
+  concat.SetAttr("axis", 1);
+  helper.Op(concat);
+  helper.Op(FetchDesc("out"));
+  helper.Run();
+  auto expected = helper.Output<float>("out");
+
+  Declare(&helper, "a", {declared_batch, 2, 3});
+  Declare(&helper, "b", {declared_batch, 4, 3});
+  Declare(&helper, "out", {declared_batch, 6, 3});
+  ConcatSplitViewPass().Apply(helper.mutable_graph());
+  EXPECT_EQ(IsMarked(&helper, "concat"), expect_marked);
+
+  // The second run reuses the views set up by the first one.
+  for (int run = 0; run < 2; ++run) {
+    helper.Run();
+    auto actual = helper.Output<float>("out");
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i], expected[i]) << "run " << run << " at " << i;
+    }
+  }
+  auto* scope = helper.scope();
+  EXPECT_EQ(scope->FindTensor("a")->IsViewOf(*scope->FindTensor("out")),
+            expect_marked);
+}
+
+TEST(concat_split_view_pass, concat_outermost_axis) {
+  TestConcat(1, 1, true);
+}
+
+TEST(concat_split_view_pass, concat_strided_axis) {
+  // A dim in front of the axis is not 1 or is unknown, so the slices of the
+  // output may be strided.
+  TestConcat(2, 2, false);
+  TestConcat(1, -1, false);
+}
+
+// relu(x) split along axis 1 of [batch, 6, 2] into two halves which are
+// added up again.
+void TestSplit(int64_t batch, int64_t declared_batch, bool expect_marked) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {batch, 6, 2});
+  helper.Op(UnaryDesc("relu", "x", "t"));
+  cpp::OpDesc split;
+  split.SetType("split");
+  split.SetInput("X", {"t"});
+  split.SetOutput("Out", {"o0", "o1"});
+  split.SetAttr("axis", 1);
+  split.SetAttr("num", 2);
+  split.SetAttr("sections", std::vector<int>{});
+  helper.Op(split);
+  cpp::OpDesc add;
+  add.SetType("elementwise_add");
+  add.SetInput("X", {"o0"});
+  add.SetInput("Y", {"o1"});
+  add.SetOutput("Out", {"out"});
+  add.SetAttr("axis", -1);
+  helper.Op(add);
+  helper.Op(FetchDesc("out"));
+  helper.Run();
+  auto expected = helper.Output<float>("out");
+
+  Declare(&helper, "t", {declared_batch, 6, 2});
+  Declare(&helper, "o0", {declared_batch, 3, 2});
+  Declare(&helper, "o1", {declared_batch, 3, 2});
+  ConcatSplitViewPass().Apply(helper.mutable_graph());
+  EXPECT_EQ(IsMarked(&helper, "split"), expect_marked);
+
+  for (int run = 0; run < 2; ++run) {
+    helper.Run();
+    auto actual = helper.Output<float>("out");
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(actual[i], expected[i]) << "run " << run << " at " << i;
+    }
+  }
+  auto* scope = helper.scope();
+  EXPECT_EQ(scope->FindTensor("o0")->IsViewOf(*scope->FindTensor("t")),
+            expect_marked);
+}
+
+TEST(concat_split_view_pass, split_outermost_axis) { TestSplit(1, 1, true); }
+
+TEST(concat_split_view_pass, split_strided_axis) {
+  TestSplit(2, 2, false);
+  TestSplit(1, -1, false);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,262 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+#include "lite/operators/conditional_block_op.h"
+#include "lite/operators/subgraph_op.h"
+#include "lite/operators/while_op.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// The weights are kept in the root scope, the exec scope of the program is
+// one of its kids.
+Scope* RootScope(Scope* scope) {
+  while (scope->parent()) {
+    scope = const_cast<Scope*>(scope->parent());
+  }
+  return scope;
+}
+
+// The vars read by the ops of the sub-blocks, they have no edges in the
+// graph of the main block.
+std::set<std::string> SubBlockInputs(SSAGraph* graph) {
+  std::shared_ptr<const cpp::ProgramDesc> program_desc;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto& inst = node->AsStmt();
+    auto* op = inst.op().get();
+    if (inst.op_type() == "while") {
+      program_desc = static_cast<operators::WhileOp*>(op)->GetProgramDesc();
+    } else if (inst.op_type() == "conditional_block") {
+      program_desc =
+          static_cast<operators::ConditionalBlockOp*>(op)->GetProgramDesc();
+    } else if (inst.op_type() == "subgraph") {
+      program_desc = static_cast<operators::SubgraphOp*>(op)->GetProgramDesc();
+    }
+    if (program_desc) break;
+  }
+  std::set<std::string> names;
+  if (!program_desc) return names;
+  for (size_t i = 0; i < program_desc->BlocksSize(); ++i) {
+    if (i == kRootBlockIdx) continue;
+    const auto* block_desc = program_desc->GetBlock<cpp::BlockDesc>(i);
+    for (size_t j = 0; j < block_desc->OpsSize(); ++j) {
+      const auto* op_desc = block_desc->GetOp<cpp::OpDesc>(j);
+      for (auto& name : op_desc->input_vars()) {
+        names.insert(name);
+      }
+    }
+  }
+  return names;
+}
+
+}  // namespace
+
+void ConstantFoldingPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The vars of the sub-blocks are recreated in every step scope.
+  if (graph->blockIdx() != kRootBlockIdx) return;
+
+  int folded = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!IsFoldable(node)) continue;
+    if (FoldConstant(graph.get(), node)) folded++;
+  }
+  EliminateDeadOps(graph.get());
+  VLOG(4) << "constant folding: " << folded << " ops are folded";
+}
+
+bool ConstantFoldingPass::IsFoldable(Node* node) const {
+  auto& inst = node->AsStmt();
+  const auto op_type = inst.op_type();
+  if (excluded_ops_.count(op_type) ||
+      op_type.find("quant") != std::string::npos ||
+      op_type.compare(0, 2, "__") == 0) {
+    return false;
+  }
+  if (node->outlinks.empty()) return false;
+  for (auto* in : node->inlinks) {
+    if (!in->IsArg() || !in->arg()->is_weight) return false;
+  }
+  for (auto* out : node->outlinks) {
+    // The output must be written by this op only, and not be a weight or
+    // an input of the same op(in-place).
+    if (!out->IsArg() || out->arg()->is_weight || out->inlinks.size() != 1) {
+      return false;
+    }
+    for (auto* in : node->inlinks) {
+      if (in->arg()->name == out->arg()->name) return false;
+    }
+  }
+  return true;
+}
+
+std::unique_ptr<KernelBase> ConstantFoldingPass::PickKernel(Node* node) const {
+  auto& inst = node->AsStmt();
+  const auto* op_info = inst.op_info();
+  auto* scope = inst.op()->scope();
+  // Only the targets whose kernels are really compiled in can be run. The
+  // opt tool only builds the host kernels, the others are faked.
+  std::vector<TargetType> targets{TARGET(kHost)};
+#ifndef LITE_ON_MODEL_OPTIMIZE_TOOL
+#ifdef LITE_WITH_X86
+  targets.push_back(TARGET(kX86));
+#endif
+#ifdef LITE_WITH_ARM
+  targets.push_back(TARGET(kARM));
+#endif
+#endif
+
+  auto kernels = KernelRegistry::Global().Create(inst.op_type());
+  for (auto& kernel : kernels) {
+    if (std::find(targets.begin(), targets.end(), kernel->target()) ==
+        targets.end()) {
+      continue;
+    }
+    bool matched = true;
+    for (auto& arg : op_info->InputArgumentNames()) {
+      const auto* decl = ParamTypeRegistry::Global().RetrieveInArgument(
+          kernel->place(), kernel->GenParamTypeKey(), arg);
+      if (!decl || !decl->type->IsTensor()) {
+        matched = false;
+        break;
+      }
+      const auto* type = decl->type;
+      for (auto& var_name : op_info->Input(arg)) {
+        auto* var = scope->FindVar(var_name);
+        if (!var || !var->IsType<lite::Tensor>()) {
+          matched = false;
+          break;
+        }
+        const auto& tensor = var->Get<lite::Tensor>();
+        if ((type->precision() != PRECISION(kAny) &&
+             type->precision() != tensor.precision()) ||
+            (type->layout() != DATALAYOUT(kAny) &&
+             type->layout() != DATALAYOUT(kNCHW))) {
+          matched = false;
+          break;
+        }
+      }
+      if (!matched) break;
+    }
+    if (matched) return std::move(kernel);
+  }
+  return nullptr;
+}
+
+bool ConstantFoldingPass::FoldConstant(SSAGraph* graph, Node* node) {
+  auto& inst = node->AsStmt();
+  auto* scope = inst.op()->scope();
+  const auto* op_info = inst.op_info();
+  for (auto& var_name : op_info->output_names()) {
+    auto* var = scope->FindVar(var_name);
+    if (!var || !var->IsType<lite::Tensor>()) return false;
+  }
+  auto kernel = PickKernel(node);
+  if (!kernel) return false;
+
+  int64_t in_numel = 0;
+  for (auto* in : node->inlinks) {
+    in_numel += scope->FindVar(in->arg()->name)->Get<lite::Tensor>().numel();
+  }
+
+  // Run the op once, as in RuntimeProgram.
+  auto op = inst.op();
+  op->AttachKernel(kernel.get());
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  if (!op->CheckShape() || !op->InferShape()) return false;
+  int64_t out_numel = 0;
+  for (auto& var_name : op_info->output_names()) {
+    out_numel += scope->FindVar(var_name)->Get<lite::Tensor>().numel();
+  }
+  if (out_numel > (std::max)(in_numel, max_folded_numel_)) return false;
+  kernel->Launch();
+
+  // Replace the outputs with persistable tensors of the root scope, where
+  // the cloned predictors and the saved model look for the weights, and
+  // drop the op, as well as the inputs that are not used any more.
+  auto* root_scope = RootScope(scope);
+  for (auto& var_name : op_info->output_names()) {
+    auto* tensor = scope->FindVar(var_name)->GetMutable<lite::Tensor>();
+    tensor->set_persistable(true);
+    if (root_scope != scope) {
+      auto* weight = root_scope->Var(var_name)->GetMutable<lite::Tensor>();
+      weight->CopyDataFrom(*tensor);
+      tensor->ShareDataWith(*weight);
+    }
+  }
+  std::set<const Node*> nodes2rm;
+  for (auto* out : node->outlinks) {
+    out->arg()->is_weight = true;
+    // such as the XShape of reshape2
+    if (out->outlinks.empty()) nodes2rm.insert(out);
+  }
+  for (auto* in : node->inlinks) {
+    if (in->outlinks.size() == 1) nodes2rm.insert(in);
+  }
+  nodes2rm.insert(node);
+  VLOG(4) << "fold constant op " << inst.op_type();
+  GraphSafeRemoveNodes(graph, nodes2rm);
+  return true;
+}
+
+void ConstantFoldingPass::EliminateDeadOps(SSAGraph* graph) {
+  // The vars read by the sub-blocks are alive even without readers in the
+  // graph, the fetched vars have the fetch ops as readers.
+  const auto live_vars = SubBlockInputs(graph);
+  auto stmts = graph->StmtTopologicalOrder();
+  for (auto it = stmts.rbegin(); it != stmts.rend(); ++it) {
+    auto* node = *it;
+    const auto op_type = node->AsStmt().op_type();
+    if (excluded_ops_.count(op_type) || node->outlinks.empty()) continue;
+    bool dead = true;
+    for (auto* out : node->outlinks) {
+      if (!out->outlinks.empty() || out->arg()->is_weight ||
+          out->inlinks.size() != 1 || live_vars.count(out->arg()->name)) {
+        dead = false;
+        break;
+      }
+    }
+    if (!dead) continue;
+
+    std::set<const Node*> nodes2rm(node->outlinks.begin(),
+                                   node->outlinks.end());
+    for (auto* in : node->inlinks) {
+      if (in->outlinks.size() == 1 && in->inlinks.empty()) {
+        nodes2rm.insert(in);
+      }
+    }
+    nodes2rm.insert(node);
+    VLOG(4) << "eliminate dead op " << op_type;
+    GraphSafeRemoveNodes(graph, nodes2rm);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(constant_folding_pass,
+                  paddle::lite::mir::ConstantFoldingPass)
+    .BindTargets({TARGET(kAny)});
@@ -0,0 +1,78 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/kernel.h"
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::ConstantFoldingPass
+ * Run the ops whose inputs are all persistable(or which have no inputs, such
+ * as fill_constant) once with the cpu kernels, and replace their outputs with
+ * persistable tensors. Chains of such ops(fill_constant->range->expand,
+ * precomputed priors...) are folded one after another. A chain starting at
+ * an activation, such as shape->slice->fill_constant, is not folded, since
+ * the dims of the activation are only known when the program runs. Then the
+ * ops whose outputs are never used are removed with their dead vars. Only
+ * the main block is processed.
+ */
+class ConstantFoldingPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsFoldable(Node* node) const;
+  // Create a cpu kernel of the op whose declared input types match the
+  // tensors in scope, return nullptr if there is none.
+  std::unique_ptr<KernelBase> PickKernel(Node* node) const;
+  bool FoldConstant(SSAGraph* graph, Node* node);
+  void EliminateDeadOps(SSAGraph* graph);
+
+  // Ops with side effects, random outputs, sub-blocks or quantization
+  // semantics, never folded nor eliminated.
+  const std::set<std::string> excluded_ops_{"feed",
+                                            "fetch",
+                                            "while",
+                                            "conditional_block",
+                                            "subgraph",
+                                            "io_copy",
+                                            "io_copy_once",
+                                            "print",
+                                            "write_to_array",
+                                            "read_from_array",
+                                            "increment",
+                                            "share_data",
+                                            "uniform_random",
+                                            "gaussian_random",
+                                            "sampling_id",
+                                            "randperm",
+                                            "dropout",
+                                            "calib",
+                                            "calib_once"};
+  // Don't fold ops whose outputs are much larger than their inputs, such as
+  // expand or fill_constant of a big shape, to keep the model small.
+  const int64_t max_folded_numel_{1 << 16};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
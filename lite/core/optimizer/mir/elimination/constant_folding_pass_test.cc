@@ -0,0 +1,195 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/constant_folding_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc BinaryDesc(const std::string& op_type,
+                              const std::string& x,
+                              const std::string& y,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", -1);
+  return desc;
+}
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  if (op_type == "scale") {
+    desc.SetAttr("scale", 2.f);
+    desc.SetAttr("bias", 1.f);
+    desc.SetAttr("bias_after_scale", true);
+  }
+  return desc;
+}
+
+static cpp::OpDesc FetchDesc(const std::string& x) {
+  cpp::OpDesc desc;
+  desc.SetType("fetch");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {"fetch"});
+  desc.SetAttr("col", 0);
+  return desc;
+}
+
+TEST(constant_folding_pass, fold_chain) {
+  PassTestHelper helper;
+  helper.Weight<float>("a", {2, 3}, {-3.f, -1.f, 0.f, 1.f, 2.f, 3.f});
+  helper.Weight<float>("b", {2, 3}, {1.f});
+  helper.Input<float>("x", {2, 3});
+  // relu(a + b) only depends on weights, x * relu(a + b) does not
+  helper.Op(BinaryDesc("elementwise_add", "a", "b", "c"));
+  helper.Op(UnaryDesc("relu", "c", "d"));
+  helper.Op(BinaryDesc("elementwise_mul", "x", "d", "y"));
+  helper.Op(FetchDesc("y"));
+  helper.Run();
+  auto expected = helper.Output<float>("y");
+
+  ConstantFoldingPass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"elementwise_mul", "fetch"}));
+  // the folded output becomes a weight of the root scope, the dead inputs
+  // are removed
+  auto* d_var = helper.root_scope()->FindLocalVar("d");
+  ASSERT_NE(d_var, nullptr);
+  auto* d = d_var->GetMutable<Tensor>();
+  EXPECT_TRUE(d->persistable());
+  EXPECT_EQ(helper.graph()->RetrieveArgument("a"), nullptr);
+  auto* mul = helper.FindOp("elementwise_mul");
+  ASSERT_EQ(mul->inlinks.size(), 2u);
+  for (auto* in : mul->inlinks) {
+    EXPECT_EQ(in->arg()->is_weight, in->arg()->name == "d");
+  }
+  const std::vector<float> folded{0.f, 0.f, 1.f, 2.f, 3.f, 4.f};
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_FLOAT_EQ(d->data<float>()[i], folded[i]);
+  }
+
+  helper.Run();
+  auto actual = helper.Output<float>("y");
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_FLOAT_EQ(actual[i], expected[i]);
+  }
+}
+
+TEST(constant_folding_pass, fold_op_without_inputs) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {4});
+  cpp::OpDesc fill;
+  fill.SetType("fill_constant");
+  fill.SetOutput("Out", {"c"});
+  fill.SetAttr("shape", std::vector<int64_t>{4});
+  fill.SetAttr("dtype", static_cast<int>(VarDescAPI::VarDataType::FP32));
+  fill.SetAttr("value", 1.5f);
+  fill.SetAttr("force_cpu", false);
+  helper.Op(fill);
+  helper.Op(BinaryDesc("elementwise_add", "x", "c", "y"));
+  helper.Op(FetchDesc("y"));
+
+  ConstantFoldingPass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"elementwise_add", "fetch"}));
+  auto c = helper.Output<float>("c");
+  EXPECT_EQ(c, std::vector<float>(4, 1.5f));
+}
+
+TEST(constant_folding_pass, eliminate_dead_ops) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3});
+  // scale -> relu is never read, relu -> fetch is
+  helper.Op(UnaryDesc("scale", "x", "t0"));
+  helper.Op(UnaryDesc("relu", "t0", "t1"));
+  helper.Op(UnaryDesc("relu", "x", "y"));
+  helper.Op(FetchDesc("y"));
+
+  ConstantFoldingPass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"relu", "fetch"}));
+  EXPECT_EQ(helper.graph()->RetrieveArgument("t0"), nullptr);
+  EXPECT_EQ(helper.graph()->RetrieveArgument("t1"), nullptr);
+  EXPECT_NE(helper.graph()->RetrieveArgument("x"), nullptr);
+}
+
+TEST(constant_folding_pass, keep_ops_read_by_sub_blocks) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3});
+  helper.Input<bool>("cond", {1}, {false});
+  // t1 is only read by an op of the sub-block of while
+  helper.Op(UnaryDesc("scale", "x", "t0"));
+  helper.Op(UnaryDesc("relu", "t0", "t1"));
+  helper.Op(UnaryDesc("relu", "x", "y"));
+  helper.Op(FetchDesc("y"));
+
+  std::shared_ptr<cpp::ProgramDesc> program_desc(new cpp::ProgramDesc);
+  program_desc->AddBlock<cpp::BlockDesc>();
+  auto* sub_block = program_desc->AddBlock<cpp::BlockDesc>();
+  *sub_block->AddOp<cpp::OpDesc>() = UnaryDesc("relu", "t1", "t2");
+  cpp::OpDesc loop;
+  loop.SetType("while");
+  loop.SetInput("X", {});
+  loop.SetInput("Condition", {"cond"});
+  loop.SetOutput("Out", {});
+  loop.SetOutput("StepScopes", {"step_scopes"});
+  loop.SetAttr<int32_t>("sub_block", 1);
+  helper.Op(loop, program_desc);
+
+  ConstantFoldingPass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_NE(helper.FindOp("scale"), nullptr);
+  EXPECT_NE(helper.graph()->RetrieveArgument("t1"), nullptr);
+  EXPECT_EQ(helper.OpTypes().size(), 5u);
+}
+
+TEST(constant_folding_pass, fold_fetched_output) {
+  PassTestHelper helper;
+  helper.Weight<float>("a", {3}, {1.f, 2.f, 3.f});
+  helper.Op(UnaryDesc("scale", "a", "y"));
+  helper.Op(FetchDesc("y"));
+
+  ConstantFoldingPass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  // the value is folded, but the fetch still reads it
+  EXPECT_EQ(helper.OpTypes(), std::vector<std::string>{"fetch"});
+  auto* fetch = helper.FindOp("fetch");
+  ASSERT_EQ(fetch->inlinks.size(), 1u);
+  EXPECT_EQ(fetch->inlinks.front()->arg()->name, "y");
+  EXPECT_TRUE(fetch->inlinks.front()->arg()->is_weight);
+  EXPECT_EQ(helper.Output<float>("y"), (std::vector<float>{3.f, 5.f, 7.f}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,432 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/elimination/transpose_reshape_eliminate_pass.h"
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// Edit a copy of the op desc and reset the op with it.
+void UpdateOp(SSAGraph* graph,
+              Node* node,
+              const std::function<void(OpInfo*)>& update) {
+  auto op_info = *node->AsStmt().op_info();
+  update(&op_info);
+  node->AsStmt().ResetOp(op_info, graph->valid_places());
+}
+
+// The var node of the first argument of `argument` of the op.
+Node* FindVar(const std::list<Node*>& links,
+              const OpInfo& op_info,
+              const std::string& argument,
+              bool is_input) {
+  if (is_input ? !op_info.HasInput(argument) : !op_info.HasOutput(argument)) {
+    return nullptr;
+  }
+  auto names = is_input ? op_info.Input(argument) : op_info.Output(argument);
+  if (names.empty()) return nullptr;
+  for (auto* link : links) {
+    if (link->IsArg() && link->AsArg().name == names.front()) return link;
+  }
+  return nullptr;
+}
+
+Node* InputVar(Node* node, const std::string& argument) {
+  return FindVar(node->inlinks, *node->AsStmt().op_info(), argument, true);
+}
+
+Node* OutputVar(Node* node, const std::string& argument) {
+  return FindVar(node->outlinks, *node->AsStmt().op_info(), argument, false);
+}
+
+bool IsQuantized(Node* node) {
+  return node->AsStmt().op_info()->HasAttr("enable_int8");
+}
+
+// Whether the outputs of the op except `out`(XShape of transpose2, reshape2
+// ...) are never read, so that the op can be removed once `out` is not read.
+bool OnlyOutputIsRead(Node* node, Node* out) {
+  for (auto* var : node->outlinks) {
+    if (var != out && (!var->outlinks.empty() || var->AsArg().is_persist)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Read `to` instead of `from` in the op.
+void ReplaceInput(SSAGraph* graph, Node* node, Node* from, Node* to) {
+  UpdateOp(graph, node, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(from->AsArg().name, to->AsArg().name);
+  });
+  RemoveDirectedLink(from, node);
+  DirectedLink(to, node);
+}
+
+std::vector<int> GetAxis(Node* node) {
+  return node->AsStmt().op_info()->GetAttr<std::vector<int>>("axis");
+}
+
+bool IsIdentity(const std::vector<int>& axis) {
+  for (size_t i = 0; i < axis.size(); i++) {
+    if (axis[i] != static_cast<int>(i)) return false;
+  }
+  return true;
+}
+
+// `var` holds the input of a transpose of `axis` now, whose output has the
+// dims of `transposed`. The dims of the tensors in the scope of `op` stand for
+// the var descs until the program runs, give `var` the unpermuted dims.
+void UnpermuteDims(Node* op,
+                   Node* transposed,
+                   Node* var,
+                   const std::vector<int>& axis) {
+  auto* scope = op->AsStmt().op()->scope();
+  auto* from = scope->FindVar(transposed->AsArg().name);
+  auto* to = scope->FindVar(var->AsArg().name);
+  if (!from || !from->IsType<Tensor>() || !to || !to->IsType<Tensor>()) return;
+  auto dims = from->Get<Tensor>().dims().Vectorize();
+  if (dims.size() != axis.size()) return;
+  std::vector<int64_t> unpermuted(dims.size());
+  for (size_t i = 0; i < axis.size(); i++) {
+    unpermuted[axis[i]] = dims[i];
+  }
+  to->GetMutable<Tensor>()->Resize(unpermuted);
+}
+
+}  // namespace
+
+void TransposeReshapeEliminatePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // The vars of the sub-blocks may be read by the parent block by name.
+  if (graph->blockIdx() != kRootBlockIdx) return;
+
+  // A single sweep in topological order. A rewrite may enable another one
+  // on the ops it touched or on the producers of their inputs only, these
+  // are put back at the front of the worklist.
+  removed_.clear();
+  auto order = graph->StmtTopologicalOrder();
+  std::list<Node*> worklist(order.begin(), order.end());
+  int rewrites = 0;
+  while (!worklist.empty()) {
+    auto* node = worklist.front();
+    worklist.pop_front();
+    // The pass never creates nodes, so the address of a removed node can't
+    // be taken by another one while it runs.
+    if (removed_.count(node) || IsQuantized(node)) continue;
+    revisit_.clear();
+    bool changed = false;
+    const auto& op_type = node->AsStmt().op_type();
+    if (transpose_ops_.count(op_type)) {
+      changed = EliminateIdentityTranspose(graph.get(), node) ||
+                MergeTransposes(graph.get(), node) ||
+                FoldTransposeIntoMatmul(graph.get(), node) ||
+                SinkTranspose(graph.get(), node);
+    } else if (reshape_ops_.count(op_type)) {
+      changed = MergeReshapes(graph.get(), node);
+    } else if (binary_ops_.count(op_type)) {
+      changed = HoistTransposes(graph.get(), node);
+    }
+    if (changed) {
+      rewrites++;
+      worklist.insert(worklist.begin(), revisit_.begin(), revisit_.end());
+    }
+  }
+  VLOG(4) << "transpose/reshape elimination: " << rewrites << " rewrites";
+}
+
+void TransposeReshapeEliminatePass::RemoveOp(SSAGraph* graph, Node* node) {
+  std::set<const Node*> nodes2rm(node->outlinks.begin(), node->outlinks.end());
+  nodes2rm.insert(node);
+  removed_.insert(node);
+  GraphSafeRemoveNodes(graph, nodes2rm);
+}
+
+void TransposeReshapeEliminatePass::RevisitProducer(Node* var) {
+  revisit_.insert(revisit_.end(), var->inlinks.begin(), var->inlinks.end());
+}
+
+Node* TransposeReshapeEliminatePass::SoleConsumer(Node* var) const {
+  if (!var || var->AsArg().is_weight || var->AsArg().is_persist ||
+      var->inlinks.size() != 1 || var->outlinks.size() != 1) {
+    return nullptr;
+  }
+  auto* node = var->outlinks.front();
+  if (control_flow_ops_.count(node->AsStmt().op_type()) || IsQuantized(node)) {
+    return nullptr;
+  }
+  return node;
+}
+
+bool TransposeReshapeEliminatePass::EliminateIdentityTranspose(SSAGraph* graph,
+                                                               Node* node) {
+  auto* in = InputVar(node, "X");
+  auto* out = OutputVar(node, "Out");
+  if (!in || !out || !IsIdentity(GetAxis(node)) || out->outlinks.empty() ||
+      out->AsArg().is_persist || !OnlyOutputIsRead(node, out)) {
+    return false;
+  }
+  // The fetch ops and the sub-blocks read the output by its name.
+  auto consumers = out->outlinks;
+  for (auto* consumer : consumers) {
+    const auto& op_type = consumer->AsStmt().op_type();
+    if (op_type == "fetch" || control_flow_ops_.count(op_type)) return false;
+  }
+  for (auto* consumer : consumers) {
+    ReplaceInput(graph, consumer, out, in);
+  }
+  RemoveOp(graph, node);
+  RevisitProducer(in);
+  revisit_.insert(revisit_.end(), consumers.begin(), consumers.end());
+  return true;
+}
+
+bool TransposeReshapeEliminatePass::MergeTransposes(SSAGraph* graph,
+                                                    Node* node) {
+  auto* in = InputVar(node, "X");
+  auto* out = OutputVar(node, "Out");
+  auto* next = SoleConsumer(out);
+  if (!in || !next || !transpose_ops_.count(next->AsStmt().op_type()) ||
+      !OnlyOutputIsRead(node, out)) {
+    return false;
+  }
+  // out[i] = in[axis[i]] and next_out[i] = out[next_axis[i]], so that
+  // next_out[i] = in[axis[next_axis[i]]].
+  auto axis = GetAxis(node);
+  auto next_axis = GetAxis(next);
+  if (axis.size() != next_axis.size()) return false;
+  std::vector<int> merged_axis(axis.size());
+  for (size_t i = 0; i < axis.size(); i++) {
+    merged_axis[i] = axis[next_axis[i]];
+  }
+  UpdateOp(graph, next, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(out->AsArg().name, in->AsArg().name);
+    op_desc->SetAttr("axis", merged_axis);
+  });
+  DirectedLink(in, next);
+  RemoveOp(graph, node);
+  RevisitProducer(in);
+  revisit_.push_back(next);
+  return true;
+}
+
+bool TransposeReshapeEliminatePass::MergeReshapes(SSAGraph* graph,
+                                                  Node* node) {
+  auto* in = InputVar(node, "X");
+  auto* out = OutputVar(node, "Out");
+  auto* next = SoleConsumer(out);
+  if (!in || !next || !OnlyOutputIsRead(node, out)) return false;
+  // The second reshape must not depend on the shape of its input, except
+  // the number of the elements, which doesn't change.
+  auto* next_info = next->AsStmt().op_info();
+  const auto& next_type = next_info->Type();
+  if ((next_type != "reshape" && next_type != "reshape2") ||
+      !next_info->HasAttr("shape") || next->inlinks.size() != 1) {
+    return false;
+  }
+  auto shape = next_info->GetAttr<std::vector<int>>("shape");
+  if (shape.empty() || std::count(shape.begin(), shape.end(), 0)) {
+    return false;
+  }
+  ReplaceInput(graph, next, out, in);
+  RemoveOp(graph, node);
+  RevisitProducer(in);
+  revisit_.push_back(next);
+  return true;
+}
+
+bool TransposeReshapeEliminatePass::SinkTranspose(SSAGraph* graph,
+                                                  Node* node) {
+  auto* in = InputVar(node, "X");
+  auto* out = OutputVar(node, "Out");
+  auto* next = SoleConsumer(out);
+  auto is_unary = [&](Node* op) {
+    return op && unary_ops_.count(op->AsStmt().op_type()) &&
+           op->inlinks.size() == 1 && op->outlinks.size() == 1;
+  };
+  if (!in || !is_unary(next) || !OnlyOutputIsRead(node, out)) return false;
+  // Only sink it when it meets another transpose or a matmul at the end of
+  // the unary ops.
+  auto* last = next;
+  while (is_unary(last)) {
+    last = SoleConsumer(last->outlinks.front());
+  }
+  if (!last || (!transpose_ops_.count(last->AsStmt().op_type()) &&
+                !IsFoldableIntoMatmul(node, last))) {
+    return false;
+  }
+
+  // in -> transpose -> out -> next -> next_out becomes
+  // in -> next -> out -> transpose -> next_out.
+  auto* next_out = next->outlinks.front();
+  UpdateOp(graph, next, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(out->AsArg().name, in->AsArg().name);
+    op_desc->UpdateAllOutputs(next_out->AsArg().name, out->AsArg().name);
+  });
+  UpdateOp(graph, node, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(in->AsArg().name, out->AsArg().name);
+    op_desc->UpdateAllOutputs(out->AsArg().name, next_out->AsArg().name);
+  });
+  RemoveDirectedLink(in, node);
+  RemoveDirectedLink(node, out);
+  RemoveDirectedLink(out, next);
+  RemoveDirectedLink(next, next_out);
+  DirectedLink(in, next);
+  DirectedLink(next, out);
+  DirectedLink(out, node);
+  DirectedLink(node, next_out);
+  UnpermuteDims(node, out, out, GetAxis(node));
+  RevisitProducer(in);
+  revisit_.push_back(next);
+  revisit_.push_back(node);
+  return true;
+}
+
+bool TransposeReshapeEliminatePass::HoistTransposes(SSAGraph* graph,
+                                                    Node* node) {
+  auto* op_info = node->AsStmt().op_info();
+  if (op_info->HasAttr("axis") && op_info->GetAttr<int>("axis") != -1) {
+    return false;
+  }
+  auto* x = InputVar(node, "X");
+  auto* y = InputVar(node, "Y");
+  auto* out = OutputVar(node, "Out");
+  if (!x || !y || !out || x == y || node->inlinks.size() != 2 ||
+      node->outlinks.size() != 1 || SoleConsumer(x) != node ||
+      SoleConsumer(y) != node) {
+    return false;
+  }
+  auto* x_transpose = x->inlinks.front();
+  auto* y_transpose = y->inlinks.front();
+  if (!transpose_ops_.count(x_transpose->AsStmt().op_type()) ||
+      !transpose_ops_.count(y_transpose->AsStmt().op_type()) ||
+      IsQuantized(x_transpose) || IsQuantized(y_transpose) ||
+      OutputVar(x_transpose, "Out") != x ||
+      OutputVar(y_transpose, "Out") != y ||
+      GetAxis(x_transpose) != GetAxis(y_transpose) ||
+      !OnlyOutputIsRead(x_transpose, x) ||
+      !OnlyOutputIsRead(y_transpose, y)) {
+    return false;
+  }
+  auto* x_in = InputVar(x_transpose, "X");
+  auto* y_in = InputVar(y_transpose, "X");
+  if (!x_in || !y_in) return false;
+
+  // transpose(x_in) + transpose(y_in) -> out becomes
+  // x_in + y_in -> x -> transpose -> out, the transpose of y is removed.
+  UpdateOp(graph, node, [&](OpInfo* op_desc) {
+    op_desc->SetInput("X", {x_in->AsArg().name});
+    op_desc->SetInput("Y", {y_in->AsArg().name});
+    op_desc->UpdateAllOutputs(out->AsArg().name, x->AsArg().name);
+  });
+  UpdateOp(graph, x_transpose, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(x_in->AsArg().name, x->AsArg().name);
+    op_desc->UpdateAllOutputs(x->AsArg().name, out->AsArg().name);
+  });
+  RemoveDirectedLink(x_in, x_transpose);
+  RemoveDirectedLink(x_transpose, x);
+  RemoveDirectedLink(x, node);
+  RemoveDirectedLink(node, out);
+  DirectedLink(x_in, node);
+  DirectedLink(y_in, node);
+  DirectedLink(node, x);
+  DirectedLink(x, x_transpose);
+  DirectedLink(x_transpose, out);
+  // x held transpose(x_in) and holds x_in + y_in now, which is broadcast to
+  // the dims of out before the transpose when x_in is the smaller input.
+  UnpermuteDims(node, out, x, GetAxis(x_transpose));
+  RemoveOp(graph, y_transpose);
+  RevisitProducer(x_in);
+  RevisitProducer(y_in);
+  revisit_.push_back(node);
+  revisit_.push_back(x_transpose);
+  return true;
+}
+
+bool TransposeReshapeEliminatePass::IsFoldableIntoMatmul(Node* transpose,
+                                                         Node* matmul) const {
+  const auto& op_type = matmul->AsStmt().op_type();
+  if (op_type != "matmul" && op_type != "matmul_v2") return false;
+  auto axis = GetAxis(transpose);
+  auto rank = static_cast<int>(axis.size());
+  if (rank < 2 || axis[rank - 2] != rank - 1 || axis[rank - 1] != rank - 2) {
+    return false;
+  }
+  for (int i = 0; i < rank - 2; i++) {
+    if (axis[i] != i) return false;
+  }
+  // The same var as both of the inputs can't be folded into one of them.
+  auto* op_info = matmul->AsStmt().op_info();
+  return op_info->Input("X").front() != op_info->Input("Y").front();
+}
+
+bool TransposeReshapeEliminatePass::FoldTransposeIntoMatmul(SSAGraph* graph,
+                                                            Node* node) {
+  auto* in = InputVar(node, "X");
+  auto* out = OutputVar(node, "Out");
+  auto* next = SoleConsumer(out);
+  if (!in || !next || !IsFoldableIntoMatmul(node, next) ||
+      !OnlyOutputIsRead(node, out)) {
+    return false;
+  }
+  auto* op_info = next->AsStmt().op_info();
+  bool is_x = op_info->Input("X").front() == out->AsArg().name;
+  std::string attr;
+  if (op_info->Type() == "matmul") {
+    attr = is_x ? "transpose_X" : "transpose_Y";
+  } else {
+    attr = is_x ? "trans_x" : "trans_y";
+  }
+  bool transposed = op_info->GetAttr<bool>(attr);
+  UpdateOp(graph, next, [&](OpInfo* op_desc) {
+    op_desc->UpdateAllInputs(out->AsArg().name, in->AsArg().name);
+    op_desc->SetAttr(attr, !transposed);
+  });
+  DirectedLink(in, next);
+  RemoveOp(graph, node);
+  RevisitProducer(in);
+  return true;
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(transpose_reshape_eliminate_pass,
+                  paddle::lite::mir::TransposeReshapeEliminatePass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
+    .ExcludeTargets({TARGET(kNPU),
+                     TARGET(kBM),
+                     TARGET(kXPU),
+                     TARGET(kRKNPU),
+                     TARGET(kAPU),
+                     TARGET(kMLU),
+                     TARGET(kHuaweiAscendNPU),
+                     TARGET(kImaginationNNA),
+                     TARGET(kOpenCL),
+                     TARGET(kMetal),
+                     TARGET(kNNAdapter)});
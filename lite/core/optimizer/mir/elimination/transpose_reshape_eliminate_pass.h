@@ -0,0 +1,121 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::TransposeReshapeEliminatePass
+ * Simplify the chains of transposes and reshapes of the models converted
+ * from other frameworks algebraically:
+ * 1. Remove the transposes of the identity permutation, unless their
+ *    outputs are fetched.
+ * 2. Compose two consecutive transposes into one, which is then removed if
+ *    the composed permutation is the identity.
+ * 3. Compose a reshape-like op(reshape, squeeze, unsqueeze, flatten)
+ *    followed by a reshape of a static shape into the second one.
+ * 4. Sink a transpose through the unary elementwise ops(activations, scale)
+ *    when it meets another transpose or a matmul below them.
+ * 5. Hoist the two transposes of the same permutation on the inputs of a
+ *    binary elementwise op to its output.
+ * 6. Fold a transpose swapping the last two dims into the trans_x/trans_y
+ *    attributes of matmul.
+ * Only the main block is processed, and the quantized ops are kept as they
+ * are.
+ */
+class TransposeReshapeEliminatePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool EliminateIdentityTranspose(SSAGraph* graph, Node* node);
+  bool MergeTransposes(SSAGraph* graph, Node* node);
+  bool MergeReshapes(SSAGraph* graph, Node* node);
+  bool SinkTranspose(SSAGraph* graph, Node* node);
+  bool HoistTransposes(SSAGraph* graph, Node* node);
+  bool FoldTransposeIntoMatmul(SSAGraph* graph, Node* node);
+
+  // Remove the op with its outputs, which must not be read anymore.
+  void RemoveOp(SSAGraph* graph, Node* node);
+  // Visit the ops writing the var again after the current rewrite.
+  void RevisitProducer(Node* var);
+
+  // The only op reading the var, nullptr if there are several or none of
+  // them, or the var must be kept.
+  Node* SoleConsumer(Node* var) const;
+  // Whether the transpose can be folded into the matmul reading its output.
+  bool IsFoldableIntoMatmul(Node* transpose, Node* matmul) const;
+
+  // The ops removed by the pass, and the ops to visit again after the
+  // current rewrite.
+  std::set<const Node*> removed_;
+  std::vector<Node*> revisit_;
+
+  const std::set<std::string> transpose_ops_{"transpose", "transpose2"};
+  const std::set<std::string> reshape_ops_{"reshape",
+                                           "reshape2",
+                                           "squeeze",
+                                           "squeeze2",
+                                           "unsqueeze",
+                                           "unsqueeze2",
+                                           "flatten",
+                                           "flatten2",
+                                           "flatten_contiguous_range"};
+  // The ops computing every element from the element at the same position
+  // only, so that they commute with the transposes.
+  const std::set<std::string> unary_ops_{"relu",
+                                         "relu6",
+                                         "leaky_relu",
+                                         "sigmoid",
+                                         "tanh",
+                                         "swish",
+                                         "hard_swish",
+                                         "hard_sigmoid",
+                                         "gelu",
+                                         "elu",
+                                         "softplus",
+                                         "mish",
+                                         "exp",
+                                         "log",
+                                         "abs",
+                                         "sqrt",
+                                         "rsqrt",
+                                         "square",
+                                         "floor",
+                                         "scale"};
+  const std::set<std::string> binary_ops_{"elementwise_add",
+                                          "elementwise_sub",
+                                          "elementwise_mul",
+                                          "elementwise_div",
+                                          "elementwise_max",
+                                          "elementwise_min",
+                                          "elementwise_pow"};
+  // Ops referring to the vars by name in their sub-blocks.
+  const std::set<std::string> control_flow_ops_{
+      "while", "conditional_block", "subgraph"};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
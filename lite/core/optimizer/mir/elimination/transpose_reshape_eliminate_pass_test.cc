@@ -0,0 +1,280 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/elimination/transpose_reshape_eliminate_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc TransposeDesc(const std::string& x,
+                                 const std::string& out,
+                                 const std::vector<int>& axis) {
+  cpp::OpDesc desc;
+  desc.SetType("transpose2");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  desc.SetOutput("XShape", {out + "_xshape"});
+  desc.SetAttr("axis", axis);
+  return desc;
+}
+
+static cpp::OpDesc ReshapeDesc(const std::string& x,
+                               const std::string& out,
+                               const std::vector<int>& shape) {
+  cpp::OpDesc desc;
+  desc.SetType("reshape2");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  desc.SetOutput("XShape", {out + "_xshape"});
+  desc.SetAttr("shape", shape);
+  return desc;
+}
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  if (op_type == "scale") {
+    desc.SetAttr("scale", 2.f);
+    desc.SetAttr("bias", 1.f);
+    desc.SetAttr("bias_after_scale", true);
+  }
+  return desc;
+}
+
+static cpp::OpDesc AddDesc(const std::string& x,
+                           const std::string& y,
+                           const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("elementwise_add");
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", -1);
+  return desc;
+}
+
+static cpp::OpDesc FetchDesc(const std::string& x) {
+  cpp::OpDesc desc;
+  desc.SetType("fetch");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {"fetch"});
+  desc.SetAttr("col", 0);
+  return desc;
+}
+
+static void CheckOutput(PassTestHelper* helper,
+                        const std::string& out,
+                        const std::vector<float>& expected) {
+  helper->Run();
+  auto actual = helper->Output<float>(out);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_FLOAT_EQ(actual[i], expected[i]) << out << " at " << i;
+  }
+}
+
+// Runs the program before and after the pass, and checks that `out` is the
+// same.
+static void ApplyAndCompare(PassTestHelper* helper, const std::string& out) {
+  helper->Run();
+  auto expected = helper->Output<float>(out);
+  TransposeReshapeEliminatePass().Apply(helper->mutable_graph());
+  helper->graph()->CheckValid();
+  CheckOutput(helper, out, expected);
+}
+
+static DDim VarDims(PassTestHelper* helper, const std::string& name) {
+  return helper->scope()->FindVar(name)->Get<Tensor>().dims();
+}
+
+static size_t CountOps(PassTestHelper* helper, const std::string& op_type) {
+  auto op_types = helper->OpTypes();
+  return std::count(op_types.begin(), op_types.end(), op_type);
+}
+
+TEST(transpose_reshape_eliminate_pass, identity_transpose) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "t", {0, 1, 2}));
+  helper.Op(UnaryDesc("relu", "t", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"relu", "fetch"}));
+}
+
+TEST(transpose_reshape_eliminate_pass, keep_fetched_identity_transpose) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "y", {0, 1, 2}));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"transpose2", "fetch"}));
+}
+
+TEST(transpose_reshape_eliminate_pass, merge_transposes) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "t0", {1, 0, 2}));
+  helper.Op(TransposeDesc("t0", "t1", {0, 2, 1}));
+  helper.Op(UnaryDesc("relu", "t1", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"transpose2", "relu", "fetch"}));
+  auto* transpose = helper.FindOp("transpose2");
+  EXPECT_EQ(transpose->AsStmt().op_info()->GetAttr<std::vector<int>>("axis"),
+            (std::vector<int>{1, 2, 0}));
+}
+
+TEST(transpose_reshape_eliminate_pass, merge_inverse_transposes) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "t0", {2, 0, 1}));
+  helper.Op(TransposeDesc("t0", "t1", {1, 2, 0}));
+  helper.Op(UnaryDesc("relu", "t1", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"relu", "fetch"}));
+}
+
+TEST(transpose_reshape_eliminate_pass, merge_reshapes) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(ReshapeDesc("x", "r0", {6, 4}));
+  helper.Op(ReshapeDesc("r0", "r1", {4, -1}));
+  helper.Op(UnaryDesc("relu", "r1", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"reshape2", "relu", "fetch"}));
+  EXPECT_EQ(VarDims(&helper, "y"), DDim(std::vector<int64_t>{4, 6}));
+}
+
+TEST(transpose_reshape_eliminate_pass, hoist_transposes) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Input<float>("z", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "tx", {0, 2, 1}));
+  helper.Op(TransposeDesc("z", "tz", {0, 2, 1}));
+  helper.Op(AddDesc("tx", "tz", "s"));
+  helper.Op(UnaryDesc("relu", "s", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{
+                "elementwise_add", "transpose2", "relu", "fetch"}));
+}
+
+// x is broadcast to the dims of z, the sum in the layout of x has the dims of
+// z, not of x.
+TEST(transpose_reshape_eliminate_pass, hoist_transposes_of_broadcast_x) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {1, 3, 1});
+  helper.Input<float>("z", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "tx", {0, 2, 1}));
+  helper.Op(TransposeDesc("z", "tz", {0, 2, 1}));
+  helper.Op(AddDesc("tx", "tz", "s"));
+  helper.Op(UnaryDesc("relu", "s", "y"));
+  helper.Op(FetchDesc("y"));
+  helper.Run();
+  auto expected = helper.Output<float>("y");
+  EXPECT_EQ(VarDims(&helper, "s"), DDim(std::vector<int64_t>{2, 4, 3}));
+
+  TransposeReshapeEliminatePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{
+                "elementwise_add", "transpose2", "relu", "fetch"}));
+  EXPECT_EQ(VarDims(&helper, "tx"), DDim(std::vector<int64_t>{2, 3, 4}));
+  CheckOutput(&helper, "y", expected);
+}
+
+TEST(transpose_reshape_eliminate_pass, keep_transposes_with_read_xshape) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Input<float>("z", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "tx", {0, 2, 1}));
+  helper.Op(TransposeDesc("z", "tz", {0, 2, 1}));
+  helper.Op(AddDesc("tx", "tz", "s"));
+  helper.Op(UnaryDesc("relu", "s", "y"));
+  helper.Op(UnaryDesc("scale", "tx_xshape", "w"));
+  TransposeReshapeEliminatePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(CountOps(&helper, "transpose2"), 2u);
+  auto* add = helper.FindOp("elementwise_add");
+  EXPECT_EQ(add->AsStmt().op_info()->Input("X"),
+            (std::vector<std::string>{"tx"}));
+}
+
+// The transpose moves down through relu and scale, then cancels the one
+// below them.
+TEST(transpose_reshape_eliminate_pass, sink_transpose) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "t0", {0, 2, 1}));
+  helper.Op(UnaryDesc("relu", "t0", "a"));
+  helper.Op(UnaryDesc("scale", "a", "b"));
+  helper.Op(TransposeDesc("b", "t1", {0, 2, 1}));
+  helper.Op(UnaryDesc("relu", "t1", "y"));
+  helper.Op(FetchDesc("y"));
+  helper.Run();
+  auto expected = helper.Output<float>("y");
+  EXPECT_EQ(VarDims(&helper, "t0"), DDim(std::vector<int64_t>{2, 4, 3}));
+
+  TransposeReshapeEliminatePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"relu", "scale", "relu", "fetch"}));
+  // relu and scale write t0 and a in the layout of x now, the later passes
+  // see it before the program runs again.
+  auto* scale = helper.FindOp("scale");
+  EXPECT_EQ(scale->AsStmt().op_info()->Input("X"),
+            (std::vector<std::string>{"t0"}));
+  EXPECT_EQ(scale->AsStmt().op_info()->Output("Out"),
+            (std::vector<std::string>{"a"}));
+  EXPECT_EQ(VarDims(&helper, "t0"), DDim(std::vector<int64_t>{2, 3, 4}));
+  EXPECT_EQ(VarDims(&helper, "a"), DDim(std::vector<int64_t>{2, 3, 4}));
+  CheckOutput(&helper, "y", expected);
+}
+
+// Without a transpose or a matmul below the unary ops, sinking the
+// transpose gains nothing.
+TEST(transpose_reshape_eliminate_pass, keep_transpose_above_unary_ops) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Op(TransposeDesc("x", "t0", {0, 2, 1}));
+  helper.Op(UnaryDesc("relu", "t0", "y"));
+  helper.Op(FetchDesc("y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"transpose2", "relu", "fetch"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
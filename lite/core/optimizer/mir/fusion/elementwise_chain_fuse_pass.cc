@@ -0,0 +1,177 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// Whether the model declares the var as a float tensor.
+bool IsFloatTensor(Node* node) {
+  const auto* type = node->AsArg().type;
+  return type && type->IsTensor() && type->precision() == PRECISION(kFloat);
+}
+
+}  // namespace
+
+void ElementwiseChainFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The fused kernel is only implemented for x86.
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kX86) && place.target != TARGET(kHost) &&
+        place.target != TARGET(kAny)) {
+      return;
+    }
+  }
+
+  // Collect the chains first, the nodes are removed while fusing.
+  std::set<Node*> visited;
+  std::vector<std::vector<Node*>> chains;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (visited.count(node) || !IsChainable(node)) continue;
+    std::vector<Node*> chain{node};
+    Node* next = NextInChain(node);
+    while (next && !visited.count(next)) {
+      chain.push_back(next);
+      next = NextInChain(next);
+    }
+    if (chain.size() < 2) continue;
+    visited.insert(chain.begin(), chain.end());
+    chains.push_back(std::move(chain));
+  }
+
+  for (auto& chain : chains) {
+    FuseChain(graph.get(), chain);
+  }
+  VLOG(4) << "fused " << chains.size() << " elementwise chains";
+}
+
+bool ElementwiseChainFusePass::IsChainable(Node* node) const {
+  auto& inst = node->AsStmt();
+  const auto op_type = inst.op_type();
+  const auto* op_info = inst.op_info();
+  if (!binary_ops_.count(op_type) && !unary_ops_.count(op_type)) return false;
+  // The quantized ops and the ops fused with scale are left alone.
+  if (op_info->HasAttr("enable_int8") || op_info->HasAttr("fuse_scale")) {
+    return false;
+  }
+  if (op_info->Output("Out").size() != 1 || node->outlinks.size() != 1) {
+    return false;
+  }
+  // The fused kernel only computes in float.
+  for (auto* in : node->inlinks) {
+    if (!IsFloatTensor(in)) return false;
+  }
+  if (!IsFloatTensor(node->outlinks.front())) return false;
+  if (op_info->Input("X").size() != 1) return false;
+  if (binary_ops_.count(op_type)) {
+    return op_info->Input("Y").size() == 1 &&
+           op_info->Input("X").front() != op_info->Input("Y").front();
+  }
+  return true;
+}
+
+Node* ElementwiseChainFusePass::NextInChain(Node* node) const {
+  auto* out = node->outlinks.front();
+  if (!out->IsArg() || out->arg()->is_weight || out->outlinks.size() != 1) {
+    return nullptr;
+  }
+  auto* next = out->outlinks.front();
+  if (!next->IsStmt() || !IsChainable(next)) return nullptr;
+  // The intermediate output must be read once, as X or Y.
+  const auto& out_name = out->arg()->name;
+  const auto* op_info = next->AsStmt().op_info();
+  int reads = 0;
+  for (auto& name : op_info->input_names()) {
+    if (name == out_name) reads++;
+  }
+  return reads == 1 ? next : nullptr;
+}
+
+void ElementwiseChainFusePass::FuseChain(SSAGraph* graph,
+                                         const std::vector<Node*>& chain) {
+  auto* head_info = chain.front()->AsStmt().op_info();
+  std::vector<std::string> y_names;
+  std::vector<std::string> op_types;
+  std::vector<int> axes;
+  std::vector<int> reversed;
+  std::string chained = head_info->Input("X").front();
+  std::set<const Node*> nodes2rm;
+  for (auto* node : chain) {
+    const auto* op_info = node->AsStmt().op_info();
+    const auto op_type = node->AsStmt().op_type();
+    op_types.push_back(op_type);
+    axes.push_back(op_info->HasAttr("axis") ? op_info->GetAttr<int>("axis")
+                                            : -1);
+    reversed.push_back(0);
+    if (binary_ops_.count(op_type)) {
+      const auto x_name = op_info->Input("X").front();
+      const auto y_name = op_info->Input("Y").front();
+      reversed.back() = x_name == chained ? 0 : 1;
+      y_names.push_back(x_name == chained ? y_name : x_name);
+    }
+    chained = op_info->Output("Out").front();
+    nodes2rm.insert(node);
+    if (node != chain.back()) nodes2rm.insert(node->outlinks.front());
+  }
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_elementwise_chain");
+  op_desc.SetInput("X", {head_info->Input("X").front()});
+  op_desc.SetInput("Y", y_names);
+  op_desc.SetOutput("Out", {chained});
+  op_desc.SetAttr("op_types", op_types);
+  op_desc.SetAttr("axes", axes);
+  op_desc.SetAttr("reversed", reversed);
+
+  // Keep the input and output nodes before the old ops are removed.
+  std::vector<Node*> inputs;
+  for (auto* node : chain) {
+    for (auto* in : node->inlinks) {
+      if (!nodes2rm.count(in)) inputs.push_back(in);
+    }
+  }
+  auto* out = chain.back()->outlinks.front();
+
+  auto old_op = chain.front()->AsStmt().op();
+  auto* scope = old_op->scope();
+  auto& valid_places = old_op->valid_places();
+  auto op = LiteOpRegistry::Global().Create("fusion_elementwise_chain");
+  op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(op, valid_places);
+  GraphSafeRemoveNodes(graph, nodes2rm);
+
+  for (auto* in : inputs) {
+    DirectedLink(in, new_op_node);
+  }
+  DirectedLink(new_op_node, out);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_elementwise_chain_fuse_pass,
+                  paddle::lite::mir::ElementwiseChainFusePass)
+    .BindTargets({TARGET(kX86)})
+    .BindKernel("fusion_elementwise_chain");
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::ElementwiseChainFusePass
+ * Fuse the chains of elementwise ops, where the output of each op is only
+ * read by the next one, into a single fusion_elementwise_chain op, e.g.
+ *   elementwise_mul -> elementwise_add -> relu
+ * The fused kernel reads every input once and keeps the intermediate results
+ * in cache, instead of writing and reading them back between the ops. Chains
+ * of any length are matched by walking the graph, so no pattern per
+ * combination is needed.
+ */
+class ElementwiseChainFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsChainable(Node* node) const;
+  // Returns the op reading the output of `node` if it continues the chain.
+  Node* NextInChain(Node* node) const;
+  void FuseChain(SSAGraph* graph, const std::vector<Node*>& chain);
+
+  const std::set<std::string> binary_ops_{"elementwise_add",
+                                          "elementwise_sub",
+                                          "elementwise_mul",
+                                          "elementwise_div",
+                                          "elementwise_max",
+                                          "elementwise_min"};
+  const std::set<std::string> unary_ops_{"relu", "sigmoid", "tanh"};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,136 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/elementwise_chain_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc BinaryDesc(const std::string& op_type,
+                              const std::string& x,
+                              const std::string& y,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", -1);
+  return desc;
+}
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  return desc;
+}
+
+static cpp::OpDesc FetchDesc(const std::string& x) {
+  cpp::OpDesc desc;
+  desc.SetType("fetch");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {"fetch"});
+  desc.SetAttr("col", 0);
+  return desc;
+}
+
+TEST(elementwise_chain_fuse_pass, fuse_float_chain) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Input<float>("y", {2, 3, 4});
+  helper.Input<float>("z", {2, 3, 4});
+  for (auto name : {"t0", "t1", "out"}) {
+    helper.Var(name, PRECISION(kFloat));
+  }
+  // relu(x + y) * z
+  helper.Op(BinaryDesc("elementwise_add", "x", "y", "t0"));
+  helper.Op(UnaryDesc("relu", "t0", "t1"));
+  helper.Op(BinaryDesc("elementwise_mul", "t1", "z", "out"));
+  helper.Op(FetchDesc("out"));
+  helper.Run();
+  auto expected = helper.Output<float>("out");
+
+  ElementwiseChainFusePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"fusion_elementwise_chain", "fetch"}));
+  EXPECT_EQ(helper.graph()->RetrieveArgument("t0"), nullptr);
+  EXPECT_EQ(helper.graph()->RetrieveArgument("t1"), nullptr);
+
+  helper.Run();
+  auto actual = helper.Output<float>("out");
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_FLOAT_EQ(actual[i], expected[i]);
+  }
+}
+
+TEST(elementwise_chain_fuse_pass, skip_int64_chain) {
+  PassTestHelper helper;
+  helper.Input<int64_t>("x", {2, 5}, {1, 20000000000, -3});
+  helper.Input<int64_t>("y", {2, 5}, {7, -5});
+  helper.Input<int64_t>("z", {2, 5}, {3});
+  helper.Var("t0", PRECISION(kInt64));
+  helper.Var("out", PRECISION(kInt64));
+  // (x + y) - z, the fused kernel would read the int64 data as float
+  helper.Op(BinaryDesc("elementwise_add", "x", "y", "t0"));
+  helper.Op(BinaryDesc("elementwise_sub", "t0", "z", "out"));
+  helper.Op(FetchDesc("out"));
+
+  ElementwiseChainFusePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{
+                "elementwise_add", "elementwise_sub", "fetch"}));
+
+  helper.Run();
+  auto out = helper.Output<int64_t>("out");
+  const std::vector<int64_t> x{1, 20000000000, -3};
+  const std::vector<int64_t> y{7, -5};
+  ASSERT_EQ(out.size(), 10u);
+  for (size_t i = 0; i < out.size(); ++i) {
+    EXPECT_EQ(out[i], x[i % 3] + y[i % 2] - 3);
+  }
+}
+
+TEST(elementwise_chain_fuse_pass, skip_float_op_with_int64_output) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {4});
+  helper.Input<float>("y", {4});
+  helper.Var("t0", PRECISION(kFloat));
+  // a model declaring another output type must not be fused either
+  helper.Var("out", PRECISION(kInt64));
+  helper.Op(BinaryDesc("elementwise_add", "x", "y", "t0"));
+  helper.Op(UnaryDesc("relu", "t0", "out"));
+  helper.Op(FetchDesc("out"));
+
+  ElementwiseChainFusePass().Apply(helper.mutable_graph());
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"elementwise_add", "relu", "fetch"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
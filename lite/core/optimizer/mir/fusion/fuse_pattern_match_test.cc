@@ -0,0 +1,234 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/fusion/elementwise_add_activation_fuser.h"
+#include "lite/core/optimizer/mir/fusion/fc_fuser.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// Gives the tests the matcher of a fuser.
+template <typename FuserT>
+class ExposedFuser : public FuserT {
+ public:
+  using FuserT::FuserT;
+  PatternMatcher* matcher() { return &this->matcher_; }
+};
+
+using FuserAndMatcher = std::pair<std::unique_ptr<FuseBase>, PatternMatcher*>;
+
+template <typename FuserT, typename... Args>
+FuserAndMatcher NewFuser(Args... args) {
+  auto* fuser = new ExposedFuser<FuserT>(args...);
+  return FuserAndMatcher(std::unique_ptr<FuseBase>(fuser), fuser->matcher());
+}
+
+// The search of PatternMatcher before the PMNodes were anchored on op types:
+// every PMNode is told every node of the graph, and every edge of the
+// pattern is tried on every pair of candidates for every partial match.
+static std::vector<PatternMatcher::subgraph_t> ExhaustiveSearch(
+    const PMPattern& pattern, SSAGraph* graph) {
+  struct Group {
+    std::map<PMNode*, Node*> roles;
+    std::set<Node*> nodes;
+    bool Match(Node* node, PMNode* pat) {
+      if (nodes.count(node)) return roles.count(pat) && roles[pat] == node;
+      return !roles.count(pat) || roles[pat] == node;
+    }
+  };
+  std::vector<PatternMatcher::subgraph_t> result;
+  std::map<const PMNode*, std::set<Node*>> candidates;
+  for (auto& node : graph->mutable_nodes()) {
+    for (const auto& pmnode : pattern.nodes()) {
+      if (pmnode->Tell(&node)) candidates[pmnode.get()].insert(&node);
+    }
+  }
+  auto* first = pattern.edges().empty() ? pattern.nodes().front().get()
+                                        : pattern.edges().front().first;
+  if (!candidates.count(first)) return result;
+  std::vector<Group> groups;
+  for (auto* node : candidates[first]) {
+    groups.emplace_back();
+    groups.back().roles[first] = node;
+  }
+  for (const auto& edge : pattern.edges()) {
+    if (groups.empty()) break;
+    std::vector<Group> next;
+    for (auto* source : candidates[edge.first]) {
+      for (auto* target : candidates[edge.second]) {
+        const auto& links = source->outlinks;
+        if (std::find(links.begin(), links.end(), target) == links.end()) {
+          continue;
+        }
+        for (const auto& group : groups) {
+          Group new_group = group;
+          if (new_group.Match(source, edge.first) &&
+              new_group.Match(target, edge.second)) {
+            new_group.roles[edge.first] = source;
+            new_group.nodes.insert(source);
+            new_group.roles[edge.second] = target;
+            new_group.nodes.insert(target);
+            next.push_back(new_group);
+          }
+        }
+      }
+    }
+    groups.swap(next);
+  }
+  for (auto& group : groups) result.push_back(group.roles);
+  return result;
+}
+
+static cpp::OpDesc MulDesc(const std::string& x,
+                           const std::string& y,
+                           const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("mul");
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("x_num_col_dims", 1);
+  desc.SetAttr("y_num_col_dims", 1);
+  return desc;
+}
+
+static cpp::OpDesc AddDesc(const std::string& x,
+                           const std::string& y,
+                           const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("elementwise_add");
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", -1);
+  return desc;
+}
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  if (op_type == "scale") {
+    desc.SetAttr("scale", 0.5f);
+    desc.SetAttr("bias", 0.f);
+    desc.SetAttr("bias_after_scale", true);
+  }
+  return desc;
+}
+
+// Two fc candidates in a row, the second one with an add output read
+// outside the pattern, a mul + add whose bias is no weight, and elementwise
+// adds followed by relu which compete with the fc patterns for the same ops.
+static void BuildGraph(PassTestHelper* helper) {
+  helper->Input<float>("x", {4, 8});
+  for (auto name : {"W0", "W1", "W2"}) helper->Weight<float>(name, {8, 8});
+  helper->Weight<float>("b0", {8});
+  helper->Weight<float>("b1", {8});
+  for (auto name : {"m0", "a0", "r0", "m1", "a1", "r1", "z", "m2", "a2", "r2",
+                    "s", "out"}) {
+    helper->Var(name, PRECISION(kFloat));
+  }
+  helper->Op(MulDesc("x", "W0", "m0"));
+  helper->Op(AddDesc("m0", "b0", "a0"));
+  helper->Op(UnaryDesc("relu", "a0", "r0"));
+  helper->Op(MulDesc("r0", "W1", "m1"));
+  helper->Op(AddDesc("m1", "b1", "a1"));
+  helper->Op(UnaryDesc("relu", "a1", "r1"));
+  helper->Op(UnaryDesc("scale", "a1", "z"));
+  helper->Op(MulDesc("x", "W2", "m2"));
+  helper->Op(AddDesc("m2", "r0", "a2"));
+  helper->Op(UnaryDesc("relu", "a2", "r2"));
+  helper->Op(AddDesc("r1", "r2", "s"));
+  helper->Op(UnaryDesc("relu", "s", "out"));
+}
+
+// Runs the fusers of lite_fc_fuse_pass and
+// lite_elementwise_activation_fuse_pass in the order of the optimizer. Each
+// matcher has to find the same subgraphs, in the same order, as the
+// exhaustive search, and the fused graph has to compute the same outputs.
+TEST(PatternMatcher, FusersMatchExhaustiveSearch) {
+  PassTestHelper helper;
+  BuildGraph(&helper);
+  helper.Run();
+  std::map<std::string, std::vector<float>> expected;
+  for (auto name : {"z", "out"}) expected[name] = helper.Output<float>(name);
+
+  using fusion::ElementwiseActivationFuser;
+  using fusion::FcFuser;
+  std::vector<std::function<FuserAndMatcher()>> fusers{
+      [] { return NewFuser<FcFuser>(true); },
+      [] { return NewFuser<FcFuser>(false); },
+      [] {
+        return NewFuser<ElementwiseActivationFuser>("elementwise_add", "relu");
+      }};
+  std::vector<size_t> fused_nums;
+  for (auto& create : fusers) {
+    auto probe = create();
+    probe.first->BuildPattern();
+    auto* matcher = probe.second;
+    matcher->MarkPMNodesInGraph(helper.graph());
+    auto subgraphs = matcher->DetectPatterns();
+    auto reference = ExhaustiveSearch(matcher->pattern(), helper.graph());
+    EXPECT_FALSE(reference.empty());
+    EXPECT_EQ(subgraphs, reference);
+
+    auto fuser = create();
+    fused_nums.push_back((*fuser.first)(helper.graph()));
+    helper.graph()->CheckValid();
+  }
+  // fc with relu: x -> r0. fc: r0 -> a1, since a1 is also read by scale.
+  // elementwise_add + relu: m2 + r0 -> r2 and r1 + r2 -> out.
+  EXPECT_EQ(fused_nums, (std::vector<size_t>{1, 1, 2}));
+
+  auto op_types = helper.OpTypes();
+  std::sort(op_types.begin(), op_types.end());
+  EXPECT_EQ(op_types,
+            (std::vector<std::string>{"fc",
+                                      "fc",
+                                      "fusion_elementwise_add_activation",
+                                      "fusion_elementwise_add_activation",
+                                      "mul",
+                                      "relu",
+                                      "scale"}));
+
+  helper.Run();
+  for (auto& item : expected) {
+    auto actual = helper.Output<float>(item.first);
+    ASSERT_EQ(actual.size(), item.second.size()) << item.first;
+    for (size_t i = 0; i < actual.size(); ++i) {
+      EXPECT_NEAR(actual[i], item.second[i], 1e-5) << item.first;
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,195 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/kv_cache_fuse_pass.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+namespace {
+
+// Whether `node` is reachable from `ancestor` along the data edges.
+bool IsAncestor(Node* ancestor, Node* node) {
+  std::set<Node*> visited;
+  std::vector<Node*> stack{node};
+  while (!stack.empty()) {
+    auto* cur = stack.back();
+    stack.pop_back();
+    if (cur == ancestor) return true;
+    if (!visited.insert(cur).second) continue;
+    for (auto* in : cur->inlinks) stack.push_back(in);
+  }
+  return false;
+}
+
+bool HasInput(const OpInfo* op_info, const std::string& name) {
+  return op_info->HasInput(name) && !op_info->Input(name).empty();
+}
+
+}  // namespace
+
+void KVCacheFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The caches only live across the iterations of the while sub-blocks.
+  if (graph->blockIdx() == kRootBlockIdx) return;
+  // The kernels are on host, so the cache must stay in host memory.
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kX86) && place.target != TARGET(kARM) &&
+        place.target != TARGET(kHost) && place.target != TARGET(kAny)) {
+      return;
+    }
+  }
+
+  // Collect the pairs first, the nodes are removed while fusing.
+  std::vector<std::pair<Node*, Node*>> pairs;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    auto* cache = CacheInput(node);
+    if (!cache) continue;
+    auto* write_back = WriteBack(node, cache->arg()->name);
+    if (!write_back || !IsSafe(graph.get(), node, write_back)) continue;
+    pairs.emplace_back(node, write_back);
+  }
+
+  for (auto& pair : pairs) {
+    Fuse(graph.get(), pair.first, pair.second);
+  }
+  VLOG(4) << "fused " << pairs.size() << " kv cache updates";
+}
+
+Node* KVCacheFusePass::CacheInput(Node* node) const {
+  auto& inst = node->AsStmt();
+  const auto op_type = inst.op_type();
+  const auto* op_info = inst.op_info();
+  std::string other;
+  if (op_type == "concat") {
+    if (HasInput(op_info, "AxisTensor")) return nullptr;
+    if (op_info->Input("X").size() != 2) return nullptr;
+    other = op_info->Input("X")[1];
+  } else if (op_type == "gather") {
+    if (HasInput(op_info, "Axis")) return nullptr;
+    other = op_info->Input("Index").front();
+  } else {
+    return nullptr;
+  }
+  const auto cache_name = op_info->Input("X").front();
+  if (cache_name == other || node->outlinks.size() != 1) return nullptr;
+  for (auto* in : node->inlinks) {
+    if (in->arg()->name != cache_name) continue;
+    // The old content of the cache must not be read by any other op.
+    if (in->arg()->is_weight || in->outlinks.size() != 1) return nullptr;
+    return in;
+  }
+  return nullptr;
+}
+
+Node* KVCacheFusePass::WriteBack(Node* node, const std::string& cache) const {
+  auto* out = node->outlinks.front();
+  if (out->arg()->is_weight) return nullptr;
+  Node* write_back = nullptr;
+  for (auto* reader : out->outlinks) {
+    auto& inst = reader->AsStmt();
+    if (inst.op_type() != "assign") continue;
+    const auto* op_info = inst.op_info();
+    if (op_info->Input("X").front() != out->arg()->name ||
+        op_info->Output("Out").front() != cache) {
+      continue;
+    }
+    if (write_back) return nullptr;
+    write_back = reader;
+  }
+  return write_back;
+}
+
+bool KVCacheFusePass::IsSafe(SSAGraph* graph,
+                             Node* node,
+                             Node* write_back) const {
+  auto* out = node->outlinks.front();
+  const auto& cache = write_back->outlinks.front()->arg()->name;
+  std::vector<Node*> readers;
+  for (auto* reader : out->outlinks) {
+    if (reader != write_back) readers.push_back(reader);
+  }
+  for (auto& other : graph->mutable_nodes()) {
+    if (other.IsArg()) {
+      // The output becomes an alias, so it must be defined once in the block
+      // and not be carried over from the last iteration.
+      if (&other != out && other.arg()->name == out->arg()->name) {
+        return false;
+      }
+      continue;
+    }
+    if (&other == write_back) continue;
+    bool writes_cache = false;
+    for (auto* arg : other.outlinks) {
+      if (arg->arg()->name == cache) writes_cache = true;
+    }
+    if (!writes_cache || IsAncestor(&other, node)) continue;
+    for (auto* reader : readers) {
+      if (!IsAncestor(reader, &other)) return false;
+    }
+  }
+  return true;
+}
+
+void KVCacheFusePass::Fuse(SSAGraph* graph, Node* node, Node* write_back) {
+  const auto* op_info = node->AsStmt().op_info();
+  const bool append = node->AsStmt().op_type() == "concat";
+  const auto cache = op_info->Input("X").front();
+  const auto other =
+      append ? op_info->Input("X")[1] : op_info->Input("Index").front();
+  auto* out = node->outlinks.front();
+  auto* cache_out = write_back->outlinks.front();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType(append ? "kv_cache_append" : "kv_cache_reorder");
+  op_desc.SetInput("Cache", {cache});
+  op_desc.SetInput(append ? "X" : "Index", {other});
+  op_desc.SetOutput("CacheOut", {cache});
+  op_desc.SetOutput("Out", {out->arg()->name});
+  if (append) op_desc.SetAttr("axis", op_info->GetAttr<int>("axis"));
+
+  // Keep the input nodes before the old ops are removed.
+  std::vector<Node*> inputs(node->inlinks.begin(), node->inlinks.end());
+
+  auto old_op = node->AsStmt().op();
+  auto* scope = old_op->scope();
+  auto& valid_places = old_op->valid_places();
+  auto op = LiteOpRegistry::Global().Create(op_desc.Type());
+  op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(op, valid_places);
+  GraphSafeRemoveNodes(graph, {node, write_back});
+
+  for (auto* in : inputs) {
+    DirectedLink(in, new_op_node);
+  }
+  DirectedLink(new_op_node, cache_out);
+  DirectedLink(new_op_node, out);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_kv_cache_fuse_pass, paddle::lite::mir::KVCacheFusePass)
+    .BindTargets({TARGET(kX86), TARGET(kARM), TARGET(kHost)})
+    .BindKernel("kv_cache_append")
+    .BindKernel("kv_cache_reorder");
@@ -0,0 +1,53 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::KVCacheFusePass
+ * The decoders in the while sub-blocks keep their attention caches as
+ *   concat(cache, new) -> t, assign(t) -> cache
+ *   gather(cache, parent_idx) -> t, assign(t) -> cache
+ * which copy the whole cache twice per step. Each pair is replaced by a
+ * kv_cache_append or kv_cache_reorder op, which updates the cache in place
+ * and makes t an alias of it.
+ *
+ * The cache must be read by the matched op only, and every other writer of
+ * the cache must be ordered before the op, or after all the readers of t, by
+ * the data edges of the graph. Otherwise the pair is left alone.
+ */
+class KVCacheFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  // Returns the input node of the cache, nullptr if `node` is no candidate.
+  Node* CacheInput(Node* node) const;
+  // Returns the assign writing the output of `node` back to the cache.
+  Node* WriteBack(Node* node, const std::string& cache) const;
+  bool IsSafe(SSAGraph* graph, Node* node, Node* write_back) const;
+  void Fuse(SSAGraph* graph, Node* node, Node* write_back);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
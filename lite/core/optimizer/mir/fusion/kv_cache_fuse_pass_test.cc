@@ -0,0 +1,161 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/kv_cache_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc ConcatDesc(const std::string& cache,
+                              const std::string& x,
+                              const std::string& out,
+                              int axis) {
+  cpp::OpDesc desc;
+  desc.SetType("concat");
+  desc.SetInput("X", {cache, x});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", axis);
+  return desc;
+}
+
+static cpp::OpDesc GatherDesc(const std::string& cache,
+                              const std::string& index,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("gather");
+  desc.SetInput("X", {cache});
+  desc.SetInput("Index", {index});
+  desc.SetOutput("Out", {out});
+  return desc;
+}
+
+static cpp::OpDesc ScaleDesc(const std::string& x, const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("scale");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("scale", 2.f);
+  desc.SetAttr("bias", 1.f);
+  desc.SetAttr("bias_after_scale", true);
+  return desc;
+}
+
+// The assign writing `x` back to the cache. The helper keeps one node per
+// var, so the written cache gets a node of its own here, as in the SSA graph
+// of a while sub-block.
+static void WriteBack(PassTestHelper* helper,
+                      const std::string& x,
+                      const std::string& cache) {
+  cpp::OpDesc desc;
+  desc.SetType("assign");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {cache});
+  auto op = LiteOpRegistry::Global().Create("assign");
+  op->Attach(desc, helper->scope());
+  auto* graph = helper->graph();
+  auto* node = graph->GraphCreateInstructNode(op, graph->valid_places());
+  DirectedLink(helper->Var(x), node);
+  DirectedLink(node, graph->NewArgumentNode(cache));
+}
+
+// One step of a decoder: the cache grows by `x` along axis 1 and is read
+// through t, or is reordered by `index` when `reorder` is set.
+static void BuildStep(PassTestHelper* helper, bool reorder) {
+  helper->graph()->SetBlockIdx(1);
+  helper->Input<float>("cache", {3, 2, 4});
+  helper->Var("t", PRECISION(kFloat));
+  helper->Var("y", PRECISION(kFloat));
+  if (reorder) {
+    helper->Input<int64_t>("index", {3}, {2, 0, 0});
+    helper->Op(GatherDesc("cache", "index", "t"));
+  } else {
+    helper->Input<float>("x", {3, 1, 4});
+    helper->Op(ConcatDesc("cache", "x", "t", 1));
+  }
+  helper->Op(ScaleDesc("t", "y"));
+  WriteBack(helper, "t", "cache");
+}
+
+// Runs a few steps without and with the pass, and checks that the cache and
+// the output read through t are the same.
+static void CheckSteps(bool reorder, const std::string& fused_op) {
+  PassTestHelper reference;
+  PassTestHelper fused;
+  BuildStep(&reference, reorder);
+  BuildStep(&fused, reorder);
+  KVCacheFusePass().Apply(fused.mutable_graph());
+  fused.graph()->CheckValid();
+  EXPECT_EQ(fused.OpTypes(), (std::vector<std::string>{fused_op, "scale"}));
+
+  for (int step = 0; step < 4; ++step) {
+    if (!reorder) {
+      for (auto* helper : {&reference, &fused}) {
+        auto* x = helper->scope()->FindMutableTensor("x");
+        auto* x_data = x->mutable_data<float>();
+        for (int64_t i = 0; i < x->numel(); ++i) {
+          x_data[i] = step * 100.f + i;
+        }
+      }
+    }
+    reference.Run();
+    fused.Run();
+    for (auto name : {"cache", "y"}) {
+      auto expected = reference.Output<float>(name);
+      auto actual = fused.Output<float>(name);
+      ASSERT_EQ(actual.size(), expected.size()) << name << " step " << step;
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << name << " step " << step;
+      }
+    }
+  }
+}
+
+TEST(kv_cache_fuse_pass, fuse_append) {
+  CheckSteps(false, "kv_cache_append");
+}
+
+TEST(kv_cache_fuse_pass, fuse_reorder) {
+  CheckSteps(true, "kv_cache_reorder");
+}
+
+TEST(kv_cache_fuse_pass, skip_root_block) {
+  PassTestHelper helper;
+  BuildStep(&helper, false);
+  helper.graph()->SetBlockIdx(kRootBlockIdx);
+  KVCacheFusePass().Apply(helper.mutable_graph());
+  EXPECT_EQ(helper.FindOp("kv_cache_append"), nullptr);
+}
+
+TEST(kv_cache_fuse_pass, skip_cache_read_by_other_ops) {
+  PassTestHelper helper;
+  BuildStep(&helper, false);
+  // The old content of the cache is still read after the append.
+  helper.Var("z", PRECISION(kFloat));
+  helper.Op(ScaleDesc("cache", "z"));
+  KVCacheFusePass().Apply(helper.mutable_graph());
+  EXPECT_EQ(helper.FindOp("kv_cache_append"), nullptr);
+  EXPECT_NE(helper.FindOp("concat"), nullptr);
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,104 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/fusion/optimizer_fuse_pass.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/pattern_matcher.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void OptimizerFusePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The fused op is only built with LITE_WITH_TRAIN.
+  if (!LiteOpRegistry::Global().Create("fusion_optimizer")) return;
+
+  // Group the sgd ops by learning rate, the nodes are removed while fusing.
+  std::map<std::string, std::vector<Node*>> groups;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt() || node->AsStmt().op_type() != "sgd") continue;
+    const auto* op_info = node->AsStmt().op_info();
+    groups[op_info->Input("LearningRate").front()].push_back(node);
+  }
+
+  for (auto& group : groups) {
+    if (group.second.size() < 2) continue;
+    FuseOptimizers(graph.get(), group.second);
+    VLOG(4) << "fused " << group.second.size() << " sgd ops with learning rate "
+            << group.first;
+  }
+}
+
+void OptimizerFusePass::FuseOptimizers(SSAGraph* graph,
+                                       const std::vector<Node*>& nodes) {
+  std::vector<std::string> params, grads, param_outs;
+  std::vector<Node*> inputs, outputs;
+  std::set<Node*> linked;
+  std::set<const Node*> nodes2rm;
+  for (auto* node : nodes) {
+    const auto* op_info = node->AsStmt().op_info();
+    params.push_back(op_info->Input("Param").front());
+    grads.push_back(op_info->Input("Grad").front());
+    param_outs.push_back(op_info->Output("ParamOut").front());
+    // The learning rate is read by all the ops, link it once.
+    for (auto* in : node->inlinks) {
+      if (linked.insert(in).second) inputs.push_back(in);
+    }
+    for (auto* out : node->outlinks) {
+      outputs.push_back(out);
+    }
+    nodes2rm.insert(node);
+  }
+  const auto* head_info = nodes.front()->AsStmt().op_info();
+
+  cpp::OpDesc op_desc;
+  op_desc.SetType("fusion_optimizer");
+  op_desc.SetInput("Param", params);
+  op_desc.SetInput("Grad", grads);
+  op_desc.SetInput("LearningRate", {head_info->Input("LearningRate").front()});
+  op_desc.SetOutput("ParamOut", param_outs);
+  op_desc.SetAttr<std::string>("optimizer_type", "sgd");
+  op_desc.SetAttr<int>("accumulate_steps", 1);
+
+  auto old_op = nodes.front()->AsStmt().op();
+  auto* scope = old_op->scope();
+  auto& valid_places = old_op->valid_places();
+  auto op = LiteOpRegistry::Global().Create("fusion_optimizer");
+  op->Attach(op_desc, scope);
+  auto* new_op_node = graph->GraphCreateInstructNode(op, valid_places);
+  GraphSafeRemoveNodes(graph, nodes2rm);
+
+  for (auto* in : inputs) {
+    DirectedLink(in, new_op_node);
+  }
+  for (auto* out : outputs) {
+    DirectedLink(new_op_node, out);
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_optimizer_fuse_pass,
+                  paddle::lite::mir::OptimizerFusePass)
+    .BindTargets({TARGET(kARM)})
+    .BindKernel("fusion_optimizer");
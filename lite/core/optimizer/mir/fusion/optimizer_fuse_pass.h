@@ -0,0 +1,47 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * mir::OptimizerFusePass
+ * Replaces the sgd ops of a training program, one per parameter, by a single
+ * fusion_optimizer op for every learning rate, e.g.
+ *   sgd(w0, w0@GRAD, lr), sgd(w1, w1@GRAD, lr), ...
+ *     -> fusion_optimizer(optimizer_type = "sgd", Param = {w0, w1, ...})
+ * The fused kernel updates all the parameters in one parallel loop instead
+ * of launching a kernel per parameter.
+ */
+class OptimizerFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  void FuseOptimizers(SSAGraph* graph, const std::vector<Node*>& nodes);
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
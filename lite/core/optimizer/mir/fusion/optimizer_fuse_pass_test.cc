@@ -0,0 +1,102 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/optimizer_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc SGDDesc(const std::string& param,
+                           const std::string& grad,
+                           const std::string& lr) {
+  cpp::OpDesc desc;
+  desc.SetType("sgd");
+  desc.SetInput("Param", {param});
+  desc.SetInput("Grad", {grad});
+  desc.SetInput("LearningRate", {lr});
+  desc.SetOutput("ParamOut", {param + "_out"});
+  return desc;
+}
+
+static std::vector<std::string> NodeNames(const std::list<Node*>& nodes) {
+  std::vector<std::string> names;
+  for (auto* node : nodes) names.push_back(node->AsArg().name);
+  return names;
+}
+
+TEST(optimizer_fuse_pass, group_sgd_by_learning_rate) {
+  PassTestHelper helper({Place{TARGET(kARM)}, Place{TARGET(kHost)}});
+  for (auto lr : {"lr0", "lr1", "lr2"}) helper.Weight<float>(lr, {1});
+  // w0 and w2 share lr0, w1 and w3 share lr1, w4 has lr2 of its own
+  const std::vector<std::string> lrs{"lr0", "lr1", "lr0", "lr1", "lr2"};
+  for (size_t i = 0; i < lrs.size(); ++i) {
+    const auto w = "w" + std::to_string(i);
+    helper.Weight<float>(w, {4, 3});
+    helper.Input<float>(w + "@GRAD", {4, 3});
+    helper.Op(SGDDesc(w, w + "@GRAD", lrs[i]));
+  }
+
+  OptimizerFusePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+
+  std::vector<Node*> fused;
+  int num_sgd = 0;
+  for (auto* node : helper.graph()->StmtTopologicalOrder()) {
+    const auto& op_type = node->AsStmt().op_type();
+    if (op_type == "fusion_optimizer") fused.push_back(node);
+    if (op_type == "sgd") ++num_sgd;
+  }
+  ASSERT_EQ(fused.size(), 2u);
+  EXPECT_EQ(num_sgd, 1);
+  EXPECT_EQ(helper.FindOp("sgd")->AsStmt().op_info()->Input("LearningRate"),
+            std::vector<std::string>{"lr2"});
+
+  for (auto* node : fused) {
+    const auto* op_info = node->AsStmt().op_info();
+    const auto lr = op_info->Input("LearningRate");
+    ASSERT_EQ(lr.size(), 1u);
+    const auto first = lr.front() == "lr0" ? 0 : 1;
+    const std::vector<std::string> params{"w" + std::to_string(first),
+                                          "w" + std::to_string(first + 2)};
+    EXPECT_EQ(op_info->Input("Param"), params);
+    EXPECT_EQ(op_info->Input("Grad"),
+              (std::vector<std::string>{params[0] + "@GRAD",
+                                        params[1] + "@GRAD"}));
+    EXPECT_EQ(op_info->Output("ParamOut"),
+              (std::vector<std::string>{params[0] + "_out",
+                                        params[1] + "_out"}));
+    EXPECT_EQ(op_info->GetAttr<std::string>("optimizer_type"), "sgd");
+    // The shared learning rate is linked once.
+    auto inputs = NodeNames(node->inlinks);
+    EXPECT_EQ(std::count(inputs.begin(), inputs.end(), lr.front()), 1);
+    EXPECT_EQ(inputs.size(), 5u);
+    auto outputs = NodeNames(node->outlinks);
+    std::sort(outputs.begin(), outputs.end());
+    EXPECT_EQ(outputs, op_info->Output("ParamOut"));
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_OP(sgd);
+USE_LITE_OP(fusion_optimizer);
@@ -0,0 +1,67 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/residual_add_activation_fuse_pass.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/fusion/residual_add_activation_fuser.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void ResidualAddActivationFusePass::Apply(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // Only the x86 kernels consume a fused residual.
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kX86) && place.target != TARGET(kHost) &&
+        place.target != TARGET(kAny)) {
+      return;
+    }
+  }
+
+  std::vector<std::string> op_type_cases{
+      "conv2d", "depthwise_conv2d", "fc", "matmul"};
+  std::vector<std::string> add_input_cases{"X", "Y"};
+  // Match the longest chains first, "" fuses the bare elementwise_add.
+  std::vector<std::string> act_type_cases{"relu",
+                                          "relu6",
+                                          "leaky_relu",
+                                          "hard_swish",
+                                          "swish",
+                                          "sigmoid",
+                                          "tanh",
+                                          "gelu",
+                                          ""};
+  for (auto& op_type : op_type_cases) {
+    for (auto& add_input : add_input_cases) {
+      for (auto& act_type : act_type_cases) {
+        VLOG(4) << " op_type: " << op_type << "  add_input: " << add_input
+                << "  act_type: " << act_type;
+        fusion::ResidualAddActivationFuser fuser(op_type, add_input, act_type);
+        fuser.apply_impl(graph.get());
+      }
+    }
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(lite_residual_add_activation_fuse_pass,
+                  paddle::lite::mir::ResidualAddActivationFusePass)
+    .BindTargets({TARGET(kX86)});
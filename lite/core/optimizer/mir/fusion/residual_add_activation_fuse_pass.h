@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// This pass folds the residual elementwise_add that follows conv2d,
+// depthwise_conv2d, fc or matmul, and the activation after it, into the
+// producing op. The x86 kernels then add the residual in the same sweep over
+// the output as bias and activation, instead of running elementwise_add and
+// the activation as two more kernels.
+//
+// For example:
+//
+//       |                          |
+//     conv2d                       A
+//       |                          |
+//       ----- elementwise_add -----
+//                  |
+//                relu
+//                  |
+//                  V
+//
+// After the pass is applied:
+//
+//       |                          |
+//       |                          A
+//       |                          |
+//       ----------- conv2d --------
+//                     |
+//                     V
+//
+// The fused op reads A from "SecondInput", and "fuse_elementwise_op_type"
+// together with the "elementwise_act_*" attributes describe the epilogue.
+//
+// Limitations:
+// * elementwise_add must use axis -1, A may broadcast onto the op output
+//   but not enlarge it.
+// * Quantized ops, conv with prelu and fc with an activation other than relu
+//   are left alone.
+// * Only applied when every valid place is x86.
+
+class ResidualAddActivationFusePass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
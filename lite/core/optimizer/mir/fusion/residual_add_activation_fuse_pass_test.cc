@@ -0,0 +1,199 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/residual_add_activation_fuse_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static cpp::OpDesc Conv2dDesc(const std::string& x,
+                              const std::string& filter,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("conv2d");
+  desc.SetInput("Input", {x});
+  desc.SetInput("Filter", {filter});
+  desc.SetOutput("Output", {out});
+  desc.SetAttr("strides", std::vector<int>{1, 1});
+  desc.SetAttr("paddings", std::vector<int>{0, 0});
+  desc.SetAttr("dilations", std::vector<int>{1, 1});
+  desc.SetAttr("groups", 1);
+  return desc;
+}
+
+static cpp::OpDesc FcDesc(const std::string& x,
+                          const std::string& w,
+                          const std::string& bias,
+                          const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("fc");
+  desc.SetInput("Input", {x});
+  desc.SetInput("W", {w});
+  desc.SetInput("Bias", {bias});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("in_num_col_dims", 1);
+  return desc;
+}
+
+static cpp::OpDesc MatmulDesc(const std::string& x,
+                              const std::string& y,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("matmul");
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("transpose_X", false);
+  desc.SetAttr("transpose_Y", false);
+  desc.SetAttr("alpha", 1.f);
+  return desc;
+}
+
+static cpp::OpDesc AddDesc(const std::string& x,
+                           const std::string& y,
+                           const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("elementwise_add");
+  desc.SetInput("X", {x});
+  desc.SetInput("Y", {y});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("axis", -1);
+  return desc;
+}
+
+static cpp::OpDesc ActDesc(const std::string& op_type,
+                           const std::string& x,
+                           const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  if (op_type == "leaky_relu") desc.SetAttr("alpha", 0.1f);
+  return desc;
+}
+
+// Runs the program before and after the pass, and checks that `out` is the
+// same.
+static void ApplyAndCompare(PassTestHelper* helper, const std::string& out) {
+  helper->Run();
+  auto expected = helper->Output<float>(out);
+  ResidualAddActivationFusePass().Apply(helper->mutable_graph());
+  helper->graph()->CheckValid();
+  helper->Run();
+  auto actual = helper->Output<float>(out);
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(actual[i], expected[i], 1e-5) << out << " at " << i;
+  }
+}
+
+static size_t CountLinks(const std::list<Node*>& links, const Node* node) {
+  return std::count(links.begin(), links.end(), node);
+}
+
+// conv(x) + x: x feeds the fused conv twice, through one link.
+TEST(residual_add_activation_fuse_pass, fuse_conv_with_its_input) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {1, 4, 5, 5});
+  helper.Weight<float>("filter", {4, 4, 1, 1});
+  helper.Op(Conv2dDesc("x", "filter", "c"));
+  helper.Op(AddDesc("c", "x", "s"));
+  helper.Op(ActDesc("relu", "s", "y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"conv2d"}));
+  auto* conv = helper.FindOp("conv2d");
+  auto* op_info = conv->AsStmt().op_info();
+  EXPECT_EQ(op_info->Input("SecondInput"), (std::vector<std::string>{"x"}));
+  EXPECT_EQ(op_info->Output("Output"), (std::vector<std::string>{"y"}));
+  EXPECT_EQ(op_info->GetAttr<std::string>("elementwise_act_type"), "relu");
+  auto* x = helper.Var("x");
+  EXPECT_EQ(CountLinks(conv->inlinks, x), 1u);
+  EXPECT_EQ(CountLinks(x->outlinks, conv), 1u);
+}
+
+// The bias of a row broadcasts over the batch of the fc.
+TEST(residual_add_activation_fuse_pass, fuse_fc_with_broadcast_residual) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {4, 8});
+  helper.Weight<float>("w", {8, 6});
+  helper.Weight<float>("b", {6});
+  helper.Input<float>("r", {6});
+  helper.Op(FcDesc("x", "w", "b", "f"));
+  helper.Op(AddDesc("f", "r", "y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"fc"}));
+  auto* op_info = helper.FindOp("fc")->AsStmt().op_info();
+  EXPECT_EQ(op_info->GetAttr<std::string>("fuse_elementwise_op_type"),
+            "elementwise_add");
+}
+
+// The residual is the X of the add, and leaky_relu carries its alpha over.
+TEST(residual_add_activation_fuse_pass, fuse_matmul_with_activation) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {2, 3, 4});
+  helper.Weight<float>("w", {4, 5});
+  helper.Input<float>("r", {2, 3, 5});
+  helper.Op(MatmulDesc("x", "w", "m"));
+  helper.Op(AddDesc("r", "m", "s"));
+  helper.Op(ActDesc("leaky_relu", "s", "y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(), (std::vector<std::string>{"matmul"}));
+  auto* op_info = helper.FindOp("matmul")->AsStmt().op_info();
+  EXPECT_EQ(op_info->GetAttr<std::string>("elementwise_act_type"),
+            "leaky_relu");
+  EXPECT_FLOAT_EQ(op_info->GetAttr<float>("elementwise_act_alpha"), 0.1f);
+}
+
+// The residual broadcasts the output of the fc to a larger shape.
+TEST(residual_add_activation_fuse_pass, skip_larger_residual) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {4, 8});
+  helper.Weight<float>("w", {8, 6});
+  helper.Weight<float>("b", {6});
+  helper.Input<float>("r", {2, 4, 6});
+  helper.Op(FcDesc("x", "w", "b", "f"));
+  helper.Op(AddDesc("f", "r", "y"));
+  ApplyAndCompare(&helper, "y");
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"fc", "elementwise_add"}));
+}
+
+// The outputs were never shaped, so the pass can't tell a broadcast.
+TEST(residual_add_activation_fuse_pass, skip_unknown_dims) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {4, 8});
+  helper.Weight<float>("w", {8, 6});
+  helper.Weight<float>("b", {6});
+  helper.Input<float>("r", {4, 6});
+  helper.Op(FcDesc("x", "w", "b", "f"));
+  helper.Op(AddDesc("f", "r", "y"));
+  ResidualAddActivationFusePass().Apply(helper.mutable_graph());
+  helper.graph()->CheckValid();
+  EXPECT_EQ(helper.OpTypes(),
+            (std::vector<std::string>{"fc", "elementwise_add"}));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,159 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/fusion/residual_add_activation_fuser.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+std::string ResidualAddActivationFuser::OutputSlot() const {
+  return (op_type_ == "conv2d" || op_type_ == "depthwise_conv2d") ? "Output"
+                                                                   : "Out";
+}
+
+void ResidualAddActivationFuser::BuildPattern() {
+  const std::string residual_input = add_input_ == "X" ? "Y" : "X";
+  const std::string op_type = op_type_;
+
+  // The op is not fused yet, runs in fp32 and its own activation can be
+  // replayed by the x86 epilogue.
+  auto op_teller = [op_type](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->AsStmt().op_info();
+    if (op_info->HasAttr("fuse_elementwise_op_type")) return false;
+    if (op_info->HasAttr("enable_int8") &&
+        op_info->GetAttr<bool>("enable_int8")) {
+      return false;
+    }
+    if (op_type == "fc") {
+      std::string act_type =
+          op_info->HasAttr("activation_type")
+              ? op_info->GetAttr<std::string>("activation_type")
+              : "";
+      return act_type.empty() || act_type == "relu";
+    }
+    if (op_info->HasAttr("with_act") && op_info->GetAttr<bool>("with_act")) {
+      return op_info->GetAttr<std::string>("act_type") != "prelu";
+    }
+    return true;
+  };
+  // Limitation of elementwise
+  auto add_teller = [](const Node* node) -> bool {
+    auto* op_info = const_cast<Node*>(node)->AsStmt().op_info();
+    bool enable_int8 = op_info->HasAttr("enable_int8") &&
+                       op_info->GetAttr<bool>("enable_int8");
+    return op_info->GetAttr<int>("axis") == -1 &&
+           !op_info->HasAttr("fuse_scale") && !op_info->HasAttr("act_type") &&
+           !enable_int8;
+  };
+
+  auto* op = OpNode("op", op_type_)
+                 ->assert_is_op(op_type_)
+                 ->assert_node_satisfied(op_teller);
+  auto* op_out = VarNode("op_out")
+                     ->assert_is_op_output(op_type_, OutputSlot())
+                     ->assert_is_op_input("elementwise_add", add_input_)
+                     ->assert_only_one_output();
+  auto* residual = VarNode("residual")
+                       ->assert_is_op_input("elementwise_add", residual_input)
+                       ->AsInput();
+  auto* add = OpNode("add", "elementwise_add")
+                  ->assert_is_op("elementwise_add")
+                  ->assert_node_satisfied(add_teller);
+  auto* add_out =
+      VarNode("add_out")->assert_is_op_output("elementwise_add", "Out");
+
+  *op >> *op_out;
+  add->LinksFrom({op_out, residual}).LinksTo({add_out});
+  if (!act_type_.empty()) {
+    add_out->assert_is_op_input(act_type_, "X")->assert_only_one_output();
+    auto* act = OpNode("act", act_type_)->assert_is_op(act_type_);
+    auto* act_out = VarNode("act_out")->assert_is_op_output(act_type_, "Out");
+    *add_out >> *act >> *act_out;
+  }
+}
+
+void ResidualAddActivationFuser::InsertNewNode(SSAGraph* graph,
+                                               const key2nodes_t& matched) {
+  auto* op_node = matched.at("op");
+  auto* op_out = matched.at("op_out");
+  auto* residual = matched.at("residual");
+  auto* out = matched.at(act_type_.empty() ? "add_out" : "act_out");
+  if (residual == op_out) return;
+
+  // The fused op keeps its own output shape, so the residual must not
+  // broadcast it to a larger one. Without the dims of the var descs this
+  // can't be told, skip these too.
+  auto* scope = op_node->stmt()->op()->scope();
+  auto GetTensorDims = [scope](const Node* var_node) {
+    auto* var = scope->FindVar(var_node->arg()->name);
+    return var ? var->Get<Tensor>().dims() : DDim();
+  };
+  auto op_out_dims = GetTensorDims(op_out);
+  auto out_dims = GetTensorDims(out);
+  if (op_out_dims.empty() || out_dims.empty() || op_out_dims != out_dims) {
+    VLOG(4) << "Output dims of " << op_type_ << " " << op_out_dims
+            << " differ from the residual sum " << out_dims
+            << ". Skip this fusion!";
+    return;
+  }
+
+  auto op_info = *op_node->stmt()->op_info();
+  op_info.SetInput("SecondInput", {residual->arg()->name});
+  op_info.SetOutput(OutputSlot(), {out->arg()->name});
+  if (act_type_.empty()) {
+    op_info.SetAttr<std::string>("fuse_elementwise_op_type",
+                                 "elementwise_add");
+  } else {
+    op_info.SetAttr<std::string>("fuse_elementwise_op_type",
+                                 "fusion_elementwise_add_activation");
+    op_info.SetAttr<std::string>("elementwise_act_type", act_type_);
+    // Carry the activation attributes over, read back by
+    // operators::ParseElementwiseActivation.
+    auto* act_info = matched.at("act")->stmt()->op_info();
+    for (const std::string name : {"alpha", "threshold", "scale", "offset",
+                                   "beta"}) {
+      if (act_info->HasAttr(name) &&
+          act_info->GetAttrType(name) == OpDescAPI::AttrType::FLOAT) {
+        op_info.SetAttr<float>("elementwise_act_" + name,
+                               act_info->GetAttr<float>(name));
+      }
+    }
+    if (act_info->HasAttr("approximate")) {
+      op_info.SetAttr<bool>("elementwise_act_approximate",
+                            act_info->GetAttr<bool>("approximate"));
+    }
+    nodes2rm_.insert(matched.at("add_out"));
+    nodes2rm_.insert(matched.at("act"));
+  }
+  op_node->stmt()->ResetOp(op_info, graph->valid_places());
+
+  // the residual may already feed the op, e.g. conv(x) + x
+  if (std::find(op_node->inlinks.begin(), op_node->inlinks.end(), residual) ==
+      op_node->inlinks.end()) {
+    DirectedLink(residual, op_node);
+  }
+  DirectedLink(op_node, out);
+  nodes2rm_.insert(op_out);
+  nodes2rm_.insert(matched.at("add"));
+}
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,65 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <memory>
+#include <set>
+#include <string>
+#include "lite/core/optimizer/mir/pattern_matcher_high_api.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+namespace fusion {
+
+// Folds `elementwise_add(op(...), residual)` and an optional activation after
+// it into `op`, which then reads the residual from "SecondInput".
+// `add_input` is the slot ("X" or "Y") of elementwise_add taking the output
+// of `op`, `act_type` is empty when no activation follows.
+class ResidualAddActivationFuser : public FuseBase {
+ public:
+  ResidualAddActivationFuser(const std::string& op_type,
+                             const std::string& add_input,
+                             const std::string& act_type)
+      : op_type_(op_type), add_input_(add_input), act_type_(act_type) {}
+
+  size_t apply_impl(SSAGraph* graph) {
+    BuildPattern();
+    PerformPatternMatcher(graph);
+
+    for (const auto& matched : key2nodes_) {
+      InsertNewNode(graph, matched);
+    }
+
+    GraphSafeRemoveNodes(graph, nodes2rm_);
+    return key2nodes_.size();
+  }
+
+  void BuildPattern() override;
+  void InsertNewNode(SSAGraph* graph, const key2nodes_t& matched) override;
+
+ private:
+  std::string OutputSlot() const;
+
+  std::string op_type_;
+  std::string add_input_;
+  std::string act_type_;
+  std::set<const Node*> nodes2rm_;
+};
+
+}  // namespace fusion
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -74,6 +74,9 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
       "fetch",
       "cast",
       "expand",
+      // the caches are updated in place and must survive across runs
+      "kv_cache_append",
+      "kv_cache_reorder",
   };
 
   auto insert_invalid_op_nodes_for_specific_target = [&](
@@ -122,6 +125,17 @@ void MemoryOptimizePass::CollectLifeCycleByDevice(
       }
       continue;
     }
+    // The inputs and outputs of concat and split may be views of each other
+    if (op_info->HasAttr("use_buffer_view") &&
+        op_info->GetAttr<bool>("use_buffer_view")) {
+      for (auto in_var_node : op_node->inlinks) {
+        invalid_var_names.insert(in_var_node->AsArg().name);
+      }
+      for (auto out_var_node : op_node->outlinks) {
+        invalid_var_names.insert(out_var_node->AsArg().name);
+      }
+      continue;
+    }
     // The specified input and output variables of the Ops whose 'inplace' attr
     // is true will not be reused, such as reshape/reshape2's X and Out
     // variables
@@ -243,6 +257,70 @@ void MemoryOptimizePass::MakeReusePlan(
   }
 }
 
+bool MemoryOptimizePass::IsTrainingProgram(SSAGraph* graph) const {
+  const std::string grad_suffix = "_grad";
+  for (auto& op_node : graph->StmtTopologicalOrder()) {
+    if (!op_node->IsStmt()) continue;
+    const auto op_type = op_node->AsStmt().op_type();
+    if (op_type == "sgd" || op_type == "fusion_optimizer") return true;
+    if (op_type.size() > grad_suffix.size() &&
+        op_type.compare(op_type.size() - grad_suffix.size(),
+                        grad_suffix.size(),
+                        grad_suffix) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MemoryOptimizePass::MakeTrainingReusePlan(
+    const lifecycle_map_t& lifecycles,
+    std::map<std::string, std::string>* node2cluster) {
+  // A var and its gradient have the same shape, sharing a buffer between
+  // them does not grow it.
+  auto base_name = [](const std::string& name) -> std::string {
+    auto pos = name.find("@GRAD");
+    return pos == std::string::npos ? name : name.substr(0, pos);
+  };
+  std::vector<std::pair<std::string, lifecycle_t>> vars(lifecycles.begin(),
+                                                        lifecycles.end());
+  std::stable_sort(vars.begin(),
+                   vars.end(),
+                   [](const std::pair<std::string, lifecycle_t>& a,
+                      const std::pair<std::string, lifecycle_t>& b) {
+                     return a.second.first < b.second.first;
+                   });
+  // Visiting the vars by the start of their lifetime and taking any free
+  // cluster uses as many clusters as vars live at the peak, the forward
+  // activations become free right after their last backward use.
+  struct Cluster {
+    std::string name;
+    int free_at;
+    std::set<std::string> bases;
+  };
+  std::vector<Cluster> clusters;
+  for (auto& var : vars) {
+    const auto base = base_name(var.first);
+    int picked = -1;
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      if (clusters[i].free_at >= var.second.first) continue;
+      if (picked < 0 || clusters[i].bases.count(base)) {
+        picked = i;
+        if (clusters[i].bases.count(base)) break;
+      }
+    }
+    if (picked < 0) {
+      picked = clusters.size();
+      clusters.push_back(Cluster{var.first, -1, {}});
+    }
+    clusters[picked].free_at = var.second.second;
+    clusters[picked].bases.insert(base);
+    (*node2cluster)[var.first] = clusters[picked].name;
+  }
+  LOG(INFO) << "training step, " << vars.size() << " vars in "
+            << clusters.size() << " clusters";
+}
+
 void MemoryOptimizePass::PerformReusePlan(
     SSAGraph* graph, const std::map<std::string, std::string>& reuse_table) {
   int node_append_idx = 0;
@@ -330,11 +408,19 @@ void MemoryOptimizePass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   // name of var and the value in the table represents the current name of var.
   // 3. Perform reuse plan: Replace all var's name in the model according to the
   // mapping table.
+  // A training step(with grad or optimizer ops) holds the forward activations
+  // until the backward ops, it is planned in the order of the lifetimes.
+  if (!enabled_) return;
+  is_training_ = IsTrainingProgram(graph.get());
   std::map<std::string, lifecycle_map_t> lifecycles;
   CollectLifeCycleByDevice(&lifecycles, graph.get());
   for (auto& ele : lifecycles) {
     std::map<std::string, std::string> node2cluster;
-    MakeReusePlan(ele.second, &node2cluster);
+    if (is_training_) {
+      MakeTrainingReusePlan(ele.second, &node2cluster);
+    } else {
+      MakeReusePlan(ele.second, &node2cluster);
+    }
     PerformReusePlan(graph.get(), node2cluster);
   }
 }
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#ifdef PADDLE_WITH_TESTING
+#include <gtest/gtest_prod.h>
+#endif
+
 #include <algorithm>
 #include <limits>
 #include <list>
@@ -40,16 +44,32 @@ class MemoryOptimizePass : public ProgramPass {
   using lifecycle_map_t = std::map<std::string, lifecycle_t>;
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
 
+  // The reuse renames the variables, so it's turned off while the predictor
+  // calibrates the activations by their names.
+  void SetEnabled(bool enabled) { enabled_ = enabled; }
+  bool enabled() const { return enabled_; }
+
  private:
+#ifdef PADDLE_WITH_TESTING
+  FRIEND_TEST(memory_optimize_pass, training_plan_no_overlap);
+  FRIEND_TEST(memory_optimize_pass, training_plan_pairs_gradients);
+#endif
+
   void CollectLifeCycleByDevice(
       std::map<std::string, lifecycle_map_t>* lifecycles, SSAGraph*);
   void MakeReusePlan(const lifecycle_map_t& lifecycles,
                      std::map<std::string, std::string>* node2cluster);
+  // Plan of a training step, see Apply().
+  void MakeTrainingReusePlan(const lifecycle_map_t& lifecycles,
+                             std::map<std::string, std::string>* node2cluster);
+  bool IsTrainingProgram(SSAGraph* graph) const;
   void PerformReusePlan(SSAGraph* graph,
                         const std::map<std::string, std::string>& reuse_table);
 
  private:
   int max_lifecycle_{-1};
+  bool is_training_{false};
+  bool enabled_{true};
 };
 
 }  // namespace mir
@@ -0,0 +1,105 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The most vars alive at the same time, lifetimes include both ends.
+static int PeakLiveVars(const MemoryOptimizePass::lifecycle_map_t& vars) {
+  int peak = 0;
+  for (auto& var : vars) {
+    const int t = var.second.first;
+    int live = 0;
+    for (auto& other : vars) {
+      if (other.second.first <= t && other.second.second >= t) ++live;
+    }
+    peak = std::max(peak, live);
+  }
+  return peak;
+}
+
+static void CheckNoOverlap(const MemoryOptimizePass::lifecycle_map_t& vars,
+                           const std::map<std::string, std::string>& plan) {
+  ASSERT_EQ(plan.size(), vars.size());
+  for (auto& a : vars) {
+    for (auto& b : vars) {
+      if (a.first >= b.first || plan.at(a.first) != plan.at(b.first)) {
+        continue;
+      }
+      EXPECT_TRUE(a.second.second < b.second.first ||
+                  b.second.second < a.second.first)
+          << a.first << " and " << b.first << " share "
+          << plan.at(a.first);
+    }
+  }
+}
+
+TEST(memory_optimize_pass, training_plan_no_overlap) {
+  std::mt19937 rng(1234);
+  for (int round = 0; round < 20; ++round) {
+    MemoryOptimizePass::lifecycle_map_t vars;
+    const int num = 10 + round * 5;
+    for (int i = 0; i < num; ++i) {
+      const int begin = rng() % 100;
+      const int end = begin + rng() % 30;
+      std::string name = "var" + std::to_string(i);
+      // some vars get the gradient naming of another var
+      if (i % 3 == 2) name = "var" + std::to_string(i - 2) + "@GRAD";
+      vars[name] = {begin, end};
+    }
+    std::map<std::string, std::string> plan;
+    MemoryOptimizePass pass;
+    pass.MakeTrainingReusePlan(vars, &plan);
+    CheckNoOverlap(vars, plan);
+    // First-fit in the order of the lifetimes needs no more buffers than
+    // vars are alive at the peak.
+    std::set<std::string> clusters;
+    for (auto& item : plan) clusters.insert(item.second);
+    EXPECT_EQ(static_cast<int>(clusters.size()), PeakLiveVars(vars));
+  }
+}
+
+TEST(memory_optimize_pass, training_plan_pairs_gradients) {
+  // Both a and x are free when x@GRAD starts, x@GRAD takes the buffer of x
+  // which has the same shape.
+  MemoryOptimizePass::lifecycle_map_t vars{{"a", {0, 2}},
+                                           {"x", {0, 2}},
+                                           {"y", {1, 6}},
+                                           {"x@GRAD", {3, 5}},
+                                           {"a@GRAD", {6, 8}},
+                                           {"y@GRAD", {7, 9}}};
+  std::map<std::string, std::string> plan;
+  MemoryOptimizePass pass;
+  pass.MakeTrainingReusePlan(vars, &plan);
+  CheckNoOverlap(vars, plan);
+  EXPECT_EQ(plan.at("x@GRAD"), plan.at("x"));
+  // x@GRAD ended at 5, but a@GRAD still finds the buffer of a.
+  EXPECT_EQ(plan.at("a@GRAD"), plan.at("a"));
+  EXPECT_EQ(plan.at("y@GRAD"), plan.at("y"));
+  EXPECT_NE(plan.at("a"), plan.at("x"));
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,76 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include <string>
+#include "lite/core/calibrator.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void MixedPrecisionPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (precisions_.empty()) return;
+  auto& quantizable_ops = Calibrator::quantizable_ops();
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto* op_info = node->stmt()->mutable_op_info();
+    PrecisionType precision = PRECISION(kFloat);
+    auto iter = quantizable_ops.find(op_info->Type());
+    if (iter != quantizable_ops.end() &&
+        op_info->HasOutput(iter->second.output) &&
+        !op_info->Output(iter->second.output).empty()) {
+      auto layer = precisions_.find(op_info->Output(iter->second.output)[0]);
+      if (layer != precisions_.end()) {
+        precision = layer->second;
+      }
+    }
+    switch (precision) {
+      case PRECISION(kFP16):
+        op_info->SetAttr<std::string>(kMixedPrecisionAttr, "fp16");
+        break;
+      case PRECISION(kInt8):
+        op_info->SetAttr<std::string>(kMixedPrecisionAttr, "int8");
+        break;
+      default:
+        op_info->SetAttr<std::string>(kMixedPrecisionAttr, "fp32");
+        break;
+    }
+  }
+}
+
+bool MixedPrecisionPass::MatchesPrecision(const OpInfo& op_info,
+                                          PrecisionType precision) {
+  if (!op_info.HasAttr(kMixedPrecisionAttr)) return true;
+  auto assigned = op_info.GetAttr<std::string>(kMixedPrecisionAttr);
+  switch (precision) {
+    case PRECISION(kFP16):
+      return assigned == "fp16";
+    case PRECISION(kFloat):
+      return assigned != "fp16";
+    case PRECISION(kInt8):
+      return assigned == "int8";
+    default:
+      return true;
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(mixed_precision_pass, paddle::lite::mir::MixedPrecisionPass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)});
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/api/paddle_place.h"
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+// The precision which the op is assigned to, one of "fp32", "fp16" and "int8".
+static const char kMixedPrecisionAttr[] = "__@mixed_precision@__";
+
+/*
+ * Assign the precisions of the layers by the plan of the mixed precision
+ * search. A layer is a quantizable op(see Calibrator) named by its output
+ * variable. The layers in the plan run in the given precision, and all of the
+ * other ops run in fp32, so the int8 layers are quantized by
+ * post_quant_static_pass, and static_kernel_pick_pass picks the fp16 or fp32
+ * kernels by the attribute.
+ */
+class MixedPrecisionPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetPrecisions(const std::map<std::string, PrecisionType>& precisions) {
+    precisions_ = precisions;
+  }
+  const std::map<std::string, PrecisionType>& precisions() const {
+    return precisions_;
+  }
+
+  // Whether a kernel of `precision` can be picked for the op.
+  static bool MatchesPrecision(const OpInfo& op_info, PrecisionType precision);
+
+ private:
+  std::map<std::string, PrecisionType> precisions_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,168 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/optimizer/mir/pass_test_helper.h"
+#include "lite/core/optimizer/mir/static_kernel_pick_pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+static bool Matches(const std::string& assigned, PrecisionType precision) {
+  cpp::OpDesc desc;
+  desc.SetType("conv2d");
+  if (!assigned.empty()) {
+    desc.SetAttr<std::string>(kMixedPrecisionAttr, assigned);
+  }
+  OpInfo op_info(desc);
+  return MixedPrecisionPass::MatchesPrecision(op_info, precision);
+}
+
+TEST(mixed_precision_pass, matches_precision) {
+  for (auto precision : {PRECISION(kFloat),
+                         PRECISION(kFP16),
+                         PRECISION(kInt8),
+                         PRECISION(kAny)}) {
+    EXPECT_TRUE(Matches("", precision));
+  }
+  EXPECT_TRUE(Matches("fp32", PRECISION(kFloat)));
+  EXPECT_FALSE(Matches("fp32", PRECISION(kFP16)));
+  EXPECT_FALSE(Matches("fp32", PRECISION(kInt8)));
+  EXPECT_TRUE(Matches("fp16", PRECISION(kFP16)));
+  EXPECT_FALSE(Matches("fp16", PRECISION(kFloat)));
+  EXPECT_FALSE(Matches("fp16", PRECISION(kInt8)));
+  // An int8 layer keeps its fp32 kernels for the ops not quantized by
+  // post_quant_static_pass.
+  EXPECT_TRUE(Matches("int8", PRECISION(kInt8)));
+  EXPECT_TRUE(Matches("int8", PRECISION(kFloat)));
+  EXPECT_FALSE(Matches("int8", PRECISION(kFP16)));
+  // Kernels of any precision serve every plan.
+  EXPECT_TRUE(Matches("fp16", PRECISION(kAny)));
+  EXPECT_TRUE(Matches("int8", PRECISION(kAny)));
+}
+
+static cpp::OpDesc Conv2dDesc(const std::string& x,
+                              const std::string& filter,
+                              const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("conv2d");
+  desc.SetInput("Input", {x});
+  desc.SetInput("Filter", {filter});
+  desc.SetOutput("Output", {out});
+  desc.SetAttr("strides", std::vector<int>{1, 1});
+  desc.SetAttr("paddings", std::vector<int>{0, 0});
+  desc.SetAttr("dilations", std::vector<int>{1, 1});
+  desc.SetAttr("groups", 1);
+  return desc;
+}
+
+static cpp::OpDesc FcDesc(const std::string& x,
+                          const std::string& w,
+                          const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("fc");
+  desc.SetInput("Input", {x});
+  desc.SetInput("W", {w});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("in_num_col_dims", 1);
+  return desc;
+}
+
+static cpp::OpDesc ReluDesc(const std::string& x, const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("relu");
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  return desc;
+}
+
+static std::string Assigned(PassTestHelper* helper,
+                            const std::string& op_type) {
+  auto* op_info = helper->FindOp(op_type)->AsStmt().op_info();
+  if (!op_info->HasAttr(kMixedPrecisionAttr)) return "";
+  return op_info->GetAttr<std::string>(kMixedPrecisionAttr);
+}
+
+// The layers are matched by their outputs, every other op runs in fp32.
+TEST(mixed_precision_pass, annotate_layers) {
+  PassTestHelper helper;
+  helper.Input<float>("x", {1, 4, 3, 3});
+  helper.Weight<float>("filter", {4, 4, 1, 1});
+  helper.Weight<float>("w", {36, 8});
+  helper.Op(Conv2dDesc("x", "filter", "c"));
+  helper.Op(FcDesc("c", "w", "f"));
+  helper.Op(ReluDesc("f", "y"));
+
+  MixedPrecisionPass pass;
+  pass.Apply(helper.mutable_graph());
+  EXPECT_EQ(Assigned(&helper, "conv2d"), "");
+  EXPECT_EQ(Assigned(&helper, "fc"), "");
+
+  pass.SetPrecisions({{"c", PRECISION(kInt8)}, {"f", PRECISION(kFP16)}});
+  pass.Apply(helper.mutable_graph());
+  EXPECT_EQ(Assigned(&helper, "conv2d"), "int8");
+  EXPECT_EQ(Assigned(&helper, "fc"), "fp16");
+  EXPECT_EQ(Assigned(&helper, "relu"), "fp32");
+
+  pass.SetPrecisions({{"y", PRECISION(kFP16)}});
+  pass.Apply(helper.mutable_graph());
+  EXPECT_EQ(Assigned(&helper, "conv2d"), "fp32");
+  EXPECT_EQ(Assigned(&helper, "fc"), "fp32");
+  EXPECT_EQ(Assigned(&helper, "relu"), "fp32");
+}
+
+#ifdef LITE_BUILD_EXTRA
+// Picks the kernel of a tile, which has host kernels in int8 and fp32,
+// after annotating it with `assigned`.
+static PrecisionType PickTile(const std::vector<Place>& places,
+                              const std::string& assigned) {
+  PassTestHelper helper(places);
+  helper.scope()->Var("x")->GetMutable<Tensor>();
+  cpp::OpDesc desc;
+  desc.SetType("tile");
+  desc.SetInput("X", {"x"});
+  desc.SetOutput("Out", {"y"});
+  desc.SetAttr("repeat_times", std::vector<int>{2});
+  if (!assigned.empty()) {
+    desc.SetAttr<std::string>(kMixedPrecisionAttr, assigned);
+  }
+  auto* node = helper.Op(desc);
+  StaticKernelPickPass().Apply(helper.mutable_graph());
+  auto& kernels = node->AsStmt().kernels();
+  CHECK_EQ(kernels.size(), 1u);
+  return kernels.front()->precision();
+}
+
+// The assigned precision wins over the order of the valid places.
+TEST(mixed_precision_pass, pick_kernels_of_assigned_precision) {
+  const std::vector<Place> int8_first{Place{TARGET(kHost), PRECISION(kInt8)},
+                                      Place{TARGET(kHost), PRECISION(kFloat)}};
+  const std::vector<Place> fp32_first{Place{TARGET(kHost), PRECISION(kFloat)},
+                                      Place{TARGET(kHost), PRECISION(kInt8)}};
+  EXPECT_EQ(PickTile(fp32_first, ""), PRECISION(kFloat));
+  EXPECT_EQ(PickTile(int8_first, "fp32"), PRECISION(kFloat));
+  // Without a kernel of the assigned precision, the best scored one is used.
+  EXPECT_EQ(PickTile(fp32_first, "fp16"), PRECISION(kFloat));
+}
+#endif  // LITE_BUILD_EXTRA
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
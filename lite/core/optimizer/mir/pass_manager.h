@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -82,6 +83,35 @@ class PassManager {
   std::map<std::string, mir::Pass*> pass_map_;
 };
 
+// Changes a setting of a registered pass until it goes out of scope, and then
+// restores the previous value, e.g.
+//   ScopedPassSetting<MemoryOptimizePass, bool> reuse("memory_optimize_pass",
+//       &MemoryOptimizePass::enabled, &MemoryOptimizePass::SetEnabled, false);
+// The passes are shared by all the predictors, the setting applies to every
+// predictor built in the scope, so they must not be built concurrently.
+template <typename PassTy, typename ValueTy>
+class ScopedPassSetting {
+ public:
+  template <typename Getter, typename Setter>
+  ScopedPassSetting(const std::string& name,
+                    Getter get,
+                    Setter set,
+                    const ValueTy& value) {
+    auto* pass = PassManager::Global().LookUp<PassTy>(name);
+    CHECK(pass) << "No pass named " << name;
+    ValueTy saved = (pass->*get)();
+    restore_ = [pass, set, saved] { (pass->*set)(saved); };
+    (pass->*set)(value);
+  }
+  ~ScopedPassSetting() { restore_(); }
+
+  ScopedPassSetting(const ScopedPassSetting&) = delete;
+  ScopedPassSetting& operator=(const ScopedPassSetting&) = delete;
+
+ private:
+  std::function<void()> restore_;
+};
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
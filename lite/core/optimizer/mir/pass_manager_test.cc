@@ -14,6 +14,7 @@
 
 #include "lite/core/optimizer/mir/pass_manager.h"
 #include <gtest/gtest.h>
+#include "lite/core/optimizer/mir/memory_optimize_pass.h"
 #include "lite/core/optimizer/mir/pass_registry.h"
 
 namespace paddle {
@@ -26,8 +27,34 @@ TEST(PassManager, test) {
   ASSERT_TRUE(pass != nullptr);
 }
 
+TEST(PassManager, scoped_pass_setting) {
+  auto* pass =
+      PassManager::Global().LookUp<MemoryOptimizePass>("memory_optimize_pass");
+  ASSERT_TRUE(pass != nullptr);
+  ASSERT_TRUE(pass->enabled());
+  {
+    ScopedPassSetting<MemoryOptimizePass, bool> outer(
+        "memory_optimize_pass",
+        &MemoryOptimizePass::enabled,
+        &MemoryOptimizePass::SetEnabled,
+        false);
+    EXPECT_FALSE(pass->enabled());
+    {
+      ScopedPassSetting<MemoryOptimizePass, bool> inner(
+          "memory_optimize_pass",
+          &MemoryOptimizePass::enabled,
+          &MemoryOptimizePass::SetEnabled,
+          true);
+      EXPECT_TRUE(pass->enabled());
+    }
+    EXPECT_FALSE(pass->enabled());
+  }
+  EXPECT_TRUE(pass->enabled());
+}
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
 
 USE_MIR_PASS(demo);
+USE_MIR_PASS(memory_optimize_pass);
@@ -0,0 +1,192 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/core/context.h"
+#include "lite/core/op_registry.h"
+#include "lite/core/optimizer/mir/ssa_graph.h"
+#include "lite/core/scope.h"
+#include "lite/operators/while_op.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+/*
+ * \brief   Builds a small SSAGraph op by op for the unit tests of the passes.
+ *
+ *  Every var gets a scope var and one argument node, so a name refers to
+ *  the same node wherever it is used. As in a Program, the weights live in
+ *  the root scope and the other vars in its exec scope. The ops get the kernels of
+ *  `valid_places`, and Run() executes the graph in topological order, which
+ *  lets the tests compare the outputs before and after a pass.
+ */
+class PassTestHelper {
+ public:
+  explicit PassTestHelper(
+      const std::vector<Place>& valid_places = {Place{TARGET(kX86)},
+                                                Place{TARGET(kHost)}})
+      : valid_places_(valid_places) {
+    graph_->SetValidPlaces(valid_places_);
+  }
+
+  SSAGraph* graph() { return graph_.get(); }
+  std::unique_ptr<SSAGraph>& mutable_graph() { return graph_; }
+  Scope* scope() { return exec_scope_; }
+  Scope* root_scope() { return &scope_; }
+
+  Node* Var(const std::string& name) {
+    auto it = vars_.find(name);
+    if (it != vars_.end()) return it->second;
+    // the type of the var is set by the first op attached to it
+    exec_scope_->Var(name);
+    auto* node = graph_->NewArgumentNode(name);
+    vars_[name] = node;
+    return node;
+  }
+
+  // Declares the data type of a var, as the var descs of a model do.
+  Node* Var(const std::string& name, PrecisionType precision) {
+    auto* node = Var(name);
+    node->AsArg().type =
+        LiteType::GetTensorTy(TARGET(kUnk), precision, DATALAYOUT(kUnk));
+    return node;
+  }
+
+  template <typename T>
+  Tensor* Input(const std::string& name,
+                const std::vector<int64_t>& dims,
+                const std::vector<T>& data = {}) {
+    Var(name, lite_api::PrecisionTypeTrait<T>::Type());
+    auto* tensor = exec_scope_->FindVar(name)->GetMutable<Tensor>();
+    tensor->Resize(dims);
+    auto* ptr = tensor->mutable_data<T>();
+    for (int64_t i = 0; i < tensor->numel(); ++i) {
+      ptr[i] = data.empty() ? static_cast<T>((i * 7) % 13 - 6) / 4
+                            : data[i % data.size()];
+    }
+    return tensor;
+  }
+
+  // A persistable input, marked as a weight in the graph.
+  template <typename T>
+  Tensor* Weight(const std::string& name,
+                 const std::vector<int64_t>& dims,
+                 const std::vector<T>& data = {}) {
+    scope_.Var(name);
+    auto* tensor = Input<T>(name, dims, data);
+    tensor->set_persistable(true);
+    Var(name)->AsArg().is_weight = true;
+    return tensor;
+  }
+
+  // `program_desc` holds the sub-blocks of a while op.
+  Node* Op(const cpp::OpDesc& desc,
+           std::shared_ptr<const cpp::ProgramDesc> program_desc = nullptr) {
+    for (auto& name : desc.input_vars()) Var(name);
+    for (auto& name : desc.output_vars()) Var(name);
+    auto op = LiteOpRegistry::Global().Create(desc.Type());
+    CHECK(op) << "no op " << desc.Type();
+    if (program_desc) {
+      CHECK_EQ(desc.Type(), "while");
+      static_cast<operators::WhileOp*>(op.get())->SetProgramDesc(program_desc);
+    }
+    op->Attach(desc, exec_scope_);
+    auto* node = graph_->GraphCreateInstructNode(op, valid_places_);
+    for (auto& name : desc.input_vars()) DirectedLink(Var(name), node);
+    for (auto& name : desc.output_vars()) DirectedLink(node, Var(name));
+    return node;
+  }
+
+  // The op types of the statements, in topological order.
+  std::vector<std::string> OpTypes() {
+    std::vector<std::string> types;
+    for (auto* node : graph_->StmtTopologicalOrder()) {
+      types.push_back(node->AsStmt().op_type());
+    }
+    return types;
+  }
+
+  Node* FindOp(const std::string& op_type) {
+    for (auto* node : graph_->StmtTopologicalOrder()) {
+      if (node->AsStmt().op_type() == op_type) return node;
+    }
+    return nullptr;
+  }
+
+  // Run every statement with the first kernel whose declared input
+  // precisions match the tensors, as the static kernel pick would.
+  void Run() {
+    for (auto* node : graph_->StmtTopologicalOrder()) {
+      auto& inst = node->AsStmt();
+      auto op = inst.op();
+      KernelBase* kernel = PickKernel(&inst);
+      CHECK(kernel) << "no kernel of " << inst.op_type();
+      op->AttachKernel(kernel);
+      if (!kernel->context()) {
+        kernel->SetContext(
+            ContextScheduler::Global().NewContext(kernel->target()));
+      }
+      CHECK(op->CheckShape());
+      CHECK(op->InferShape());
+      kernel->Launch();
+    }
+  }
+
+  template <typename T>
+  std::vector<T> Output(const std::string& name) {
+    const auto& tensor = exec_scope_->FindVar(name)->Get<Tensor>();
+    const T* data = tensor.data<T>();
+    return std::vector<T>(data, data + tensor.numel());
+  }
+
+ private:
+  KernelBase* PickKernel(Node::Stmt* inst) {
+    const auto* op_info = inst->op_info();
+    for (auto& kernel : inst->kernels()) {
+      bool matched = true;
+      for (auto& arg : op_info->InputArgumentNames()) {
+        const auto* decl = ParamTypeRegistry::Global().RetrieveInArgument(
+            kernel->place(), kernel->GenParamTypeKey(), arg);
+        if (!decl || !decl->type->IsTensor()) continue;
+        for (auto& name : op_info->Input(arg)) {
+          const auto& tensor = exec_scope_->FindVar(name)->Get<Tensor>();
+          auto precision = decl->type->precision();
+          if (precision != PRECISION(kAny) &&
+              precision != tensor.precision()) {
+            matched = false;
+          }
+        }
+      }
+      if (matched) return kernel.get();
+    }
+    return nullptr;
+  }
+
+  std::vector<Place> valid_places_;
+  Scope scope_;
+  Scope* exec_scope_{&scope_.NewScope()};
+  std::unique_ptr<SSAGraph> graph_{new SSAGraph};
+  std::map<std::string, Node*> vars_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -14,7 +14,13 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "lite/core/op_lite.h"
@@ -116,13 +122,66 @@ void PatternMatcher::operator()(SSAGraph *graph,
 bool PatternMatcher::MarkPMNodesInGraph(SSAGraph *graph) {
   VLOG(3) << "mark pmnodes in graph";
   if (graph->nodes().empty()) return false;
-  for (auto &node : graph->mutable_nodes()) {
-    for (const auto &pmnode : pattern_.nodes()) {
-      if (pmnode->Tell(&node)) {
-        pmnodes2nodes_[pmnode.get()].insert(&node);
+  // The PMNodes with an asserted op type only check the statements of that
+  // type, instead of every node of the graph.
+  std::map<std::string, std::vector<Node *>> op_index;
+  std::set<const PMNode *> anchors;
+  for (const auto &pmnode : pattern_.nodes()) {
+    const auto &op_type = pmnode->anchor_op_type();
+    if (op_type.empty()) continue;
+    if (anchors.empty()) op_index = graph->OpTypeIndex();
+    anchors.insert(pmnode.get());
+    auto it = op_index.find(op_type);
+    if (it == op_index.end()) continue;
+    for (auto *node : it->second) {
+      if (pmnode->Tell(node)) {
+        pmnodes2nodes_[pmnode.get()].insert(node);
       }
     }
   }
+  // A PMNode linked to an anchor can only match the neighbours of the nodes
+  // hit by that anchor, the others fall back to scanning the whole graph.
+  for (const auto &pmnode : pattern_.nodes()) {
+    if (anchors.count(pmnode.get())) continue;
+    const PMNode *anchor = nullptr;
+    bool from_anchor = false;
+    for (const auto &edge : pattern_.edges()) {
+      const PMNode *other = nullptr;
+      if (edge.second == pmnode.get() && anchors.count(edge.first)) {
+        other = edge.first;
+      } else if (edge.first == pmnode.get() && anchors.count(edge.second)) {
+        other = edge.second;
+      } else {
+        continue;
+      }
+      if (!anchor || pmnodes2nodes_[other].size() <
+                         pmnodes2nodes_[anchor].size()) {
+        anchor = other;
+        from_anchor = edge.first == other;
+      }
+    }
+    if (!anchor) {
+      for (auto &node : graph->mutable_nodes()) {
+        if (pmnode->Tell(&node)) {
+          pmnodes2nodes_[pmnode.get()].insert(&node);
+        }
+      }
+      continue;
+    }
+    std::set<Node *> candidates;
+    for (auto *node : pmnodes2nodes_[anchor]) {
+      const auto &links = from_anchor ? node->outlinks : node->inlinks;
+      candidates.insert(links.begin(), links.end());
+    }
+    for (auto *node : candidates) {
+      if (pmnode->Tell(node)) {
+        pmnodes2nodes_[pmnode.get()].insert(node);
+      }
+    }
+  }
+  for (auto it = pmnodes2nodes_.begin(); it != pmnodes2nodes_.end();) {
+    it = it->second.empty() ? pmnodes2nodes_.erase(it) : std::next(it);
+  }
   // Check to early stop if some PMNode can't find matched Node.
   for (auto &pmnode : pattern_.nodes()) {
     if (!pmnodes2nodes_.count(pmnode.get())) {
@@ -230,24 +289,74 @@ std::vector<PatternMatcher::subgraph_t> PatternMatcher::DetectPatterns() {
     cur_groups.clear();
     if (pre_groups.empty()) break;
     // source -> target
-    for (Node *source : pmnodes2nodes_[edge.first]) {
-      for (Node *target : pmnodes2nodes_[edge.second]) {
-        // TODO(Superjomn) add some prune strategies.
-        for (const auto &group : pre_groups) {
-          if (IsNodesLink(source, target)) {
-            HitGroup new_group = group;
-            bool flag = new_group.Match(source, edge.first) &&
-                        new_group.Match(target, edge.second);
-            if (flag) {
-              new_group.Register(source, edge.first);
-              new_group.Register(target, edge.second);
-              cur_groups.push_back(new_group);
-              // TODO(Superjomn) need to unique
+    // A group that already holds one end of the edge only needs to check the
+    // links of that node, the others try every linked pair of candidates.
+    auto &sources = pmnodes2nodes_[edge.first];
+    auto &targets = pmnodes2nodes_[edge.second];
+    std::vector<std::tuple<Node *, Node *, size_t>> hits;
+    std::vector<std::pair<Node *, Node *>> linked_pairs;
+    bool linked_pairs_ready = false;
+    for (size_t i = 0; i < pre_groups.size(); i++) {
+      const auto &roles = pre_groups[i].roles;
+      auto source_role = roles.find(edge.first);
+      auto target_role = roles.find(edge.second);
+      if (source_role != roles.end()) {
+        Node *source = source_role->second;
+        if (!sources.count(source)) continue;
+        for (Node *target : source->outlinks) {
+          if (targets.count(target)) hits.emplace_back(source, target, i);
+        }
+      } else if (target_role != roles.end()) {
+        Node *target = target_role->second;
+        if (!targets.count(target)) continue;
+        for (Node *source : target->inlinks) {
+          if (sources.count(source) && IsNodesLink(source, target)) {
+            hits.emplace_back(source, target, i);
+          }
+        }
+      } else {
+        if (!linked_pairs_ready) {
+          for (Node *source : sources) {
+            for (Node *target : source->outlinks) {
+              if (targets.count(target)) {
+                linked_pairs.emplace_back(source, target);
+              }
             }
           }
+          linked_pairs_ready = true;
+        }
+        for (const auto &pair : linked_pairs) {
+          hits.emplace_back(pair.first, pair.second, i);
         }
       }
     }
+    // Keep the order of the exhaustive search: by source, target and group.
+    auto hit_less = [](const std::tuple<Node *, Node *, size_t> &a,
+                       const std::tuple<Node *, Node *, size_t> &b) {
+      std::less<Node *> less;
+      if (std::get<0>(a) != std::get<0>(b)) {
+        return less(std::get<0>(a), std::get<0>(b));
+      }
+      if (std::get<1>(a) != std::get<1>(b)) {
+        return less(std::get<1>(a), std::get<1>(b));
+      }
+      return std::get<2>(a) < std::get<2>(b);
+    };
+    std::sort(hits.begin(), hits.end(), hit_less);
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    for (const auto &hit : hits) {
+      Node *source = std::get<0>(hit);
+      Node *target = std::get<1>(hit);
+      HitGroup new_group = pre_groups[std::get<2>(hit)];
+      bool flag = new_group.Match(source, edge.first) &&
+                  new_group.Match(target, edge.second);
+      if (flag) {
+        new_group.Register(source, edge.first);
+        new_group.Register(target, edge.second);
+        cur_groups.push_back(new_group);
+        // TODO(Superjomn) need to unique
+      }
+    }
     VLOG(3) << "step " << step << " get records: " << cur_groups.size();
   }
 
@@ -371,6 +480,8 @@ PMNode *PMNode::assert_only_one_output() {
 }
 
 PMNode *PMNode::assert_is_op(const std::string &op_type) {
+  // A teller set at construction overrides the asserts, see PMNode::Tell.
+  if (!teller_ && anchor_op_type_.empty()) anchor_op_type_ = op_type;
   asserts_.emplace_back([op_type](const Node *x) {
     if (x && x->IsStmt()) {
       auto *op_info = x->stmt()->op_info();
@@ -521,21 +632,29 @@ bool HasInput(const Node &op, const std::string &argument) {
 
 void GraphSafeRemoveNodes(SSAGraph *graph,
                           const std::set<const Node *> &nodes) {
+  // Only the neighbours of the removed nodes can hold links to them.
+  std::set<Node *> neighbours;
+  for (auto *node : nodes) {
+    neighbours.insert(node->inlinks.begin(), node->inlinks.end());
+    neighbours.insert(node->outlinks.begin(), node->outlinks.end());
+  }
+
   for (auto *node : nodes) {
     graph->RemoveNode(node);
   }
 
-  for (auto &node : graph->mutable_nodes()) {
-    for (auto it = node.inlinks.begin(); it != node.inlinks.end();) {
+  for (auto *node : neighbours) {
+    if (nodes.count(node)) continue;
+    for (auto it = node->inlinks.begin(); it != node->inlinks.end();) {
       if (nodes.count(*it)) {
-        it = node.inlinks.erase(it);
+        it = node->inlinks.erase(it);
       } else {
         it++;
       }
     }
-    for (auto it = node.outlinks.begin(); it != node.outlinks.end();) {
+    for (auto it = node->outlinks.begin(); it != node->outlinks.end();) {
       if (nodes.count(*it)) {
-        it = node.outlinks.erase(it);
+        it = node->outlinks.erase(it);
       } else {
         it++;
       }
@@ -116,6 +116,10 @@ struct PMNode {
 
   void set_op_type(const std::string& op_type) { op_type_ = op_type; }
 
+  // The op type asserted by assert_is_op(op_type), empty if there is none.
+  // The matcher only checks the statements of this type for the PMNode.
+  const std::string& anchor_op_type() const { return anchor_op_type_; }
+
   bool IsIntermediate() const { return role_ == Role::kIntermediate; }
   bool IsInput() const { return role_ == Role::kInput; }
   bool IsOutput() const { return role_ == Role::kOutput; }
@@ -195,6 +199,7 @@ struct PMNode {
   PMPattern* pattern_;
   std::string name_;
   std::string op_type_;
+  std::string anchor_op_type_;
   Type type_{};
   Role role_{Role::kUnknown};
 };
@@ -318,6 +323,7 @@ class PatternMatcher {
 #ifdef PADDLE_WITH_TESTING
   FRIEND_TEST(PatternMatcher, MarkPMNodesInGraph);
   FRIEND_TEST(PatternMatcher, DetectPatterns);
+  FRIEND_TEST(PatternMatcher, FusersMatchExhaustiveSearch);
 #endif
 
  private:
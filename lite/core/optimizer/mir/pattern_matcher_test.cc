@@ -228,6 +228,22 @@ TEST(PatternMatcher, IntermediateCheck) {
   ASSERT_EQ(count, 1);
 }
 
+TEST(SSAGraph, RemoveNodeAfterListEdits) {
+  SSAGraph graph;
+  auto* kept = graph.NewArgumentNode("kept");
+  auto* erased = graph.NewArgumentNode("erased");
+  // Nodes erased and appended through the list are not seen by the index of
+  // RemoveNode, a new node may even take the address of an erased one.
+  graph.mutable_nodes().remove_if(
+      [&](const Node& node) { return &node == erased; });
+  graph.mutable_nodes().emplace_back();
+  auto* appended = &graph.mutable_nodes().back();
+  appended->AsArg("appended");
+  graph.RemoveNode(appended);
+  graph.RemoveNode(kept);
+  EXPECT_TRUE(graph.nodes().empty());
+}
+
 }  // namespace mir
 }  // namespace lite
 }  // namespace paddle
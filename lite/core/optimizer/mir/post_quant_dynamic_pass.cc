@@ -28,6 +28,9 @@ namespace mir {
 const std::vector<std::string> PostQuantDynamicPass::quant_axis1_ops = {
     "mul", "lookup_table"};
 
+const std::vector<std::string> PostQuantDynamicPass::row_wise_ops = {
+    "lookup_table", "lookup_table_v2"};
+
 std::vector<std::string> PostQuantDynamicPass::quant_ops = {
     "conv2d", "mul", "lookup_table"};
 
@@ -74,47 +77,6 @@ void FindAbsMaxPerChannel(const Tensor& tensor,
   }
 }
 
-template <typename T>
-void QuantizeWeightPerChannel(const Tensor& src,
-                              const std::vector<float>& scales,
-                              int quant_axis,
-                              T* dest_data) {
-  CHECK(quant_axis == 0 || quant_axis == 1);
-  CHECK(dest_data != nullptr);
-
-  const DDim dims = src.dims();
-  const float* src_data = src.data<float>();
-  if (quant_axis == 0) {
-    int64_t channel = dims[0];
-    int64_t channel_size = dims.production() / channel;
-    for (int64_t i = 0; i < channel; i++) {
-      float scale = scales[i];
-      const float* src_start = src_data + i * channel_size;
-      const float* src_end = src_data + (i + 1) * channel_size;
-      T* dest_start = dest_data + i * channel_size;
-      std::transform(src_start, src_end, dest_start, [scale](float x) {
-        return static_cast<T>(round(x / scale));
-      });
-    }
-  } else if (quant_axis == 1) {
-    int64_t out_size = dims[0];
-    int64_t channel = dims[1];
-    int64_t inner_size = dims.production() / (out_size * channel);
-    for (int64_t i = 0; i < out_size; i++) {
-      for (int64_t j = 0; j < channel; j++) {
-        float scale = scales[j];
-        int64_t index = i * channel * inner_size + j * inner_size;
-        const float* src_start = src_data + index;
-        const float* src_end = src_start + inner_size;
-        T* dest_start = dest_data + index;
-        std::transform(src_start, src_end, dest_start, [scale](float x) {
-          return static_cast<T>(std::round(x / scale));
-        });
-      }
-    }
-  }
-}
-
 void PostQuantDynamicPerChannel(OpInfo* op_info,
                                 Tensor* weight,
                                 const std::string weight_name,
@@ -164,12 +126,24 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
     LOG(FATAL) << "Not support quant type:" << static_cast<int>(quant_type_);
   }
 
+  bool row_wise_tables = true;
+  for (auto& place : graph->valid_places()) {
+    if (place.target != TARGET(kX86) && place.target != TARGET(kHost)) {
+      row_wise_tables = false;
+    }
+  }
+  auto is_row_wise = [&](const std::string& op_type) {
+    return row_wise_tables &&
+           std::find(row_wise_ops.begin(), row_wise_ops.end(), op_type) !=
+               row_wise_ops.end();
+  };
+
   std::vector<mir::Node*> nodes;
   for (auto* node : graph->StmtTopologicalOrder()) {
     if (node->IsStmt()) {
       const std::string op_type = node->stmt()->op_type();
       auto iter = std::find(quant_ops.begin(), quant_ops.end(), op_type);
-      if (iter != quant_ops.end()) {
+      if (iter != quant_ops.end() || is_row_wise(op_type)) {
         nodes.push_back(node);
       }
     }
@@ -190,6 +164,19 @@ void PostQuantDynamicPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                     << "so skip quantizing the weight of " << weight_name;
           continue;
         }
+        if (is_row_wise(op_type)) {
+          PostQuantDynamicPerChannel(
+              op_info, weight, weight_name, 0, quant_bits);
+          op_info->SetAttr<std::string>("quantization_type",
+                                        "post_weight_row_wise_abs_max");
+          // The op reads the row scales when it is attached.
+          auto op = node->stmt()->op();
+          op->Attach(*op_info, scope);
+          for (auto& kernel : node->AsStmt().kernels()) {
+            op->AttachKernel(kernel.get());
+          }
+          continue;
+        }
         auto iter =
             std::find(quant_axis1_ops.begin(), quant_axis1_ops.end(), op_type);
         int quant_axis = iter != quant_axis1_ops.end() ? 1 : 0;
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
@@ -24,6 +26,54 @@
 namespace paddle {
 namespace lite {
 namespace mir {
+
+// Find the abs max of every channel of the 2-D or 4-D tensor along quant_axis.
+void FindAbsMaxPerChannel(const Tensor& tensor,
+                          int quant_axis,
+                          std::vector<float>* res);
+
+// Quantize the weight with the scales of the channels along quant_axis.
+template <typename T>
+void QuantizeWeightPerChannel(const Tensor& src,
+                              const std::vector<float>& scales,
+                              int quant_axis,
+                              T* dest_data) {
+  CHECK(quant_axis == 0 || quant_axis == 1);
+  CHECK(dest_data != nullptr);
+
+  const DDim dims = src.dims();
+  const float* src_data = src.data<float>();
+  if (quant_axis == 0) {
+    int64_t channel = dims[0];
+    int64_t channel_size = dims.production() / channel;
+    for (int64_t i = 0; i < channel; i++) {
+      float scale = scales[i];
+      const float* src_start = src_data + i * channel_size;
+      const float* src_end = src_data + (i + 1) * channel_size;
+      T* dest_start = dest_data + i * channel_size;
+      std::transform(src_start, src_end, dest_start, [scale](float x) {
+        return static_cast<T>(round(x / scale));
+      });
+    }
+  } else if (quant_axis == 1) {
+    int64_t out_size = dims[0];
+    int64_t channel = dims[1];
+    int64_t inner_size = dims.production() / (out_size * channel);
+    for (int64_t i = 0; i < out_size; i++) {
+      for (int64_t j = 0; j < channel; j++) {
+        float scale = scales[j];
+        int64_t index = i * channel * inner_size + j * inner_size;
+        const float* src_start = src_data + index;
+        const float* src_end = src_start + inner_size;
+        T* dest_start = dest_data + index;
+        std::transform(src_start, src_end, dest_start, [scale](float x) {
+          return static_cast<T>(std::round(x / scale));
+        });
+      }
+    }
+  }
+}
+
 /*
  * Use post_quant_dynamic method to quantize the model.
  * In optimization stage, if the data type of weights is fp32, quantize the
@@ -39,6 +89,10 @@ class PostQuantDynamicPass : public ProgramPass {
   // For the ops in quant_axis1_ops, the quantized axis is 1.
   // Default, quant_axis1_ops = {"mul", "lookup_table"}
   static const std::vector<std::string> quant_axis1_ops;
+  // Embedding tables which are quantized row by row when all the valid
+  // places are x86 or host. The x86 lookup kernels keep them quantized and
+  // dequantize the gathered rows, instead of dequantizing them at loading.
+  static const std::vector<std::string> row_wise_ops;
 
  public:
   void Apply(const std::unique_ptr<SSAGraph>& graph) override;
@@ -0,0 +1,106 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/core/optimizer/mir/post_quant_static_pass.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "lite/core/calibrator.h"
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/core/optimizer/mir/post_quant_dynamic_pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+void PostQuantStaticPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  if (thresholds_.empty()) return;
+  const int bit_length = 8;
+  const float range = (1 << (bit_length - 1)) - 1;
+  auto& quantizable_ops = Calibrator::quantizable_ops();
+
+  int num_quantized = 0;
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt()) continue;
+    auto iter = quantizable_ops.find(node->stmt()->op_type());
+    if (iter == quantizable_ops.end()) continue;
+    auto op_info = *node->stmt()->op_info();
+    auto& arg = iter->second;
+    if (op_info.HasAttr("enable_int8") ||
+        !MixedPrecisionPass::MatchesPrecision(op_info, PRECISION(kInt8)) ||
+        !op_info.HasInput(arg.activation) ||
+        !op_info.HasInput(arg.weight) ||
+        op_info.Input(arg.activation).size() != 1 ||
+        op_info.Input(arg.weight).size() != 1) {
+      continue;
+    }
+    auto activation_name = op_info.Input(arg.activation).front();
+    auto weight_name = op_info.Input(arg.weight).front();
+    auto threshold = thresholds_.find(activation_name);
+    if (threshold == thresholds_.end()) {
+      VLOG(3) << "No threshold of " << activation_name << ", skip "
+              << op_info.Type();
+      continue;
+    }
+    // The weight shared by other ops can't be quantized for this op only.
+    auto weight_node =
+        std::find_if(node->inlinks.begin(),
+                     node->inlinks.end(),
+                     [&](Node* in) { return in->arg()->name == weight_name; });
+    if (weight_node == node->inlinks.end() ||
+        !(*weight_node)->arg()->is_weight ||
+        (*weight_node)->outlinks.size() != 1) {
+      continue;
+    }
+    auto* scope = node->stmt()->op()->scope();
+    auto* weight = scope->FindVar(weight_name)->GetMutable<Tensor>();
+    if (weight->precision() != PRECISION(kFloat) ||
+        (weight->dims().size() != 2 && weight->dims().size() != 4)) {
+      continue;
+    }
+
+    std::vector<float> weight_scales;
+    FindAbsMaxPerChannel(*weight, arg.quant_axis, &weight_scales);
+    for (auto& scale : weight_scales) {
+      // Keep the all-zero channels away from dividing by zero.
+      scale = std::max(scale / range, 1e-8f);
+    }
+    Tensor tmp_tensor;
+    tmp_tensor.CopyDataFrom(*weight);
+    weight->clear();
+    weight->set_precision(PRECISION(kInt8));
+    QuantizeWeightPerChannel(tmp_tensor,
+                             weight_scales,
+                             arg.quant_axis,
+                             weight->mutable_data<int8_t>());
+
+    op_info.SetAttr("enable_int8", true);
+    op_info.SetAttr<int>("bit_length", bit_length);
+    op_info.SetInputScale(activation_name, {threshold->second / range});
+    op_info.SetInputScale(weight_name, weight_scales);
+    node->stmt()->ResetOp(op_info, graph->valid_places());
+    num_quantized++;
+  }
+  LOG(INFO) << "post_quant_static_pass quantized " << num_quantized << " ops.";
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(post_quant_static_pass,
+                  paddle::lite::mir::PostQuantStaticPass)
+    .BindTargets({TARGET(kARM), TARGET(kX86)});
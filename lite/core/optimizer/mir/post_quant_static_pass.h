@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Use the thresholds of the activations collected by the calibration of the
+ * predictor to quantize the model statically.
+ * For the quantizable ops whose input activation has a threshold, the weights
+ * are quantized to int8 channel-wise with abs_max, and the ops are marked with
+ * 'enable_int8' and the input scales, the same as the ops fused from the fake
+ * quantized models, so the int8 kernels are picked for them.
+ */
+class PostQuantStaticPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+  void SetThresholds(const std::map<std::string, float>& thresholds) {
+    thresholds_ = thresholds;
+  }
+  const std::map<std::string, float>& thresholds() const {
+    return thresholds_;
+  }
+
+ private:
+  std::map<std::string, float> thresholds_;
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
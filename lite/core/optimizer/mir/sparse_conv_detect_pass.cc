@@ -121,7 +121,7 @@ int SparseConvDetectPass::ComputeSparseWeight(
   }
   int left_index = 0, right_index = 0;
   for (int ocb = 0; ocb < M; ocb++) {
-    for (int i = 0; i < oc_nonzeros[ocb]; i++) {
+    for (uint32_t i = 0; i < oc_nonzeros[ocb]; i++) {
       diffs[right_index++] = act_diffs[left_index++];
     }
     if (oc_nonzeros[ocb] % 4 != 0) {
@@ -312,7 +312,57 @@ void SparseConvDetectPass::CopyOutputScaleFromOpInfo(cpp::OpDesc* op_desc,
   }
 }
 
+void SparseConvDetectPass::DetectSparseFc(
+    const std::unique_ptr<SSAGraph>& graph) {
+  // No weight can have more zeros than the threshold, e.g. the default 1.5
+  // which disables the sparse kernels.
+  if (sparse_threshold_ > 1.f) return;
+  for (auto& node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt() || node->AsStmt().op_type() != "fc") continue;
+    auto* op_info = node->stmt()->mutable_op_info();
+    if (op_info->HasAttr("padding_weights") &&
+        op_info->GetAttr<bool>("padding_weights")) {
+      continue;
+    }
+    auto* scope = node->stmt()->op()->scope();
+    auto w = op_info->Input("W").front();
+    // The values of a W computed at runtime are unknown here.
+    bool w_is_weight = false;
+    for (auto* in : node->inlinks) {
+      if (in->IsArg() && in->AsArg().name == w) {
+        w_is_weight = in->AsArg().is_weight || in->AsArg().is_persist;
+      }
+    }
+    if (!w_is_weight) continue;
+    const auto& w_tensor = scope->FindVar(w)->Get<lite::Tensor>();
+    if (w_tensor.precision() != PrecisionType::kFloat ||
+        w_tensor.dims().size() != 2) {
+      continue;
+    }
+    int weight_num = w_tensor.numel();
+    int zero_num = ComputeSparseZeros<float>(&w_tensor, weight_num);
+    float sparse_zero_percent =
+        static_cast<float>(zero_num) / static_cast<float>(weight_num);
+    VLOG(4) << "fc " << w << " sparse zero num percent: "
+            << sparse_zero_percent;
+    if (sparse_zero_percent < sparse_threshold_) continue;
+    op_info->SetAttr<bool>("use_sparse_weight", true);
+    auto op = node->stmt()->op();
+    op->Attach(*op_info, scope);
+    for (auto& kernel : node->AsStmt().kernels()) {
+      op->AttachKernel(kernel.get());
+    }
+  }
+}
+
 void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  // The x86 kernels only cover fp32 weights and relu-like activations, but
+  // also handle sparse fc.
+  bool use_x86 = false;
+  for (auto& place : graph->valid_places()) {
+    if (place.target == TARGET(kX86)) use_x86 = true;
+  }
+  if (use_x86) DetectSparseFc(graph);
   for (auto& node : graph->StmtTopologicalOrder()) {
     if (node->IsStmt() && node->AsStmt().op_type() == "conv2d") {
       auto* scope = node->stmt()->op()->scope();
@@ -355,6 +405,19 @@ void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
         VLOG(4) << "The paddings of the supported sparse conv must be 0";
         continue;
       }
+      if (use_x86 && use_int8) {
+        VLOG(4) << "The x86 sparse conv only supports fp32";
+        continue;
+      }
+      if (use_x86 && conv_op_desc->HasAttr("with_act") &&
+          conv_op_desc->GetAttr<bool>("with_act")) {
+        auto act_type = conv_op_desc->GetAttr<std::string>("act_type");
+        if (act_type != "relu" && act_type != "relu6" &&
+            act_type != "leaky_relu") {
+          VLOG(4) << "The x86 sparse conv does not support " << act_type;
+          continue;
+        }
+      }
       int zero_num;
       int num_build_nonzeroes = 0;
       if (use_fp32) {
@@ -468,6 +531,7 @@ void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
       }
 
       op_desc.SetAttr<int>("first_ic", first_ic);
+      op_desc.SetAttr<int>("diffs_im_size", static_cast<int>(im_size));
       sparse_conv2d_op->Attach(op_desc, node->stmt()->op()->scope());
       auto* sparse_op_node = graph->GraphCreateInstructNode(
           sparse_conv2d_op, graph->valid_places());
@@ -508,7 +572,7 @@ void SparseConvDetectPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
 
 REGISTER_MIR_PASS(sparse_conv_detect_pass,
                   paddle::lite::mir::SparseConvDetectPass)
-    .BindTargets({TARGET(kARM)})
+    .BindTargets({TARGET(kARM), TARGET(kX86)})
     .ExcludeTargets({TARGET(kXPU)})
     .ExcludeTargets({TARGET(kBM)})
     .ExcludeTargets({TARGET(kRKNPU)})
@@ -516,5 +580,4 @@ REGISTER_MIR_PASS(sparse_conv_detect_pass,
     .ExcludeTargets({TARGET(kNPU)})
     .ExcludeTargets({TARGET(kAPU)})
     .ExcludeTargets({TARGET(kHuaweiAscendNPU)})
-    .ExcludeTargets({TARGET(kX86)})
     .ExcludeTargets({TARGET(kImaginationNNA)});
@@ -68,6 +68,9 @@ class SparseConvDetectPass : public ProgramPass {
                                  OpInfo* op_info,
                                  const std::string& name);
 
+  // Mark the fc ops whose weights are sparse enough for the x86 sparse fc.
+  void DetectSparseFc(const std::unique_ptr<SSAGraph>& graph);
+
   void SetSparseThreshold(float sparse_threshold) {
     sparse_threshold_ = sparse_threshold;
   }
@@ -14,9 +14,13 @@
 
 #include "lite/core/optimizer/mir/ssa_graph.h"
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 namespace paddle {
@@ -40,116 +44,104 @@ bool SSAGraph::CheckBidirectionalConnection() {
   return true;
 }
 
-std::map<mir::Node *, std::set<mir::Node *>> SSAGraph::BuildOperationAdjList() {
-  std::map<mir::Node *, std::set<mir::Node *>> adj_list;
+std::vector<mir::Node *> SSAGraph::TopologicalOrder(bool stmt_only) {
+  CheckBidirectionalConnection();
 
-  for (auto &n : mutable_nodes()) {
-    if (!n.IsStmt()) continue;
-    if (adj_list.find(&n) == adj_list.end()) {
-      adj_list[&n] = std::set<mir::Node *>();
-    }
-    std::vector<mir::Node *> nodes;
-    for (auto &var : n.inlinks) {
-      for (auto &adj_n : var->inlinks) {
-        CHECK(adj_n->IsStmt());
-        nodes.push_back(adj_n);
-      }
-    }
-    std::stable_sort(
-        nodes.begin(), nodes.end(), [](mir::Node *node1, mir::Node *node2) {
-          return node1 > node2;
-        });
-    adj_list[&n].insert(std::make_move_iterator(nodes.begin()),
-                        std::make_move_iterator(nodes.end()));
+  // Nodes are visited in address order, as the former std::map based
+  // adjacency tables did, so the resulting order is unchanged.
+  std::vector<mir::Node *> nodes;
+  nodes.reserve(node_storage_.size());
+  for (auto &n : node_storage_) {
+    if (!stmt_only || n.IsStmt()) nodes.push_back(&n);
   }
-  return adj_list;
-}
-
-std::map<mir::Node *, std::set<mir::Node *>> SSAGraph::BuildNodeAdjList() {
-  std::map<mir::Node *, std::set<mir::Node *>> adj_list;
-
-  for (auto &n : mutable_nodes()) {
-    if (adj_list.find(&n) == adj_list.end()) {
-      adj_list[&n] = std::set<mir::Node *>();
-    }
-    std::vector<mir::Node *> nodes;
-    for (auto &var : n.inlinks) {
-      nodes.push_back(var);
-    }
-    std::stable_sort(
-        nodes.begin(), nodes.end(), [](mir::Node *node1, mir::Node *node2) {
-          return node1 > node2;
-        });
-    adj_list[&n].insert(std::make_move_iterator(nodes.begin()),
-                        std::make_move_iterator(nodes.end()));
+  std::sort(nodes.begin(), nodes.end(), std::less<mir::Node *>());
+  std::unordered_map<const mir::Node *, size_t> index;
+  index.reserve(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    index.emplace(nodes[i], i);
   }
-  return adj_list;
-}
-
-void SSAGraph::SortHelper(
-    const std::map<mir::Node *, std::set<mir::Node *>> &adj_list,
-    mir::Node *node,
-    std::set<mir::Node *> *visited,
-    std::vector<mir::Node *> *ret) {
-  visited->insert(node);
 
-  for (auto adj : adj_list.at(node)) {
-    if (visited->find(adj) == visited->end()) {
-      SortHelper(adj_list, adj, visited, ret);
+  // Inlink edge table, indexed by the position in `nodes`.
+  std::vector<std::vector<size_t>> adj_list(nodes.size());
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto &adj = adj_list[i];
+    for (auto *var : nodes[i]->inlinks) {
+      if (!stmt_only) {
+        adj.push_back(index.at(var));
+        continue;
+      }
+      for (auto *adj_n : var->inlinks) {
+        CHECK(adj_n->IsStmt());
+        adj.push_back(index.at(adj_n));
+      }
     }
+    std::sort(adj.begin(), adj.end());
+    adj.erase(std::unique(adj.begin(), adj.end()), adj.end());
   }
 
-  ret->push_back(node);
-}
-
-std::vector<mir::Node *> SSAGraph::StmtTopologicalOrder() {
-  CheckBidirectionalConnection();
-
-  std::stack<mir::Node *> stack;
-  std::set<mir::Node *> visited;
+  // Post-order DFS on an explicit stack, deep chains in large programs would
+  // overflow the call stack otherwise.
   std::vector<mir::Node *> res;
-
-  auto adj_list = BuildOperationAdjList();
-
-  for (auto adj : adj_list) {
-    if (visited.find(adj.first) == visited.end()) {
-      SortHelper(adj_list, adj.first, &visited, &res);
+  res.reserve(nodes.size());
+  std::vector<bool> visited(nodes.size(), false);
+  std::vector<std::pair<size_t, size_t>> stack;
+  for (size_t root = 0; root < nodes.size(); root++) {
+    if (visited[root]) continue;
+    visited[root] = true;
+    stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      size_t cur = stack.back().first;
+      size_t &next = stack.back().second;
+      if (next < adj_list[cur].size()) {
+        size_t adj = adj_list[cur][next++];
+        if (!visited[adj]) {
+          visited[adj] = true;
+          stack.emplace_back(adj, 0);
+        }
+      } else {
+        res.push_back(nodes[cur]);
+        stack.pop_back();
+      }
     }
   }
-
   return res;
 }
 
-std::vector<mir::Node *> SSAGraph::NodeTopologicalOrder() {
-  CheckBidirectionalConnection();
-
-  std::stack<mir::Node *> stack;
-  std::set<mir::Node *> visited;
-  std::vector<mir::Node *> res;
+std::vector<mir::Node *> SSAGraph::StmtTopologicalOrder() {
+  return TopologicalOrder(true);
+}
 
-  auto adj_list = BuildNodeAdjList();
+std::vector<mir::Node *> SSAGraph::NodeTopologicalOrder() {
+  return TopologicalOrder(false);
+}
 
-  for (auto adj : adj_list) {
-    if (visited.find(adj.first) == visited.end()) {
-      SortHelper(adj_list, adj.first, &visited, &res);
-    }
+std::map<std::string, std::vector<mir::Node *>> SSAGraph::OpTypeIndex() {
+  std::map<std::string, std::vector<mir::Node *>> index;
+  for (auto &n : node_storage_) {
+    if (!n.IsStmt() || !n.stmt()->op()) continue;
+    index[n.stmt()->op_info()->Type()].push_back(&n);
   }
+  return index;
+}
 
-  return res;
+mir::Node *SSAGraph::EmplaceNode() {
+  node_storage_.emplace_back();
+  auto it = std::prev(node_storage_.end());
+  node_index_[&*it] = it;
+  return &*it;
 }
 
 Node *SSAGraph::GraphCreateInstructNode(
     const std::shared_ptr<OpLite> &op, const std::vector<Place> &valid_places) {
-  node_storage_.emplace_back();
+  auto &new_node = *EmplaceNode();
   // TODO(Superjomn) remove one valid_places here.
   op->SetValidPlaces(valid_places);
-  auto &new_node = node_storage_.back();
   auto kernels = op->CreateKernels(valid_places);
-  node_storage_.back().AsStmt(op->op_type_, std::move(kernels), op);
+  new_node.AsStmt(op->op_type_, std::move(kernels), op);
 
   CHECK(new_node.inlinks.empty()) << "duplicate Build found";
   CHECK(new_node.outlinks.empty()) << "duplicate Build found";
-  return &node_storage_.back();
+  return &new_node;
 }
 
 void SSAGraph::Build(const Program &program,
@@ -158,11 +150,11 @@ void SSAGraph::Build(const Program &program,
   CHECK(node_storage_.empty());
 
   block_idx_ = block_idx;
-  auto weights = program.weights();
+  const auto &program_weights = program.weights();
+  std::unordered_set<std::string> weights(program_weights.begin(),
+                                          program_weights.end());
   auto is_weight = [&](const std::string &name) -> bool {
-    auto it = std::find(weights.begin(), weights.end(), name);
-    if (it == weights.end()) return false;
-    return true;
+    return weights.count(name) > 0;
   };
 
   auto var_type_map = program.var_type_map();
@@ -177,8 +169,7 @@ void SSAGraph::Build(const Program &program,
       if (arg_update_node_map.count(var_name)) {
         arg_node = arg_update_node_map.at(var_name);
       } else {
-        node_storage_.emplace_back();
-        arg_node = &node_storage_.back();
+        arg_node = EmplaceNode();
         arg_node->AsArg(var_name, node_storage_.size() - 1);
         arg_update_node_map[var_name] = arg_node;
       }
@@ -200,8 +191,7 @@ void SSAGraph::Build(const Program &program,
       DirectedLink(arg_node, op_node);
     }
     for (const auto &var_name : op->op_info()->output_names()) {
-      node_storage_.emplace_back();
-      auto *arg_node = &node_storage_.back();
+      auto *arg_node = EmplaceNode();
       arg_node->AsArg(var_name, node_storage_.size() - 1);
       arg_update_node_map[var_name] = arg_node;
       if (var_type_map.count(var_name) && !arg_node->arg()->type) {
@@ -212,31 +202,39 @@ void SSAGraph::Build(const Program &program,
       CHECK(arg_node->IsRoleSet());
       DirectedLink(op_node, arg_node);
     }
-    CHECK(CheckLinksRoleSet());
   }
 
   CHECK(CheckNodesRoleSet());
   CheckValid();
 }
 
+void SSAGraph::RebuildNodeIndex() {
+  node_index_.clear();
+  for (auto it = node_storage_.begin(); it != node_storage_.end(); ++it) {
+    node_index_[&*it] = it;
+  }
+  node_index_stale_ = false;
+}
+
 void SSAGraph::RemoveNode(const mir::Node *node) {
-  auto pos = std::find_if(node_storage_.begin(),
-                          node_storage_.end(),
-                          [&node](mir::Node &n) { return &n == node; });
-  CHECK(pos != node_storage_.end());
-  node_storage_.erase(pos);
+  if (node_index_stale_) RebuildNodeIndex();
+  auto indexed = node_index_.find(node);
+  CHECK(indexed != node_index_.end());
+  node_storage_.erase(indexed->second);
+  node_index_.erase(indexed);
 }
 
 void SSAGraph::CloneFrom(const SSAGraph &from) {
   node_storage_.clear();
+  node_index_.clear();
+  node_index_stale_ = false;
   arguments_.clear();
   valid_places_ = from.valid_places_;
 
   std::map<const mir::Node *, mir::Node *> clone_node_map;
   for (const auto &node : from.node_storage_) {
     if (node.IsArg()) {
-      node_storage_.emplace_back();
-      auto &new_node = node_storage_.back();
+      auto &new_node = *EmplaceNode();
       new_node.AsArg() = *node.arg();
       clone_node_map.emplace(&node, &new_node);
     } else {
@@ -299,14 +297,14 @@ mir::Node *SSAGraph::RetrieveArgument(const std::string &arg) {
 }
 
 bool SSAGraph::CheckNodesRoleSet() {
-  for (auto &node : mutable_nodes()) {
+  for (auto &node : node_storage_) {
     CHECK_OR_FALSE(node.IsRoleSet());
   }
   return true;
 }
 
 bool SSAGraph::CheckLinksRoleSet() {
-  for (auto &node : mutable_nodes()) {
+  for (auto &node : node_storage_) {
     CHECK_OR_FALSE(node.IsRoleSet());
     if (!node.IsStmt()) continue;
     for (auto *x : node.inlinks) {
@@ -322,16 +320,12 @@ bool SSAGraph::CheckLinksRoleSet() {
 }
 
 Node *SSAGraph::NewArgumentNode(const std::string &name) {
-  node_storage_.emplace_back();
-  auto &arg_node = node_storage_.back();
+  auto &arg_node = *EmplaceNode();
   arg_node.AsArg(name, node_storage_.size() - 1);
   return &arg_node;
 }
 
-Node *SSAGraph::NewInstructNode() {
-  node_storage_.emplace_back();
-  return &node_storage_.back();
-}
+Node *SSAGraph::NewInstructNode() { return EmplaceNode(); }
 
 }  // namespace mir
 }  // namespace lite
@@ -20,6 +20,7 @@
 #include <set>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
@@ -51,6 +52,9 @@ class SSAGraph : GraphBase {
 
   std::vector<mir::Node *> NodeTopologicalOrder();
 
+  // The statement nodes grouped by op type, in the order of `nodes()`.
+  std::map<std::string, std::vector<mir::Node *>> OpTypeIndex();
+
   // The inputs of the graph.
   std::vector<mir::Node *> inputs();
 
@@ -58,7 +62,12 @@ class SSAGraph : GraphBase {
   std::vector<mir::Node *> outputs();
 
   const std::list<mir::Node> &nodes() const { return node_storage_; }
-  std::list<mir::Node> &mutable_nodes() { return node_storage_; }
+  // The passes may append or erase nodes through the list, which the index
+  // of RemoveNode can not follow, so it is rebuilt before its next use.
+  std::list<mir::Node> &mutable_nodes() {
+    node_index_stale_ = true;
+    return node_storage_;
+  }
 
   mir::Node *RetrieveArgument(const std::string &arg);
 
@@ -79,6 +88,7 @@ class SSAGraph : GraphBase {
   void SetValidPlaces(const std::vector<Place> &x) { valid_places_ = x; }
 
   int blockIdx() { return block_idx_; }
+  void SetBlockIdx(int block_idx) { block_idx_ = block_idx; }
 
  private:
   mir::Node *Argument(const std::string &name);
@@ -94,19 +104,18 @@ class SSAGraph : GraphBase {
     }
   }
 
-  // Build operator inlink edge table.
-  std::map<mir::Node *, std::set<mir::Node *>> BuildOperationAdjList();
-
-  // Build node inlink edge table.
-  std::map<mir::Node *, std::set<mir::Node *>> BuildNodeAdjList();
+  // Sort all the nodes, or only the statements if `stmt_only` is set.
+  std::vector<mir::Node *> TopologicalOrder(bool stmt_only);
 
-  void SortHelper(const std::map<mir::Node *, std::set<mir::Node *>> &adj_list,
-                  mir::Node *node,
-                  std::set<mir::Node *> *visited,
-                  std::vector<mir::Node *> *ret);
+  // Append a node to the storage and index it for RemoveNode.
+  mir::Node *EmplaceNode();
+  void RebuildNodeIndex();
 
  private:
   std::list<mir::Node> node_storage_;
+  std::unordered_map<const mir::Node *, std::list<mir::Node>::iterator>
+      node_index_;
+  bool node_index_stale_{false};
   std::map<std::string, mir::Node *> arguments_;
   std::vector<Place> valid_places_;
   int block_idx_ = kRootBlockIdx;
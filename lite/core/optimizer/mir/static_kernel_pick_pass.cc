@@ -32,6 +32,23 @@ bool KernelScoreCmp(const std::pair<float, std::unique_ptr<KernelBase>>& a,
   return a.first > b.first;
 }
 
+// Sort the kernels by their scores, and move the ones of the precision
+// assigned by the mixed precision plan to the front. The scores alone can't
+// tell them apart, a kernel whose precision is placed first gets a high score
+// for the target and the layout of that place whatever its precision.
+static void SortKernels(
+    const OpInfo& op_info,
+    std::vector<std::pair<float, std::unique_ptr<KernelBase>>>* scored) {
+  std::stable_sort(scored->begin(), scored->end(), KernelScoreCmp);
+  std::stable_partition(
+      scored->begin(),
+      scored->end(),
+      [&op_info](const std::pair<float, std::unique_ptr<KernelBase>>& item) {
+        return MixedPrecisionPass::MatchesPrecision(op_info,
+                                                    item.second->precision());
+      });
+}
+
 void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
   kernel_pick_factors_.ConsiderTarget();
   kernel_pick_factors_.ConsiderPrecision();
@@ -79,7 +96,7 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
               << " score:" << score;
       scored.emplace_back(score, std::move(kernel));
     }
-    std::stable_sort(scored.begin(), scored.end(), KernelScoreCmp);
+    SortKernels(*instruct.op_info(), &scored);
     instruct.kernels().clear();
 
     if (!instruct.op_info()->HasAttr("enable_int8")) {
@@ -146,7 +163,7 @@ void StaticKernelPickPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
                                     instruct.op_info()->output_names());
           scored.emplace_back(score, std::move(kernel));
         }
-        std::stable_sort(scored.begin(), scored.end(), KernelScoreCmp);
+        SortKernels(*instruct.op_info(), &scored);
         instruct.kernels().clear();
       }
       // If the out_type_int8 is true, we should pick the kernel with the
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "lite/core/optimizer/mir/mixed_precision_pass.h"
 #include "lite/core/optimizer/mir/pass.h"
 #include "lite/core/types.h"
 
@@ -90,9 +91,12 @@ class StaticKernelPickPass : public mir::StmtPass {
           (place.precision == kernel.precision() ||
            kernel.precision() == PRECISION(kAny) ||
            place.precision == PRECISION(kAny))) {
-        // score skipped, if kernel is int8, but op is not int8
+        // score skipped, if kernel is int8, but op is not int8, or the op is
+        // assigned to another precision by the mixed precision plan
         if (!(kernel.precision() == PRECISION(kInt8) &&
-              !instruct.op_info()->HasAttr("enable_int8"))) {
+              !instruct.op_info()->HasAttr("enable_int8")) &&
+            MixedPrecisionPass::MatchesPrecision(*instruct.op_info(),
+                                                 kernel.precision())) {
           score += kMax / static_cast<int>(
                               core::KernelPickFactor::Factor::PrecisionFirst);
         }
@@ -0,0 +1,104 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/optimizer/mir/x86_fp16_weight_pass.h"
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/core/optimizer/mir/pass_registry.h"
+#include "lite/utils/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+
+bool X86FP16WeightPass::IsConvertible(Node* op_node) const {
+  auto& inst = op_node->AsStmt();
+  if (!fp16_ops_.count(inst.op_type())) return false;
+  // The pass runs before static_kernel_pick_pass, so every candidate kernel
+  // must be one of the x86 fp32 kernels that read fp16 weights.
+  if (inst.kernels().empty()) return false;
+  for (auto& kernel : inst.kernels()) {
+    if (kernel->target() != TARGET(kX86) ||
+        kernel->precision() != PRECISION(kFloat)) {
+      return false;
+    }
+  }
+  const auto* op_info = inst.op_info();
+  if (op_info->HasAttr("enable_int8") &&
+      op_info->GetAttr<bool>("enable_int8")) {
+    return false;
+  }
+  if (inst.op_type() == "matmul") {
+    // The weight must be the right hand matrix of a plain 2-D gemm.
+    if (op_info->HasAttr("transpose_X") &&
+        op_info->GetAttr<bool>("transpose_X")) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void X86FP16WeightPass::Apply(const std::unique_ptr<SSAGraph>& graph) {
+  for (auto* node : graph->StmtTopologicalOrder()) {
+    if (!node->IsStmt() || !IsConvertible(node)) continue;
+    auto& inst = node->AsStmt();
+    const auto* op_info = inst.op_info();
+    const auto& slot = fp16_ops_.at(inst.op_type());
+    if (!op_info->HasInput(slot) || op_info->Input(slot).empty()) continue;
+    const auto weight_name = op_info->Input(slot).front();
+
+    Node* weight_node = nullptr;
+    for (auto* in_node : node->inlinks) {
+      if (in_node->IsArg() && in_node->arg()->name == weight_name) {
+        weight_node = in_node;
+        break;
+      }
+    }
+    if (!weight_node || !weight_node->arg()->is_weight ||
+        weight_node->outlinks.size() != 1) {
+      continue;
+    }
+
+    auto* scope = inst.op()->scope();
+    auto* var = scope->FindVar(weight_name);
+    if (!var) continue;
+    auto* weight = var->GetMutable<lite::Tensor>();
+    if (weight->precision() != PRECISION(kFloat)) continue;
+    if (inst.op_type() == "matmul" && weight->dims().size() != 2) continue;
+
+    const int64_t num = weight->numel();
+    const float* src = weight->data<float>();
+    std::vector<uint16_t> half(num);
+    for (int64_t i = 0; i < num; ++i) {
+      half[i] = lite::float16(src[i]).x;
+    }
+    auto dims = weight->dims();
+    weight->clear();
+    weight->Resize(dims);
+    auto* dst = weight->mutable_data<uint16_t>();
+    std::memcpy(dst, half.data(), num * sizeof(uint16_t));
+    weight->set_precision(PRECISION(kFP16));
+    VLOG(4) << "convert weight " << weight_name << " of " << inst.op_type()
+            << " to fp16";
+  }
+}
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_MIR_PASS(x86_fp16_weight_pass, paddle::lite::mir::X86FP16WeightPass)
+    .BindTargets({TARGET(kX86)});
@@ -0,0 +1,52 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <map>
+#include <memory>
+#include <string>
+#include "lite/core/optimizer/mir/pass.h"
+
+namespace paddle {
+namespace lite {
+namespace mir {
+/*
+ * Store the weights of x86 fp32 gemm based kernels(fc, matmul and conv2d)
+ * as fp16 in scope. The kernels widen the weights panel by panel right
+ * before the fp32 gemm, which halves the weight footprint and the memory
+ * traffic of weight bound layers, while activations and accumulation stay
+ * in fp32. The embedding tables of lookup_table are stored as fp16 too,
+ * and only the gathered rows are widened.
+ * A weight is only converted when it is persistable, fp32 and used by a
+ * single supported op, so that no other kernel sees fp16 data.
+ */
+class X86FP16WeightPass : public ProgramPass {
+ public:
+  void Apply(const std::unique_ptr<SSAGraph>& graph) override;
+
+ private:
+  bool IsConvertible(Node* op_node) const;
+
+  // op type -> input slot of the weight
+  std::map<std::string, std::string> fp16_ops_{{"fc", "W"},
+                                                {"matmul", "Y"},
+                                                {"conv2d", "Filter"},
+                                                {"depthwise_conv2d", "Filter"},
+                                                {"lookup_table", "W"},
+                                                {"lookup_table_v2", "W"}};
+};
+
+}  // namespace mir
+}  // namespace lite
+}  // namespace paddle
@@ -138,6 +138,8 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "op_transformation_pass",                   //
        "remove_scale1_pass",                       //
        "adaptive_1x1_pool2d_convert_global_pass",  //
+       "constant_folding_pass",                    //
+       "transpose_reshape_eliminate_pass",         //
 
        "lite_conv_elementwise_fuse_pass",  // conv-elemwise-bn
        "lite_conv_bn_fuse_pass",           //
@@ -167,10 +169,14 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "lite_instance_norm_activation_fuse_pass",     //
        "lite_flatten_fc_fuse_pass",                   //
        "lite_fc_prelu_fuse_pass",                     //
+       "lite_residual_add_activation_fuse_pass",
        "lite_elementwise_activation_fuse_pass",
+       "lite_elementwise_chain_fuse_pass",
+       "lite_kv_cache_fuse_pass",
        "lite_conv_scale_fuse_pass",
        "lite_conv_elementwise_tree_fuse_pass",
        "lite_greater_than_cast_fuse_pass",
+       "lite_optimizer_fuse_pass",
        "identity_dropout_eliminate_pass",
        "sparse_conv_detect_pass",
        "__xpu__max_pooling_pad_zero_detect_fuse_pass",
@@ -259,6 +265,7 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
        "runtime_context_assign_pass",
        "argument_type_display_pass",
        "lite_inplace_fuse_pass",
+       "concat_split_view_pass",
 #if !(defined(LITE_WITH_FPGA) || defined(LITE_WITH_PRECISION_PROFILE))
        "memory_optimize_pass",
        "xpu_memory_optimize_pass"
@@ -285,12 +292,18 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
   // runtime_context_assign_pass
   // post_quant_dynamic_pass must be in the behind of
   // lite_quant_dequant_fuse_pass
+  // mixed_precision_pass and post_quant_static_pass must be in the front of
+  // quantized_op_attributes_inference_pass, in the given order
   const std::string msa_pass{"multi_stream_analysis_pass"};
   const std::string msa_depend_pass{"runtime_context_assign_pass"};
   const std::string pqd_pass{"post_quant_dynamic_pass"};
   const std::string pqd_depend_pass{"lite_quant_dequant_fuse_pass"};
+  const std::string pqs_pass{"post_quant_static_pass"};
+  const std::string mp_pass{"mixed_precision_pass"};
+  const std::string pqs_depend_pass{"quantized_op_attributes_inference_pass"};
   const std::string fp16_pass{"fp16_attribute_pass"};
   const std::string x86_int8_pass{"x86_int8_attribute_pass"};
+  const std::string x86_fp16_pass{"x86_fp16_weight_pass"};
 
   for (const std::string& pass : passes) {
     if (pass == msa_pass) {
@@ -303,6 +316,11 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
           std::find(passes_local.begin(), passes_local.end(), pqd_depend_pass);
       CHECK(iter != passes_local.end()) << "No find " << pqd_depend_pass;
       passes_local.insert(iter + 1, pqd_pass);
+    } else if (pass == pqs_pass || pass == mp_pass) {
+      auto iter =
+          std::find(passes_local.begin(), passes_local.end(), pqs_depend_pass);
+      CHECK(iter != passes_local.end()) << "No find " << pqs_depend_pass;
+      passes_local.insert(iter, pass);
     } else {
       passes_local.push_back(pass);
     }
@@ -326,6 +344,21 @@ std::unique_ptr<RuntimeProgram> RunDefaultOptimizer(
     }
   }
 
+  // x86_fp16_weight_pass must be in the front of static_kernel_pick_pass, so
+  // kernel selection and memory reuse see the fp16 weights
+  for (auto place : valid_places) {
+    if (place.target == TARGET(kX86)) {
+      if (place.precision == PRECISION(kFP16)) {
+        auto iter = std::find(passes_local.begin(),
+                              passes_local.end(),
+                              "static_kernel_pick_pass");
+        CHECK(iter != passes_local.end()) << "No find static_kernel_pick_pass";
+        passes_local.insert(iter, x86_fp16_pass);
+        break;
+      }
+    }
+  }
+
   for (auto& pass_name : passes_local) {
     optim.AddPass(pass_name);
   }
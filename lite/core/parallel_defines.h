@@ -14,39 +14,41 @@
 
 #pragma once
 
-#include <tuple>
-#include <utility>
 #include "lite/core/thread_pool.h"
 
 #ifdef LITE_USE_THREAD_POOL
 /* support basic for loop
  * for (int i = 0; i < work_size; ++i)
  */
-#define LITE_PARALLEL_BEGIN(index, tid, work_size)      \
-  {                                                     \
-    std::pair<std::function<void(int, int)>, int> task; \
-    task.second = work_size;                            \
-  task.first = [&](int index, int tid) {
-#define LITE_PARALLEL_END()                           \
-  }                                                   \
-  ;                                                   \
-  paddle::lite::ThreadPool::Enqueue(std::move(task)); \
+#define LITE_PARALLEL_BEGIN(index, tid, work_size) \
+  {                                                \
+    const int lite_parallel_size = (work_size);    \
+  auto lite_parallel_task = [&](int index, int tid) {
+#define LITE_PARALLEL_END()                                      \
+  }                                                              \
+  ;                                                              \
+  paddle::lite::ThreadPool::Enqueue(                             \
+      paddle::lite::ThreadPool::TaskRef(lite_parallel_task),     \
+      lite_parallel_size);                                       \
   }
 
 /* support common for loop
  * for (int i = start; i < end; i += step)
  */
-#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, start, step)   \
-  {                                                                \
-    std::tuple<std::function<void(int, int)>, int, int, int> task; \
-    std::get<3>(task) = step;                                      \
-    std::get<2>(task) = start;                                     \
-    std::get<1>(task) = end;                                       \
-  std::get<0>(task) = [&](int index, int tid) {
-#define LITE_PARALLEL_COMMON_END()                    \
-  }                                                   \
-  ;                                                   \
-  paddle::lite::ThreadPool::Enqueue(std::move(task)); \
+#define LITE_PARALLEL_COMMON_BEGIN(index, tid, end, start, step) \
+  {                                                              \
+    const int lite_parallel_end = (end);                         \
+    const int lite_parallel_start = (start);                     \
+    const int lite_parallel_step = (step);                       \
+  auto lite_parallel_task = [&](int index, int tid) {
+#define LITE_PARALLEL_COMMON_END()                           \
+  }                                                          \
+  ;                                                          \
+  paddle::lite::ThreadPool::Enqueue(                         \
+      paddle::lite::ThreadPool::TaskRef(lite_parallel_task), \
+      lite_parallel_end,                                     \
+      lite_parallel_start,                                   \
+      lite_parallel_step);                                   \
   }
 
 #elif defined(ARM_WITH_OMP)
@@ -15,13 +15,20 @@
 #include "lite/core/program.h"
 
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
 #include <map>
+#include <mutex>  // NOLINT
 #include <set>
+#include <tuple>
 
+#include "lite/core/model/base/io.h"
 #include "lite/model_parser/cpp_desc.h"
 #include "lite/operators/conditional_block_op.h"
 #include "lite/operators/subgraph_op.h"
 #include "lite/operators/while_op.h"
+#include "lite/utils/timer.h"
 #ifdef LITE_WITH_PRECISION_PROFILE
 #include "lite/core/profile/precision_profiler.h"
 #endif
@@ -441,6 +448,11 @@ void RuntimeProgram::SaveOutput() {
 #endif
 
 void RuntimeProgram::Run() {
+  if (frozen_ && !instruction_hook_ && !InputShapeChanged()) {
+    RunFrozen();
+    return;
+  }
+
 #ifdef LITE_WITH_PRECISION_PROFILE
   auto inst_precision_profiler = paddle::lite::profile::PrecisionProfiler();
   std::string precision_profiler_summary =
@@ -462,6 +474,7 @@ void RuntimeProgram::Run() {
 #endif
 
   int idx = -1;
+  Timer timer;
 
   auto& insts = instructions_[kRootBlockIdx];
   for (auto& inst : insts) {
@@ -486,7 +499,13 @@ void RuntimeProgram::Run() {
     monitor.preRun(inst);
 #endif
 
+    if (instruction_hook_) {
+      timer.Start();
+    }
     inst.Run();
+    if (instruction_hook_) {
+      instruction_hook_(inst, timer.Stop());
+    }
 
 #ifdef LITE_WITH_FPGA
     monitor.postRun(inst);
@@ -522,6 +541,280 @@ void RuntimeProgram::Run() {
             << precision_profiler_summary
             << inst_precision_profiler.GetSummaryTail();
 #endif
+
+  if (static_shape_ && (!unfreezable_ || InputShapeChanged())) {
+    frozen_ = Freeze();
+    unfreezable_ = !frozen_;
+  }
+}
+
+// Whether the op takes its shape or one of its attributes from a tensor,
+// e.g. reshape2 with ShapeTensor, slice with StartsTensor or expand with
+// expand_times_tensor. Its output shape then depends on the data of that
+// tensor, which may change from run to run.
+static bool HasTensorAttrInput(const OpInfo& op_info) {
+  static const std::set<std::string> kTensorAttrSlots{
+      "Shape", "OutSize", "ExpandTimes", "RepeatTimes", "Offsets"};
+  for (auto& slot : op_info.InputArgumentNames()) {
+    if (op_info.Input(slot).empty()) continue;
+    std::string lower(slot);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    auto ends_with = [&lower](const std::string& suffix) {
+      return lower.size() >= suffix.size() &&
+             lower.compare(
+                 lower.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (kTensorAttrSlots.count(slot) || ends_with("tensor") ||
+        ends_with("tensorlist")) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RuntimeProgram::Freeze() {
+  launch_table_.clear();
+  frozen_outputs_.clear();
+  frozen_inputs_.clear();
+#if defined(LITE_WITH_PROFILE) || defined(LITE_WITH_PRECISION_PROFILE) || \
+    defined(LITE_WITH_NVTX) || defined(LITE_WITH_FPGA) ||                 \
+    defined(LITE_WITH_METAL) || defined(LITE_WITH_CUDA) ||                \
+    defined(LITE_WITH_OPENCL)
+  // These builds hook every instruction in Run(), keep the normal path.
+  return false;
+#else
+  // The ops whose output shapes depend on the dims of their inputs and on
+  // their attributes alone. The shapes of the others may come from the data
+  // of an input, e.g. the Num of linspace or the K of top_k_v2, so those of
+  // one run can't be replayed. Neither can those of the listed ops that take
+  // a shape or an attribute as a tensor.
+  static const std::set<std::string> kStaticShapeOps{
+      "abs",
+      "arg_max",
+      "batch_norm",
+      "bmm",
+      "calib",
+      "cast",
+      "clip",
+      "concat",
+      "conv2d",
+      "conv2d_transpose",
+      "depthwise_conv2d",
+      "depthwise_conv2d_transpose",
+      "dropout",
+      "elementwise_add",
+      "elementwise_div",
+      "elementwise_max",
+      "elementwise_min",
+      "elementwise_mul",
+      "elementwise_pow",
+      "elementwise_sub",
+      "elu",
+      "exp",
+      "fc",
+      "fill_constant",
+      "fill_constant_batch_size_like",
+      "flatten",
+      "flatten2",
+      "flatten_contiguous_range",
+      "fusion_elementwise_add_activation",
+      "fusion_elementwise_chain",
+      "fusion_elementwise_div_activation",
+      "fusion_elementwise_max_activation",
+      "fusion_elementwise_min_activation",
+      "fusion_elementwise_mul_activation",
+      "fusion_elementwise_sub_activation",
+      "gelu",
+      "group_norm",
+      "hard_sigmoid",
+      "hard_swish",
+      "instance_norm",
+      "io_copy",
+      "io_copy_once",
+      "layer_norm",
+      "layout",
+      "leaky_relu",
+      "log",
+      "log_softmax",
+      "lookup_table",
+      "lookup_table_v2",
+      "matmul",
+      "matmul_v2",
+      "mean",
+      "mish",
+      "mul",
+      "pool2d",
+      "prelu",
+      "reduce_max",
+      "reduce_mean",
+      "reduce_min",
+      "reduce_prod",
+      "reduce_sum",
+      "relu",
+      "relu6",
+      "reshape",
+      "reshape2",
+      "rsqrt",
+      "scale",
+      "shape",
+      "sigmoid",
+      "slice",
+      "softmax",
+      "softsign",
+      "sparse_conv2d",
+      "split",
+      "sqrt",
+      "square",
+      "squeeze",
+      "squeeze2",
+      "stack",
+      "swish",
+      "tanh",
+      "thresholded_relu",
+      "transpose",
+      "transpose2",
+      "unsqueeze",
+      "unsqueeze2"};
+  if (instructions_.size() != 1) return false;
+
+  std::set<std::string> produced;
+  std::set<std::string> inputs;
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    if (inst.is_feed_fetch_op()) continue;
+    const auto* op = inst.op();
+    if (!kStaticShapeOps.count(op->Type()) ||
+        HasTensorAttrInput(*op->op_info())) {
+      VLOG(4) << "can't freeze the shapes of " << op->Type();
+      return false;
+    }
+    if (op->run_once() && inst.has_run()) continue;
+
+    // Local tensors read before any op writes them are the program inputs.
+    for (auto& name : op->op_info()->input_names()) {
+      if (produced.count(name) || inputs.count(name)) continue;
+      auto* var = exec_scope_->FindLocalVar(name);
+      if (!var) continue;
+      if (!var->IsType<Tensor>()) return false;
+      auto* tensor = var->GetMutable<Tensor>();
+      frozen_inputs_.push_back({tensor, tensor->dims(), tensor->lod()});
+      inputs.insert(name);
+    }
+
+    FrozenLaunch launch{inst.mutable_kernel(), frozen_outputs_.size(), 0};
+    for (auto& name : op->op_info()->output_names()) {
+      auto* var = exec_scope_->FindVar(name);
+      if (!var || !var->IsType<Tensor>()) return false;
+      auto* tensor = var->GetMutable<Tensor>();
+      frozen_outputs_.push_back({tensor, tensor->dims(), tensor->lod()});
+      produced.insert(name);
+    }
+    launch.output_end = frozen_outputs_.size();
+    launch_table_.push_back(launch);
+  }
+  VLOG(4) << "frozen " << launch_table_.size() << " kernels with "
+          << frozen_inputs_.size() << " inputs";
+  return true;
+#endif
+}
+
+bool RuntimeProgram::InputShapeChanged() const {
+  for (auto& input : frozen_inputs_) {
+    if (input.tensor->dims() != input.dims ||
+        input.tensor->lod() != input.lod) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void RuntimeProgram::RunFrozen() {
+  for (auto& launch : launch_table_) {
+    // Tensors may be shared by several ops after memory optimization, so the
+    // output shapes are restored before every launch.
+    for (size_t i = launch.output_begin; i < launch.output_end; ++i) {
+      auto& output = frozen_outputs_[i];
+      output.tensor->Resize(output.dims);
+      if (!output.lod.empty() || !output.tensor->lod().empty()) {
+        output.tensor->set_lod(output.lod);
+      }
+    }
+    launch.kernel->Launch();
+  }
+}
+
+namespace {
+// The embedding tables mapped by this process, keyed by the table name, data
+// and size. The predictors sharing the weights of a model, e.g. the clones of
+// a predictor, find their tables here and neither hash nor map them again.
+using EmbeddingTableKey = std::tuple<std::string, const void*, size_t>;
+
+std::set<EmbeddingTableKey>* MappedEmbeddingTables() {
+  static auto* tables = new std::set<EmbeddingTableKey>;
+  return tables;
+}
+
+std::mutex* MappedEmbeddingTablesMutex() {
+  static auto* mutex = new std::mutex;
+  return mutex;
+}
+
+uint64_t HashTableContent(const char* bytes, size_t size) {
+  uint64_t hash = 14695981039346656037ULL;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * 1099511628211ULL;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(bytes[i])) * 1099511628211ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+void RuntimeProgram::MapEmbeddingTables(const std::string& dir) {
+  constexpr size_t kMinMappedTableBytes = 16 << 20;
+  CHECK(exec_scope_) << "The exec scope of the program is not set.";
+  for (auto& inst : instructions_[kRootBlockIdx]) {
+    const auto* op = inst.op();
+    const auto& op_type = op->Type();
+    if (op_type != "lookup_table" && op_type != "lookup_table_v2") continue;
+    const auto& names = op->op_info()->Input("W");
+    if (names.empty()) continue;
+    auto* var = exec_scope_->FindVar(names.front());
+    if (!var || !var->IsType<lite::Tensor>()) continue;
+    auto* table = var->GetMutable<lite::Tensor>();
+    if (!table->persistable() || table->memory_size() < kMinMappedTableBytes) {
+      continue;
+    }
+    if (table->target() != TARGET(kHost) && table->target() != TARGET(kX86)) {
+      continue;
+    }
+    // The content hash keeps the files of different models or different
+    // versions of a model apart, while the processes serving the same model
+    // map the same file.
+    const auto* bytes = static_cast<const char*>(table->raw_data());
+    const size_t size = table->memory_size();
+    std::lock_guard<std::mutex> lock(*MappedEmbeddingTablesMutex());
+    auto* mapped_tables = MappedEmbeddingTables();
+    if (mapped_tables->count(EmbeddingTableKey(names.front(), bytes, size))) {
+      continue;
+    }
+    const uint64_t hash = HashTableContent(bytes, size);
+    std::string file_name = names.front();
+    std::replace(file_name.begin(), file_name.end(), '/', '_');
+    char suffix[32];
+    snprintf(suffix,
+             sizeof(suffix),
+             "_%016llx.bin",
+             static_cast<unsigned long long>(hash));  // NOLINT
+    const std::string path = dir + "/" + file_name + suffix;
+    if (model_parser::MapTensorToFile(path, table)) {
+      VLOG(4) << "map embedding table " << names.front() << " to " << path;
+      mapped_tables->emplace(names.front(), table->raw_data(), size);
+    }
+  }
 }
 
 void Program::Build(const std::shared_ptr<cpp::ProgramDesc>& program_desc) {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #pragma once
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -129,6 +130,7 @@ struct Instruction {
   KernelBase* mutable_kernel() { return kernel_.get(); }
 
   bool is_feed_fetch_op() const { return is_feed_fetch_op_; }
+  bool has_run() const { return has_run_; }
 
 #ifdef LITE_WITH_CUDA
   bool need_sync() const {
@@ -256,6 +258,36 @@ class LITE_API RuntimeProgram {
 
   size_t block_size() { return instructions_.size(); }
 
+  // Static shape mode: after a run the kernels are frozen into a flat launch
+  // table, and later runs replay the cached output shapes instead of calling
+  // InferShape, as long as the input shapes and lods stay the same. A program
+  // with an op whose output shapes may depend on the data of its inputs is
+  // never frozen, see Freeze().
+  void set_static_shape(bool static_shape) {
+    static_shape_ = static_shape;
+    frozen_ = false;
+    unfreezable_ = false;
+  }
+  bool static_shape() const { return static_shape_; }
+  // Whether the next run with the same input shapes replays the launch table.
+  bool frozen() const { return frozen_; }
+
+  // The hook is called after every instruction with the time it took in ms,
+  // for inspecting the ops one by one, such as the calibration of the
+  // post-training quantization. The frozen launch table is not used while a
+  // hook is set.
+  using InstructionHook = std::function<void(const Instruction&, float)>;
+  void set_instruction_hook(const InstructionHook& hook) {
+    instruction_hook_ = hook;
+  }
+
+  // Move the embedding tables of lookup_table into read-only mappings of
+  // files in `dir`. Tables smaller than 16MB are left in place, and so are
+  // the tables already mapped for another predictor sharing the weights.
+  // The tables are mapped after being loaded in full, so the peak memory of
+  // the predictor creation is unchanged, only the steady state is shared.
+  void MapEmbeddingTables(const std::string& dir);
+
   void set_version(const int64_t version) { version_ = version; }
 
   const int64_t get_version() const { return version_; }
@@ -277,10 +309,39 @@ class LITE_API RuntimeProgram {
 
  private:
   RuntimeProgram(const RuntimeProgram&) = delete;
+
+  // Build the launch table from the shapes of the last run, return false if
+  // the program can not be frozen. The inputs found before the failure are
+  // kept, so that it is only tried again when their shapes change.
+  bool Freeze();
+  bool InputShapeChanged() const;
+  void RunFrozen();
+
+  struct FrozenOutput {
+    Tensor* tensor;
+    DDim dims;
+    LoD lod;
+  };
+  struct FrozenLaunch {
+    KernelBase* kernel;
+    // range of the outputs of the kernel in frozen_outputs_
+    size_t output_begin;
+    size_t output_end;
+  };
+
   std::vector<std::vector<Instruction>> instructions_;
   Scope* exec_scope_{};
   int64_t version_{0};
 
+  bool static_shape_{false};
+  bool frozen_{false};
+  // the last Freeze() failed for the current input shapes
+  bool unfreezable_{false};
+  std::vector<FrozenLaunch> launch_table_;
+  std::vector<FrozenOutput> frozen_outputs_;
+  std::vector<FrozenOutput> frozen_inputs_;
+  InstructionHook instruction_hook_;
+
 #ifdef LITE_WITH_METAL
   std::unique_ptr<KernelContext> metal_ctx_{nullptr};
 #endif
@@ -0,0 +1,204 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/core/program.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+
+static cpp::OpDesc UnaryDesc(const std::string& op_type,
+                             const std::string& x,
+                             const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType(op_type);
+  desc.SetInput("X", {x});
+  desc.SetOutput("Out", {out});
+  if (op_type == "scale") {
+    desc.SetAttr("scale", 2.f);
+    desc.SetAttr("bias", -1.f);
+    desc.SetAttr("bias_after_scale", true);
+  }
+  return desc;
+}
+
+static cpp::OpDesc LinspaceDesc(const std::string& out) {
+  cpp::OpDesc desc;
+  desc.SetType("linspace");
+  desc.SetInput("Start", {"start"});
+  desc.SetInput("Stop", {"stop"});
+  desc.SetInput("Num", {"num"});
+  desc.SetOutput("Out", {out});
+  desc.SetAttr("dtype", 5);
+  return desc;
+}
+
+// Appends the op of `desc` with its kernel of `place` and `alias`.
+static void AddInstruction(const cpp::OpDesc& desc,
+                           const Place& place,
+                           const std::string& alias,
+                           Scope* scope,
+                           std::vector<Instruction>* insts) {
+  for (auto& name : desc.output_vars()) scope->Var(name)->GetMutable<Tensor>();
+  auto op = LiteOpRegistry::Global().Create(desc.Type());
+  ASSERT_TRUE(op) << desc.Type();
+  op->Attach(desc, scope);
+  auto kernels = op->CreateKernels({place});
+  auto it = std::find_if(kernels.begin(),
+                         kernels.end(),
+                         [&alias](const std::unique_ptr<KernelBase>& kernel) {
+                           return kernel->alias() == alias;
+                         });
+  ASSERT_TRUE(it != kernels.end()) << desc.Type() << " " << alias;
+  auto kernel = std::move(*it);
+  kernel->SetContext(ContextScheduler::Global().NewContext(kernel->target()));
+  insts->emplace_back(op, std::move(kernel));
+}
+
+static void SetInput(Scope* scope,
+                     const std::vector<int64_t>& dims,
+                     float offset) {
+  auto* x = scope->Var("x")->GetMutable<Tensor>();
+  x->Resize(dims);
+  auto* data = x->mutable_data<float>();
+  for (int64_t i = 0; i < x->numel(); i++) {
+    data[i] = static_cast<float>(i % 7) - 3.f + offset;
+  }
+}
+
+// y = relu(2 * x - 1)
+static void CheckOutput(Scope* scope) {
+  const auto& x = scope->FindVar("x")->Get<Tensor>();
+  const auto& y = scope->FindVar("y")->Get<Tensor>();
+  ASSERT_EQ(y.dims(), x.dims());
+  for (int64_t i = 0; i < x.numel(); i++) {
+    float expected = std::max(2.f * x.data<float>()[i] - 1.f, 0.f);
+    EXPECT_FLOAT_EQ(y.data<float>()[i], expected) << "at " << i;
+  }
+}
+
+static std::unique_ptr<RuntimeProgram> BuildScaleRelu(Scope* scope) {
+  std::vector<std::vector<Instruction>> insts(1);
+  const Place place{TARGET(kX86), PRECISION(kFloat)};
+  AddInstruction(UnaryDesc("scale", "x", "a"), place, "def", scope, &insts[0]);
+  AddInstruction(UnaryDesc("relu", "a", "y"), place, "def", scope, &insts[0]);
+  std::unique_ptr<RuntimeProgram> program(
+      new RuntimeProgram(std::move(insts)));
+  program->set_exec_scope(scope);
+  program->set_static_shape(true);
+  return program;
+}
+
+// The launch table is rebuilt when the input shape changes, and replays the
+// output shapes even when another op resized a shared tensor.
+TEST(RuntimeProgram, freeze_and_change_input_shape) {
+  Scope scope;
+  SetInput(&scope, {2, 3}, 0.f);
+  auto program = BuildScaleRelu(&scope);
+  EXPECT_FALSE(program->frozen());
+  program->Run();
+  CheckOutput(&scope);
+  EXPECT_TRUE(program->frozen());
+
+  SetInput(&scope, {2, 3}, 1.5f);
+  scope.FindVar("y")->GetMutable<Tensor>()->Resize({1});
+  program->Run();
+  CheckOutput(&scope);
+  EXPECT_TRUE(program->frozen());
+
+  SetInput(&scope, {4, 5}, 0.5f);
+  program->Run();
+  CheckOutput(&scope);
+  EXPECT_TRUE(program->frozen());
+}
+
+// linspace sizes its output from the data of Num, the program keeps running
+// InferShape.
+TEST(RuntimeProgram, keep_data_dependent_shapes) {
+  Scope scope;
+  auto set_scalar = [&scope](const std::string& name, float value) {
+    auto* tensor = scope.Var(name)->GetMutable<Tensor>();
+    tensor->Resize({1});
+    tensor->mutable_data<float>()[0] = value;
+  };
+  set_scalar("start", 0.f);
+  set_scalar("stop", 1.f);
+  auto* num = scope.Var("num")->GetMutable<Tensor>();
+  num->Resize({1});
+  num->mutable_data<int32_t>()[0] = 3;
+
+  std::vector<std::vector<Instruction>> insts(1);
+  AddInstruction(LinspaceDesc("x"),
+                 Place{TARGET(kHost), PRECISION(kFloat)},
+                 "float32",
+                 &scope,
+                 &insts[0]);
+  AddInstruction(UnaryDesc("relu", "x", "y"),
+                 Place{TARGET(kX86), PRECISION(kFloat)},
+                 "def",
+                 &scope,
+                 &insts[0]);
+  RuntimeProgram program(std::move(insts));
+  program.set_exec_scope(&scope);
+  program.set_static_shape(true);
+
+  for (int n : {3, 9, 2}) {
+    num->mutable_data<int32_t>()[0] = n;
+    program.Run();
+    EXPECT_FALSE(program.frozen());
+    const auto& y = scope.FindVar("y")->Get<Tensor>();
+    ASSERT_EQ(y.numel(), n);
+    for (int i = 0; i < n; i++) {
+      EXPECT_NEAR(y.data<float>()[i], static_cast<float>(i) / (n - 1), 1e-6);
+    }
+  }
+}
+
+// An instruction hook sees every op, so the frozen program goes back to
+// Run() while one is set.
+TEST(RuntimeProgram, run_with_hook_on_frozen_program) {
+  Scope scope;
+  SetInput(&scope, {3, 4}, 0.f);
+  auto program = BuildScaleRelu(&scope);
+  program->Run();
+  ASSERT_TRUE(program->frozen());
+
+  std::vector<std::string> hooked;
+  program->set_instruction_hook(
+      [&hooked](const Instruction& inst, float) {
+        hooked.push_back(inst.op()->Type());
+      });
+  SetInput(&scope, {3, 4}, 2.f);
+  program->Run();
+  CheckOutput(&scope);
+  EXPECT_EQ(hooked, (std::vector<std::string>{"scale", "relu"}));
+
+  program->set_instruction_hook(nullptr);
+  SetInput(&scope, {3, 4}, -1.f);
+  program->Run();
+  CheckOutput(&scope);
+  EXPECT_EQ(hooked.size(), 2u);
+  EXPECT_TRUE(program->frozen());
+}
+
+}  // namespace lite
+}  // namespace paddle
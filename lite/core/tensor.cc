@@ -29,6 +29,30 @@ void TensorLite::ShareDataWith(const TensorLite &other) {
   memory_size_ = other.memory_size_;
   precision_ = other.precision_;
   offset_ = other.offset_;
+  view_capacity_ = other.view_capacity_;
+}
+
+void TensorLite::ShareBufferWith(const TensorLite &parent,
+                                 size_t offset,
+                                 size_t capacity) {
+  CHECK_GT(capacity, 0u);
+  CHECK_LE(parent.offset_ + offset + capacity, parent.buffer_->space())
+      << "The view exceeds the buffer of its parent tensor.";
+  buffer_ = parent.buffer_;
+  target_ = parent.target_;
+  offset_ = parent.offset_ + offset;
+  memory_size_ = capacity;
+  view_capacity_ = capacity;
+}
+
+void TensorLite::DetachView() {
+  if (view_capacity_ == 0) return;
+  std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>();
+  buffer->ResetLazy(target_, memory_size_);
+  TargetCopy(target_, buffer->data(), raw_data(), memory_size_);
+  buffer_ = buffer;
+  offset_ = 0;
+  view_capacity_ = 0;
 }
 
 void TensorLite::CopyDataFrom(const TensorLite &other) {
@@ -43,8 +67,9 @@ void TensorLite::CopyDataFrom(const TensorLite &other) {
 
 void *TensorLite::mutable_data(size_t memory_size) {
   memory_size_ = memory_size;
+  ReleaseViewIfNotFit(target_, memory_size_);
   buffer_->ResetLazy(target_, memory_size_);
-  return buffer_->data();
+  return static_cast<char *>(buffer_->data()) + offset_;
 }
 
 void *TensorLite::mutable_data(TargetType target, size_t memory_size) {
@@ -61,15 +86,14 @@ void TensorLite::ResetBuffer(std::shared_ptr<Buffer> buffer,
                              size_t memory_size) {
   CHECK_EQ(offset_, 0u)
       << "Only the offset is supported to zero when the Buffer is reset.";
-  if (buffer_) {
-    CHECK_LE(memory_size_, buffer->space())
-        << "The space of buffer is not enough to store the tensor.";
-    CHECK_LE(memory_size, buffer->space())
-        << "The buffer is smaller than the specified minimum size.";
-  }
+  // The previous memory size is irrelevant as the tensor is rebound to the
+  // new buffer, e.g. when a smaller batch is shared after a larger one.
+  CHECK_LE(memory_size, buffer->space())
+      << "The buffer is smaller than the specified minimum size.";
   buffer_ = buffer;
   memory_size_ = memory_size;
   target_ = buffer->target();
+  view_capacity_ = 0;
 }
 
 #ifdef LITE_WITH_OPENCL
@@ -96,6 +96,7 @@ class TensorLite {
   R *mutable_data() {
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
     memory_size_ = dims_.production() * sizeof(T);
+    ReleaseViewIfNotFit(target_, memory_size_);
     buffer_->ResetLazy(target_, memory_size_);
     return reinterpret_cast<R *>(static_cast<char *>(buffer_->data()) +
                                  offset_);
@@ -190,6 +191,7 @@ class TensorLite {
 #endif
     precision_ = lite_api::PrecisionTypeTrait<T>::Type();
     memory_size_ = memory_size;
+    ReleaseViewIfNotFit(target, memory_size_);
     buffer_->ResetLazy(target, memory_size_);
     target_ = target;
     return reinterpret_cast<R *>(static_cast<char *>(buffer_->data()) +
@@ -210,7 +212,12 @@ class TensorLite {
   }
 
   void clear() {
-    buffer_->Free();
+    if (view_capacity_ > 0) {
+      buffer_ = std::make_shared<Buffer>();
+      view_capacity_ = 0;
+    } else {
+      buffer_->Free();
+    }
     offset_ = 0;
   }
   size_t data_size() const { return this->dims().production(); }
@@ -219,8 +226,26 @@ class TensorLite {
 
   size_t offset() const { return offset_; }
 
+  // The bytes this tensor can hold without reallocating its buffer.
+  size_t capacity() const {
+    return view_capacity_ > 0 ? view_capacity_ : buffer_->space() - offset_;
+  }
+
+  // Whether the buffer of this tensor can be written in place without
+  // changing the data seen by any tensor other than `alias`: the buffer owns
+  // its memory, and no other tensor holds it.
+  bool IsSoleOwner(const TensorLite &alias) const {
+    const bool shared_with_alias = &alias != this && alias.buffer_ == buffer_;
+    return buffer_->own_data() &&
+           buffer_.use_count() <= (shared_with_alias ? 2 : 1);
+  }
+
   bool IsInitialized() const { return buffer_->data(); }
 
+  // Whether the data lives in memory shared by ResetBuffer, which the tensor
+  // must not reallocate.
+  bool IsExternalMemory() const { return !buffer_->own_data(); }
+
   // Other share data to this.
   void ShareDataWith(const TensorLite &other);
 
@@ -228,6 +253,22 @@ class TensorLite {
 
   void ResetBuffer(std::shared_ptr<Buffer> buffer, size_t memory_size);
 
+  // Make this tensor a view of `capacity` bytes of `parent`'s buffer starting
+  // at byte `offset`, so that whoever writes this tensor writes straight into
+  // the parent. The view is dropped as soon as the tensor needs more than
+  // `capacity` bytes.
+  void ShareBufferWith(const TensorLite &parent,
+                       size_t offset,
+                       size_t capacity);
+
+  // Whether this tensor is a view created by ShareBufferWith on `parent`.
+  bool IsViewOf(const TensorLite &parent) const {
+    return view_capacity_ > 0 && buffer_ == parent.buffer_;
+  }
+
+  // Move the data of a view into a private buffer.
+  void DetachView();
+
   TargetType target() const { return target_; }
   void set_target(TargetType target) { target_ = target; }
 
@@ -261,6 +302,17 @@ class TensorLite {
 
   /// @brief Buffer may be shared with other tensors
   size_t offset_{0};
+  /// @brief Bytes owned by this tensor when it is a view of another tensor
+  size_t view_capacity_{0};
+
+  void ReleaseViewIfNotFit(TargetType target, size_t memory_size) {
+    if (view_capacity_ > 0 &&
+        (memory_size > view_capacity_ || target != target_)) {
+      buffer_ = std::make_shared<Buffer>();
+      offset_ = 0;
+      view_capacity_ = 0;
+    }
+  }
 };
 
 template <typename T>
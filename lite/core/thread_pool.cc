@@ -14,6 +14,7 @@
 
 #include "lite/core/thread_pool.h"
 #include <string.h>
+#include <algorithm>
 #include "lite/utils/log/logging.h"
 
 namespace paddle {
@@ -43,17 +44,17 @@ void ThreadPool::Destroy() {
 ThreadPool::ThreadPool(int number) {
   thread_num_ = number;
   for (int i = 0; i < thread_num_; ++i) {
-    tasks_.second.emplace_back(new std::atomic<bool>{false});
+    busy_.emplace_back(new std::atomic<bool>{false});
   }
   for (int thread_index = 1; thread_index < thread_num_; ++thread_index) {
     workers_.emplace_back([this, thread_index]() {
       while (!stop_) {
-        // if (*tasks_.second[thread_index]) {
-        while (!(*tasks_.second[thread_index])) {
+        while (!(*busy_[thread_index]) && !stop_) {
           std::this_thread::yield();
         }
-        tasks_.first(thread_index, thread_index);
-        *tasks_.second[thread_index] = false;
+        if (stop_) break;
+        RunJob(thread_index);
+        *busy_[thread_index] = false;
       }
     });
   }
@@ -64,7 +65,7 @@ ThreadPool::~ThreadPool() {
   for (auto& worker : workers_) {
     worker.join();
   }
-  for (auto c : tasks_.second) {
+  for (auto c : busy_) {
     delete c;
   }
 }
@@ -90,83 +91,43 @@ void ThreadPool::ReleaseThreadPool() {
   gInstance->cv_.notify_all();
 }
 
-void ThreadPool::Enqueue(TASK_BASIC&& task) {
-  if (task.second <= 1 || (nullptr == gInstance)) {
-    for (int i = 0; i < task.second; ++i) {
-      task.first(i, 0);
-    }
-    return;
-  }
-  int work_size = task.second;
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = [work_size, &task](int index, int tId) {
-      for (int v = tId; v < work_size; v += gInstance->thread_num_) {
-        task.first(v, tId);  // nested lambda func
-      }
-    };
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = std::move(task.first);
+void ThreadPool::RunJob(int tid) {
+  for (int v = start_ + tid * step_; v < end_; v += stride_) {
+    task_(v, tid);
   }
-  for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
-  }
-  // invoke tid 0 callback in main thread
-  // other tid task is invoked in child thread
-  gInstance->tasks_.first(0, 0);
-  bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in child thread
-  do {
-    std::this_thread::yield();
-    complete = true;
-    for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
-        complete = false;
-        break;
-      }
-    }
-  } while (!complete);
 }
 
-void ThreadPool::Enqueue(TASK_COMMON&& task) {
-  int end = std::get<1>(task);
-  int start = std::get<2>(task);
-  int step = std::get<3>(task);
+void ThreadPool::Enqueue(TaskRef task, int work_size) {
+  Enqueue(task, work_size, 0, 1);
+}
+
+void ThreadPool::Enqueue(TaskRef task, int end, int start, int step) {
   int work_size = (end - start + step - 1) / step;
   if (work_size <= 1 || (nullptr == gInstance)) {
     for (int v = start; v < end; v += step) {
-      std::get<0>(task)(v, 0);
+      task(v, 0);
     }
     return;
   }
-  if (work_size > gInstance->thread_num_) {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto start_index = start + tId * step;
-      auto stride = gInstance->thread_num_ * step;
-      for (int v = start_index; v < end; v += stride) {
-        std::get<0>(task)(v, tId);  // nested lambda func
-      }
-    });
-    work_size = gInstance->thread_num_;
-  } else {
-    gInstance->tasks_.first = ([=, &task](int index, int tId) {
-      auto v = start + tId * step;
-      std::get<0>(task)(v, tId);  // nested lambda func
-    });
-  }
+  work_size = std::min(work_size, gInstance->thread_num_);
+  gInstance->task_ = task;
+  gInstance->start_ = start;
+  gInstance->end_ = end;
+  gInstance->step_ = step;
+  gInstance->stride_ = work_size * step;
   for (int i = 1; i < work_size; ++i) {
-    *(gInstance->tasks_.second[i]) = true;
+    *(gInstance->busy_[i]) = true;
   }
   // invoke tid 0 callback in main thread
-  // other tid task is invoked in new thread
-  gInstance->tasks_.first(0, 0);
+  // other tid task is invoked in child thread
+  gInstance->RunJob(0);
   bool complete = true;
-  // check tid 1 to thread_num - 1 all work completed in new thread
+  // check tid 1 to thread_num - 1 all work completed in child thread
   do {
     std::this_thread::yield();
     complete = true;
     for (int i = 1; i < work_size; ++i) {
-      if (*gInstance->tasks_.second[i]) {
+      if (*gInstance->busy_[i]) {
         complete = false;
         break;
       }
@@ -15,11 +15,8 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>  //NOLINT
-#include <functional>
 #include <mutex>   //NOLINT
 #include <thread>  //NOLINT
-#include <tuple>
-#include <utility>
 #include <vector>
 
 namespace paddle {
@@ -27,12 +24,29 @@ namespace lite {
 
 class ThreadPool {
  public:
-  typedef std::function<void(int, int)> TASK;
-  typedef std::pair<std::function<void(int, int)>, int> TASK_BASIC;
-  typedef std::tuple<std::function<void(int, int)>, int, int, int> TASK_COMMON;
+  // Non-owning reference to a `void(int index, int tid)` callable. Enqueue
+  // blocks until every worker is done, so the referenced callable always
+  // outlives the dispatch and no std::function has to be allocated.
+  class TaskRef {
+   public:
+    TaskRef() = default;
+    template <typename F>
+    explicit TaskRef(F& func) : obj_(&func), call_(&Invoke<F>) {}
+    void operator()(int index, int tid) const { call_(obj_, index, tid); }
 
-  static void Enqueue(TASK_BASIC&& task);
-  static void Enqueue(TASK_COMMON&& task);
+   private:
+    template <typename F>
+    static void Invoke(void* obj, int index, int tid) {
+      (*static_cast<F*>(obj))(index, tid);
+    }
+    void* obj_{nullptr};
+    void (*call_)(void*, int, int){nullptr};
+  };
+
+  // for (int i = 0; i < work_size; ++i)
+  static void Enqueue(TaskRef task, int work_size);
+  // for (int i = start; i < end; i += step)
+  static void Enqueue(TaskRef task, int end, int start, int step);
   static void AcquireThreadPool();
   static void ReleaseThreadPool();
   static int Init(int number);
@@ -43,10 +57,18 @@ class ThreadPool {
   explicit ThreadPool(int number = 0);
   ~ThreadPool();
 
+  // worker `tid` runs indices start + tid * step, strided by stride
+  void RunJob(int tid);
+
   std::vector<std::thread> workers_;
   std::atomic<bool> stop_{false};
   bool ready_{true};
-  std::pair<TASK, std::vector<std::atomic<bool>*>> tasks_;
+  std::vector<std::atomic<bool>*> busy_;
+  TaskRef task_;
+  int start_{0};
+  int end_{0};
+  int step_{1};
+  int stride_{1};
   std::condition_variable cv_;
   std::mutex mutex_;
 
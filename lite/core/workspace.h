@@ -35,6 +35,9 @@ namespace lite {
  *
  * - call `WorkSpace::Global().Alloc()` if needed to allocate some temporary
  * buffer.
+ * - the buffer only grows, so steady-state runs reuse it without touching the
+ * heap. Growing it invalidates blocks returned by earlier `Alloc()` calls in
+ * the same kernel, so request all temporaries of a kernel in one block.
  */
 class WorkSpace {
  public:
@@ -91,7 +94,7 @@ class WorkSpace {
 
   TargetType target_;
   Buffer buffer_;
-  size_t cursor_;
+  size_t cursor_{0};
 
   DISALLOW_COPY_AND_ASSIGN(WorkSpace);
 };
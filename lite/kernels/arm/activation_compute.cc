@@ -17,6 +17,9 @@
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -29,6 +32,13 @@ void ReluCompute<PRECISION(kFloat)>::Run() {
   auto x_dims = param.X->dims();
   auto x_data = param.X->data<float>();
   auto output_data = param.Out->mutable_data<float>();
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx.has_sve()) {
+    lite::arm::math::sve::act_relu(
+        x_data, output_data, x_dims.production(), ctx.threads());
+    return;
+  }
+#endif
   lite::arm::math::act_relu<float>(
       x_data, output_data, x_dims.production(), ctx.threads());
 }
@@ -77,6 +87,13 @@ void LeakyReluCompute::Run() {
   auto x_data = param.X->data<float>();
   auto alpha = param.Leaky_relu_alpha;
   auto output_data = param.Out->mutable_data<float>();
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx.has_sve()) {
+    lite::arm::math::sve::act_relu_neg(
+        x_data, output_data, x_dims.production(), alpha, ctx.threads());
+    return;
+  }
+#endif
   lite::arm::math::act_relu_neg<float>(
       x_data, output_data, x_dims.production(), alpha, ctx.threads());
 }
@@ -111,6 +128,13 @@ void SigmoidCompute::Run() {
   auto x_dims = param.X->dims();
   auto x_data = param.X->data<float>();
   auto output_data = param.Out->mutable_data<float>();
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx.has_sve()) {
+    lite::arm::math::sve::act_sigmoid(
+        x_data, output_data, x_dims.production(), ctx.threads());
+    return;
+  }
+#endif
   lite::arm::math::act_sigmoid<float>(
       x_data, output_data, x_dims.production(), ctx.threads());
 }
@@ -121,6 +145,13 @@ void TanhCompute::Run() {
   auto x_dims = param.X->dims();
   auto x_data = param.X->data<float>();
   auto output_data = param.Out->mutable_data<float>();
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx.has_sve()) {
+    lite::arm::math::sve::act_tanh(
+        x_data, output_data, x_dims.production(), ctx.threads());
+    return;
+  }
+#endif
   lite::arm::math::act_tanh<float>(
       x_data, output_data, x_dims.production(), ctx.threads());
 }
@@ -132,6 +163,13 @@ void Relu6Compute::Run() {
   auto x_data = param.X->data<float>();
   float coef = 6.;
   auto output_data = param.Out->mutable_data<float>();
+#ifdef LITE_WITH_ARM_SVE
+  if (ctx.has_sve()) {
+    lite::arm::math::sve::act_clipped_relu(
+        x_data, output_data, x_dims.production(), coef, ctx.threads());
+    return;
+  }
+#endif
   lite::arm::math::act_clipped_relu<float>(
       x_data, output_data, x_dims.production(), coef, ctx.threads());
 }
@@ -18,6 +18,9 @@
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/conv_impl_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -39,6 +42,20 @@ void DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   auto win = param.x->dims()[3];
   auto paddings = *param.paddings;
   // select dw conv kernel
+#ifdef LITE_WITH_ARM_SVE
+  auto strides = param.strides;
+  auto dilations = *param.dilations;
+  if (kw == 3 && ctx.has_sve() && strides[0] == strides[1] &&
+      (strides[0] == 1 || strides[0] == 2) && dilations[0] == 1 &&
+      dilations[1] == 1 &&
+      lite::arm::math::sve::fused_act_supported(param.activation_param)) {
+    // takes the original weights layout and any padding
+    flag_trans_weights_ = false;
+    impl_ = lite::arm::math::sve::conv_depthwise_3x3_fp32;
+    KERNEL_FUNC_NAME("conv_depthwise_3x3_fp32_sve")
+    return;
+  }
+#endif
   if (kw == 3) {
     bool pads_less = ((paddings[1] < 2) && (paddings[3] < 2));
     if (pads_less && paddings[0] == paddings[2] &&
@@ -292,9 +292,10 @@ void Conv2DTransposeCompute<PRECISION(kInt8), PRECISION(kFloat)>::Run() {
   int group_size_coldata = m * n;
 
   bool pads_all_qual = pads_equal && (paddings[0] == paddings[2]);
-  int hblock = lite::arm::math::get_hblock(&ctx);
+  int hblock = lite::arm::math::get_hblock_int8(&ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
-  int group_size_weights = ((m_roundup * k + 15) / 16) * 16;
+  int kup = ROUNDUP(k, lite::arm::math::get_kblock_int8(&ctx));
+  int group_size_weights = ((m_roundup * kup + 15) / 16) * 16;
   bool flag_1x1s1p1 = (kw == 1) && (kh == 1) && (param.strides[0] == 1) &&
                       (param.strides[1] == 1) && pads_all_qual &&
                       (paddings[0] == 0) && (dilations[0] == 1) &&
@@ -391,9 +392,10 @@ void Conv2DTransposeCompute<PRECISION(kInt8), PRECISION(kInt8)>::Run() {
   int group_size_coldata = m * n;
 
   bool pads_all_qual = pads_equal && (paddings[0] == paddings[2]);
-  int hblock = lite::arm::math::get_hblock(&ctx);
+  int hblock = lite::arm::math::get_hblock_int8(&ctx);
   int m_roundup = hblock * ((m + hblock - 1) / hblock);
-  int group_size_weights = ((m_roundup * k + 15) / 16) * 16;
+  int kup = ROUNDUP(k, lite::arm::math::get_kblock_int8(&ctx));
+  int group_size_weights = ((m_roundup * kup + 15) / 16) * 16;
   bool flag_1x1s1p1 = (kw == 1) && (kh == 1) && (param.strides[0] == 1) &&
                       (param.strides[1] == 1) && pads_all_qual &&
                       (paddings[0] == 0) && (dilations[0] == 1) &&
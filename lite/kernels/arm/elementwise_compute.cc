@@ -25,6 +25,9 @@
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -209,6 +212,56 @@ struct CommonElementWiseOpArm<Elem_t, DimValue_t, arm_math::NullNeonConfig> {
   }
 };
 
+#ifdef LITE_WITH_ARM_SVE
+// Replaces the float neon kernels by their sve versions, other types keep
+// the neon ones.
+template <class T>
+void select_sve_fns(FastBCastFn<T>** fast_bcast_fn,
+                    ElementWiseFn<T>** elementwise_fn) {}
+
+#define ELEMENTWISE_SVE_FNS(name)                                 \
+  {arm_math::elementwise_##name<float>,                           \
+   arm_math::sve::elementwise_##name},                            \
+      {arm_math::elementwise_##name##_relu<float>,                \
+       arm_math::sve::elementwise_##name##_relu}
+#define ELEMENTWISE_SVE_BCAST_FNS(name)                           \
+  {arm_math::elementwise_##name##_broadcast<float>,               \
+   arm_math::sve::elementwise_##name##_broadcast},                \
+      {arm_math::elementwise_##name##_relu_broadcast<float>,      \
+       arm_math::sve::elementwise_##name##_relu_broadcast}
+
+template <>
+void select_sve_fns<float>(FastBCastFn<float>** fast_bcast_fn,
+                           ElementWiseFn<float>** elementwise_fn) {
+  static const std::pair<ElementWiseFn<float>*, ElementWiseFn<float>*>
+      sve_fns[] = {ELEMENTWISE_SVE_FNS(add),
+                   ELEMENTWISE_SVE_FNS(sub),
+                   ELEMENTWISE_SVE_FNS(mul),
+                   ELEMENTWISE_SVE_FNS(max),
+                   ELEMENTWISE_SVE_FNS(min)};
+  static const std::pair<FastBCastFn<float>*, FastBCastFn<float>*>
+      sve_bcast_fns[] = {ELEMENTWISE_SVE_BCAST_FNS(add),
+                         ELEMENTWISE_SVE_BCAST_FNS(sub),
+                         ELEMENTWISE_SVE_BCAST_FNS(mul),
+                         ELEMENTWISE_SVE_BCAST_FNS(max),
+                         ELEMENTWISE_SVE_BCAST_FNS(min)};
+  for (auto& fn : sve_fns) {
+    if (*elementwise_fn == fn.first) {
+      *elementwise_fn = fn.second;
+      break;
+    }
+  }
+  for (auto& fn : sve_bcast_fns) {
+    if (*fast_bcast_fn == fn.first) {
+      *fast_bcast_fn = fn.second;
+      break;
+    }
+  }
+}
+#undef ELEMENTWISE_SVE_FNS
+#undef ELEMENTWISE_SVE_BCAST_FNS
+#endif
+
 // Note: All calling to elementwise_compute_template may set a template arg
 //  "NeonConfig" to get better performance than the "NullNeonConfig".
 //  However,it may increase the binary size significantly. So,
@@ -237,6 +290,11 @@ void elementwise_compute_template(paddle::lite::KernelBase* kernel,
   auto x_dims = x->dims();
   auto y_dims = y->dims();
   int pre, n, post;
+#ifdef LITE_WITH_ARM_SVE
+  if (kernel->mutable_context()->template As<ARMContext>().has_sve()) {
+    select_sve_fns<T>(&fast_bcast_fn, &elementwise_fn);
+  }
+#endif
   if (elementwise_fn && x_dims == y_dims) {
     elementwise_fn(x_data, y_data, out_data, x_dims.production());
   } else if (fast_bcast_fn &&
@@ -0,0 +1,223 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/kernels/arm/fusion_optimizer_compute.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "lite/core/op_registry.h"
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+namespace {
+
+enum OptimizerType { kSGD = 0, kMomentum = 1, kAdam = 2 };
+
+// Elements updated by one task.
+const int64_t kBlockSize = 16384;
+
+struct UpdateBlock {
+  int index;
+  int64_t begin;
+  int64_t size;
+};
+
+// The raw pointers of one parameter and its states.
+struct UpdateTensor {
+  const float* param;
+  const float* grad;
+  float* accum;
+  float* param_out;
+  const float* state0;
+  const float* state1;
+  float* state0_out;
+  float* state1_out;
+};
+
+inline void CopyIfNotSame(const float* in, float* out, int64_t size) {
+  if (in && out && in != out) {
+    std::memcpy(out, in, size * sizeof(float));
+  }
+}
+
+}  // namespace
+
+void FusionOptimizerCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const int num = param.Param.size();
+  const int steps = param.accumulate_steps;
+  const bool accumulate = steps > 1;
+  int type = kSGD;
+  if (param.optimizer_type == "momentum") {
+    type = kMomentum;
+  } else if (param.optimizer_type == "adam") {
+    type = kAdam;
+  }
+
+  if (accumulate && grad_accum_.size() != static_cast<size_t>(num)) {
+    grad_accum_.resize(num);
+    for (int i = 0; i < num; ++i) {
+      grad_accum_[i].Resize(param.Param[i]->dims());
+      auto* accum = grad_accum_[i].mutable_data<float>();
+      std::memset(accum, 0, grad_accum_[i].numel() * sizeof(float));
+    }
+  }
+  step_++;
+  const bool update = !accumulate || step_ % steps == 0;
+
+  // Resolve all the pointers before the parallel loop, mutable_data may
+  // allocate.
+  std::vector<UpdateTensor> tensors(num);
+  std::vector<UpdateBlock> blocks;
+  for (int i = 0; i < num; ++i) {
+    auto& t = tensors[i];
+    t.param = param.Param[i]->data<float>();
+    t.grad = param.Grad[i]->data<float>();
+    t.accum = accumulate ? grad_accum_[i].mutable_data<float>() : nullptr;
+    t.param_out = param.ParamOut[i]->mutable_data<float>();
+    t.state0 = t.state1 = nullptr;
+    t.state0_out = t.state1_out = nullptr;
+    if (type == kMomentum) {
+      t.state0 = param.Velocity[i]->data<float>();
+      t.state0_out = param.VelocityOut[i]->mutable_data<float>();
+    } else if (type == kAdam) {
+      t.state0 = param.Moment1[i]->data<float>();
+      t.state1 = param.Moment2[i]->data<float>();
+      t.state0_out = param.Moment1Out[i]->mutable_data<float>();
+      t.state1_out = param.Moment2Out[i]->mutable_data<float>();
+    }
+    const int64_t numel = param.Param[i]->numel();
+    for (int64_t begin = 0; begin < numel; begin += kBlockSize) {
+      blocks.push_back({i, begin, std::min(kBlockSize, numel - begin)});
+    }
+  }
+
+  const float lr = *param.LearningRate->data<float>();
+  const float grad_scale = 1.f / steps;
+  const float mu = param.mu;
+  const bool use_nesterov = param.use_nesterov;
+  const float beta1 = param.beta1;
+  const float beta2 = param.beta2;
+  float adam_lr = 0.f;
+  float adam_eps = 0.f;
+  if (type == kAdam) {
+    const float beta1_pow = *param.Beta1Pow->data<float>();
+    const float beta2_pow = *param.Beta2Pow->data<float>();
+    adam_lr = lr * std::sqrt(1.f - beta2_pow) / (1.f - beta1_pow);
+    adam_eps = param.epsilon * std::sqrt(1.f - beta2_pow);
+  }
+
+  const int block_num = blocks.size();
+  LITE_PARALLEL_BEGIN(b, tid, block_num) {
+    const auto& block = blocks[b];
+    const auto& t = tensors[block.index];
+    const int64_t off = block.begin;
+    const int64_t size = block.size;
+    const float* p = t.param + off;
+    const float* g = t.grad + off;
+    float* acc = t.accum ? t.accum + off : nullptr;
+    float* po = t.param_out + off;
+    if (!update) {
+      // Only sum the gradients, the outputs keep the inputs.
+      for (int64_t k = 0; k < size; ++k) {
+        acc[k] += g[k];
+      }
+      CopyIfNotSame(p, po, size);
+      if (t.state0) CopyIfNotSame(t.state0 + off, t.state0_out + off, size);
+      if (t.state1) CopyIfNotSame(t.state1 + off, t.state1_out + off, size);
+    } else if (type == kSGD) {
+      for (int64_t k = 0; k < size; ++k) {
+        float grad = g[k];
+        if (acc) {
+          grad = (acc[k] + grad) * grad_scale;
+          acc[k] = 0.f;
+        }
+        po[k] = p[k] - lr * grad;
+      }
+    } else if (type == kMomentum) {
+      const float* v = t.state0 + off;
+      float* vo = t.state0_out + off;
+      for (int64_t k = 0; k < size; ++k) {
+        float grad = g[k];
+        if (acc) {
+          grad = (acc[k] + grad) * grad_scale;
+          acc[k] = 0.f;
+        }
+        float velocity = mu * v[k] + grad;
+        vo[k] = velocity;
+        po[k] = use_nesterov ? p[k] - (grad + mu * velocity) * lr
+                             : p[k] - lr * velocity;
+      }
+    } else {
+      const float* m1 = t.state0 + off;
+      const float* m2 = t.state1 + off;
+      float* m1o = t.state0_out + off;
+      float* m2o = t.state1_out + off;
+      for (int64_t k = 0; k < size; ++k) {
+        float grad = g[k];
+        if (acc) {
+          grad = (acc[k] + grad) * grad_scale;
+          acc[k] = 0.f;
+        }
+        float mom1 = beta1 * m1[k] + (1.f - beta1) * grad;
+        float mom2 = beta2 * m2[k] + (1.f - beta2) * grad * grad;
+        m1o[k] = mom1;
+        m2o[k] = mom2;
+        po[k] = p[k] - adam_lr * (mom1 / (std::sqrt(mom2) + adam_eps));
+      }
+    }
+  }
+  LITE_PARALLEL_END();
+
+  if (type == kAdam) {
+    const float beta1_pow = *param.Beta1Pow->data<float>();
+    const float beta2_pow = *param.Beta2Pow->data<float>();
+    *param.Beta1PowOut->mutable_data<float>() =
+        update ? beta1_pow * beta1 : beta1_pow;
+    *param.Beta2PowOut->mutable_data<float>() =
+        update ? beta2_pow * beta2 : beta2_pow;
+  }
+}
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_optimizer,
+                     kARM,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::arm::FusionOptimizerCompute,
+                     def)
+    .BindInput("Param", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Grad", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("LearningRate", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Velocity", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Moment1", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Moment2", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Beta1Pow", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindInput("Beta2Pow", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("ParamOut", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("VelocityOut", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Moment1Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Moment2Out", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Beta1PowOut", {LiteType::GetTensorTy(TARGET(kARM))})
+    .BindOutput("Beta2PowOut", {LiteType::GetTensorTy(TARGET(kARM))})
+    .Finalize();
@@ -0,0 +1,50 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace arm {
+
+// Updates all the parameters of fusion_optimizer in one parallel loop. Every
+// tensor is cut into blocks and the blocks of all tensors are shared among
+// the threads, so small and large parameters are balanced.
+class FusionOptimizerCompute
+    : public KernelLite<TARGET(kARM), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusionOptimizerParam;
+
+  FusionOptimizerCompute() = default;
+
+  void Run() override;
+
+  virtual ~FusionOptimizerCompute() = default;
+
+ private:
+  // The sum of the gradients since the last update, one per parameter, only
+  // used with accumulate_steps > 1.
+  std::vector<Tensor> grad_accum_;
+  int step_{0};
+};
+
+}  // namespace arm
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
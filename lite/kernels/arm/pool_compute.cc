@@ -21,6 +21,9 @@
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 namespace paddle {
 namespace lite {
 namespace kernels {
@@ -64,6 +67,9 @@ void PoolCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   kps_equal = kps_equal && win_ksize;
   auto x_dims = param.x->dims();
   auto w_in = x_dims[x_dims.size() - 1];
+#ifdef LITE_WITH_ARM_SVE
+  bool has_sve = this->ctx_->template As<ARMContext>().has_sve();
+#endif
 
   if (global_pooling) {
     for (size_t i = 0; i < ksize.size(); ++i) {
@@ -71,6 +77,15 @@ void PoolCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
       paddings[2 * i + 1] = 0;
       ksize[i] = static_cast<int>(in_dims[i + 2]);
     }
+#ifdef LITE_WITH_ARM_SVE
+    if (has_sve && pooling_type == "max") {
+      lite::arm::math::sve::pooling_global_max(POOL_IN_PARAM);
+      return;
+    } else if (has_sve && pooling_type == "avg") {
+      lite::arm::math::sve::pooling_global_avg(POOL_IN_PARAM);
+      return;
+    }
+#endif
     if (pooling_type == "max") {
       lite::arm::math::pooling_global_max(POOL_IN_PARAM);
       return;
@@ -79,6 +94,17 @@ void PoolCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
       return;
     }
   } else {
+#ifdef LITE_WITH_ARM_SVE
+    // the sve kernel masks the padding, so any window shape is covered;
+    // inclusive avg keeps the neon path which counts the padded area
+    bool is_max = pooling_type == "max";
+    if (has_sve && !adaptive && !use_quantizer &&
+        (is_max || (pooling_type == "avg" && exclusive))) {
+      lite::arm::math::sve::pooling(
+          POOL_IN_PARAM, ksize, strides, paddings, is_max);
+      return;
+    }
+#endif
     if (w_in > 8 && ksize[0] == 1 && strides[0] == 2 && paddings[0] == 0 &&
         kps_equal) {
       // auto& ctx = this->ctx_->template As<ARMContext>();
@@ -17,6 +17,9 @@
 #ifdef ENABLE_ARM_FP16
 #include "lite/backends/arm/math/fp16/funcs_fp16.h"
 #endif
+#ifdef LITE_WITH_ARM_SVE
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#endif
 
 namespace paddle {
 namespace lite {
@@ -37,6 +40,12 @@ void SoftmaxCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   int outer_num = x_dims.Slice(0, axis).production();
   int inner_num = x_dims.Slice(axis + 1, x_rank).production();
   int axis_size = x_dims[axis];
+#ifdef LITE_WITH_ARM_SVE
+  if (this->ctx_->template As<ARMContext>().has_sve()) {
+    lite::arm::math::sve::softmax(din, dout, axis_size, inner_num, outer_num);
+    return;
+  }
+#endif
   if (inner_num == 1) {
     if (axis_size > 4) {
       lite::arm::math::softmax_inner1_large_axis(
@@ -145,8 +145,10 @@ void GenerateProposalsCompute::Run() {
   std::vector<int64_t> tmp_lod;
   std::vector<int64_t> tmp_num;
 
-  int64_t num_proposals = 0;
-  for (int64_t i = 0; i < num; ++i) {
+  // Proposals of different images are independent, so compute them
+  // concurrently and append them to the outputs in image order afterwards.
+  std::vector<std::pair<Tensor, Tensor>> image_proposals(num);
+  lite::host::math::ParallelFor(num, [&](int64_t i) {
     Tensor im_info_slice = im_info->Slice<float>(i, i + 1);
     Tensor bbox_deltas_slice = bbox_deltas_swap.Slice<float>(i, i + 1);
     Tensor scores_slice = scores_swap.Slice<float>(i, i + 1);
@@ -155,19 +157,22 @@ void GenerateProposalsCompute::Run() {
         std::vector<int64_t>({c_bbox * h_bbox * w_bbox / 4, 4}));
     scores_slice.Resize(std::vector<int64_t>({c_score * h_score * w_score, 1}));
 
-    std::pair<Tensor, Tensor> tensor_pair =
-        ProposalForOneImage(im_info_slice,
-                            *anchors,
-                            *variances,
-                            bbox_deltas_slice,
-                            scores_slice,
-                            pre_nms_top_n,
-                            post_nms_top_n,
-                            nms_thresh,
-                            min_size,
-                            eta);
-    Tensor &proposals = tensor_pair.first;
-    Tensor &scores = tensor_pair.second;
+    image_proposals[i] = ProposalForOneImage(im_info_slice,
+                                             *anchors,
+                                             *variances,
+                                             bbox_deltas_slice,
+                                             scores_slice,
+                                             pre_nms_top_n,
+                                             post_nms_top_n,
+                                             nms_thresh,
+                                             min_size,
+                                             eta);
+  });
+
+  int64_t num_proposals = 0;
+  for (int64_t i = 0; i < num; ++i) {
+    Tensor &proposals = image_proposals[i].first;
+    Tensor &scores = image_proposals[i].second;
 
     lite::host::math::AppendTensor<float>(
         rpn_rois, 4 * num_proposals, proposals);
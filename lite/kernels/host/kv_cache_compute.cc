@@ -0,0 +1,228 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/host/kv_cache_compute.h"
+#include <cstring>
+#include <memory>
+#include "lite/core/parallel_defines.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+void KVCacheAppendCompute::Run() {
+  auto& param = Param<param_t>();
+  auto* cache = param.cache;
+  const auto* x = param.x;
+  const auto& x_dims = x->dims();
+  int rank = static_cast<int>(x_dims.size());
+  int axis = param.axis < 0 ? param.axis + rank : param.axis;
+  // An empty cache created by fill_constant may carry another precision.
+  if (cache->numel() > 0) {
+    CHECK(cache->precision() == x->precision())
+        << "The cache and the appended data must have the same precision.";
+  }
+  const size_t elem_bytes = lite_api::PrecisionTypeLength(x->precision());
+
+  auto out_dims = cache->dims();
+  out_dims[axis] += x_dims[axis];
+  const int64_t outer = x_dims.count(0, axis);
+  const size_t cache_block = cache->dims().count(axis, rank) * elem_bytes;
+  const size_t x_block = x_dims.count(axis, rank) * elem_bytes;
+  const size_t out_block = cache_block + x_block;
+  const size_t out_bytes = outer * out_block;
+  const char* x_data = static_cast<const char*>(x->raw_data());
+
+  // The cache may share its buffer with another tensor, e.g. a var of the
+  // parent block or a tensor which ShareDataWith it. Those must keep their
+  // data, so the cache then moves to a buffer of its own.
+  if (cache->capacity() >= out_bytes && cache->IsSoleOwner(*param.out)) {
+    // Move the cached blocks to their new place from the last one, where
+    // they never overlap the blocks which are not moved yet.
+    char* data = static_cast<char*>(cache->mutable_data(out_bytes));
+    for (int64_t o = outer - 1; o >= 0; --o) {
+      if (o > 0 && cache_block > 0) {
+        std::memmove(data + o * out_block, data + o * cache_block, cache_block);
+      }
+      std::memcpy(data + o * out_block + cache_block,
+                  x_data + o * x_block,
+                  x_block);
+    }
+  } else {
+    // Grow the cache geometrically, a cache growing by one step per
+    // iteration is then only reallocated a logarithmic number of times.
+    auto buffer = std::make_shared<Buffer>();
+    buffer->ResetLazy(cache->target(), 2 * out_bytes);
+    char* data = static_cast<char*>(buffer->data());
+    const char* cache_data = static_cast<const char*>(cache->raw_data());
+    LITE_PARALLEL_BEGIN(o, tid, outer) {
+      if (cache_block > 0) {
+        std::memcpy(
+            data + o * out_block, cache_data + o * cache_block, cache_block);
+      }
+      std::memcpy(data + o * out_block + cache_block,
+                  x_data + o * x_block,
+                  x_block);
+    }
+    LITE_PARALLEL_END();
+    if (cache->offset() != 0) {
+      cache->DetachView();
+    }
+    cache->ResetBuffer(buffer, out_bytes);
+  }
+  cache->Resize(out_dims);
+  cache->set_precision(x->precision());
+  param.out->ShareDataWith(*cache);
+}
+
+template <typename IndexT>
+void KVCacheReorderCompute::Reorder(const IndexT* index,
+                                    int64_t rows,
+                                    size_t row_bytes) {
+  auto& param = Param<param_t>();
+  char* data =
+      static_cast<char*>(param.cache->mutable_data(param.cache->memory_size()));
+  // A source row has to be saved when it is read after its own row is
+  // overwritten, the rows which keep their content are not touched.
+  slots_.assign(rows, -1);
+  int64_t saved_rows = 0;
+  for (int64_t i = 0; i < rows; ++i) {
+    const int64_t src = static_cast<int64_t>(index[i]);
+    CHECK(src >= 0 && src < rows) << "The index " << src
+                                  << " is out of the range of the cache.";
+    if (src != i && static_cast<int64_t>(index[src]) != src &&
+        slots_[src] < 0) {
+      slots_[src] = saved_rows++;
+    }
+  }
+  saved_.resize(saved_rows * row_bytes);
+  for (int64_t i = 0; i < rows; ++i) {
+    if (slots_[i] >= 0) {
+      std::memcpy(saved_.data() + slots_[i] * row_bytes,
+                  data + i * row_bytes,
+                  row_bytes);
+    }
+  }
+  LITE_PARALLEL_BEGIN(i, tid, rows) {
+    const int64_t src = static_cast<int64_t>(index[i]);
+    if (src != i) {
+      const char* from = slots_[src] >= 0
+                             ? saved_.data() + slots_[src] * row_bytes
+                             : data + src * row_bytes;
+      std::memcpy(data + i * row_bytes, from, row_bytes);
+    }
+  }
+  LITE_PARALLEL_END();
+}
+
+void KVCacheReorderCompute::Run() {
+  auto& param = Param<param_t>();
+  auto* cache = param.cache;
+  const auto* index = param.index;
+  const int64_t rows = cache->dims()[0];
+  const int64_t index_num = index->numel();
+  const size_t row_bytes =
+      rows > 0 ? cache->numel() / rows *
+                     lite_api::PrecisionTypeLength(cache->precision())
+               : 0;
+
+  // A shared buffer is never reordered in place, see KVCacheAppendCompute.
+  if (index_num == rows && cache->IsSoleOwner(*param.out)) {
+    if (rows > 0) {
+      if (index->precision() == PRECISION(kInt32)) {
+        Reorder(index->data<int32_t>(), rows, row_bytes);
+      } else {
+        Reorder(index->data<int64_t>(), rows, row_bytes);
+      }
+    }
+  } else {
+    // The number of rows changes or the buffer is shared, gather into a new
+    // buffer.
+    auto buffer = std::make_shared<Buffer>();
+    buffer->ResetLazy(cache->target(), index_num * row_bytes);
+    char* data = static_cast<char*>(buffer->data());
+    const char* cache_data = static_cast<const char*>(cache->raw_data());
+    for (int64_t i = 0; i < index_num; ++i) {
+      const int64_t src = index->precision() == PRECISION(kInt32)
+                              ? index->data<int32_t>()[i]
+                              : index->data<int64_t>()[i];
+      CHECK(src >= 0 && src < rows) << "The index " << src
+                                    << " is out of the range of the cache.";
+      std::memcpy(
+          data + i * row_bytes, cache_data + src * row_bytes, row_bytes);
+    }
+    auto out_dims = cache->dims();
+    out_dims[0] = index_num;
+    if (cache->offset() != 0) {
+      cache->DetachView();
+    }
+    cache->ResetBuffer(buffer, index_num * row_bytes);
+    cache->Resize(out_dims);
+  }
+  param.out->ShareDataWith(*cache);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(kv_cache_append,
+                     kHost,
+                     kAny,
+                     kAny,
+                     paddle::lite::kernels::host::KVCacheAppendCompute,
+                     def)
+    .BindInput("Cache",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindInput("X",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindOutput("CacheOut",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .Finalize();
+
+REGISTER_LITE_KERNEL(kv_cache_reorder,
+                     kHost,
+                     kAny,
+                     kAny,
+                     paddle::lite::kernels::host::KVCacheReorderCompute,
+                     def)
+    .BindInput("Cache",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindInput("Index",
+               {LiteType::GetTensorTy(TARGET(kHost),
+                                      PRECISION(kAny),
+                                      DATALAYOUT(kAny))})
+    .BindOutput("CacheOut",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .BindOutput("Out",
+                {LiteType::GetTensorTy(TARGET(kHost),
+                                       PRECISION(kAny),
+                                       DATALAYOUT(kAny))})
+    .Finalize();
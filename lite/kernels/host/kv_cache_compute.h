@@ -0,0 +1,56 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+class KVCacheAppendCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)> {
+ public:
+  using param_t = operators::KVCacheAppendParam;
+
+  void Run() override;
+
+  virtual ~KVCacheAppendCompute() = default;
+};
+
+class KVCacheReorderCompute
+    : public KernelLite<TARGET(kHost), PRECISION(kAny), DATALAYOUT(kAny)> {
+ public:
+  using param_t = operators::KVCacheReorderParam;
+
+  void Run() override;
+
+  virtual ~KVCacheReorderCompute() = default;
+
+ private:
+  template <typename IndexT>
+  void Reorder(const IndexT* index, int64_t rows, size_t row_bytes);
+
+  // The slot in saved_ of every row, -1 if the row is not saved.
+  std::vector<int64_t> slots_;
+  std::vector<char> saved_;
+};
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
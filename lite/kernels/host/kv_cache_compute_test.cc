@@ -0,0 +1,249 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/host/kv_cache_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+std::vector<float> ConcatRef(const std::vector<float>& a,
+                             const std::vector<float>& b,
+                             int64_t outer,
+                             int64_t a_block,
+                             int64_t b_block) {
+  std::vector<float> out;
+  for (int64_t o = 0; o < outer; ++o) {
+    out.insert(out.end(),
+               a.begin() + o * a_block,
+               a.begin() + (o + 1) * a_block);
+    out.insert(out.end(),
+               b.begin() + o * b_block,
+               b.begin() + (o + 1) * b_block);
+  }
+  return out;
+}
+
+void TestAppend(int axis) {
+  // [beam, head, step, dim], one step is appended per iteration.
+  const DDim x_dims({3, 2, 1, 4});
+  lite::Tensor cache, x, out;
+  cache.Resize({3, 2, 0, 4});
+  cache.mutable_data<float>();
+
+  std::vector<float> ref;
+  int64_t steps = 0;
+  KVCacheAppendCompute append;
+  operators::KVCacheAppendParam param;
+  param.cache = &cache;
+  param.x = &x;
+  param.cache_out = &cache;
+  param.out = &out;
+  param.axis = axis;
+  append.SetParam(param);
+  append.PrepareForRun();
+
+  for (int iter = 0; iter < 9; ++iter) {
+    x.Resize(x_dims);
+    auto* x_data = x.mutable_data<float>();
+    std::vector<float> x_ref(x_dims.production());
+    for (size_t i = 0; i < x_ref.size(); ++i) {
+      x_ref[i] = x_data[i] = iter * 1000 + i;
+    }
+    ref = ConcatRef(ref, x_ref, 3 * 2, steps * 4, 4);
+    const void* before = cache.raw_data();
+    const size_t capacity = cache.capacity();
+    append.Run();
+    ++steps;
+
+    ASSERT_EQ(cache.dims(), DDim({3, 2, steps, 4}));
+    ASSERT_EQ(out.dims(), cache.dims());
+    EXPECT_EQ(out.raw_data(), cache.raw_data());
+    if (capacity >= ref.size() * sizeof(float)) {
+      EXPECT_EQ(cache.raw_data(), before);
+    }
+    for (size_t i = 0; i < ref.size(); ++i) {
+      ASSERT_EQ(cache.data<float>()[i], ref[i]) << "iter " << iter;
+    }
+  }
+  // The cache grows geometrically, so it is not reallocated every step.
+  EXPECT_GE(cache.capacity(), 9 * 3 * 2 * 4 * sizeof(float));
+}
+
+TEST(kv_cache_append, steps) {
+  TestAppend(2);
+  TestAppend(-2);
+}
+
+TEST(kv_cache_append, int64) {
+  lite::Tensor cache, x, out;
+  cache.Resize({2, 3});
+  auto* cache_data = cache.mutable_data<int64_t>();
+  x.Resize({2, 1});
+  auto* x_data = x.mutable_data<int64_t>();
+  for (int i = 0; i < 6; ++i) cache_data[i] = i;
+  x_data[0] = 100;
+  x_data[1] = 101;
+
+  KVCacheAppendCompute append;
+  operators::KVCacheAppendParam param;
+  param.cache = &cache;
+  param.x = &x;
+  param.cache_out = &cache;
+  param.out = &out;
+  param.axis = 1;
+  append.SetParam(param);
+  append.Run();
+
+  const std::vector<int64_t> ref{0, 1, 2, 100, 3, 4, 5, 101};
+  ASSERT_EQ(cache.dims(), DDim({2, 4}));
+  EXPECT_EQ(cache.precision(), PRECISION(kInt64));
+  for (size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_EQ(out.data<int64_t>()[i], ref[i]);
+  }
+}
+
+TEST(kv_cache_append, shared_buffer) {
+  // The cache has room for the new step, but another tensor shares its
+  // buffer and must keep its data.
+  lite::Tensor cache, shared, x, out;
+  cache.Resize({2, 4});
+  cache.mutable_data<float>();
+  cache.Resize({2, 3});
+  auto* cache_data = cache.mutable_data<float>();
+  for (int i = 0; i < 6; ++i) cache_data[i] = i;
+  shared.ShareDataWith(cache);
+  x.Resize({2, 1});
+  auto* x_data = x.mutable_data<float>();
+  x_data[0] = 100;
+  x_data[1] = 101;
+
+  KVCacheAppendCompute append;
+  operators::KVCacheAppendParam param;
+  param.cache = &cache;
+  param.x = &x;
+  param.cache_out = &cache;
+  param.out = &out;
+  param.axis = 1;
+  append.SetParam(param);
+  append.Run();
+
+  const std::vector<float> ref{0, 1, 2, 100, 3, 4, 5, 101};
+  ASSERT_EQ(cache.dims(), DDim({2, 4}));
+  EXPECT_NE(cache.raw_data(), shared.raw_data());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_EQ(cache.data<float>()[i], ref[i]);
+  }
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(shared.data<float>()[i], i);
+  }
+}
+
+template <typename IndexT>
+void TestReorder(const std::vector<IndexT>& index, int64_t rows) {
+  const int64_t row_size = 5;
+  lite::Tensor cache, index_tensor, out;
+  cache.Resize({rows, row_size});
+  auto* cache_data = cache.mutable_data<float>();
+  for (int64_t i = 0; i < rows * row_size; ++i) cache_data[i] = i;
+  std::vector<float> ref;
+  for (auto src : index) {
+    for (int64_t j = 0; j < row_size; ++j) {
+      ref.push_back(src * row_size + j);
+    }
+  }
+  index_tensor.Resize({static_cast<int64_t>(index.size())});
+  auto* index_data = index_tensor.mutable_data<IndexT>();
+  for (size_t i = 0; i < index.size(); ++i) index_data[i] = index[i];
+  const void* before = cache.raw_data();
+
+  KVCacheReorderCompute reorder;
+  operators::KVCacheReorderParam param;
+  param.cache = &cache;
+  param.index = &index_tensor;
+  param.cache_out = &cache;
+  param.out = &out;
+  reorder.SetParam(param);
+  reorder.Run();
+
+  ASSERT_EQ(cache.dims(),
+            DDim({static_cast<int64_t>(index.size()), row_size}));
+  EXPECT_EQ(out.raw_data(), cache.raw_data());
+  if (static_cast<int64_t>(index.size()) == rows) {
+    EXPECT_EQ(cache.raw_data(), before);
+  }
+  for (size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_EQ(cache.data<float>()[i], ref[i]);
+  }
+}
+
+TEST(kv_cache_reorder, in_place) {
+  // The identity, duplicated parents, and cycles of rows.
+  TestReorder<int32_t>({0, 1, 2, 3}, 4);
+  TestReorder<int32_t>({0, 0, 0, 3}, 4);
+  TestReorder<int64_t>({1, 2, 3, 0}, 4);
+  TestReorder<int64_t>({3, 3, 1, 1, 4, 0}, 6);
+}
+
+TEST(kv_cache_reorder, resize) {
+  // The first step of beam search expands every source to the beams.
+  TestReorder<int64_t>({0, 0, 0, 1, 1, 1}, 2);
+  TestReorder<int32_t>({2, 0}, 3);
+}
+
+TEST(kv_cache_reorder, shared_buffer) {
+  lite::Tensor cache, shared, index, out;
+  cache.Resize({3, 2});
+  auto* cache_data = cache.mutable_data<float>();
+  for (int i = 0; i < 6; ++i) cache_data[i] = i;
+  shared.ShareDataWith(cache);
+  index.Resize({3});
+  auto* index_data = index.mutable_data<int64_t>();
+  index_data[0] = 2;
+  index_data[1] = 0;
+  index_data[2] = 0;
+
+  KVCacheReorderCompute reorder;
+  operators::KVCacheReorderParam param;
+  param.cache = &cache;
+  param.index = &index;
+  param.cache_out = &cache;
+  param.out = &out;
+  reorder.SetParam(param);
+  reorder.Run();
+
+  const std::vector<float> ref{4, 5, 0, 1, 0, 1};
+  EXPECT_NE(cache.raw_data(), shared.raw_data());
+  for (size_t i = 0; i < ref.size(); ++i) {
+    EXPECT_EQ(cache.data<float>()[i], ref[i]);
+  }
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(shared.data<float>()[i], i);
+  }
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(kv_cache_append, kHost, kAny, kAny, def);
+USE_LITE_KERNEL(kv_cache_reorder, kHost, kAny, kAny, def);
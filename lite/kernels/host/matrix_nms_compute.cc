@@ -17,50 +17,13 @@
 #include <map>
 #include <utility>
 #include <vector>
+#include "lite/backends/host/math/nms_util.h"
 
 namespace paddle {
 namespace lite {
 namespace kernels {
 namespace host {
 
-template <class T>
-static T BBoxArea(const T* box, const bool normalized) {
-  if (box[2] < box[0] || box[3] < box[1]) {
-    // If coordinate values are is invalid
-    // (e.g. xmax < xmin or ymax < ymin), return 0.
-    return static_cast<T>(0.);
-  } else {
-    const T w = box[2] - box[0];
-    const T h = box[3] - box[1];
-    if (normalized) {
-      return w * h;
-    } else {
-      // If coordinate values are not within range [0, 1].
-      return (w + 1) * (h + 1);
-    }
-  }
-}
-
-template <class T>
-static T JaccardOverlap(const T* box1, const T* box2, const bool normalized) {
-  if (box2[0] > box1[2] || box2[2] < box1[0] || box2[1] > box1[3] ||
-      box2[3] < box1[1]) {
-    return static_cast<T>(0.);
-  } else {
-    const T inter_xmin = (std::max)(box1[0], box2[0]);
-    const T inter_ymin = (std::max)(box1[1], box2[1]);
-    const T inter_xmax = (std::min)(box1[2], box2[2]);
-    const T inter_ymax = (std::min)(box1[3], box2[3]);
-    T norm = normalized ? static_cast<T>(0.) : static_cast<T>(1.);
-    T inter_w = inter_xmax - inter_xmin + norm;
-    T inter_h = inter_ymax - inter_ymin + norm;
-    const T inter_area = inter_w * inter_h;
-    const T bbox1_area = BBoxArea<T>(box1, normalized);
-    const T bbox2_area = BBoxArea<T>(box2, normalized);
-    return inter_area / (bbox1_area + bbox2_area - inter_area);
-  }
-}
-
 template <class T>
 T PolyIoU(const T* box1,
           const T* box2,
@@ -125,16 +88,20 @@ void NMSMatrix(const Tensor& bbox,
   std::vector<T> iou_matrix((num_pre * (num_pre - 1)) >> 1);
   std::vector<T> iou_max(num_pre);
 
+  // Gather the preselected boxes in score order so that every row of the
+  // iou matrix is a single vectorized pass over contiguous coordinates.
+  lite::host::math::BoxesSoA<T> sorted_boxes(num_pre, normalized);
+  for (int64_t i = 0; i < num_pre; i++) {
+    sorted_boxes.Push(bbox_ptr + perm[i] * box_size);
+  }
+
   iou_max[0] = 0.;
   for (int64_t i = 1; i < num_pre; i++) {
+    T* iou_row = iou_matrix.data() + i * (i - 1) / 2;
+    sorted_boxes.Overlaps(bbox_ptr + perm[i] * box_size, 0, i, iou_row);
     T max_iou = 0.;
-    auto idx_a = perm[i];
     for (int64_t j = 0; j < i; j++) {
-      auto idx_b = perm[j];
-      auto iou = JaccardOverlap<T>(
-          bbox_ptr + idx_a * box_size, bbox_ptr + idx_b * box_size, normalized);
-      max_iou = (std::max)(max_iou, iou);
-      iou_matrix[i * (i - 1) / 2 + j] = iou;
+      max_iou = (std::max)(max_iou, iou_row[j]);
     }
     iou_max[i] = max_iou;
   }
@@ -173,20 +140,16 @@ size_t MultiClassMatrixNMS(const Tensor& scores,
                            T score_threshold,
                            T post_threshold,
                            bool use_gaussian,
-                           float gaussian_sigma) {
-  std::vector<int> all_indices;
-  std::vector<T> all_scores;
-  std::vector<T> all_classes;
-  all_indices.reserve(scores.numel());
-  all_scores.reserve(scores.numel());
-  all_classes.reserve(scores.numel());
-
-  size_t num_det = 0;
+                           float gaussian_sigma,
+                           bool parallel_classes) {
   auto class_num = scores.dims()[0];
-  Tensor score_slice;
-  for (int64_t c = 0; c < class_num; ++c) {
-    if (c == background_label) continue;
-    score_slice = scores.Slice<float>(c, c + 1);
+  // Every class is decayed independently into its own buffers, which are
+  // then concatenated in class order exactly as a sequential loop would.
+  std::vector<std::vector<int>> class_indices(class_num);
+  std::vector<std::vector<T>> class_scores(class_num);
+  auto nms_one_class = [&](int64_t c) {
+    if (c == background_label) return;
+    Tensor score_slice = scores.Slice<float>(c, c + 1);
     if (use_gaussian) {
       NMSMatrix<T, true>(bboxes,
                          score_slice,
@@ -195,8 +158,8 @@ size_t MultiClassMatrixNMS(const Tensor& scores,
                          gaussian_sigma,
                          nms_top_k,
                          normalized,
-                         &all_indices,
-                         &all_scores);
+                         &class_indices[c],
+                         &class_scores[c]);
     } else {
       NMSMatrix<T, false>(bboxes,
                           score_slice,
@@ -205,13 +168,35 @@ size_t MultiClassMatrixNMS(const Tensor& scores,
                           gaussian_sigma,
                           nms_top_k,
                           normalized,
-                          &all_indices,
-                          &all_scores);
+                          &class_indices[c],
+                          &class_scores[c]);
     }
-    for (size_t i = 0; i < all_indices.size() - num_det; i++) {
-      all_classes.push_back(static_cast<T>(c));
+  };
+  if (parallel_classes) {
+    lite::host::math::ParallelFor(class_num, nms_one_class);
+  } else {
+    for (int64_t c = 0; c < class_num; ++c) {
+      nms_one_class(c);
     }
-    num_det = all_indices.size();
+  }
+
+  size_t num_det = 0;
+  for (int64_t c = 0; c < class_num; ++c) {
+    num_det += class_indices[c].size();
+  }
+  std::vector<int> all_indices;
+  std::vector<T> all_scores;
+  std::vector<T> all_classes;
+  all_indices.reserve(num_det);
+  all_scores.reserve(num_det);
+  all_classes.reserve(num_det);
+  for (int64_t c = 0; c < class_num; ++c) {
+    all_indices.insert(
+        all_indices.end(), class_indices[c].begin(), class_indices[c].end());
+    all_scores.insert(
+        all_scores.end(), class_scores[c].begin(), class_scores[c].end());
+    all_classes.insert(
+        all_classes.end(), class_indices[c].size(), static_cast<T>(c));
   }
 
   if (num_det <= 0) {
@@ -272,36 +257,43 @@ void MatrixNmsCompute::Run() {
   auto box_dim = boxes->dims()[2];
   auto out_dim = box_dim + 2;
 
-  Tensor boxes_slice, scores_slice;
-  int64_t num_out = 0;
-  std::vector<int64_t> offsets = {0};
-  std::vector<float> detections;
-  std::vector<int> indices;
-  std::vector<int> num_per_batch;
-  detections.reserve(out_dim * num_boxes * batch_size);
-  indices.reserve(num_boxes * batch_size);
-  num_per_batch.reserve(batch_size);
-  for (int i = 0; i < batch_size; ++i) {
-    scores_slice = scores->Slice<float>(i, i + 1);
+  // Images are independent, so run them concurrently. With a single image
+  // the classes are processed concurrently instead.
+  std::vector<std::vector<float>> batch_detections(batch_size);
+  std::vector<std::vector<int>> batch_indices(batch_size);
+  std::vector<int> num_per_batch(batch_size, 0);
+  const bool parallel_classes = batch_size == 1;
+  auto nms_one_image = [&](int i) {
+    Tensor scores_slice = scores->Slice<float>(i, i + 1);
     scores_slice.Resize({score_dims[1], score_dims[2]});
-    boxes_slice = boxes->Slice<float>(i, i + 1);
+    Tensor boxes_slice = boxes->Slice<float>(i, i + 1);
     boxes_slice.Resize({score_dims[2], box_dim});
     int start = i * score_dims[2];
-    num_out = MultiClassMatrixNMS(scores_slice,
-                                  boxes_slice,
-                                  &detections,
-                                  &indices,
-                                  start,
-                                  background_label,
-                                  nms_top_k,
-                                  keep_top_k,
-                                  normalized,
-                                  score_threshold,
-                                  post_threshold,
-                                  use_gaussian,
-                                  gaussian_sigma);
-    offsets.push_back(offsets.back() + num_out);
-    num_per_batch.emplace_back(num_out);
+    batch_detections[i].reserve(out_dim * num_boxes);
+    batch_indices[i].reserve(num_boxes);
+    num_per_batch[i] = MultiClassMatrixNMS(scores_slice,
+                                           boxes_slice,
+                                           &batch_detections[i],
+                                           &batch_indices[i],
+                                           start,
+                                           background_label,
+                                           nms_top_k,
+                                           keep_top_k,
+                                           normalized,
+                                           score_threshold,
+                                           post_threshold,
+                                           use_gaussian,
+                                           gaussian_sigma,
+                                           parallel_classes);
+  };
+  if (parallel_classes) {
+    nms_one_image(0);
+  } else {
+    lite::host::math::ParallelFor(batch_size, nms_one_image);
+  }
+  std::vector<int64_t> offsets = {0};
+  for (int i = 0; i < batch_size; ++i) {
+    offsets.push_back(offsets.back() + num_per_batch[i]);
   }
 
   int64_t num_kept = offsets.back();
@@ -313,9 +305,14 @@ void MatrixNmsCompute::Run() {
   } else {
     outs->Resize({num_kept, out_dim});
     index->Resize({num_kept, 1});
-    std::copy(
-        detections.begin(), detections.end(), outs->mutable_data<float>());
-    std::copy(indices.begin(), indices.end(), index->mutable_data<int>());
+    float* out_data = outs->mutable_data<float>();
+    int* index_data = index->mutable_data<int>();
+    for (int i = 0; i < batch_size; ++i) {
+      out_data = std::copy(
+          batch_detections[i].begin(), batch_detections[i].end(), out_data);
+      index_data = std::copy(
+          batch_indices[i].begin(), batch_indices[i].end(), index_data);
+    }
   }
 
   if (rois_num != nullptr) {
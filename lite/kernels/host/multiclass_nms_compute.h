@@ -81,23 +81,36 @@ void NMSFast(const Tensor& bbox,
       scores_data, score_threshold, top_k, &sorted_indices);
 
   selected_indices->clear();
+  selected_indices->reserve(sorted_indices.size());
   T adaptive_threshold = nms_threshold;
   const T* bbox_data = bbox.data<T>();
 
-  while (sorted_indices.size() != 0) {
-    const int idx = sorted_indices.front().second;
+  // 4: [xmin ymin xmax ymax], checked against the kept boxes in SoA layout.
+  if (box_size == 4) {
+    lite::host::math::BoxesSoA<T> kept_boxes(sorted_indices.size(),
+                                             normalized);
+    for (size_t i = 0; i < sorted_indices.size(); ++i) {
+      const int idx = sorted_indices[i].second;
+      const T* box = bbox_data + idx * box_size;
+      bool keep = !kept_boxes.Suppress(box, adaptive_threshold);
+      if (keep) {
+        selected_indices->push_back(idx);
+        kept_boxes.Push(box);
+      }
+      if (keep && eta < 1 && adaptive_threshold > 0.5) {
+        adaptive_threshold *= eta;
+      }
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < sorted_indices.size(); ++i) {
+    const int idx = sorted_indices[i].second;
     bool keep = true;
     for (size_t k = 0; k < selected_indices->size(); ++k) {
       if (keep) {
         const int kept_idx = (*selected_indices)[k];
         T overlap = T(0.);
-        // 4: [xmin ymin xmax ymax]
-        if (box_size == 4) {
-          overlap = lite::host::math::JaccardOverlap<T>(
-              bbox_data + idx * box_size,
-              bbox_data + kept_idx * box_size,
-              normalized);
-        }
         // 8: [x1 y1 x2 y2 x3 y3 x4 y4] or 16, 24, 32
         if (box_size == 8 || box_size == 16 || box_size == 24 ||
             box_size == 32) {
@@ -115,7 +128,6 @@ void NMSFast(const Tensor& bbox,
     if (keep) {
       selected_indices->push_back(idx);
     }
-    sorted_indices.erase(sorted_indices.begin());
     if (keep && eta < 1 && adaptive_threshold > 0.5) {
       adaptive_threshold *= eta;
     }
@@ -128,7 +140,8 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
                    const Tensor& bboxes,
                    const int scores_size,
                    std::map<int, std::vector<int>>* indices,
-                   int* num_nmsed_out) {
+                   int* num_nmsed_out,
+                   bool parallel_classes = false) {
   int64_t background_label = param.background_label;
   int64_t nms_top_k = param.nms_top_k;
   int64_t keep_top_k = param.keep_top_k;
@@ -140,9 +153,16 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
   int num_det = 0;
 
   int64_t class_num = scores_size == 3 ? scores.dims()[0] : scores.dims()[1];
-  Tensor bbox_slice, score_slice;
+  // Create the per-class slots up front so that classes can be processed
+  // concurrently, each one writing only its own vector.
+  std::vector<std::vector<int>*> class_indices(class_num, nullptr);
   for (int64_t c = 0; c < class_num; ++c) {
     if (c == background_label) continue;
+    class_indices[c] = &((*indices)[c]);
+  }
+  auto nms_one_class = [&](int64_t c) {
+    if (class_indices[c] == nullptr) return;
+    Tensor bbox_slice, score_slice;
     if (scores_size == 3) {
       score_slice = scores.Slice<T>(c, c + 1);
       bbox_slice = bboxes;
@@ -158,15 +178,27 @@ void MultiClassNMS(const operators::MulticlassNmsParam& param,
             nms_threshold,
             nms_eta,
             nms_top_k,
-            &((*indices)[c]),
+            class_indices[c],
             normalized);
     if (scores_size == 2) {
-      std::stable_sort((*indices)[c].begin(), (*indices)[c].end());
+      std::stable_sort(class_indices[c]->begin(), class_indices[c]->end());
+    }
+  };
+  if (parallel_classes) {
+    lite::host::math::ParallelFor(class_num, nms_one_class);
+  } else {
+    for (int64_t c = 0; c < class_num; ++c) {
+      nms_one_class(c);
+    }
+  }
+  for (int64_t c = 0; c < class_num; ++c) {
+    if (class_indices[c] != nullptr) {
+      num_det += class_indices[c]->size();
     }
-    num_det += (*indices)[c].size();
   }
 
   *num_nmsed_out = num_det;
+  Tensor score_slice;
   const T* scores_data = scores.data<T>();
   if (keep_top_k > -1 && num_det > keep_top_k) {
     const T* sdata;
@@ -282,12 +314,10 @@ class MulticlassNmsCompute : public KernelLite<TType, PType> {
     auto return_rois_num = param.nms_rois_num != nullptr;
     auto rois_num = param.rois_num;
 
-    std::vector<std::map<int, std::vector<int>>> all_indices;
     std::vector<uint64_t> batch_starts = {0};
     int64_t batch_size = score_dims[0];
     int64_t box_dim = boxes->dims()[2];
     int64_t out_dim = box_dim + 2;
-    int num_nmsed_out = 0;
     Tensor boxes_slice, scores_slice;
     int n;
     if (has_roissum) {
@@ -295,32 +325,47 @@ class MulticlassNmsCompute : public KernelLite<TType, PType> {
     } else {
       n = score_size == 3 ? batch_size : boxes->lod().back().size() - 1;
     }
-    for (int i = 0; i < n; ++i) {
+    std::vector<uint64_t> boxes_lod;
+    if (score_size != 3) {
+      if (has_roissum) {
+        boxes_lod = GetNmsLodFromRoisNum(rois_num);
+      } else {
+        boxes_lod = boxes->lod().back();
+      }
+    }
+
+    // Images are independent, so run them concurrently. With a single image
+    // the classes are processed concurrently instead.
+    std::vector<std::map<int, std::vector<int>>> all_indices(n);
+    std::vector<int> all_num_nmsed(n, 0);
+    const bool parallel_classes = n == 1;
+    auto nms_one_image = [&](int i) {
+      Tensor image_boxes, image_scores;
       if (score_size == 3) {
-        scores_slice = scores->template Slice<T>(i, i + 1);
-        scores_slice.Resize({score_dims[1], score_dims[2]});
-        boxes_slice = boxes->template Slice<T>(i, i + 1);
-        boxes_slice.Resize({score_dims[2], box_dim});
+        image_scores = scores->template Slice<T>(i, i + 1);
+        image_scores.Resize({score_dims[1], score_dims[2]});
+        image_boxes = boxes->template Slice<T>(i, i + 1);
+        image_boxes.Resize({score_dims[2], box_dim});
       } else {
-        std::vector<uint64_t> boxes_lod;
-        if (has_roissum) {
-          boxes_lod = GetNmsLodFromRoisNum(rois_num);
-        } else {
-          boxes_lod = boxes->lod().back();
-        }
-        scores_slice =
+        image_scores =
             scores->template Slice<T>(boxes_lod[i], boxes_lod[i + 1]);
-        boxes_slice = boxes->template Slice<T>(boxes_lod[i], boxes_lod[i + 1]);
+        image_boxes = boxes->template Slice<T>(boxes_lod[i], boxes_lod[i + 1]);
       }
-      std::map<int, std::vector<int>> indices;
       MultiClassNMS<T>(param,
-                       scores_slice,
-                       boxes_slice,
+                       image_scores,
+                       image_boxes,
                        score_size,
-                       &indices,
-                       &num_nmsed_out);
-      all_indices.push_back(indices);
-      batch_starts.push_back(batch_starts.back() + num_nmsed_out);
+                       &all_indices[i],
+                       &all_num_nmsed[i],
+                       parallel_classes);
+    };
+    if (parallel_classes) {
+      nms_one_image(0);
+    } else {
+      lite::host::math::ParallelFor(n, nms_one_image);
+    }
+    for (int i = 0; i < n; ++i) {
+      batch_starts.push_back(batch_starts.back() + all_num_nmsed[i]);
     }
 
     uint64_t num_kept = batch_starts.back();
@@ -337,6 +382,10 @@ class MulticlassNmsCompute : public KernelLite<TType, PType> {
     } else {
       outs->Resize({static_cast<int64_t>(num_kept), out_dim});
       outs->template mutable_data<T>();
+      if (return_index) {
+        index->Resize({static_cast<int64_t>(num_kept), 1});
+        index->template mutable_data<int>();
+      }
       int offset = 0;
       int* oindices = nullptr;
       for (int i = 0; i < n; ++i) {
@@ -349,12 +398,6 @@ class MulticlassNmsCompute : public KernelLite<TType, PType> {
             offset = i * score_dims[2];
           }
         } else {
-          std::vector<uint64_t> boxes_lod;
-          if (has_roissum) {
-            boxes_lod = GetNmsLodFromRoisNum(rois_num);
-          } else {
-            boxes_lod = boxes->lod().back();
-          }
           scores_slice =
               scores->template Slice<T>(boxes_lod[i], boxes_lod[i + 1]);
           boxes_slice =
@@ -368,9 +411,7 @@ class MulticlassNmsCompute : public KernelLite<TType, PType> {
         if (e > s) {
           Tensor out = outs->template Slice<T>(s, e);
           if (return_index) {
-            index->Resize({static_cast<int64_t>(num_kept), 1});
-            int* output_idx = index->template mutable_data<int>();
-            oindices = output_idx + s;
+            oindices = index->template mutable_data<int>() + s;
           }
           MultiClassOutput<T>(scores_slice,
                               boxes_slice,
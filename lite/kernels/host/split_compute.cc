@@ -38,6 +38,21 @@ void SplitCompute<T, PType>::Run() {
     axis += static_cast<int>(param.x->dims().size());
   }
 
+  // With nothing in front of the split axis each output is a contiguous
+  // slice of the input and is handed out as a view instead of a copy.
+  if (param.use_buffer_view && in_dim.count(0, axis) == 1) {
+    size_t offset = 0;
+    for (auto* out : dout) {
+      const size_t size = out->numel() * sizeof(T);
+      if (size > 0) {
+        out->ShareBufferWith(*param.x, offset, size);
+        out->set_precision(lite_api::PrecisionTypeTrait<T>::Type());
+      }
+      offset += size;
+    }
+    return;
+  }
+
   lite::host::math::split(din, dout, axis, in_strides);
 }
 
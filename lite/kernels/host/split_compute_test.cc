@@ -0,0 +1,94 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/host/split_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace host {
+
+// Splits x along `axis` and checks every output against its slice of x.
+void TestSplit(const DDim& x_dims,
+               int axis,
+               const std::vector<int64_t>& sections,
+               bool expect_views) {
+  const int real_axis = axis < 0 ? axis + x_dims.size() : axis;
+  const int64_t outer = x_dims.count(0, real_axis);
+  const int64_t inner = x_dims.count(real_axis + 1, x_dims.size());
+  lite::Tensor x;
+  x.Resize(x_dims);
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); ++i) x_data[i] = i;
+
+  std::vector<lite::Tensor> outs(sections.size());
+  std::vector<lite::Tensor*> out_ptrs;
+  for (size_t i = 0; i < sections.size(); ++i) {
+    auto dims = x_dims.Vectorize();
+    dims[real_axis] = sections[i];
+    outs[i].Resize(dims);
+    out_ptrs.push_back(&outs[i]);
+  }
+
+  SplitCompute<float, PRECISION(kFloat)> split;
+  operators::SplitParam param;
+  param.x = &x;
+  param.output = out_ptrs;
+  param.axis = axis;
+  param.use_buffer_view = true;
+  split.SetParam(param);
+  split.Run();
+
+  int64_t begin = 0;
+  for (size_t i = 0; i < sections.size(); ++i) {
+    auto& out = outs[i];
+    EXPECT_EQ(out.IsViewOf(x), expect_views);
+    EXPECT_EQ(out.precision(), PRECISION(kFloat));
+    if (expect_views) {
+      EXPECT_EQ(out.data<float>(), x_data + begin * inner);
+    }
+    const float* out_data = out.data<float>();
+    for (int64_t o = 0; o < outer; ++o) {
+      for (int64_t j = 0; j < sections[i] * inner; ++j) {
+        ASSERT_EQ(out_data[o * sections[i] * inner + j],
+                  x_data[(o * x_dims[real_axis] + begin) * inner + j]);
+      }
+    }
+    begin += sections[i];
+  }
+}
+
+TEST(split_host, buffer_view) {
+  TestSplit(DDim({1, 6, 2}), 1, {2, 4}, true);
+  TestSplit(DDim({1, 6, 2}), -2, {1, 3, 2}, true);
+  TestSplit(DDim({6, 5}), 0, {3, 3}, true);
+}
+
+TEST(split_host, buffer_view_with_outer_dims) {
+  // The slices are strided, so the outputs are copied.
+  TestSplit(DDim({2, 6, 2}), 1, {2, 4}, false);
+  TestSplit(DDim({1, 3, 4}), 2, {1, 3}, false);
+}
+
+}  // namespace host
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(split, kHost, kFloat, kNCHW, def);
@@ -67,7 +67,7 @@ struct BaseActivationFunctor {
 template <typename Functor>
 bool Activate(const lite::Tensor* X, lite::Tensor* Out) {
   using T = typename Functor::ELEMENT_TYPE;
-  auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+  const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
   CHECK_OR_FALSE(X)
   CHECK_OR_FALSE(Out)
   auto x = lite::fluid::EigenVector<T>::Flatten(*X);
@@ -146,7 +146,7 @@ class LeakyReluCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     param.Out->template mutable_data<T>();
     auto X = param.X;
     auto Out = param.Out;
-    auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+    const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
     CHECK(X);
     CHECK(Out);
     auto x = lite::fluid::EigenVector<T>::Flatten(*X);
@@ -296,7 +296,7 @@ class Relu6Compute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     param.Out->template mutable_data<T>();
     auto X = param.X;
     auto Out = param.Out;
-    auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+    const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
     CHECK(X);
     CHECK(Out);
     auto x = lite::fluid::EigenVector<T>::Flatten(*X);
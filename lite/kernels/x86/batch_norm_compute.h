@@ -147,6 +147,10 @@ class BatchNormCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
         EigenArrayMap<T> y_arr(
             param.y->template mutable_data<T>(), sample_size, N * C);
         ConstEigenArrayMap<T> x_arr(x->template data<T>(), sample_size, N * C);
+#ifdef PADDLE_WITH_MKLML
+        const bool parallel = N * C > 1 && sample_size * N * C >= (1 << 15);
+#pragma omp parallel for if (parallel)
+#endif
         for (int nc = 0; nc < N * C; ++nc) {
           y_arr.col(nc) = x_arr.col(nc) * new_scale(nc % C) + new_bias(nc % C);
         }
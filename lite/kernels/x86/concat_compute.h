@@ -56,10 +56,24 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     }
 
     auto* out = param.output;
+    int num_concat = count(0, axis, x_dims);
+    // Every input is a contiguous slice of the output, so once the inputs
+    // have been turned into views of it their producers write in place.
+    const bool use_view = param.use_buffer_view && num_concat == 1;
+    if (use_view && InputsAreViews(param)) {
+      out->template mutable_data<T>();
+      return;
+    }
+    if (use_view) {
+      // The output buffer may be reallocated below, so views that no longer
+      // match the current shapes have to keep their data elsewhere.
+      for (auto* x : param.x) {
+        if (x->IsViewOf(*out)) x->DetachView();
+      }
+    }
     T* output_data = param.output->template mutable_data<T>();
 
     int offset_concat_axis = 0;
-    int num_concat = count(0, axis, x_dims);
     int concat_input_size = count(axis + 1, x_dims.size(), x_dims);
     const int top_concat_axis = out->dims()[axis];
     for (size_t i = 0; i < param.x.size(); ++i) {
@@ -74,8 +88,37 @@ class ConcatCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       }
       offset_concat_axis += bottom_concat_axis;
     }
+    if (use_view) {
+      size_t offset = 0;
+      for (auto* x : param.x) {
+        const size_t size = x->numel() * sizeof(T);
+        if (size > 0) x->ShareBufferWith(*out, offset, size);
+        offset += size;
+      }
+    }
   }
   virtual ~ConcatCompute() = default;
+
+ private:
+  // Whether the producers of all inputs have written their results into the
+  // matching slices of the output.
+  bool InputsAreViews(const param_t& param) const {
+    const auto* out = param.output;
+    if (!out->IsInitialized()) return false;
+    size_t offset = out->offset();
+    for (auto* x : param.x) {
+      const size_t size = x->numel() * sizeof(T);
+      if (size == 0) continue;
+      if (!x->IsViewOf(*out) || x->offset() != offset ||
+          x->memory_size() != size ||
+          x->precision() != lite_api::PrecisionTypeTrait<T>::Type()) {
+        return false;
+      }
+      offset += size;
+    }
+    return offset - out->offset() ==
+           static_cast<size_t>(out->numel()) * sizeof(T);
+  }
 };
 
 }  // namespace x86
@@ -14,7 +14,9 @@
 
 #include "lite/kernels/x86/conv_compute.h"
 #include <utility>
-#include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/fp16_gemm.h"
+#include "lite/backends/x86/math/isa_dispatch.h"
+#include "lite/core/workspace.h"
 #include "lite/kernels/x86/conv_depthwise.h"
 #include "lite/kernels/x86/conv_direct.h"
 
@@ -87,21 +89,29 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
   const int ih = param.x->dims()[2];
   const int iw = param.x->dims()[3];
 
+  //! the 5x5 depthwise and direct kernels only have an AVX2 body
+  const bool use_avx2 = lite::x86::math::UseAVX2();
+
   //! select conv impl
   if (dw_kernel && kps_equal && no_dilation && flag_dw &&
-      (flag_dw_5x5 || paddings[0] == 1)) {
+      ((flag_dw_5x5 && use_avx2) || (flag_dw_3x3 && paddings[0] == 1))) {
     impl_ = new DepthwiseConv<PRECISION(kFloat), PRECISION(kFloat)>;
   }
 
-  if (ih >= 112 && ih <= 400 && iw >= 112 && iw <= 400 && input_channel >= 3 &&
-      output_channel <= 24 && output_channel % 8 == 0 && groups == 1 &&
-      kernel_h == 3 && stride_h == 2 && nodilations && kps_equal &&
-      pad_all_equal && flag_p01) {
+  if (use_avx2 && ih >= 112 && ih <= 400 && iw >= 112 && iw <= 400 &&
+      input_channel >= 3 && output_channel <= 24 && output_channel % 8 == 0 &&
+      groups == 1 && kernel_h == 3 && stride_h == 2 && nodilations &&
+      kps_equal && pad_all_equal && flag_p01) {
     impl_ = new DirectConv<PRECISION(kFloat), PRECISION(kFloat)>();
     VLOG(3) << "invoking directConv  3x3s2";
   }
 
   if (impl_) {
+    // the specialized impls only take fp32 filters
+    if (param.filter->precision() == PRECISION(kFP16)) {
+      lite::x86::math::fp16_to_fp32(*param.filter, &weights_);
+      param.filter = &weights_;
+    }
     impl_->SetContext(std::move(this->ctx_));
     impl_->SetParam(param);
     impl_->PrepareForRun();
@@ -112,7 +122,24 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::PrepareForRun() {
 template <>
 void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
   if (impl_) {
-    return impl_->Run();
+    impl_->Run();
+    auto& param = this->Param<param_t>();
+    if (param.second_x) {
+      //! the specialized impls already applied bias and activation
+      const auto& o_dims = param.output->dims();
+      residual_.Reset(*param.second_x, o_dims, 2);
+      lite::x86::math::fill_bias_residual_act(
+          param.output->mutable_data<float>(),
+          nullptr,
+          false,
+          &residual_,
+          0,
+          o_dims[0] * o_dims[1],
+          o_dims[2] * o_dims[3],
+          nullptr,
+          &param.elementwise_act_param);
+    }
+    return;
   }
   auto& ctx = ctx_->As<X86Context>();
   INIT_PARAM
@@ -127,7 +154,10 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
   auto din = param.x->data<float>();
   auto dout = param.output->mutable_data<float>();
-  auto weights = param.filter->data<float>();
+  // fp16 filters are stored by x86_fp16_weight_pass
+  bool fp16_weights = param.filter->precision() == PRECISION(kFP16);
+  auto weights = fp16_weights ? nullptr : param.filter->data<float>();
+  auto weights_fp16 = fp16_weights ? param.filter->data<uint16_t>() : nullptr;
   const float* bias_ptr =
       flag_bias ? static_cast<const float*>(param.bias->data<float>())
                 : nullptr;
@@ -135,10 +165,17 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
   if (!flag_1x1gemm_) {
     int col_size = group * group_size_coldata;
-    col_data = static_cast<float*>(
-        TargetMalloc(TARGET(kX86), col_size * sizeof(float)));
+    col_data = reinterpret_cast<float*>(
+        WorkSpace::Global_X86().Alloc(col_size * sizeof(float)));
   }
   auto act_param = param.activation_param;
+  //! a fused residual is added in the same sweep as bias and activation, a
+  //! row of the epilogue is a channel of the output
+  const lite::x86::math::ResidualBroadcast* residual = nullptr;
+  if (param.second_x) {
+    residual_.Reset(*param.second_x, o_dims, 2);
+    residual = &residual_;
+  }
   paddle::lite::x86::math::Blas<lite::TargetType::kX86> matmul(ctx);
   for (int i = 0; i < num; i++) {
     const float* din_batch = din + i * channel_in_size;
@@ -165,8 +202,21 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
 
     for (int g = 0; g < group; g++) {
       const float* col_data_group = din_data + g * group_size_coldata;
-      const float* weights_group = weights + g * group_size_weights;
       float* dout_group = dout_batch + g * group_size_out;
+      if (fp16_weights) {
+        lite::x86::math::gemm_fp16_a(ctx,
+                                     m,
+                                     n,
+                                     k,
+                                     weights_fp16 + g * group_size_weights,
+                                     k,
+                                     col_data_group,
+                                     n,
+                                     dout_group,
+                                     n);
+        continue;
+      }
+      const float* weights_group = weights + g * group_size_weights;
       if (n == 1) {
         matmul.GEMV<float>(
             false, m, k, 1.f, weights_group, col_data_group, 0.f, dout_group);
@@ -187,10 +237,22 @@ void Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)>::Run() {
       }
     }
     //! bias and activate
-    lite::x86::math::fill_bias_act(
-        dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
+    if (residual) {
+      lite::x86::math::fill_bias_residual_act(
+          dout_batch,
+          bias_ptr,
+          true,
+          residual,
+          static_cast<int64_t>(i) * chout,
+          chout,
+          wout * hout,
+          &act_param,
+          &param.elementwise_act_param);
+    } else {
+      lite::x86::math::fill_bias_act(
+          dout_batch, bias_ptr, chout, wout * hout, flag_bias, &act_param);
+    }
   }
-  if (!flag_1x1gemm_) TargetFree(TARGET(kX86), col_data);
 }
 
 template <>
@@ -341,6 +403,8 @@ REGISTER_LITE_KERNEL(conv2d, kX86, kFloat, kNCHW, ConvFp32, def)
 REGISTER_LITE_KERNEL(depthwise_conv2d, kX86, kFloat, kNCHW, ConvFp32, def)
     .BindInput("Input",
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("SecondInput",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindInput("Filter",
                {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
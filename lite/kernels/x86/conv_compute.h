@@ -19,6 +19,7 @@
 #include "lite/backends/x86/math/avx/conv_utils.h"
 #include "lite/backends/x86/math/blas.h"
 #include "lite/backends/x86/math/conv_bias.h"
+#include "lite/backends/x86/math/fill_bias_activate.h"
 #include "lite/backends/x86/math/im2col.h"
 #include "lite/backends/x86/math/vol2col.h"
 #include "lite/core/kernel.h"
@@ -81,6 +82,8 @@ class Conv2dCompute : public KernelLite<TARGET(kX86), Ptype> {
   std::vector<float> w_scale_;
   Tensor weights_;
   Tensor bias_;
+  // reads SecondInput, planned again only when its dims change
+  lite::x86::math::ResidualBroadcast residual_;
 };
 
 }  // namespace x86
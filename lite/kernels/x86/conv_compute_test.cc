@@ -14,12 +14,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "lite/backends/x86/math/fill_bias_activate.h"
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/conv_compute.h"
+#include "lite/utils/float16.h"
 
 namespace paddle {
 namespace lite {
@@ -92,6 +96,255 @@ TEST(conv2d_x86, run_test) {
   }
 }
 
+TEST(conv2d_x86, run_residual_test) {
+  lite::Tensor x, filter, b, residual, out;
+  x.Resize({1, 2, 2, 2});
+  filter.Resize({2, 2, 1, 1});
+  b.Resize({2});
+  residual.Resize({2, 1, 1});
+  out.Resize({1, 2, 2, 2});
+
+  auto x_data = x.mutable_data<float>();
+  auto filter_data = filter.mutable_data<float>();
+  auto b_data = b.mutable_data<float>();
+  auto residual_data = residual.mutable_data<float>();
+  auto out_data = out.mutable_data<float>();
+  for (int64_t i = 0; i < x.dims().production(); i++) {
+    x_data[i] = 1;
+  }
+  for (int64_t i = 0; i < filter.dims().production(); i++) {
+    filter_data[i] = 1;
+  }
+  b_data[0] = 1;
+  b_data[1] = -10;
+  // broadcast over the spatial dims of each channel
+  residual_data[0] = -5;
+  residual_data[1] = 4;
+
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  operators::ConvParam param;
+  param.x = &x;
+  param.filter = &filter;
+  param.bias = &b;
+  param.second_x = &residual;
+  param.output = &out;
+  param.strides = {1, 1};
+  param.groups = 1;
+  param.paddings = std::make_shared<std::vector<int>>(4, 0);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  param.activation_param.has_active = true;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+  param.fuse_elementwise_op_type = "fusion_elementwise_add_activation";
+  param.elementwise_act_param.has_active = true;
+  param.elementwise_act_param.active_type = lite_api::ActivationType::kRelu;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.Run();
+
+  // relu(relu(2 + bias) + residual) per channel
+  float ref_result[2] = {0.f, 4.f};
+  for (int i = 0; i < out.dims().production(); i++) {
+    EXPECT_NEAR(out_data[i], ref_result[i / 4], 1e-5);
+  }
+}
+
+// Rows of 3 x 4 columns of an output {2, 3, 4}. The residual is read in
+// place, or expanded when it broadcasts along part of a row, and a Reset
+// with the same dims still picks up new data.
+TEST(conv2d_x86, residual_broadcast_test) {
+  const lite::DDim out_dims(std::vector<int64_t>{2, 3, 4});
+  lite::x86::math::ResidualBroadcast broadcast;
+  const std::vector<std::vector<int64_t>> residual_shapes{
+      {3, 4}, {2, 1, 1}, {3, 1}, {3, 1}, {2, 1, 4}};
+  for (size_t s = 0; s < residual_shapes.size(); s++) {
+    const auto& shape = residual_shapes[s];
+    lite::Tensor residual;
+    residual.Resize(shape);
+    auto* res_data = residual.mutable_data<float>();
+    for (int64_t i = 0; i < residual.numel(); i++) {
+      res_data[i] = static_cast<float>(i + 10 * s);
+    }
+    broadcast.Reset(residual, out_dims, 1);
+    const int offset = 3 - static_cast<int>(shape.size());
+    for (int64_t i = 0; i < out_dims.production(); i++) {
+      int64_t index[3] = {i / 12, i / 4 % 3, i % 4};
+      int64_t res_offset = 0;
+      for (int d = offset; d < 3; d++) {
+        int64_t dim = shape[d - offset];
+        res_offset = res_offset * dim + (dim == out_dims[d] ? index[d] : 0);
+      }
+      const float* row = broadcast.row(index[0]);
+      EXPECT_EQ(row[(i % 12) * broadcast.col_stride()], res_data[res_offset])
+          << "residual " << residual.dims() << " at " << i;
+    }
+  }
+}
+
+// The epilogue of the fused residual runs 8 columns at a time under AVX and
+// the tail column by column. Every activation it vectorizes, as act and as
+// post_act, must give the vectorized columns the result of the scalar
+// tail, which a call with a single column takes.
+TEST(conv2d_x86, fill_bias_residual_act_test) {
+  using lite_api::ActivationType;
+  std::vector<operators::ActivationParam> acts;
+  for (auto type : {ActivationType::kRelu,
+                    ActivationType::kRelu6,
+                    ActivationType::kLeakyRelu,
+                    ActivationType::kHardSwish,
+                    ActivationType::kHardSigmoid,
+                    ActivationType::kSigmoid,
+                    ActivationType::kSwish,
+                    ActivationType::kTanh,
+                    ActivationType::kGelu}) {
+    operators::ActivationParam act;
+    act.has_active = true;
+    act.active_type = type;
+    act.Leaky_relu_alpha = 0.1f;
+    act.Swish_beta = 1.5f;
+    act.gelu_approximate = true;
+    acts.push_back(act);
+  }
+
+  const int rows = 3;
+  const int cols = 19;
+  lite::Tensor bias, out, out_ref;
+  bias.Resize({cols});
+  out.Resize({rows, cols});
+  out_ref.Resize({rows, cols});
+  auto* bias_data = bias.mutable_data<float>();
+  for (int i = 0; i < cols; i++) {
+    bias_data[i] = 0.25f * (i % 7) - 0.75f;
+  }
+  // a residual of the same shape, and one broadcast along each row
+  for (int64_t res_cols : {cols, 1}) {
+    lite::Tensor residual;
+    residual.Resize({rows, res_cols});
+    auto* res_data = residual.mutable_data<float>();
+    for (int64_t i = 0; i < residual.numel(); i++) {
+      res_data[i] = static_cast<float>((i * 5) % 11) / 2.f - 2.5f;
+    }
+    lite::x86::math::ResidualBroadcast broadcast;
+    broadcast.Reset(residual, out.dims(), 1);
+    for (size_t a = 0; a < acts.size(); a++) {
+      const auto* act = &acts[a];
+      const auto* post_act = &acts[(a + 1) % acts.size()];
+      auto* out_data = out.mutable_data<float>();
+      auto* ref_data = out_ref.mutable_data<float>();
+      for (int64_t i = 0; i < out.numel(); i++) {
+        out_data[i] = static_cast<float>((i * 37) % 97) / 6.f - 8.f;
+        ref_data[i] = out_data[i];
+      }
+      lite::x86::math::fill_bias_residual_act(
+          out_data, bias_data, false, &broadcast, 0, rows, cols, act, post_act);
+      for (int r = 0; r < rows; r++) {
+        for (int c = 0; c < cols; c++) {
+          lite::Tensor res_one;
+          res_one.Resize({1});
+          res_one.mutable_data<float>()[0] =
+              res_data[r * res_cols + (res_cols == 1 ? 0 : c)];
+          lite::x86::math::ResidualBroadcast one;
+          one.Reset(res_one, res_one.dims(), 0);
+          lite::x86::math::fill_bias_residual_act(ref_data + r * cols + c,
+                                                  bias_data + c,
+                                                  false,
+                                                  &one,
+                                                  0,
+                                                  1,
+                                                  1,
+                                                  act,
+                                                  post_act);
+        }
+      }
+      for (int64_t i = 0; i < out.numel(); i++) {
+        ASSERT_NEAR(out_data[i],
+                    ref_data[i],
+                    1e-5f * std::max(1.f, std::fabs(ref_data[i])))
+            << "act " << static_cast<int>(act->active_type) << " post_act "
+            << static_cast<int>(post_act->active_type) << " residual cols "
+            << res_cols << " at " << i;
+      }
+    }
+  }
+}
+
+static void RunConv(lite::Tensor* x,
+                    lite::Tensor* filter,
+                    lite::Tensor* b,
+                    int groups,
+                    int pad,
+                    lite::Tensor* out) {
+  Conv2dCompute<PRECISION(kFloat), PRECISION(kFloat)> conv2d;
+  operators::ConvParam param;
+  param.x = x;
+  param.filter = filter;
+  param.bias = b;
+  param.output = out;
+  param.strides = {1, 1};
+  param.groups = groups;
+  param.paddings = std::make_shared<std::vector<int>>(4, pad);
+  param.dilations = std::make_shared<std::vector<int>>(2, 1);
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  conv2d.SetContext(std::move(ctx));
+  conv2d.SetParam(param);
+  conv2d.PrepareForRun();
+  conv2d.Run();
+}
+
+// The filter is stored in fp16 the way x86_fp16_weight_pass stores it, the
+// result must match the fp32 kernel within fp16 rounding of the weights.
+TEST(conv2d_x86, run_fp16_weight_test) {
+  struct Case {
+    int chin, chout, groups, ksize, pad;
+  };
+  // 1x1 gemm, grouped 3x3 im2col gemm and 3x3 depthwise
+  for (const auto& c : {Case{16, 24, 1, 1, 0},
+                        Case{8, 12, 2, 3, 1},
+                        Case{8, 8, 8, 3, 1}}) {
+    const int hw = 9;
+    const int hout = hw + 2 * c.pad - c.ksize + 1;
+    lite::Tensor x, filter, filter_fp16, b, out, out_ref;
+    x.Resize({2, c.chin, hw, hw});
+    filter.Resize({c.chout, c.chin / c.groups, c.ksize, c.ksize});
+    filter_fp16.Resize(filter.dims());
+    b.Resize({c.chout});
+    out.Resize({2, c.chout, hout, hout});
+    out_ref.Resize(out.dims());
+
+    auto* x_data = x.mutable_data<float>();
+    for (int64_t i = 0; i < x.numel(); i++) {
+      x_data[i] = static_cast<float>((i * 13) % 17) / 17.f - 0.5f;
+    }
+    auto* filter_data = filter.mutable_data<float>();
+    auto* filter_fp16_data = filter_fp16.mutable_data<uint16_t>();
+    for (int64_t i = 0; i < filter.numel(); i++) {
+      filter_data[i] = static_cast<float>((i * 7) % 23) / 23.f - 0.5f;
+      filter_fp16_data[i] = lite::float16(filter_data[i]).x;
+    }
+    filter_fp16.set_precision(PRECISION(kFP16));
+    auto* b_data = b.mutable_data<float>();
+    for (int i = 0; i < c.chout; i++) {
+      b_data[i] = 0.1f * (i % 5) - 0.2f;
+    }
+
+    RunConv(&x, &filter, &b, c.groups, c.pad, &out_ref);
+    RunConv(&x, &filter_fp16, &b, c.groups, c.pad, &out);
+
+    // every weight is off by at most 2^-11 relative, |x| <= 0.5
+    const int k = c.chin / c.groups * c.ksize * c.ksize;
+    const float tol = 0.5f * 0.5f * k / 2048.f + 1e-5f;
+    const float* out_data = out.data<float>();
+    const float* ref_data = out_ref.data<float>();
+    for (int64_t i = 0; i < out.numel(); i++) {
+      ASSERT_NEAR(out_data[i], ref_data[i], tol)
+          << "chin " << c.chin << " chout " << c.chout << " groups "
+          << c.groups << " ksize " << c.ksize << " at " << i;
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -41,7 +41,8 @@ class DirectConv : public KernelLite<TARGET(kX86), Ptype> {
 
   virtual void PrepareForRun() {
     auto& param = this->template Param<param_t>();
-#ifdef __AVX__
+#if defined(__AVX__) || defined(LITE_WITH_X86_DISPATCH)
+    // math::conv_direct_3x3s2 is built for AVX2 in dispatch builds
     constexpr int block = 8;
 #else
     constexpr int block = 4;
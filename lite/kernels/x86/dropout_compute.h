@@ -67,9 +67,9 @@ class DropoutCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       auto X = EigenMatrix<T>::Reshape(*param.x, 1);
       auto Y = EigenMatrix<T>::Reshape(*param.output, 1);
       if (param.dropout_implementation == "upscale_in_train") {
-        Y.device(lite::fluid::EigenDeviceType<lite::TargetType::kX86>()) = X;
+        Y.device(lite::fluid::GetEigenDevice<lite::TargetType::kX86>()) = X;
       } else {
-        Y.device(lite::fluid::EigenDeviceType<lite::TargetType::kX86>()) =
+        Y.device(lite::fluid::GetEigenDevice<lite::TargetType::kX86>()) =
             X * static_cast<T>(1.0f - param.dropout_prob);
       }
     }
@@ -0,0 +1,194 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <set>
+#include <thread>  // NOLINT
+#include <vector>
+#include "lite/backends/x86/fluid/eigen.h"
+#include "lite/backends/x86/math/softmax.h"
+#include "lite/backends/x86/math/softmax_impl.h"
+#include "lite/backends/x86/parallel.h"
+#include "lite/kernels/x86/activation_compute.h"
+#include "lite/kernels/x86/reduce_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Large enough for Eigen's cost model to shard every expression below.
+constexpr int64_t kBatch = 64;
+constexpr int64_t kChannel = 128;
+constexpr int64_t kSpatial = 128;
+
+// The threads evaluating a large element-wise expression on the device.
+static std::set<std::thread::id> EvaluatingThreads(
+    const Eigen::ThreadPoolDevice& device) {
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  Eigen::Tensor<float, 1> in(1 << 20);
+  Eigen::Tensor<float, 1> out(1 << 20);
+  in.setConstant(1.f);
+  out.device(device) = in.unaryExpr([&mutex, &ids](float x) {
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.insert(std::this_thread::get_id());
+    return x + 1.f;
+  });
+  return ids;
+}
+
+static void FillInput(Tensor* x, const std::vector<int64_t>& dims) {
+  x->Resize(dims);
+  auto* data = x->mutable_data<float>();
+  for (int64_t i = 0; i < x->numel(); i++) {
+    data[i] = std::sin(static_cast<float>(i) * 0.01f) * 4.f;
+  }
+}
+
+// Runs `run` once on 4 threads and once on 1, and compares the outputs.
+static void CompareWithSingleThread(const std::function<void(Tensor*)>& run,
+                                    float rel_error) {
+  Tensor sharded;
+  Tensor single;
+  lite::x86::SetNumThreads(4);
+  run(&sharded);
+  lite::x86::SetNumThreads(1);
+  run(&single);
+  ASSERT_EQ(sharded.dims(), single.dims());
+  for (int64_t i = 0; i < single.numel(); i++) {
+    float ref = single.data<float>()[i];
+    EXPECT_NEAR(sharded.data<float>()[i], ref, rel_error * (std::abs(ref) + 1))
+        << "at " << i;
+  }
+}
+
+TEST(eigen_device_x86, shard_over_math_threads) {
+  lite::x86::SetNumThreads(4);
+  auto device = lite::fluid::GetEigenDevice<TARGET(kX86)>();
+  EXPECT_EQ(device.numThreads(), 4);
+  auto ids = EvaluatingThreads(device);
+  EXPECT_GT(ids.size(), 1u);
+}
+
+TEST(eigen_device_x86, inline_with_one_thread) {
+  lite::x86::SetNumThreads(1);
+  auto device = lite::fluid::GetEigenDevice<TARGET(kX86)>();
+  EXPECT_EQ(device.numThreads(), 1);
+  EXPECT_EQ(EvaluatingThreads(device),
+            std::set<std::thread::id>{std::this_thread::get_id()});
+}
+
+TEST(eigen_device_x86, inline_in_omp_region) {
+  lite::x86::SetNumThreads(4);
+  std::vector<int> num_threads(2, 0);
+  std::vector<size_t> num_ids(2, 0);
+#pragma omp parallel num_threads(2)
+  {
+    int tid = omp_get_thread_num();
+    auto device = lite::fluid::GetEigenDevice<TARGET(kX86)>();
+    num_threads[tid] = device.numThreads();
+    num_ids[tid] = EvaluatingThreads(device).size();
+  }
+  EXPECT_EQ(num_threads, std::vector<int>(2, 1));
+  EXPECT_EQ(num_ids, std::vector<size_t>(2, 1));
+}
+
+// A worker of the pool waiting for the pool could deadlock, it evaluates
+// the nested expressions inline.
+TEST(eigen_device_x86, inline_in_pool_worker) {
+  lite::x86::SetNumThreads(4);
+  auto device = lite::fluid::GetEigenDevice<TARGET(kX86)>();
+  int nested_threads = 0;
+  size_t nested_ids = 0;
+  Eigen::Barrier barrier(1);
+  device.enqueue_with_barrier(&barrier, [&nested_threads, &nested_ids] {
+    auto nested = lite::fluid::GetEigenDevice<TARGET(kX86)>();
+    nested_threads = nested.numThreads();
+    nested_ids = EvaluatingThreads(nested).size();
+  });
+  barrier.Wait();
+  EXPECT_EQ(nested_threads, 1);
+  EXPECT_EQ(nested_ids, 1u);
+}
+
+TEST(eigen_device_x86, activation_sharded_as_single_thread) {
+  Tensor x;
+  FillInput(&x, {kBatch, kChannel, kSpatial});
+  for (bool sigmoid : {false, true}) {
+    CompareWithSingleThread(
+        [&x, sigmoid](Tensor* out) {
+          out->Resize(x.dims());
+          operators::ActivationParam param;
+          param.X = &x;
+          param.Out = out;
+          if (sigmoid) {
+            SigmoidCompute<float> kernel;
+            kernel.SetParam(param);
+            kernel.Run();
+          } else {
+            ReluCompute<float> kernel;
+            kernel.SetParam(param);
+            kernel.Run();
+          }
+        },
+        1e-6f);
+  }
+}
+
+TEST(eigen_device_x86, reduce_sharded_as_single_thread) {
+  Tensor x;
+  FillInput(&x, {kBatch, kChannel, kSpatial});
+  // Over one axis, and over all the axes into a scalar.
+  for (bool reduce_all : {false, true}) {
+    CompareWithSingleThread(
+        [&x, reduce_all](Tensor* out) {
+          out->Resize(reduce_all ? std::vector<int64_t>{1}
+                                 : std::vector<int64_t>{kBatch, kSpatial});
+          operators::ReduceParam param;
+          param.X = &x;
+          param.Out = out;
+          param.dim = {1};
+          param.reduce_all = reduce_all;
+          ReduceCompute<float, SumFunctor> kernel;
+          kernel.SetParam(param);
+          kernel.Run();
+        },
+        1e-4f);
+  }
+}
+
+// The softmax over the channels of NCHW data, which isn't the last axis, is
+// evaluated with Eigen.
+TEST(eigen_device_x86, softmax_sharded_as_single_thread) {
+  Tensor x;
+  FillInput(&x, {kBatch, kChannel * kSpatial});
+  X86Context context;
+  CompareWithSingleThread(
+      [&x, &context](Tensor* out) {
+        out->Resize(x.dims());
+        out->mutable_data<float>();
+        lite::x86::math::SoftmaxEigen<TARGET(kX86), float, true>(
+            context, kChannel, &x, out);
+      },
+      1e-5f);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -135,8 +135,13 @@ struct X86CommonElementWise {
     int batch_num = batch_arg.BatchNum();
     auto bcast_type = batch_arg.BcastType();
     int range_length = batch_arg.ElemNumPerBatch();
+    const bool parallel =
+        batch_num * range_length > x86_math::kElementwiseParallelSize;
     switch (bcast_type) {
       case (lite::kernels::host::BroadcastType::X_AS_CONTINUOUS): {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (parallel)
+#endif
         for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
           paddle::lite::x86::math::elementwise_range_to_one<X86Config>(
               batch_arg.XAtBatch(batch_id),
@@ -147,6 +152,9 @@ struct X86CommonElementWise {
         break;
       }
       case (lite::kernels::host::BroadcastType::Y_AS_CONTINUOUS): {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (parallel)
+#endif
         for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
           paddle::lite::x86::math::elementwise_one_to_range<X86Config>(
               batch_arg.XAtBatch(batch_id),
@@ -157,6 +165,9 @@ struct X86CommonElementWise {
         break;
       }
       case (lite::kernels::host::BroadcastType::BOTH_CONTINUOUS): {
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (parallel)
+#endif
         for (int batch_id = 0; batch_id < batch_num; ++batch_id) {
           paddle::lite::x86::math::elementwise_range_to_range<X86Config>(
               batch_arg.XAtBatch(batch_id),
@@ -262,12 +273,8 @@ void elementwise_compute_template(paddle::lite::KernelBase* kernel,
     fast_bcast_fn(
         x_data, y_data, out_data, pre, n, post, has_active, act_type, true);
   } else {
-    if (has_active)
-      LOG(FATAL) << "elementwise can't fuse active in this shape "
-                 << "with input1:[" << x_dims[0] << "," << x_dims[1] << ","
-                 << x_dims[2] << "," << x_dims[3] << "],"
-                 << "input2:[" << y_dims[0] << "," << y_dims[1] << ","
-                 << y_dims[2] << "," << y_dims[3] << "]";
+    // X86Config carries the activation, so the general broadcast applies it
+    // as well.
     auto batch_arg =
         lite::kernels::host::GenBatchElementWiseArg<T>(x, y, param.Out, axis);
     X86CommonElementWise<T, int64_t, X86Config>::Run(batch_arg, op);
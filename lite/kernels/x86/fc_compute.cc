@@ -18,6 +18,7 @@ REGISTER_LITE_KERNEL(
     fc, kX86, kFloat, kNCHW, paddle::lite::kernels::x86::FcCompute<float>, def)
     .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("SecondInput", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindInput("W", {LiteType::GetTensorTy(TARGET(kX86))})
     .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86))})
     .Finalize();
@@ -19,11 +19,15 @@
 #include "lite/backends/x86/jit/kernel_base.h"
 #include "lite/backends/x86/jit/kernels.h"
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/fp16_gemm.h"
+#include "lite/backends/x86/math/sparse_conv.h"
 #include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_lite.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/type_system.h"
+#include "lite/core/workspace.h"
 #include "lite/operators/fc_op.h"
 
 namespace paddle {
@@ -67,15 +71,11 @@ class FCFunctor {
       const int NN = N + 4;
       const int KK = K + 4;
 
-      // NOTE: here need to mutable_data for temporary Tensor X1 and Y1,
-      //  the overhead is unmeasured.
-      lite::Tensor X1;
-      X1.Resize(std::vector<int64_t>{M * KK});
-      T* X1_data = X1.mutable_data<T>();
-
-      lite::Tensor Y1;
-      Y1.Resize(std::vector<int64_t>{M * NN});
-      Y1_data = Y1.mutable_data<T>();
+      // The padded X1 and Y1 share one block of the per-thread workspace,
+      // which is reused across runs.
+      T* X1_data = reinterpret_cast<T*>(WorkSpace::Global_X86().Alloc(
+          (M * KK + M * NN) * sizeof(T)));
+      Y1_data = X1_data + M * KK;
 
       auto parallel_memcpy_x = [&](int64_t begin, int64_t end) {
         for (int64_t i = begin; i < end; i++) {
@@ -125,6 +125,57 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
   using param_t = operators::FcParam;
 
+  void PrepareForRun() override {
+    auto& param = *param_.get_mutable<param_t>();
+    act_param_.has_active = param.activation_type == "relu";
+    act_param_.active_type = lite_api::ActivationType::kRelu;
+    use_sparse_ = param.use_sparse_weight && !param.padding_weights &&
+                  param.w->precision() == PRECISION(kFloat);
+    if (!use_sparse_) return;
+    // Keep the columns of W as sparse rows, one per output feature.
+    const auto& w_dims = param.w->dims();
+    const int K = w_dims[0];
+    const int N = w_dims[1];
+    const T* w_data = param.w->template data<T>();
+    values_.clear();
+    columns_.clear();
+    row_ptr_.assign(1, 0);
+    for (int n = 0; n < N; ++n) {
+      for (int k = 0; k < K; ++k) {
+        const T w = w_data[k * N + n];
+        if (w != static_cast<T>(0)) {
+          values_.push_back(w);
+          columns_.push_back(k);
+        }
+      }
+      row_ptr_.push_back(static_cast<int32_t>(values_.size()));
+    }
+  }
+
+  // Applies the fused residual epilogue on the raw product in Out, in the
+  // same sweep as bias and activation when they are not applied yet.
+  void RunResidualEpilogue(const T* bias,
+                           const operators::ActivationParam* act_param,
+                           int M,
+                           int N) {
+    auto& param = *param_.get_mutable<param_t>();
+    auto* output = param.output;
+    T* output_data = output->template mutable_data<T>();
+    const auto& out_dims = output->dims();
+    residual_.Reset(*param.second_x, out_dims, out_dims.size() - 1);
+    lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+      lite::x86::math::fill_bias_residual_act(output_data + begin * N,
+                                              bias,
+                                              false,
+                                              &residual_,
+                                              begin,
+                                              end - begin,
+                                              N,
+                                              act_param,
+                                              &param.elementwise_act_param);
+    });
+  }
+
   void Run() override {
     auto& param = *param_.get_mutable<param_t>();
     auto* input = param.input;
@@ -141,11 +192,81 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int M = output->dims().production() / w_dims1;
 
     const T* input_data = input->template data<T>();
-    const T* w_data = w->template data<T>();
     T* output_data = output->template mutable_data<T>();
 
     auto& context = ctx_->As<X86Context>();
+    if (use_sparse_) {
+      lite::x86::math::sparse_fc_fp32(values_.data(),
+                                      columns_.data(),
+                                      row_ptr_.data(),
+                                      bias ? bias->template data<T>() : nullptr,
+                                      input_data,
+                                      output_data,
+                                      M,
+                                      w_dims1,
+                                      w_dims0,
+                                      act_param_);
+      if (param.second_x) {
+        RunResidualEpilogue(nullptr, nullptr, M, w_dims1);
+      }
+      return;
+    }
+    if (w->precision() == PRECISION(kFP16)) {
+      // weights stored as fp16 by x86_fp16_weight_pass
+      int N = w_dims1;
+      int ldw = padding_weights ? N + 4 : N;
+      lite::x86::math::gemm_fp16_b(context,
+                                   false,
+                                   M,
+                                   N,
+                                   w_dims0,
+                                   1.f,
+                                   input_data,
+                                   w_dims0,
+                                   w->template data<uint16_t>(),
+                                   ldw,
+                                   output_data,
+                                   N);
+      if (param.second_x) {
+        RunResidualEpilogue(
+            bias ? bias->template data<T>() : nullptr, &act_param_, M, N);
+        return;
+      }
+      if (bias) {
+        auto compute =
+            with_relu ? jit::KernelFuncs<jit::VAddReluTuple<T>,
+                                         fluid::CPUPlace>::Cache()
+                            .At(N)
+                      : jit::KernelFuncs<jit::VAddTuple<T>,
+                                         fluid::CPUPlace>::Cache()
+                            .At(N);
+        const T* bias_data = bias->template data<T>();
+        lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; i++) {
+            compute(bias_data, output_data + i * N, output_data + i * N, N);
+          }
+        });
+      }
+      return;
+    }
+    const T* w_data = w->template data<T>();
     FCFunctor<lite::TargetType::kX86, T> fc;
+    if (param.second_x) {
+      //! plain GEMM, then bias, activation and residual in one sweep
+      fc(context,
+         M,
+         w_dims1,
+         w_dims0,
+         input_data,
+         w_data,
+         output_data,
+         nullptr,
+         false,
+         padding_weights);
+      RunResidualEpilogue(
+          bias ? bias->template data<T>() : nullptr, &act_param_, M, w_dims1);
+      return;
+    }
     fc(context,
        M,
        w_dims1,
@@ -159,6 +280,16 @@ class FcCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
   }
 
   virtual ~FcCompute() = default;
+
+ private:
+  // Weights in compressed sparse row form when use_sparse_weight is set.
+  bool use_sparse_{false};
+  std::vector<T> values_;
+  std::vector<int32_t> columns_;
+  std::vector<int32_t> row_ptr_;
+  operators::ActivationParam act_param_;
+  // reads SecondInput, planned again only when its dims change
+  lite::x86::math::ResidualBroadcast residual_;
 };
 
 }  // namespace x86
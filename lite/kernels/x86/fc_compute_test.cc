@@ -0,0 +1,224 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/fc_compute.h"
+#include "lite/utils/float16.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+TEST(fc_x86, retrive_op) {
+  auto fc = KernelRegistry::Global().Create("fc");
+  ASSERT_FALSE(fc.empty());
+  ASSERT_TRUE(fc.front());
+}
+
+TEST(fc_x86, init) {
+  FcCompute<float> fc;
+  ASSERT_EQ(fc.precision(), PRECISION(kFloat));
+  ASSERT_EQ(fc.target(), TARGET(kX86));
+}
+
+static void RunFc(lite::Tensor* x,
+                  lite::Tensor* w,
+                  lite::Tensor* bias,
+                  bool with_relu,
+                  bool padding_weights,
+                  lite::Tensor* out) {
+  FcCompute<float> fc;
+  operators::FcParam param;
+  param.input = x;
+  param.w = w;
+  param.bias = bias;
+  param.output = out;
+  param.activation_type = with_relu ? "relu" : "";
+  param.padding_weights = padding_weights;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  fc.SetContext(std::move(ctx));
+  fc.SetParam(param);
+  fc.PrepareForRun();
+  fc.Run();
+}
+
+// W is stored in fp16 the way x86_fp16_weight_pass stores it, the result
+// must match the fp32 kernel within fp16 rounding of the weights.
+TEST(fc_x86, run_fp16_weight_test) {
+  for (int m : {1, 29}) {
+    for (int k : {8, 260}) {
+      for (int n : {3, 70}) {
+        for (bool padding_weights : {false, true}) {
+          for (bool with_bias : {false, true}) {
+            for (bool with_relu : {false, true}) {
+              const int pad = padding_weights ? 4 : 0;
+              lite::Tensor x, w, w_fp16, bias, out, out_ref;
+              x.Resize({m, k});
+              w.Resize({k + pad, n + pad});
+              w_fp16.Resize(w.dims());
+              bias.Resize({n});
+              out.Resize({m, n});
+              out_ref.Resize({m, n});
+
+              auto* x_data = x.mutable_data<float>();
+              for (int64_t i = 0; i < x.numel(); i++) {
+                x_data[i] = static_cast<float>((i * 13) % 17) / 17.f - 0.5f;
+              }
+              auto* w_data = w.mutable_data<float>();
+              auto* w_fp16_data = w_fp16.mutable_data<uint16_t>();
+              for (int r = 0; r < k + pad; r++) {
+                for (int c = 0; c < n + pad; c++) {
+                  int64_t i = r * (n + pad) + c;
+                  w_data[i] = r < k && c < n
+                                  ? static_cast<float>((i * 7) % 23) / 23.f -
+                                        0.5f
+                                  : 0.f;
+                  w_fp16_data[i] = lite::float16(w_data[i]).x;
+                }
+              }
+              w_fp16.set_precision(PRECISION(kFP16));
+              auto* bias_data = bias.mutable_data<float>();
+              for (int i = 0; i < n; i++) {
+                bias_data[i] = 0.1f * (i % 5) - 0.2f;
+              }
+
+              lite::Tensor* b = with_bias ? &bias : nullptr;
+              RunFc(&x, &w, b, with_relu, padding_weights, &out_ref);
+              RunFc(&x, &w_fp16, b, with_relu, padding_weights, &out);
+
+              // every weight is off by at most 2^-11 relative, |x| <= 0.5
+              const float tol = 0.5f * 0.5f * k / 2048.f + 1e-5f;
+              const float* out_data = out.data<float>();
+              const float* ref_data = out_ref.data<float>();
+              for (int64_t i = 0; i < out.numel(); i++) {
+                ASSERT_NEAR(out_data[i], ref_data[i], tol)
+                    << "m " << m << " k " << k << " n " << n << " padding "
+                    << padding_weights << " bias " << with_bias << " relu "
+                    << with_relu << " at " << i;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// Out = leaky_relu(fc(X) + SecondInput) for the dense, fp16 and sparse
+// kernels, against the plain fc followed by the add and the activation.
+TEST(fc_x86, run_residual_test) {
+  const int m = 13;
+  const int k = 20;
+  const int n = 19;
+  lite::Tensor x, w, w_fp16, bias;
+  x.Resize({m, k});
+  w.Resize({k, n});
+  w_fp16.Resize({k, n});
+  bias.Resize({n});
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>((i * 13) % 17) / 17.f - 0.5f;
+  }
+  // most of the weights are zeros, as the sparse kernel expects
+  auto* w_data = w.mutable_data<float>();
+  auto* w_fp16_data = w_fp16.mutable_data<uint16_t>();
+  for (int64_t i = 0; i < w.numel(); i++) {
+    w_data[i] = i % 3 ? 0.f : static_cast<float>((i * 7) % 23) / 23.f - 0.5f;
+    w_fp16_data[i] = lite::float16(w_data[i]).x;
+  }
+  w_fp16.set_precision(PRECISION(kFP16));
+  auto* bias_data = bias.mutable_data<float>();
+  for (int i = 0; i < n; i++) {
+    bias_data[i] = 0.1f * (i % 5) - 0.2f;
+  }
+
+  const std::vector<std::vector<int64_t>> residual_shapes{{m, n}, {n}, {m, 1}};
+  for (const auto& residual_shape : residual_shapes) {
+    lite::Tensor residual;
+    residual.Resize(residual_shape);
+    auto* res_data = residual.mutable_data<float>();
+    for (int64_t i = 0; i < residual.numel(); i++) {
+      res_data[i] = static_cast<float>((i * 5) % 11) / 11.f - 0.5f;
+    }
+    for (bool with_relu : {false, true}) {
+      lite::Tensor out_ref;
+      out_ref.Resize({m, n});
+      RunFc(&x, &w, &bias, with_relu, false, &out_ref);
+      auto* ref_data = out_ref.mutable_data<float>();
+      for (int r = 0; r < m; r++) {
+        for (int c = 0; c < n; c++) {
+          float v = ref_data[r * n + c];
+          if (residual_shape.size() == 1) {
+            v += res_data[c];
+          } else {
+            v += res_data[residual_shape[1] == 1 ? r : r * n + c];
+          }
+          ref_data[r * n + c] = v > 0.f ? v : 0.1f * v;
+        }
+      }
+
+      // the dense, the fp16 and the sparse kernel
+      for (int kernel = 0; kernel < 3; kernel++) {
+        lite::Tensor out;
+        out.Resize({m, n});
+        FcCompute<float> fc;
+        operators::FcParam param;
+        param.input = &x;
+        param.w = kernel == 1 ? &w_fp16 : &w;
+        param.bias = &bias;
+        param.output = &out;
+        param.activation_type = with_relu ? "relu" : "";
+        param.use_sparse_weight = kernel == 2;
+        param.second_x = &residual;
+        param.fuse_elementwise_op_type = "fusion_elementwise_add_activation";
+        param.elementwise_act_param.has_active = true;
+        param.elementwise_act_param.active_type =
+            lite_api::ActivationType::kLeakyRelu;
+        param.elementwise_act_param.Leaky_relu_alpha = 0.1f;
+        std::unique_ptr<KernelContext> ctx(new KernelContext);
+        ctx->As<X86Context>();
+        fc.SetContext(std::move(ctx));
+        fc.SetParam(param);
+        fc.PrepareForRun();
+        fc.Run();
+
+        // every weight is off by at most 2^-11 relative, |x| <= 0.5
+        const float tol =
+            kernel == 1 ? 0.5f * 0.5f * k / 2048.f + 1e-5f : 1e-5f;
+        const float* out_data = out.data<float>();
+        for (int64_t i = 0; i < out.numel(); i++) {
+          ASSERT_NEAR(out_data[i], ref_data[i], tol)
+              << "kernel " << kernel << " residual " << residual.dims()
+              << " relu " << with_relu << " at " << i;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fc, kX86, kFloat, kNCHW, def);
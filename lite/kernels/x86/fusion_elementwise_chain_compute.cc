@@ -0,0 +1,237 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/fusion_elementwise_chain_compute.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "lite/backends/x86/math/elementwise.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+namespace x86_math = paddle::lite::x86::math;
+
+// Number of output elements computed by the whole chain at a time.
+constexpr int kChainBlockSize = 1024;
+
+template <class OpConfig>
+void ChainBinary(const float* x,
+                 const float* y,
+                 float* z,
+                 int num,
+                 bool x_single,
+                 bool y_single) {
+  using Config = x86_math::MergeConfig<
+      OpConfig,
+      x86_math::ActiveConfig<x86_math::ActiveType::NO_ACTIVE, float>>;
+  if (x_single) {
+    x86_math::elementwise_one_to_range<Config>(x, y, z, num);
+  } else if (y_single) {
+    x86_math::elementwise_range_to_one<Config>(x, y, z, num);
+  } else {
+    x86_math::elementwise_range_to_range<Config>(x, y, z, num);
+  }
+}
+
+template <x86_math::ActiveType act_type>
+void ChainUnary(const float* x, float* z, int num) {
+  using Config =
+      x86_math::MergeConfig<x86_math::BasicConfig<float>,
+                            x86_math::ActiveConfig<act_type, float>>;
+  x86_math::do_isa_active<Config>(x, z, num);
+}
+
+void FusionElementwiseChainCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  steps_.resize(param.op_types.size());
+  int operand = 0;
+  for (size_t i = 0; i < param.op_types.size(); ++i) {
+    const auto& op_type = param.op_types[i];
+    auto& step = steps_[i];
+    if (operators::IsElementwiseChainBinaryOp(op_type)) {
+      step.operand = ++operand;
+      step.reversed = param.reversed[i] != 0;
+    }
+    if (op_type == "elementwise_add") {
+      step.binary = ChainBinary<x86_math::AddConfig<float>>;
+    } else if (op_type == "elementwise_sub") {
+      step.binary = ChainBinary<x86_math::SubConfig<float>>;
+    } else if (op_type == "elementwise_mul") {
+      step.binary = ChainBinary<x86_math::MulConfig<float>>;
+    } else if (op_type == "elementwise_div") {
+      step.binary = ChainBinary<x86_math::DivConfig<float>>;
+    } else if (op_type == "elementwise_max") {
+      step.binary = ChainBinary<x86_math::MaxConfig<float>>;
+    } else if (op_type == "elementwise_min") {
+      step.binary = ChainBinary<x86_math::MinConfig<float>>;
+    } else if (op_type == "relu") {
+      step.unary = ChainUnary<x86_math::ActiveType::RELU>;
+    } else if (op_type == "sigmoid") {
+      step.unary = ChainUnary<x86_math::ActiveType::SIGMOID>;
+    } else if (op_type == "tanh") {
+      step.unary = ChainUnary<x86_math::ActiveType::TANH>;
+    } else {
+      LOG(FATAL) << "unsupported op in elementwise chain: " << op_type;
+    }
+  }
+  operand_data_.resize(operand + 1);
+  operand_dims_.resize(operand + 1);
+  strides_.resize(operand + 1);
+}
+
+bool FusionElementwiseChainCompute::LayoutChanged(const param_t& param) const {
+  if (dims_.empty() || operand_dims_[0] != param.X->dims()) return true;
+  for (size_t i = 0; i < param.Y.size(); ++i) {
+    if (operand_dims_[i + 1] != param.Y[i]->dims()) return true;
+  }
+  return false;
+}
+
+void FusionElementwiseChainCompute::UpdateLayout(const param_t& param) {
+  operand_dims_[0] = param.X->dims();
+  for (size_t i = 0; i < param.Y.size(); ++i) {
+    operand_dims_[i + 1] = param.Y[i]->dims();
+  }
+  std::vector<std::vector<int64_t>> aligned_dims;
+  auto out_dims = operators::ElementwiseChainAlignDims(param, &aligned_dims);
+  const int rank = out_dims.size();
+  const int operand_num = aligned_dims.size();
+
+  // The continuous strides of every operand, 0 on its broadcast dims.
+  std::vector<std::vector<int64_t>> full_strides(operand_num);
+  for (int k = 0; k < operand_num; ++k) {
+    full_strides[k].resize(rank);
+    int64_t stride = 1;
+    for (int d = rank - 1; d >= 0; --d) {
+      full_strides[k][d] = aligned_dims[k][d] == 1 ? 0 : stride;
+      stride *= aligned_dims[k][d];
+    }
+  }
+
+  // Drop the dims of size 1 and merge the neighbouring dims that every
+  // operand walks the same way(both continuous or both broadcast).
+  dims_.clear();
+  for (auto& strides : strides_) strides.clear();
+  for (int d = 0; d < rank; ++d) {
+    if (out_dims[d] == 1) continue;
+    bool mergeable = !dims_.empty();
+    for (int k = 0; k < operand_num && mergeable; ++k) {
+      mergeable = strides_[k].back() == full_strides[k][d] * out_dims[d];
+    }
+    if (mergeable) {
+      dims_.back() *= out_dims[d];
+      for (int k = 0; k < operand_num; ++k) {
+        strides_[k].back() = full_strides[k][d];
+      }
+    } else {
+      dims_.push_back(out_dims[d]);
+      for (int k = 0; k < operand_num; ++k) {
+        strides_[k].push_back(full_strides[k][d]);
+      }
+    }
+  }
+  if (dims_.empty()) {
+    dims_.push_back(1);
+    for (int k = 0; k < operand_num; ++k) strides_[k].push_back(1);
+  }
+}
+
+int64_t FusionElementwiseChainCompute::OperandOffset(int operand,
+                                                     int64_t row) const {
+  const auto& strides = strides_[operand];
+  int64_t offset = 0;
+  for (int d = static_cast<int>(dims_.size()) - 2; d >= 0; --d) {
+    offset += (row % dims_[d]) * strides[d];
+    row /= dims_[d];
+  }
+  return offset;
+}
+
+void FusionElementwiseChainCompute::RunBlock(int64_t row,
+                                             int64_t start,
+                                             int len,
+                                             float* out) const {
+  // The chained value lives in the output block.
+  const float* head = operand_data_[0] + OperandOffset(0, row);
+  const float* acc = out;
+  if (strides_[0].back() == 0) {
+    std::fill(out, out + len, *head);
+  } else {
+    acc = head + start;
+  }
+  for (auto& step : steps_) {
+    if (step.unary) {
+      step.unary(acc, out, len);
+    } else {
+      const bool single = strides_[step.operand].back() == 0;
+      const float* operand = operand_data_[step.operand] +
+                             OperandOffset(step.operand, row) +
+                             (single ? 0 : start);
+      if (step.reversed) {
+        step.binary(operand, acc, out, len, single, false);
+      } else {
+        step.binary(acc, operand, out, len, false, single);
+      }
+    }
+    acc = out;
+  }
+}
+
+void FusionElementwiseChainCompute::Run() {
+  auto& param = this->Param<param_t>();
+  if (LayoutChanged(param)) {
+    UpdateLayout(param);
+  }
+  operand_data_[0] = param.X->data<float>();
+  for (size_t i = 0; i < param.Y.size(); ++i) {
+    operand_data_[i + 1] = param.Y[i]->data<float>();
+  }
+  float* out_data = param.Out->mutable_data<float>();
+  const int64_t numel = param.Out->numel();
+  if (numel == 0) return;
+
+  const int64_t inner = dims_.back();
+  const int64_t blocks_per_row =
+      (inner + kChainBlockSize - 1) / kChainBlockSize;
+  const int64_t blocks = numel / inner * blocks_per_row;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (numel > x86_math::kElementwiseParallelSize)
+#endif
+  for (int64_t i = 0; i < blocks; ++i) {
+    const int64_t row = i / blocks_per_row;
+    const int64_t start = (i % blocks_per_row) * kChainBlockSize;
+    const int len = (std::min)(static_cast<int64_t>(kChainBlockSize),
+                               inner - start);
+    RunBlock(row, start, len, out_data + row * inner + start);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(fusion_elementwise_chain,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::FusionElementwiseChainCompute,
+                     def)
+    .BindInput("X", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindInput("Y", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .BindOutput("Out", {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kFloat))})
+    .Finalize();
@@ -0,0 +1,74 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/core/op_registry.h"
+#include "lite/operators/fusion_elementwise_chain_op.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Runs a fused elementwise chain block by block: each block of the output is
+// computed by all the ops of the chain while it stays in cache. The dims of
+// all operands are collapsed first, so the innermost loop always runs over
+// either continuous or broadcast(single) values.
+class FusionElementwiseChainCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::FusionElementwiseChainParam;
+
+  void PrepareForRun() override;
+
+  void Run() override;
+
+  virtual ~FusionElementwiseChainCompute() = default;
+
+ private:
+  // z = x op y on num elements, x or y is one value if x_single or y_single.
+  using BinaryFn =
+      void (*)(const float*, const float*, float*, int, bool, bool);
+  using UnaryFn = void (*)(const float*, float*, int);
+
+  struct Step {
+    BinaryFn binary{nullptr};
+    UnaryFn unary{nullptr};
+    // index of the operand in X, Y..., only for binary ops
+    int operand{0};
+    bool reversed{false};
+  };
+
+  bool LayoutChanged(const param_t& param) const;
+  void UpdateLayout(const param_t& param);
+  int64_t OperandOffset(int operand, int64_t row) const;
+  void RunBlock(int64_t row, int64_t start, int len, float* out) const;
+
+  std::vector<Step> steps_;
+  std::vector<const float*> operand_data_;
+  // The layout below is computed for these operand dims.
+  std::vector<DDim> operand_dims_;
+  // Collapsed output dims, and the strides of every operand over them, which
+  // are 0 on the broadcast dims.
+  std::vector<int64_t> dims_;
+  std::vector<std::vector<int64_t>> strides_;
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,159 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/fusion_elementwise_chain_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+static float ChainRefOp(const std::string& op_type, float x, float y) {
+  if (op_type == "elementwise_add") return x + y;
+  if (op_type == "elementwise_sub") return x - y;
+  if (op_type == "elementwise_mul") return x * y;
+  if (op_type == "elementwise_div") return x / y;
+  if (op_type == "elementwise_max") return (std::max)(x, y);
+  if (op_type == "elementwise_min") return (std::min)(x, y);
+  if (op_type == "relu") return x > 0.f ? x : 0.f;
+  if (op_type == "sigmoid") return 1.f / (1.f + std::exp(-x));
+  return std::tanh(x);
+}
+
+// The element of `tensor` whose dims are aligned to `out_dims` as
+// `aligned_dims` at the idx-th element of the output.
+static float ChainRefAt(const Tensor& tensor,
+                        const std::vector<int64_t>& aligned_dims,
+                        const std::vector<int64_t>& out_dims,
+                        int64_t idx) {
+  int64_t offset = 0;
+  int64_t stride = 1;
+  for (int d = static_cast<int>(out_dims.size()) - 1; d >= 0; --d) {
+    if (aligned_dims[d] != 1) offset += (idx % out_dims[d]) * stride;
+    idx /= out_dims[d];
+    stride *= aligned_dims[d];
+  }
+  return tensor.data<float>()[offset];
+}
+
+static void TestChain(const std::vector<int64_t>& x_shape,
+                      const std::vector<std::vector<int64_t>>& y_shapes,
+                      const std::vector<std::string>& op_types,
+                      const std::vector<int>& axes,
+                      const std::vector<int>& reversed) {
+  Tensor x, out;
+  std::vector<Tensor> ys(y_shapes.size());
+  operators::FusionElementwiseChainParam param;
+  x.Resize(DDim(x_shape));
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    x_data[i] = static_cast<float>(i % 13) * 0.25f - 1.5f;
+  }
+  param.X = &x;
+  for (size_t k = 0; k < ys.size(); ++k) {
+    ys[k].Resize(DDim(y_shapes[k]));
+    auto* y_data = ys[k].mutable_data<float>();
+    for (int64_t i = 0; i < ys[k].numel(); ++i) {
+      y_data[i] = static_cast<float>((i + k) % 7) * 0.5f + 0.5f;
+    }
+    param.Y.push_back(&ys[k]);
+  }
+  param.Out = &out;
+  param.op_types = op_types;
+  param.axes = axes;
+  param.reversed = reversed;
+
+  std::vector<std::vector<int64_t>> aligned_dims;
+  auto out_dims = operators::ElementwiseChainAlignDims(param, &aligned_dims);
+  out.Resize(DDim(out_dims));
+
+  FusionElementwiseChainCompute chain;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  chain.SetContext(std::move(ctx));
+  chain.SetParam(param);
+  chain.PrepareForRun();
+  chain.Run();
+
+  auto* out_data = out.data<float>();
+  for (int64_t i = 0; i < out.numel(); ++i) {
+    float ref = ChainRefAt(x, aligned_dims[0], out_dims, i);
+    int k = 0;
+    for (size_t s = 0; s < op_types.size(); ++s) {
+      if (!operators::IsElementwiseChainBinaryOp(op_types[s])) {
+        ref = ChainRefOp(op_types[s], ref, 0.f);
+        continue;
+      }
+      float y = ChainRefAt(ys[k], aligned_dims[k + 1], out_dims, i);
+      k++;
+      ref = reversed[s] ? ChainRefOp(op_types[s], y, ref)
+                        : ChainRefOp(op_types[s], ref, y);
+    }
+    EXPECT_NEAR(out_data[i], ref, 1e-4 * (1.f + std::fabs(ref)));
+  }
+}
+
+TEST(fusion_elementwise_chain_x86, retrive_op) {
+  auto chain = KernelRegistry::Global().Create("fusion_elementwise_chain");
+  ASSERT_FALSE(chain.empty());
+  ASSERT_TRUE(chain.front());
+}
+
+TEST(fusion_elementwise_chain_x86, channel_scale_bias_relu) {
+  TestChain({2, 8, 5, 7},
+            {{8}, {8}},
+            {"elementwise_mul", "elementwise_add", "relu"},
+            {1, 1, -1},
+            {0, 0, 0});
+  TestChain({5000, 33},
+            {{5000, 1}, {33}},
+            {"elementwise_mul", "elementwise_add", "relu"},
+            {-1, -1, -1},
+            {0, 0, 0});
+}
+
+TEST(fusion_elementwise_chain_x86, reversed_and_broadcast) {
+  TestChain({2, 3, 40, 41},
+            {{2, 3, 40, 41}, {41}},
+            {"elementwise_add", "tanh", "elementwise_sub"},
+            {-1, -1, -1},
+            {0, 0, 1});
+  TestChain({3, 1},
+            {{1, 5}, {3, 5}},
+            {"elementwise_add", "elementwise_max", "sigmoid"},
+            {-1, -1, -1},
+            {0, 1, 0});
+  TestChain({4, 1, 9},
+            {{6, 1}, {4, 6, 9}},
+            {"elementwise_div", "elementwise_min"},
+            {-1, -1},
+            {1, 0});
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(fusion_elementwise_chain, kX86, kFloat, kNCHW, def);
@@ -42,7 +42,7 @@ void Unnormalize(const X86Context& ctx,
                  Tensor* grid_slice,
                  const int max_val,  // height-1 or width-1
                  bool align_corners) {
-  auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+  const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
   auto grid_slice_t = EigenTensor<T, 3>::From(*grid_slice);
 
   if (!align_corners) {
@@ -61,7 +61,7 @@ void Clip(const X86Context& ctx,
           const int max_val,  // height-1 or width-1
           bool align_corners,
           std::string padding_mode) {
-  auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+  const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
   auto grid_slice_t = EigenTensor<T, 3>::From(*grid_slice);
   if (padding_mode == "border") {
     grid_slice_t.device(place) = grid_slice_t.cwiseMax(static_cast<T>(0))
@@ -170,7 +170,7 @@ void AllNeigbors(const X86Context& ctx,
                  Tensor* v_en,
                  Tensor* v_ws,
                  Tensor* v_es) {  // values
-  auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+  const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
 
   const int c = input.dims()[1];
   const int n = grid_x->dims()[0];
@@ -239,7 +239,7 @@ void BilinearInter(const X86Context& ctx,
                    Tensor* grid_x,
                    Tensor* grid_y,
                    Tensor* out) {
-  auto place = lite::fluid::EigenDeviceType<TARGET(kX86)>();
+  const auto& place = lite::fluid::GetEigenDevice<TARGET(kX86)>();
   const int n = grid_x->dims()[0];
   const int out_h = grid_x->dims()[1];
   const int out_w = grid_x->dims()[2];
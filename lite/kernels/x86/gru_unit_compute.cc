@@ -49,7 +49,7 @@ void GRUUnitCompute<T>::Run() {
   auto g = EigenMatrix<T>::From(*gate);
   auto r_h_p = EigenMatrix<T>::From(*reset_hidden_prev);
   auto h = EigenMatrix<T>::From(*hidden);
-  const auto& place = lite::fluid::EigenDeviceType<lite::TargetType::kX86>();
+  const auto& place = lite::fluid::GetEigenDevice<lite::TargetType::kX86>();
 
   if (bias) {
     auto b = EigenMatrix<T>::From(*bias);
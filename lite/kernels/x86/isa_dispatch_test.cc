@@ -0,0 +1,220 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/backends/x86/math/isa_dispatch.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <functional>
+#include <vector>
+#include "lite/backends/x86/math/activation.h"
+#include "lite/backends/x86/math/avx/group_norm.h"
+#include "lite/backends/x86/math/avx/instance_norm.h"
+#include "lite/backends/x86/math/conv_depthwise_impl.h"
+#include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/pooling_global.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Sizes which leave a remainder after the 4, 8 and 32 float loops.
+constexpr int kSize = 1000 + 7;
+constexpr int kNum = 2;
+constexpr int kChannel = 6;
+constexpr int kHeight = 17;
+constexpr int kWidth = 19;
+
+static std::vector<float> Data(int size, float scale = 4.f) {
+  std::vector<float> data(size);
+  for (int i = 0; i < size; i++) {
+    data[i] = std::sin(static_cast<float>(i) * 0.37f) * scale;
+  }
+  return data;
+}
+
+// Runs `run` on the baseline SSE path and on the AVX2 one, and compares the
+// outputs.
+static void CompareBaselineWithAVX2(
+    const std::function<std::vector<float>()>& run, float rel_error) {
+  if (!lite::x86::MayIUse(lite::x86::avx2)) {
+    LOG(INFO) << "The host has no AVX2, only the baseline path is run.";
+    lite::x86::math::SetUseAVX2(false);
+    run();
+    return;
+  }
+  lite::x86::math::SetUseAVX2(false);
+  auto baseline = run();
+  lite::x86::math::SetUseAVX2(true);
+  auto avx2 = run();
+  ASSERT_EQ(baseline.size(), avx2.size());
+  for (size_t i = 0; i < baseline.size(); i++) {
+    EXPECT_NEAR(avx2[i], baseline[i], rel_error * (std::abs(baseline[i]) + 1))
+        << "at " << i;
+  }
+}
+
+TEST(isa_dispatch_x86, force_dispatch_level) {
+  lite::x86::math::SetUseAVX2(false);
+  EXPECT_FALSE(lite::x86::math::UseAVX2());
+  lite::x86::math::SetUseAVX2(lite::x86::MayIUse(lite::x86::avx2));
+  EXPECT_EQ(lite::x86::math::UseAVX2(), lite::x86::MayIUse(lite::x86::avx2));
+}
+
+TEST(isa_dispatch_x86, activation) {
+  auto x = Data(kSize);
+  CompareBaselineWithAVX2(
+      [&x] {
+        std::vector<float> out(2 * kSize);
+        lite::x86::math::mish<float>(x.data(), out.data(), kSize, 20.f);
+        lite::x86::math::hard_swish<float>(
+            x.data(), out.data() + kSize, kSize, 6.f, 3.f, 6.f);
+        return out;
+      },
+      1e-5f);
+}
+
+TEST(isa_dispatch_x86, global_pooling) {
+  auto x = Data(kSize);
+  CompareBaselineWithAVX2(
+      [&x] {
+        return std::vector<float>{
+            lite::x86::math::global_max_pool(x.data(), kSize),
+            lite::x86::math::global_avg_pool(x.data(), kSize)};
+      },
+      1e-5f);
+}
+
+TEST(isa_dispatch_x86, fill_bias_act) {
+  auto x = Data(kChannel * kSize);
+  auto bias = Data(kChannel, 1.f);
+  for (auto act_type : {lite_api::ActivationType::kRelu,
+                        lite_api::ActivationType::kRelu6,
+                        lite_api::ActivationType::kLeakyRelu,
+                        lite_api::ActivationType::kHardSwish}) {
+    operators::ActivationParam act_param;
+    act_param.has_active = true;
+    act_param.active_type = act_type;
+    act_param.Relu_clipped_coef = 6.f;
+    act_param.Leaky_relu_alpha = 0.1f;
+    act_param.hard_swish_scale = 6.f;
+    act_param.hard_swish_offset = 3.f;
+    act_param.hard_swish_threshold = 6.f;
+    for (bool flag_bias : {false, true}) {
+      CompareBaselineWithAVX2(
+          [&x, &bias, &act_param, flag_bias] {
+            auto out = x;
+            lite::x86::math::fill_bias_act(out.data(),
+                                           bias.data(),
+                                           kChannel,
+                                           kSize,
+                                           flag_bias,
+                                           &act_param);
+            return out;
+          },
+          1e-6f);
+    }
+  }
+}
+
+TEST(isa_dispatch_x86, group_and_instance_norm) {
+  const int groups = 3;
+  auto x = Data(kNum * kChannel * kHeight * kWidth);
+  auto scale = Data(kChannel, 1.f);
+  auto bias = Data(kChannel, 0.5f);
+  CompareBaselineWithAVX2(
+      [&] {
+        std::vector<float> out(x.size());
+        std::vector<float> mean(kNum * groups);
+        std::vector<float> variance(kNum * groups);
+        lite::x86::math::group_norm(x.data(),
+                                    out.data(),
+                                    kNum,
+                                    kChannel,
+                                    kHeight,
+                                    kWidth,
+                                    1e-5f,
+                                    groups,
+                                    scale.data(),
+                                    bias.data(),
+                                    mean.data(),
+                                    variance.data());
+        out.insert(out.end(), mean.begin(), mean.end());
+        out.insert(out.end(), variance.begin(), variance.end());
+        return out;
+      },
+      1e-4f);
+  CompareBaselineWithAVX2(
+      [&] {
+        std::vector<float> out(x.size());
+        std::vector<float> mean(kNum * kChannel);
+        std::vector<float> variance(kNum * kChannel);
+        lite::x86::math::instance_norm(x.data(),
+                                       out.data(),
+                                       kNum,
+                                       kChannel,
+                                       kHeight,
+                                       kWidth,
+                                       1e-5f,
+                                       scale.data(),
+                                       bias.data(),
+                                       mean.data(),
+                                       variance.data());
+        out.insert(out.end(), mean.begin(), mean.end());
+        out.insert(out.end(), variance.begin(), variance.end());
+        return out;
+      },
+      1e-4f);
+}
+
+TEST(isa_dispatch_x86, conv_depthwise_3x3) {
+  auto x = Data(kNum * kChannel * kHeight * kWidth);
+  auto weights = Data(kChannel * 9, 0.5f);
+  auto bias = Data(kChannel, 1.f);
+  operators::ActivationParam act_param;
+  act_param.has_active = true;
+  act_param.active_type = lite_api::ActivationType::kRelu;
+  for (int stride : {1, 2}) {
+    const int h_out = (kHeight + 2 - 3) / stride + 1;
+    const int w_out = (kWidth + 2 - 3) / stride + 1;
+    CompareBaselineWithAVX2(
+        [&, stride, h_out, w_out] {
+          std::vector<float> out(kNum * kChannel * h_out * w_out);
+          auto conv = stride == 1
+                          ? lite::x86::math::conv_depthwise_3x3s1_p1_direct
+                          : lite::x86::math::conv_depthwise_3x3s2_p1_direct;
+          conv(x.data(),
+               out.data(),
+               kNum,
+               kChannel,
+               h_out,
+               w_out,
+               kChannel,
+               kHeight,
+               kWidth,
+               weights.data(),
+               bias.data(),
+               1,
+               true,
+               act_param);
+          return out;
+        },
+        1e-5f);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -13,8 +13,12 @@
 // limitations under the License.
 #pragma once
 
+#include <xmmintrin.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
 #include <vector>
-#include "lite/backends/x86/fluid/eigen.h"
+#include "lite/backends/x86/math/fp16_gemm.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 
@@ -23,6 +27,12 @@ namespace lite {
 namespace kernels {
 namespace x86 {
 
+// Gathers rows of an embedding table. The table is either fp32, fp16, or
+// int8/int16 quantized row by row with one scale per row, in which case the
+// rows are dequantized while they are gathered.
+// Batches of ids are deduplicated, so every distinct row is read and
+// converted once and in ascending order, and the rows are gathered in
+// parallel with the next rows prefetched.
 template <typename T>
 class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
  public:
@@ -32,31 +42,149 @@ class LookupTableCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto &param = *param_.get_mutable<operators::LookupTableParam>();
     auto *ids_t = param.Ids;
     auto *output_t = param.Out;
-    int64_t padding_idx = param.padding_idx;
+    auto *table_t = param.W;
     const int64_t *ids = ids_t->template data<int64_t>();
-    int64_t ids_numel = ids_t->dims().production();
+    const int64_t ids_numel = ids_t->dims().production();
+    const int64_t row_number = table_t->dims()[0];
+    const int64_t row_width = table_t->dims()[1];
+    T *output = output_t->template mutable_data<T>();
 
-    auto *table_t = param.W;
-    int64_t row_number = table_t->dims()[0];
-    int64_t row_width = table_t->dims()[1];
+    const auto precision = table_t->precision();
+    if (precision == PRECISION(kInt8) || precision == PRECISION(kInt16)) {
+      CHECK_EQ(static_cast<int64_t>(param.w_scale.size()), row_number)
+          << "A quantized table needs one scale per row.";
+    }
+    for (int64_t i = 0; i < ids_numel; ++i) {
+      if (param.padding_idx != -1 && ids[i] == param.padding_idx) continue;
+      CHECK_LT(ids[i], row_number);
+      CHECK_GE(ids[i], 0);
+    }
 
-    const T *table = table_t->template data<T>();
-    T *output = output_t->template mutable_data<T>();
-    memset(output, 0, output_t->dims().production() * sizeof(T));
+    if (ids_numel < kMinDedupIds) {
+      for (int64_t i = 0; i < ids_numel; ++i) {
+        if (i + kPrefetchDistance < ids_numel) {
+          PrefetchRow(param, ids[i + kPrefetchDistance], row_width);
+        }
+        GatherRow(param, ids[i], row_width, output + i * row_width);
+      }
+      return;
+    }
+
+    // Sort the (id, position) pairs, the first position of every id owns
+    // the gathered row and the others copy it.
+    order_.resize(ids_numel);
     for (int64_t i = 0; i < ids_numel; ++i) {
-      if (padding_idx != -1 && ids[i] == padding_idx) {
-        memset(output + i * row_width, 0, row_width * sizeof(T));
-      } else {
-        CHECK_LT(ids[i], row_number);
-        CHECK_GE(ids[i], 0);
-        memcpy(output + i * row_width,
-               table + ids[i] * row_width,
-               row_width * sizeof(T));
+      order_[i] = std::make_pair(ids[i], i);
+    }
+    std::sort(order_.begin(), order_.end());
+    owners_.clear();
+    source_.resize(ids_numel);
+    for (int64_t j = 0; j < ids_numel; ++j) {
+      if (j == 0 || order_[j].first != order_[j - 1].first) {
+        owners_.push_back(j);
+      }
+      source_[j] = order_[owners_.back()].second;
+    }
+
+    const int64_t owner_num = static_cast<int64_t>(owners_.size());
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (owner_num * row_width > kParallelSize)
+#endif
+    for (int64_t k = 0; k < owner_num; ++k) {
+      if (k + kPrefetchDistance < owner_num) {
+        PrefetchRow(
+            param, order_[owners_[k + kPrefetchDistance]].first, row_width);
+      }
+      const auto &owner = order_[owners_[k]];
+      GatherRow(
+          param, owner.first, row_width, output + owner.second * row_width);
+    }
+    if (owner_num == ids_numel) return;
+#ifdef PADDLE_WITH_MKLML
+#pragma omp parallel for if (ids_numel * row_width > kParallelSize)
+#endif
+    for (int64_t j = 0; j < ids_numel; ++j) {
+      const int64_t dst = order_[j].second;
+      if (dst != source_[j]) {
+        std::memcpy(output + dst * row_width,
+                    output + source_[j] * row_width,
+                    row_width * sizeof(T));
       }
     }
   }
 
   virtual ~LookupTableCompute() = default;
+
+ private:
+  // Batches smaller than this are gathered in order without deduplication.
+  static constexpr int64_t kMinDedupIds = 16;
+  static constexpr int64_t kPrefetchDistance = 4;
+  // Gathers of fewer elements than this are not worth waking the threads.
+  static constexpr int64_t kParallelSize = 1 << 15;
+  // Only the head of a row is prefetched, the hardware prefetcher follows.
+  static constexpr int64_t kPrefetchBytes = 256;
+
+  void PrefetchRow(const operators::LookupTableParam &param,
+                   int64_t id,
+                   int64_t row_width) const {
+    if (param.padding_idx != -1 && id == param.padding_idx) return;
+    const int64_t row_bytes =
+        row_width * lite_api::PrecisionTypeLength(param.W->precision());
+    const char *row =
+        static_cast<const char *>(param.W->raw_data()) + id * row_bytes;
+    const int64_t bytes =
+        row_bytes < kPrefetchBytes ? row_bytes : kPrefetchBytes;
+    for (int64_t b = 0; b < bytes; b += 64) {
+      _mm_prefetch(row + b, _MM_HINT_T0);
+    }
+  }
+
+  void GatherRow(const operators::LookupTableParam &param,
+                 int64_t id,
+                 int64_t row_width,
+                 T *out) const {
+    if (param.padding_idx != -1 && id == param.padding_idx) {
+      std::memset(out, 0, row_width * sizeof(T));
+      return;
+    }
+    const auto *table_t = param.W;
+    switch (table_t->precision()) {
+      case PRECISION(kInt8):
+        DequantRow(table_t->template data<int8_t>() + id * row_width,
+                   param.w_scale[id],
+                   row_width,
+                   out);
+        break;
+      case PRECISION(kInt16):
+        DequantRow(table_t->template data<int16_t>() + id * row_width,
+                   param.w_scale[id],
+                   row_width,
+                   out);
+        break;
+      case PRECISION(kFP16):
+        lite::x86::math::fp16_to_fp32(
+            table_t->template data<uint16_t>() + id * row_width,
+            out,
+            row_width);
+        break;
+      default:
+        std::memcpy(out,
+                    table_t->template data<T>() + id * row_width,
+                    row_width * sizeof(T));
+        break;
+    }
+  }
+
+  template <typename Q>
+  static void DequantRow(const Q *in, float scale, int64_t n, T *out) {
+    for (int64_t i = 0; i < n; ++i) {
+      out[i] = scale * static_cast<T>(in[i]);
+    }
+  }
+
+  std::vector<std::pair<int64_t, int64_t>> order_;
+  std::vector<int64_t> owners_;
+  std::vector<int64_t> source_;
 };
 
 }  // namespace x86
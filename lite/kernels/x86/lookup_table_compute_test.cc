@@ -14,10 +14,14 @@
 
 #include "lite/kernels/x86/lookup_table_compute.h"
 #include <gtest/gtest.h>
+#include <unistd.h>
 #include <cmath>
+#include <cstdio>
 #include <string>
 #include <vector>
+#include "lite/core/model/base/io.h"
 #include "lite/core/op_registry.h"
+#include "lite/utils/float16.h"
 
 namespace paddle {
 namespace lite {
@@ -74,6 +78,115 @@ TEST(lookup_table_x86, compute) {
   }
 }
 
+// Gathers `ids` from `w` and compares against the fp32 table `ref`.
+static void CheckLookup(const lite::Tensor& w,
+                        const std::vector<float>& ref,
+                        const std::vector<float>& w_scale,
+                        const std::vector<int64_t>& ids,
+                        int64_t padding_idx,
+                        float eps) {
+  const int64_t emb_size = w.dims()[1];
+  const int64_t ids_num = static_cast<int64_t>(ids.size());
+  lite::Tensor ids_t, out;
+  ids_t.Resize({ids_num, 1});
+  std::copy(ids.begin(), ids.end(), ids_t.mutable_data<int64_t>());
+  out.Resize({ids_num, emb_size});
+
+  LookupTableCompute<float> lookup_table;
+  operators::LookupTableParam param;
+  param.W = &w;
+  param.Ids = &ids_t;
+  param.Out = &out;
+  param.padding_idx = padding_idx;
+  param.w_scale = w_scale;
+  lookup_table.SetParam(param);
+  lookup_table.Run();
+
+  const float* out_data = out.data<float>();
+  for (int64_t i = 0; i < ids_num; ++i) {
+    for (int64_t j = 0; j < emb_size; ++j) {
+      float expect = ids[i] == padding_idx ? 0.f : ref[ids[i] * emb_size + j];
+      EXPECT_NEAR(out_data[i * emb_size + j], expect, eps);
+    }
+  }
+}
+
+TEST(lookup_table_x86, quantized_table) {
+  const int vocab_size = 97;
+  const int emb_size = 37;
+  std::vector<float> ref(vocab_size * emb_size);
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ref[i] = static_cast<float>(static_cast<int>(i * 7) % 23) * 0.1f - 1.1f;
+  }
+  // Repeated ids and a padding id, enough of them to take the deduplicated
+  // parallel path.
+  std::vector<int64_t> ids;
+  for (int i = 0; i < 300; ++i) {
+    ids.push_back((i * 13) % vocab_size);
+  }
+  const int64_t padding_idx = 5;
+
+  lite::Tensor w_fp32;
+  w_fp32.Resize({vocab_size, emb_size});
+  std::copy(ref.begin(), ref.end(), w_fp32.mutable_data<float>());
+  CheckLookup(w_fp32, ref, {}, ids, padding_idx, 0.f);
+  CheckLookup(w_fp32, ref, {}, {3, 1, 3}, -1, 0.f);
+
+  lite::Tensor w_int8;
+  w_int8.Resize({vocab_size, emb_size});
+  auto* int8_data = w_int8.mutable_data<int8_t>();
+  std::vector<float> w_scale(vocab_size);
+  for (int r = 0; r < vocab_size; ++r) {
+    float abs_max = 0.f;
+    for (int c = 0; c < emb_size; ++c) {
+      abs_max = std::max(abs_max, std::fabs(ref[r * emb_size + c]));
+    }
+    w_scale[r] = abs_max / 127.f;
+    for (int c = 0; c < emb_size; ++c) {
+      int8_data[r * emb_size + c] = static_cast<int8_t>(
+          std::round(ref[r * emb_size + c] / w_scale[r]));
+    }
+  }
+  CheckLookup(w_int8, ref, w_scale, ids, padding_idx, 1e-2f);
+
+  lite::Tensor w_fp16;
+  w_fp16.Resize({vocab_size, emb_size});
+  auto* fp16_data = w_fp16.mutable_data<uint16_t>();
+  w_fp16.set_precision(PRECISION(kFP16));
+  for (size_t i = 0; i < ref.size(); ++i) {
+    fp16_data[i] = lite::float16(ref[i]).x;
+  }
+  CheckLookup(w_fp16, ref, {}, ids, -1, 1e-3f);
+}
+
+TEST(lookup_table_x86, mapped_table) {
+  const int vocab_size = 64;
+  const int emb_size = 16;
+  std::vector<float> ref(vocab_size * emb_size);
+  for (size_t i = 0; i < ref.size(); ++i) {
+    ref[i] = static_cast<float>(i) * 0.5f;
+  }
+  lite::Tensor w;
+  w.Resize({vocab_size, emb_size});
+  std::copy(ref.begin(), ref.end(), w.mutable_data<float>());
+
+  char path[] = "/tmp/lookup_table_x86_XXXXXX";
+  int fd = mkstemp(path);
+  ASSERT_GE(fd, 0);
+  close(fd);
+  std::remove(path);
+  const void* heap_data = w.raw_data();
+  ASSERT_TRUE(model_parser::MapTensorToFile(path, &w));
+  EXPECT_NE(w.raw_data(), heap_data);
+  // A second table maps the file written by the first one.
+  lite::Tensor w2;
+  w2.CopyDataFrom(w);
+  ASSERT_TRUE(model_parser::MapTensorToFile(path, &w2));
+  CheckLookup(w, ref, {}, {63, 0, 17}, -1, 0.f);
+  CheckLookup(w2, ref, {}, {1, 2, 3}, -1, 0.f);
+  std::remove(path);
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,6 +14,7 @@
 
 #include "lite/kernels/x86/match_matrix_tensor_compute.h"
 #include <vector>
+#include "lite/backends/x86/math/ragged_batch.h"
 
 namespace paddle {
 namespace lite {
@@ -68,31 +69,36 @@ void MatchMatrixTensorCompute<T>::Run() {
             bottom_l_trans_data,
             dim_t * dim_in);
 
-  for (size_t b = 0; b < x->lod()[0].size() - 1; b++) {
-    for (int t = 0; t < dim_t; t++) {
+  // The per-sequence products are independent, so balance them across
+  // threads by left sequence length.
+  lite::x86::math::RaggedBatch batch_l(offset_l);
+  batch_l.ParallelFor(dim_t * dim_in, [&](int64_t seq_begin, int64_t seq_end) {
+    auto blas = lite::x86::math::GetBlas<TARGET(kX86), T>(context);
+    for (int64_t b = seq_begin; b < seq_end; b++) {
       int len_l = offset_l[b + 1] - offset_l[b];
       int len_r = offset_r[b + 1] - offset_r[b];
-      auto* top_data = out_data + top_offset[b] + t * len_l * len_r;
-      const auto* l_t_data =
-          bottom_l_trans_data + offset_l[b] * dim_t * dim_in + t * dim_in;
-      const auto* r_data = bottom_r_data + offset_r[b] * dim_in;
+      for (int t = 0; t < dim_t; t++) {
+        auto* top_data = out_data + top_offset[b] + t * len_l * len_r;
+        const auto* l_t_data =
+            bottom_l_trans_data + offset_l[b] * dim_t * dim_in + t * dim_in;
+        const auto* r_data = bottom_r_data + offset_r[b] * dim_in;
 
-      auto blas = lite::x86::math::GetBlas<TARGET(kX86), T>(context);
-      blas.GEMM(CblasNoTrans,
-                CblasTrans,
-                len_l,
-                len_r,
-                dim_in,
-                1.0f,
-                l_t_data,
-                dim_t * dim_in,
-                r_data,
-                dim_in,
-                0.0f,
-                top_data,
-                len_r);
+        blas.GEMM(CblasNoTrans,
+                  CblasTrans,
+                  len_l,
+                  len_r,
+                  dim_in,
+                  1.0f,
+                  l_t_data,
+                  dim_t * dim_in,
+                  r_data,
+                  dim_in,
+                  0.0f,
+                  top_data,
+                  len_r);
+      }
     }
-  }
+  });
 
   int batch_size = x->lod()[0].size() - 1;
   int lod_lv1_size = batch_size * dim_t;
@@ -14,6 +14,9 @@
 #pragma once
 
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/fill_bias_activate.h"
+#include "lite/backends/x86/math/fp16_gemm.h"
+#include "lite/backends/x86/parallel.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/types.h"
@@ -58,6 +61,29 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     auto *out = param.Out;
     out->template mutable_data<T>();
 
+    if (y->precision() == PRECISION(kFP16)) {
+      // 2-D weight stored as fp16 by x86_fp16_weight_pass
+      CHECK(!param.transpose_X);
+      CHECK_EQ(y->dims().size(), 2);
+      int K = param.transpose_Y ? y->dims()[1] : y->dims()[0];
+      int N = param.transpose_Y ? y->dims()[0] : y->dims()[1];
+      int M = x->numel() / K;
+      lite::x86::math::gemm_fp16_b(context,
+                                   param.transpose_Y,
+                                   M,
+                                   N,
+                                   K,
+                                   param.alpha,
+                                   x->template data<T>(),
+                                   K,
+                                   y->template data<uint16_t>(),
+                                   y->dims()[1],
+                                   out->template mutable_data<T>(),
+                                   N);
+      RunResidualEpilogue();
+      return;
+    }
+
     auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
     auto mat_dim_a = lite::x86::math::CreateMatrixDescriptor(
         RowMatrixFromVector(x->dims()), 0, param.transpose_X);
@@ -65,9 +91,40 @@ class MatMulCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
         ColumnMatrixFromVector(y->dims()), 0, param.transpose_Y);
     auto scale = static_cast<T>(param.alpha);
     blas.MatMul(*x, mat_dim_a, *y, mat_dim_b, scale, out, T(0));
+    RunResidualEpilogue();
   }
 
   virtual ~MatMulCompute() = default;
+
+ private:
+  // Adds the fused SecondInput and applies its activation in one sweep.
+  void RunResidualEpilogue() {
+    auto &param = *param_.get_mutable<operators::MatMulParam>();
+    if (!param.second_x) return;
+    auto *out = param.Out;
+    const auto &out_dims = out->dims();
+    // a row of the epilogue is the last dim, or one element of a vector
+    const int col_axis =
+        out_dims.size() > 1 ? out_dims.size() - 1 : out_dims.size();
+    const int N = out_dims.size() > 1 ? out_dims[col_axis] : 1;
+    const int M = out_dims.production() / N;
+    T *out_data = out->template mutable_data<T>();
+    residual_.Reset(*param.second_x, out_dims, col_axis);
+    lite::x86::RunParallelFor(0, M, [&](int64_t begin, int64_t end) {
+      lite::x86::math::fill_bias_residual_act(out_data + begin * N,
+                                              nullptr,
+                                              false,
+                                              &residual_,
+                                              begin,
+                                              end - begin,
+                                              N,
+                                              nullptr,
+                                              &param.elementwise_act_param);
+    });
+  }
+
+  // reads SecondInput, planned again only when its dims change
+  lite::x86::math::ResidualBroadcast residual_;
 };
 
 }  // namespace x86
@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <utility>
@@ -21,6 +23,7 @@
 
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/matmul_compute.h"
+#include "lite/utils/float16.h"
 
 namespace paddle {
 namespace lite {
@@ -80,6 +83,139 @@ TEST(matmul_x86, run_test) {
   }
 }
 
+static void RunMatMul(const lite::Tensor& x,
+                      const lite::Tensor& y,
+                      bool transpose_y,
+                      float alpha,
+                      lite::Tensor* out) {
+  MatMulCompute<float> matmul;
+  operators::MatMulParam param;
+  param.X = &x;
+  param.Y = &y;
+  param.Out = out;
+  param.transpose_Y = transpose_y;
+  param.alpha = alpha;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  matmul.SetContext(std::move(ctx));
+  matmul.SetParam(param);
+  matmul.Run();
+}
+
+// Y is stored in fp16 the way x86_fp16_weight_pass stores it, the result
+// must match the fp32 kernel within fp16 rounding of the weights.
+TEST(matmul_x86, run_fp16_weight_test) {
+  for (int m : {1, 3, 37}) {
+    for (int k : {16, 300}) {
+      for (int n : {5, 130}) {
+        for (bool transpose_y : {false, true}) {
+          lite::Tensor x, y, y_fp16, out, out_ref;
+          x.Resize({2, m, k});
+          if (transpose_y) {
+            y.Resize({n, k});
+          } else {
+            y.Resize({k, n});
+          }
+          auto* x_data = x.mutable_data<float>();
+          for (int64_t i = 0; i < x.numel(); i++) {
+            x_data[i] = static_cast<float>((i * 13) % 17) / 17.f - 0.5f;
+          }
+          auto* y_data = y.mutable_data<float>();
+          y_fp16.Resize(y.dims());
+          auto* y_fp16_data = y_fp16.mutable_data<uint16_t>();
+          for (int64_t i = 0; i < y.numel(); i++) {
+            y_data[i] = static_cast<float>((i * 7) % 23) / 23.f - 0.5f;
+            y_fp16_data[i] = lite::float16(y_data[i]).x;
+          }
+          y_fp16.set_precision(PRECISION(kFP16));
+          out.Resize({2, m, n});
+          out_ref.Resize({2, m, n});
+
+          RunMatMul(x, y, transpose_y, 0.5f, &out_ref);
+          RunMatMul(x, y_fp16, transpose_y, 0.5f, &out);
+
+          // every weight is off by at most 2^-11 relative, |x| <= 0.5
+          const float tol = 0.5f * 0.5f * 0.5f * k / 2048.f + 1e-5f;
+          const float* out_data = out.data<float>();
+          const float* ref_data = out_ref.data<float>();
+          for (int64_t i = 0; i < out.numel(); i++) {
+            ASSERT_NEAR(out_data[i], ref_data[i], tol)
+                << "m " << m << " k " << k << " n " << n << " transpose_y "
+                << transpose_y << " at " << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+// Out = leaky_relu(X * Y + SecondInput), with a residual of the output
+// shape and ones broadcast along the rows, the columns and the batch.
+TEST(matmul_x86, run_residual_test) {
+  const int m = 5;
+  const int k = 7;
+  const int n = 19;
+  lite::Tensor x, y, out_ref;
+  x.Resize({2, m, k});
+  y.Resize({k, n});
+  out_ref.Resize({2, m, n});
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>((i * 13) % 17) / 17.f - 0.5f;
+  }
+  auto* y_data = y.mutable_data<float>();
+  for (int64_t i = 0; i < y.numel(); i++) {
+    y_data[i] = static_cast<float>((i * 7) % 23) / 23.f - 0.5f;
+  }
+  RunMatMul(x, y, false, 1.f, &out_ref);
+  const float* prod_data = out_ref.data<float>();
+
+  const std::vector<std::vector<int64_t>> residual_shapes{
+      {2, m, n}, {n}, {m, 1}, {2, 1, 1}};
+  for (const auto& residual_shape : residual_shapes) {
+    lite::Tensor residual, out;
+    residual.Resize(residual_shape);
+    auto* res_data = residual.mutable_data<float>();
+    for (int64_t i = 0; i < residual.numel(); i++) {
+      res_data[i] = static_cast<float>((i * 5) % 11) / 11.f - 0.5f;
+    }
+    out.Resize({2, m, n});
+
+    MatMulCompute<float> matmul;
+    operators::MatMulParam param;
+    param.X = &x;
+    param.Y = &y;
+    param.Out = &out;
+    param.second_x = &residual;
+    param.fuse_elementwise_op_type = "fusion_elementwise_add_activation";
+    param.elementwise_act_param.has_active = true;
+    param.elementwise_act_param.active_type =
+        lite_api::ActivationType::kLeakyRelu;
+    param.elementwise_act_param.Leaky_relu_alpha = 0.1f;
+    std::unique_ptr<KernelContext> ctx(new KernelContext);
+    ctx->As<X86Context>();
+    matmul.SetContext(std::move(ctx));
+    matmul.SetParam(param);
+    matmul.Run();
+
+    // the residual aligned to the trailing dims of the output
+    const int64_t out_dims[3] = {2, m, n};
+    const int offset = 3 - static_cast<int>(residual_shape.size());
+    const float* out_data = out.data<float>();
+    for (int64_t i = 0; i < out.numel(); i++) {
+      int64_t index[3] = {i / (m * n), i / n % m, i % n};
+      int64_t res_offset = 0;
+      for (int d = offset; d < 3; d++) {
+        int64_t dim = residual_shape[d - offset];
+        res_offset = res_offset * dim + (dim == out_dims[d] ? index[d] : 0);
+      }
+      float v = prod_data[i] + res_data[res_offset];
+      ASSERT_NEAR(out_data[i], v > 0.f ? v : 0.1f * v, 1e-5)
+          << "residual " << residual.dims() << " at " << i;
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -14,8 +14,11 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -79,6 +82,218 @@ TEST(pool2d_x86, run_test) {
   }
 }
 
+// Scalar pool2d over NCHW, the reference for the SIMD and threaded paths.
+void Pool2dRef(const lite::Tensor& x,
+               const std::vector<int>& ksize,
+               const std::vector<int>& strides,
+               const std::vector<int>& paddings,
+               const std::string& pooling_type,
+               bool exclusive,
+               bool adaptive,
+               lite::Tensor* out) {
+  const int planes = x.dims()[0] * x.dims()[1];
+  const int in_h = x.dims()[2];
+  const int in_w = x.dims()[3];
+  const int out_h = out->dims()[2];
+  const int out_w = out->dims()[3];
+  const bool is_max = pooling_type == "max";
+  const float* x_data = x.data<float>();
+  float* out_data = out->mutable_data<float>();
+  for (int nc = 0; nc < planes; ++nc) {
+    const float* in = x_data + nc * in_h * in_w;
+    for (int ph = 0; ph < out_h; ++ph) {
+      for (int pw = 0; pw < out_w; ++pw) {
+        int hstart, hend, wstart, wend;
+        if (adaptive) {
+          hstart = ph * in_h / out_h;
+          hend = ((ph + 1) * in_h + out_h - 1) / out_h;
+          wstart = pw * in_w / out_w;
+          wend = ((pw + 1) * in_w + out_w - 1) / out_w;
+        } else {
+          hstart = ph * strides[0] - paddings[0];
+          wstart = pw * strides[1] - paddings[2];
+          hend = std::min(hstart + ksize[0], in_h);
+          wend = std::min(wstart + ksize[1], in_w);
+          hstart = std::max(hstart, 0);
+          wstart = std::max(wstart, 0);
+        }
+        float acc = is_max ? -HUGE_VALF : 0.f;
+        for (int h = hstart; h < hend; ++h) {
+          for (int w = wstart; w < wend; ++w) {
+            float v = in[h * in_w + w];
+            acc = is_max ? std::max(acc, v) : acc + v;
+          }
+        }
+        if (!is_max) {
+          const int pool_size = (exclusive || adaptive)
+                                    ? (hend - hstart) * (wend - wstart)
+                                    : ksize[0] * ksize[1];
+          acc /= pool_size;
+        }
+        out_data[(nc * out_h + ph) * out_w + pw] = acc;
+      }
+    }
+  }
+}
+
+void RunPoolTest(const std::vector<int64_t>& x_shape,
+                 const std::vector<int>& ksize,
+                 const std::vector<int>& strides,
+                 const std::vector<int>& paddings,
+                 const std::string& pooling_type,
+                 bool exclusive,
+                 bool adaptive,
+                 bool global_pooling) {
+  lite::Tensor x, out, out_ref;
+  x.Resize(x_shape);
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); i++) {
+    x_data[i] = static_cast<float>((i * 37) % 101) / 101.f - 0.5f;
+  }
+  std::vector<int> kernel = ksize;
+  if (global_pooling) {
+    kernel = {static_cast<int>(x_shape[2]), static_cast<int>(x_shape[3])};
+  }
+  std::vector<int64_t> out_shape = x_shape;
+  for (int i = 0; i < 2; ++i) {
+    out_shape[i + 2] =
+        adaptive ? kernel[i]
+                 : (x_shape[i + 2] + paddings[2 * i] + paddings[2 * i + 1] -
+                    kernel[i]) / strides[i] + 1;
+  }
+  out.Resize(out_shape);
+  out_ref.Resize(out_shape);
+
+  PoolCompute<float> pool2d;
+  operators::PoolParam param;
+  param.x = &x;
+  param.output = &out;
+  param.ksize = ksize;
+  param.strides = strides;
+  param.paddings = std::make_shared<std::vector<int>>(paddings);
+  param.pooling_type = pooling_type;
+  param.exclusive = exclusive;
+  param.adaptive = adaptive;
+  param.global_pooling = global_pooling;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  pool2d.SetContext(std::move(ctx));
+  pool2d.SetParam(param);
+  pool2d.Run();
+
+  // The kernel ignores exclusive for max pooling.
+  Pool2dRef(x,
+            kernel,
+            strides,
+            paddings,
+            pooling_type,
+            exclusive,
+            adaptive,
+            &out_ref);
+  const float* out_data = out.data<float>();
+  const float* ref_data = out_ref.data<float>();
+  for (int64_t i = 0; i < out.numel(); i++) {
+    ASSERT_NEAR(out_data[i], ref_data[i], 1e-5)
+        << pooling_type << " x " << x_shape[2] << "x" << x_shape[3] << " k "
+        << kernel[0] << " s " << strides[0] << " p " << paddings[0]
+        << " exclusive " << exclusive << " adaptive " << adaptive
+        << " global " << global_pooling << " at " << i;
+  }
+}
+
+TEST(pool2d_x86, run_windows) {
+  // Odd and even widths, wide enough for the vector loop of the 2x2 and
+  // 3x3 stride 2 path, with and without padding.
+  for (auto hw : std::vector<std::vector<int64_t>>{{7, 7}, {12, 37}}) {
+    for (int k : {2, 3, 5}) {
+      for (int stride : {1, 2}) {
+        for (int pad : {0, 1}) {
+          for (std::string type : {"max", "avg"}) {
+            for (bool exclusive : {true, false}) {
+              RunPoolTest({2, 3, hw[0], hw[1]},
+                          {k, k},
+                          {stride, stride},
+                          {pad, pad, pad, pad},
+                          type,
+                          exclusive,
+                          false,
+                          false);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(pool2d_x86, run_narrow_input) {
+  // Inputs narrower than the window: no output column of the 2x2 and 3x3
+  // stride 2 path has its window fully inside the row.
+  for (auto hw : std::vector<std::vector<int64_t>>{{5, 1}, {5, 2}, {6, 2}}) {
+    for (int k : {2, 3}) {
+      if (hw[1] >= k) continue;
+      for (std::string type : {"max", "avg"}) {
+        RunPoolTest({2, 3, hw[0], hw[1]},
+                    {k, k},
+                    {2, 2},
+                    {0, 0, 0, 0},
+                    type,
+                    true,
+                    false,
+                    false);
+      }
+    }
+  }
+}
+
+TEST(pool2d_x86, run_global_and_adaptive) {
+  for (std::string type : {"max", "avg"}) {
+    // Global pooling over planes smaller and larger than a vector.
+    for (int64_t hw : {1, 3, 9}) {
+      RunPoolTest({2, 5, hw, hw},
+                  {1, 1},
+                  {1, 1},
+                  {0, 0, 0, 0},
+                  type,
+                  true,
+                  false,
+                  true);
+    }
+  }
+  for (auto out_hw : std::vector<std::vector<int>>{{1, 1}, {3, 4}, {5, 5}}) {
+    RunPoolTest({1, 4, 11, 13},
+                out_hw,
+                {1, 1},
+                {0, 0, 0, 0},
+                "avg",
+                true,
+                true,
+                false);
+  }
+}
+
+TEST(pool2d_x86, run_threaded) {
+  // Large enough to split the planes among the OpenMP threads.
+  for (std::string type : {"max", "avg"}) {
+    RunPoolTest({2, 16, 32, 33},
+                {3, 3},
+                {2, 2},
+                {1, 1, 1, 1},
+                type,
+                false,
+                false,
+                false);
+    RunPoolTest({2, 16, 32, 33},
+                {1, 1},
+                {1, 1},
+                {0, 0, 0, 0},
+                type,
+                true,
+                false,
+                true);
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -27,35 +27,35 @@ namespace x86 {
 struct SumFunctor {
   template <typename X, typename Y, typename Dim>
   void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->sum(dim);
+    y->device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) = x->sum(dim);
   }
 };
 
 struct ProdFunctor {
   template <typename X, typename Y, typename Dim>
   void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->prod(dim);
+    y->device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) = x->prod(dim);
   }
 };
 
 struct MeanFunctor {
   template <typename X, typename Y, typename Dim>
   void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->mean(dim);
+    y->device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) = x->mean(dim);
   }
 };
 
 struct MaxFunctor {
   template <typename X, typename Y, typename Dim>
   void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->maximum(dim);
+    y->device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) = x->maximum(dim);
   }
 };
 
 struct MinFunctor {
   template <typename X, typename Y, typename Dim>
   void operator()(X* x, Y* y, const Dim& dim) {
-    y->device(lite::fluid::EigenDeviceType<TARGET(kX86)>()) = x->minimum(dim);
+    y->device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) = x->minimum(dim);
   }
 };
 
@@ -29,6 +29,11 @@ template <typename T>
 void scale_compute(
     const T* x, T* out, int size, T scale, T bias, bool bias_before) {
   if (bias_before) bias *= scale;
+#ifdef PADDLE_WITH_MKLML
+  // Small inputs are not worth waking the threads up for.
+  const bool parallel = size >= (1 << 15);
+#pragma omp parallel for if (parallel)
+#endif
   for (int i = 0; i < size; i++) {
     out[i] = x[i] * scale + bias;
   }
@@ -14,10 +14,13 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+#include "lite/backends/x86/math/ragged_batch.h"
 #include "lite/core/op_registry.h"
 #include "lite/kernels/x86/sequence_pool_compute.h"
 
@@ -81,6 +84,126 @@ TEST(sequence_pool_x86, run_test) {
   }
 }
 
+TEST(sequence_pool_x86, ragged_batch) {
+  // Built from a temporary: the offsets must be owned by the batch.
+  lite::x86::math::RaggedBatch batch(std::vector<uint64_t>{0, 4, 4, 9, 10});
+  EXPECT_EQ(batch.num_seqs(), 4);
+  EXPECT_EQ(batch.total_len(), 10u);
+  EXPECT_EQ(batch.max_len(), 5u);
+  EXPECT_EQ(batch.seq_len(1), 0u);
+  EXPECT_EQ(batch.seq_begin(2), 4u);
+  EXPECT_EQ(batch.seq_end(2), 9u);
+  EXPECT_FALSE(batch.uniform());
+  lite::x86::math::RaggedBatch dense(std::vector<uint64_t>{0, 3, 6, 9});
+  EXPECT_TRUE(dense.uniform());
+
+  // Every sequence is visited exactly once, with and without threading.
+  std::vector<uint64_t> offsets{0};
+  for (int i = 0; i < 1000; ++i) {
+    offsets.push_back(offsets.back() + (i * 37) % 11);
+  }
+  for (int64_t row_cost : {1, 1 << 20}) {
+    lite::x86::math::RaggedBatch big(offsets);
+    std::vector<int> visits(big.num_seqs(), 0);
+    big.ParallelFor(row_cost, [&](int64_t seq_begin, int64_t seq_end) {
+      ASSERT_LT(seq_begin, seq_end);
+      for (int64_t i = seq_begin; i < seq_end; ++i) {
+        visits[i]++;
+      }
+    });
+    for (int v : visits) {
+      EXPECT_EQ(v, 1);
+    }
+  }
+}
+
+static void SequencePoolRef(const std::string& pool_type,
+                            const std::vector<uint64_t>& lod,
+                            const float* x,
+                            int64_t width,
+                            float* out) {
+  for (size_t i = 0; i + 1 < lod.size(); ++i) {
+    int64_t h = static_cast<int64_t>(lod[i + 1] - lod[i]);
+    for (int64_t j = 0; j < width; ++j) {
+      if (h == 0) {
+        out[i * width + j] = 0.f;
+        continue;
+      }
+      double sum = 0.;
+      for (int64_t r = 0; r < h; ++r) {
+        sum += x[(lod[i] + r) * width + j];
+      }
+      if (pool_type == "SUM") {
+        out[i * width + j] = sum;
+      } else if (pool_type == "AVERAGE") {
+        out[i * width + j] = sum / h;
+      } else if (pool_type == "SQRT") {
+        out[i * width + j] = sum / std::sqrt(static_cast<double>(h));
+      } else if (pool_type == "FIRST") {
+        out[i * width + j] = x[lod[i] * width + j];
+      } else {
+        out[i * width + j] = x[(lod[i + 1] - 1) * width + j];
+      }
+    }
+  }
+}
+
+TEST(sequence_pool_x86, run_pool_types) {
+  std::vector<std::vector<uint64_t>> lods{
+      {0, 10},
+      {0, 3, 3, 10, 11, 30},
+      {0, 4, 8, 12, 16, 20, 24},
+  };
+  // Enough sequences and width to take the threaded path.
+  std::vector<uint64_t> long_lod{0};
+  for (int i = 0; i < 512; ++i) {
+    long_lod.push_back(long_lod.back() + 1 + (i * 13) % 29);
+  }
+  lods.push_back(long_lod);
+  std::vector<uint64_t> long_uniform_lod{0};
+  for (int i = 0; i < 512; ++i) {
+    long_uniform_lod.push_back(long_uniform_lod.back() + 16);
+  }
+  lods.push_back(long_uniform_lod);
+
+  for (const auto& seq_lod : lods) {
+    for (int64_t width : {1, 8, 67}) {
+      for (std::string pool_type :
+           {"SUM", "AVERAGE", "SQRT", "FIRST", "LAST"}) {
+        lite::Tensor x, out;
+        x.set_lod({seq_lod});
+        x.Resize({static_cast<int64_t>(seq_lod.back()), width});
+        auto* x_data = x.mutable_data<float>();
+        for (int64_t i = 0; i < x.numel(); i++) {
+          x_data[i] = static_cast<float>((i * 7) % 19) * 0.1f - 0.9f;
+        }
+
+        SequencePoolCompute<float> sequence_pool;
+        operators::SequencePoolParam param;
+        param.X = &x;
+        param.Out = &out;
+        param.pool_type = pool_type;
+        std::unique_ptr<KernelContext> ctx(new KernelContext);
+        ctx->As<X86Context>();
+        sequence_pool.SetContext(std::move(ctx));
+        sequence_pool.SetParam(param);
+        sequence_pool.Run();
+
+        int64_t num_seqs = static_cast<int64_t>(seq_lod.size()) - 1;
+        ASSERT_EQ(out.dims()[0], num_seqs);
+        std::vector<float> ref(num_seqs * width);
+        SequencePoolRef(pool_type, seq_lod, x_data, width, ref.data());
+        const float* out_data = out.data<float>();
+        for (size_t i = 0; i < ref.size(); i++) {
+          EXPECT_NEAR(out_data[i], ref[i], 1e-4)
+              << pool_type << " width " << width << " seqs " << num_seqs
+              << " at " << i;
+        }
+      }
+    }
+  }
+}
+
 }  // namespace x86
 }  // namespace kernels
 }  // namespace lite
@@ -211,7 +211,8 @@ void slice_compute(const lite::Tensor* in,
   auto out_t =
       lite::fluid::EigenTensor<T, D, Eigen::RowMajor, Eigen::DenseIndex>::From(
           *out, new_out_dims);
-  out_t = in_t.slice(offsets, extents);
+  out_t.device(lite::fluid::GetEigenDevice<TARGET(kX86)>()) =
+      in_t.slice(offsets, extents);
 
   out->Resize(out_dims);
 }
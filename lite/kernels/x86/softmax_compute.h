@@ -67,13 +67,10 @@ class SoftmaxCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
       lite::x86::math::SoftmaxFunctor<lite::TargetType::kX86, T, true>()(
           context, axis_dim, x, output);
     } else {
-      const int n = SizeToAxis(axis, x->dims());
-      const int d = SizeFromAxis(axis, x->dims());
-
       DDim x_dims = x->dims();
       DDim out_dims = output->dims();
 
-      DDim shape_2d(std::vector<DDim::value_type>{n, d});
+      DDim shape_2d = x_dims.Flatten2D(axis);
       x->Resize(shape_2d);
       output->Resize(shape_2d);
 
@@ -0,0 +1,117 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/kernels/x86/sparse_conv_compute.h"
+#include "lite/backends/x86/math/sparse_conv.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// sparse_conv_detect_pass stores the fp32 weights row by row, each row padded
+// with zeros to a multiple of 4 entries, together with the byte distance to
+// the input channel of the next entry scaled by the spatial size.
+void SparseConvCompute::PrepareForRun() {
+  auto& param = this->Param<param_t>();
+  const int oc = param.oc_nonzeros->numel();
+  const auto* nonzeros = param.nonzero_weights->data<float>();
+  const auto* oc_nonzeros = param.oc_nonzeros->data<uint32_t>();
+  const auto* diffs = param.diffs->data<int32_t>();
+  const auto& x_dims = param.x->dims();
+  const int im_size = param.diffs_im_size > 0
+                          ? param.diffs_im_size
+                          : static_cast<int>(x_dims[2] * x_dims[3]);
+  const int scale = im_size * static_cast<int>(sizeof(float));
+
+  values_.clear();
+  channels_.clear();
+  row_ptr_.assign(1, 0);
+  int channel = param.first_ic;
+  int index = 0;
+  for (int r = 0; r < oc; ++r) {
+    const int count = static_cast<int>(oc_nonzeros[r]);
+    const int stored = (count + 3) / 4 * 4;
+    for (int i = 0; i < stored; ++i, ++index) {
+      if (i < count) {
+        values_.push_back(nonzeros[index]);
+        channels_.push_back(channel);
+      }
+      CHECK_EQ(diffs[index] % scale, 0)
+          << "The diffs of sparse_conv2d do not match the spatial size "
+          << im_size;
+      channel += diffs[index] / scale;
+    }
+    row_ptr_.push_back(static_cast<int32_t>(values_.size()));
+  }
+  CHECK_EQ(index, param.nonzero_weights->numel());
+  im_size_ = -1;
+}
+
+void SparseConvCompute::ReInitWhenNeeded() {
+  auto& param = this->Param<param_t>();
+  const auto& o_dims = param.output->dims();
+  const int im_size = static_cast<int>(o_dims[2] * o_dims[3]);
+  if (im_size == im_size_) return;
+  im_size_ = im_size;
+  offsets_.resize(channels_.size());
+  for (size_t i = 0; i < channels_.size(); ++i) {
+    offsets_[i] = channels_[i] * im_size;
+  }
+}
+
+void SparseConvCompute::Run() {
+  auto& param = this->Param<param_t>();
+  const auto& x_dims = param.x->dims();
+  const auto& o_dims = param.output->dims();
+  const int batch = x_dims[0];
+  const int ic = x_dims[1];
+  const int oc = o_dims[1];
+  const float* din = param.x->data<float>();
+  const float* bias = param.bias ? param.bias->data<float>() : nullptr;
+  float* dout = param.output->mutable_data<float>();
+  for (int b = 0; b < batch; ++b) {
+    lite::x86::math::sparse_conv_fp32(values_.data(),
+                                      offsets_.data(),
+                                      row_ptr_.data(),
+                                      bias,
+                                      din + b * ic * im_size_,
+                                      dout + b * oc * im_size_,
+                                      oc,
+                                      im_size_,
+                                      param.activation_param);
+  }
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_KERNEL(sparse_conv2d,
+                     kX86,
+                     kFloat,
+                     kNCHW,
+                     paddle::lite::kernels::x86::SparseConvCompute,
+                     def)
+    .BindInput("Input", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("NonZeroWeights", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindInput("OcNonZeros",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Diffs",
+               {LiteType::GetTensorTy(TARGET(kX86), PRECISION(kInt32))})
+    .BindInput("Bias", {LiteType::GetTensorTy(TARGET(kX86))})
+    .BindOutput("Output", {LiteType::GetTensorTy(TARGET(kX86))})
+    .Finalize();
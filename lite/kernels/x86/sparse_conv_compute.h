@@ -0,0 +1,49 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <vector>
+#include "lite/core/kernel.h"
+#include "lite/operators/op_params.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+class SparseConvCompute
+    : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
+ public:
+  using param_t = operators::SparseConvParam;
+
+  void PrepareForRun() override;
+  void ReInitWhenNeeded() override;
+  void Run() override;
+
+  virtual ~SparseConvCompute() = default;
+
+ private:
+  // The weights re-encoded as compressed sparse rows.
+  std::vector<float> values_;
+  std::vector<int32_t> channels_;
+  std::vector<int32_t> row_ptr_;
+  // channels_ scaled by the spatial size of the last run.
+  std::vector<int32_t> offsets_;
+  int im_size_{-1};
+};
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
@@ -0,0 +1,217 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lite/backends/x86/math/sparse_conv.h"
+#include "lite/core/op_registry.h"
+#include "lite/kernels/x86/sparse_conv_compute.h"
+
+namespace paddle {
+namespace lite {
+namespace kernels {
+namespace x86 {
+
+// Dense [oc, ic] weights where roughly `sparsity` of the entries are zero.
+static std::vector<float> SparseRefWeights(int oc, int ic, float sparsity) {
+  std::vector<float> weights(oc * ic);
+  for (int i = 0; i < oc * ic; ++i) {
+    const bool zero = static_cast<float>((i * 37) % 100) < sparsity * 100.f;
+    weights[i] = zero ? 0.f : static_cast<float>(i % 11) * 0.125f - 0.6f;
+  }
+  return weights;
+}
+
+// Encode the weights the same way sparse_conv_detect_pass does for fp32.
+static int SparseRefEncode(const std::vector<float>& weights,
+                           int oc,
+                           int ic,
+                           int im_size,
+                           Tensor* nonzeros,
+                           Tensor* oc_nonzeros,
+                           Tensor* diffs) {
+  std::vector<float> values;
+  std::vector<int> channels;
+  std::vector<uint32_t> counts(oc, 0);
+  for (int r = 0; r < oc; ++r) {
+    for (int c = 0; c < ic; ++c) {
+      if (weights[r * ic + c] != 0.f) {
+        values.push_back(weights[r * ic + c]);
+        channels.push_back(c);
+        counts[r]++;
+      }
+    }
+  }
+  const int first_ic = channels.empty() ? 0 : channels.front();
+  std::vector<float> padded_values;
+  std::vector<int32_t> padded_diffs;
+  int index = 0;
+  for (int r = 0; r < oc; ++r) {
+    for (uint32_t i = 0; i < counts[r]; ++i, ++index) {
+      const int next = index + 1 < static_cast<int>(channels.size())
+                           ? channels[index + 1]
+                           : first_ic;
+      padded_values.push_back(values[index]);
+      padded_diffs.push_back((next - channels[index]) *
+                             static_cast<int>(sizeof(float)) * im_size);
+    }
+    while (padded_values.size() % 4 != 0) {
+      padded_values.push_back(0.f);
+      padded_diffs.push_back(0);
+    }
+  }
+  nonzeros->Resize({static_cast<int64_t>(padded_values.size())});
+  std::copy(padded_values.begin(),
+            padded_values.end(),
+            nonzeros->mutable_data<float>());
+  diffs->Resize({static_cast<int64_t>(padded_diffs.size())});
+  std::copy(
+      padded_diffs.begin(), padded_diffs.end(), diffs->mutable_data<int32_t>());
+  oc_nonzeros->Resize({oc});
+  std::copy(
+      counts.begin(), counts.end(), oc_nonzeros->mutable_data<uint32_t>());
+  return first_ic;
+}
+
+static void TestSparseConv(int batch,
+                           int ic,
+                           int oc,
+                           int h,
+                           int w,
+                           float sparsity,
+                           bool with_relu) {
+  const int im_size = h * w;
+  Tensor x, bias, out, nonzeros, oc_nonzeros, diffs;
+  x.Resize({batch, ic, h, w});
+  auto* x_data = x.mutable_data<float>();
+  for (int64_t i = 0; i < x.numel(); ++i) {
+    x_data[i] = static_cast<float>(i % 17) * 0.1f - 0.8f;
+  }
+  bias.Resize({oc});
+  auto* bias_data = bias.mutable_data<float>();
+  for (int i = 0; i < oc; ++i) {
+    bias_data[i] = static_cast<float>(i % 5) * 0.2f - 0.4f;
+  }
+  out.Resize({batch, oc, h, w});
+  auto weights = SparseRefWeights(oc, ic, sparsity);
+
+  operators::SparseConvParam param;
+  param.x = &x;
+  param.bias = &bias;
+  param.output = &out;
+  param.nonzero_weights = &nonzeros;
+  param.oc_nonzeros = &oc_nonzeros;
+  param.diffs = &diffs;
+  param.first_ic = SparseRefEncode(
+      weights, oc, ic, im_size, &nonzeros, &oc_nonzeros, &diffs);
+  param.diffs_im_size = im_size;
+  param.activation_param.has_active = with_relu;
+  param.activation_param.active_type = lite_api::ActivationType::kRelu;
+
+  SparseConvCompute sparse_conv;
+  std::unique_ptr<KernelContext> ctx(new KernelContext);
+  ctx->As<X86Context>();
+  sparse_conv.SetContext(std::move(ctx));
+  sparse_conv.SetParam(param);
+  sparse_conv.Launch();
+
+  auto* out_data = out.data<float>();
+  for (int b = 0; b < batch; ++b) {
+    for (int r = 0; r < oc; ++r) {
+      for (int p = 0; p < im_size; ++p) {
+        float ref = bias_data[r];
+        for (int c = 0; c < ic; ++c) {
+          ref += weights[r * ic + c] * x_data[(b * ic + c) * im_size + p];
+        }
+        if (with_relu) ref = std::max(ref, 0.f);
+        EXPECT_NEAR(out_data[(b * oc + r) * im_size + p], ref, 1e-4f);
+      }
+    }
+  }
+}
+
+static void TestSparseFc(int m, int k, int n, float sparsity) {
+  // The fc weights are [k, n], each output column is one sparse row.
+  auto weights_t = SparseRefWeights(n, k, sparsity);
+  std::vector<float> values;
+  std::vector<int32_t> columns;
+  std::vector<int32_t> row_ptr(1, 0);
+  for (int j = 0; j < n; ++j) {
+    for (int c = 0; c < k; ++c) {
+      if (weights_t[j * k + c] != 0.f) {
+        values.push_back(weights_t[j * k + c]);
+        columns.push_back(c);
+      }
+    }
+    row_ptr.push_back(static_cast<int32_t>(values.size()));
+  }
+  std::vector<float> x(m * k), bias(n), y(m * n);
+  for (int i = 0; i < m * k; ++i) {
+    x[i] = static_cast<float>(i % 13) * 0.15f - 0.9f;
+  }
+  for (int j = 0; j < n; ++j) {
+    bias[j] = static_cast<float>(j % 3) * 0.3f;
+  }
+  operators::ActivationParam act_param;
+  lite::x86::math::sparse_fc_fp32(values.data(),
+                                  columns.data(),
+                                  row_ptr.data(),
+                                  bias.data(),
+                                  x.data(),
+                                  y.data(),
+                                  m,
+                                  n,
+                                  k,
+                                  act_param);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      float ref = bias[j];
+      for (int c = 0; c < k; ++c) {
+        ref += x[i * k + c] * weights_t[j * k + c];
+      }
+      EXPECT_NEAR(y[i * n + j], ref, 1e-4f);
+    }
+  }
+}
+
+TEST(sparse_conv_x86, retrive_op) {
+  auto sparse_conv = KernelRegistry::Global().Create("sparse_conv2d");
+  ASSERT_FALSE(sparse_conv.empty());
+  ASSERT_TRUE(sparse_conv.front());
+}
+
+TEST(sparse_conv_x86, compute) {
+  TestSparseConv(1, 32, 24, 8, 8, 0.8f, false);
+  TestSparseConv(2, 19, 13, 7, 9, 0.6f, true);
+  TestSparseConv(1, 8, 5, 1, 3, 0.9f, true);
+}
+
+TEST(sparse_fc_x86, compute) {
+  TestSparseFc(1, 64, 48, 0.85f);
+  TestSparseFc(3, 37, 29, 0.7f);
+  TestSparseFc(70, 33, 21, 0.8f);
+}
+
+}  // namespace x86
+}  // namespace kernels
+}  // namespace lite
+}  // namespace paddle
+
+USE_LITE_KERNEL(sparse_conv2d, kX86, kFloat, kNCHW, def);
@@ -15,6 +15,7 @@
 
 #include <vector>
 #include "lite/backends/x86/math/blas.h"
+#include "lite/backends/x86/math/ragged_batch.h"
 #include "lite/core/kernel.h"
 #include "lite/core/op_registry.h"
 #include "lite/core/tensor.h"
@@ -86,43 +87,49 @@ class VarConv2DCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     int kernel_win_size = kernel_h * kernel_w;
     int half_kernel_h = kernel_h / 2;
     int half_kernel_w = kernel_w / 2;
-    for (int b = 0; b < batch; ++b) {
-      int t_offset = top_offset[b];
-      int b_offset = bottom_offset[b];
-      int width = offset_x[b + 1] - offset_x[b];
-      int height = offset_y[b + 1] - offset_y[b];
-      if (width == 0 || height == 0) {
-        continue;
-      }
-      int top_im_x = (width - 1) / stride_w + 1;
-      int top_im_y = (height - 1) / stride_h + 1;
-      int top_x = top_im_y * top_im_x;
-      for (int z = 0; z < input_channel; ++z) {
-        int row_offset = kernel_win_size * z;
-        int im_offset = z * width * height;
-        for (int y = 0; y < height; y += stride_h) {
-          for (int x = 0; x < width; x += stride_w) {
-            int col_offset = x / stride_w + y / stride_h * top_im_x;
-            for (int ky = 0; ky < kernel_h; ++ky) {
-              for (int kx = 0; kx < kernel_w; ++kx) {
-                int im_y = y + ky - half_kernel_h;
-                int im_x = x + kx - half_kernel_w;
-                if (im_x >= 0 && im_x < width && im_y >= 0 && im_y < height) {
-                  top_data[t_offset +
-                           (row_offset + ky * kernel_w + kx) * top_x +
-                           col_offset] =
-                      bottom_data[b_offset + im_offset + im_y * width + im_x];
-                } else {
-                  top_data[t_offset +
-                           (row_offset + ky * kernel_w + kx) * top_x +
-                           col_offset] = 0;
+    // Sequences are balanced across threads by the size of their columns.
+    lite::x86::math::RaggedBatch col_batch(top_offset);
+    col_batch.ParallelFor(1, [&](int64_t seq_begin, int64_t seq_end) {
+      for (int64_t b = seq_begin; b < seq_end; ++b) {
+        int t_offset = top_offset[b];
+        int b_offset = bottom_offset[b];
+        int width = offset_x[b + 1] - offset_x[b];
+        int height = offset_y[b + 1] - offset_y[b];
+        if (width == 0 || height == 0) {
+          continue;
+        }
+        int top_im_x = (width - 1) / stride_w + 1;
+        int top_im_y = (height - 1) / stride_h + 1;
+        int top_x = top_im_y * top_im_x;
+        for (int z = 0; z < input_channel; ++z) {
+          int row_offset = kernel_win_size * z;
+          int im_offset = z * width * height;
+          for (int y = 0; y < height; y += stride_h) {
+            for (int x = 0; x < width; x += stride_w) {
+              int col_offset = x / stride_w + y / stride_h * top_im_x;
+              for (int ky = 0; ky < kernel_h; ++ky) {
+                for (int kx = 0; kx < kernel_w; ++kx) {
+                  int im_y = y + ky - half_kernel_h;
+                  int im_x = x + kx - half_kernel_w;
+                  if (im_x >= 0 && im_x < width && im_y >= 0 &&
+                      im_y < height) {
+                    top_data[t_offset +
+                             (row_offset + ky * kernel_w + kx) * top_x +
+                             col_offset] =
+                        bottom_data[b_offset + im_offset + im_y * width +
+                                    im_x];
+                  } else {
+                    top_data[t_offset +
+                             (row_offset + ky * kernel_w + kx) * top_x +
+                             col_offset] = 0;
+                  }
                 }
               }
             }
           }
         }
       }
-    }
+    });
   }
 
   void Run() override {
@@ -182,27 +189,35 @@ class VarConv2DCompute : public KernelLite<TARGET(kX86), PRECISION(kFloat)> {
     const auto* w_data = w->template data<T>();
     const auto* col_data = col->template data<T>();
 
-    auto blas = lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
-    for (int b = 0; b < batch; ++b) {
-      int top_im_size = (top_offset[b + 1] - top_offset[b]) / output_channel;
-      if (top_im_size == 0) {
-        continue;
-      }
+    // Each sequence is one GEMM over its own columns, balanced across threads
+    // by output size.
+    lite::x86::math::RaggedBatch top_batch(top_offset);
+    int col_rows = input_channel * kernel_h * kernel_w;
+    top_batch.ParallelFor(col_rows, [&](int64_t seq_begin, int64_t seq_end) {
+      auto blas =
+          lite::x86::math::GetBlas<lite::TargetType::kX86, T>(context);
+      for (int64_t b = seq_begin; b < seq_end; ++b) {
+        int top_im_size =
+            (top_offset[b + 1] - top_offset[b]) / output_channel;
+        if (top_im_size == 0) {
+          continue;
+        }
 
-      blas.GEMM(false,
-                false,
-                output_channel,
-                top_im_size,
-                input_channel * kernel_h * kernel_w,
-                1.0,
-                w_data,
-                input_channel * kernel_h * kernel_w,
-                col_data + col_offset[b],
-                top_im_size,
-                0.0,
-                top_data + top_offset[b],
-                top_im_size);
-    }
+        blas.GEMM(false,
+                  false,
+                  output_channel,
+                  top_im_size,
+                  col_rows,
+                  1.0,
+                  w_data,
+                  col_rows,
+                  col_data + col_offset[b],
+                  top_im_size,
+                  0.0,
+                  top_data + top_offset[b],
+                  top_im_size);
+      }
+    });
   }
 
   virtual ~VarConv2DCompute() = default;
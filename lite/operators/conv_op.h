@@ -169,6 +169,7 @@ class ConvOpLite : public OpLite {
       auto X = op_desc.Input("SecondInput").front();
       param_.second_x =
           const_cast<lite::Tensor*>(&(scope->FindVar(X)->Get<lite::Tensor>()));
+      ParseElementwiseActivation(op_desc, &param_.elementwise_act_param);
     }
 
     if (op_desc.HasAttr("padding_algorithm")) {
@@ -107,6 +107,17 @@ bool FcOpLite::AttachImpl(const cpp::OpDesc& op_desc, lite::Scope* scope) {
   } else {
     param_.padding_weights = false;
   }
+  if (op_desc.HasAttr("use_sparse_weight")) {
+    param_.use_sparse_weight = op_desc.GetAttr<bool>("use_sparse_weight");
+  }
+
+  if (op_desc.HasAttr("fuse_elementwise_op_type")) {
+    param_.fuse_elementwise_op_type =
+        op_desc.GetAttr<std::string>("fuse_elementwise_op_type");
+    auto X = op_desc.Input("SecondInput").front();
+    param_.second_x = scope->FindVar(X)->GetMutable<lite::Tensor>();
+    ParseElementwiseActivation(op_desc, &param_.elementwise_act_param);
+  }
 
   if (param_.activation_type == "prelu") {
     param_.Prelu_mode = op_desc.GetAttr<std::string>("prelu_mode");
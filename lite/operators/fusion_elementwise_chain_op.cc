@@ -0,0 +1,113 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/fusion_elementwise_chain_op.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+static std::vector<int64_t> PadDims(const std::vector<int64_t>& dims,
+                                    size_t offset,
+                                    size_t rank) {
+  std::vector<int64_t> padded(rank, 1);
+  std::copy(dims.begin(), dims.end(), padded.begin() + offset);
+  return padded;
+}
+
+std::vector<int64_t> ElementwiseChainAlignDims(
+    const FusionElementwiseChainParam& param,
+    std::vector<std::vector<int64_t>>* aligned_dims) {
+  aligned_dims->assign(1, param.X->dims().Vectorize());
+  std::vector<int64_t> out = aligned_dims->front();
+  size_t y_idx = 0;
+  for (size_t i = 0; i < param.op_types.size(); ++i) {
+    if (!IsElementwiseChainBinaryOp(param.op_types[i])) continue;
+    const auto y = param.Y[y_idx++]->dims().Vectorize();
+    const bool reversed = param.reversed[i] != 0;
+    // The same rule as ElementwiseOp::InferShapeImpl, the operand of lower
+    // rank is placed at axis.
+    const size_t x_rank = reversed ? y.size() : out.size();
+    const size_t y_rank = reversed ? out.size() : y.size();
+    const size_t rank = (std::max)(x_rank, y_rank);
+    int axis = param.axes[i];
+    if (axis == -1) {
+      axis = std::abs(static_cast<int>(x_rank) - static_cast<int>(y_rank));
+    }
+    const size_t x_offset = x_rank > y_rank ? 0 : axis;
+    const size_t y_offset = x_rank > y_rank ? axis : 0;
+    const size_t out_offset = reversed ? y_offset : x_offset;
+    const size_t operand_offset = reversed ? x_offset : y_offset;
+    CHECK_LE(out_offset + out.size(), rank) << "invalid axis " << axis;
+    CHECK_LE(operand_offset + y.size(), rank) << "invalid axis " << axis;
+
+    for (auto& dims : *aligned_dims) {
+      dims = PadDims(dims, out_offset, rank);
+    }
+    aligned_dims->push_back(PadDims(y, operand_offset, rank));
+    out = PadDims(out, out_offset, rank);
+    const auto& operand = aligned_dims->back();
+    for (size_t d = 0; d < rank; ++d) {
+      CHECK(out[d] == operand[d] || out[d] == 1 || operand[d] == 1)
+          << "dims mismatch in " << param.op_types[i] << " at " << d;
+      out[d] = (std::max)(out[d], operand[d]);
+    }
+  }
+  return out;
+}
+
+bool FusionElementwiseChainOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.X);
+  CHECK_OR_FALSE(param_.Out);
+  CHECK_OR_FALSE(!param_.op_types.empty());
+  CHECK_EQ_OR_FALSE(param_.axes.size(), param_.op_types.size());
+  CHECK_EQ_OR_FALSE(param_.reversed.size(), param_.op_types.size());
+  size_t binary_num = std::count_if(param_.op_types.begin(),
+                                    param_.op_types.end(),
+                                    IsElementwiseChainBinaryOp);
+  CHECK_EQ_OR_FALSE(param_.Y.size(), binary_num);
+  return true;
+}
+
+bool FusionElementwiseChainOp::InferShapeImpl() const {
+  std::vector<std::vector<int64_t>> aligned_dims;
+  param_.Out->Resize(ElementwiseChainAlignDims(param_, &aligned_dims));
+  param_.Out->set_lod(param_.X->lod());
+  return true;
+}
+
+bool FusionElementwiseChainOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                          lite::Scope* scope) {
+  param_.X = GetVar<lite::Tensor>(scope, opdesc.Input("X").front());
+  param_.Y.clear();
+  for (auto& name : opdesc.Input("Y")) {
+    param_.Y.push_back(GetVar<lite::Tensor>(scope, name));
+  }
+  param_.Out = GetMutableVar<lite::Tensor>(scope, opdesc.Output("Out").front());
+  param_.op_types = opdesc.GetAttr<std::vector<std::string>>("op_types");
+  param_.axes = opdesc.GetAttr<std::vector<int>>("axes");
+  param_.reversed = opdesc.GetAttr<std::vector<int>>("reversed");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_elementwise_chain,
+                 paddle::lite::operators::FusionElementwiseChainOp);
@@ -0,0 +1,68 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+#include <string>
+#include <vector>
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+/*
+ * A chain of elementwise ops(elementwise_add/sub/mul/div/max/min and
+ * relu/sigmoid/tanh) fused by lite_elementwise_chain_fuse_pass, so that the
+ * whole chain reads each input once. X is the input of the first op, Y holds
+ * the other operand of every binary op in order. For the i-th op,
+ * `op_types[i]` is its type, `axes[i]` its broadcast axis and `reversed[i]`
+ * is 1 when the chained value is the Y input of the original op.
+ */
+class FusionElementwiseChainOp : public OpLite {
+ public:
+  FusionElementwiseChainOp() {}
+
+  explicit FusionElementwiseChainOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override {
+    return "fusion_elementwise_chain";
+  }
+
+ private:
+  mutable FusionElementwiseChainParam param_;
+};
+
+inline bool IsElementwiseChainBinaryOp(const std::string& op_type) {
+  return op_type.compare(0, 12, "elementwise_") == 0;
+}
+
+// Aligns the dims of all operands(X first, then Y) to the rank of the output
+// following the broadcast rule of every op in the chain, the broadcast axes
+// are set to 1. Returns the output dims.
+std::vector<int64_t> ElementwiseChainAlignDims(
+    const FusionElementwiseChainParam& param,
+    std::vector<std::vector<int64_t>>* aligned_dims);
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
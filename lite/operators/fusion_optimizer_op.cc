@@ -0,0 +1,129 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "lite/operators/fusion_optimizer_op.h"
+#include <string>
+#include <vector>
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool FusionOptimizerOp::CheckShape() const {
+  const size_t num = param_.Param.size();
+  CHECK_OR_FALSE(num > 0);
+  CHECK_OR_FALSE(param_.LearningRate);
+  CHECK_EQ_OR_FALSE(param_.LearningRate->dims().production(), 1);
+  CHECK_EQ_OR_FALSE(param_.Grad.size(), num);
+  CHECK_EQ_OR_FALSE(param_.ParamOut.size(), num);
+  CHECK_OR_FALSE(param_.accumulate_steps >= 1);
+  for (size_t i = 0; i < num; ++i) {
+    CHECK_EQ_OR_FALSE(param_.Param[i]->dims(), param_.Grad[i]->dims());
+  }
+  if (param_.optimizer_type == "momentum") {
+    CHECK_EQ_OR_FALSE(param_.Velocity.size(), num);
+    CHECK_EQ_OR_FALSE(param_.VelocityOut.size(), num);
+  } else if (param_.optimizer_type == "adam") {
+    CHECK_EQ_OR_FALSE(param_.Moment1.size(), num);
+    CHECK_EQ_OR_FALSE(param_.Moment2.size(), num);
+    CHECK_EQ_OR_FALSE(param_.Moment1Out.size(), num);
+    CHECK_EQ_OR_FALSE(param_.Moment2Out.size(), num);
+    CHECK_OR_FALSE(param_.Beta1Pow);
+    CHECK_OR_FALSE(param_.Beta2Pow);
+    CHECK_OR_FALSE(param_.Beta1PowOut);
+    CHECK_OR_FALSE(param_.Beta2PowOut);
+  } else {
+    CHECK_EQ_OR_FALSE(param_.optimizer_type, std::string("sgd"));
+  }
+  return true;
+}
+
+bool FusionOptimizerOp::InferShapeImpl() const {
+  for (size_t i = 0; i < param_.Param.size(); ++i) {
+    auto dims = param_.Param[i]->dims();
+    param_.ParamOut[i]->Resize(dims);
+    if (param_.optimizer_type == "momentum") {
+      param_.VelocityOut[i]->Resize(dims);
+    } else if (param_.optimizer_type == "adam") {
+      param_.Moment1Out[i]->Resize(dims);
+      param_.Moment2Out[i]->Resize(dims);
+    }
+  }
+  if (param_.optimizer_type == "adam") {
+    param_.Beta1PowOut->Resize(param_.Beta1Pow->dims());
+    param_.Beta2PowOut->Resize(param_.Beta2Pow->dims());
+  }
+  return true;
+}
+
+bool FusionOptimizerOp::AttachImpl(const cpp::OpDesc& opdesc,
+                                   lite::Scope* scope) {
+  auto inputs = [&](const std::string& arg) {
+    std::vector<const lite::Tensor*> vars;
+    if (!opdesc.HasInput(arg)) return vars;
+    for (auto& name : opdesc.Input(arg)) {
+      vars.push_back(GetVar<lite::Tensor>(scope, name));
+    }
+    return vars;
+  };
+  // ParamOut and the state outputs usually have the same names as the inputs
+  // and share the same memory.
+  auto outputs = [&](const std::string& arg) {
+    std::vector<lite::Tensor*> vars;
+    if (!opdesc.HasOutput(arg)) return vars;
+    for (auto& name : opdesc.Output(arg)) {
+      vars.push_back(GetMutableVar<lite::Tensor>(scope, name));
+    }
+    return vars;
+  };
+  param_.Param = inputs("Param");
+  param_.Grad = inputs("Grad");
+  param_.ParamOut = outputs("ParamOut");
+  param_.LearningRate =
+      GetVar<lite::Tensor>(scope, opdesc.Input("LearningRate").front());
+  param_.optimizer_type = opdesc.GetAttr<std::string>("optimizer_type");
+  if (opdesc.HasAttr("accumulate_steps")) {
+    param_.accumulate_steps = opdesc.GetAttr<int>("accumulate_steps");
+  }
+
+  if (param_.optimizer_type == "momentum") {
+    param_.Velocity = inputs("Velocity");
+    param_.VelocityOut = outputs("VelocityOut");
+    param_.mu = opdesc.GetAttr<float>("mu");
+    if (opdesc.HasAttr("use_nesterov")) {
+      param_.use_nesterov = opdesc.GetAttr<bool>("use_nesterov");
+    }
+  } else if (param_.optimizer_type == "adam") {
+    param_.Moment1 = inputs("Moment1");
+    param_.Moment2 = inputs("Moment2");
+    param_.Moment1Out = outputs("Moment1Out");
+    param_.Moment2Out = outputs("Moment2Out");
+    param_.Beta1Pow = inputs("Beta1Pow").front();
+    param_.Beta2Pow = inputs("Beta2Pow").front();
+    param_.Beta1PowOut = outputs("Beta1PowOut").front();
+    param_.Beta2PowOut = outputs("Beta2PowOut").front();
+    param_.beta1 = opdesc.GetAttr<float>("beta1");
+    param_.beta2 = opdesc.GetAttr<float>("beta2");
+    param_.epsilon = opdesc.GetAttr<float>("epsilon");
+  }
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(fusion_optimizer, paddle::lite::operators::FusionOptimizerOp);
@@ -0,0 +1,61 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#pragma once
+#include <string>
+#include <vector>
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+/*
+ * One optimizer step for a list of parameters, created by
+ * lite_optimizer_fuse_pass from the per-parameter optimizer ops, so that a
+ * single kernel launch updates every parameter. optimizer_type selects the
+ * rule:
+ *   sgd:      Param -= lr * Grad
+ *   momentum: Velocity = mu * Velocity + Grad, Param -= lr * Velocity
+ *             (or lr * (Grad + mu * Velocity) with use_nesterov)
+ *   adam:     the same update as the adam op, Beta1Pow/Beta2Pow are shared
+ *             by all parameters since they are updated on the same step
+ * With accumulate_steps > 1 the gradients are summed by the kernel and the
+ * parameters are updated once every accumulate_steps runs.
+ */
+class FusionOptimizerOp : public OpLite {
+ public:
+  FusionOptimizerOp() {}
+
+  explicit FusionOptimizerOp(const std::string& type) : OpLite(type) {}
+
+  bool CheckShape() const override;
+
+  bool InferShapeImpl() const override;
+
+  bool AttachImpl(const cpp::OpDesc& opdesc, lite::Scope* scope) override;
+
+  void AttachKernel(KernelBase* kernel) override { kernel->SetParam(param_); }
+
+  std::string DebugString() const override { return "fusion_optimizer"; }
+
+ private:
+  mutable FusionOptimizerParam param_;
+};
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
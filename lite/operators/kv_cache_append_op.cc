@@ -0,0 +1,69 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/kv_cache_append_op.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool KVCacheAppendOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.cache);
+  CHECK_OR_FALSE(param_.x);
+  CHECK_OR_FALSE(param_.cache_out);
+  CHECK_OR_FALSE(param_.out);
+  CHECK_EQ_OR_FALSE(param_.cache, param_.cache_out);
+  const auto& cache_dims = param_.cache->dims();
+  const auto& x_dims = param_.x->dims();
+  CHECK_EQ_OR_FALSE(cache_dims.size(), x_dims.size());
+  int rank = static_cast<int>(x_dims.size());
+  int axis = param_.axis < 0 ? param_.axis + rank : param_.axis;
+  CHECK_OR_FALSE(axis >= 0 && axis < rank);
+  for (int i = 0; i < rank; ++i) {
+    if (i != axis) {
+      CHECK_EQ_OR_FALSE(cache_dims[i], x_dims[i]);
+    }
+  }
+  return true;
+}
+
+bool KVCacheAppendOp::InferShapeImpl() const {
+  auto out_dims = param_.cache->dims();
+  const auto& x_dims = param_.x->dims();
+  int rank = static_cast<int>(x_dims.size());
+  int axis = param_.axis < 0 ? param_.axis + rank : param_.axis;
+  out_dims[axis] += x_dims[axis];
+  // The cache is resized by the kernel when it is grown.
+  param_.out->Resize(out_dims);
+  return true;
+}
+
+bool KVCacheAppendOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                 lite::Scope* scope) {
+  param_.cache = scope->FindMutableTensor(op_desc.Input("Cache").front());
+  param_.x = scope->FindTensor(op_desc.Input("X").front());
+  param_.cache_out =
+      scope->FindMutableTensor(op_desc.Output("CacheOut").front());
+  param_.out = scope->FindMutableTensor(op_desc.Output("Out").front());
+  param_.axis = op_desc.GetAttr<int>("axis");
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(kv_cache_append, paddle::lite::operators::KVCacheAppendOp);
@@ -0,0 +1,54 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lite/operators/kv_cache_reorder_op.h"
+#include "lite/core/op_lite.h"
+#include "lite/core/op_registry.h"
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+bool KVCacheReorderOp::CheckShape() const {
+  CHECK_OR_FALSE(param_.cache);
+  CHECK_OR_FALSE(param_.index);
+  CHECK_OR_FALSE(param_.cache_out);
+  CHECK_OR_FALSE(param_.out);
+  CHECK_EQ_OR_FALSE(param_.cache, param_.cache_out);
+  CHECK_GE_OR_FALSE(param_.cache->dims().size(), 1UL);
+  return true;
+}
+
+bool KVCacheReorderOp::InferShapeImpl() const {
+  auto out_dims = param_.cache->dims();
+  out_dims[0] = param_.index->numel();
+  param_.out->Resize(out_dims);
+  return true;
+}
+
+bool KVCacheReorderOp::AttachImpl(const cpp::OpDesc& op_desc,
+                                  lite::Scope* scope) {
+  param_.cache = scope->FindMutableTensor(op_desc.Input("Cache").front());
+  param_.index = scope->FindTensor(op_desc.Input("Index").front());
+  param_.cache_out =
+      scope->FindMutableTensor(op_desc.Output("CacheOut").front());
+  param_.out = scope->FindMutableTensor(op_desc.Output("Out").front());
+  return true;
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
+
+REGISTER_LITE_OP(kv_cache_reorder, paddle::lite::operators::KVCacheReorderOp);
@@ -60,6 +60,12 @@ bool LookupTableOpLite::AttachImpl(const cpp::OpDesc& op_desc,
   param_.Out = scope->FindMutableTensor(out);
 
   param_.padding_idx = op_desc.GetAttr<int64_t>("padding_idx");
+  if (op_desc.HasAttr("quantization_type") &&
+      op_desc.GetAttr<std::string>("quantization_type") ==
+          "post_weight_row_wise_abs_max") {
+    param_.w_scale =
+        op_desc.GetAttr<std::vector<float>>(input + "_quant_scale");
+  }
   if (op_desc.HasAttr("is_test")) {
     param_.is_test = op_desc.GetAttr<bool>("is_test");
   }
@@ -148,6 +148,13 @@ bool MatMulOpLite::AttachImpl(const cpp::OpDesc &op_desc, lite::Scope *scope) {
   param_.transpose_X = op_desc.GetAttr<bool>("transpose_X");
   param_.transpose_Y = op_desc.GetAttr<bool>("transpose_Y");
   param_.alpha = op_desc.GetAttr<float>("alpha");
+  if (op_desc.HasAttr("fuse_elementwise_op_type")) {
+    param_.fuse_elementwise_op_type =
+        op_desc.GetAttr<std::string>("fuse_elementwise_op_type");
+    auto second_x = op_desc.Input("SecondInput").front();
+    param_.second_x = GetMutableVar<lite::Tensor>(scope, second_x);
+    ParseElementwiseActivation(op_desc, &param_.elementwise_act_param);
+  }
 
   const OpInfo *op_info = dynamic_cast<const OpInfo *>(&op_desc);
   if (op_info != nullptr && op_info->HasAttr("enable_int8")) {
@@ -13,3 +13,61 @@
 // limitations under the License.
 
 #include "lite/operators/op_params.h"
+#include <string>
+
+namespace paddle {
+namespace lite {
+namespace operators {
+
+void ParseElementwiseActivation(const cpp::OpDesc& op_desc,
+                                ActivationParam* act_param) {
+  if (!op_desc.HasAttr("fuse_elementwise_op_type") ||
+      op_desc.GetAttr<std::string>("fuse_elementwise_op_type") !=
+          "fusion_elementwise_add_activation") {
+    return;
+  }
+  auto float_attr = [&](const std::string& name, float default_value) {
+    return op_desc.HasAttr(name) ? op_desc.GetAttr<float>(name)
+                                 : default_value;
+  };
+  std::string act_type =
+      op_desc.HasAttr("elementwise_act_type")
+          ? op_desc.GetAttr<std::string>("elementwise_act_type")
+          : "relu";
+  act_param->has_active = true;
+  if (act_type == "relu") {
+    act_param->active_type = lite_api::ActivationType::kRelu;
+  } else if (act_type == "relu6") {
+    act_param->active_type = lite_api::ActivationType::kRelu6;
+    act_param->Relu_clipped_coef =
+        float_attr("elementwise_act_threshold", 6.f);
+  } else if (act_type == "leaky_relu") {
+    act_param->active_type = lite_api::ActivationType::kLeakyRelu;
+    act_param->Leaky_relu_alpha = float_attr("elementwise_act_alpha", 0.02f);
+  } else if (act_type == "hard_swish") {
+    act_param->active_type = lite_api::ActivationType::kHardSwish;
+    act_param->hard_swish_threshold =
+        float_attr("elementwise_act_threshold", 6.f);
+    act_param->hard_swish_scale = float_attr("elementwise_act_scale", 6.f);
+    act_param->hard_swish_offset = float_attr("elementwise_act_offset", 3.f);
+  } else if (act_type == "sigmoid") {
+    act_param->active_type = lite_api::ActivationType::kSigmoid;
+  } else if (act_type == "tanh") {
+    act_param->active_type = lite_api::ActivationType::kTanh;
+  } else if (act_type == "swish") {
+    act_param->active_type = lite_api::ActivationType::kSwish;
+    act_param->Swish_beta = float_attr("elementwise_act_beta", 1.f);
+  } else if (act_type == "gelu") {
+    act_param->active_type = lite_api::ActivationType::kGelu;
+    act_param->gelu_approximate =
+        op_desc.HasAttr("elementwise_act_approximate") &&
+        op_desc.GetAttr<bool>("elementwise_act_approximate");
+  } else {
+    LOG(FATAL) << "Unsupported activation after the fused elementwise op: "
+               << act_type;
+  }
+}
+
+}  // namespace operators
+}  // namespace lite
+}  // namespace paddle
@@ -115,6 +115,58 @@ struct SubgraphParam : ParamBase {
   Scope* exec_scope{nullptr};
 };
 
+// Also embedded by the ops that fuse an activation into their output.
+struct ActivationParam : ParamBase {
+  const lite::Tensor* X{};
+  lite::Tensor* Out{};
+  lite_api::ActivationType active_type{lite_api::ActivationType::kIndentity};
+  bool has_active{false};
+  float Leaky_relu_alpha{0.f};   // leaky_relu param
+  float Relu_clipped_coef{6.f};  // relu_clipped param
+  std::string Prelu_mode{
+      "channel"};  // prelu param, can be "all", "channel" or "element"
+  lite::Tensor* Prelu_alpha{};  // prelu param
+  float Swish_beta;             // swish param
+  // hard_sigmoid param
+  float hard_sigmoid_slope{0.2f};
+  float hard_sigmoid_offset{0.5f};
+  // hard_swish param
+  float hard_swish_threshold{6.0f};
+  float hard_swish_scale{6.0f};
+  float hard_swish_offset{3.0f};
+  // thresholded_relu
+  float relu_threshold{1.0f};
+  // elu
+  float Elu_alpha{1.0f};
+  // relu6
+  float threshold{6.0f};
+  // gelu
+  bool gelu_approximate{false};
+
+  ///////////////////////////////////////////////////////////////////////////////////
+  // get a vector of input tensors
+  const std::vector<const Tensor*>* input_tensor_ptrs() override {
+    if (!input_tensor_ptrs_cache_) {
+      input_tensor_ptrs_cache_.reset(new std::vector<const Tensor*>({X}));
+    }
+    return input_tensor_ptrs_cache_.get();
+  }
+  // get a vector of output tensors
+  std::vector<Tensor*>* output_tensor_ptrs() override {
+    if (!output_tensor_ptrs_cache_) {
+      output_tensor_ptrs_cache_.reset(new std::vector<lite::Tensor*>({Out}));
+    }
+    return output_tensor_ptrs_cache_.get();
+  }
+};
+
+// Reads the activation that follows a fused elementwise op. Fusion passes
+// mark it with fuse_elementwise_op_type "fusion_elementwise_add_activation"
+// and describe it with the "elementwise_act_*" attributes; relu is assumed
+// when no type is given, as the OpenCL conv kernels do.
+void ParseElementwiseActivation(const cpp::OpDesc& op_desc,
+                                ActivationParam* act_param);
+
 /// -------------------------- NN operators ------------------------------------
 
 struct FcParam : ParamBase {
@@ -129,8 +181,14 @@ struct FcParam : ParamBase {
   int in_num_col_dims{1};
   std::string activation_type{""};
   bool padding_weights{false};
+  // set by sparse_conv_detect_pass when most of the weights are zeros
+  bool use_sparse_weight{false};
   std::string Prelu_mode{
       "channel"};  // prelu param, can be "all", "channel" or "element"
+  // for residual fuse: Out = act(act(X * W + bias) + SecondInput)
+  lite::Tensor* second_x{nullptr};
+  std::string fuse_elementwise_op_type{""};
+  ActivationParam elementwise_act_param;
   // for int8
   WITH_INT8_CONFIG
   ///////////////////////////////////////////////////////////////////////////////////
@@ -379,6 +437,8 @@ struct ConcatParam : ParamBase {
   lite::Tensor* output{};
   int axis{0};
   lite::Tensor* axis_tensor{};
+  // set by concat_split_view_pass: the inputs may become views of the output
+  bool use_buffer_view{false};
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
     if (!input_tensor_ptrs_cache_) {
@@ -400,50 +460,6 @@ struct ConcatParam : ParamBase {
 };
 
 /// ----------------------- activation operators ----------------------
-struct ActivationParam : ParamBase {
-  const lite::Tensor* X{};
-  lite::Tensor* Out{};
-  lite_api::ActivationType active_type{lite_api::ActivationType::kIndentity};
-  bool has_active{false};
-  float Leaky_relu_alpha{0.f};   // leaky_relu param
-  float Relu_clipped_coef{6.f};  // relu_clipped param
-  std::string Prelu_mode{
-      "channel"};  // prelu param, can be "all", "channel" or "element"
-  lite::Tensor* Prelu_alpha{};  // prelu param
-  float Swish_beta;             // swish param
-  // hard_sigmoid param
-  float hard_sigmoid_slope{0.2f};
-  float hard_sigmoid_offset{0.5f};
-  // hard_swish param
-  float hard_swish_threshold{6.0f};
-  float hard_swish_scale{6.0f};
-  float hard_swish_offset{3.0f};
-  // thresholded_relu
-  float relu_threshold{1.0f};
-  // elu
-  float Elu_alpha{1.0f};
-  // relu6
-  float threshold{6.0f};
-  // gelu
-  bool gelu_approximate{false};
-
-  ///////////////////////////////////////////////////////////////////////////////////
-  // get a vector of input tensors
-  const std::vector<const Tensor*>* input_tensor_ptrs() override {
-    if (!input_tensor_ptrs_cache_) {
-      input_tensor_ptrs_cache_.reset(new std::vector<const Tensor*>({X}));
-    }
-    return input_tensor_ptrs_cache_.get();
-  }
-  // get a vector of output tensors
-  std::vector<Tensor*>* output_tensor_ptrs() override {
-    if (!output_tensor_ptrs_cache_) {
-      output_tensor_ptrs_cache_.reset(new std::vector<lite::Tensor*>({Out}));
-    }
-    return output_tensor_ptrs_cache_.get();
-  }
-};
-
 struct ActivationGradParam : ParamBase {
   const lite::Tensor* X{};
   const lite::Tensor* Out{};
@@ -467,6 +483,8 @@ struct SparseConvParam : ParamBase {
   const lite::Tensor* bias{nullptr};
   lite::Tensor* output{};
   int first_ic{0};
+  // the spatial size the diffs are scaled with, 0 if unknown
+  int diffs_im_size{0};
   std::vector<int> strides{1, 1};
   std::shared_ptr<std::vector<int>> paddings;
   int groups{1};
@@ -519,6 +537,7 @@ struct ConvParam : ParamBase {
   ActivationParam activation_param;
   // for elementwise tree fuse
   std::string fuse_elementwise_op_type{""};
+  ActivationParam elementwise_act_param;
   // support var_length or not
   bool var_length{false};
   // only used in conv_transpose.
@@ -665,6 +684,8 @@ struct SplitParam : ParamBase {
   int axis{-1};
   int num{0};
   std::vector<int> sections;
+  // set by concat_split_view_pass: the outputs may become views of the input
+  bool use_buffer_view{false};
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
   const std::vector<const Tensor*>* input_tensor_ptrs() override {
@@ -790,6 +811,17 @@ struct FusionElementwiseActivationGradParam : public ElementwiseGradParam {
   std::string act_type;
 };
 
+// A chain of elementwise ops fused into one pass over the output, see
+// FusionElementwiseChainOp.
+struct FusionElementwiseChainParam : ParamBase {
+  const lite::Tensor* X{};
+  std::vector<const lite::Tensor*> Y{};
+  lite::Tensor* Out{};
+  std::vector<std::string> op_types{};
+  std::vector<int> axes{};
+  std::vector<int> reversed{};
+};
+
 /// ----------------------- mean operators ----------------------
 struct MeanParam : ParamBase {
   const lite::Tensor* X{};
@@ -892,6 +924,39 @@ struct SGDParam : ParamBase {
   lite::Tensor* ParamOut{};
 };
 
+// The optimizer step of many parameters fused into one op, see
+// FusionOptimizerOp.
+struct FusionOptimizerParam : ParamBase {
+  std::vector<const lite::Tensor*> Param{};
+  std::vector<const lite::Tensor*> Grad{};
+  const lite::Tensor* LearningRate{};
+  // momentum
+  std::vector<const lite::Tensor*> Velocity{};
+  // adam
+  std::vector<const lite::Tensor*> Moment1{};
+  std::vector<const lite::Tensor*> Moment2{};
+  const lite::Tensor* Beta1Pow{};
+  const lite::Tensor* Beta2Pow{};
+
+  std::vector<lite::Tensor*> ParamOut{};
+  std::vector<lite::Tensor*> VelocityOut{};
+  std::vector<lite::Tensor*> Moment1Out{};
+  std::vector<lite::Tensor*> Moment2Out{};
+  lite::Tensor* Beta1PowOut{};
+  lite::Tensor* Beta2PowOut{};
+
+  // "sgd", "momentum" or "adam"
+  std::string optimizer_type{"sgd"};
+  float mu{0.9f};
+  bool use_nesterov{false};
+  float beta1{0.9f};
+  float beta2{0.999f};
+  float epsilon{1e-8f};
+  // The parameters are updated once every accumulate_steps runs with the mean
+  // of the gradients.
+  int accumulate_steps{1};
+};
+
 /// ----------------------- uniform_random operators ----------------------
 struct UniformRandomParam : ParamBase {
   const lite::Tensor* shape_tensor{nullptr};
@@ -1197,6 +1262,8 @@ struct LookupTableParam : ParamBase {
   bool is_test{true};
   std::string entry_config{""};  // used in distributed training
   std::string entry{"none"};
+  // per row scales of an int8/int16 table
+  std::vector<float> w_scale{};
 };
 
 struct LookupTableDequantParam : ParamBase {
@@ -1675,6 +1742,10 @@ struct MatMulParam : ParamBase {
   bool transpose_X{false};
   bool transpose_Y{false};
   float alpha{1.0f};
+  // for residual fuse: Out = act(alpha * X * Y + SecondInput)
+  lite::Tensor* second_x{nullptr};
+  std::string fuse_elementwise_op_type{""};
+  ActivationParam elementwise_act_param;
   WITH_INT8_CONFIG
   ///////////////////////////////////////////////////////////////////////////////////
   // get a vector of input tensors
@@ -1706,6 +1777,23 @@ struct GatherParam : ParamBase {
   lite::Tensor* Out{};
 };
 
+// Cache and CacheOut are the same variable, which is updated in place. Out is
+// an alias of the updated cache.
+struct KVCacheAppendParam : ParamBase {
+  lite::Tensor* cache{nullptr};
+  const lite::Tensor* x{nullptr};
+  lite::Tensor* cache_out{nullptr};
+  lite::Tensor* out{nullptr};
+  int axis{0};
+};
+
+struct KVCacheReorderParam : ParamBase {
+  lite::Tensor* cache{nullptr};
+  const lite::Tensor* index{nullptr};
+  lite::Tensor* cache_out{nullptr};
+  lite::Tensor* out{nullptr};
+};
+
 struct GatherTreeParam : ParamBase {
   const lite::Tensor* ids{nullptr};
   const lite::Tensor* parents{nullptr};
@@ -121,6 +121,9 @@ class SparseConvOp : public OpLite {
     if (op_desc.HasAttr("first_ic")) {
       param_.first_ic = op_desc.GetAttr<int>("first_ic");
     }
+    if (op_desc.HasAttr("diffs_im_size")) {
+      param_.diffs_im_size = op_desc.GetAttr<int>("diffs_im_size");
+    }
 
     // For Int8
     const OpInfo* op_info = dynamic_cast<const OpInfo*>(&op_desc);
@@ -0,0 +1,216 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lite/api/paddle_use_kernels.h"
+#include "lite/api/paddle_use_ops.h"
+#include "lite/core/test/arena/framework.h"
+#include "lite/tests/utils/fill_data.h"
+
+namespace paddle {
+namespace lite {
+
+class FusionOptimizerComputeTester : public arena::TestCase {
+ protected:
+  std::string lr_ = "learning_rate";
+  std::string beta1_pow_ = "beta1_pow";
+  std::string beta2_pow_ = "beta2_pow";
+  std::string beta1_pow_out_ = "beta1_pow_out";
+  std::string beta2_pow_out_ = "beta2_pow_out";
+  std::string optimizer_type_ = "sgd";
+  std::vector<DDim> dims_;
+  float learning_rate_ = 0.01f;
+  float mu_ = 0.9f;
+  bool use_nesterov_ = false;
+  float beta1_ = 0.9f;
+  float beta2_ = 0.999f;
+  float epsilon_ = 1e-8f;
+  int accumulate_steps_ = 1;
+
+  std::vector<std::string> Names(const std::string& prefix) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < dims_.size(); ++i) {
+      names.push_back(prefix + "_" + std::to_string(i));
+    }
+    return names;
+  }
+
+ public:
+  FusionOptimizerComputeTester(const Place& place,
+                               const std::string& alias,
+                               const std::vector<DDim>& dims,
+                               const std::string& optimizer_type,
+                               bool use_nesterov = false,
+                               int accumulate_steps = 1)
+      : TestCase(place, alias),
+        optimizer_type_(optimizer_type),
+        dims_(dims),
+        use_nesterov_(use_nesterov),
+        accumulate_steps_(accumulate_steps) {}
+
+  void RunBaseline(Scope* scope) override {
+    const float lr = *scope->FindTensor(lr_)->data<float>();
+    float beta1_pow = 1.f;
+    float beta2_pow = 1.f;
+    if (optimizer_type_ == "adam") {
+      beta1_pow = *scope->FindTensor(beta1_pow_)->data<float>();
+      beta2_pow = *scope->FindTensor(beta2_pow_)->data<float>();
+    }
+    // The first run only accumulates when accumulate_steps > 1.
+    const bool update = accumulate_steps_ == 1;
+    const float grad_scale = 1.f / accumulate_steps_;
+    for (size_t i = 0; i < dims_.size(); ++i) {
+      const int64_t size = dims_[i].production();
+      auto index = std::to_string(i);
+      auto* p = scope->FindTensor("param_" + index)->data<float>();
+      auto* g = scope->FindTensor("grad_" + index)->data<float>();
+      auto* p_out = scope->NewTensor("param_out_" + index);
+      p_out->Resize(dims_[i]);
+      auto* po = p_out->mutable_data<float>();
+      float *s0o = nullptr, *s1o = nullptr;
+      const float *s0 = nullptr, *s1 = nullptr;
+      if (optimizer_type_ == "momentum") {
+        s0 = scope->FindTensor("velocity_" + index)->data<float>();
+        auto* out = scope->NewTensor("velocity_out_" + index);
+        out->Resize(dims_[i]);
+        s0o = out->mutable_data<float>();
+      } else if (optimizer_type_ == "adam") {
+        s0 = scope->FindTensor("moment1_" + index)->data<float>();
+        s1 = scope->FindTensor("moment2_" + index)->data<float>();
+        auto* out0 = scope->NewTensor("moment1_out_" + index);
+        auto* out1 = scope->NewTensor("moment2_out_" + index);
+        out0->Resize(dims_[i]);
+        out1->Resize(dims_[i]);
+        s0o = out0->mutable_data<float>();
+        s1o = out1->mutable_data<float>();
+      }
+      for (int64_t k = 0; k < size; ++k) {
+        if (!update) {
+          po[k] = p[k];
+          if (s0) s0o[k] = s0[k];
+          if (s1) s1o[k] = s1[k];
+          continue;
+        }
+        float grad = g[k] * grad_scale;
+        if (optimizer_type_ == "sgd") {
+          po[k] = p[k] - lr * grad;
+        } else if (optimizer_type_ == "momentum") {
+          float v = mu_ * s0[k] + grad;
+          s0o[k] = v;
+          po[k] = use_nesterov_ ? p[k] - (grad + mu_ * v) * lr : p[k] - lr * v;
+        } else {
+          float m1 = beta1_ * s0[k] + (1.f - beta1_) * grad;
+          float m2 = beta2_ * s1[k] + (1.f - beta2_) * grad * grad;
+          s0o[k] = m1;
+          s1o[k] = m2;
+          float lr_t = lr * std::sqrt(1.f - beta2_pow) / (1.f - beta1_pow);
+          po[k] = p[k] - lr_t * m1 / (std::sqrt(m2) +
+                                      epsilon_ * std::sqrt(1.f - beta2_pow));
+        }
+      }
+    }
+    if (optimizer_type_ == "adam") {
+      auto* b1 = scope->NewTensor(beta1_pow_out_);
+      auto* b2 = scope->NewTensor(beta2_pow_out_);
+      b1->Resize(DDim({1}));
+      b2->Resize(DDim({1}));
+      *b1->mutable_data<float>() = update ? beta1_pow * beta1_ : beta1_pow;
+      *b2->mutable_data<float>() = update ? beta2_pow * beta2_ : beta2_pow;
+    }
+  }
+
+  void PrepareOpDesc(cpp::OpDesc* op_desc) {
+    op_desc->SetType("fusion_optimizer");
+    op_desc->SetInput("Param", Names("param"));
+    op_desc->SetInput("Grad", Names("grad"));
+    op_desc->SetInput("LearningRate", {lr_});
+    op_desc->SetOutput("ParamOut", Names("param_out"));
+    op_desc->SetAttr("optimizer_type", optimizer_type_);
+    op_desc->SetAttr("accumulate_steps", accumulate_steps_);
+    if (optimizer_type_ == "momentum") {
+      op_desc->SetInput("Velocity", Names("velocity"));
+      op_desc->SetOutput("VelocityOut", Names("velocity_out"));
+      op_desc->SetAttr("mu", mu_);
+      op_desc->SetAttr("use_nesterov", use_nesterov_);
+    } else if (optimizer_type_ == "adam") {
+      op_desc->SetInput("Moment1", Names("moment1"));
+      op_desc->SetInput("Moment2", Names("moment2"));
+      op_desc->SetInput("Beta1Pow", {beta1_pow_});
+      op_desc->SetInput("Beta2Pow", {beta2_pow_});
+      op_desc->SetOutput("Moment1Out", Names("moment1_out"));
+      op_desc->SetOutput("Moment2Out", Names("moment2_out"));
+      op_desc->SetOutput("Beta1PowOut", {beta1_pow_out_});
+      op_desc->SetOutput("Beta2PowOut", {beta2_pow_out_});
+      op_desc->SetAttr("beta1", beta1_);
+      op_desc->SetAttr("beta2", beta2_);
+      op_desc->SetAttr("epsilon", epsilon_);
+    }
+  }
+
+  void PrepareData() override {
+    for (size_t i = 0; i < dims_.size(); ++i) {
+      const int64_t size = dims_[i].production();
+      auto index = std::to_string(i);
+      std::vector<float> data(size);
+      fill_data_rand(data.data(), -1.f, 1.f, size);
+      SetCommonTensor("param_" + index, dims_[i], data.data());
+      fill_data_rand(data.data(), -1.f, 1.f, size);
+      SetCommonTensor("grad_" + index, dims_[i], data.data());
+      if (optimizer_type_ == "momentum") {
+        fill_data_rand(data.data(), -1.f, 1.f, size);
+        SetCommonTensor("velocity_" + index, dims_[i], data.data());
+      } else if (optimizer_type_ == "adam") {
+        fill_data_rand(data.data(), -1.f, 1.f, size);
+        SetCommonTensor("moment1_" + index, dims_[i], data.data());
+        fill_data_rand(data.data(), 0.f, 1.f, size);
+        SetCommonTensor("moment2_" + index, dims_[i], data.data());
+      }
+    }
+    std::vector<float> lr{learning_rate_};
+    SetCommonTensor(lr_, DDim{{1}}, lr.data());
+    if (optimizer_type_ == "adam") {
+      std::vector<float> beta1_pow{beta1_ * beta1_};
+      std::vector<float> beta2_pow{beta2_ * beta2_};
+      SetCommonTensor(beta1_pow_, DDim{{1}}, beta1_pow.data());
+      SetCommonTensor(beta2_pow_, DDim{{1}}, beta2_pow.data());
+    }
+  }
+};
+
+TEST(fusion_optimizer, precision) {
+#ifdef LITE_WITH_ARM
+  Place place(TARGET(kARM));
+  // The last parameter is split into several blocks by the kernel.
+  std::vector<DDim> dims{DDim({3, 2, 4, 1}), DDim({7}), DDim({64, 300})};
+  for (std::string type : {"sgd", "momentum", "adam"}) {
+    for (bool use_nesterov : {false, true}) {
+      if (use_nesterov && type != "momentum") continue;
+      for (int accumulate_steps : {1, 2}) {
+        std::unique_ptr<arena::TestCase> tester(
+            new FusionOptimizerComputeTester(
+                place, "def", dims, type, use_nesterov, accumulate_steps));
+        arena::Arena arena(std::move(tester), place, 2e-5);
+        arena.TestPrecision();
+      }
+    }
+  }
+#endif
+}
+
+}  // namespace lite
+}  // namespace paddle
@@ -269,6 +269,8 @@ class MatrixNmsComputeTester : public arena::TestCase {
   bool normalized_{false};
   bool use_gaussian_{true};
   float gaussian_sigma_{2.0f};
+  // random overlapping boxes instead of the diagonal ramp
+  bool random_data_{false};
 
  public:
   MatrixNmsComputeTester(const Place& place,
@@ -282,7 +284,8 @@ class MatrixNmsComputeTester : public arena::TestCase {
                          int keep_top_k = 2,
                          bool normalized = false,
                          bool use_gaussian = true,
-                         float gaussian_sigma = 2.0f)
+                         float gaussian_sigma = 2.0f,
+                         bool random_data = false)
       : TestCase(place, alias),
         bboxes_dims_(bboxes_dims),
         scores_dims_(scores_dims),
@@ -293,7 +296,8 @@ class MatrixNmsComputeTester : public arena::TestCase {
         keep_top_k_(keep_top_k),
         normalized_(normalized),
         use_gaussian_(use_gaussian),
-        gaussian_sigma_(gaussian_sigma) {}
+        gaussian_sigma_(gaussian_sigma),
+        random_data_(random_data) {}
 
   void RunBaseline(Scope* scope) override {
     auto* boxes = scope->FindTensor(bboxes_);
@@ -390,15 +394,31 @@ class MatrixNmsComputeTester : public arena::TestCase {
 
   void PrepareData() override {
     std::vector<float> bboxes(bboxes_dims_.production());
-    for (int i = 0; i < bboxes_dims_.production(); ++i) {
-      bboxes[i] = i * 1. / bboxes_dims_.production();
-    }
-    SetCommonTensor(bboxes_, bboxes_dims_, bboxes.data());
-
     std::vector<float> scores(scores_dims_.production());
-    for (int i = 0; i < scores_dims_.production(); ++i) {
-      scores[i] = i * 1. / scores_dims_.production();
+    if (random_data_) {
+      std::vector<float> rand(bboxes.size());
+      fill_data_rand(rand.data(), 0.f, 1.f, rand.size());
+      for (size_t i = 0; i < bboxes.size(); i += 4) {
+        // xmin, ymin in [0, 0.8), width and height in [0.05, 0.25)
+        bboxes[i] = rand[i] * 0.8f;
+        bboxes[i + 1] = rand[i + 1] * 0.8f;
+        bboxes[i + 2] = bboxes[i] + 0.05f + rand[i + 2] * 0.2f;
+        bboxes[i + 3] = bboxes[i + 1] + 0.05f + rand[i + 3] * 0.2f;
+      }
+      // distinct scores, both sides order ties with an unstable sort
+      for (size_t i = 0; i < scores.size(); ++i) {
+        scores[i] = static_cast<float>((i * 7919) % scores.size()) /
+                    static_cast<float>(scores.size());
+      }
+    } else {
+      for (int i = 0; i < bboxes_dims_.production(); ++i) {
+        bboxes[i] = i * 1. / bboxes_dims_.production();
+      }
+      for (int i = 0; i < scores_dims_.production(); ++i) {
+        scores[i] = i * 1. / scores_dims_.production();
+      }
     }
+    SetCommonTensor(bboxes_, bboxes_dims_, bboxes.data());
     SetCommonTensor(scores_, scores_dims_, scores.data());
   }
 };
@@ -416,6 +436,36 @@ void TestMatrixNms(Place place, float abs_error) {
   }
 }
 
+// Overlapping random boxes with several classes, a single image (classes run
+// in parallel) and a batch (images run in parallel).
+void TestMatrixNmsRandom(Place place, float abs_error) {
+  int M = 300;
+  for (int N : {1, 4}) {
+    for (int class_num : {3, 8}) {
+      for (bool use_gaussian : {true, false}) {
+        std::vector<int64_t> bbox_shape{N, M, 4};
+        std::vector<int64_t> score_shape{N, class_num, M};
+        std::unique_ptr<arena::TestCase> tester(
+            new MatrixNmsComputeTester(place,
+                                       "def",
+                                       DDim(bbox_shape),
+                                       DDim(score_shape),
+                                       0,
+                                       0.05f,
+                                       0.1f,
+                                       100,
+                                       50,
+                                       true,
+                                       use_gaussian,
+                                       2.0f,
+                                       true));
+        arena::Arena arena(std::move(tester), place, abs_error);
+        arena.TestPrecision();
+      }
+    }
+  }
+}
+
 TEST(matrix_nms, precision) {
   float abs_error = 2e-5;
   Place place;
@@ -428,5 +478,17 @@ TEST(matrix_nms, precision) {
   TestMatrixNms(place, abs_error);
 }
 
+TEST(matrix_nms, precision_random) {
+  float abs_error = 2e-5;
+  Place place;
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+  place = TARGET(kHost);
+#else
+  return;
+#endif
+
+  TestMatrixNmsRandom(place, abs_error);
+}
+
 }  // namespace lite
 }  // namespace paddle
@@ -322,6 +322,8 @@ class MulticlassNmsComputeTester : public arena::TestCase {
   int background_label_{-1};
   float score_threshold_{0.01f};
   bool normalized_{false};
+  // random boxes and scores rounded to 0.1, so many scores tie
+  bool random_data_{false};
 
  public:
   MulticlassNmsComputeTester(const Place& place,
@@ -334,7 +336,8 @@ class MulticlassNmsComputeTester : public arena::TestCase {
                              int nms_top_k = 1,
                              int background_label = 1,
                              float score_threshold = 0.01f,
-                             bool normalized = false)
+                             bool normalized = false,
+                             bool random_data = false)
       : TestCase(place, alias),
         bboxes_dims_(bboxes_dims),
         scores_dims_(scores_dims),
@@ -344,7 +347,8 @@ class MulticlassNmsComputeTester : public arena::TestCase {
         nms_top_k_(nms_top_k),
         background_label_(background_label),
         score_threshold_(score_threshold),
-        normalized_(normalized) {}
+        normalized_(normalized),
+        random_data_(random_data) {}
 
   void RunBaseline(Scope* scope) override {
     auto* boxes = scope->FindTensor(bboxes_);
@@ -458,15 +462,31 @@ class MulticlassNmsComputeTester : public arena::TestCase {
 
   void PrepareData() override {
     std::vector<T> bboxes(bboxes_dims_.production());
-    for (int i = 0; i < bboxes_dims_.production(); ++i) {
-      bboxes[i] = i * 1. / bboxes_dims_.production();
-    }
-    SetCommonTensor(bboxes_, bboxes_dims_, bboxes.data());
-
     std::vector<T> scores(scores_dims_.production());
-    for (int i = 0; i < scores_dims_.production(); ++i) {
-      scores[i] = i * 1. / scores_dims_.production();
+    if (random_data_) {
+      std::vector<float> rand(bboxes.size());
+      fill_data_rand(rand.data(), 0.f, 1.f, rand.size());
+      for (size_t i = 0; i < bboxes.size(); i += 4) {
+        // xmin, ymin in [0, 0.8), width and height in [0.05, 0.25)
+        bboxes[i] = rand[i] * 0.8f;
+        bboxes[i + 1] = rand[i + 1] * 0.8f;
+        bboxes[i + 2] = bboxes[i] + 0.05f + rand[i + 2] * 0.2f;
+        bboxes[i + 3] = bboxes[i + 1] + 0.05f + rand[i + 3] * 0.2f;
+      }
+      rand.resize(scores.size());
+      fill_data_rand(rand.data(), 0.f, 1.f, rand.size());
+      for (size_t i = 0; i < scores.size(); ++i) {
+        scores[i] = std::round(rand[i] * 10.f) / 10.f;
+      }
+    } else {
+      for (int i = 0; i < bboxes_dims_.production(); ++i) {
+        bboxes[i] = i * 1. / bboxes_dims_.production();
+      }
+      for (int i = 0; i < scores_dims_.production(); ++i) {
+        scores[i] = i * 1. / scores_dims_.production();
+      }
     }
+    SetCommonTensor(bboxes_, bboxes_dims_, bboxes.data());
     SetCommonTensor(scores_, scores_dims_, scores.data());
   }
 };
@@ -485,6 +505,38 @@ void TestMulticlassNms(Place place, float abs_error) {
   }
 }
 
+// Overlapping random boxes with tied scores, several classes, a single image
+// (classes run in parallel) and a batch (images run in parallel).
+template <typename T>
+void TestMulticlassNmsRandom(Place place, float abs_error) {
+  int M = 300;
+  for (int N : {1, 4}) {
+    for (int class_num : {3, 8}) {
+      for (int keep_top_k : {-1, 50}) {
+        for (bool normalized : {true, false}) {
+          std::vector<int64_t> bbox_shape{N, M, 4};
+          std::vector<int64_t> score_shape{N, class_num, M};
+          std::unique_ptr<arena::TestCase> tester(
+              new MulticlassNmsComputeTester<T>(place,
+                                                "def",
+                                                DDim(bbox_shape),
+                                                DDim(score_shape),
+                                                keep_top_k,
+                                                0.3f,
+                                                1.f,
+                                                100,
+                                                0,
+                                                0.05f,
+                                                normalized,
+                                                true));
+          arena::Arena arena(std::move(tester), place, abs_error);
+          arena.TestPrecision();
+        }
+      }
+    }
+  }
+}
+
 TEST(multiclass_nms, precision) {
   float abs_error = 2e-5;
   Place place;
@@ -497,6 +549,18 @@ TEST(multiclass_nms, precision) {
   TestMulticlassNms<float>(place, abs_error);
 }
 
+TEST(multiclass_nms, precision_random) {
+  float abs_error = 2e-5;
+  Place place;
+#if defined(LITE_WITH_ARM) || defined(LITE_WITH_X86)
+  place = TARGET(kHost);
+#else
+  return;
+#endif
+
+  TestMulticlassNmsRandom<float>(place, abs_error);
+}
+
 #if defined(ENABLE_ARM_FP16)
 TEST(multiclass_nmmsFP16, precison) {
   float abs_error = 2e-5;
@@ -0,0 +1,303 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <vector>
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/naive_math_impl.h"
+#ifdef LITE_WITH_ARM
+#include "lite/backends/arm/math/gemm_bf16.h"
+#endif  // LITE_WITH_ARM
+#include "lite/core/context.h"
+#include "lite/core/profile/timer.h"
+#include "lite/core/tensor.h"
+#include "lite/operators/op_params.h"
+#include "lite/tests/utils/tensor_utils.h"
+
+typedef paddle::lite::Tensor Tensor;
+using paddle::lite::profile::Timer;
+typedef paddle::lite::operators::ActivationParam ActivationParam;
+
+DEFINE_int32(power_mode,
+             0,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+DEFINE_int32(warmup, 0, "warmup times");
+DEFINE_int32(repeats, 1, "repeats times");
+DEFINE_bool(basic_test, true, "do all tests");
+DEFINE_bool(check_result, true, "check the result");
+
+DEFINE_int32(M, 512, "gemm: M");
+DEFINE_int32(N, 512, "gemm: N");
+DEFINE_int32(K, 512, "gemm: K");
+
+DEFINE_bool(traA, false, "gemm: A transpose");
+DEFINE_bool(traB, false, "gemm: B transpose");
+
+DEFINE_int32(relu_type, 0, "relu type, 0: no relu; 1: relu;");
+DEFINE_bool(flag_bias, true, "with bias");
+
+#ifdef LITE_WITH_ARM
+bool test_gemm_bf16(bool tra,
+                    bool trb,
+                    int m,
+                    int n,
+                    int k,
+                    bool has_bias,
+                    int relu_type,
+                    int cls,
+                    int ths) {
+  Tensor ta;
+  Tensor tb;
+  Tensor tc;
+  Tensor tc_basic;
+  Tensor tbias;
+
+  ta.Resize({m, k});
+  tb.Resize({k, n});
+  tc.Resize({m, n});
+  tc_basic.Resize({m, n});
+  tbias.Resize({m});
+  ta.set_precision(PRECISION(kFloat));
+  tb.set_precision(PRECISION(kFloat));
+  tc.set_precision(PRECISION(kFloat));
+  tc_basic.set_precision(PRECISION(kFloat));
+  tbias.set_precision(PRECISION(kFloat));
+
+  fill_tensor_rand(ta, -1.f, 1.f);
+  fill_tensor_rand(tb, -1.f, 1.f);
+  fill_tensor_rand(tbias, -1.f, 1.f);
+
+  ActivationParam act_param;
+  act_param.has_active = relu_type != 0;
+  act_param.active_type = paddle::lite_api::ActivationType::kRelu;
+
+  int lda = tra ? m : k;
+  int ldb = trb ? k : n;
+  auto da = ta.data<float>();
+  auto db = tb.data<float>();
+  auto dc = tc.mutable_data<float>();
+  auto dc_basic = tc_basic.mutable_data<float>();
+  auto dbias = tbias.data<float>();
+
+  LOG(INFO) << "gemm_bf16 M: " << m << ", N: " << n << ", K: " << k
+            << ", transA: " << (tra ? "true" : "false")
+            << ", transB: " << (trb ? "true" : "false")
+            << ", relu_type: " << relu_type
+            << ", bias: " << (has_bias ? "true" : "false");
+
+  if (FLAGS_check_result) {
+    // the reference sees the same bf16 rounded inputs as the kernel
+    std::vector<float> a_bf16(ta.numel());
+    std::vector<float> b_bf16(tb.numel());
+    for (size_t i = 0; i < a_bf16.size(); ++i) {
+      a_bf16[i] = paddle::lite::arm::math::bf16_to_fp32(
+          paddle::lite::arm::math::fp32_to_bf16(da[i]));
+    }
+    for (size_t i = 0; i < b_bf16.size(); ++i) {
+      b_bf16[i] = paddle::lite::arm::math::bf16_to_fp32(
+          paddle::lite::arm::math::fp32_to_bf16(db[i]));
+    }
+    memset(dc_basic, 0, tc_basic.numel() * sizeof(float));
+    basic_gemm(tra,
+               trb,
+               m,
+               n,
+               k,
+               1.f,
+               a_bf16.data(),
+               lda,
+               b_bf16.data(),
+               ldb,
+               0.f,
+               dc_basic,
+               n,
+               dbias,
+               has_bias,
+               relu_type);
+  }
+
+  Timer t0;
+  double ops = 2.0 * m * n * k;
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(cls), ths);
+
+  std::vector<uint16_t> packed_a(
+      paddle::lite::arm::math::get_packed_size_bf16(m, k));
+  paddle::lite::arm::math::prepackA_bf16(
+      packed_a.data(), da, lda, 0, m, 0, k, tra);
+
+  for (int j = 0; j < FLAGS_warmup; ++j) {
+    paddle::lite::arm::math::gemm_prepack_bf16(packed_a.data(),
+                                               db,
+                                               dbias,
+                                               dc,
+                                               m,
+                                               n,
+                                               k,
+                                               has_bias,
+                                               trb,
+                                               act_param,
+                                               &ctx);
+  }
+  for (int i = 0; i < FLAGS_repeats; ++i) {
+    t0.Start();
+    paddle::lite::arm::math::gemm_prepack_bf16(packed_a.data(),
+                                               db,
+                                               dbias,
+                                               dc,
+                                               m,
+                                               n,
+                                               k,
+                                               has_bias,
+                                               trb,
+                                               act_param,
+                                               &ctx);
+    t0.Stop();
+  }
+  LOG(INFO) << "gemm_bf16 output: M: " << m << ", N: " << n << ", K: " << k
+            << ", power_mode: " << cls << ", threads: " << ths
+            << ", GOPS: " << ops * 1e-9f
+            << " GOPS, avg time: " << t0.LapTimes().Avg()
+            << " ms, min time: " << t0.LapTimes().Min()
+            << " ms, mean GOPs: " << ops * 1e-6f / t0.LapTimes().Avg()
+            << " GOPs, max GOPs: " << ops * 1e-6f / t0.LapTimes().Min()
+            << " GOPs";
+
+  if (FLAGS_check_result) {
+    double max_ratio = 0;
+    double max_diff = 0;
+    tensor_cmp_host(tc_basic, tc, max_ratio, max_diff);
+    LOG(INFO) << "compare result, max diff: " << max_diff
+              << ", max ratio: " << max_ratio;
+    if (std::abs(max_ratio) > 1e-4f && std::abs(max_diff) > 1e-3f) {
+      Tensor tdiff;
+      tdiff.set_precision(PRECISION(kFloat));
+      tdiff.Resize(tc.dims());
+      tensor_diff(tc_basic, tc, tdiff);
+      LOG(INFO) << "basic result: ";
+      print_tensor(tc_basic);
+      LOG(INFO) << "lite result: ";
+      print_tensor(tc);
+      LOG(INFO) << "diff result: ";
+      print_tensor(tdiff);
+      return false;
+    }
+  }
+  return true;
+}
+#else
+bool test_gemm_bf16(bool tra,
+                    bool trb,
+                    int m,
+                    int n,
+                    int k,
+                    bool has_bias,
+                    int relu_type,
+                    int cls,
+                    int ths) {
+  return true;
+}
+#endif  // LITE_WITH_ARM
+
+#ifdef LITE_WITH_ARM
+TEST(TestLiteGemmBf16, fp32_to_bf16) {
+  using paddle::lite::arm::math::bf16_to_fp32;
+  using paddle::lite::arm::math::fp32_to_bf16;
+  // ties round to even
+  EXPECT_EQ(fp32_to_bf16(1.00390625f), 0x3f80);
+  EXPECT_EQ(fp32_to_bf16(1.01171875f), 0x3f82);
+  EXPECT_EQ(fp32_to_bf16(1.0f + 1.f / 128 + 1.f / 1024), 0x3f81);
+  EXPECT_EQ(bf16_to_fp32(fp32_to_bf16(-2.5f)), -2.5f);
+  EXPECT_TRUE(std::isnan(bf16_to_fp32(fp32_to_bf16(NAN))));
+}
+#endif  // LITE_WITH_ARM
+
+TEST(TestLiteGemmBf16, gemm_prepack_bf16) {
+  if (FLAGS_basic_test) {
+#ifdef LITE_WITH_ARM
+    paddle::lite::DeviceInfo::Init();
+    if (!paddle::lite::DeviceInfo::Global().has_bf16()) {
+      LOG(INFO) << "bf16 is not supported on this cpu, skip";
+      return;
+    }
+#endif
+    for (auto& m : {1, 3, 7, 8, 9, 33, 397}) {
+      for (auto& n : {1, 3, 11, 12, 13, 141, 789}) {
+        for (auto& k : {1, 3, 4, 5, 8, 59, 67}) {
+          for (auto& tra : {false, true}) {
+            for (auto& trb : {false, true}) {
+              for (auto& has_bias : {false, true}) {
+                for (auto& relu_type : {0, 1}) {
+                  for (auto& th : {1, 2, 4}) {
+                    auto flag = test_gemm_bf16(tra,
+                                               trb,
+                                               m,
+                                               n,
+                                               k,
+                                               has_bias,
+                                               relu_type,
+                                               FLAGS_power_mode,
+                                               th);
+                    if (!flag) {
+                      LOG(FATAL) << "test m = " << m << ", n=" << n
+                                 << ", k=" << k
+                                 << ", bias: " << (has_bias ? "true" : "false")
+                                 << ", relu: " << relu_type
+                                 << ", trans A: " << (tra ? "true" : "false")
+                                 << ", trans B: " << (trb ? "true" : "false")
+                                 << " failed\n";
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestGemmBf16Custom, gemm_prepack_bf16_custom) {
+#ifdef LITE_WITH_ARM
+  paddle::lite::DeviceInfo::Init();
+  if (!paddle::lite::DeviceInfo::Global().has_bf16()) {
+    LOG(INFO) << "bf16 is not supported on this cpu, skip";
+    return;
+  }
+#endif
+  auto flag = test_gemm_bf16(FLAGS_traA,
+                             FLAGS_traB,
+                             FLAGS_M,
+                             FLAGS_N,
+                             FLAGS_K,
+                             FLAGS_flag_bias,
+                             FLAGS_relu_type,
+                             FLAGS_power_mode,
+                             FLAGS_threads);
+  if (!flag) {
+    LOG(FATAL) << "test m = " << FLAGS_M << ", n=" << FLAGS_N
+               << ", k=" << FLAGS_K << ", trans A: " << FLAGS_traA
+               << ", trans B: " << FLAGS_traB << ", bias: " << FLAGS_flag_bias
+               << ", relu: " << FLAGS_relu_type << " failed!!";
+  }
+}
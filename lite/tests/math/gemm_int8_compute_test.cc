@@ -193,7 +193,7 @@ bool test_gemm_int8(bool tra,
   Tensor tpackedA;
   int hblock = paddle::lite::arm::math::get_hblock_int8(&ctx);
   int round_up_a = ((hblock + m - 1) / hblock) * hblock;
-  int round_up_k = 4 * ((k + 3) / 4);
+  int round_up_k = ROUNDUP(k, paddle::lite::arm::math::get_kblock_int8(&ctx));
   tpackedA.Resize({round_up_a * round_up_k});
   auto prepack_data = tpackedA.data<int8_t>();
 
@@ -392,6 +392,54 @@ TEST(TestLiteGemmInt8, gemm_prepacked_int8) {
   }
 }
 
+#if defined(__aarch64__) && defined(WITH_ARM_MMLA)
+// The i8mm kernels pack A by 8 rows and B by 12 columns, 8 k values at a
+// time; the shapes below cover the tails of each block against basic_gemm.
+TEST(TestLiteGemmInt8, gemm_prepacked_int8_mmla) {
+  if (FLAGS_basic_test) {
+    paddle::lite::DeviceInfo::Init();
+    if (!paddle::lite::DeviceInfo::Global().has_i8mm()) {
+      LOG(INFO) << "i8mm is not supported on this cpu, skip";
+      return;
+    }
+    for (auto& m : {1, 7, 8, 9, 15, 17, 33}) {
+      for (auto& n : {1, 11, 12, 13, 23, 25, 141}) {
+        for (auto& k : {1, 7, 8, 9, 15, 16, 17, 67}) {
+          for (auto& tra : {false, true}) {
+            for (auto& trb : {false, true}) {
+              for (auto& has_bias : {false, true}) {
+                for (auto& relu_type : {0, 1}) {
+                  for (auto& th : {1, 4}) {
+                    auto flag = test_gemm_int8(tra,
+                                               trb,
+                                               m,
+                                               n,
+                                               k,
+                                               has_bias,
+                                               relu_type,
+                                               FLAGS_power_mode,
+                                               th);
+                    if (!flag) {
+                      LOG(FATAL) << "test m = " << m << ", n=" << n
+                                 << ", k=" << k
+                                 << ", bias: " << (has_bias ? "true" : "false")
+                                 << ", relu: " << relu_type
+                                 << ", trans A: " << (tra ? "true" : "false")
+                                 << ", trans B: " << (trb ? "true" : "false")
+                                 << " failed\n";
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+#endif  // __aarch64__ && WITH_ARM_MMLA
+
 TEST(TestGemmInt8Custom, gemm_prepacked_int8_custom) {
 #ifdef LITE_WITH_ARM
   paddle::lite::DeviceInfo::Init();
@@ -0,0 +1,419 @@
+// Copyright (c) 2021 PaddlePaddle Authors. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "lite/backends/arm/math/funcs.h"
+#include "lite/backends/arm/math/sve/funcs_sve.h"
+#include "lite/core/context.h"
+#include "lite/operators/op_params.h"
+#include "lite/tests/utils/fill_data.h"
+#include "lite/tests/utils/naive_math_impl.h"
+
+// The sve kernels are checked against the neon kernels they replace, or
+// against the naive implementations when the neon one is split in many
+// specialized paths. The sizes cover the predicated tails for any vector
+// length up to 2048 bits.
+
+typedef paddle::lite::operators::ActivationParam ActivationParam;
+namespace arm_math = paddle::lite::arm::math;
+
+DEFINE_int32(power_mode,
+             3,
+             "power mode: "
+             "0 for POWER_HIGH;"
+             "1 for POWER_LOW;"
+             "2 for POWER_FULL;"
+             "3 for NO_BIND");
+DEFINE_int32(threads, 1, "threads num");
+
+static bool SveSupported() {
+  paddle::lite::DeviceInfo::Init();
+  if (!paddle::lite::DeviceInfo::Global().has_sve()) {
+    LOG(INFO) << "sve is not supported on this cpu, skip";
+    return false;
+  }
+  return true;
+}
+
+static std::vector<float> RandData(size_t size, float vmin, float vmax) {
+  std::vector<float> data(size);
+  fill_data_rand(data.data(), vmin, vmax, size);
+  return data;
+}
+
+static void CheckNear(const std::vector<float>& expected,
+                      const std::vector<float>& actual,
+                      float eps,
+                      const std::string& name) {
+  ASSERT_EQ(expected.size(), actual.size()) << name;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_NEAR(expected[i], actual[i], eps) << name << " at " << i;
+  }
+}
+
+static const int kSizes[] = {1, 3, 15, 16, 17, 63, 65, 255, 1023};
+
+TEST(TestSve, activation) {
+  if (!SveSupported()) return;
+  for (int size : kSizes) {
+    auto din = RandData(size, -8.f, 8.f);
+    std::vector<float> ref(size);
+    std::vector<float> out(size);
+    const std::string tag = " size " + std::to_string(size);
+
+    arm_math::act_relu<float>(din.data(), ref.data(), size, FLAGS_threads);
+    arm_math::sve::act_relu(din.data(), out.data(), size, FLAGS_threads);
+    CheckNear(ref, out, 0.f, "relu" + tag);
+
+    arm_math::act_relu_neg<float>(
+        din.data(), ref.data(), size, 0.1f, FLAGS_threads);
+    arm_math::sve::act_relu_neg(
+        din.data(), out.data(), size, 0.1f, FLAGS_threads);
+    CheckNear(ref, out, 1e-6f, "leaky_relu" + tag);
+
+    arm_math::act_clipped_relu<float>(
+        din.data(), ref.data(), size, 6.f, FLAGS_threads);
+    arm_math::sve::act_clipped_relu(
+        din.data(), out.data(), size, 6.f, FLAGS_threads);
+    CheckNear(ref, out, 0.f, "relu6" + tag);
+
+    arm_math::act_sigmoid<float>(din.data(), ref.data(), size, FLAGS_threads);
+    arm_math::sve::act_sigmoid(din.data(), out.data(), size, FLAGS_threads);
+    CheckNear(ref, out, 1e-5f, "sigmoid" + tag);
+
+    arm_math::act_tanh<float>(din.data(), ref.data(), size, FLAGS_threads);
+    arm_math::sve::act_tanh(din.data(), out.data(), size, FLAGS_threads);
+    CheckNear(ref, out, 1e-5f, "tanh" + tag);
+  }
+}
+
+#define CHECK_ELEMENTWISE_SVE(name)                                          \
+  for (int num : kSizes) {                                                   \
+    auto x = RandData(num, -4.f, 4.f);                                       \
+    auto y = RandData(num, -4.f, 4.f);                                       \
+    std::vector<float> ref(num);                                             \
+    std::vector<float> out(num);                                             \
+    arm_math::elementwise_##name<float>(x.data(), y.data(), ref.data(), num); \
+    arm_math::sve::elementwise_##name(x.data(), y.data(), out.data(), num);  \
+    CheckNear(ref, out, 0.f, #name);                                         \
+    arm_math::elementwise_##name##_relu<float>(                              \
+        x.data(), y.data(), ref.data(), num);                                 \
+    arm_math::sve::elementwise_##name##_relu(                                \
+        x.data(), y.data(), out.data(), num);                                 \
+    CheckNear(ref, out, 0.f, #name "_relu");                                 \
+    const int batch = 2;                                                     \
+    const int channels = 3;                                                  \
+    auto bx = RandData(batch * channels * num, -4.f, 4.f);                   \
+    auto by = RandData(channels, -4.f, 4.f);                                 \
+    std::vector<float> bref(bx.size());                                      \
+    std::vector<float> bout(bx.size());                                      \
+    arm_math::elementwise_##name##_broadcast<float>(                         \
+        bx.data(), by.data(), bref.data(), batch, channels, num);            \
+    arm_math::sve::elementwise_##name##_broadcast(                           \
+        bx.data(), by.data(), bout.data(), batch, channels, num);            \
+    CheckNear(bref, bout, 0.f, #name "_broadcast");                          \
+    arm_math::elementwise_##name##_relu_broadcast<float>(                    \
+        bx.data(), by.data(), bref.data(), batch, channels, num);            \
+    arm_math::sve::elementwise_##name##_relu_broadcast(                      \
+        bx.data(), by.data(), bout.data(), batch, channels, num);            \
+    CheckNear(bref, bout, 0.f, #name "_relu_broadcast");                     \
+  }
+
+TEST(TestSve, elementwise) {
+  if (!SveSupported()) return;
+  CHECK_ELEMENTWISE_SVE(add)
+  CHECK_ELEMENTWISE_SVE(sub)
+  CHECK_ELEMENTWISE_SVE(mul)
+  CHECK_ELEMENTWISE_SVE(max)
+  CHECK_ELEMENTWISE_SVE(min)
+}
+#undef CHECK_ELEMENTWISE_SVE
+
+TEST(TestSve, softmax) {
+  if (!SveSupported()) return;
+  const int outer_num = 2;
+  for (int axis_size : {1, 3, 17, 65}) {
+    for (int inner_num : {1, 4, 5, 33}) {
+      const int size = outer_num * axis_size * inner_num;
+      auto din = RandData(size, -10.f, 10.f);
+      std::vector<float> ref(size);
+      std::vector<float> out(size);
+      arm_math::softmax_basic<float>(
+          din.data(), ref.data(), axis_size, inner_num, outer_num);
+      arm_math::sve::softmax(
+          din.data(), out.data(), axis_size, inner_num, outer_num);
+      CheckNear(ref,
+                out,
+                1e-5f,
+                "softmax axis " + std::to_string(axis_size) + " inner " +
+                    std::to_string(inner_num));
+    }
+  }
+}
+
+TEST(TestSve, pooling) {
+  if (!SveSupported()) return;
+  const int num = 1;
+  const int ch = 3;
+  for (int hin : {1, 5, 17}) {
+    for (int win : {1, 4, 15, 33}) {
+      auto din = RandData(num * ch * hin * win, -4.f, 4.f);
+      std::vector<float> ref(num * ch);
+      std::vector<float> out(num * ch);
+      arm_math::pooling_global_max(
+          din.data(), ref.data(), num, ch, 1, 1, ch, hin, win);
+      arm_math::sve::pooling_global_max(
+          din.data(), out.data(), num, ch, 1, 1, ch, hin, win);
+      CheckNear(ref, out, 0.f, "global max");
+      arm_math::pooling_global_avg(
+          din.data(), ref.data(), num, ch, 1, 1, ch, hin, win);
+      arm_math::sve::pooling_global_avg(
+          din.data(), out.data(), num, ch, 1, 1, ch, hin, win);
+      CheckNear(ref, out, 1e-5f, "global avg");
+
+      for (int k : {2, 3}) {
+        for (int stride : {1, 2}) {
+          for (int pad : {0, 1}) {
+            int hout = (hin + 2 * pad - k) / stride + 1;
+            int wout = (win + 2 * pad - k) / stride + 1;
+            if (hout <= 0 || wout <= 0) continue;
+            std::vector<int> ksize{k, k};
+            std::vector<int> strides{stride, stride};
+            std::vector<int> paddings{pad, pad, pad, pad};
+            for (bool is_max : {true, false}) {
+              std::vector<float> wref(num * ch * hout * wout);
+              std::vector<float> wout_data(wref.size());
+              arm_math::pooling_basic(din.data(),
+                                      wref.data(),
+                                      num,
+                                      ch,
+                                      hout,
+                                      wout,
+                                      ch,
+                                      hin,
+                                      win,
+                                      ksize,
+                                      strides,
+                                      paddings,
+                                      false,
+                                      true,
+                                      false,
+                                      false,
+                                      false,
+                                      is_max ? "max" : "avg");
+              arm_math::sve::pooling(din.data(),
+                                     wout_data.data(),
+                                     num,
+                                     ch,
+                                     hout,
+                                     wout,
+                                     ch,
+                                     hin,
+                                     win,
+                                     ksize,
+                                     strides,
+                                     paddings,
+                                     is_max);
+              CheckNear(wref,
+                        wout_data,
+                        1e-5f,
+                        std::string(is_max ? "max" : "avg") + " pooling k " +
+                            std::to_string(k) + " s " +
+                            std::to_string(stride) + " p " +
+                            std::to_string(pad));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+// relu, relu6 and leaky relu, with the act_type of conv_basic/basic_gemm.
+static ActivationParam MakeActParam(int act_type) {
+  ActivationParam act_param;
+  act_param.has_active = act_type != 0;
+  if (act_type == 1) {
+    act_param.active_type = paddle::lite_api::ActivationType::kRelu;
+  } else if (act_type == 2) {
+    act_param.active_type = paddle::lite_api::ActivationType::kRelu6;
+    act_param.Relu_clipped_coef = 6.f;
+  } else if (act_type == 4) {
+    act_param.active_type = paddle::lite_api::ActivationType::kLeakyRelu;
+    act_param.Leaky_relu_alpha = 0.1f;
+  }
+  return act_param;
+}
+
+TEST(TestSve, conv_depthwise_3x3) {
+  if (!SveSupported()) return;
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(FLAGS_power_mode),
+                 FLAGS_threads);
+  const int num = 2;
+  const int ch = 3;
+  for (int hin : {3, 4, 9}) {
+    for (int win : {3, 7, 16, 33}) {
+      for (int stride : {1, 2}) {
+        for (int pad : {0, 1}) {
+          for (bool flag_bias : {false, true}) {
+            for (int act_type : {0, 1, 2, 4}) {
+              int hout = (hin + 2 * pad - 3) / stride + 1;
+              int wout = (win + 2 * pad - 3) / stride + 1;
+              auto din = RandData(num * ch * hin * win, -1.f, 1.f);
+              auto weights = RandData(ch * 9, -1.f, 1.f);
+              auto bias = RandData(ch, -1.f, 1.f);
+              std::vector<float> ref(num * ch * hout * wout);
+              std::vector<float> out(ref.size());
+              conv_basic<float, float>(din.data(),
+                                       ref.data(),
+                                       num,
+                                       ch,
+                                       hout,
+                                       wout,
+                                       ch,
+                                       hin,
+                                       win,
+                                       weights.data(),
+                                       bias.data(),
+                                       ch,
+                                       3,
+                                       3,
+                                       stride,
+                                       stride,
+                                       1,
+                                       1,
+                                       pad,
+                                       pad,
+                                       flag_bias,
+                                       act_type,
+                                       6.f,
+                                       0.1f);
+              paddle::lite::operators::ConvParam param;
+              param.strides = {stride, stride};
+              param.paddings = std::make_shared<std::vector<int>>(
+                  std::vector<int>{pad, pad, pad, pad});
+              param.dilations =
+                  std::make_shared<std::vector<int>>(std::vector<int>{1, 1});
+              param.groups = ch;
+              param.activation_param = MakeActParam(act_type);
+              arm_math::sve::conv_depthwise_3x3_fp32(
+                  din.data(),
+                  out.data(),
+                  num,
+                  ch,
+                  hout,
+                  wout,
+                  ch,
+                  hin,
+                  win,
+                  weights.data(),
+                  flag_bias ? bias.data() : nullptr,
+                  param,
+                  &ctx,
+                  nullptr);
+              CheckNear(ref,
+                        out,
+                        1e-4f,
+                        "dw conv h " + std::to_string(hin) + " w " +
+                            std::to_string(win) + " s " +
+                            std::to_string(stride) + " p " +
+                            std::to_string(pad) + " act " +
+                            std::to_string(act_type));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(TestSve, sgemm) {
+  if (!SveSupported()) return;
+  std::unique_ptr<paddle::lite::KernelContext> ctx1(
+      new paddle::lite::KernelContext);
+  auto& ctx = ctx1->As<paddle::lite::ARMContext>();
+  ctx.SetRunMode(static_cast<paddle::lite_api::PowerMode>(FLAGS_power_mode),
+                 FLAGS_threads);
+  for (int m : {1, 7, 8, 9, 33}) {
+    for (int n : {1, 15, 16, 17, 65, 141}) {
+      for (int k : {1, 3, 8, 59}) {
+        for (bool tra : {false, true}) {
+          for (bool trb : {false, true}) {
+            for (bool has_bias : {false, true}) {
+              for (int act_type : {0, 1, 2, 4}) {
+                int lda = tra ? m : k;
+                int ldb = trb ? k : n;
+                auto a = RandData(m * k, -1.f, 1.f);
+                auto b = RandData(k * n, -1.f, 1.f);
+                auto bias = RandData(m, -1.f, 1.f);
+                auto ref = RandData(m * n, -1.f, 1.f);
+                auto out = ref;
+                const float alpha = 1.f;
+                const float beta = 0.5f;
+                basic_gemm<float, float>(tra,
+                                         trb,
+                                         m,
+                                         n,
+                                         k,
+                                         alpha,
+                                         a.data(),
+                                         lda,
+                                         b.data(),
+                                         ldb,
+                                         beta,
+                                         ref.data(),
+                                         n,
+                                         bias.data(),
+                                         has_bias,
+                                         act_type,
+                                         6.f,
+                                         0.1f);
+                arm_math::sve::sgemm(tra,
+                                     trb,
+                                     m,
+                                     n,
+                                     k,
+                                     alpha,
+                                     a.data(),
+                                     lda,
+                                     b.data(),
+                                     ldb,
+                                     beta,
+                                     out.data(),
+                                     n,
+                                     bias.data(),
+                                     has_bias,
+                                     MakeActParam(act_type),
+                                     &ctx);
+                CheckNear(ref,
+                          out,
+                          1e-4f,
+                          "sgemm m " + std::to_string(m) + " n " +
+                              std::to_string(n) + " k " + std::to_string(k) +
+                              " act " + std::to_string(act_type));
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
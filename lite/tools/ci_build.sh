@@ -346,6 +346,7 @@ function build_test_train {
 
     find -name "*.whl" | xargs pip2 install
     python ../lite/tools/python/lite_test.py
+    python ../lite/api/python/tensor_test.py
 
 }
 